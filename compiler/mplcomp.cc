@@ -85,6 +85,7 @@ int main(int argc, char *argv[])
     mpl_list_t *compiler_defines_p = NULL;
     char *include_dir_name_p = NULL;
     int experimental = 0;
+    int specialize = 0;
     codegen_mode_t codegen_mode = codegen_mode_mpl;
 
     include_dir_name_p = strdup(".");
@@ -96,7 +97,7 @@ int main(int argc, char *argv[])
         exit(-1);
     }
 
-    while ((opt = getopt(argc, argv, "m:f:o:d:i:D:e")) != -1) {
+    while ((opt = getopt(argc, argv, "m:f:o:d:i:D:es")) != -1) {
         switch (opt) {
             case 'm':
                 free(mode_p);
@@ -123,6 +124,9 @@ int main(int argc, char *argv[])
             case 'e':
                 experimental = 1;
                 break;
+            case 's':
+                specialize = 1;
+                break;
             case 'f':
                 flags = strdup(optarg);
                 break;
@@ -163,6 +167,9 @@ int main(int argc, char *argv[])
     else if (!strcmp(mode_p, "api")) {
         codegen_mode = codegen_mode_api;
     }
+    else if (!strcmp(mode_p, "api11")) {
+        codegen_mode = codegen_mode_api11;
+    }
 
     ifstream input_file(mpl_filename_p, ios::in);
     if (input_file.fail()) {
@@ -177,6 +184,7 @@ int main(int argc, char *argv[])
                                   compiler_defines_p,
                                   experimental,
                                   codegen_mode);
+    compiler_p->specialize = specialize;
 
     compiler_p->push_file(mpl_filename_p, 1);
     compiler_p->parse();
@@ -203,6 +211,10 @@ int main(int argc, char *argv[])
             sprintf(hfilename, "%s/%s.hh", out_dir_name_p, out_name_p);
             sprintf(cfilename, "%s/%s.cc", out_dir_name_p, out_name_p);
         }
+        else if (codegen_mode == codegen_mode_api11) {
+            sprintf(hfilename, "%s/%s_api11.hh", out_dir_name_p, out_name_p);
+            sprintf(cfilename, "%s/%s_api11.cc", out_dir_name_p, out_name_p);
+        }
         else if (codegen_mode == codegen_mode_cli) {
             sprintf(hfilename, "%s/%s_cli.h", out_dir_name_p, out_name_p);
             sprintf(cfilename, "%s/%s_cli.c", out_dir_name_p, out_name_p);
@@ -3048,14 +3060,17 @@ static void usage(char *name)
 {
     fprintf(stderr, "Usage: %s [options] <yourfile>.mpl\n", name);
     fprintf(stderr,
-            "Options: -m <mode> (mode=mpl|cli|dejagnu|cpp|latex) (default mpl)\n"
+            "Options: -m <mode> (mode=mpl|cli|api|api11|dejagnu|latex) (default mpl)\n"
             "         -i <include-dir>\n"
             "         -d <output-dir>\n"
             "         -o <output-filename-without-suffix> (default <yourfile>)\n"
+            "         -s (mode mpl) generate specialized pack/unpack methods for\n"
+            "            integer, enum and string parameters\n"
             "\n"
             "  Modes: mpl     - generate support code for parameter sets and categories (C)\n"
             "         cli     - generate support code for command line interface (C)\n"
             "         api     - generate support code for API (C++)\n"
+            "         api11   - generate value classes for bags, with direct encode/decode (C++11)\n"
             "         dejagnu - generate support code for dejagnu test system (TCL)\n"
             "         latex   - generate documentation (latex, suitable for latex2html)\n"
            );
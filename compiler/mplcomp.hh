@@ -104,6 +104,7 @@ typedef enum {
     CODEGEN_MODE_VALUE_ELEMENT(mpl) \
     CODEGEN_MODE_VALUE_ELEMENT(cli) \
     CODEGEN_MODE_VALUE_ELEMENT(api) \
+    CODEGEN_MODE_VALUE_ELEMENT(api11) \
 
 #define CODEGEN_MODE_VALUE_ELEMENT(ELEMENT) \
     codegen_mode_##ELEMENT,
@@ -1091,6 +1092,7 @@ class parameter_set : public listable_object {
     number_range *find_number_range(const char *number_range_name_p);
     int check_parameters();
     parameter *find_parameter(char *name_p);
+    int get_parameter_number(char *name_p);
     parameter_group *find_parameter_group(char *category_name_p);
     parameter *create_parameter_in_current_group(const char *type_p, char *name_p);
     parameter *create_parameter_in_default_group(const char *type_p, char *name_p);
@@ -1106,14 +1108,17 @@ class parameter_set : public listable_object {
     void gc_h_functions(FILE *f);
     void gc_h_macros(FILE *f);
     void gc_h_bags(FILE *f);
+    void gc_h_structs(FILE *f);
     void gc_h_paramids(FILE *f);
     void gc_h_enums(FILE *f);
     void gc_h_enumerator_lists(FILE *f);
 
     void gc_c(FILE *f);
     void gc_c_bags(FILE *f);
+    void gc_c_structs(FILE *f);
     void gc_c_param_init(FILE *f);
     void gc_c_param_descr(FILE *f);
+    void gc_c_methods(FILE *f);
     void gc_c_defaults(FILE *f);
     void gc_c_extra(FILE *f);
     void gc_c_ranges(FILE *f);
@@ -1127,6 +1132,8 @@ class parameter_set : public listable_object {
 
     void api_hh(FILE *f, char *indent);
     void api_cc(FILE *f, char *indent);
+    void api11_hh(FILE *f);
+    void api11_cc(FILE *f);
 
     void wrap_up_definition();
 
@@ -1708,9 +1715,14 @@ class category : public inheritable_object {
     virtual void wrap_up_definition();
 
     void gc(FILE *hfile_p, FILE *cfile_p, mpl_list_t *categories_p);
+    void gc_dispatch(FILE *hfile_p, FILE *cfile_p);
+    void gc_client_protocol(FILE *hfile_p, FILE *cfile_p);
+    void gc_client_send(FILE *hfile_p, FILE *cfile_p);
 
     void api_hh(FILE *f, char *indent);
     void api_cc(FILE *f, char *indent);
+    void api_hh_dispatch(FILE *f, char *indent);
+    void api_cc_dispatch(FILE *f, char *indent);
 
     void convert_doc();
     void convert_doc_commands();
@@ -1953,6 +1965,7 @@ class mpl_compiler {
         include_dir_name_p(include_dir_name_p),
         experimental(experimental),
         codegen_mode(codegen_mode),
+        specialize(0),
         lexer_p(NULL),
         lexer_stream_p(input_stream_p),
         current_if_condition(this, NULL, if_operator_none, NULL),
@@ -1991,6 +2004,8 @@ class mpl_compiler {
     char *include_dir_name_p;
     int experimental;
     codegen_mode_t codegen_mode;
+    /* Generate specialized parameter methods (-s) */
+    int specialize;
     istream *lexer_stream_p;
     mpl_lexer *lexer_p;
     if_condition current_if_condition;
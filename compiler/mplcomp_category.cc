@@ -513,6 +513,9 @@ void category::gc(FILE *hfile_p, FILE *cfile_p, mpl_list_t *categories_p)
                     lnu,
                     name_p
                    );
+            gc_dispatch(hfile_p, cfile_p);
+            gc_client_protocol(hfile_p, cfile_p);
+            gc_client_send(hfile_p, cfile_p);
         }
         else if (compiler_p->codegen_mode == codegen_mode_cli) {
             fprintf(hfile_p,
@@ -659,6 +662,7 @@ void category::api_hh(FILE *f, char *indent)
                 "%s    BAG *receive(mpl_list_t *inMsg);\n",
                 indent
                );
+        api_hh_dispatch(f, indent);
     }
     return;
 }
@@ -865,6 +869,604 @@ void category::api_cc(FILE *f, char *indent)
             indent,
             indent
            );
+    if (parent_p == NULL)
+        api_cc_dispatch(f, indent);
+    free(snu);
+    free(cnu);
+}
+
+/* Dispatch slots for the commands of this category and its children,
+   indexed by command bag parameter number minus that of the first
+   command. Gaps between the commands (responses, other parameters) are
+   left with a NULL command_p. Returns the number of slots. */
+typedef struct {
+    command *command_p;
+    category *category_p;
+} dispatch_slot_t;
+
+static int get_dispatch_slots(category *category_p,
+                              dispatch_slot_t **slots_pp)
+{
+    parameter_set *parameter_set_p = category_p->get_parameter_set();
+    mpl_list_t *tmp_p;
+    mpl_list_t *clist_p = NULL;
+    object_container *container_p;
+    int first = 0;
+    int last = 0;
+    int pass;
+    dispatch_slot_t *slots_p = NULL;
+
+    container_p = new object_container(category_p);
+    container_p->append_to(clist_p);
+    mpl_list_append(&clist_p, category_p->get_flat_child_list());
+
+    /* First pass finds the id range, second pass fills in the slots */
+    for (pass = 0; pass < 2; pass++) {
+        MPL_LIST_FOR_EACH(clist_p, tmp_p) {
+            object_container *container_p = LISTABLE_PTR(tmp_p, object_container);
+            category *child_p = (category*) container_p->object_p;
+            mpl_list_t *tmp_p;
+
+            if (child_p->get_parameter_set() != parameter_set_p)
+                continue;
+
+            MPL_LIST_FOR_EACH(child_p->commands.method_list_p, tmp_p) {
+                command *command_p = LISTABLE_PTR(tmp_p, command);
+                char bag_name[256];
+                int number;
+
+                snprintf(bag_name, sizeof(bag_name), "%s_%s",
+                         command_p->name_p,
+                         child_p->get_command_bag()->name_p);
+                number = parameter_set_p->get_parameter_number(bag_name);
+                if (number == 0)
+                    continue;
+                if (pass == 0) {
+                    if ((first == 0) || (number < first))
+                        first = number;
+                    if (number > last)
+                        last = number;
+                }
+                else {
+                    slots_p[number - first].command_p = command_p;
+                    slots_p[number - first].category_p = child_p;
+                }
+            }
+        }
+        if ((pass == 0) && (first != 0))
+            slots_p = (dispatch_slot_t*) calloc(last - first + 1,
+                                                sizeof(dispatch_slot_t));
+        if (slots_p == NULL)
+            break;
+    }
+    DELETE_LISTABLE_LIST(&clist_p, object_container);
+
+    *slots_pp = slots_p;
+    return slots_p ? (last - first + 1) : 0;
+}
+
+void category::gc_dispatch(FILE *hfile_p, FILE *cfile_p)
+{
+    char *snl = get_parameter_set()->get_short_name();
+    char *snu = str_toupper(snl);
+    char *cnl = name_p;
+    char *cnu = str_toupper(cnl);
+    dispatch_slot_t *slots_p;
+    int num_slots;
+    int i;
+
+    num_slots = get_dispatch_slots(this, &slots_p);
+    if (num_slots == 0)
+        goto out;
+
+    fprintf(hfile_p,
+            "/**\n"
+            "  * Command handlers for category %s, one slot per command.\n"
+            "  * A handler gets the parameters of the command and returns\n"
+            "  * the response message. Slots may be NULL.\n"
+            "  */\n"
+            "typedef struct {\n",
+            cnl
+           );
+    for (i = 0; i < num_slots; i++) {
+        if (slots_p[i].command_p == NULL)
+            continue;
+        fprintf(hfile_p,
+                "    mpl_list_t *(*%s)(mpl_bag_t *reqParams, void *ctx_p);\n",
+                slots_p[i].command_p->name_p
+               );
+    }
+    fprintf(hfile_p,
+            "} %s_handlers_t;\n"
+            "\n",
+            cnl
+           );
+    fprintf(hfile_p,
+            "/**\n"
+            "  * Call the handler of a command message. The handler is found\n"
+            "  * in a table indexed by command id.\n"
+            "  * @param handlers_p (in) The command handlers\n"
+            "  * @param reqMsg (in) The command message\n"
+            "  * @param ctx_p (in) Passed on to the handler\n"
+            "  * @return The handler's response message, or NULL if reqMsg\n"
+            "  *         is not a command or the command has no handler\n"
+            "  */\n"
+            "mpl_list_t *%s_dispatch(const %s_handlers_t *handlers_p, mpl_list_t *reqMsg, void *ctx_p);\n"
+            "\n",
+            cnl,
+            cnl
+           );
+
+    fprintf(cfile_p,
+            "\n"
+            "typedef mpl_list_t *(*%s_dispatch_fp)(const %s_handlers_t *handlers_p, mpl_bag_t *reqParams, void *ctx_p);\n"
+            "\n",
+            cnl,
+            cnl
+           );
+    for (i = 0; i < num_slots; i++) {
+        if (slots_p[i].command_p == NULL)
+            continue;
+        fprintf(cfile_p,
+                "static mpl_list_t *%s_dispatch_%s(const %s_handlers_t *handlers_p, mpl_bag_t *reqParams, void *ctx_p)\n"
+                "{\n"
+                "    if (handlers_p->%s == NULL)\n"
+                "        return NULL;\n"
+                "    return handlers_p->%s(reqParams, ctx_p);\n"
+                "}\n"
+                "\n",
+                cnl,
+                slots_p[i].command_p->name_p,
+                cnl,
+                slots_p[i].command_p->name_p,
+                slots_p[i].command_p->name_p
+               );
+    }
+    fprintf(cfile_p,
+            "/* Indexed by command id minus the id of the first command */\n"
+            "static const %s_dispatch_fp %s_dispatch_table[] = {\n",
+            cnl,
+            cnl
+           );
+    for (i = 0; i < num_slots; i++) {
+        if (slots_p[i].command_p == NULL)
+            fprintf(cfile_p,
+                    "    NULL,\n"
+                   );
+        else
+            fprintf(cfile_p,
+                    "    %s_dispatch_%s,\n",
+                    cnl,
+                    slots_p[i].command_p->name_p
+                   );
+    }
+    fprintf(cfile_p,
+            "};\n"
+            "\n"
+           );
+    fprintf(cfile_p,
+            "mpl_list_t *%s_dispatch(const %s_handlers_t *handlers_p, mpl_list_t *reqMsg, void *ctx_p)\n"
+            "{\n"
+            "    size_t index;\n"
+            "\n"
+            "    if (!%s_IS_COMMAND(reqMsg))\n"
+            "        return NULL;\n"
+            "    /* Ids below the first command wrap around and fail the range check */\n"
+            "    index = (size_t) (%s_GET_COMMAND_ID(reqMsg) - %s_PARAM_ID(%s_%s));\n"
+            "    if ((index >= (sizeof(%s_dispatch_table) / sizeof(%s_dispatch_table[0]))) ||\n"
+            "        (%s_dispatch_table[index] == NULL))\n"
+            "        return NULL;\n"
+            "    return %s_dispatch_table[index](handlers_p, %s_GET_BAG_PTR(reqMsg, %s), ctx_p);\n"
+            "}\n"
+            "\n",
+            cnl,
+            cnl,
+            cnu,
+            cnu,
+            snu,
+            slots_p[0].command_p->name_p,
+            slots_p[0].category_p->get_command_bag()->name_p,
+            cnl,
+            cnl,
+            cnl,
+            cnl,
+            snu,
+            get_command_bag()->name_p
+           );
+    free(slots_p);
+out:
+    free(snu);
+    free(cnu);
+}
+
+void category::gc_client_protocol(FILE *hfile_p, FILE *cfile_p)
+{
+    parameter_set *parameter_set_p = get_parameter_set();
+    char *cnl = name_p;
+    char *cnu;
+
+    /* The IS_ and GET_ID macros need the message bags in the category's
+       own parameter set, which an inheriting category may not have */
+    if ((parameter_set_p->get_parameter_number(get_command_bag()->name_p) == 0) ||
+        (parameter_set_p->get_parameter_number(get_response_bag()->name_p) == 0) ||
+        (parameter_set_p->get_parameter_number(get_event_bag()->name_p) == 0))
+        return;
+
+    cnu = str_toupper(cnl);
+    fprintf(hfile_p,
+            "/**\n"
+            "  * Message classification of category %s for the\n"
+            "  * asynchronous client (see mpl_client_create()).\n"
+            "  */\n"
+            "extern const mpl_client_protocol_t %s_client_protocol;\n"
+            "\n",
+            cnl,
+            cnl
+           );
+
+    fprintf(cfile_p,
+            "static bool %s_client_is_event(mpl_list_t *msg)\n"
+            "{\n"
+            "    return %s_IS_EVENT(msg);\n"
+            "}\n"
+            "\n"
+            "static mpl_param_element_id_t %s_client_command_response_id(mpl_list_t *reqMsg)\n"
+            "{\n"
+            "    if (!%s_IS_COMMAND(reqMsg))\n"
+            "        return MPL_PARAM_ID_UNDEFINED;\n"
+            "    return %s_COMMAND_ID_TO_RESPONSE_ID(%s_GET_COMMAND_ID(reqMsg));\n"
+            "}\n"
+            "\n"
+            "static mpl_param_element_id_t %s_client_response_id(mpl_list_t *respMsg)\n"
+            "{\n"
+            "    if (!%s_IS_RESPONSE(respMsg))\n"
+            "        return MPL_PARAM_ID_UNDEFINED;\n"
+            "    return %s_GET_RESPONSE_ID(respMsg);\n"
+            "}\n"
+            "\n"
+            "const mpl_client_protocol_t %s_client_protocol = {\n"
+            "    %s_client_is_event,\n"
+            "    %s_client_command_response_id,\n"
+            "    %s_client_response_id\n"
+            "};\n"
+            "\n",
+            cnl,
+            cnu,
+            cnl,
+            cnu,
+            cnu,
+            cnu,
+            cnl,
+            cnu,
+            cnu,
+            cnl,
+            cnl,
+            cnl,
+            cnl
+           );
+    free(cnu);
+}
+
+void category::gc_client_send(FILE *hfile_p, FILE *cfile_p)
+{
+    parameter_set *parameter_set_p = get_parameter_set();
+    char *snl = parameter_set_p->get_short_name();
+    char *snu = str_toupper(snl);
+    char *cnl = name_p;
+    char *cnu = str_toupper(cnl);
+    dispatch_slot_t *slots_p = NULL;
+    char **resp_names_pp = NULL;
+    int num_slots = 0;
+    int i;
+
+    /* Same message bags as needed by the client protocol */
+    if ((parameter_set_p->get_parameter_number(get_command_bag()->name_p) == 0) ||
+        (parameter_set_p->get_parameter_number(get_response_bag()->name_p) == 0) ||
+        (parameter_set_p->get_parameter_number(get_event_bag()->name_p) == 0))
+        goto out;
+
+    num_slots = get_dispatch_slots(this, &slots_p);
+    if (num_slots == 0)
+        goto out;
+
+    /* Commands without a response bag get no send function */
+    resp_names_pp = (char**) calloc(num_slots, sizeof(char*));
+    if (resp_names_pp == NULL)
+        goto out;
+    for (i = 0; i < num_slots; i++) {
+        char bag_name[256];
+
+        if (slots_p[i].command_p == NULL)
+            continue;
+        snprintf(bag_name, sizeof(bag_name), "%s_%s",
+                 slots_p[i].command_p->name_p,
+                 slots_p[i].category_p->get_response_bag()->name_p);
+        if (parameter_set_p->get_parameter_number(bag_name) != 0)
+            resp_names_pp[i] = strdup(bag_name);
+    }
+
+    fprintf(hfile_p,
+            "/**\n"
+            "  * Response handlers of the asynchronous client for category\n"
+            "  * %s, one slot per command. A handler gets the parameters\n"
+            "  * of the response, which are only valid during the call.\n"
+            "  * answered is false if the command was not answered (see\n"
+            "  * mpl_client_response_fp). Slots may be NULL.\n"
+            "  */\n"
+            "typedef struct {\n"
+            "    void *ctx_p; /* Passed to the handlers */\n",
+            cnl
+           );
+    for (i = 0; i < num_slots; i++) {
+        if (resp_names_pp[i] == NULL)
+            continue;
+        fprintf(hfile_p,
+                "    void (*%s)(void *ctx_p, uint32_t request_id, bool answered, mpl_bag_t *respParams);\n",
+                slots_p[i].command_p->name_p
+               );
+    }
+    fprintf(hfile_p,
+            "} %s_client_handlers_t;\n"
+            "\n",
+            cnl
+           );
+
+    for (i = 0; i < num_slots; i++) {
+        if (resp_names_pp[i] == NULL)
+            continue;
+        fprintf(hfile_p,
+                "/**\n"
+                "  * Send command %s on an asynchronous client (see\n"
+                "  * mpl_client_send()).\n"
+                "  * @param client_p (in) The client\n"
+                "  * @param reqParams (in) The command parameters (not changed)\n"
+                "  * @param handlers_p (in) Response handlers, kept until the\n"
+                "  *        command is answered\n"
+                "  * @param request_id_p (out) The request id (may be NULL)\n"
+                "  * @return 0 on success, -1 on error\n"
+                "  */\n"
+                "int %s_client_send_%s(mpl_client_t *client_p, mpl_bag_t *reqParams, const %s_client_handlers_t *handlers_p, uint32_t *request_id_p);\n"
+                "\n",
+                slots_p[i].command_p->name_p,
+                cnl,
+                slots_p[i].command_p->name_p,
+                cnl
+               );
+
+        fprintf(cfile_p,
+                "static void %s_client_response_%s(void *ctx_p, uint32_t request_id, mpl_list_t *respMsg)\n"
+                "{\n"
+                "    const %s_client_handlers_t *handlers_p = (const %s_client_handlers_t*) ctx_p;\n"
+                "    bool answered;\n"
+                "\n"
+                "    answered = (respMsg != NULL) &&\n"
+                "               %s_IS_RESPONSE(respMsg) &&\n"
+                "               (%s_GET_RESPONSE_ID(respMsg) == %s_PARAM_ID(%s));\n"
+                "    if (handlers_p->%s != NULL)\n"
+                "        handlers_p->%s(handlers_p->ctx_p, request_id, answered,\n"
+                "            answered ? %s_GET_RESPONSE_PARAMS_PTR(respMsg) : NULL);\n"
+                "    mpl_param_list_destroy(&respMsg);\n"
+                "}\n"
+                "\n"
+                "int %s_client_send_%s(mpl_client_t *client_p, mpl_bag_t *reqParams, const %s_client_handlers_t *handlers_p, uint32_t *request_id_p)\n"
+                "{\n"
+                "    mpl_param_element_t *elem_p;\n"
+                "    int ret;\n"
+                "\n"
+                "    if (handlers_p == NULL)\n"
+                "        return -1;\n"
+                "    elem_p = mpl_param_element_create_empty(%s_PARAM_ID(%s_%s));\n"
+                "    if (elem_p == NULL)\n"
+                "        return -1;\n"
+                "    /* The parameters are only borrowed for packing */\n"
+                "    elem_p->value_p = reqParams;\n"
+                "    ret = mpl_client_send(client_p,\n"
+                "                          &elem_p->list_entry,\n"
+                "                          %s_client_response_%s,\n"
+                "                          (void*) handlers_p,\n"
+                "                          request_id_p);\n"
+                "    elem_p->value_p = NULL;\n"
+                "    mpl_param_element_destroy(elem_p);\n"
+                "    return ret;\n"
+                "}\n"
+                "\n",
+                cnl,
+                slots_p[i].command_p->name_p,
+                cnl,
+                cnl,
+                cnu,
+                cnu,
+                snu,
+                resp_names_pp[i],
+                slots_p[i].command_p->name_p,
+                slots_p[i].command_p->name_p,
+                cnu,
+                cnl,
+                slots_p[i].command_p->name_p,
+                cnl,
+                snu,
+                slots_p[i].command_p->name_p,
+                slots_p[i].category_p->get_command_bag()->name_p,
+                cnl,
+                slots_p[i].command_p->name_p
+               );
+    }
+out:
+    if (resp_names_pp != NULL) {
+        for (i = 0; i < num_slots; i++)
+            free(resp_names_pp[i]);
+        free(resp_names_pp);
+    }
+    free(slots_p);
+    free(snu);
+    free(cnu);
+}
+
+void category::api_hh_dispatch(FILE *f, char *indent)
+{
+    dispatch_slot_t *slots_p;
+    int num_slots;
+    int i;
+
+    num_slots = get_dispatch_slots(this, &slots_p);
+    if (num_slots == 0)
+        return;
+
+    fprintf(f,
+            "\n"
+            "%s    /**\n"
+            "%s      * Command handlers, one slot per command. A handler gets\n"
+            "%s      * the decoded command, which is only valid during the call,\n"
+            "%s      * and returns the response. Slots may be NULL.\n"
+            "%s      */\n"
+            "%s    struct handlers {\n",
+            indent,
+            indent,
+            indent,
+            indent,
+            indent,
+            indent
+           );
+    for (i = 0; i < num_slots; i++) {
+        if (slots_p[i].command_p == NULL)
+            continue;
+        fprintf(f,
+                "%s        BAG *(*%s)(%s_%s *reqObj, void *ctx_p);\n",
+                indent,
+                slots_p[i].command_p->name_p,
+                slots_p[i].command_p->name_p,
+                slots_p[i].category_p->get_command_bag()->name_p
+               );
+    }
+    fprintf(f,
+            "%s    };\n"
+            "\n"
+            "%s    /**\n"
+            "%s      * Decode a command message and call its handler. The\n"
+            "%s      * handler is found in a table indexed by command id.\n"
+            "%s      * @return The handler's response, or NULL if inMsg is not\n"
+            "%s      *         a command or the command has no handler\n"
+            "%s      */\n"
+            "%s    BAG *dispatch(const handlers &h, mpl_list_t *inMsg, void *ctx_p);\n",
+            indent,
+            indent,
+            indent,
+            indent,
+            indent,
+            indent,
+            indent,
+            indent
+           );
+    free(slots_p);
+}
+
+void category::api_cc_dispatch(FILE *f, char *indent)
+{
+    char *snl = get_parameter_set()->get_short_name();
+    char *snu = str_toupper(snl);
+    char *cnu = str_toupper(name_p);
+    dispatch_slot_t *slots_p;
+    int num_slots;
+    int i;
+
+    num_slots = get_dispatch_slots(this, &slots_p);
+    if (num_slots == 0)
+        goto out;
+
+    fprintf(f,
+            "\n"
+            "%stypedef BAG *(*dispatch_fp)(const handlers &h, mpl_bag_t *params_p, void *ctx_p);\n"
+            "\n",
+            indent
+           );
+    for (i = 0; i < num_slots; i++) {
+        command *command_p = slots_p[i].command_p;
+        char *bag_p;
+
+        if (command_p == NULL)
+            continue;
+        bag_p = slots_p[i].category_p->get_command_bag()->name_p;
+        fprintf(f,
+                "%sstatic BAG *dispatch_%s(const handlers &h, mpl_bag_t *params_p, void *ctx_p)\n"
+                "%s{\n"
+                "%s    if (h.%s == NULL)\n"
+                "%s        return NULL;\n"
+                "%s    %s_%s reqObj(params_p);\n"
+                "%s    return h.%s(&reqObj, ctx_p);\n"
+                "%s}\n"
+                "\n",
+                indent,
+                command_p->name_p,
+                indent,
+                indent,
+                command_p->name_p,
+                indent,
+                indent,
+                command_p->name_p,
+                bag_p,
+                indent,
+                command_p->name_p,
+                indent
+               );
+    }
+    fprintf(f,
+            "%s/* Indexed by command id minus the id of the first command */\n"
+            "%sstatic const dispatch_fp dispatch_table[] = {\n",
+            indent,
+            indent
+           );
+    for (i = 0; i < num_slots; i++) {
+        if (slots_p[i].command_p == NULL)
+            fprintf(f,
+                    "%s    NULL,\n",
+                    indent
+                   );
+        else
+            fprintf(f,
+                    "%s    dispatch_%s,\n",
+                    indent,
+                    slots_p[i].command_p->name_p
+                   );
+    }
+    fprintf(f,
+            "%s};\n"
+            "\n",
+            indent
+           );
+    fprintf(f,
+            "%sBAG *dispatch(const handlers &h, mpl_list_t *inMsg, void *ctx_p)\n"
+            "%s{\n"
+            "%s    size_t index;\n"
+            "\n"
+            "%s    if (!%s_IS_COMMAND(inMsg))\n"
+            "%s        return NULL;\n"
+            "%s    index = (size_t) (%s_GET_COMMAND_ID(inMsg) - %s_PARAM_ID(%s_%s));\n"
+            "%s    if ((index >= (sizeof(dispatch_table) / sizeof(dispatch_table[0]))) ||\n"
+            "%s        (dispatch_table[index] == NULL))\n"
+            "%s        return NULL;\n"
+            "%s    return dispatch_table[index](h, %s_GET_BAG_PTR(inMsg, %s), ctx_p);\n"
+            "%s}\n",
+            indent,
+            indent,
+            indent,
+            indent,
+            cnu,
+            indent,
+            indent,
+            cnu,
+            snu,
+            slots_p[0].command_p->name_p,
+            slots_p[0].category_p->get_command_bag()->name_p,
+            indent,
+            indent,
+            indent,
+            indent,
+            snu,
+            get_command_bag()->name_p,
+            indent
+           );
+    free(slots_p);
+out:
     free(snu);
     free(cnu);
 }
@@ -1233,6 +1233,10 @@ void mpl_compiler::gc_h_header(FILE *f, char *out_name_p)
         fprintf(f, "#ifndef mplcomp_%s_hh\n", on_p);
         fprintf(f, "#define mplcomp_%s_hh\n", on_p);
     }
+    else if (codegen_mode == codegen_mode_api11) {
+        fprintf(f, "#ifndef mplcomp_%s_api11_hh\n", on_p);
+        fprintf(f, "#define mplcomp_%s_api11_hh\n", on_p);
+    }
     else {
         fprintf(f, "#ifndef mplcomp_%s_cli_h\n", on_p);
         fprintf(f, "#define mplcomp_%s_cli_h\n", on_p);
@@ -1249,7 +1253,13 @@ void mpl_compiler::gc_h_header(FILE *f, char *out_name_p)
     fprintf(f,
             "#include \"mpl_param.h\"\n"
            );
-    if (codegen_mode != codegen_mode_api) {
+    if (codegen_mode == codegen_mode_mpl) {
+        fprintf(f,
+                "#include \"mpl_client.h\"\n"
+               );
+    }
+    if ((codegen_mode != codegen_mode_api) &&
+        (codegen_mode != codegen_mode_api11)) {
         fprintf(f,
                 "#ifdef  __cplusplus\n"
                 "extern \"C\" {\n"
@@ -1274,6 +1284,13 @@ void mpl_compiler::gc_h_header(FILE *f, char *out_name_p)
         fprintf(f, "#include \"%s.h\"\n", out_name_p);
         fprintf(f, "#include <wchar.h>\n");
     }
+    else if (codegen_mode == codegen_mode_api11) {
+        fprintf(f, "#include \"%s.h\"\n", out_name_p);
+        fprintf(f, "#include <wchar.h>\n");
+        fprintf(f, "#include <string>\n");
+        fprintf(f, "#include <vector>\n");
+        fprintf(f, "#include <utility>\n");
+    }
     else {
         gc_lines(f, hlines_p, code_segment_top, codegen_mode);
     }
@@ -1287,10 +1304,14 @@ void mpl_compiler::gc_c_header(FILE *f, char *out_name_p)
     fprintf(f, "\n");
     fprintf(f, "#include <stdlib.h>\n");
     fprintf(f, "#include <stdio.h>\n");
+    fprintf(f, "#include <string.h>\n");
     fprintf(f, "#include \"mpl_param.h\"\n");
     if (codegen_mode == codegen_mode_api) {
         fprintf(f, "#include \"%s.hh\"\n", out_name_p);
     }
+    else if (codegen_mode == codegen_mode_api11) {
+        fprintf(f, "#include \"%s_api11.hh\"\n", out_name_p);
+    }
     else {
         fprintf(f, "#include \"%s.h\"\n", out_name_p);
     }
@@ -1938,7 +1959,8 @@ void mpl_compiler::gc_h_footer(FILE *f, char *out_name_p)
     if (codegen_mode == codegen_mode_mpl) {
         gc_lines(f, hlines_p, code_segment_prototypes, codegen_mode);
     }
-    if (codegen_mode != codegen_mode_api) {
+    if ((codegen_mode != codegen_mode_api) &&
+        (codegen_mode != codegen_mode_api11)) {
         fprintf(f,
                 "#ifdef  __cplusplus\n"
                 "}\n"
@@ -1950,6 +1972,8 @@ void mpl_compiler::gc_h_footer(FILE *f, char *out_name_p)
         fprintf(f, "\n#endif /* mplcomp_%s_h */\n\n", on_p);
     else if (codegen_mode == codegen_mode_api)
         fprintf(f, "\n#endif /* mplcomp_%s_hh */\n\n", on_p);
+    else if (codegen_mode == codegen_mode_api11)
+        fprintf(f, "\n#endif /* mplcomp_%s_api11_hh */\n\n", on_p);
     else
         fprintf(f, "\n#endif /* mplcomp_%s_cli_h */\n\n", on_p);
     free(on_p);
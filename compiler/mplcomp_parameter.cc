@@ -1452,6 +1452,398 @@ void int_parameter::gc_c_ranges(FILE *f, char *parameter_set_name_p)
            );
 }
 
+static void gc_c_int64_literal(FILE *f, int64_t value)
+{
+    if (value == INT64_MIN)
+        fprintf(f, "(%" PRIi64 " - 1)", value + 1);
+    else
+        fprintf(f, "%" PRIi64, value);
+}
+
+/* "static int <psl>_<method>_<pn>(<args>)", one argument per line */
+static void gc_c_method_head(FILE *f,
+                             const char *psl,
+                             const char *method_p,
+                             const char *pn,
+                             const char *args[])
+{
+    int indent = (int) (strlen("static int __(") +
+                        strlen(psl) + strlen(method_p) + strlen(pn));
+    int i;
+
+    fprintf(f, "static int %s_%s_%s(%s", psl, method_p, pn, args[0]);
+    for (i = 1; args[i] != NULL; i++)
+        fprintf(f, ",\n%*s%s", indent, "", args[i]);
+    fprintf(f, ")\n{\n");
+}
+
+static void gc_c_method_pack_head(FILE *f, const char *psl, const char *pn)
+{
+    const char *args[] = {
+        "const void* param_value_p",
+        "char *buf",
+        "size_t buflen",
+        "const mpl_param_descr2_t *descr_p",
+        "const mpl_pack_options_t *options_p",
+        NULL
+    };
+
+    gc_c_method_head(f, psl, "pack", pn, args);
+    fprintf(f,
+            "    (void)descr_p;\n"
+            "    (void)options_p;\n"
+           );
+}
+
+static void gc_c_method_packed_size_head(FILE *f, const char *psl, const char *pn)
+{
+    const char *args[] = {
+        "const void* param_value_p",
+        "const mpl_param_descr2_t *descr_p",
+        "const mpl_pack_options_t *options_p",
+        NULL
+    };
+
+    gc_c_method_head(f, psl, "packed_size", pn, args);
+    fprintf(f,
+            "    (void)descr_p;\n"
+            "    (void)options_p;\n"
+           );
+}
+
+static void gc_c_method_unpack_head(FILE *f, const char *psl, const char *pn)
+{
+    const char *args[] = {
+        "const char* value_str",
+        "void **value_pp",
+        "const mpl_param_descr2_t *descr_p",
+        "const mpl_pack_options_t *options_p",
+        "mpl_param_element_id_t unpack_context",
+        NULL
+    };
+
+    gc_c_method_head(f, psl, "unpack", pn, args);
+}
+
+static void gc_c_method_unpack_tail(FILE *f,
+                                    const char *pn,
+                                    const char *c_type_p,
+                                    const char *result_p)
+{
+    fprintf(f,
+            "    p = mpl_param_gen_malloc(sizeof(%s));\n"
+            "    if (NULL == p)\n"
+            "        return mpl_param_gen_error(E_MPL_FAILED_ALLOCATING_MEMORY, \"%s\", NULL);\n"
+            "    *p = (%s)value;\n"
+            "    *value_pp = p;\n"
+            "    return %s;\n"
+            "}\n"
+            "\n",
+            c_type_p,
+            pn,
+            c_type_p,
+            result_p
+           );
+}
+
+static void gc_c_method_clone(FILE *f,
+                              const char *psl,
+                              const char *pn,
+                              const char *c_type_p)
+{
+    const char *args[] = {
+        "void **new_value_pp",
+        "const void* old_value_p",
+        "const mpl_param_descr2_t *descr_p",
+        NULL
+    };
+
+    gc_c_method_head(f, psl, "clone", pn, args);
+    fprintf(f,
+            "    %s *p = mpl_param_gen_malloc(sizeof(%s));\n"
+            "\n"
+            "    (void)descr_p;\n"
+            "    if (NULL == p)\n"
+            "        return mpl_param_gen_error(E_MPL_FAILED_ALLOCATING_MEMORY, \"%s\", NULL);\n"
+            "    *p = *(const %s*)old_value_p;\n"
+            "    *new_value_pp = p;\n"
+            "    return 0;\n"
+            "}\n"
+            "\n",
+            c_type_p,
+            c_type_p,
+            pn,
+            c_type_p
+           );
+}
+
+int int_parameter::gc_c_methods(FILE *f, char *parameter_set_name_p)
+{
+    char *psl = parameter_set_name_p;
+    char *pn = name_p;
+    const char *ct = get_c_type();
+    int type_of_int = get_type_of_int(get_type());
+    const char *min_p = (const char *) get_property("min");
+    const char *max_p = (const char *) get_property("max");
+    mpl_list_t *nr_p = (mpl_list_t*) get_property("number_ranges");
+    const char *type_min_p = NULL;
+    const char *type_max_p = NULL;
+    int is_hex = (type_of_int > 1);
+    int is_uint_syntax = (type_of_int >= 16);
+    /* Read as an int by the methods of the type, see convert_int() */
+    int is_int_value = (type_of_int < 16) && (type_of_int != -64);
+    const char *sep_p = "";
+
+    switch (type_of_int) {
+        case 8:
+            type_min_p = "0";
+            type_max_p = "UINT8_MAX";
+            break;
+        case 16:
+            type_max_p = "UINT16_MAX";
+            break;
+        case 32:
+            type_max_p = "UINT32_MAX";
+            break;
+        case -8:
+            type_min_p = "INT8_MIN";
+            type_max_p = "INT8_MAX";
+            break;
+        case -16:
+            type_min_p = "INT16_MIN";
+            type_max_p = "INT16_MAX";
+            break;
+        default:
+            break;
+    }
+
+    fprintf(f,
+            "/* %s methods */\n",
+            pn
+           );
+
+    gc_c_method_pack_head(f, psl, pn);
+    fprintf(f,
+            "    return mpl_param_gen_pack_%s(buf, buflen, *(const %s*)param_value_p);\n"
+            "}\n"
+            "\n",
+            is_hex ? "hex" : "int",
+            ct
+           );
+
+    gc_c_method_packed_size_head(f, psl, pn);
+    fprintf(f,
+            "    return mpl_param_gen_%s_len(*(const %s*)param_value_p);\n"
+            "}\n"
+            "\n",
+            is_hex ? "hex" : "int",
+            ct
+           );
+
+    gc_c_method_unpack_head(f, psl, pn);
+    fprintf(f,
+            "    %s value;\n"
+            "    %s *p;\n"
+            "    int range_id;\n"
+            "\n"
+            "    (void)descr_p;\n"
+            "    (void)options_p;\n"
+            "    (void)unpack_context;\n",
+            is_uint_syntax ? "uint64_t" : "int64_t",
+            ct
+           );
+    if (type_of_int == -64) {
+        /* An empty value is 0, as for mpl_unpack_param_value_sint64() */
+        fprintf(f,
+                "    if (*value_str == '\\0')\n"
+                "        value = 0;\n"
+                "    else if (mpl_param_gen_convert_int(value_str, &value) < 0)\n"
+                "        return -1;\n"
+               );
+    } else {
+        fprintf(f,
+                "    if (mpl_param_gen_convert_%s(value_str, &value) < 0)\n"
+                "        return -1;\n",
+                is_uint_syntax ? "uint" : "int"
+               );
+    }
+    if (is_int_value) {
+        fprintf(f,
+                "    value = (int)value;\n"
+               );
+    }
+
+    /* Type range, max and min in one check */
+    if (type_min_p || type_max_p || min_p || max_p) {
+        fprintf(f,
+                "    if (");
+        if (type_min_p) {
+            fprintf(f, "%s(value < %s)", sep_p, type_min_p);
+            sep_p = " ||\n        ";
+        }
+        if (type_max_p) {
+            fprintf(f, "%s(value > %s)", sep_p, type_max_p);
+            sep_p = " ||\n        ";
+        }
+        if (max_p) {
+            fprintf(f, "%s(value > (%s)(%s))", sep_p, ct, max_p);
+            sep_p = " ||\n        ";
+        }
+        if (min_p) {
+            fprintf(f, "%s(value < (%s)(%s))", sep_p, ct, min_p);
+            sep_p = " ||\n        ";
+        }
+        fprintf(f,
+                ")\n"
+                "        return mpl_param_gen_error(E_MPL_FAILED_OPERATION, \"%s\", value_str);\n",
+                pn
+               );
+    }
+
+    if (nr_p == NULL) {
+        fprintf(f,
+                "    range_id = 0;\n"
+               );
+    } else {
+        /* Same order as the range table, the first match wins */
+        mpl_list_t *tmp_p;
+        number_range *number_range_p;
+        enum_parameter *number_range_parameter_p =
+            (enum_parameter*) parameter_set_p->find_parameter(parameter_set_p->range_id_p->value_p);
+        assert(number_range_parameter_p);
+        int num_ranges = 0;
+        sep_p = "    ";
+
+        MPL_LIST_FOR_EACH(nr_p, tmp_p) {
+            number_range_p = LISTABLE_PTR(tmp_p, number_range);
+
+            mpl_list_t *tmp_p;
+            integer_range *integer_range_p;
+            MPL_LIST_FOR_EACH(number_range_p->range_list_p, tmp_p) {
+                integer_range_p = LISTABLE_PTR(tmp_p, integer_range);
+                enum_value *enum_value_p =
+                    number_range_parameter_p->get_enum_value(number_range_p->name_p);
+                assert(enum_value_p);
+                assert(enum_value_p->get_value_p());
+                fprintf(f, "%sif (((int64_t)value >= ", sep_p);
+                gc_c_int64_literal(f, *integer_range_p->get_first_p());
+                fprintf(f, ") && ((int64_t)value <= ");
+                gc_c_int64_literal(f, *integer_range_p->get_last_p());
+                fprintf(f,
+                        "))\n"
+                        "        range_id = %" PRIi64 ";\n",
+                        *enum_value_p->get_value_p()
+                       );
+                sep_p = "    else ";
+                num_ranges++;
+            }
+        }
+        if (num_ranges)
+            fprintf(f,
+                    "    else\n"
+                    "        return mpl_param_gen_error(E_MPL_FAILED_OPERATION, \"%s\", value_str);\n",
+                    pn
+                   );
+        else
+            fprintf(f,
+                    "    range_id = 0;\n"
+                   );
+    }
+    fprintf(f,
+            "\n"
+           );
+    gc_c_method_unpack_tail(f, pn, ct, "range_id");
+
+    gc_c_method_clone(f, psl, pn, ct);
+    return 1;
+}
+
+int string_parameter::gc_c_methods(FILE *f, char *parameter_set_name_p)
+{
+    char *psl = parameter_set_name_p;
+    char *pn = name_p;
+    const char *min_p = (const char *) get_property("min");
+    const char *max_p = (const char *) get_property("max");
+    const char *clone_args[] = {
+        "void **new_value_pp",
+        "const void* old_value_p",
+        "const mpl_param_descr2_t *descr_p",
+        NULL
+    };
+
+    if (strcmp(get_type(), "string"))
+        return 0;
+
+    fprintf(f,
+            "/* %s methods */\n"
+            "#define %s_pack_%s mpl_pack_param_value_string\n"
+            "#define %s_packed_size_%s mpl_packed_size_param_value_string\n"
+            "\n",
+            pn,
+            psl, pn,
+            psl, pn
+           );
+
+    /* One pass for the length, escaped values take the generic path */
+    gc_c_method_unpack_head(f, psl, pn);
+    fprintf(f,
+            "    size_t len = strcspn(value_str, \"\\\\\");\n"
+            "    char *p;\n"
+            "\n"
+            "    if (value_str[len] != '\\0')\n"
+            "        return mpl_unpack_param_value_string(value_str, value_pp, descr_p,\n"
+            "                                             options_p, unpack_context);\n"
+           );
+    if (max_p || min_p) {
+        fprintf(f,
+                "    if (");
+        if (max_p)
+            fprintf(f, "((int64_t)len > (int64_t)(%s))", max_p);
+        if (max_p && min_p)
+            fprintf(f, " ||\n        ");
+        if (min_p)
+            fprintf(f, "((int64_t)len < (int64_t)(%s))", min_p);
+        fprintf(f,
+                ")\n"
+                "        return mpl_param_gen_error(E_MPL_FAILED_OPERATION, \"%s\", value_str);\n",
+                pn
+               );
+    }
+    fprintf(f,
+            "    if (options_p->string_views) {\n"
+            "        *value_pp = (void*)value_str;\n"
+            "        return 0;\n"
+            "    }\n"
+            "    p = mpl_param_gen_malloc(len + 1);\n"
+            "    if (NULL == p)\n"
+            "        return mpl_param_gen_error(E_MPL_FAILED_ALLOCATING_MEMORY, \"%s\", NULL);\n"
+            "    memcpy(p, value_str, len + 1);\n"
+            "    *value_pp = p;\n"
+            "    return 0;\n"
+            "}\n"
+            "\n",
+            pn
+           );
+
+    gc_c_method_head(f, psl, "clone", pn, clone_args);
+    fprintf(f,
+            "    size_t size = strlen((const char*)old_value_p) + 1;\n"
+            "    char *p = mpl_param_gen_malloc(size);\n"
+            "\n"
+            "    (void)descr_p;\n"
+            "    if (NULL == p)\n"
+            "        return mpl_param_gen_error(E_MPL_FAILED_ALLOCATING_MEMORY, \"%s\", NULL);\n"
+            "    memcpy(p, old_value_p, size);\n"
+            "    *new_value_pp = p;\n"
+            "    return 0;\n"
+            "}\n"
+            "\n",
+            pn
+           );
+    return 1;
+}
+
+
 void enum_parameter::gc_h_enum(FILE *f, char *parameter_set_name_p)
 {
     mpl_list_t *tmp_p;
@@ -1604,7 +1996,12 @@ void enum_parameter::gc_h_enum(FILE *f, char *parameter_set_name_p)
     if (!external_parent) {
         if (parent_p && (this->enum_values_p == NULL)) {
             fprintf(f,
-                    "#define %s_names_%s %s_names_%s\n\n",
+                    "#define %s_names_%s %s_names_%s\n"
+                    "#define %s_enum_table_%s %s_enum_table_%s\n\n",
+                    psl,
+                    pn,
+                    ((parameter*)parent_p)->parameter_set_p->name_p,
+                    parent_p->name_p,
                     psl,
                     pn,
                     ((parameter*)parent_p)->parameter_set_p->name_p,
@@ -1613,7 +2010,10 @@ void enum_parameter::gc_h_enum(FILE *f, char *parameter_set_name_p)
         }
         else
             fprintf(f,
-                    "extern const mpl_enum_value_t %s_names_%s[];\n",
+                    "extern const mpl_enum_value_t %s_names_%s[];\n"
+                    "extern const mpl_enum_table_t %s_enum_table_%s;\n",
+                    psl,
+                    pn,
                     psl,
                     pn
                    );
@@ -1627,85 +2027,667 @@ void enum_parameter::gc_h_enum(FILE *f, char *parameter_set_name_p)
         free(epsu);
 }
 
-void enum_parameter::gc_c_enum(FILE *f, char *parameter_set_name_p)
+/* FNV-1a, the same as name_hash() in mpl_param.c */
+static uint32_t enum_table_name_hash(const char *name_p)
 {
-    mpl_list_t *tmp_p;
-    int external_parent = (external_parent_parameter_name_p != NULL);
-    char *epn = external_parent_parameter_name_p;
-    char *epsl = external_parent_parameter_set_name_p;
-    char *epsu = NULL;
-    char *psl = parameter_set_name_p;
-    char *psu = str_toupper(psl);
-    char *pn = name_p;
-
-    if (epsl)
-        epsu = str_toupper(epsl);
+    uint32_t hash = 2166136261u;
 
-    fprintf(f,
-            "/* %s names%s */\n",
-            name_p,
-            parent_p || external_parent ? " (inherited)" : ""
-           );
+    for (; *name_p != '\0'; name_p++) {
+        hash ^= (uint8_t) *name_p;
+        hash *= 16777619u;
+    }
+    return hash;
+}
 
-    if (parent_p && (enum_values_p == NULL)) {
-        fprintf(f,
-                "#define %s_names_%s %s_names_%s\n\n",
-                psl,
-                pn,
-                ((parameter*)parent_p)->parameter_set_p->name_p,
-                parent_p->name_p
-               );
-        free(psu);
-        if (epsu)
-            free(epsu);
-        return;
+/*
+ * Perfect hash of names (hash and displace): the names are put in
+ * buckets on hash & (num_buckets - 1), and the buckets, largest first,
+ * are given the first displacement that moves all their names to free
+ * slots. Returns 0 on success, -1 if no displacements were found.
+ */
+static int enum_table_build_names(const uint32_t *hashes_p,
+                                  int num_names,
+                                  uint32_t num_buckets,
+                                  uint32_t num_slots,
+                                  uint32_t *displace_p,
+                                  int *slots_p)
+{
+    int *bucket_size_p = (int *) calloc(num_buckets, sizeof(int));
+    uint32_t *order_p = (uint32_t *) calloc(num_buckets, sizeof(uint32_t));
+    uint32_t *bucket_slots_p = (uint32_t *) calloc(num_names, sizeof(uint32_t));
+    uint32_t bucket;
+    uint32_t displace;
+    uint32_t slot;
+    uint32_t i;
+    int n;
+    int k;
+    int j;
+    int result = 0;
+
+    for (i = 0; i < num_slots; i++)
+        slots_p[i] = -1;
+    for (n = 0; n < num_names; n++)
+        bucket_size_p[hashes_p[n] & (num_buckets - 1)]++;
+
+    /* Insertion sort of the buckets, largest first */
+    for (i = 0; i < num_buckets; i++) {
+        for (j = (int) i;
+             (j > 0) && (bucket_size_p[order_p[j - 1]] < bucket_size_p[i]);
+             j--) {
+            order_p[j] = order_p[j - 1];
+        }
+        order_p[j] = i;
     }
 
-    if (external_parent) {
-        fprintf(f,
-                "#define %s_names_%s %s_names_%s\n\n",
-                psl,
-                pn,
-                epsl,
-                epn
-               );
-        free(psu);
-        if (epsu)
-            free(epsu);
-        return;
+    for (i = 0; (i < num_buckets) && (result == 0); i++) {
+        bucket = order_p[i];
+        displace_p[bucket] = 0;
+        if (bucket_size_p[bucket] == 0)
+            continue;
+
+        for (displace = 0; displace < (1u << 20); displace++) {
+            k = 0;
+            for (n = 0; n < num_names; n++) {
+                if ((hashes_p[n] & (num_buckets - 1)) != bucket)
+                    continue;
+                slot = MPL_ENUM_TABLE_SLOT(hashes_p[n], displace) & (num_slots - 1);
+                if (slots_p[slot] >= 0)
+                    break;
+                for (j = 0; j < k; j++)
+                    if (bucket_slots_p[j] == slot)
+                        break;
+                if (j < k)
+                    break;
+                bucket_slots_p[k++] = slot;
+            }
+            if (n == num_names)
+                break;
+        }
+        if (displace == (1u << 20)) {
+            result = -1;
+            break;
+        }
+
+        displace_p[bucket] = displace;
+        for (n = 0; n < num_names; n++) {
+            if ((hashes_p[n] & (num_buckets - 1)) != bucket)
+                continue;
+            slot = MPL_ENUM_TABLE_SLOT(hashes_p[n], displace) & (num_slots - 1);
+            slots_p[slot] = n;
+        }
     }
 
+    free(bucket_size_p);
+    free(order_p);
+    free(bucket_slots_p);
+    return result;
+}
+
+static void gc_c_int_array(FILE *f,
+                           const char *c_type_p,
+                           const char *psl,
+                           const char *what_p,
+                           const char *pn,
+                           const int64_t *values_p,
+                           int num_values)
+{
+    int i;
+
     fprintf(f,
-            "#define %s_%s_VALUE_ELEMENT(NAME, VALUE) { #NAME, VALUE }, \n",
-            psu,
-            pn
-           );
-    fprintf(f,
-            "const mpl_enum_value_t %s_names_%s[] =\n"
-            "{\n",
+            "static const %s %s_%s_%s[] =\n"
+            "{",
+            c_type_p,
             psl,
+            what_p,
             pn
            );
+    for (i = 0; i < num_values; i++)
+        fprintf(f,
+                "%s%" PRIi64 "%s",
+                (i % 8) ? " " : "\n  ",
+                values_p[i],
+                (i < num_values - 1) ? "," : "\n"
+               );
     fprintf(f,
-            "  %s_%sS\n"
-            "};\n",
-            psu,
-            pn
-           );
-    fprintf(f,
-            "#undef %s_%s_VALUE_ELEMENT\n",
-            psu,
-            pn
-           );
-    fprintf(f,
-            "\n"
+            "};\n"
            );
-    free(psu);
-    if (epsu)
-        free(epsu);
 }
 
-bool bag_parameter::have_own_parameters()
+/*
+ * Lookup tables for the values of an enum (mpl_enum_table_t), positions
+ * refer to the names array, which has the values in the same order.
+ */
+static void gc_c_enum_table(FILE *f,
+                            const char *psl,
+                            const char *pn,
+                            mpl_list_t *values_p)
+{
+    mpl_list_t *tmp_p;
+    enum_value *enum_value_p;
+    enum_value **names_pp;
+    uint32_t *hashes_p;
+    int *name_pos_p;
+    int64_t *out_p;
+    int *by_value_p;
+    int num_values = 0;
+    int num_names = 0;
+    int num_by_value = 0;
+    uint32_t num_buckets = 1;
+    uint32_t num_slots = 1;
+    uint32_t *displace_p = NULL;
+    int *slots_p = NULL;
+    int have_names = 0;
+    int dense = 0;
+    uint64_t span = 0;
+    int64_t value;
+    int pos;
+    int n;
+    int k;
+    uint32_t i;
+
+    MPL_LIST_FOR_EACH(values_p, tmp_p)
+        num_values++;
+
+    if (num_values == 0) {
+        fprintf(f,
+                "const mpl_enum_table_t %s_enum_table_%s =\n"
+                "{\n"
+                "  NULL, 0,\n"
+                "  NULL, 0,\n"
+                "  0, false,\n"
+                "  NULL, 0\n"
+                "};\n\n",
+                psl,
+                pn
+               );
+        return;
+    }
+
+    names_pp = (enum_value **) calloc(num_values, sizeof(enum_value *));
+    hashes_p = (uint32_t *) calloc(num_values, sizeof(uint32_t));
+    name_pos_p = (int *) calloc(num_values, sizeof(int));
+    by_value_p = (int *) calloc(num_values, sizeof(int));
+
+    /* Names, the first of duplicates (like a linear search finds) */
+    pos = 0;
+    MPL_LIST_FOR_EACH(values_p, tmp_p) {
+        enum_value_p = LISTABLE_PTR(tmp_p, enum_value);
+        names_pp[pos] = enum_value_p;
+        for (k = 0; k < num_names; k++)
+            if (!strcmp(names_pp[name_pos_p[k]]->name_p, enum_value_p->name_p))
+                break;
+        if (k == num_names) {
+            hashes_p[num_names] = enum_table_name_hash(enum_value_p->name_p);
+            name_pos_p[num_names++] = pos;
+        }
+        pos++;
+    }
+
+    /* Equal hashes can not be told apart by any displacement */
+    have_names = 1;
+    for (n = 0; (n < num_names) && have_names; n++)
+        for (k = 0; k < n; k++)
+            if (hashes_p[k] == hashes_p[n]) {
+                have_names = 0;
+                break;
+            }
+
+    while (num_buckets < (uint32_t) ((num_names + 1) / 2))
+        num_buckets *= 2;
+    while (num_slots < (uint32_t) (num_names + num_names / 4 + 1))
+        num_slots *= 2;
+    for (; have_names; num_slots *= 2) {
+        free(displace_p);
+        free(slots_p);
+        displace_p = (uint32_t *) calloc(num_buckets, sizeof(uint32_t));
+        slots_p = (int *) calloc(num_slots, sizeof(int));
+        if (enum_table_build_names(hashes_p,
+                                   num_names,
+                                   num_buckets,
+                                   num_slots,
+                                   displace_p,
+                                   slots_p) == 0)
+            break;
+        if (num_slots > (uint32_t) (8 * num_names)) {
+            fprintf(stderr,
+                    "%s: no perfect hash found for the names\n",
+                    pn
+                   );
+            have_names = 0;
+        }
+    }
+
+    /* Values: first position of each, sorted on value */
+    for (n = 0; n < num_values; n++) {
+        value = *names_pp[n]->value_p;
+        for (k = 0; k < num_by_value; k++)
+            if (*names_pp[by_value_p[k]]->value_p == value)
+                break;
+        if (k < num_by_value)
+            continue;
+        for (k = num_by_value;
+             (k > 0) && (*names_pp[by_value_p[k - 1]]->value_p > value);
+             k--) {
+            by_value_p[k] = by_value_p[k - 1];
+        }
+        by_value_p[k] = n;
+        num_by_value++;
+    }
+    /* A dense table when at most half of it is unused */
+    span = (uint64_t) *names_pp[by_value_p[num_by_value - 1]]->value_p -
+        (uint64_t) *names_pp[by_value_p[0]]->value_p + 1;
+    dense = (span != 0) && (span <= (uint64_t) (2 * num_by_value));
+
+    fprintf(f,
+            "/* %s lookup tables */\n",
+            pn
+           );
+    if (have_names) {
+        out_p = (int64_t *) calloc(num_slots, sizeof(int64_t));
+        for (i = 0; i < num_buckets; i++)
+            out_p[i] = displace_p[i];
+        gc_c_int_array(f, "uint32_t", psl, "enum_displace", pn, out_p, num_buckets);
+        for (i = 0; i < num_slots; i++)
+            out_p[i] = (slots_p[i] < 0) ? -1 : name_pos_p[slots_p[i]];
+        gc_c_int_array(f, "int", psl, "enum_slots", pn, out_p, num_slots);
+        free(out_p);
+    }
+    if (dense) {
+        out_p = (int64_t *) calloc(span, sizeof(int64_t));
+        for (i = 0; i < span; i++)
+            out_p[i] = -1;
+        for (k = 0; k < num_by_value; k++)
+            out_p[(uint64_t) *names_pp[by_value_p[k]]->value_p -
+                  (uint64_t) *names_pp[by_value_p[0]]->value_p] = by_value_p[k];
+        gc_c_int_array(f, "int", psl, "enum_by_value", pn, out_p, (int) span);
+        free(out_p);
+    }
+    else {
+        out_p = (int64_t *) calloc(num_by_value, sizeof(int64_t));
+        for (k = 0; k < num_by_value; k++)
+            out_p[k] = by_value_p[k];
+        gc_c_int_array(f, "int", psl, "enum_by_value", pn, out_p, num_by_value);
+        free(out_p);
+    }
+
+    fprintf(f,
+            "const mpl_enum_table_t %s_enum_table_%s =\n"
+            "{\n",
+            psl,
+            pn
+           );
+    if (have_names)
+        fprintf(f,
+                "  %s_enum_displace_%s, %u,\n"
+                "  %s_enum_slots_%s, %u,\n",
+                psl, pn, num_buckets - 1,
+                psl, pn, num_slots - 1
+               );
+    else
+        fprintf(f,
+                "  NULL, 0,\n"
+                "  NULL, 0,\n"
+               );
+    fprintf(f, "  ");
+    gc_c_int64_literal(f, *names_pp[by_value_p[0]]->value_p);
+    fprintf(f,
+            ", %s,\n"
+            "  %s_enum_by_value_%s, %d\n"
+            "};\n"
+            "\n",
+            dense ? "true" : "false",
+            psl,
+            pn,
+            dense ? (int) span : num_by_value
+           );
+
+    free(names_pp);
+    free(hashes_p);
+    free(name_pos_p);
+    free(by_value_p);
+    free(displace_p);
+    free(slots_p);
+}
+
+void enum_parameter::gc_c_enum(FILE *f, char *parameter_set_name_p)
+{
+    mpl_list_t *tmp_p;
+    int external_parent = (external_parent_parameter_name_p != NULL);
+    char *epn = external_parent_parameter_name_p;
+    char *epsl = external_parent_parameter_set_name_p;
+    char *epsu = NULL;
+    char *psl = parameter_set_name_p;
+    char *psu = str_toupper(psl);
+    char *pn = name_p;
+
+    if (epsl)
+        epsu = str_toupper(epsl);
+
+    fprintf(f,
+            "/* %s names%s */\n",
+            name_p,
+            parent_p || external_parent ? " (inherited)" : ""
+           );
+
+    if (parent_p && (enum_values_p == NULL)) {
+        fprintf(f,
+                "#define %s_names_%s %s_names_%s\n"
+                "#define %s_enum_table_%s %s_enum_table_%s\n\n",
+                psl,
+                pn,
+                ((parameter*)parent_p)->parameter_set_p->name_p,
+                parent_p->name_p,
+                psl,
+                pn,
+                ((parameter*)parent_p)->parameter_set_p->name_p,
+                parent_p->name_p
+               );
+        free(psu);
+        if (epsu)
+            free(epsu);
+        return;
+    }
+
+    if (external_parent) {
+        fprintf(f,
+                "#define %s_names_%s %s_names_%s\n"
+                "#define %s_enum_table_%s %s_enum_table_%s\n\n",
+                psl,
+                pn,
+                epsl,
+                epn,
+                psl,
+                pn,
+                epsl,
+                epn
+               );
+        free(psu);
+        if (epsu)
+            free(epsu);
+        return;
+    }
+
+    fprintf(f,
+            "#define %s_%s_VALUE_ELEMENT(NAME, VALUE) { #NAME, VALUE }, \n",
+            psu,
+            pn
+           );
+    fprintf(f,
+            "const mpl_enum_value_t %s_names_%s[] =\n"
+            "{\n",
+            psl,
+            pn
+           );
+    fprintf(f,
+            "  %s_%sS\n"
+            "};\n",
+            psu,
+            pn
+           );
+    fprintf(f,
+            "#undef %s_%s_VALUE_ELEMENT\n",
+            psu,
+            pn
+           );
+    fprintf(f,
+            "\n"
+           );
+    gc_c_enum_table(f, psl, pn, (mpl_list_t *) get_property("enum_values"));
+    free(psu);
+    if (epsu)
+        free(epsu);
+}
+
+/* The first enum value with this name (or value), duplicates are skipped */
+static int enum_value_is_first(mpl_list_t *enum_values_p,
+                               enum_value *enum_value_p,
+                               int by_name)
+{
+    mpl_list_t *tmp_p;
+    enum_value *other_p;
+
+    MPL_LIST_FOR_EACH(enum_values_p, tmp_p) {
+        other_p = LISTABLE_PTR(tmp_p, enum_value);
+        if (other_p == enum_value_p)
+            return 1;
+        if (by_name && !strcmp(other_p->name_p, enum_value_p->name_p))
+            return 0;
+        if (!by_name && (*other_p->value_p == *enum_value_p->value_p))
+            return 0;
+    }
+    return 1;
+}
+
+/*
+ * Match value_str against names (which have the first k characters of
+ * value_str in common): common characters with strncmp(), then a switch
+ * on the first character that tells them apart, sets value or clears
+ * named.
+ */
+static void gc_c_enum_name_match(FILE *f,
+                                 enum_value **names_pp,
+                                 int num_names,
+                                 int k,
+                                 int indent)
+{
+    enum_value **group_pp;
+    int common;
+    int i;
+    int j;
+    int n;
+
+    if (num_names == 1) {
+        if (names_pp[0]->name_p[k] == '\0')
+            fprintf(f,
+                    "%*sif (value_str[%d] == '\\0')\n",
+                    indent, "",
+                    k
+                   );
+        else
+            fprintf(f,
+                    "%*sif (!strcmp(value_str + %d, \"%s\"))\n",
+                    indent, "",
+                    k,
+                    names_pp[0]->name_p + k
+                   );
+        fprintf(f, "%*svalue = ", indent + 4, "");
+        gc_c_int64_literal(f, *names_pp[0]->value_p);
+        fprintf(f,
+                ";\n"
+                "%*selse\n"
+                "%*snamed = 0;\n",
+                indent, "",
+                indent + 4, ""
+               );
+        return;
+    }
+
+    /* Characters that all the names have in common */
+    for (common = 0; names_pp[0]->name_p[k + common] != '\0'; common++) {
+        for (i = 1; i < num_names; i++)
+            if (names_pp[i]->name_p[k + common] != names_pp[0]->name_p[k + common])
+                break;
+        if (i < num_names)
+            break;
+    }
+    if (common > 0) {
+        fprintf(f,
+                "%*sif (strncmp(value_str + %d, \"%.*s\", %d))\n"
+                "%*snamed = 0;\n"
+                "%*selse {\n",
+                indent, "",
+                k,
+                common,
+                names_pp[0]->name_p + k,
+                common,
+                indent + 4, "",
+                indent, ""
+               );
+        gc_c_enum_name_match(f, names_pp, num_names, k + common, indent + 4);
+        fprintf(f, "%*s}\n", indent, "");
+        return;
+    }
+
+    fprintf(f,
+            "%*sswitch (value_str[%d]) {\n",
+            indent, "",
+            k
+           );
+    /* One case per character, in the order of the names */
+    for (i = 0; i < num_names; i++) {
+        for (j = 0; j < i; j++)
+            if (names_pp[j]->name_p[k] == names_pp[i]->name_p[k])
+                break;
+        if (j < i)
+            continue;
+
+        if (names_pp[i]->name_p[k] == '\0') {
+            fprintf(f, "%*scase '\\0':\n", indent + 4, "");
+            fprintf(f, "%*svalue = ", indent + 8, "");
+            gc_c_int64_literal(f, *names_pp[i]->value_p);
+            fprintf(f, ";\n%*sbreak;\n", indent + 8, "");
+            continue;
+        }
+
+        group_pp = (enum_value **) calloc(num_names, sizeof(enum_value *));
+        n = 0;
+        for (j = i; j < num_names; j++)
+            if (names_pp[j]->name_p[k] == names_pp[i]->name_p[k])
+                group_pp[n++] = names_pp[j];
+        fprintf(f, "%*scase '%c':\n", indent + 4, "", names_pp[i]->name_p[k]);
+        gc_c_enum_name_match(f, group_pp, n, k + 1, indent + 8);
+        fprintf(f, "%*sbreak;\n", indent + 8, "");
+        free(group_pp);
+    }
+    fprintf(f,
+            "%*sdefault:\n"
+            "%*snamed = 0;\n"
+            "%*sbreak;\n"
+            "%*s}\n",
+            indent + 4, "",
+            indent + 8, "",
+            indent + 8, "",
+            indent, ""
+           );
+}
+
+int enum_parameter::gc_c_methods(FILE *f, char *parameter_set_name_p)
+{
+    char *psl = parameter_set_name_p;
+    char *pn = name_p;
+    mpl_list_t *values_p = (mpl_list_t *) get_property("enum_values");
+    mpl_list_t *tmp_p;
+    enum_value *enum_value_p;
+    char ct[255];
+    enum_value **names_pp;
+    int num_names;
+    int pass;
+
+    /* The values of an external parent are not known here */
+    if ((external_parent_parameter_name_p != NULL) || (values_p == NULL))
+        return 0;
+
+    sprintf(ct, "%s_%s_t", psl, pn);
+
+    fprintf(f,
+            "/* %s methods */\n",
+            pn
+           );
+
+    /* Pack and packed size: the names are rendered at compile time */
+    for (pass = 0; pass < 2; pass++) {
+        if (pass == 0)
+            gc_c_method_pack_head(f, psl, pn);
+        else
+            gc_c_method_packed_size_head(f, psl, pn);
+        fprintf(f,
+                "    switch ((int64_t)*(const %s*)param_value_p) {\n",
+                ct
+               );
+        MPL_LIST_FOR_EACH(values_p, tmp_p) {
+            enum_value_p = LISTABLE_PTR(tmp_p, enum_value);
+            if (!enum_value_is_first(values_p, enum_value_p, 0))
+                continue;
+            fprintf(f, "        case ");
+            gc_c_int64_literal(f, *enum_value_p->value_p);
+            if (pass == 0)
+                fprintf(f,
+                        ":\n"
+                        "            return mpl_param_gen_pack_text(buf, buflen, \"=%s\", %d);\n",
+                        enum_value_p->name_p,
+                        (int) strlen(enum_value_p->name_p) + 1
+                       );
+            else
+                fprintf(f,
+                        ":\n"
+                        "            return %d;\n",
+                        (int) strlen(enum_value_p->name_p) + 1
+                       );
+        }
+        fprintf(f,
+                "        default:\n"
+                "            return mpl_param_gen_error(E_MPL_FAILED_OPERATION, \"%s\", NULL);\n"
+                "    }\n"
+                "}\n"
+                "\n",
+                pn
+               );
+    }
+
+    /* Unpack: names by a character trie, then numeric values */
+    gc_c_method_unpack_head(f, psl, pn);
+    fprintf(f,
+            "    int64_t value = 0;\n"
+            "    int named = 1;\n"
+            "    %s *p;\n"
+            "\n"
+            "    (void)descr_p;\n"
+            "    (void)options_p;\n"
+            "    (void)unpack_context;\n",
+            ct
+           );
+    num_names = 0;
+    MPL_LIST_FOR_EACH(values_p, tmp_p)
+        num_names++;
+    names_pp = (enum_value **) calloc(num_names, sizeof(enum_value *));
+    num_names = 0;
+    MPL_LIST_FOR_EACH(values_p, tmp_p) {
+        enum_value_p = LISTABLE_PTR(tmp_p, enum_value);
+        if (enum_value_is_first(values_p, enum_value_p, 1))
+            names_pp[num_names++] = enum_value_p;
+    }
+    gc_c_enum_name_match(f, names_pp, num_names, 0, 4);
+    free(names_pp);
+    fprintf(f,
+            "    if (!named) {\n"
+            "        if (mpl_param_gen_convert_int(value_str, &value) < 0)\n"
+            "            return -1;\n"
+            "        switch (value) {\n"
+           );
+    MPL_LIST_FOR_EACH(values_p, tmp_p) {
+        enum_value_p = LISTABLE_PTR(tmp_p, enum_value);
+        if (!enum_value_is_first(values_p, enum_value_p, 0))
+            continue;
+        fprintf(f, "            case ");
+        gc_c_int64_literal(f, *enum_value_p->value_p);
+        fprintf(f, ":\n");
+    }
+    fprintf(f,
+            "                break;\n"
+            "            default:\n"
+            "                return mpl_param_gen_error(E_MPL_FAILED_OPERATION, \"%s\", value_str);\n"
+            "        }\n"
+            "    }\n"
+            "\n",
+            pn
+           );
+    gc_c_method_unpack_tail(f, pn, ct, "0");
+
+    gc_c_method_clone(f, psl, pn, ct);
+    return 1;
+}
+
+bool bag_parameter::have_own_parameters()
 {
     parameter_list_entry *parameter_list_entry_p;
     mpl_list_t *tmp_p;
@@ -3872,32 +4854,832 @@ void bag_parameter::gc_c_bag(FILE *f)
     free(lnu);
 }
 
-mpl_list_t *bag_parameter::get_possible_parameters()
+/* Positive decimal number, or -1 (e.g. a max given by name) */
+static int struct_number(const char *str_p)
 {
-    mpl_list_t *plist_p = NULL;
-    mpl_list_t *tmp_p;
-    MPL_LIST_FOR_EACH((mpl_list_t*)get_property("parameter_list"), tmp_p) {
-        parameter_list_entry *parameter_list_entry_p = LISTABLE_PTR(tmp_p, parameter_list_entry);
-        parameter *parameter_p = parameter_list_entry_p->parameter_set_p->find_parameter(parameter_list_entry_p->parameter_name_p);
-        object_container *container_p = new object_container(parameter_p);
-        container_p->append_to(plist_p);
-        mpl_list_append(&plist_p, parameter_p->get_flat_child_list());
-    }
-    return plist_p;
+    char *end_p;
+    long n;
+
+    if ((str_p == NULL) || !isdigit(*str_p))
+        return -1;
+    n = strtol(str_p, &end_p, 10);
+    if ((*end_p != '\0') || (n <= 0) || (n > 100000))
+        return -1;
+    return (int) n;
 }
 
-bool bag_parameter::param_is_field_or_subfield(parameter *param_p)
-{
-    mpl_list_t *tmp_p;
-    mpl_list_t *plist_p = get_possible_parameters();
-    MPL_LIST_FOR_EACH(plist_p, tmp_p) {
-        object_container *container_p = LISTABLE_PTR(tmp_p, object_container);
-        parameter *parameter_p = (parameter*) container_p->object_p;
+/* How a bag field is stored in the native struct */
+typedef enum {
+    struct_field_value,
+    struct_field_string,
+    struct_field_array,         /* Elements inline, with <field>_len */
+    struct_field_ptr,           /* Allocated by unpack */
+    struct_field_bag
+} struct_field_kind_t;
 
-        if (parameter_p == param_p) {
-            DELETE_LISTABLE_LIST(&plist_p, object_container);
-            return true;
-        }
+typedef struct {
+    parameter_list_entry *entry_p;
+    parameter *parameter_p;
+    struct_field_kind_t kind;
+    char type[100];
+    char suffix[20];
+    char paramid[200];
+    int max;
+} struct_field_t;
+
+static void struct_field(parameter_list_entry *entry_p, struct_field_t *field_p)
+{
+    parameter *parameter_p;
+    int max;
+
+    parameter_p = entry_p->parameter_set_p->find_parameter(entry_p->parameter_name_p);
+    field_p->entry_p = entry_p;
+    field_p->parameter_p = parameter_p;
+    field_p->suffix[0] = '\0';
+    field_p->max = 0;
+    sprintf(field_p->paramid,
+            "%s_paramid_%s",
+            parameter_p->parameter_set_p->name_p,
+            parameter_p->name_p
+           );
+
+    if (parameter_p->is_bag()) {
+        field_p->kind = struct_field_bag;
+        sprintf(field_p->type,
+                "%s_%s_struct_t ",
+                parameter_p->parameter_set_p->name_p,
+                parameter_p->name_p
+               );
+    }
+    else if (parameter_p->is_string()) {
+        max = struct_number((char*) parameter_p->get_property("max"));
+        if (max > 0) {
+            field_p->kind = struct_field_string;
+            strcpy(field_p->type, "char ");
+            sprintf(field_p->suffix, "[%d]", max + 1);
+        }
+        else {
+            field_p->kind = struct_field_ptr;
+            strcpy(field_p->type, "char *");
+        }
+    }
+    else if (parameter_p->is_array()) {
+        max = struct_number((char*) parameter_p->get_property("max"));
+        if ((max > 0) && !entry_p->multiple) {
+            /* uintN_array holds uintN_t elements */
+            field_p->kind = struct_field_array;
+            field_p->max = max;
+            sprintf(field_p->type,
+                    "%.*s_t ",
+                    (int) (strlen(parameter_p->get_type()) - strlen("_array")),
+                    parameter_p->get_type()
+                   );
+            sprintf(field_p->suffix, "[%d]", max);
+        }
+        else {
+            field_p->kind = struct_field_ptr;
+            sprintf(field_p->type, "%s *", parameter_p->get_c_type());
+        }
+    }
+    else if (parameter_p->is_tuple()) {
+        field_p->kind = struct_field_ptr;
+        sprintf(field_p->type, "%s *", parameter_p->get_c_type());
+    }
+    else if (parameter_p->is_enum()) {
+        field_p->kind = struct_field_value;
+        sprintf(field_p->type, "%s ", param_c_type(parameter_p));
+    }
+    else if (parameter_p->is_addr()) {
+        field_p->kind = struct_field_value;
+        strcpy(field_p->type, "void *");
+    }
+    else {
+        field_p->kind = struct_field_value;
+        sprintf(field_p->type, "%s ", parameter_p->get_c_type());
+    }
+}
+
+/* Pointer to the value, as the pack functions want it */
+static const char *struct_field_value_ref(struct_field_t *field_p)
+{
+    static char ref[200];
+
+    sprintf(ref,
+            "%ss_p->%s%s",
+            ((field_p->kind == struct_field_value) ||
+             (field_p->kind == struct_field_bag)) ? "&" : "",
+            field_p->entry_p->field_name_p,
+            field_p->entry_p->multiple ? "[i]" : ""
+           );
+    return ref;
+}
+
+bool bag_parameter::struct_supported(int depth)
+{
+    mpl_list_t *tmp_p;
+    parameter_list_entry *parameter_list_entry_p;
+    parameter *parameter_p;
+    mpl_list_t *pl_p = (mpl_list_t*) get_property("parameter_list");
+
+    /* Unknown fields, or an empty struct, can not be represented */
+    if ((depth > 16) || get_property("ellipsis") || (pl_p == NULL))
+        return false;
+
+    MPL_LIST_FOR_EACH(pl_p, tmp_p) {
+        parameter_list_entry_p = LISTABLE_PTR(tmp_p, parameter_list_entry);
+        if (parameter_list_entry_p->field_name_p == NULL)
+            return false;
+
+        parameter_p = parameter_list_entry_p->parameter_set_p->find_parameter(parameter_list_entry_p->parameter_name_p);
+        if (parameter_p == NULL)
+            return false;
+
+        if (parameter_p->is_bag()) {
+            if ((parameter_p->parameter_set_p != parameter_set_p) ||
+                !((bag_parameter*)parameter_p)->struct_supported(depth + 1))
+                return false;
+        }
+        else if (parameter_p->is_string()) {
+            if (strcmp(parameter_p->get_type(), "string"))
+                return false;
+        }
+        else if (!parameter_p->is_int() &&
+                 !parameter_p->is_bool() &&
+                 !parameter_p->is_enum() &&
+                 !parameter_p->is_array() &&
+                 !parameter_p->is_tuple() &&
+                 !parameter_p->is_addr()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void bag_parameter::gc_h_struct(FILE *f)
+{
+    char *snu = str_toupper(parameter_set_p->get_short_name());
+    char *lnl = parameter_set_p->name_p;
+    mpl_list_t *tmp_p;
+    parameter_list_entry *parameter_list_entry_p;
+    mpl_list_t *pl_p = (mpl_list_t*) get_property("parameter_list");
+    int max = struct_number((char*) get_property("max"));
+    int optionals = 0;
+    int multiples = 0;
+    int arrays = 0;
+    int allocated = 0;
+    struct_field_t field;
+
+    if (struct_h_done)
+        return;
+    struct_h_done = 1;
+
+    /* Nested structs must be declared first */
+    MPL_LIST_FOR_EACH(pl_p, tmp_p) {
+        parameter_list_entry_p = LISTABLE_PTR(tmp_p, parameter_list_entry);
+        struct_field(parameter_list_entry_p, &field);
+        if (field.kind == struct_field_bag)
+            ((bag_parameter*)field.parameter_p)->gc_h_struct(f);
+        if (parameter_list_entry_p->multiple)
+            multiples++;
+        else if (parameter_list_entry_p->optional)
+            optionals++;
+        if (field.kind == struct_field_array)
+            arrays++;
+        if ((field.kind == struct_field_ptr) ||
+            (parameter_list_entry_p->multiple && (max <= 0)))
+            allocated++;
+    }
+
+    fprintf(f,
+            "\n"
+            "/**\n"
+            "  * @ingroup %s_FM_UTIL\n"
+            "  * Native struct for bag '%s'.\n",
+            snu,
+            name_p
+           );
+    if (optionals)
+        fprintf(f,
+                "  * Optional fields are present when their bit in 'has' is set.\n"
+               );
+    if (multiples)
+        fprintf(f,
+                "  * Multiple fields are arrays, with the number of elements in\n"
+                "  * <field>_count.\n"
+               );
+    if (arrays)
+        fprintf(f,
+                "  * Array fields with a max hold <field>_len elements.\n"
+               );
+    if (allocated)
+        fprintf(f,
+                "  * Strings without max, tuples, other array fields, and multiple\n"
+                "  * fields when the bag has no max, are allocated by\n"
+                "  * %s_%s_struct_unpack().\n",
+                lnl,
+                name_p
+               );
+    fprintf(f,
+            "  */\n"
+            "typedef struct\n"
+            "{\n"
+           );
+    if (optionals) {
+        fprintf(f,
+                "    struct\n"
+                "    {\n"
+               );
+        MPL_LIST_FOR_EACH(pl_p, tmp_p) {
+            parameter_list_entry_p = LISTABLE_PTR(tmp_p, parameter_list_entry);
+            if (parameter_list_entry_p->optional && !parameter_list_entry_p->multiple)
+                fprintf(f,
+                        "        unsigned %s:1;\n",
+                        parameter_list_entry_p->field_name_p
+                       );
+        }
+        fprintf(f,
+                "    } has;\n"
+               );
+    }
+    MPL_LIST_FOR_EACH(pl_p, tmp_p) {
+        parameter_list_entry_p = LISTABLE_PTR(tmp_p, parameter_list_entry);
+        struct_field(parameter_list_entry_p, &field);
+        if (!parameter_list_entry_p->multiple)
+            fprintf(f,
+                    "    %s%s%s;",
+                    field.type,
+                    parameter_list_entry_p->field_name_p,
+                    field.suffix
+                   );
+        else if (max > 0)
+            fprintf(f,
+                    "    %s%s[%d]%s;",
+                    field.type,
+                    parameter_list_entry_p->field_name_p,
+                    max,
+                    field.suffix
+                   );
+        else if (field.suffix[0])
+            fprintf(f,
+                    "    %s(*%s)%s;",
+                    field.type,
+                    parameter_list_entry_p->field_name_p,
+                    field.suffix
+                   );
+        else
+            fprintf(f,
+                    "    %s*%s;",
+                    field.type,
+                    parameter_list_entry_p->field_name_p
+                   );
+        fprintf(f, "\n");
+        if (field.kind == struct_field_array)
+            fprintf(f,
+                    "    int %s_len;\n",
+                    parameter_list_entry_p->field_name_p
+                   );
+        if (parameter_list_entry_p->multiple)
+            fprintf(f,
+                    "    int %s_count;\n",
+                    parameter_list_entry_p->field_name_p
+                   );
+    }
+    fprintf(f,
+            "} %s_%s_struct_t;\n",
+            lnl,
+            name_p
+           );
+
+    fprintf(f,
+            "/**\n"
+            "  * @ingroup %s_FM_UTIL\n"
+            "  * Pack the struct as the value of bag '%s' (\"={...}\"), the\n"
+            "  * same as the parameter list would be packed.\n"
+            "  * @return The packed length, as snprintf(), or -1 on error\n"
+            "  */\n"
+            "int %s_%s_struct_pack_value(const %s_%s_struct_t *s_p, char *buf, size_t buflen);\n",
+            snu,
+            name_p,
+            lnl, name_p, lnl, name_p
+           );
+    fprintf(f,
+            "/**\n"
+            "  * @ingroup %s_FM_UTIL\n"
+            "  * Pack the struct as parameter '%s' (\"prefix.%s={...}\").\n"
+            "  * @return The packed length, as snprintf(), or -1 on error\n"
+            "  */\n"
+            "int %s_%s_struct_pack(const %s_%s_struct_t *s_p, char *buf, size_t buflen);\n",
+            snu,
+            name_p,
+            name_p,
+            lnl, name_p, lnl, name_p
+           );
+    fprintf(f,
+            "/**\n"
+            "  * @ingroup %s_FM_UTIL\n"
+            "  * Unpack a value of bag '%s' (\"{...}\") into the struct.\n"
+            "  * @return 0 on success, -1 if the value is not valid or uses\n"
+            "  *         anything the struct can not hold (then the parameter list\n"
+            "  *         unpack functions must be used)\n"
+            "  */\n"
+            "int %s_%s_struct_unpack_value(const char *value_str, %s_%s_struct_t *s_p);\n",
+            snu,
+            name_p,
+            lnl, name_p, lnl, name_p
+           );
+    fprintf(f,
+            "/**\n"
+            "  * @ingroup %s_FM_UTIL\n"
+            "  * Unpack parameter '%s' (\"prefix.%s={...}\") into the struct.\n"
+            "  * @return 0 on success, -1 on error (see %s_%s_struct_unpack_value())\n"
+            "  */\n"
+            "int %s_%s_struct_unpack(const char *str, %s_%s_struct_t *s_p);\n",
+            snu,
+            name_p,
+            name_p,
+            lnl, name_p,
+            lnl, name_p, lnl, name_p
+           );
+    fprintf(f,
+            "/**\n"
+            "  * @ingroup %s_FM_UTIL\n"
+            "  * Free what %s_%s_struct_unpack() allocated, and clear the struct.\n"
+            "  */\n"
+            "void %s_%s_struct_free(%s_%s_struct_t *s_p);\n",
+            snu,
+            lnl, name_p,
+            lnl, name_p, lnl, name_p
+           );
+    free(snu);
+}
+
+static void gc_c_struct_pack_check(FILE *f, const char *indent)
+{
+    fprintf(f,
+            "%sif (res < 0)\n"
+            "%s    return -1;\n"
+            "%slen += res;\n",
+            indent,
+            indent,
+            indent
+           );
+}
+
+void bag_parameter::gc_c_struct(FILE *f)
+{
+    char *lnl = parameter_set_p->name_p;
+    mpl_list_t *tmp_p;
+    parameter_list_entry *parameter_list_entry_p;
+    mpl_list_t *pl_p = (mpl_list_t*) get_property("parameter_list");
+    int max = struct_number((char*) get_property("max"));
+    int multiples = 0;
+    struct_field_t field;
+    const char *indent;
+    const char *fn;
+
+    MPL_LIST_FOR_EACH(pl_p, tmp_p) {
+        parameter_list_entry_p = LISTABLE_PTR(tmp_p, parameter_list_entry);
+        if (parameter_list_entry_p->multiple)
+            multiples++;
+    }
+
+    /* Pack */
+    fprintf(f,
+            "int %s_%s_struct_pack_value(const %s_%s_struct_t *s_p, char *buf, size_t buflen)\n"
+            "{\n"
+            "    int len;\n"
+            "    int res;\n"
+            "%s"
+            "    bool first = true;\n"
+            "\n"
+            "    len = snprintf(buf, buflen, \"={\");\n"
+            "    if (len < 0)\n"
+            "        return -1;\n",
+            lnl, name_p, lnl, name_p,
+            multiples ? "    int i;\n" : ""
+           );
+    MPL_LIST_FOR_EACH(pl_p, tmp_p) {
+        parameter_list_entry_p = LISTABLE_PTR(tmp_p, parameter_list_entry);
+        struct_field(parameter_list_entry_p, &field);
+        fn = parameter_list_entry_p->field_name_p;
+
+        fprintf(f, "\n");
+        if (parameter_list_entry_p->multiple) {
+            if (!parameter_list_entry_p->optional || (max > 0)) {
+                fprintf(f,
+                        "    if ("
+                       );
+                if (!parameter_list_entry_p->optional && (max > 0))
+                    fprintf(f,
+                            "(s_p->%s_count < 1) || (s_p->%s_count > %d)",
+                            fn,
+                            fn,
+                            max
+                           );
+                else if (max > 0)
+                    fprintf(f,
+                            "s_p->%s_count > %d",
+                            fn,
+                            max
+                           );
+                else
+                    fprintf(f,
+                            "s_p->%s_count < 1",
+                            fn
+                           );
+                fprintf(f,
+                        ")\n"
+                        "        return -1;\n"
+                       );
+            }
+            fprintf(f,
+                    "    for (i = 0; i < s_p->%s_count; i++) {\n",
+                    fn
+                   );
+            indent = "        ";
+        }
+        else if (parameter_list_entry_p->optional) {
+            fprintf(f,
+                    "    if (s_p->has.%s) {\n",
+                    fn
+                   );
+            indent = "        ";
+        }
+        else
+            indent = "    ";
+
+        if (field.kind == struct_field_ptr)
+            fprintf(f,
+                    "%sif (s_p->%s%s == NULL)\n"
+                    "%s    return -1;\n",
+                    indent,
+                    fn,
+                    parameter_list_entry_p->multiple ? "[i]" : "",
+                    indent
+                   );
+        fprintf(f,
+                "%sres = mpl_param_struct_pack_name(MPL_PARAM_STRUCT_BUF(buf, buflen, len), first, \"%s\", %s);\n",
+                indent,
+                fn,
+                parameter_list_entry_p->multiple ? "i + 1" : "0"
+               );
+        gc_c_struct_pack_check(f, indent);
+        if (field.kind == struct_field_bag)
+            fprintf(f,
+                    "%sres = %s_%s_struct_pack_value(%s, MPL_PARAM_STRUCT_BUF(buf, buflen, len));\n",
+                    indent,
+                    field.parameter_p->parameter_set_p->name_p,
+                    field.parameter_p->name_p,
+                    struct_field_value_ref(&field)
+                   );
+        else if (field.kind == struct_field_array)
+            fprintf(f,
+                    "%sif ((s_p->%s_len < 0) || (s_p->%s_len > %d))\n"
+                    "%s    return -1;\n"
+                    "%sres = mpl_param_struct_pack_array(%s, s_p->%s, s_p->%s_len, MPL_PARAM_STRUCT_BUF(buf, buflen, len));\n",
+                    indent,
+                    fn,
+                    fn,
+                    field.max,
+                    indent,
+                    indent,
+                    field.paramid,
+                    fn,
+                    fn
+                   );
+        else
+            fprintf(f,
+                    "%sres = mpl_param_value_pack(%s, %s, MPL_PARAM_STRUCT_BUF(buf, buflen, len));\n",
+                    indent,
+                    field.paramid,
+                    struct_field_value_ref(&field)
+                   );
+        gc_c_struct_pack_check(f, indent);
+        fprintf(f,
+                "%sfirst = false;\n",
+                indent
+               );
+        if (parameter_list_entry_p->multiple || parameter_list_entry_p->optional)
+            fprintf(f,
+                    "    }\n"
+                   );
+    }
+    fprintf(f,
+            "\n"
+            "    res = snprintf(MPL_PARAM_STRUCT_BUF(buf, buflen, len), \"}\");\n"
+           );
+    gc_c_struct_pack_check(f, "    ");
+    fprintf(f,
+            "    return len;\n"
+            "}\n"
+            "\n"
+           );
+
+    fprintf(f,
+            "int %s_%s_struct_pack(const %s_%s_struct_t *s_p, char *buf, size_t buflen)\n"
+            "{\n"
+            "    int len;\n"
+            "    int res;\n"
+            "\n"
+            "    len = snprintf(buf, buflen, \"%s.%s\");\n"
+            "    if (len < 0)\n"
+            "        return -1;\n"
+            "    res = %s_%s_struct_pack_value(s_p, MPL_PARAM_STRUCT_BUF(buf, buflen, len));\n",
+            lnl, name_p, lnl, name_p,
+            parameter_set_p->prefix_p->value_p, name_p,
+            lnl, name_p
+           );
+    gc_c_struct_pack_check(f, "    ");
+    fprintf(f,
+            "    return len;\n"
+            "}\n"
+            "\n"
+           );
+
+    /* Unpack */
+    fprintf(f,
+            "int %s_%s_struct_unpack_value(const char *value_str, %s_%s_struct_t *s_p)\n"
+            "{\n"
+            "    char *copy_p;\n"
+            "    mpl_arg_t *args_p;\n"
+            "    int numargs;\n"
+            "    int i;\n"
+            "    int tag;\n",
+            lnl, name_p, lnl, name_p
+           );
+    MPL_LIST_FOR_EACH(pl_p, tmp_p) {
+        parameter_list_entry_p = LISTABLE_PTR(tmp_p, parameter_list_entry);
+        if (!parameter_list_entry_p->multiple)
+            fprintf(f,
+                    "    int %s_found = 0;\n",
+                    parameter_list_entry_p->field_name_p
+                   );
+    }
+    fprintf(f,
+            "\n"
+            "    memset(s_p, 0, sizeof(*s_p));\n"
+            "    numargs = mpl_param_struct_split(value_str, &copy_p, &args_p);\n"
+            "    if (numargs < 0)\n"
+            "        return -1;\n"
+            "\n"
+            "    for (i = 0; i < numargs; i++) {\n"
+            "        if (args_p[i].value_p == NULL)\n"
+            "            goto error_return;\n"
+            "        tag = mpl_param_struct_key_tag(args_p[i].key_p);\n"
+            "        if (tag < 0)\n"
+            "            goto error_return;\n"
+           );
+    MPL_LIST_FOR_EACH(pl_p, tmp_p) {
+        char to[200];
+        parameter_list_entry_p = LISTABLE_PTR(tmp_p, parameter_list_entry);
+        struct_field(parameter_list_entry_p, &field);
+        fn = parameter_list_entry_p->field_name_p;
+
+        fprintf(f,
+                "        %sif (!strcmp(args_p[i].key_p, \"%s\")) {\n",
+                (tmp_p == pl_p) ? "" : "else ",
+                fn
+               );
+        if (parameter_list_entry_p->multiple) {
+            /* Multiple fields are tagged from 1 and up, in order */
+            fprintf(f,
+                    "            if (tag != (s_p->%s_count + 1))\n"
+                    "                goto error_return;\n",
+                    fn
+                   );
+            if (max > 0)
+                fprintf(f,
+                        "            if (s_p->%s_count >= %d)\n"
+                        "                goto error_return;\n",
+                        fn,
+                        max
+                       );
+            else
+                fprintf(f,
+                        "            if (mpl_param_struct_grow((void**)&s_p->%s, s_p->%s_count, sizeof(*s_p->%s)) < 0)\n"
+                        "                goto error_return;\n",
+                        fn,
+                        fn,
+                        fn
+                       );
+        }
+        else {
+            fprintf(f,
+                    "            if ((tag != 0) || %s_found++)\n"
+                    "                goto error_return;\n",
+                    fn
+                   );
+        }
+
+        sprintf(to, "s_p->%s", fn);
+        if (parameter_list_entry_p->multiple)
+            sprintf(to + strlen(to), "[s_p->%s_count]", fn);
+
+        switch (field.kind) {
+            case struct_field_bag:
+                fprintf(f,
+                        "            if (%s_%s_struct_unpack_value(args_p[i].value_p, &%s) < 0)\n",
+                        field.parameter_p->parameter_set_p->name_p,
+                        field.parameter_p->name_p,
+                        to
+                       );
+                break;
+            case struct_field_ptr:
+                fprintf(f,
+                        "            if (mpl_param_value_unpack(%s, args_p[i].value_p, (void**)&%s) < 0)\n",
+                        field.paramid,
+                        to
+                       );
+                break;
+            case struct_field_array:
+                fprintf(f,
+                        "            if (mpl_param_struct_unpack_array(%s, args_p[i].value_p, %s, %d, &s_p->%s_len) < 0)\n",
+                        field.paramid,
+                        to,
+                        field.max,
+                        fn
+                       );
+                break;
+            case struct_field_string:
+                fprintf(f,
+                        "            if (mpl_param_value_unpack_to(%s, args_p[i].value_p, %s, sizeof(%s)) < 0)\n",
+                        field.paramid,
+                        to,
+                        to
+                       );
+                break;
+            default:
+                fprintf(f,
+                        "            if (mpl_param_value_unpack_to(%s, args_p[i].value_p, &%s, sizeof(%s)) < 0)\n",
+                        field.paramid,
+                        to,
+                        to
+                       );
+                break;
+        }
+        fprintf(f,
+                "                goto error_return;\n"
+               );
+        if (parameter_list_entry_p->multiple)
+            fprintf(f,
+                    "            s_p->%s_count++;\n",
+                    fn
+                   );
+        else if (parameter_list_entry_p->optional)
+            fprintf(f,
+                    "            s_p->has.%s = 1;\n",
+                    fn
+                   );
+        fprintf(f,
+                "        }\n"
+               );
+    }
+    fprintf(f,
+            "        else\n"
+            "            goto error_return;\n"
+            "    }\n"
+            "\n"
+           );
+
+    /* Mandatory fields */
+    MPL_LIST_FOR_EACH(pl_p, tmp_p) {
+        parameter_list_entry_p = LISTABLE_PTR(tmp_p, parameter_list_entry);
+        fn = parameter_list_entry_p->field_name_p;
+        if (parameter_list_entry_p->optional)
+            continue;
+        if (parameter_list_entry_p->multiple)
+            fprintf(f,
+                    "    if (s_p->%s_count < 1)\n"
+                    "        goto error_return;\n",
+                    fn
+                   );
+        else
+            fprintf(f,
+                    "    if (!%s_found)\n"
+                    "        goto error_return;\n",
+                    fn
+                   );
+    }
+    fprintf(f,
+            "\n"
+            "    free(args_p);\n"
+            "    free(copy_p);\n"
+            "    return 0;\n"
+            "\n"
+            "  error_return:\n"
+            "    free(args_p);\n"
+            "    free(copy_p);\n"
+            "    %s_%s_struct_free(s_p);\n"
+            "    return -1;\n"
+            "}\n"
+            "\n",
+            lnl, name_p
+           );
+
+    fprintf(f,
+            "int %s_%s_struct_unpack(const char *str, %s_%s_struct_t *s_p)\n"
+            "{\n"
+            "    const char *value_p;\n"
+            "\n"
+            "    value_p = mpl_param_struct_value(str, \"%s\", \"%s\");\n"
+            "    if (value_p == NULL)\n"
+            "        return -1;\n"
+            "    return %s_%s_struct_unpack_value(value_p, s_p);\n"
+            "}\n"
+            "\n",
+            lnl, name_p, lnl, name_p,
+            parameter_set_p->prefix_p->value_p, name_p,
+            lnl, name_p
+           );
+
+    /* Free */
+    multiples = 0;
+    MPL_LIST_FOR_EACH(pl_p, tmp_p) {
+        parameter_list_entry_p = LISTABLE_PTR(tmp_p, parameter_list_entry);
+        struct_field(parameter_list_entry_p, &field);
+        if (parameter_list_entry_p->multiple &&
+            ((field.kind == struct_field_bag) ||
+             (field.kind == struct_field_ptr)))
+            multiples++;
+    }
+    fprintf(f,
+            "void %s_%s_struct_free(%s_%s_struct_t *s_p)\n"
+            "{\n"
+            "%s",
+            lnl, name_p, lnl, name_p,
+            multiples ? "    int i;\n\n" : ""
+           );
+    MPL_LIST_FOR_EACH(pl_p, tmp_p) {
+        parameter_list_entry_p = LISTABLE_PTR(tmp_p, parameter_list_entry);
+        struct_field(parameter_list_entry_p, &field);
+        fn = parameter_list_entry_p->field_name_p;
+
+        if ((field.kind != struct_field_bag) &&
+            (field.kind != struct_field_ptr) &&
+            (!parameter_list_entry_p->multiple || (max > 0)))
+            continue;
+
+        if (parameter_list_entry_p->multiple) {
+            if ((field.kind == struct_field_bag) ||
+                (field.kind == struct_field_ptr))
+                fprintf(f,
+                        "    for (i = 0; i < s_p->%s_count; i++)\n"
+                        "    ",
+                        fn
+                       );
+        }
+        if (field.kind == struct_field_bag)
+            fprintf(f,
+                    "    %s_%s_struct_free(%s);\n",
+                    field.parameter_p->parameter_set_p->name_p,
+                    field.parameter_p->name_p,
+                    struct_field_value_ref(&field)
+                   );
+        else if (field.kind == struct_field_ptr)
+            fprintf(f,
+                    "    mpl_param_value_free(%s, %s);\n",
+                    field.paramid,
+                    struct_field_value_ref(&field)
+                   );
+        if (parameter_list_entry_p->multiple && (max <= 0))
+            fprintf(f,
+                    "    free(s_p->%s);\n",
+                    fn
+                   );
+    }
+    fprintf(f,
+            "    memset(s_p, 0, sizeof(*s_p));\n"
+            "}\n"
+            "\n"
+           );
+}
+
+mpl_list_t *bag_parameter::get_possible_parameters()
+{
+    mpl_list_t *plist_p = NULL;
+    mpl_list_t *tmp_p;
+    MPL_LIST_FOR_EACH((mpl_list_t*)get_property("parameter_list"), tmp_p) {
+        parameter_list_entry *parameter_list_entry_p = LISTABLE_PTR(tmp_p, parameter_list_entry);
+        parameter *parameter_p = parameter_list_entry_p->parameter_set_p->find_parameter(parameter_list_entry_p->parameter_name_p);
+        object_container *container_p = new object_container(parameter_p);
+        container_p->append_to(plist_p);
+        mpl_list_append(&plist_p, parameter_p->get_flat_child_list());
+    }
+    return plist_p;
+}
+
+bool bag_parameter::param_is_field_or_subfield(parameter *param_p)
+{
+    mpl_list_t *tmp_p;
+    mpl_list_t *plist_p = get_possible_parameters();
+    MPL_LIST_FOR_EACH(plist_p, tmp_p) {
+        object_container *container_p = LISTABLE_PTR(tmp_p, object_container);
+        parameter *parameter_p = (parameter*) container_p->object_p;
+
+        if (parameter_p == param_p) {
+            DELETE_LISTABLE_LIST(&plist_p, object_container);
+            return true;
+        }
 
         if (parameter_p->is_bag() && (parameter_p != this) && !is_parent(parameter_p)) {
             if (((bag_parameter*)parameter_p)->param_is_field_or_subfield(param_p)) {
@@ -4870,144 +6652,871 @@ void bag_parameter::api_cc(FILE *f, char *indent)
             indent
            );
     fprintf(f,
-            "%s}\n",
+            "%s}\n",
+            indent
+           );
+
+    /* Comparison operator */
+    fprintf(f,
+            "%sbool %s::operator==(%s &other)\n"
+            "%s{\n",
+            indent,
+            name_p,
+            name_p,
+            indent
+           );
+
+    fprintf(f,
+            "%s    mpl_param_element_t *this_elem = mpl_param_element_create_empty(this->id());\n"
+            "%s    mpl_param_element_t *other_elem = mpl_param_element_create_empty(other.id());\n"
+            "%s    this_elem->value_p = this->encode();\n"
+            "%s    other_elem->value_p = other.encode();\n",
+            indent,
+            indent,
+            indent,
+            indent
+           );
+
+    fprintf(f,
+            "%s    int diff = mpl_param_element_compare(this_elem, other_elem);\n"
+            "%s    mpl_param_element_destroy(this_elem);\n"
+            "%s    mpl_param_element_destroy(other_elem);\n"
+            "%s    return (diff == 0);\n",
+            indent,
+            indent,
+            indent,
+            indent
+           );
+    fprintf(f,
+            "%s}\n",
+            indent
+           );
+
+    /* Encode method */
+    fprintf(f,
+            "%smpl_bag_t *%s::encode()\n",
+            indent,
+            name_p
+           );
+    fprintf(f,
+            "%s{\n",
+            indent
+           );
+
+    fprintf(f,
+            "%s    mpl_bag_t *encoded_p = NULL;\n",
+            indent
+           );
+    if (parent_p) {
+        fprintf(f,
+                "%s    encoded_p = %s::encode();\n",
+                indent,
+                parent_p->name_p
+               );
+    }
+
+    api_cc_encode_parameter_list(f,
+                                 indent,
+                                 bag_parameter_list_p,
+                                 parent_p ? ((bag_parameter*)parent_p)->bag_parameter_list_p : NULL,
+                                 parameter_set_p,
+                                 name_p,
+                                 (char*)"encoded_p",
+                                 direction_none
+                                );
+    fprintf(f,
+            "%s    return encoded_p;\n",
+            indent
+           );
+
+    fprintf(f,
+            "%s}\n",
+            indent
+           );
+
+    /* Print method */
+    fprintf(f,
+            "%svoid %s::print()\n",
+            indent,
+            name_p
+           );
+    fprintf(f,
+            "%s{\n",
+            indent
+           );
+
+    if (parent_p) {
+        fprintf(f,
+                "%s    %s::print();\n",
+                indent,
+                parent_p->name_p
+               );
+    } else {
+        fprintf(f,
+                "%s    BAG::print();\n",
+                indent
+               );
+    }
+
+    api_cc_print_parameter_list(f,
+                                indent,
+                                bag_parameter_list_p,
+                                parent_p ? ((bag_parameter*)parent_p)->bag_parameter_list_p : NULL,
+                                parameter_set_p,
+                                direction_none
+                                );
+    fprintf(f,
+            "%s}\n",
+            indent
+           );
+
+    /* __set_id() method */
+    fprintf(f,
+            "%svoid %s::__set_id()\n"
+            "%s{\n",
+            indent,
+            name_p,
+            indent
+           );
+    fprintf(f,
+            "%s    __id = %s_PARAM_ID(%s);\n",
+            indent,
+            snu,
+            name_p
+           );
+    fprintf(f,
+            "%s}\n",
+            indent
+           );
+
+    free(snu);
+}
+
+/* How a bag field is stored in the C++11 value class */
+typedef enum {
+    api11_field_value,
+    api11_field_string,
+    api11_field_array,
+    api11_field_bag
+} api11_field_kind_t;
+
+typedef struct {
+    parameter_list_entry *entry_p;
+    parameter *parameter_p;
+    api11_field_kind_t kind;
+    char type[100];
+    char c_type[100];
+    char paramid[200];
+} api11_field_t;
+
+static void api11_field(parameter_list_entry *entry_p, api11_field_t *field_p)
+{
+    parameter *parameter_p;
+
+    parameter_p = entry_p->parameter_set_p->find_parameter(entry_p->parameter_name_p);
+    field_p->entry_p = entry_p;
+    field_p->parameter_p = parameter_p;
+    field_p->c_type[0] = '\0';
+    sprintf(field_p->paramid,
+            "%s_paramid_%s",
+            parameter_p->parameter_set_p->name_p,
+            parameter_p->name_p
+           );
+
+    if (parameter_p->is_bag()) {
+        field_p->kind = api11_field_bag;
+        strcpy(field_p->type, parameter_p->name_p);
+    }
+    else if (parameter_p->is_string()) {
+        /* c_type is the character type */
+        field_p->kind = api11_field_string;
+        if (!strcmp(parameter_p->get_c_type(), "wchar_t *")) {
+            strcpy(field_p->type, "std::wstring");
+            strcpy(field_p->c_type, "wchar_t");
+        }
+        else {
+            strcpy(field_p->type, "std::string");
+            strcpy(field_p->c_type, "char");
+        }
+    }
+    else if (parameter_p->is_array()) {
+        /* mpl_uint8_array_t -> std::vector<uint8_t> */
+        const char *ct = parameter_p->get_c_type();
+        field_p->kind = api11_field_array;
+        strcpy(field_p->c_type, ct);
+        sprintf(field_p->type,
+                "std::vector<%.*s_t>",
+                (int) (strlen(ct) - strlen("mpl_") - strlen("_array_t")),
+                ct + strlen("mpl_")
+               );
+    }
+    else {
+        /* Enums are typed in the class, but packed as their representation */
+        field_p->kind = api11_field_value;
+        strcpy(field_p->c_type, parameter_p->get_c_type());
+        strcpy(field_p->type, param_c_type(parameter_p));
+    }
+}
+
+bool bag_parameter::api11_supported(int depth)
+{
+    mpl_list_t *tmp_p;
+    parameter_list_entry *parameter_list_entry_p;
+    parameter *parameter_p;
+    mpl_list_t *pl_p = (mpl_list_t*) get_property("parameter_list");
+
+    /* Unknown fields can not be represented */
+    if ((depth > 16) || get_property("ellipsis"))
+        return false;
+
+    if (parent_p && !((bag_parameter*)parent_p)->api11_supported(depth + 1))
+        return false;
+
+    MPL_LIST_FOR_EACH(pl_p, tmp_p) {
+        parameter_list_entry_p = LISTABLE_PTR(tmp_p, parameter_list_entry);
+        if (parameter_list_entry_p->field_name_p == NULL)
+            return false;
+
+        parameter_p = parameter_list_entry_p->parameter_set_p->find_parameter(parameter_list_entry_p->parameter_name_p);
+        if (parameter_p == NULL)
+            return false;
+
+        if (parameter_p->is_bag()) {
+            if ((parameter_p->parameter_set_p != parameter_set_p) ||
+                !((bag_parameter*)parameter_p)->api11_supported(depth + 1))
+                return false;
+        }
+        else if (parameter_p->is_tuple()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void bag_parameter::api11_hh(FILE *f, const char *indent)
+{
+    mpl_list_t *tmp_p;
+    parameter_list_entry *parameter_list_entry_p;
+    mpl_list_t *pl_p = (mpl_list_t*) get_property("parameter_list");
+    mpl_list_t *parent_pl_p = NULL;
+    int own_fields = 0;
+    api11_field_t field;
+
+    if (api11_hh_done)
+        return;
+    api11_hh_done = 1;
+
+    /* The parent and nested classes must be declared first */
+    if (parent_p) {
+        ((bag_parameter*)parent_p)->api11_hh(f, indent);
+        parent_pl_p = (mpl_list_t*) parent_p->get_property("parameter_list");
+    }
+    MPL_LIST_FOR_EACH(pl_p, tmp_p) {
+        parameter_list_entry_p = LISTABLE_PTR(tmp_p, parameter_list_entry);
+        api11_field(parameter_list_entry_p, &field);
+        if (field.kind == api11_field_bag)
+            ((bag_parameter*)field.parameter_p)->api11_hh(f, indent);
+    }
+
+    fprintf(f,
+            "\n"
+            "%s/**\n"
+            "%s  * Value class for bag '%s'. Optional fields are optional<T> and\n"
+            "%s  * multiple fields are std::vector<T>, in tag order.\n"
+            "%s  */\n"
+            "%sclass %s%s%s {\n"
+            "%s    public:\n",
+            indent,
+            indent, name_p,
+            indent,
+            indent,
+            indent, name_p,
+            parent_p ? " : public " : "",
+            parent_p ? parent_p->name_p : "",
+            indent
+           );
+    MPL_LIST_FOR_EACH(pl_p, tmp_p) {
+        parameter_list_entry_p = LISTABLE_PTR(tmp_p, parameter_list_entry);
+        if (parameter_list_entry_is_in_list(parameter_list_entry_p, parent_pl_p))
+            continue;
+        own_fields++;
+        api11_field(parameter_list_entry_p, &field);
+        if (parameter_list_entry_p->multiple)
+            fprintf(f,
+                    "%s        std::vector<%s> %s;\n",
+                    indent,
+                    field.type,
+                    parameter_list_entry_p->field_name_p
+                   );
+        else if (parameter_list_entry_p->optional)
+            fprintf(f,
+                    "%s        optional<%s> %s;\n",
+                    indent,
+                    field.type,
+                    parameter_list_entry_p->field_name_p
+                   );
+        else
+            fprintf(f,
+                    "%s        %s %s%s;\n",
+                    indent,
+                    field.type,
+                    parameter_list_entry_p->field_name_p,
+                    (field.kind == api11_field_value) ? "{}" : ""
+                   );
+    }
+    if (own_fields)
+        fprintf(f, "\n");
+    fprintf(f,
+            "%s        %s() = default;\n"
+            "%s        %s(const %s &) = default;\n"
+            "%s        %s(%s &&) = default;\n"
+            "%s        %s &operator=(const %s &) = default;\n"
+            "%s        %s &operator=(%s &&) = default;\n"
+            "%s        bool operator==(const %s &other) const;\n"
+            "%s        bool operator!=(const %s &other) const { return !(*this == other); }\n"
+            "%s        static mpl_param_element_id_t param_id() { return %s_paramid_%s; }\n"
+            "%s        void clear() { *this = %s(); }\n"
+            "\n",
+            indent, name_p,
+            indent, name_p, name_p,
+            indent, name_p, name_p,
+            indent, name_p, name_p,
+            indent, name_p, name_p,
+            indent, name_p,
+            indent, name_p,
+            indent, parameter_set_p->name_p, name_p,
+            indent, name_p
+           );
+    fprintf(f,
+            "%s        /**\n"
+            "%s          * Append the packed value (\"={...}\") to out.\n"
+            "%s          * @return 0 on success, -1 on error (out is unchanged)\n"
+            "%s          */\n"
+            "%s        int encode_value(std::string &out) const;\n"
+            "%s        /**\n"
+            "%s          * Append the packed parameter (\"%s.%s={...}\") to out.\n"
+            "%s          * @return 0 on success, -1 on error (out is unchanged)\n"
+            "%s          */\n"
+            "%s        int encode(std::string &out) const;\n"
+            "%s        /**\n"
+            "%s          * Decode a packed value (\"{...}\").\n"
+            "%s          * @return 0 on success, -1 on error (the object is cleared)\n"
+            "%s          */\n"
+            "%s        int decode_value(const char *value_str);\n"
+            "%s        /**\n"
+            "%s          * Decode a packed parameter (\"%s.%s={...}\").\n"
+            "%s          * @return 0 on success, -1 on error\n"
+            "%s          */\n"
+            "%s        int decode(const char *str);\n"
+            "%s};\n",
+            indent,
+            indent,
+            indent,
+            indent,
+            indent,
+            indent,
+            indent, parameter_set_p->prefix_p->value_p, name_p,
+            indent,
+            indent,
+            indent,
+            indent,
+            indent,
+            indent,
+            indent,
+            indent,
+            indent,
+            indent, parameter_set_p->prefix_p->value_p, name_p,
+            indent,
+            indent,
+            indent,
+            indent
+           );
+}
+
+void bag_parameter::api11_cc(FILE *f, const char *indent)
+{
+    mpl_list_t *tmp_p;
+    parameter_list_entry *parameter_list_entry_p;
+    mpl_list_t *pl_p = (mpl_list_t*) get_property("parameter_list");
+    int max = struct_number((char*) get_property("max"));
+    api11_field_t field;
+    const char *fn;
+    const char *ind;
+    char ref[200];
+
+    /* Compare */
+    fprintf(f,
+            "\n"
+            "%sbool %s::operator==(const %s &%s) const\n"
+            "%s{\n"
+            "%s    return true",
+            indent, name_p, name_p, pl_p ? "other" : "",
+            indent,
+            indent
+           );
+    MPL_LIST_FOR_EACH(pl_p, tmp_p) {
+        parameter_list_entry_p = LISTABLE_PTR(tmp_p, parameter_list_entry);
+        fprintf(f,
+                " &&\n"
+                "%s        (%s == other.%s)",
+                indent,
+                parameter_list_entry_p->field_name_p,
+                parameter_list_entry_p->field_name_p
+               );
+    }
+    fprintf(f,
+            ";\n"
+            "%s}\n"
+            "\n",
             indent
            );
 
-    /* Comparison operator */
+    /* Encode */
     fprintf(f,
-            "%sbool %s::operator==(%s &other)\n"
+            "%sint %s::encode_value(std::string &out) const\n"
             "%s{\n",
-            indent,
-            name_p,
-            name_p,
+            indent, name_p,
             indent
            );
-
+    if (pl_p)
+        fprintf(f,
+                "%s    size_t start_ = out.size();\n"
+                "%s    bool first_ = true;\n"
+                "\n",
+                indent,
+                indent
+               );
     fprintf(f,
-            "%s    mpl_param_element_t *this_elem = mpl_param_element_create_empty(this->id());\n"
-            "%s    mpl_param_element_t *other_elem = mpl_param_element_create_empty(other.id());\n"
-            "%s    this_elem->value_p = this->encode();\n"
-            "%s    other_elem->value_p = other.encode();\n",
-            indent,
-            indent,
-            indent,
+            "%s    out += \"={\";\n",
             indent
            );
+    MPL_LIST_FOR_EACH(pl_p, tmp_p) {
+        parameter_list_entry_p = LISTABLE_PTR(tmp_p, parameter_list_entry);
+        api11_field(parameter_list_entry_p, &field);
+        fn = parameter_list_entry_p->field_name_p;
+
+        if (parameter_list_entry_p->multiple) {
+            if (!parameter_list_entry_p->optional || (max > 0)) {
+                fprintf(f,
+                        "%s    if (",
+                        indent
+                       );
+                if (!parameter_list_entry_p->optional && (max > 0))
+                    fprintf(f,
+                            "%s.empty() || (%s.size() > %d)",
+                            fn,
+                            fn,
+                            max
+                           );
+                else if (max > 0)
+                    fprintf(f,
+                            "%s.size() > %d",
+                            fn,
+                            max
+                           );
+                else
+                    fprintf(f,
+                            "%s.empty()",
+                            fn
+                           );
+                fprintf(f,
+                        ")\n"
+                        "%s        goto error_return;\n",
+                        indent
+                       );
+            }
+            fprintf(f,
+                    "%s    for (size_t i_ = 0; i_ < %s.size(); i_++) {\n"
+                    "%s        pack_name(out, first_, \"%s\", i_ + 1);\n",
+                    indent, fn,
+                    indent, fn
+                   );
+            sprintf(ref, "%s[i_]", fn);
+            ind = "        ";
+        }
+        else if (parameter_list_entry_p->optional) {
+            fprintf(f,
+                    "%s    if (%s) {\n"
+                    "%s        pack_name(out, first_, \"%s\", 0);\n",
+                    indent, fn,
+                    indent, fn
+                   );
+            sprintf(ref, "%s.value()", fn);
+            ind = "        ";
+        }
+        else if (field.kind == api11_field_value) {
+            /* In a block, for the local copy */
+            fprintf(f,
+                    "%s    pack_name(out, first_, \"%s\", 0);\n"
+                    "%s    {\n",
+                    indent, fn,
+                    indent
+                   );
+            sprintf(ref, "%s", fn);
+            ind = "        ";
+        }
+        else {
+            fprintf(f,
+                    "%s    pack_name(out, first_, \"%s\", 0);\n",
+                    indent, fn
+                   );
+            sprintf(ref, "%s", fn);
+            ind = "    ";
+        }
 
+        switch (field.kind) {
+            case api11_field_bag:
+                fprintf(f,
+                        "%s%sif (%s.encode_value(out) < 0)\n",
+                        indent, ind,
+                        ref
+                       );
+                break;
+            case api11_field_string:
+                fprintf(f,
+                        "%s%sif (pack_value(out, %s, %s.c_str()) < 0)\n",
+                        indent, ind,
+                        field.paramid,
+                        ref
+                       );
+                break;
+            case api11_field_array:
+                fprintf(f,
+                        "%s%sif (pack_array<%s>(out, %s, %s) < 0)\n",
+                        indent, ind,
+                        field.c_type,
+                        field.paramid,
+                        ref
+                       );
+                break;
+            default:
+                fprintf(f,
+                        "%s%sconst %s%sv_ = %s;\n"
+                        "%s%sif (pack_value(out, %s, &v_) < 0)\n",
+                        indent, ind,
+                        field.c_type,
+                        (field.c_type[strlen(field.c_type) - 1] == '*') ? "" : " ",
+                        ref,
+                        indent, ind,
+                        field.paramid
+                       );
+                break;
+        }
+        fprintf(f,
+                "%s%s    goto error_return;\n",
+                indent, ind
+               );
+        if (strcmp(ind, "    "))
+            fprintf(f,
+                    "%s    }\n",
+                    indent
+                   );
+    }
     fprintf(f,
-            "%s    int diff = mpl_param_element_compare(this_elem, other_elem);\n"
-            "%s    mpl_param_element_destroy(this_elem);\n"
-            "%s    mpl_param_element_destroy(other_elem);\n"
-            "%s    return (diff == 0);\n",
-            indent,
-            indent,
+            "%s    out += '}';\n"
+            "%s    return 0;\n",
             indent,
             indent
            );
+    if (pl_p)
+        fprintf(f,
+                "\n"
+                "%s  error_return:\n"
+                "%s    out.resize(start_);\n"
+                "%s    return -1;\n",
+                indent,
+                indent,
+                indent
+               );
     fprintf(f,
-            "%s}\n",
+            "%s}\n"
+            "\n",
             indent
            );
 
-    /* Encode method */
     fprintf(f,
-            "%smpl_bag_t *%s::encode()\n",
+            "%sint %s::encode(std::string &out) const\n"
+            "%s{\n"
+            "%s    size_t start_ = out.size();\n"
+            "\n"
+            "%s    out += \"%s.%s\";\n"
+            "%s    if (encode_value(out) < 0) {\n"
+            "%s        out.resize(start_);\n"
+            "%s        return -1;\n"
+            "%s    }\n"
+            "%s    return 0;\n"
+            "%s}\n"
+            "\n",
+            indent, name_p,
+            indent,
+            indent,
+            indent, parameter_set_p->prefix_p->value_p, name_p,
+            indent,
+            indent,
+            indent,
+            indent,
             indent,
-            name_p
-           );
-    fprintf(f,
-            "%s{\n",
             indent
            );
 
+    /* Decode */
     fprintf(f,
-            "%s    mpl_bag_t *encoded_p = NULL;\n",
+            "%sint %s::decode(const char *str)\n"
+            "%s{\n"
+            "%s    const char *value_p;\n"
+            "\n"
+            "%s    value_p = mpl_param_struct_value(str, \"%s\", \"%s\");\n"
+            "%s    if (value_p == NULL)\n"
+            "%s        return -1;\n"
+            "%s    return decode_value(value_p);\n"
+            "%s}\n"
+            "\n",
+            indent, name_p,
+            indent,
+            indent,
+            indent, parameter_set_p->prefix_p->value_p, name_p,
+            indent,
+            indent,
+            indent,
             indent
            );
-    if (parent_p) {
+
+    if (pl_p == NULL) {
+        /* Empty bag, there must be no fields */
         fprintf(f,
-                "%s    encoded_p = %s::encode();\n",
+                "%sint %s::decode_value(const char *value_str)\n"
+                "%s{\n"
+                "%s    char *copy_p_;\n"
+                "%s    mpl_arg_t *args_p_;\n"
+                "%s    int numargs_;\n"
+                "\n"
+                "%s    numargs_ = mpl_param_struct_split(value_str, &copy_p_, &args_p_);\n"
+                "%s    free(args_p_);\n"
+                "%s    free(copy_p_);\n"
+                "%s    return (numargs_ == 0) ? 0 : -1;\n"
+                "%s}\n",
+                indent, name_p,
                 indent,
-                parent_p->name_p
+                indent,
+                indent,
+                indent,
+                indent,
+                indent,
+                indent,
+                indent,
+                indent
                );
+        return;
     }
 
-    api_cc_encode_parameter_list(f,
-                                 indent,
-                                 bag_parameter_list_p,
-                                 parent_p ? ((bag_parameter*)parent_p)->bag_parameter_list_p : NULL,
-                                 parameter_set_p,
-                                 name_p,
-                                 (char*)"encoded_p",
-                                 direction_none
-                                );
-    fprintf(f,
-            "%s    return encoded_p;\n",
-            indent
-           );
-
     fprintf(f,
-            "%s}\n",
+            "%sint %s::decode_value(const char *value_str)\n"
+            "%s{\n"
+            "%s    char *copy_p_;\n"
+            "%s    mpl_arg_t *args_p_;\n"
+            "%s    int numargs_;\n"
+            "%s    int i_;\n"
+            "%s    int tag_;\n",
+            indent, name_p,
+            indent,
+            indent,
+            indent,
+            indent,
+            indent,
             indent
            );
-
-    /* Print method */
+    MPL_LIST_FOR_EACH(pl_p, tmp_p) {
+        parameter_list_entry_p = LISTABLE_PTR(tmp_p, parameter_list_entry);
+        if (!parameter_list_entry_p->multiple)
+            fprintf(f,
+                    "%s    int found_%s_ = 0;\n",
+                    indent,
+                    parameter_list_entry_p->field_name_p
+                   );
+    }
     fprintf(f,
-            "%svoid %s::print()\n",
+            "\n"
+            "%s    clear();\n"
+            "%s    numargs_ = mpl_param_struct_split(value_str, &copy_p_, &args_p_);\n"
+            "%s    if (numargs_ < 0)\n"
+            "%s        return -1;\n"
+            "\n"
+            "%s    for (i_ = 0; i_ < numargs_; i_++) {\n"
+            "%s        const char *value_p_ = args_p_[i_].value_p;\n"
+            "\n"
+            "%s        tag_ = mpl_param_struct_key_tag(args_p_[i_].key_p);\n"
+            "%s        if (tag_ < 0)\n"
+            "%s            goto error_return;\n",
+            indent,
+            indent,
+            indent,
+            indent,
+            indent,
+            indent,
+            indent,
             indent,
-            name_p
-           );
-    fprintf(f,
-            "%s{\n",
             indent
            );
+    MPL_LIST_FOR_EACH(pl_p, tmp_p) {
+        parameter_list_entry_p = LISTABLE_PTR(tmp_p, parameter_list_entry);
+        api11_field(parameter_list_entry_p, &field);
+        fn = parameter_list_entry_p->field_name_p;
 
-    if (parent_p) {
         fprintf(f,
-                "%s    %s::print();\n",
+                "%s        %sif (!strcmp(args_p_[i_].key_p, \"%s\")) {\n",
                 indent,
-                parent_p->name_p
+                (tmp_p == pl_p) ? "" : "else ",
+                fn
                );
-    } else {
+        if (parameter_list_entry_p->multiple) {
+            /* Multiple fields are tagged from 1 and up, in order */
+            fprintf(f,
+                    "%s            if (tag_ != (int) %s.size() + 1)\n"
+                    "%s                goto error_return;\n",
+                    indent, fn,
+                    indent
+                   );
+            if (max > 0)
+                fprintf(f,
+                        "%s            if (%s.size() >= %d)\n"
+                        "%s                goto error_return;\n",
+                        indent, fn, max,
+                        indent
+                       );
+            if (field.kind != api11_field_value)
+                fprintf(f,
+                        "%s            %s.emplace_back();\n",
+                        indent, fn
+                       );
+            sprintf(ref, "%s.back()", fn);
+        }
+        else {
+            fprintf(f,
+                    "%s            if ((tag_ != 0) || found_%s_++)\n"
+                    "%s                goto error_return;\n",
+                    indent, fn,
+                    indent
+                   );
+            if (parameter_list_entry_p->optional)
+                sprintf(ref, "%s.emplace()", fn);
+            else
+                sprintf(ref, "%s", fn);
+        }
+
+        switch (field.kind) {
+            case api11_field_bag:
+                /* An empty bag is packed without value */
+                fprintf(f,
+                        "%s            if (%s.decode_value(value_p_ ? value_p_ : \"\") < 0)\n"
+                        "%s                goto error_return;\n",
+                        indent, ref,
+                        indent
+                       );
+                break;
+            case api11_field_string:
+                fprintf(f,
+                        "%s            if ((value_p_ == NULL) ||\n"
+                        "%s                (unpack_string<%s>(%s, value_p_, %s) < 0))\n"
+                        "%s                goto error_return;\n",
+                        indent,
+                        indent, field.c_type, field.paramid, ref,
+                        indent
+                       );
+                break;
+            case api11_field_array:
+                fprintf(f,
+                        "%s            if ((value_p_ == NULL) ||\n"
+                        "%s                (unpack_array<%s>(%s, value_p_, %s) < 0))\n"
+                        "%s                goto error_return;\n",
+                        indent,
+                        indent, field.c_type, field.paramid, ref,
+                        indent
+                       );
+                break;
+            default:
+                fprintf(f,
+                        "%s            %s%sv_;\n"
+                        "%s            if ((value_p_ == NULL) ||\n"
+                        "%s                (mpl_param_value_unpack_to(%s, value_p_, &v_, sizeof(v_)) < 0))\n"
+                        "%s                goto error_return;\n",
+                        indent,
+                        field.c_type,
+                        (field.c_type[strlen(field.c_type) - 1] == '*') ? "" : " ",
+                        indent,
+                        indent, field.paramid,
+                        indent
+                       );
+                if (parameter_list_entry_p->multiple)
+                    fprintf(f,
+                            "%s            %s.push_back((%s) v_);\n",
+                            indent, fn, field.type
+                           );
+                else
+                    fprintf(f,
+                            "%s            %s = (%s) v_;\n",
+                            indent, fn, field.type
+                           );
+                break;
+        }
         fprintf(f,
-                "%s    BAG::print();\n",
+                "%s        }\n",
                 indent
                );
     }
-
-    api_cc_print_parameter_list(f,
-                                indent,
-                                bag_parameter_list_p,
-                                parent_p ? ((bag_parameter*)parent_p)->bag_parameter_list_p : NULL,
-                                parameter_set_p,
-                                direction_none
-                                );
     fprintf(f,
-            "%s}\n",
+            "%s        else\n"
+            "%s            goto error_return;\n"
+            "%s    }\n"
+            "\n",
+            indent,
+            indent,
             indent
            );
 
-    /* __set_id() method */
+    /* Mandatory fields */
+    MPL_LIST_FOR_EACH(pl_p, tmp_p) {
+        parameter_list_entry_p = LISTABLE_PTR(tmp_p, parameter_list_entry);
+        fn = parameter_list_entry_p->field_name_p;
+        if (parameter_list_entry_p->optional)
+            continue;
+        if (parameter_list_entry_p->multiple)
+            fprintf(f,
+                    "%s    if (%s.empty())\n"
+                    "%s        goto error_return;\n",
+                    indent, fn,
+                    indent
+                   );
+        else
+            fprintf(f,
+                    "%s    if (!found_%s_)\n"
+                    "%s        goto error_return;\n",
+                    indent, fn,
+                    indent
+                   );
+    }
     fprintf(f,
-            "%svoid %s::__set_id()\n"
-            "%s{\n",
+            "\n"
+            "%s    free(args_p_);\n"
+            "%s    free(copy_p_);\n"
+            "%s    return 0;\n"
+            "\n"
+            "%s  error_return:\n"
+            "%s    free(args_p_);\n"
+            "%s    free(copy_p_);\n"
+            "%s    clear();\n"
+            "%s    return -1;\n"
+            "%s}\n"
+            "\n",
+            indent,
+            indent,
+            indent,
+            indent,
+            indent,
+            indent,
             indent,
-            name_p,
-            indent
-           );
-    fprintf(f,
-            "%s    __id = %s_PARAM_ID(%s);\n",
             indent,
-            snu,
-            name_p
-           );
-    fprintf(f,
-            "%s}\n",
             indent
            );
-
-    free(snu);
 }
 
 void enum_parameter::dox_enum_values(FILE *f, int level)
@@ -111,6 +111,8 @@ class parameter : public inheritable_object {
     virtual void gc_c_ranges(FILE *f, char *parameter_set_name_p);
     virtual void gc_c_field_values(FILE *f, char *parameter_set_name_p);
     virtual void gc_c_children(FILE *f, char *parameter_set_name_p);
+    /* Specialized methods, returns 0 if the parameter has none */
+    virtual int gc_c_methods(FILE *f, char *parameter_set_name_p) { return 0; }
     virtual void cli_c_write_value_help(FILE *f) { }
     virtual void cli_h_help(FILE *f);
     virtual void cli_c_help(FILE *f);
@@ -200,6 +202,7 @@ class int_parameter : public parameter {
                              value_type_t value_type2);
     virtual void *get_property(const char *property_p);
     virtual void gc_c_ranges(FILE *f, char *parameter_set_name_p);
+    virtual int gc_c_methods(FILE *f, char *parameter_set_name_p);
     virtual void latex_options(FILE *f);
     virtual void cli_c_write_value_help(FILE *f);
     virtual void help(ostream &os);
@@ -241,6 +244,7 @@ class string_parameter : public parameter {
     virtual void print_type_description(FILE *f);
     virtual int is_string() { return 1; }
     virtual int is_basic() { return 0; }
+    virtual int gc_c_methods(FILE *f, char *parameter_set_name_p);
 
     virtual void add_option(const char *option_p,
                             const char *value_p,
@@ -412,6 +416,7 @@ class enum_parameter : public parameter {
 
     void gc_h_enum(FILE *f, char *parameter_set_name_p);
     void gc_c_enum(FILE *f, char *parameter_set_name_p);
+    virtual int gc_c_methods(FILE *f, char *parameter_set_name_p);
     void cli_h_completions(FILE *f);
     void cli_c_completions(FILE *f);
     virtual void help(ostream &os);
@@ -439,7 +444,9 @@ class bag_parameter : public parameter {
         max_p(NULL),
         min_p(NULL),
         field_table_parameter_p(NULL),
-        method_ref_p(NULL)
+        method_ref_p(NULL),
+        struct_h_done(0),
+        api11_hh_done(0)
     {
     }
     bag_parameter(bag_parameter &o) :
@@ -447,7 +454,9 @@ class bag_parameter : public parameter {
         max_p(o.max_p),
         min_p(o.min_p),
         field_table_parameter_p(o.field_table_parameter_p),
-        method_ref_p(o.method_ref_p)
+        method_ref_p(o.method_ref_p),
+        struct_h_done(0),
+        api11_hh_done(0)
     {
         CLONE_LISTABLE_OBJECT_CAST(bag_parameter,parent_p);
         CLONE_LISTABLE_OBJECT_LIST(bag_parameter_list_p);
@@ -466,6 +475,11 @@ class bag_parameter : public parameter {
 
     const method *method_ref_p;
 
+    /* Native struct already declared (nested bags go first) */
+    int struct_h_done;
+    /* C++11 value class already declared (nested bags and parent go first) */
+    int api11_hh_done;
+
     virtual const char *get_type() { return type_p; }
     virtual const char *get_c_type();
     virtual const char *get_macro_type() { return "BAG"; }
@@ -491,6 +505,9 @@ class bag_parameter : public parameter {
 
     void gc_h_bag(FILE *f);
     void gc_c_bag(FILE *f);
+    bool struct_supported(int depth = 0);
+    void gc_h_struct(FILE *f);
+    void gc_c_struct(FILE *f);
     void cli_h_completions(FILE *f);
     void cli_c_completions(FILE *f);
     virtual void cli_h_help(FILE *f);
@@ -499,6 +516,9 @@ class bag_parameter : public parameter {
 
     virtual void api_hh(FILE* f, char *indent);
     virtual void api_cc(FILE* f, char *indent);
+    bool api11_supported(int depth = 0);
+    void api11_hh(FILE *f, const char *indent);
+    void api11_cc(FILE *f, const char *indent);
 
     bool param_is_field_or_subfield(parameter *param_p);
     virtual void gc_c_field_values(FILE *f, char *parameter_set_name_p);
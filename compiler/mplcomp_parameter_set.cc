@@ -318,6 +318,29 @@ parameter *parameter_set::find_parameter(char *name_p)
     return NULL;
 }
 
+/* The parameter's number in the set, as used for its parameter id
+   (see gc_h_paramids()), or 0 if it is not in the set */
+int parameter_set::get_parameter_number(char *name_p)
+{
+    mpl_list_t *tmp_p;
+    parameter_group *parameter_group_p;
+    int i = 1;
+
+    MPL_LIST_FOR_EACH(parameter_group_list_p, tmp_p) {
+        parameter_group_p = LISTABLE_PTR(tmp_p, parameter_group);
+
+        mpl_list_t *tmp_p;
+        parameter *parameter_p;
+        MPL_LIST_FOR_EACH(parameter_group_p->parameters_p, tmp_p) {
+            parameter_p = LISTABLE_PTR(tmp_p, parameter);
+            if (!strcmp(parameter_p->name_p, name_p))
+                return i;
+            i++;
+        }
+    }
+    return 0;
+}
+
 parameter_group *parameter_set::find_parameter_group(char *category_name_p)
 {
     mpl_list_t *tmp_p;
@@ -4341,6 +4364,36 @@ void parameter_set::gc_h_bags(FILE *f)
     }
 }
 
+void parameter_set::gc_h_structs(FILE *f)
+{
+    mpl_list_t *tmp_p;
+    parameter_group *parameter_group_p;
+    int structs_found = 0;
+
+    MPL_LIST_FOR_EACH(parameter_group_list_p, tmp_p) {
+        parameter_group_p = LISTABLE_PTR(tmp_p, parameter_group);
+
+        mpl_list_t *tmp_p;
+        parameter *parameter_p;
+        MPL_LIST_FOR_EACH(parameter_group_p->parameters_p, tmp_p) {
+            parameter_p = LISTABLE_PTR(tmp_p, parameter);
+            if (parameter_p->is_bag() &&
+                ((bag_parameter*)parameter_p)->struct_supported()) {
+                if (!structs_found) {
+                    fprintf(f,
+                            "\n"
+                            "/** Native structs for bags, with routines that pack and unpack them\n"
+                            "  * directly (without building a parameter list).\n"
+                            "  */\n"
+                           );
+                    structs_found = 1;
+                }
+                ((bag_parameter*)parameter_p)->gc_h_struct(f);
+            }
+        }
+    }
+}
+
 void parameter_set::cli_h(FILE *f)
 {
     mpl_list_t *tmp_p;
@@ -4444,6 +4497,10 @@ void parameter_set::gc_h(FILE *f)
         api_hh(f, (char *)"");
         return;
     }
+    else if (compiler_p->codegen_mode == codegen_mode_api11) {
+        api11_hh(f);
+        return;
+    }
 
     fprintf(f,
             "/* Parameter set %s */\n\n",
@@ -4473,6 +4530,7 @@ void parameter_set::gc_h(FILE *f)
                );
     } else {
         gc_h_bags(f);
+        gc_h_structs(f);
     }
 
     fprintf(f, "\n");
@@ -4584,6 +4642,11 @@ void parameter_set::gc_c_extra(FILE *f)
                 "#define %s_enum_size_no_enum 0\n",
                 name_p
                );
+        fprintf(f,
+                "static const mpl_enum_table_t %s_enum_table_no_enum =\n"
+                "  { NULL, 0, NULL, 0, 0, false, NULL, 0 };\n",
+                name_p
+               );
         fprintf(f,
                 "#define %s_no_enum_t\n\n",
                 name_p
@@ -4641,6 +4704,43 @@ void parameter_set::gc_c_defaults(FILE *f)
     free(psu);
 }
 
+void parameter_set::gc_c_methods(FILE *f)
+{
+    mpl_list_t *tmp_p;
+    parameter_group *parameter_group_p;
+
+    fprintf(f,
+            "/* Specialized methods */\n"
+           );
+
+    MPL_LIST_FOR_EACH(parameter_group_list_p, tmp_p) {
+        parameter_group_p = LISTABLE_PTR(tmp_p, parameter_group);
+
+        mpl_list_t *tmp_p;
+        parameter *parameter_p;
+        MPL_LIST_FOR_EACH(parameter_group_p->parameters_p, tmp_p) {
+            parameter_p = LISTABLE_PTR(tmp_p, parameter);
+            if (parameter_p->gc_c_methods(f, name_p))
+                continue;
+
+            /* The methods of the type */
+            char *pn = parameter_p->name_p;
+            char *type_p = (char *) parameter_p->get_property("type");
+            fprintf(f,
+                    "#define %s_pack_%s mpl_pack_param_value_%s\n"
+                    "#define %s_unpack_%s mpl_unpack_param_value_%s\n"
+                    "#define %s_clone_%s mpl_clone_param_value_%s\n"
+                    "#define %s_packed_size_%s mpl_packed_size_param_value_%s\n"
+                    "\n",
+                    name_p, pn, type_p,
+                    name_p, pn, type_p,
+                    name_p, pn, type_p,
+                    name_p, pn, type_p
+                   );
+        }
+    }
+}
+
 void parameter_set::gc_c_param_descr(FILE *f)
 {
     char *psl = name_p;
@@ -4668,10 +4768,22 @@ void parameter_set::gc_c_param_descr(FILE *f)
             "  NULL, \\\n", /* Deprecated max_p */
             psl
            );
+    if (compiler_p->specialize)
+        fprintf(f,
+                "  %s_pack_##ELEMENT, \\\n"
+                "  %s_unpack_##ELEMENT, \\\n"
+                "  %s_clone_##ELEMENT, \\\n",
+                psl,
+                psl,
+                psl
+               );
+    else
+        fprintf(f,
+                "  mpl_pack_param_value_##TYPE, \\\n"
+                "  mpl_unpack_param_value_##TYPE, \\\n"
+                "  mpl_clone_param_value_##TYPE, \\\n"
+               );
     fprintf(f,
-            "  mpl_pack_param_value_##TYPE, \\\n"
-            "  mpl_unpack_param_value_##TYPE, \\\n"
-            "  mpl_clone_param_value_##TYPE, \\\n"
             "  mpl_copy_param_value_##TYPE, \\\n"
             "  mpl_compare_param_value_##TYPE, \\\n"
             "  mpl_sizeof_param_value_##TYPE, \\\n"
@@ -4682,9 +4794,21 @@ void parameter_set::gc_c_param_descr(FILE *f)
             psl
            );
     fprintf(f,
-            "  0 \\\n" /* Deprecated stringarr_size */
-            "},\n",
-            psl
+            "  0, \\\n" /* Deprecated stringarr_size */
+            "  mpl_pack_bin_param_value_##TYPE, \\\n"
+            "  mpl_unpack_bin_param_value_##TYPE, \\\n"
+           );
+    if (compiler_p->specialize)
+        fprintf(f,
+                "  %s_packed_size_##ELEMENT \\\n",
+                psl
+               );
+    else
+        fprintf(f,
+                "  mpl_packed_size_param_value_##TYPE \\\n"
+               );
+    fprintf(f,
+            "},\n"
            );
     fprintf(f,
             "\n"
@@ -4766,7 +4890,11 @@ void parameter_set::gc_c_param_descr(FILE *f)
             psl
            );
     fprintf(f,
-            "  %s_children_size_##ELEMENT \\\n",
+            "  %s_children_size_##ELEMENT, \\\n",
+            psl
+           );
+    fprintf(f,
+            "  &%s_enum_table_##EXTRA \\\n",
             psl
            );
     fprintf(f,
@@ -4877,6 +5005,33 @@ void parameter_set::gc_c_bags(FILE *f)
     }
 }
 
+void parameter_set::gc_c_structs(FILE *f)
+{
+    mpl_list_t *tmp_p;
+    parameter_group *parameter_group_p;
+    int structs_found = 0;
+
+    MPL_LIST_FOR_EACH(parameter_group_list_p, tmp_p) {
+        parameter_group_p = LISTABLE_PTR(tmp_p, parameter_group);
+
+        mpl_list_t *tmp_p;
+        parameter *parameter_p;
+        MPL_LIST_FOR_EACH(parameter_group_p->parameters_p, tmp_p) {
+            parameter_p = LISTABLE_PTR(tmp_p, parameter);
+            if (parameter_p->is_bag() &&
+                ((bag_parameter*)parameter_p)->struct_supported()) {
+                if (!structs_found) {
+                    fprintf(f,
+                            "/* Native struct routines */\n"
+                           );
+                    structs_found = 1;
+                }
+                ((bag_parameter*)parameter_p)->gc_c_struct(f);
+            }
+        }
+    }
+}
+
 void parameter_set::gc_c(FILE *f)
 {
     char *short_name_p;
@@ -4889,6 +5044,10 @@ void parameter_set::gc_c(FILE *f)
         api_cc(f, (char*)"");
         return;
     }
+    else if (compiler_p->codegen_mode == codegen_mode_api11) {
+        api11_cc(f);
+        return;
+    }
 
     fprintf(f,
             "/* Parameter set %s */\n\n",
@@ -4900,6 +5059,8 @@ void parameter_set::gc_c(FILE *f)
     gc_c_children(f);
     gc_c_extra(f);
     gc_c_defaults(f);
+    if (compiler_p->specialize)
+        gc_c_methods(f);
     gc_c_param_descr(f);
     gc_c_param_init(f);
     short_name_p = get_short_name();
@@ -4909,6 +5070,7 @@ void parameter_set::gc_c(FILE *f)
                );
     } else {
         gc_c_bags(f);
+        gc_c_structs(f);
     }
 
     fprintf(f,
@@ -5272,6 +5434,168 @@ void parameter_set::api_cc(FILE *f, char *indent)
     free(newindent);
 }
 
+void parameter_set::api11_hh(FILE *f)
+{
+    mpl_list_t *tmp_p;
+    parameter_group *parameter_group_p;
+    const char *indent = "        ";
+
+    fprintf(f,
+            "namespace %s {\n"
+            "    namespace api11 {\n",
+            name_p
+           );
+
+#define INDENT(str) fprintf(f, "%s%s", indent, str)
+    INDENT("/**\n");
+    INDENT("  * Presence of an optional field, like std::optional (C++17). The\n");
+    INDENT("  * value is stored inline.\n");
+    INDENT("  */\n");
+    INDENT("template <typename T> class optional {\n");
+    INDENT("    public:\n");
+    INDENT("        optional() : has_(false), value_() {}\n");
+    INDENT("        optional(const T &value) : has_(true), value_(value) {}\n");
+    INDENT("        optional(T &&value) : has_(true), value_(std::move(value)) {}\n");
+    INDENT("        optional &operator=(const T &value) { has_ = true; value_ = value; return *this; }\n");
+    INDENT("        optional &operator=(T &&value) { has_ = true; value_ = std::move(value); return *this; }\n");
+    INDENT("        bool has_value() const { return has_; }\n");
+    INDENT("        explicit operator bool() const { return has_; }\n");
+    INDENT("        T &value() { return value_; }\n");
+    INDENT("        const T &value() const { return value_; }\n");
+    INDENT("        T &operator*() { return value_; }\n");
+    INDENT("        const T &operator*() const { return value_; }\n");
+    INDENT("        T *operator->() { return &value_; }\n");
+    INDENT("        const T *operator->() const { return &value_; }\n");
+    INDENT("        T &emplace() { has_ = true; value_ = T(); return value_; }\n");
+    INDENT("        void reset() { has_ = false; value_ = T(); }\n");
+    INDENT("        bool operator==(const optional &other) const {\n");
+    INDENT("            return (has_ == other.has_) && (!has_ || (value_ == other.value_));\n");
+    INDENT("        }\n");
+    INDENT("        bool operator!=(const optional &other) const { return !(*this == other); }\n");
+    INDENT("    private:\n");
+    INDENT("        bool has_;\n");
+    INDENT("        T value_;\n");
+    INDENT("};\n");
+#undef INDENT
+
+    MPL_LIST_FOR_EACH(parameter_group_list_p, tmp_p) {
+        parameter_group_p = LISTABLE_PTR(tmp_p, parameter_group);
+
+        mpl_list_t *tmp_p;
+        parameter *parameter_p;
+        MPL_LIST_FOR_EACH(parameter_group_p->parameters_p, tmp_p) {
+            parameter_p = LISTABLE_PTR(tmp_p, parameter);
+            if (parameter_p->is_bag() &&
+                ((bag_parameter*)parameter_p)->api11_supported())
+                ((bag_parameter*)parameter_p)->api11_hh(f, indent);
+        }
+    }
+
+    fprintf(f,
+            "    }\n"
+            "}\n"
+           );
+}
+
+void parameter_set::api11_cc(FILE *f)
+{
+    mpl_list_t *tmp_p;
+    parameter_group *parameter_group_p;
+    const char *indent = "        ";
+
+    fprintf(f,
+            "namespace %s {\n"
+            "    namespace api11 {\n",
+            name_p
+           );
+
+#define INDENT(str) fprintf(f, "%s%s", indent, str)
+    /* Pack straight into the output string, retrying once if it is too short */
+    INDENT("static inline int pack_value(std::string &out, mpl_param_element_id_t param_id, const void *value_p)\n");
+    INDENT("{\n");
+    INDENT("    size_t pos = out.size();\n");
+    INDENT("    int len;\n");
+    INDENT("\n");
+    INDENT("    out.resize(pos + 32);\n");
+    INDENT("    len = mpl_param_value_pack(param_id, value_p, &out[pos], 32);\n");
+    INDENT("    if (len >= 32) {\n");
+    INDENT("        out.resize(pos + len + 1);\n");
+    INDENT("        len = mpl_param_value_pack(param_id, value_p, &out[pos], len + 1);\n");
+    INDENT("    }\n");
+    INDENT("    if (len < 0) {\n");
+    INDENT("        out.resize(pos);\n");
+    INDENT("        return -1;\n");
+    INDENT("    }\n");
+    INDENT("    out.resize(pos + len);\n");
+    INDENT("    return 0;\n");
+    INDENT("}\n");
+    INDENT("static inline void pack_name(std::string &out, bool &first, const char *name_p, size_t tag)\n");
+    INDENT("{\n");
+    INDENT("    char buf[24];\n");
+    INDENT("\n");
+    INDENT("    if (!first)\n");
+    INDENT("        out += ',';\n");
+    INDENT("    first = false;\n");
+    INDENT("    out += name_p;\n");
+    INDENT("    if (tag > 0) {\n");
+    INDENT("        snprintf(buf, sizeof(buf), \"[%zu]\", tag);\n");
+    INDENT("        out += buf;\n");
+    INDENT("    }\n");
+    INDENT("}\n");
+    INDENT("template <typename A, typename T>\n");
+    INDENT("static inline int pack_array(std::string &out, mpl_param_element_id_t param_id, const std::vector<T> &v)\n");
+    INDENT("{\n");
+    INDENT("    A a;\n");
+    INDENT("\n");
+    INDENT("    a.len = v.size();\n");
+    INDENT("    a.arr_p = const_cast<T*>(v.data());\n");
+    INDENT("    return pack_value(out, param_id, &a);\n");
+    INDENT("}\n");
+    INDENT("template <typename C, typename S>\n");
+    INDENT("static inline int unpack_string(mpl_param_element_id_t param_id, const char *value_str, S &s)\n");
+    INDENT("{\n");
+    INDENT("    void *value_p;\n");
+    INDENT("\n");
+    INDENT("    if (mpl_param_value_unpack(param_id, value_str, &value_p) < 0)\n");
+    INDENT("        return -1;\n");
+    INDENT("    s.assign((const C*) value_p);\n");
+    INDENT("    mpl_param_value_free(param_id, value_p);\n");
+    INDENT("    return 0;\n");
+    INDENT("}\n");
+    INDENT("template <typename A, typename T>\n");
+    INDENT("static inline int unpack_array(mpl_param_element_id_t param_id, const char *value_str, std::vector<T> &v)\n");
+    INDENT("{\n");
+    INDENT("    void *value_p;\n");
+    INDENT("    A *a_p;\n");
+    INDENT("\n");
+    INDENT("    if (mpl_param_value_unpack(param_id, value_str, &value_p) < 0)\n");
+    INDENT("        return -1;\n");
+    INDENT("    a_p = (A*) value_p;\n");
+    INDENT("    v.assign(a_p->arr_p, a_p->arr_p + a_p->len);\n");
+    INDENT("    mpl_param_value_free(param_id, value_p);\n");
+    INDENT("    return 0;\n");
+    INDENT("}\n");
+#undef INDENT
+
+    MPL_LIST_FOR_EACH(parameter_group_list_p, tmp_p) {
+        parameter_group_p = LISTABLE_PTR(tmp_p, parameter_group);
+
+        mpl_list_t *tmp_p;
+        parameter *parameter_p;
+        MPL_LIST_FOR_EACH(parameter_group_p->parameters_p, tmp_p) {
+            parameter_p = LISTABLE_PTR(tmp_p, parameter);
+            if (parameter_p->is_bag() &&
+                ((bag_parameter*)parameter_p)->api11_supported())
+                ((bag_parameter*)parameter_p)->api11_cc(f, indent);
+        }
+    }
+
+    fprintf(f,
+            "    }\n"
+            "}\n"
+           );
+}
+
 void parameter_set::convert_doc()
 {
     mpl_list_t *tmp_p;
@@ -0,0 +1,217 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string.h>
+
+#include <string>
+#include <utility>
+
+#include "personnel.h"
+#include "personnel_api11.hh"
+
+using namespace personnel::api11;
+
+void usage()
+{
+    printf("Usage: pers_cc_api11 options\n");
+    printf("    -h Show command usage\n");
+    printf("    -i input pipe\n");
+    printf("    -o output pipe\n");
+}
+
+// Send a request and decode the response into resp (the value classes
+// encode to and decode from the packed message directly)
+template <typename REQ, typename RESP>
+static int transact(FILE *fi, FILE *fo, const REQ &req, RESP &resp)
+{
+    std::string msg;
+    char buf[1024];
+
+    if (req.encode(msg) < 0) {
+        printf("Failed encoding request\n");
+        return -1;
+    }
+    fprintf(fo, "%s\n", msg.c_str());
+    printf("Sent: %s\n", msg.c_str());
+    fflush(fo);
+
+    if (fgets(buf, sizeof(buf), fi) == NULL) {
+        printf("No response\n");
+        return -1;
+    }
+    printf("Received: %s", buf);
+    buf[strcspn(buf, "\n")] = '\0';
+    if (resp.decode(buf) < 0) {
+        printf("Failed decoding response\n");
+        return -1;
+    }
+    return 0;
+}
+
+static Employee make_employee(const char *first, const char *last,
+                              int born_year, int born_month, int born_day,
+                              int hired_year, int hired_month, int hired_day)
+{
+    Employee e;
+
+    e.name.first = first;
+    e.name.last = last;
+    e.born.year = born_year;
+    e.born.month = born_month;
+    e.born.day = born_day;
+    e.gender = personnel_Gender_male;
+    e.hired.year = hired_year;
+    e.hired.month = hired_month;
+    e.hired.day = hired_day;
+    return e;
+}
+
+int main(int argc, char **argv)
+{
+    int i;
+    int opt;
+    char *pi = NULL;
+    char *po = NULL;
+    FILE *fi;
+    FILE *fo;
+
+    if (argc < 2) {
+        usage();
+        exit(-1);
+    }
+
+    printf("CC API11 DEMO started with arguments:");
+    for (i = 0 ; i < argc; i++)
+        printf(" %s", argv[i]);
+    printf("\n");
+    while (-1 != (opt = getopt(argc, argv, "i:o:h"))) {
+        switch (opt) {
+        case 'h':
+            usage();
+            return -1;
+        case 'i':
+            pi = optarg;
+            break;
+        case 'o':
+            po = optarg;
+            break;
+        default:
+            printf("unsupported option received\n");
+            return -1;
+        }
+    }
+
+    if (!pi) {
+        fprintf(stderr, "Input pipe not specified\n");
+        exit(-1);
+    }
+
+    if (!po) {
+        fprintf(stderr, "Output pipe not specified\n");
+        exit(-1);
+    }
+
+    fo = fopen(po, "w");
+    if (!fo) {
+        fprintf(stderr, "Error opening file '%s' for writing\n", po);
+        exit(-1);
+    }
+
+    fi = fopen(pi, "r");
+    if (!fi) {
+        fprintf(stderr, "Error opening file '%s' for reading\n", pi);
+        exit(-1);
+    }
+
+    if (personnel_param_init())
+    {
+        printf("personnel_param_init() failed\n");
+        return -1;
+    }
+
+    void *userData = (void*)0xabbababe;
+    uint16_t numbers[2] = { 0, 0 };
+
+    ////////
+    // ADD
+    Employee employees[2] = {
+        make_employee("Per", "Sigmond", 1961, 3, 5, 2013, 2, 21),
+        make_employee("Buster", "Minal", 1991, 7, 4, 2011, 8, 1)
+    };
+    for (i = 0; i < 2; i++) {
+        printf("ADD REQUEST/RESPONSE #%d:\n", i + 1);
+        Add_Req addReq;
+        Add_Resp addResp;
+        addReq.userdata = userData;
+        // The employee is moved into the request, not copied
+        addReq.employee = std::move(employees[i]);
+        if (transact(fi, fo, addReq, addResp) < 0)
+            return -1;
+        numbers[i] = addResp.number;
+        printf("Employee added with number=%d\n", numbers[i]);
+    }
+    // ADD end
+    ////////
+
+    ////////
+    // GET
+    for (i = 0; i < 2; i++) {
+        printf("GET REQUEST/RESPONSE #%d:\n", i + 1);
+        Get_Req getReq;
+        Get_Resp getResp;
+        getReq.userdata = userData;
+        getReq.number = numbers[i];
+        if (transact(fi, fo, getReq, getResp) < 0)
+            return -1;
+        if (getResp.employee)
+            printf("Name: %s %s\n",
+                   getResp.employee->name.first.c_str(),
+                   getResp.employee->name.last.c_str());
+    }
+    // GET end
+    ////////
+
+    ////////
+    // FIND
+    printf("FIND REQUEST/RESPONSE:\n");
+    Find_Req findReq;
+    Find_Resp findResp;
+    findReq.userdata = userData;
+    if (transact(fi, fo, findReq, findResp) < 0)
+        return -1;
+    for (size_t n = 0; n < findResp.employees.size(); n++) {
+        printf("Name #%d: %s %s\n",
+               (int) n + 1,
+               findResp.employees[n].name.first.c_str(),
+               findResp.employees[n].name.last.c_str());
+    }
+    // FIND end
+    ////////
+
+    ////////
+    // DELETE
+    for (i = 0; i < 2; i++) {
+        printf("DELETE REQUEST/RESPONSE #%d:\n", i + 1);
+        Delete_Req deleteReq;
+        Delete_Resp deleteResp;
+        deleteReq.userdata = userData;
+        deleteReq.number = numbers[i];
+        if (transact(fi, fo, deleteReq, deleteResp) < 0)
+            return -1;
+        printf("Result: %s\n", PERS_ENUM_VAR_TO_STRING_PTR(Error, deleteResp.error));
+    }
+    // DELETE end
+    ////////
+
+    if (fi != stdin)
+        fclose(fi);
+    if ((fo != stdout) && (fo != stderr))
+        fclose(fo);
+
+    printf("Halting the CC API11 DEMO\n");
+
+    mpl_param_system_deinit();
+
+    printf("DONE\n");
+    return 0;
+}
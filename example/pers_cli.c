@@ -5,6 +5,7 @@
 
 #include "personnel.h"
 #include "personnel_cli.h"
+#include "mpl_file.h"
 
 #include "linenoise.h"
 
@@ -18,31 +19,16 @@ static int checkCommand(mpl_list_t *cmdMsg);
 
 static int pack_and_send(mpl_list_t *msg)
 {
-    char *buf = NULL;
-    int len;
-    int ret = -1;
-
-    len = mpl_param_list_pack(msg, NULL, 0);
-    if (len <= 0) {
-        printf("!!! FAILED PACKING MESSAGE !!!\n");
-        goto exit;
-    }
-    buf = malloc(len+1);
-    len = mpl_param_list_pack(msg, buf, len+1);
-    if (len <= 0) {
+    if (mpl_param_list_pack_stream(msg, mpl_file_write_func, fo, NULL) < 0) {
         printf("!!! FAILED PACKING MESSAGE !!!\n");
-        goto exit;
+        return -1;
     }
 
-    if (fprintf(fo, "%s\n", buf) <= 0) {
+    if (fputc('\n', fo) == EOF) {
         fprintf(stderr, "!!! FAILED SENDING MESSAGE !!!\n");
     }
     fflush(fo);
-    ret = 0;
-
-  exit:
-    free(buf);
-    return ret;
+    return 0;
 }
 
 static void completion(const char *buf, linenoiseCompletions *lc) {
@@ -17,19 +17,54 @@
  */
 
 #include "personnel.h"
-#include "mpl_file.h"
+#include "mpl_store.h"
 #include "pers_db.h"
 #include <assert.h>
 
-static FILE *dbfile;
+/* Records are personnel.Employee bags, keyed by the number field */
+static mpl_store_t *dbstore;
+static uint16_t next_number = EMPLOYEE_NUMBER_BASE;
+
+static int find_max_number(void *ctx_p, const mpl_param_element_t *record)
+{
+    uint16_t tmpnum = PERS_GET_Employee_number(record->value_p);
+
+    if (tmpnum >= next_number)
+        next_number = tmpnum + 1;
+    return 0;
+}
+
+static mpl_store_t *persdb_store(void)
+{
+    mpl_store_options_t options;
+
+    if (dbstore)
+        return dbstore;
+
+    options.param_set_id = PERSONNEL_PARAM_SET_ID;
+    options.record_id = PERS_PARAM_ID(Employee);
+    options.key_context = PERS_PARAM_ID(Employee);
+    options.key_field = PERS_FIELD_INDEX(Employee, number);
+    options.sync_interval = MPL_STORE_DEFAULT_SYNC_INTERVAL;
+    options.compact_min = MPL_STORE_DEFAULT_COMPACT_MIN;
+
+    dbstore = mpl_store_open(PERSDB_FILENAME, &options);
+    if (dbstore)
+        (void) mpl_store_foreach(dbstore, find_max_number, NULL);
+    return dbstore;
+}
+
+void persdb_close(void)
+{
+    (void) mpl_store_close(dbstore);
+    dbstore = NULL;
+}
 
 PERS_ENUM_TYPE(Error) persdb_Add(mpl_bag_t *employee, uint16_t *number)
 {
-    mpl_list_t *tmp;
-    mpl_list_t *dblist = NULL;
     mpl_bag_t *employee_copy;
-    uint16_t new_number = EMPLOYEE_NUMBER_BASE;
-    uint16_t max_number = EMPLOYEE_NUMBER_UNDEFINED;
+    mpl_param_element_t *record;
+    mpl_store_t *store;
     int ret;
 
     PERS_ENUM_VAR_DECLARE_INIT(Error, error, success);
@@ -37,203 +72,140 @@ PERS_ENUM_TYPE(Error) persdb_Add(mpl_bag_t *employee, uint16_t *number)
     if (PERS_GET_Employee_number(employee) != EMPLOYEE_NUMBER_UNDEFINED) {
         error = PERS_ENUM_VALUE(Error, parameter);
         *number = EMPLOYEE_NUMBER_UNDEFINED;
-        goto finish;
+        return error;
     }
 
-    dbfile = fopen(PERSDB_FILENAME, "r");
-    if (dbfile) {
-        ret = mpl_file_read_params(dbfile, &dblist, PERSONNEL_PARAM_SET_ID);
-        fclose(dbfile);
-        if (ret) {
-            error = PERS_ENUM_VALUE(Error, general);
-            *number = EMPLOYEE_NUMBER_UNDEFINED;
-            goto finish;
-        }
-    }
-    MPL_LIST_FOR_EACH(dblist, tmp) {
-        uint16_t tmpnum;
-        mpl_bag_t *tmpempl =
-            MPL_LIST_CONTAINER(tmp, mpl_param_element_t, list_entry)->value_p;
-        tmpnum = PERS_GET_Employee_number(tmpempl);
-        max_number = tmpnum > max_number ? tmpnum : max_number;
-    }
-    if (max_number != EMPLOYEE_NUMBER_UNDEFINED){
-        new_number = max_number + 1;
+    store = persdb_store();
+    if (!store) {
+        error = PERS_ENUM_VALUE(Error, general);
+        *number = EMPLOYEE_NUMBER_UNDEFINED;
+        return error;
     }
 
     employee_copy = mpl_param_list_clone(employee);
     PERS_REMOVE_FIELD(employee_copy, Employee, number);
-    PERS_ADD_Employee_number(&employee_copy, new_number);
-    mpl_add_param_to_list(&dblist,
-                          PERS_PARAM_ID(Employee),
-                          employee_copy
-                         );
+    PERS_ADD_Employee_number(&employee_copy, next_number);
+    record = mpl_param_element_create(PERS_PARAM_ID(Employee), employee_copy);
     mpl_param_list_destroy(&employee_copy);
-    dbfile = fopen(PERSDB_FILENAME, "w");
-    if (!dbfile || mpl_file_write_params_no_prefix(dbfile, dblist)) {
+
+    ret = record ? mpl_store_put(store, record) : -1;
+    mpl_param_element_destroy(record);
+    if (ret) {
         error = PERS_ENUM_VALUE(Error, general);
         *number = EMPLOYEE_NUMBER_UNDEFINED;
-        goto finish;
+        return error;
     }
-    fclose(dbfile);
-    *number = new_number;
-
-finish:
-    mpl_param_list_destroy(&dblist);
+    *number = next_number++;
     return error;
 }
 
 PERS_ENUM_TYPE(Error) persdb_Get(uint16_t number, mpl_bag_t **employee)
 {
-    mpl_list_t *tmp;
-    mpl_list_t *dblist = NULL;
-    int ret;
+    mpl_param_element_t *key;
+    const mpl_param_element_t *record;
+    mpl_store_t *store;
     PERS_ENUM_VAR_DECLARE_INIT(Error, error, not_found);
 
-    if (number == EMPLOYEE_NUMBER_UNDEFINED) {
-        error = PERS_ENUM_VALUE(Error, parameter);
-        *employee = NULL;
-        goto finish;
-    }
+    *employee = NULL;
+    if (number == EMPLOYEE_NUMBER_UNDEFINED)
+        return PERS_ENUM_VALUE(Error, parameter);
 
-    dbfile = fopen(PERSDB_FILENAME, "r");
-    if (!dbfile) {
-        error = PERS_ENUM_VALUE(Error, general);
-        *employee = NULL;
-        goto finish;
-    }
-    else {
-        ret = mpl_file_read_params(dbfile, &dblist, PERSONNEL_PARAM_SET_ID);
-        fclose(dbfile);
-        if (ret) {
-            error = PERS_ENUM_VALUE(Error, general);
-            *employee = NULL;
-            goto finish;
-        }
-    }
-    MPL_LIST_FOR_EACH(dblist, tmp) {
-        uint16_t tmpnum;
-        mpl_bag_t *tmpempl =
-            MPL_LIST_CONTAINER(tmp, mpl_param_element_t, list_entry)->value_p;
-        if (PERS_GET_Employee_number(tmpempl) == number){
-            *employee = mpl_param_list_clone(tmpempl);
-            error = PERS_ENUM_VALUE(Error, success);
-            break;
-        }
+    store = persdb_store();
+    key = mpl_param_element_create(PERS_PARAM_ID(EmployeeNumber), &number);
+    if (!store || !key) {
+        mpl_param_element_destroy(key);
+        return PERS_ENUM_VALUE(Error, general);
     }
 
-finish:
-    mpl_param_list_destroy(&dblist);
+    record = mpl_store_get(store, key);
+    if (record) {
+        *employee = mpl_param_list_clone(record->value_p);
+        error = PERS_ENUM_VALUE(Error, success);
+    }
+    mpl_param_element_destroy(key);
     return error;
 }
 
 PERS_ENUM_TYPE(Error) persdb_Delete(uint16_t number)
 {
-    mpl_list_t *tmp;
-    mpl_list_t *tmp2;
-    mpl_list_t *dblist = NULL;
+    mpl_param_element_t *key;
+    mpl_store_t *store;
     int ret;
     PERS_ENUM_VAR_DECLARE_INIT(Error, error, not_found);
 
-    if (number == EMPLOYEE_NUMBER_UNDEFINED) {
-        error = PERS_ENUM_VALUE(Error, parameter);
-        goto finish;
-    }
+    if (number == EMPLOYEE_NUMBER_UNDEFINED)
+        return PERS_ENUM_VALUE(Error, parameter);
 
-    dbfile = fopen(PERSDB_FILENAME, "r");
-    if (!dbfile) {
-        error = PERS_ENUM_VALUE(Error, general);
-        goto finish;
-    }
-    else {
-        ret = mpl_file_read_params(dbfile, &dblist, PERSONNEL_PARAM_SET_ID);
-        fclose(dbfile);
-        if (ret) {
-            error = PERS_ENUM_VALUE(Error, general);
-            goto finish;
-        }
-    }
-    MPL_LIST_FOR_EACH_SAFE(dblist, tmp, tmp2) {
-        uint16_t tmpnum;
-        mpl_bag_t *tmpempl;
-        mpl_param_element_t *elem = MPL_LIST_CONTAINER(tmp, mpl_param_element_t, list_entry);
-        tmpempl = elem->value_p;
-        if (PERS_GET_Employee_number(tmpempl) == number){
-            mpl_list_remove(&dblist, tmp);
-            mpl_param_element_destroy(elem);
-            error = PERS_ENUM_VALUE(Error, success);
-            break;
-        }
+    store = persdb_store();
+    key = mpl_param_element_create(PERS_PARAM_ID(EmployeeNumber), &number);
+    if (!store || !key) {
+        mpl_param_element_destroy(key);
+        return PERS_ENUM_VALUE(Error, general);
     }
 
-    dbfile = fopen(PERSDB_FILENAME, "w");
-    if (!dbfile) {
+    ret = mpl_store_delete(store, key);
+    if (ret > 0)
+        error = PERS_ENUM_VALUE(Error, success);
+    else if (ret < 0)
         error = PERS_ENUM_VALUE(Error, general);
-        goto finish;
-    }
-    if (dblist && mpl_file_write_params_no_prefix(dbfile, dblist)) {
-        error = PERS_ENUM_VALUE(Error, general);
-    }
-    fclose(dbfile);
-
-finish:
-    mpl_param_list_destroy(&dblist);
+    mpl_param_element_destroy(key);
     return error;
 }
 
+typedef struct {
+    char *first;
+    char *middle;
+    char *last;
+    mpl_list_t **employees;
+} find_ctx_t;
+
+static int find_employee(void *ctx_p, const mpl_param_element_t *record)
+{
+    find_ctx_t *ctx = ctx_p;
+    mpl_bag_t *name;
+    mpl_bag_t *tmpempl = record->value_p;
+
+    name = PERS_GET_Employee_name_PTR(tmpempl);
+    if (ctx->first)
+        if ((PERS_Name_first_EXISTS(name) &&
+             strcmp(PERS_GET_Name_first_PTR(name), ctx->first)) ||
+            !PERS_Name_first_EXISTS(name))
+            return 0;
+    if (ctx->middle)
+        if ((PERS_Name_middle_EXISTS(name) &&
+             strcmp(PERS_GET_Name_middle_PTR(name), ctx->middle)) ||
+            !PERS_Name_middle_EXISTS(name))
+            return 0;
+    if (ctx->last)
+        if ((PERS_Name_last_EXISTS(name) &&
+             strcmp(PERS_GET_Name_last_PTR(name), ctx->last)) ||
+            !PERS_Name_last_EXISTS(name))
+            return 0;
+    mpl_add_param_to_list(ctx->employees,
+                          PERS_PARAM_ID(Employee),
+                          tmpempl
+                         );
+    return 0;
+}
+
 PERS_ENUM_TYPE(Error) persdb_Find(char *first,
                                   char *middle,
                                   char *last,
                                   mpl_list_t **employees)
 {
-    mpl_list_t *tmp;
-    mpl_list_t *dblist = NULL;
-    int ret;
-    PERS_ENUM_VAR_DECLARE_INIT(Error, error, success);
+    find_ctx_t ctx;
+    mpl_store_t *store;
 
-    dbfile = fopen(PERSDB_FILENAME, "r");
-    if (!dbfile) {
-        error = PERS_ENUM_VALUE(Error, general);
+    store = persdb_store();
+    if (!store) {
         *employees = NULL;
-        goto finish;
-    }
-    else {
-        ret = mpl_file_read_params(dbfile, &dblist, PERSONNEL_PARAM_SET_ID);
-        fclose(dbfile);
-        if (ret) {
-            error = PERS_ENUM_VALUE(Error, general);
-            *employees = NULL;
-            goto finish;
-        }
-    }
-    MPL_LIST_FOR_EACH(dblist, tmp) {
-        mpl_bag_t *name;
-        mpl_bag_t *tmpempl =
-            MPL_LIST_CONTAINER(tmp, mpl_param_element_t, list_entry)->value_p;
-        name = PERS_GET_Employee_name_PTR(tmpempl);
-        if (first)
-            if ((PERS_Name_first_EXISTS(name) &&
-                 strcmp(PERS_GET_Name_first_PTR(name), first)) ||
-                !PERS_Name_first_EXISTS(name))
-                continue;
-        if (middle)
-            if ((PERS_Name_middle_EXISTS(name) &&
-                 strcmp(PERS_GET_Name_middle_PTR(name), middle)) ||
-                !PERS_Name_middle_EXISTS(name))
-                continue;
-        if (last)
-            if ((PERS_Name_last_EXISTS(name) &&
-                 strcmp(PERS_GET_Name_last_PTR(name), last)) ||
-                !PERS_Name_last_EXISTS(name))
-                continue;
-        mpl_add_param_to_list(employees,
-                              PERS_PARAM_ID(Employee),
-                              tmpempl
-                             );
+        return PERS_ENUM_VALUE(Error, general);
     }
 
-finish:
-    mpl_param_list_destroy(&dblist);
-    return error;
+    ctx.first = first;
+    ctx.middle = middle;
+    ctx.last = last;
+    ctx.employees = employees;
+    (void) mpl_store_foreach(store, find_employee, &ctx);
+    return PERS_ENUM_VALUE(Error, success);
 }
-
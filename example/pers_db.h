@@ -27,6 +27,9 @@
 #define PERSDB_FILENAME "personnel.db"
 #endif
 
+/* The database is opened on first use, close it before exit */
+void persdb_close(void);
+
 PERS_ENUM_TYPE(Error) persdb_Add(mpl_bag_t *employee, uint16_t *number);
 PERS_ENUM_TYPE(Error) persdb_Get(uint16_t number, mpl_bag_t **employee);
 PERS_ENUM_TYPE(Error) persdb_Delete(uint16_t number);
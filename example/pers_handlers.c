@@ -22,19 +22,27 @@
 #include <stdlib.h>
 
 
-static mpl_list_t *handle_Add(mpl_bag_t *reqParams);
-static mpl_list_t *handle_Get(mpl_bag_t *reqParams);
-static mpl_list_t *handle_Delete(mpl_bag_t *reqParams);
-static mpl_list_t *handle_Find(mpl_bag_t *reqParams);
+static mpl_list_t *handle_Add(mpl_bag_t *reqParams, void *ctx_p);
+static mpl_list_t *handle_Get(mpl_bag_t *reqParams, void *ctx_p);
+static mpl_list_t *handle_Delete(mpl_bag_t *reqParams, void *ctx_p);
+static mpl_list_t *handle_Find(mpl_bag_t *reqParams, void *ctx_p);
 static char *get_error_info(mpl_list_t *check_result_list_p);
 
+static const persfile_handlers_t handlers = {
+    .Add = handle_Add,
+    .Get = handle_Get,
+    .Delete = handle_Delete,
+    .Find = handle_Find,
+};
+
 mpl_list_t *handle_persfile(mpl_list_t *reqMsg)
 {
-    mpl_bag_t *reqParams;
+    mpl_bag_t *reqParams = NULL;
     int check_ret;
     mpl_list_t *check_result_list_p = NULL;
     char *errorinfo = NULL;
     mpl_param_element_t *elem_p;
+    mpl_list_t *respMsg = NULL;
 
     if (!PERSFILE_IS_COMMAND(reqMsg)) {
         goto req_failure;
@@ -51,22 +59,12 @@ mpl_list_t *handle_persfile(mpl_list_t *reqMsg)
         goto req_failure;
     }
 
-    switch (PERSFILE_GET_COMMAND_ID(reqMsg)) {
-        case PERS_PARAM_ID(Add_Req):
-            return handle_Add(reqParams);
-        case PERS_PARAM_ID(Get_Req):
-            return handle_Get(reqParams);
-        case PERS_PARAM_ID(Delete_Req):
-            return handle_Delete(reqParams);
-        case PERS_PARAM_ID(Find_Req):
-            return handle_Find(reqParams);
-        default:
-            break;
-    }
+    respMsg = persfile_dispatch(&handlers, reqMsg, NULL);
+    if (respMsg != NULL)
+        return respMsg;
 
 req_failure:
     {
-        mpl_list_t *respMsg = NULL;
         mpl_bag_t *respParams = NULL;
         PERS_ENUM_VAR_DECLARE_INIT(Error, error, parameter);
         PERS_ADD_Resp_error(&respParams, error);
@@ -84,7 +82,7 @@ req_failure:
     }
 }
 
-static mpl_list_t *handle_Add(mpl_bag_t *reqParams)
+static mpl_list_t *handle_Add(mpl_bag_t *reqParams, void *ctx_p)
 {
     mpl_bag_t *employee;
     uint16_t number;
@@ -105,7 +103,7 @@ static mpl_list_t *handle_Add(mpl_bag_t *reqParams)
     return respMsg;
 }
 
-static mpl_list_t *handle_Get(mpl_bag_t *reqParams)
+static mpl_list_t *handle_Get(mpl_bag_t *reqParams, void *ctx_p)
 {
     uint16_t number;
     mpl_bag_t *employee = NULL;
@@ -128,7 +126,7 @@ static mpl_list_t *handle_Get(mpl_bag_t *reqParams)
     return respMsg;
 }
 
-static mpl_list_t *handle_Delete(mpl_bag_t *reqParams)
+static mpl_list_t *handle_Delete(mpl_bag_t *reqParams, void *ctx_p)
 {
     uint16_t number;
     mpl_list_t *respMsg = NULL;
@@ -147,7 +145,7 @@ static mpl_list_t *handle_Delete(mpl_bag_t *reqParams)
     return respMsg;
 }
 
-static mpl_list_t *handle_Find(mpl_bag_t *reqParams)
+static mpl_list_t *handle_Find(mpl_bag_t *reqParams, void *ctx_p)
 {
     char *first = NULL;
     char *middle = NULL;
@@ -19,9 +19,16 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <signal.h>
 #include "personnel.h"
 #include "pers_handlers.h"
-#include <assert.h>
+#include "pers_db.h"
+#include "mpl_server.h"
+#include "mpl_pthread.h"
+
+static mpl_mutex_t *db_mutex;
+static mpl_server_t *server;
 
 void usage() 
 {
@@ -29,16 +36,43 @@ void usage()
     printf("    -h Show command usage\n");
     printf("    -i input pipe\n");
     printf("    -o output pipe\n");
+    printf("    -u unix socket path\n");
+    printf("    -p tcp port (localhost)\n");
+}
+
+/* Called from the server worker threads */
+static mpl_list_t *handle_request(void *ctx_p, mpl_list_t *req, bool has_error)
+{
+    mpl_list_t *resp;
+
+    if (has_error || (req == NULL)) {
+        fprintf(stderr, "!!! INVALID REQUEST !!!\n");
+        return NULL;
+    }
+
+    /* The database is not thread safe */
+    mpl_mutex_lock(db_mutex);
+    resp = handle_persfile(req);
+    mpl_mutex_unlock(db_mutex);
+    if (resp == NULL)
+        fprintf(stderr, "!!! INVALID RESPONSE !!!\n");
+    return resp;
+}
+
+static void handle_signal(int sig)
+{
+    mpl_server_stop(server);
 }
 
 int main(int argc, char *argv[])
 {
-    char buf[1024];
     int opt;
     char *pi = NULL;
     char *po = NULL;
-    FILE *fi;
-    FILE *fo;
+    char *pu = NULL;
+    int port = -1;
+    int fi = -1;
+    int fo = -1;
     int i;
 
     if (argc < 2) {
@@ -50,7 +84,7 @@ int main(int argc, char *argv[])
     for (i = 0 ; i < argc; i++)
         printf(" %s", argv[i]);
     printf("\n");
-    while (-1 != (opt = getopt(argc, argv, "i:o:h"))) {
+    while (-1 != (opt = getopt(argc, argv, "i:o:u:p:h"))) {
         switch (opt) {
             case 'h':
                 usage();
@@ -61,80 +95,89 @@ int main(int argc, char *argv[])
             case 'o':
                 po = optarg;
                 break;
+            case 'u':
+                pu = optarg;
+                break;
+            case 'p':
+                port = atoi(optarg);
+                break;
             default:
                 printf("unsupported option received\n");
                 exit(-1);
         }
     }
 
-    if (!pi) {
+    if (!pi && !pu && (port < 0)) {
         fprintf(stderr, "Input pipe not specified\n");
         exit(-1);
     }
     
-    if (!po) {
+    if (pi && !po) {
         fprintf(stderr, "Output pipe not specified\n");
         exit(-1);
     }
 
-    if (!strcmp(pi, "-")) {
-        fi = stdin;
-    }
-    else {
-        fi = fopen(pi, "r");
-        if (!fi) {
-            fprintf(stderr, "Error opening file '%s' for reading\n", pi);
-            exit(-1);
+    if (pi) {
+        if (!strcmp(pi, "-")) {
+            fi = 0;
+        }
+        else {
+            fi = open(pi, O_RDONLY);
+            if (fi < 0) {
+                fprintf(stderr, "Error opening file '%s' for reading\n", pi);
+                exit(-1);
+            }
         }
-    }
 
-    if (!strcmp(po, "-")) {
-        fo = stdout;
-    }
-    else {
-        fo = fopen(po, "w");
-        if (!fo) {
-            fprintf(stderr, "Error opening file '%s' for writing\n", po);
-            exit(-1);
+        if (!strcmp(po, "-")) {
+            fo = 1;
+        }
+        else {
+            fo = open(po, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+            if (fo < 0) {
+                fprintf(stderr, "Error opening file '%s' for writing\n", po);
+                exit(-1);
+            }
         }
     }
 
     fprintf(stderr, "persfile server STARTS\n");
 
     personnel_param_init();
+    if (mpl_mutex_init(&db_mutex) < 0) {
+        fprintf(stderr, "Error creating mutex\n");
+        exit(-1);
+    }
 
-    while (fgets(buf, 1024, fi) != NULL) {
-        mpl_list_t *req;
-        mpl_list_t *resp;
-
-        req = mpl_param_list_unpack(buf);
-        if (req) {
-            resp = handle_persfile(req);
-            if (resp) {
-                if (mpl_param_list_pack(resp, buf, 1023) <= 0) {
-                    fprintf(stderr, "!!! FAILED PACKING MESSAGE !!!\n");
-                }
-                mpl_param_list_destroy(&resp);
-                if (fprintf(fo, "%s\n", buf) <= 0) {
-                    fprintf(stderr, "!!! FAILED SENDING MESSAGE !!!\n");
-                }
-                fflush(fo);
-            }
-            else {
-                fprintf(stderr, "!!! INVALID RESPONSE !!!\n");
-            }
-            mpl_param_list_destroy(&req);
+    server = mpl_server_create(NULL, handle_request, NULL);
+    if (server == NULL) {
+        fprintf(stderr, "Error creating server\n");
+        exit(-1);
+    }
+    signal(SIGPIPE, SIG_IGN);
+    signal(SIGINT, handle_signal);
+    signal(SIGTERM, handle_signal);
 
-        }
-        else {
-            fprintf(stderr, "!!! INVALID REQUEST !!!\n");
-        }
+    if ((fi >= 0) && (mpl_server_add_connection(server, fi, fo) < 0)) {
+        fprintf(stderr, "!!! FAILED ADDING CONNECTION !!!\n");
+    }
+    else if (pu && (mpl_server_listen_unix(server, pu) < 0)) {
+        fprintf(stderr, "Error listening on '%s'\n", pu);
+    }
+    else if ((port >= 0) &&
+             ((port = mpl_server_listen_tcp(server, port)) < 0)) {
+        fprintf(stderr, "Error listening on tcp port\n");
+    }
+    else {
+        if (port >= 0)
+            fprintf(stderr, "Listening on localhost port %d\n", port);
+        if (mpl_server_run(server) < 0)
+            fprintf(stderr, "!!! SERVER FAILED !!!\n");
     }
+    mpl_server_destroy(server);
+    persdb_close();
 
-    if (fi != stdin)
-        fclose(fi);
-    if ((fo != stdout) && (fo != stderr))
-        fclose(fo);
+    mpl_mutex_destroy(db_mutex);
     mpl_param_system_deinit();
     fprintf(stderr, "persfile server QUITS\n");
     return 0;
@@ -0,0 +1,252 @@
+/*
+ *   Copyright 2013 ST-Ericsson SA
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ */
+
+/*************************************************************************
+ *
+ * File name: mpl_arena.c
+ *
+ * Description: MPL arena (region) allocator implementation
+ *
+ **************************************************************************/
+/*****************************************************************************
+ *
+ * Include files
+ *
+ *****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "mpl_arena.h"
+
+/*****************************************************************************
+ *
+ * Defines & Type definitions
+ *
+ *****************************************************************************/
+
+/* Alignment of allocations, enough for any basic type */
+#define MPL_ARENA_ALIGN 16
+#define ALIGN_UP(size) (((size) + (MPL_ARENA_ALIGN - 1)) & ~((size_t)MPL_ARENA_ALIGN - 1))
+
+/*
+ * Each allocation is preceded by a header holding its size, so that
+ * mpl_arena_realloc() knows how much to copy.
+ */
+#define MPL_ARENA_HEADER_SIZE ALIGN_UP(sizeof(size_t))
+
+typedef struct mpl_arena_block_s
+{
+    struct mpl_arena_block_s *next_p;   /* Older (smaller) block */
+    size_t size;                        /* Usable bytes in data */
+    size_t used;
+    char *data_p;
+} mpl_arena_block_t;
+
+struct mpl_arena_s
+{
+    mpl_arena_block_t *blocks_p;        /* Current block first */
+    size_t block_size;                  /* Size of first block */
+    size_t allocated;
+};
+
+/*****************************************************************************
+ *
+ * Private function prototypes
+ *
+ *****************************************************************************/
+
+static mpl_arena_block_t *block_create(size_t size);
+
+/****************************************************************************
+ *
+ * Public Functions
+ *
+ ****************************************************************************/
+
+/**
+ * mpl_arena_create
+ */
+mpl_arena_t *mpl_arena_create(size_t block_size)
+{
+    mpl_arena_t *arena_p;
+
+    arena_p = calloc(1, sizeof(mpl_arena_t));
+    if (NULL == arena_p)
+        return NULL;
+
+    arena_p->block_size = (block_size > 0) ?
+        ALIGN_UP(block_size) : MPL_ARENA_DEFAULT_BLOCK_SIZE;
+    return arena_p;
+}
+
+/**
+ * mpl_arena_destroy
+ */
+void mpl_arena_destroy(mpl_arena_t *arena_p)
+{
+    mpl_arena_block_t *block_p;
+
+    if (NULL == arena_p)
+        return;
+
+    while (NULL != arena_p->blocks_p)
+    {
+        block_p = arena_p->blocks_p;
+        arena_p->blocks_p = block_p->next_p;
+        free(block_p);
+    }
+    free(arena_p);
+}
+
+/**
+ * mpl_arena_reset
+ */
+void mpl_arena_reset(mpl_arena_t *arena_p)
+{
+    mpl_arena_block_t *block_p;
+
+    assert(NULL != arena_p);
+
+    if (NULL == arena_p->blocks_p)
+        return;
+
+    /* The current block is the largest one */
+    while (NULL != arena_p->blocks_p->next_p)
+    {
+        block_p = arena_p->blocks_p->next_p;
+        arena_p->blocks_p->next_p = block_p->next_p;
+        free(block_p);
+    }
+    arena_p->blocks_p->used = 0;
+    arena_p->allocated = 0;
+}
+
+/**
+ * mpl_arena_alloc
+ */
+void *mpl_arena_alloc(mpl_arena_t *arena_p, size_t size)
+{
+    mpl_arena_block_t *block_p;
+    size_t needed;
+    char *p;
+
+    assert(NULL != arena_p);
+
+    if (size > ((size_t)-1 / 2))
+        return NULL;
+
+    needed = MPL_ARENA_HEADER_SIZE + ALIGN_UP(size);
+    block_p = arena_p->blocks_p;
+
+    if ((NULL == block_p) || ((block_p->size - block_p->used) < needed))
+    {
+        size_t block_size;
+
+        block_size = (NULL != block_p) ? (2 * block_p->size) : arena_p->block_size;
+        while (block_size < needed)
+            block_size *= 2;
+
+        block_p = block_create(block_size);
+        if (NULL == block_p)
+            return NULL;
+        block_p->next_p = arena_p->blocks_p;
+        arena_p->blocks_p = block_p;
+    }
+
+    p = block_p->data_p + block_p->used;
+    *((size_t*)p) = size;
+    block_p->used += needed;
+    arena_p->allocated += needed;
+
+    return p + MPL_ARENA_HEADER_SIZE;
+}
+
+/**
+ * mpl_arena_realloc
+ */
+void *mpl_arena_realloc(mpl_arena_t *arena_p, void *ptr, size_t size)
+{
+    void *new_p;
+    size_t old_size;
+
+    if (NULL == ptr)
+        return mpl_arena_alloc(arena_p, size);
+
+    old_size = *((size_t*)((char*)ptr - MPL_ARENA_HEADER_SIZE));
+    if (size <= old_size)
+    {
+        *((size_t*)((char*)ptr - MPL_ARENA_HEADER_SIZE)) = size;
+        return ptr;
+    }
+
+    new_p = mpl_arena_alloc(arena_p, size);
+    if (NULL == new_p)
+        return NULL;
+    memcpy(new_p, ptr, old_size);
+    return new_p;
+}
+
+/**
+ * mpl_arena_contains
+ */
+bool mpl_arena_contains(const mpl_arena_t *arena_p, const void *ptr)
+{
+    const mpl_arena_block_t *block_p;
+    const char *p = ptr;
+
+    if ((NULL == arena_p) || (NULL == ptr))
+        return false;
+
+    /* Block sizes double, so there are few blocks to check */
+    for (block_p = arena_p->blocks_p; NULL != block_p; block_p = block_p->next_p)
+    {
+        if ((p >= block_p->data_p) && (p < (block_p->data_p + block_p->used)))
+            return true;
+    }
+    return false;
+}
+
+/**
+ * mpl_arena_size
+ */
+size_t mpl_arena_size(const mpl_arena_t *arena_p)
+{
+    assert(NULL != arena_p);
+    return arena_p->allocated;
+}
+
+/****************************************************************************
+ *
+ * Private Functions
+ *
+ ****************************************************************************/
+
+static mpl_arena_block_t *block_create(size_t size)
+{
+    mpl_arena_block_t *block_p;
+
+    block_p = malloc(ALIGN_UP(sizeof(mpl_arena_block_t)) + size);
+    if (NULL == block_p)
+        return NULL;
+
+    block_p->next_p = NULL;
+    block_p->size = size;
+    block_p->used = 0;
+    block_p->data_p = (char*)block_p + ALIGN_UP(sizeof(mpl_arena_block_t));
+    return block_p;
+}
@@ -0,0 +1,158 @@
+/*
+ *   Copyright 2013 ST-Ericsson SA
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ */
+
+
+/*************************************************************************
+ *
+ * File name: mpl_arena.h
+ *
+ * Description: MPL arena (region) allocator API declarations
+ *
+ **************************************************************************/
+#ifndef _MPL_ARENA_H
+#define _MPL_ARENA_H
+
+/**************************************************************************
+ * Includes
+ *************************************************************************/
+#include <stddef.h>
+#include "mpl_stdbool.h"
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file mpl_arena.h
+ * @brief MPL arena allocator
+ */
+
+/** @defgroup MPL_ARENA MPL arena API
+ *  @ingroup MPL
+ * An arena hands out memory from a few large blocks, and all of it is
+ * given back at once with mpl_arena_reset() or mpl_arena_destroy().
+ * There is no way to free a single allocation.
+ *
+ * Parameter lists can be built in an arena by setting it as the arena
+ * of the calling thread, see mpl_param_arena_set(). A server that
+ * unpacks and packs one message at a time can then reset the arena per
+ * message, instead of destroying the lists element by element.
+ *
+ * An arena is not thread safe, it should only be used by one thread at
+ * a time.
+ */
+
+/**
+ * @ingroup MPL_ARENA
+ * Default size of the first block of an arena
+ */
+#define MPL_ARENA_DEFAULT_BLOCK_SIZE 4096
+
+typedef struct mpl_arena_s mpl_arena_t;
+
+/**
+ * @ingroup MPL_ARENA
+ * mpl_arena_create
+ *
+ * Create an arena. Blocks are allocated as needed, each new block twice
+ * the size of the previous one.
+ *
+ * @param block_size  Size of first block, 0 means
+ *                    MPL_ARENA_DEFAULT_BLOCK_SIZE
+ *
+ * @return The arena, or NULL on failure
+ */
+mpl_arena_t *mpl_arena_create(size_t block_size);
+
+/**
+ * @ingroup MPL_ARENA
+ * mpl_arena_destroy
+ *
+ * Free the arena and everything allocated from it.
+ *
+ * @param arena_p  The arena (may be NULL)
+ */
+void mpl_arena_destroy(mpl_arena_t *arena_p);
+
+/**
+ * @ingroup MPL_ARENA
+ * mpl_arena_reset
+ *
+ * Free everything allocated from the arena. The largest block is kept
+ * for reuse, so an arena that is reset per message soon stops
+ * allocating from the heap.
+ *
+ * @param arena_p  The arena
+ */
+void mpl_arena_reset(mpl_arena_t *arena_p);
+
+/**
+ * @ingroup MPL_ARENA
+ * mpl_arena_alloc
+ *
+ * Allocate memory from the arena, aligned for any basic type.
+ *
+ * @param arena_p  The arena
+ * @param size     Number of bytes
+ *
+ * @return Pointer to the memory, or NULL on failure
+ */
+void *mpl_arena_alloc(mpl_arena_t *arena_p, size_t size);
+
+/**
+ * @ingroup MPL_ARENA
+ * mpl_arena_realloc
+ *
+ * Resize memory allocated from the arena. The old memory is not
+ * reused.
+ *
+ * @param arena_p  The arena
+ * @param ptr      Memory from mpl_arena_alloc(), or NULL
+ * @param size     New number of bytes
+ *
+ * @return Pointer to the memory, or NULL on failure
+ */
+void *mpl_arena_realloc(mpl_arena_t *arena_p, void *ptr, size_t size);
+
+/**
+ * @ingroup MPL_ARENA
+ * mpl_arena_contains
+ *
+ * @param arena_p  The arena
+ * @param ptr      Pointer to check
+ *
+ * @return true if ptr was allocated from the arena (since the last
+ *         reset)
+ */
+bool mpl_arena_contains(const mpl_arena_t *arena_p, const void *ptr);
+
+/**
+ * @ingroup MPL_ARENA
+ * mpl_arena_size
+ *
+ * @param arena_p  The arena
+ *
+ * @return Number of bytes allocated from the arena since it was created
+ *         or last reset, including alignment
+ */
+size_t mpl_arena_size(const mpl_arena_t *arena_p);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* _MPL_ARENA_H */
@@ -0,0 +1,849 @@
+/*
+ *   Copyright 2013 ST-Ericsson SA
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ */
+
+/*************************************************************************
+ *
+ * File name: mpl_client.c
+ *
+ * Description: MPL asynchronous client implementation
+ *
+ **************************************************************************/
+/*****************************************************************************
+ *
+ * Include files
+ *
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include "mpl_stdint.h"
+#include "mpl_client.h"
+#include "mpl_dbgtrace.h"
+
+#if defined(__unix__)
+
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+
+/*****************************************************************************
+ *
+ * Defines & Type definitions
+ *
+ *****************************************************************************/
+
+#define MPL_CLIENT_READ_SIZE 65536
+#define MPL_CLIENT_INITIAL_OUT_SIZE 4096
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+/* A request waiting for its response */
+typedef struct mpl_client_pending_s
+{
+    struct mpl_client_pending_s *next_p;
+    uint32_t request_id;
+    mpl_param_element_id_t response_id; /* Expected, or
+                                           MPL_PARAM_ID_UNDEFINED */
+    mpl_client_response_fp func;
+    void *ctx_p;
+} mpl_client_pending_t;
+
+struct mpl_client_s
+{
+    mpl_client_options_t options;
+    const mpl_client_protocol_t *protocol_p;
+    int out_fd;
+    int in_fd;
+    int out_flags;                      /* File status flags to restore */
+    int in_flags;
+    bool out_is_socket;
+    mpl_client_event_fp event_func;
+    void *event_ctx_p;
+    mpl_unpack_stream_t *stream_p;
+    char *read_buf_p;
+    /* Packed requests not yet written */
+    char *out_p;
+    size_t out_len;
+    size_t out_size;
+    size_t out_offset;                  /* Written of out_p */
+    uint64_t queued_usec;               /* When the oldest was queued */
+    bool out_blocked;                   /* Waiting for POLLOUT */
+    /* Unanswered requests, oldest first */
+    mpl_client_pending_t *first_p;
+    mpl_client_pending_t *last_p;
+    mpl_client_pending_t *free_p;       /* Reused pending entries */
+    int in_flight;
+    uint32_t next_request_id;
+    int callbacks;                      /* Made by the current call */
+    int in_callback;
+    bool closed;
+};
+
+/*****************************************************************************
+ *
+ * Private function prototypes
+ *
+ *****************************************************************************/
+
+static uint64_t client_now_usec(void);
+static int client_out_write(void *ctx_p, const char *data_p, size_t len);
+static int client_write(mpl_client_t *client_p);
+static bool client_due(mpl_client_t *client_p, uint64_t now_usec);
+static int client_io(mpl_client_t *client_p, int timeout_ms, bool force);
+static int client_read(mpl_client_t *client_p);
+static int client_message(void *ctx_p, mpl_list_t *msg_p, bool has_error);
+static void client_complete(mpl_client_t *client_p, mpl_list_t *resp_p);
+static void client_close(mpl_client_t *client_p);
+static bool client_answered(mpl_client_t *client_p, uint32_t request_id);
+
+/****************************************************************************
+ *
+ * Public Functions
+ *
+ ****************************************************************************/
+
+/**
+ * mpl_client_create
+ */
+mpl_client_t *mpl_client_create(const mpl_client_options_t *options_p,
+                                const mpl_client_protocol_t *protocol_p,
+                                int out_fd,
+                                int in_fd,
+                                mpl_client_event_fp event_func,
+                                void *ctx_p)
+{
+    mpl_client_t *client_p;
+    struct stat st;
+
+    if ((out_fd < 0) || (in_fd < 0))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER, ("Missing parameter\n"));
+        mpl_set_errno(E_MPL_INVALID_PARAMETER);
+        return NULL;
+    }
+
+    client_p = calloc(1, sizeof(mpl_client_t));
+    if (NULL == client_p)
+        goto error_return;
+
+    if (NULL != options_p)
+        client_p->options = *options_p;
+    if (0 == client_p->options.flush_bytes)
+        client_p->options.flush_bytes = MPL_CLIENT_DEFAULT_FLUSH_BYTES;
+    if (0 == client_p->options.flush_usec)
+        client_p->options.flush_usec = MPL_CLIENT_DEFAULT_FLUSH_USEC;
+    if (client_p->options.max_in_flight <= 0)
+        client_p->options.max_in_flight = MPL_CLIENT_DEFAULT_MAX_IN_FLIGHT;
+    client_p->protocol_p = protocol_p;
+    client_p->out_fd = out_fd;
+    client_p->in_fd = in_fd;
+    client_p->event_func = event_func;
+    client_p->event_ctx_p = ctx_p;
+    client_p->next_request_id = 1;
+
+    client_p->read_buf_p = malloc(MPL_CLIENT_READ_SIZE);
+    if (NULL == client_p->read_buf_p)
+        goto error_return;
+    client_p->stream_p = mpl_unpack_stream_create(NULL,
+                                                  '\n',
+                                                  NULL,
+                                                  client_message,
+                                                  client_p);
+    if (NULL == client_p->stream_p)
+    {
+        free(client_p->read_buf_p);
+        free(client_p);
+        return NULL;
+    }
+
+    client_p->out_flags = fcntl(out_fd, F_GETFL);
+    client_p->in_flags = fcntl(in_fd, F_GETFL);
+    if ((client_p->out_flags < 0) || (client_p->in_flags < 0) ||
+        (fcntl(out_fd, F_SETFL, client_p->out_flags | O_NONBLOCK) < 0) ||
+        (fcntl(in_fd, F_SETFL, client_p->in_flags | O_NONBLOCK) < 0))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Bad file descriptor: %s\n", strerror(errno)));
+        mpl_set_errno(E_MPL_FAILED_OPERATION);
+        mpl_client_destroy(client_p);
+        return NULL;
+    }
+    client_p->out_is_socket = (fstat(out_fd, &st) == 0) && S_ISSOCK(st.st_mode);
+
+    return client_p;
+
+ error_return:
+    MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY, ("No memory\n"));
+    mpl_set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+    if (NULL != client_p)
+        free(client_p->read_buf_p);
+    free(client_p);
+    return NULL;
+}
+
+/**
+ * mpl_client_destroy
+ */
+void mpl_client_destroy(mpl_client_t *client_p)
+{
+    mpl_client_pending_t *pending_p;
+
+    if (NULL == client_p)
+        return;
+
+    if (client_p->out_flags >= 0)
+        (void) fcntl(client_p->out_fd, F_SETFL, client_p->out_flags);
+    if (client_p->in_flags >= 0)
+        (void) fcntl(client_p->in_fd, F_SETFL, client_p->in_flags);
+
+    while (NULL != client_p->first_p)
+    {
+        pending_p = client_p->first_p;
+        client_p->first_p = pending_p->next_p;
+        free(pending_p);
+    }
+    while (NULL != client_p->free_p)
+    {
+        pending_p = client_p->free_p;
+        client_p->free_p = pending_p->next_p;
+        free(pending_p);
+    }
+    mpl_unpack_stream_destroy(client_p->stream_p);
+    free(client_p->read_buf_p);
+    free(client_p->out_p);
+    free(client_p);
+}
+
+/**
+ * mpl_client_send
+ */
+int mpl_client_send(mpl_client_t *client_p,
+                    mpl_list_t *req_p,
+                    mpl_client_response_fp func,
+                    void *ctx_p,
+                    uint32_t *request_id_p)
+{
+    mpl_client_pending_t *pending_p;
+    size_t queued;
+
+    if ((NULL == client_p) || (NULL == req_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER, ("Missing parameter\n"));
+        mpl_set_errno(E_MPL_INVALID_PARAMETER);
+        return -1;
+    }
+
+    /* The unpack stream can not be fed from its own callback */
+    while ((client_p->in_flight >= client_p->options.max_in_flight) &&
+           (0 == client_p->in_callback))
+    {
+        if (client_io(client_p, -1, true) < 0)
+            return -1;
+    }
+    if (client_p->closed)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION, ("Connection closed\n"));
+        mpl_set_errno(E_MPL_FAILED_OPERATION);
+        return -1;
+    }
+
+    if (NULL != client_p->free_p)
+    {
+        pending_p = client_p->free_p;
+        client_p->free_p = pending_p->next_p;
+    }
+    else
+    {
+        pending_p = malloc(sizeof(mpl_client_pending_t));
+        if (NULL == pending_p)
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY, ("No memory\n"));
+            mpl_set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+            return -1;
+        }
+    }
+
+    /* Packed once, straight into the queue (which may be compacted) */
+    queued = client_p->out_len - client_p->out_offset;
+    if ((mpl_param_list_pack_stream(req_p,
+                                    client_out_write,
+                                    client_p,
+                                    NULL) < 0) ||
+        (client_out_write(client_p, "\n", 1) < 0))
+    {
+        client_p->out_len = client_p->out_offset + queued;
+        pending_p->next_p = client_p->free_p;
+        client_p->free_p = pending_p;
+        return -1;
+    }
+    if (0 == queued)
+        client_p->queued_usec = client_now_usec();
+
+    pending_p->next_p = NULL;
+    pending_p->request_id = client_p->next_request_id++;
+    if (0 == client_p->next_request_id)
+        client_p->next_request_id = 1;
+    pending_p->response_id = MPL_PARAM_ID_UNDEFINED;
+    if (NULL != client_p->protocol_p)
+        pending_p->response_id = client_p->protocol_p->command_response_id(req_p);
+    pending_p->func = func;
+    pending_p->ctx_p = ctx_p;
+    if (NULL == client_p->last_p)
+        client_p->first_p = pending_p;
+    else
+        client_p->last_p->next_p = pending_p;
+    client_p->last_p = pending_p;
+    client_p->in_flight++;
+    if (NULL != request_id_p)
+        *request_id_p = pending_p->request_id;
+
+    if (!client_p->out_blocked && client_due(client_p, client_now_usec()) &&
+        (client_write(client_p) < 0))
+        return -1;
+    return 0;
+}
+
+/**
+ * mpl_client_flush
+ */
+int mpl_client_flush(mpl_client_t *client_p)
+{
+    if (NULL == client_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER, ("Missing parameter\n"));
+        mpl_set_errno(E_MPL_INVALID_PARAMETER);
+        return -1;
+    }
+
+    if (!client_p->out_blocked && (client_write(client_p) < 0))
+        return -1;
+    /* Responses are read meanwhile, or the server could block on them */
+    while (client_p->out_offset < client_p->out_len)
+    {
+        if (client_io(client_p, -1, true) < 0)
+            return -1;
+    }
+    return 0;
+}
+
+/**
+ * mpl_client_poll
+ */
+int mpl_client_poll(mpl_client_t *client_p, int timeout_ms)
+{
+    if (NULL == client_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER, ("Missing parameter\n"));
+        mpl_set_errno(E_MPL_INVALID_PARAMETER);
+        return -1;
+    }
+
+    client_p->callbacks = 0;
+    if (client_io(client_p, timeout_ms, false) < 0)
+        return -1;
+    return client_p->callbacks;
+}
+
+/**
+ * mpl_client_wait
+ */
+int mpl_client_wait(mpl_client_t *client_p,
+                    uint32_t request_id,
+                    int timeout_ms)
+{
+    uint64_t deadline_usec = 0;
+    uint64_t now_usec;
+    int wait_ms = -1;
+
+    if (NULL == client_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER, ("Missing parameter\n"));
+        mpl_set_errno(E_MPL_INVALID_PARAMETER);
+        return -1;
+    }
+
+    if (timeout_ms >= 0)
+        deadline_usec = client_now_usec() + (uint64_t) timeout_ms * 1000;
+
+    while (!client_answered(client_p, request_id))
+    {
+        if (timeout_ms >= 0)
+        {
+            now_usec = client_now_usec();
+            if (now_usec >= deadline_usec)
+            {
+                MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION, ("Timeout\n"));
+                mpl_set_errno(E_MPL_FAILED_OPERATION);
+                return -1;
+            }
+            wait_ms = (int) ((deadline_usec - now_usec + 999) / 1000);
+        }
+        if (client_io(client_p, wait_ms, true) < 0)
+            return client_answered(client_p, request_id) ? 0 : -1;
+    }
+    return 0;
+}
+
+/**
+ * mpl_client_in_flight
+ */
+int mpl_client_in_flight(mpl_client_t *client_p)
+{
+    if (NULL == client_p)
+        return 0;
+    return client_p->in_flight;
+}
+
+/****************************************************************************
+ *
+ * Private Functions
+ *
+ ****************************************************************************/
+
+/**
+ * client_now_usec
+ */
+static uint64_t client_now_usec(void)
+{
+    struct timespec ts;
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000 + (uint64_t) ts.tv_nsec / 1000;
+}
+
+/**
+ * client_out_write
+ *
+ * Pack writer that appends to the queue
+ */
+static int client_out_write(void *ctx_p, const char *data_p, size_t len)
+{
+    mpl_client_t *client_p = ctx_p;
+    size_t size;
+    char *p;
+
+    if ((client_p->out_len + len) > client_p->out_size)
+    {
+        /* Written data at the front is dropped before growing */
+        if (client_p->out_offset > 0)
+        {
+            memmove(client_p->out_p,
+                    client_p->out_p + client_p->out_offset,
+                    client_p->out_len - client_p->out_offset);
+            client_p->out_len -= client_p->out_offset;
+            client_p->out_offset = 0;
+        }
+    }
+    if ((client_p->out_len + len) > client_p->out_size)
+    {
+        size = client_p->out_size ? client_p->out_size :
+            MPL_CLIENT_INITIAL_OUT_SIZE;
+        while (size < (client_p->out_len + len))
+            size *= 2;
+        p = realloc(client_p->out_p, size);
+        if (NULL == p)
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY, ("No memory\n"));
+            mpl_set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+            return -1;
+        }
+        client_p->out_p = p;
+        client_p->out_size = size;
+    }
+    memcpy(client_p->out_p + client_p->out_len, data_p, len);
+    client_p->out_len += len;
+    return 0;
+}
+
+/**
+ * client_due
+ *
+ * True if the queue should be written now
+ */
+static bool client_due(mpl_client_t *client_p, uint64_t now_usec)
+{
+    size_t queued = client_p->out_len - client_p->out_offset;
+
+    if (0 == queued)
+        return false;
+    return (queued >= client_p->options.flush_bytes) ||
+        (client_p->options.flush_usec < 0) ||
+        ((now_usec - client_p->queued_usec) >=
+         (uint64_t) client_p->options.flush_usec);
+}
+
+/**
+ * client_write
+ *
+ * Write as much of the queue as the descriptor takes, all requests in
+ * one system call when it takes them
+ */
+static int client_write(mpl_client_t *client_p)
+{
+    ssize_t n;
+
+    while (client_p->out_offset < client_p->out_len)
+    {
+        if (client_p->out_is_socket)
+            n = send(client_p->out_fd,
+                     client_p->out_p + client_p->out_offset,
+                     client_p->out_len - client_p->out_offset,
+                     MSG_NOSIGNAL);
+        else
+            n = write(client_p->out_fd,
+                      client_p->out_p + client_p->out_offset,
+                      client_p->out_len - client_p->out_offset);
+        if (n < 0)
+        {
+            if (EINTR == errno)
+                continue;
+            if ((EAGAIN == errno) || (EWOULDBLOCK == errno))
+            {
+                client_p->out_blocked = true;
+                return 0;
+            }
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("Write failed: %s\n", strerror(errno)));
+            mpl_set_errno(E_MPL_FAILED_OPERATION);
+            client_close(client_p);
+            return -1;
+        }
+        client_p->out_offset += n;
+    }
+    client_p->out_offset = 0;
+    client_p->out_len = 0;
+    client_p->out_blocked = false;
+    return 0;
+}
+
+/**
+ * client_io
+ *
+ * Wait for the descriptors (and the time the queue is due), then write
+ * and read what they take. force writes the queue regardless of the
+ * thresholds.
+ */
+static int client_io(mpl_client_t *client_p, int timeout_ms, bool force)
+{
+    struct pollfd fds[2];
+    nfds_t num_fds = 0;
+    int in_index = -1;
+    int out_index = -1;
+    uint64_t now_usec;
+    uint64_t due_usec;
+    int due_ms;
+    int ret;
+
+    if (client_p->closed)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION, ("Connection closed\n"));
+        mpl_set_errno(E_MPL_FAILED_OPERATION);
+        return -1;
+    }
+
+    now_usec = client_now_usec();
+    if (!client_p->out_blocked &&
+        (force || client_due(client_p, now_usec)) &&
+        (client_write(client_p) < 0))
+        return -1;
+
+    /* A queue that is not due yet shortens the wait */
+    if ((client_p->out_offset < client_p->out_len) && !client_p->out_blocked &&
+        (client_p->options.flush_usec > 0))
+    {
+        due_usec = client_p->queued_usec + client_p->options.flush_usec;
+        due_ms = (due_usec > now_usec) ?
+            (int) ((due_usec - now_usec + 999) / 1000) : 0;
+        if ((timeout_ms < 0) || (due_ms < timeout_ms))
+            timeout_ms = due_ms;
+    }
+
+    in_index = num_fds++;
+    fds[in_index].fd = client_p->in_fd;
+    fds[in_index].events = POLLIN;
+    fds[in_index].revents = 0;
+    if (client_p->out_blocked)
+    {
+        if (client_p->out_fd == client_p->in_fd)
+        {
+            fds[in_index].events |= POLLOUT;
+            out_index = in_index;
+        }
+        else
+        {
+            out_index = num_fds++;
+            fds[out_index].fd = client_p->out_fd;
+            fds[out_index].events = POLLOUT;
+            fds[out_index].revents = 0;
+        }
+    }
+
+    ret = poll(fds, num_fds, timeout_ms);
+    if (ret < 0)
+    {
+        if (EINTR == errno)
+            return 0;
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("poll failed: %s\n", strerror(errno)));
+        mpl_set_errno(E_MPL_FAILED_OPERATION);
+        return -1;
+    }
+
+    if ((out_index >= 0) &&
+        (fds[out_index].revents & (POLLOUT | POLLERR | POLLHUP)))
+    {
+        client_p->out_blocked = false;
+        if (client_write(client_p) < 0)
+            return -1;
+    }
+    if (fds[in_index].revents & (POLLIN | POLLERR | POLLHUP))
+        return client_read(client_p);
+    return 0;
+}
+
+/**
+ * client_read
+ *
+ * Read and handle what has arrived
+ */
+static int client_read(mpl_client_t *client_p)
+{
+    ssize_t n;
+
+    for (;;)
+    {
+        n = read(client_p->in_fd, client_p->read_buf_p, MPL_CLIENT_READ_SIZE);
+        if (n < 0)
+        {
+            if (EINTR == errno)
+                continue;
+            if ((EAGAIN == errno) || (EWOULDBLOCK == errno))
+                return 0;
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("Read failed: %s\n", strerror(errno)));
+            mpl_set_errno(E_MPL_FAILED_OPERATION);
+            client_close(client_p);
+            return -1;
+        }
+        if (0 == n)
+        {
+            (void) mpl_unpack_stream_finish(client_p->stream_p);
+            client_close(client_p);
+            return -1;
+        }
+        if (mpl_unpack_stream_feed(client_p->stream_p,
+                                   client_p->read_buf_p,
+                                   n) < 0)
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("Bad input from server\n"));
+        }
+        if (n < MPL_CLIENT_READ_SIZE)
+            return 0;
+    }
+}
+
+/**
+ * client_message
+ *
+ * Unpack stream callback, a message from the server
+ */
+static int client_message(void *ctx_p, mpl_list_t *msg_p, bool has_error)
+{
+    mpl_client_t *client_p = ctx_p;
+    const mpl_client_protocol_t *protocol_p = client_p->protocol_p;
+    mpl_client_pending_t *pending_p;
+    mpl_param_element_id_t response_id;
+
+    if (has_error)
+    {
+        /* Most likely the response of the oldest request */
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Message from server failed to unpack\n"));
+        mpl_param_list_destroy(&msg_p);
+        if (NULL != client_p->first_p)
+            client_complete(client_p, NULL);
+        return 0;
+    }
+    if (NULL == msg_p)
+        return 0;
+
+    if ((NULL != protocol_p) && protocol_p->is_event(msg_p))
+    {
+        client_p->callbacks++;
+        if (NULL != client_p->event_func)
+        {
+            client_p->in_callback++;
+            client_p->event_func(client_p->event_ctx_p, msg_p);
+            client_p->in_callback--;
+        }
+        else
+            mpl_param_list_destroy(&msg_p);
+        return 0;
+    }
+
+    if (NULL == client_p->first_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Response without a request\n"));
+        mpl_param_list_destroy(&msg_p);
+        return 0;
+    }
+
+    if (NULL != protocol_p)
+    {
+        /* Requests before the one this answers were not answered */
+        response_id = protocol_p->response_id(msg_p);
+        for (pending_p = client_p->first_p;
+             NULL != pending_p;
+             pending_p = pending_p->next_p)
+        {
+            if ((pending_p->response_id == response_id) ||
+                (MPL_PARAM_ID_UNDEFINED == pending_p->response_id))
+                break;
+        }
+        if (NULL != pending_p)
+        {
+            while (client_p->first_p != pending_p)
+                client_complete(client_p, NULL);
+        }
+    }
+    client_complete(client_p, msg_p);
+    return 0;
+}
+
+/**
+ * client_complete
+ *
+ * Hand a response to the oldest request
+ */
+static void client_complete(mpl_client_t *client_p, mpl_list_t *resp_p)
+{
+    mpl_client_pending_t *pending_p = client_p->first_p;
+
+    client_p->first_p = pending_p->next_p;
+    if (NULL == client_p->first_p)
+        client_p->last_p = NULL;
+    client_p->in_flight--;
+    client_p->callbacks++;
+
+    if (NULL != pending_p->func)
+    {
+        client_p->in_callback++;
+        pending_p->func(pending_p->ctx_p, pending_p->request_id, resp_p);
+        client_p->in_callback--;
+    }
+    else
+        mpl_param_list_destroy(&resp_p);
+
+    pending_p->next_p = client_p->free_p;
+    client_p->free_p = pending_p;
+}
+
+/**
+ * client_close
+ *
+ * The connection is gone, no request will be answered
+ */
+static void client_close(mpl_client_t *client_p)
+{
+    client_p->closed = true;
+    client_p->out_offset = 0;
+    client_p->out_len = 0;
+    while (NULL != client_p->first_p)
+        client_complete(client_p, NULL);
+}
+
+/**
+ * client_answered
+ *
+ * True if a request is not waiting for its response
+ */
+static bool client_answered(mpl_client_t *client_p, uint32_t request_id)
+{
+    mpl_client_pending_t *pending_p;
+
+    for (pending_p = client_p->first_p;
+         NULL != pending_p;
+         pending_p = pending_p->next_p)
+    {
+        if (pending_p->request_id == request_id)
+            return false;
+    }
+    return true;
+}
+
+#else /* defined(__unix__) */
+
+/* poll() is needed, everything fails elsewhere */
+
+mpl_client_t *mpl_client_create(const mpl_client_options_t *options_p,
+                                const mpl_client_protocol_t *protocol_p,
+                                int out_fd,
+                                int in_fd,
+                                mpl_client_event_fp event_func,
+                                void *ctx_p)
+{
+    MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION, ("Not supported\n"));
+    mpl_set_errno(E_MPL_FAILED_OPERATION);
+    return NULL;
+}
+
+void mpl_client_destroy(mpl_client_t *client_p)
+{
+}
+
+int mpl_client_send(mpl_client_t *client_p,
+                    mpl_list_t *req_p,
+                    mpl_client_response_fp func,
+                    void *ctx_p,
+                    uint32_t *request_id_p)
+{
+    return -1;
+}
+
+int mpl_client_flush(mpl_client_t *client_p)
+{
+    return -1;
+}
+
+int mpl_client_poll(mpl_client_t *client_p, int timeout_ms)
+{
+    return -1;
+}
+
+int mpl_client_wait(mpl_client_t *client_p,
+                    uint32_t request_id,
+                    int timeout_ms)
+{
+    return -1;
+}
+
+int mpl_client_in_flight(mpl_client_t *client_p)
+{
+    return 0;
+}
+
+#endif /* defined(__unix__) */
@@ -0,0 +1,262 @@
+/*
+ *   Copyright 2013 ST-Ericsson SA
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ */
+
+
+/*************************************************************************
+ *
+ * File name: mpl_client.h
+ *
+ * Description: MPL asynchronous client API declarations
+ *
+ **************************************************************************/
+#ifndef _MPL_CLIENT_H
+#define _MPL_CLIENT_H
+
+/**************************************************************************
+ * Includes
+ *************************************************************************/
+#include "mpl_param.h"
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file mpl_client.h
+ * @brief MPL asynchronous client
+ */
+
+/** @defgroup MPL_CLIENT MPL asynchronous client
+ *  @ingroup MPL
+ * A client sends packed request messages (one per line) on a connection
+ * and calls a callback for each response, without waiting for a
+ * response before sending the next request (pipelining).
+ *
+ * Each request is given a request id. The server answers the requests
+ * of a connection in order (as mpl_server does), so a response belongs
+ * to the oldest request that is not answered. With a protocol
+ * descriptor (generated as <category>_client_protocol) events are told
+ * apart from responses, and the response id is checked against the
+ * command: a request that the server did not answer is then completed
+ * with a NULL response when the response of a later request arrives.
+ *
+ * For each category the compiler also generates a typed client API on
+ * top of mpl_client_send(): <category>_client_send_<command>() sends a
+ * command from its parameter bag, and the response parameters are
+ * handed to the command's slot in a <category>_client_handlers_t.
+ *
+ * Sent requests are queued and written together, when flush_bytes are
+ * queued, when the oldest has waited flush_usec, or when the client
+ * waits for a response. The client does nothing on its own: the queue
+ * is only written and the responses only read inside the client
+ * functions, so mpl_client_poll() must be called regularly.
+ *
+ * A client is used by one thread at a time. The connection descriptors
+ * are made non-blocking while the client exists.
+ */
+
+/**
+ * @ingroup MPL_CLIENT
+ * Client options
+ */
+typedef struct
+{
+    size_t flush_bytes; /**< Queued bytes that are written at once, 0
+                             means MPL_CLIENT_DEFAULT_FLUSH_BYTES */
+    int flush_usec;     /**< Longest time a request waits in the queue,
+                             0 means MPL_CLIENT_DEFAULT_FLUSH_USEC and
+                             negative means no waiting */
+    int max_in_flight;  /**< Requests that may be waiting for a response
+                             before mpl_client_send() waits, 0 means
+                             MPL_CLIENT_DEFAULT_MAX_IN_FLIGHT */
+} mpl_client_options_t;
+
+/**
+ * @ingroup MPL_CLIENT
+ * Default value for flush_bytes
+ */
+#define MPL_CLIENT_DEFAULT_FLUSH_BYTES 16384
+
+/**
+ * @ingroup MPL_CLIENT
+ * Default value for flush_usec
+ */
+#define MPL_CLIENT_DEFAULT_FLUSH_USEC 1000
+
+/**
+ * @ingroup MPL_CLIENT
+ * Default value for max_in_flight
+ */
+#define MPL_CLIENT_DEFAULT_MAX_IN_FLIGHT 1024
+
+/**
+ * @ingroup MPL_CLIENT
+ * Message classification of a protocol (category)
+ */
+typedef struct
+{
+    /** True if the message is an event */
+    bool (*is_event)(mpl_list_t *msg_p);
+    /** Id of the response to a command message, or MPL_PARAM_ID_UNDEFINED */
+    mpl_param_element_id_t (*command_response_id)(mpl_list_t *req_p);
+    /** Id of a response message, or MPL_PARAM_ID_UNDEFINED */
+    mpl_param_element_id_t (*response_id)(mpl_list_t *resp_p);
+} mpl_client_protocol_t;
+
+typedef struct mpl_client_s mpl_client_t;
+
+/**
+ * @ingroup MPL_CLIENT
+ * mpl_client_response_fp
+ *
+ * Called with the response to a request. resp_p is handed over to the
+ * callback, it is NULL if the request was not answered (the server
+ * answered a later request, the response could not be unpacked, or the
+ * connection was closed).
+ */
+typedef void (*mpl_client_response_fp)(void *ctx_p,
+                                       uint32_t request_id,
+                                       mpl_list_t *resp_p);
+
+/**
+ * @ingroup MPL_CLIENT
+ * mpl_client_event_fp
+ *
+ * Called with an event message, which is handed over to the callback.
+ */
+typedef void (*mpl_client_event_fp)(void *ctx_p, mpl_list_t *evt_p);
+
+/**
+ * @ingroup MPL_CLIENT
+ * mpl_client_create
+ *
+ * Create a client on a connection: one file descriptor to write
+ * requests to and one to read responses from (the same for a socket).
+ *
+ * @param options_p   Options (NULL means all defaults)
+ * @param protocol_p  Message classification (NULL means that every
+ *                    message is a response to the oldest request)
+ * @param out_fd      Descriptor to write requests to
+ * @param in_fd       Descriptor to read responses from
+ * @param event_func  Event callback (NULL discards events)
+ * @param ctx_p       Passed to the event callback
+ *
+ * @return The client, or NULL on failure
+ */
+mpl_client_t *mpl_client_create(const mpl_client_options_t *options_p,
+                                const mpl_client_protocol_t *protocol_p,
+                                int out_fd,
+                                int in_fd,
+                                mpl_client_event_fp event_func,
+                                void *ctx_p);
+
+/**
+ * @ingroup MPL_CLIENT
+ * mpl_client_destroy
+ *
+ * Free the client. Queued requests are not written, and the callbacks
+ * of unanswered requests are not called. The descriptors are not
+ * closed.
+ *
+ * @param client_p  The client (may be NULL)
+ */
+void mpl_client_destroy(mpl_client_t *client_p);
+
+/**
+ * @ingroup MPL_CLIENT
+ * mpl_client_send
+ *
+ * Pack a request message and queue it. Waits (handling responses)
+ * while max_in_flight requests are unanswered, except when called from
+ * a callback.
+ *
+ * @param client_p      The client
+ * @param req_p         Request message (not changed)
+ * @param func          Response callback (NULL discards the response)
+ * @param ctx_p         Passed to the response callback
+ * @param request_id_p  Returns the request id (may be NULL)
+ *
+ * @return 0 on success, -1 on error
+ */
+int mpl_client_send(mpl_client_t *client_p,
+                    mpl_list_t *req_p,
+                    mpl_client_response_fp func,
+                    void *ctx_p,
+                    uint32_t *request_id_p);
+
+/**
+ * @ingroup MPL_CLIENT
+ * mpl_client_flush
+ *
+ * Write all queued requests, handling responses while waiting.
+ *
+ * @param client_p  The client
+ *
+ * @return 0 on success, -1 on error
+ */
+int mpl_client_flush(mpl_client_t *client_p);
+
+/**
+ * @ingroup MPL_CLIENT
+ * mpl_client_poll
+ *
+ * Write queued requests that are due and handle the responses and
+ * events that have arrived, waiting up to timeout_ms for something to
+ * happen.
+ *
+ * @param client_p    The client
+ * @param timeout_ms  Longest wait, 0 means no waiting and negative
+ *                    means no limit
+ *
+ * @return Number of callbacks made, or -1 on error or when the
+ *         connection is closed (the callbacks of unanswered requests
+ *         have then been called with NULL)
+ */
+int mpl_client_poll(mpl_client_t *client_p, int timeout_ms);
+
+/**
+ * @ingroup MPL_CLIENT
+ * mpl_client_wait
+ *
+ * Write the queued requests and handle responses until a request is
+ * answered.
+ *
+ * @param client_p    The client
+ * @param request_id  The request
+ * @param timeout_ms  Longest wait, negative means no limit
+ *
+ * @return 0 when the request is answered, -1 on error or timeout
+ */
+int mpl_client_wait(mpl_client_t *client_p,
+                    uint32_t request_id,
+                    int timeout_ms);
+
+/**
+ * @ingroup MPL_CLIENT
+ * mpl_client_in_flight
+ *
+ * @param client_p  The client
+ *
+ * @return Number of requests that are not answered
+ */
+int mpl_client_in_flight(mpl_client_t *client_p);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* _MPL_CLIENT_H */
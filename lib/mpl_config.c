@@ -232,36 +232,14 @@ int mpl_config_write_config_bl_fp(FILE *fp,
 
 static char *pack_into_buffer(mpl_list_t *param_list_p, int no_prefix)
 {
-    int buflen;
     char *buf_p;
+    size_t len;
     mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
     options.no_prefix = no_prefix;
     options.message_delimiter = '\n';
 
-    /* Calculate buffer space */
-    buflen = mpl_param_list_pack_extended(param_list_p,
-                                          NULL,
-                                          0,
-                                          &options
-                                         );
-    if (buflen <= 0)
-        return NULL;
-
-    buf_p = malloc((size_t)(buflen + 1));
-    if (buf_p == NULL)
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,("buf_p\n"));
-        mpl_set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        return NULL;
-    }
-
-    /* Pack list in to the buffer */
-    buflen = mpl_param_list_pack_extended(param_list_p,
-                                          buf_p,
-                                          buflen + 1,
-                                          &options
-                                         );
-    if (buflen <= 0)
+    buf_p = mpl_param_list_pack_alloc(param_list_p, &options, &len);
+    if ((buf_p != NULL) && (len == 0))
     {
         free(buf_p);
         return NULL;
@@ -37,6 +37,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#if defined(__unix__) || defined(__APPLE__)
+#define MPL_FILE_USE_MMAP
+#include <sys/mman.h>
+#endif
 #include "mpl_stdint.h"
 #include "mpl_file.h"
 #include "mpl_param.h"
@@ -48,12 +54,29 @@
  *
  *****************************************************************************/
 
-#define MPL_FILE_ALLOC_BLOCKSIZE 1024 /* Will (re)allocate blocks that is a
-                                         multiple of this size */
-#define MPL_FILE_READ_CHUNKSIZE (MPL_FILE_ALLOC_BLOCKSIZE - 1)
+/* Read size when the file size is not known (e.g. a pipe) */
+#define MPL_FILE_READ_CHUNKSIZE 4096
 
-#define MPL_FILE_MAXLINE 256
-#define MPL_FILE_READ_MAX_NUMLINES 512
+/* Initial size of the line buffer, grown for longer lines */
+#define MPL_FILE_INITIAL_LINE_SIZE 256
+
+/* File contents, mapped or read into memory */
+typedef struct
+{
+  char *data_p;
+  size_t len;
+  size_t map_len;         /* Length of the mapping, 0 if read */
+} mpl_file_buf_t;
+
+/* Reads lines from an mpl_file_buf_t */
+typedef struct
+{
+  const char *pos_p;      /* Start of next line */
+  const char *end_p;
+  char *line_p;           /* Copy of current line, '\0' terminated */
+  size_t line_size;
+  int line;               /* Line number */
+} mpl_file_reader_t;
 
 /*****************************************************************************
  *
@@ -66,12 +89,10 @@
  * Private function prototypes
  *
  *****************************************************************************/
-static int mpl_get_file(char **buf_pp, size_t max_filesize, FILE *fp);
-static int mpl_buffer_gets(char *dest_p, size_t maxline, char **src_pp);
-static int mpl_buffer_get_line(char *s,
-                               size_t size,
-                               char **file_pos_pp,
-                               int *line);
+static int mpl_get_file(mpl_file_buf_t *file_buf_p, FILE *fp);
+static int mpl_read_file(mpl_file_buf_t *file_buf_p, FILE *fp, size_t size);
+static void mpl_release_file(mpl_file_buf_t *file_buf_p);
+static int mpl_file_get_line(mpl_file_reader_t *reader_p, char **line_pp);
 
 
 /****************************************************************************
@@ -86,10 +107,10 @@ int mpl_file_read_params_bl(FILE* fp,
                             int param_set_id,
                             mpl_blacklist_t blacklist)
 {
-  char *file_buf_p;
-  char *file_pos_p;
+  mpl_file_buf_t file_buf;
+  mpl_file_reader_t reader;
   char *buf;
-  int line = 0,numargs,i;
+  int numargs,i;
   mpl_arg_t *args_p = NULL;
   mpl_param_element_t* unpackparam = NULL;
   int res;
@@ -103,45 +124,32 @@ int mpl_file_read_params_bl(FILE* fp,
     return -1;
   }
 
-  if ((res = mpl_get_file(&file_buf_p,
-                          (MPL_FILE_READ_MAX_NUMLINES * MPL_FILE_MAXLINE),
-                          fp)) < 0)
+  if (mpl_get_file(&file_buf, fp) < 0)
   {
     return -1;
   }
 
-  if (res == 0)
+  if (file_buf.len == 0)
   {
     /* File was empty */
-    free(file_buf_p);
+    mpl_release_file(&file_buf);
     return 0;
   }
 
-  buf = malloc(MPL_FILE_MAXLINE);
-  if(NULL == buf)
-  {
-    MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                        ("failed allocating memory!\n"));
-    mpl_set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-    free(file_buf_p);
-    free(args_p);
-    return -1;
-  }
+  /* Lines are parsed straight out of the file buffer, one at a time */
+  memset(&reader, 0, sizeof(reader));
+  reader.pos_p = file_buf.data_p;
+  reader.end_p = file_buf.data_p + file_buf.len;
 
-  file_pos_p = file_buf_p;
-  while ((res = mpl_buffer_get_line(buf,
-                                    MPL_FILE_MAXLINE,
-                                    &file_pos_p,
-                                    &line)) > 0)
+  while ((res = mpl_file_get_line(&reader, &buf)) > 0)
   {
     numargs = mpl_get_args_2(&args_p, 0, buf, '=', ';', '\\');
     if (numargs < 0) {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
                             ("mpl_get_args failed\n"));
         mpl_set_errno(E_MPL_FAILED_OPERATION);
-        free(file_buf_p);
-        free(args_p);
-        return -1;
+        res = -1;
+        break;
     }
     
     for(i=0;i<numargs;i++)
@@ -153,7 +161,7 @@ int mpl_file_read_params_bl(FILE* fp,
       {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
                             ("mpl_unpack_param() failed at line %d in file\n",
-                             line));
+                             reader.line));
         mpl_set_errno(E_MPL_FAILED_OPERATION);
         continue;//skip the bad parameters
       }
@@ -167,10 +175,11 @@ int mpl_file_read_params_bl(FILE* fp,
       mpl_list_add(param_list_pp, &unpackparam->list_entry);
     }
     free(args_p);
+    args_p = NULL;
   }
 
-  free(file_buf_p);
-  free(buf);
+  free(reader.line_p);
+  mpl_release_file(&file_buf);
 
   if (res < 0)
   {
@@ -184,9 +193,6 @@ int mpl_file_write_params_internal(FILE *fp,
                                    mpl_list_t *param_list_p,
                                    bool no_prefix)
 {
-  int buflen;
-  char *buf_p;
-  size_t res;
   mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
   options.no_prefix = no_prefix;
   options.message_delimiter = '\n';
@@ -200,49 +206,35 @@ int mpl_file_write_params_internal(FILE *fp,
     return -1;
   }
 
-  /* Calculate buffer space */
-  buflen = mpl_param_list_pack_extended(param_list_p,
-                                        NULL,
-                                        0,
-                                        &options
-                                       );
-  if (buflen <= 0)
+  /* Pack directly to the file, nothing packed is an error as before */
+  if (mpl_param_list_pack_stream(param_list_p,
+                                 mpl_file_write_func,
+                                 fp,
+                                 &options) <= 0)
     return -1;
 
-  buf_p = malloc((size_t)(buflen + 1));
-  if (buf_p == NULL)
-  {
-    MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,("buf_p\n"));
-    mpl_set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-    return -1;
-  }
+  return 0;
+}
 
-  /* Pack list in to the buffer */
-  buflen = mpl_param_list_pack_extended(param_list_p,
-                                        buf_p,
-                                        buflen + 1,
-                                        &options
-                                       );
-  if (buflen <= 0)
-  {
-    free(buf_p);
-    return -1;
-  }
+/**
+ * mpl_file_write_func
+ */
+int mpl_file_write_func(void *ctx_p, const char *data_p, size_t len)
+{
+  FILE *fp = ctx_p;
+  size_t res;
 
-  /* Write to file */
-  res = fwrite(buf_p, sizeof(char), (size_t)buflen, fp);
-  if (res != (size_t)buflen)
+  res = fwrite(data_p, sizeof(char), len, fp);
+  if (res != len)
   {
     MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                        ("fwrite returned %zu (trying to write %d bytes)\n",
+                        ("fwrite returned %zu (trying to write %zu bytes)\n",
                          res,
-                         buflen));/*lint !e557 zu is C99 */
+                         len));/*lint !e557 zu is C99 */
     mpl_set_errno(E_MPL_FAILED_OPERATION);
-    free(buf_p);
     return -1;
   }
 
-  free(buf_p);
   return 0;
 }
 
@@ -254,148 +246,180 @@ int mpl_file_write_params_internal(FILE *fp,
 
 /**
  * mpl_get_file()
+ *
+ * Get the rest of the file (from the current position) into memory. A
+ * regular file is mapped, otherwise it is read.
  **/
-static int mpl_get_file(char **buf_pp, size_t max_filesize, FILE *fp)
+static int mpl_get_file(mpl_file_buf_t *file_buf_p, FILE *fp)
 {
-  char *buf_p;
-  char *buf_pos_p;
-  size_t bytes_read;
-  size_t total_bytes_read = 0;
-  size_t buffer_size;
+  struct stat st;
+  long offset;
+  size_t size = 0;
 
-  buffer_size = MPL_FILE_READ_CHUNKSIZE;
+  memset(file_buf_p, 0, sizeof(*file_buf_p));
 
-  buf_p = malloc(buffer_size + 1); /* Allocate an extra byte for zero
-                                      termination */
-  if (buf_p == NULL)
+  offset = ftell(fp);
+  if ((offset >= 0) &&
+      (fstat(fileno(fp), &st) == 0) &&
+      S_ISREG(st.st_mode) &&
+      (st.st_size > offset))
   {
-    MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,("malloc buf_p\n"));
-    mpl_set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-    return -1;
+    size = (size_t)(st.st_size - offset);
+
+#ifdef MPL_FILE_USE_MMAP
+    {
+      void *map_p;
+
+      map_p = mmap(NULL,
+                   (size_t)st.st_size,
+                   PROT_READ,
+                   MAP_PRIVATE,
+                   fileno(fp),
+                   0);
+      if (map_p != MAP_FAILED)
+      {
+#ifdef MADV_SEQUENTIAL
+        (void)madvise(map_p, (size_t)st.st_size, MADV_SEQUENTIAL);
+#endif
+        file_buf_p->data_p = (char*)map_p + offset;
+        file_buf_p->len = size;
+        file_buf_p->map_len = (size_t)st.st_size;
+
+        /* Leave the file position where reading it would have */
+        (void)fseek(fp, 0, SEEK_END);
+        return 0;
+      }
+    }
+#endif
   }
-  buf_pos_p = buf_p;
 
-  do
-  {
-    size_t max_bytes_to_read;
+  return mpl_read_file(file_buf_p, fp, size);
+}
 
-    max_bytes_to_read = MPL_FILE_READ_CHUNKSIZE;
-    if ((total_bytes_read + MPL_FILE_READ_CHUNKSIZE) > max_filesize)
-      max_bytes_to_read = max_filesize - total_bytes_read;
+/**
+ * mpl_read_file()
+ *
+ * Read the rest of the file. If the size is known it is read in one go,
+ * otherwise the buffer is grown geometrically.
+ **/
+static int mpl_read_file(mpl_file_buf_t *file_buf_p, FILE *fp, size_t size)
+{
+  char *buf_p = NULL;
+  char *new_buf_p;
+  size_t buffer_size;
+  size_t total_bytes_read = 0;
+  size_t bytes_read;
 
-    bytes_read = fread(buf_pos_p, sizeof(char), max_bytes_to_read, fp);
-    if (bytes_read > 0)
-      total_bytes_read += bytes_read;
+  buffer_size = (size > 0) ? size : MPL_FILE_READ_CHUNKSIZE;
 
-    if (feof(fp) || ferror(fp))
-      break;
+  do
+  {
+    if (total_bytes_read == buffer_size)
+      buffer_size *= 2;
 
-    if (total_bytes_read >= max_filesize)
+    new_buf_p = realloc(buf_p, buffer_size);
+    if (new_buf_p == NULL)
     {
-      MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                          ("Maximum allowed file size reached (%zu bytes)\n",
-                           max_filesize - 1));/*lint !e557 zu is C99 */
-      mpl_set_errno(E_MPL_FAILED_OPERATION);
+      MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,("realloc buf_p\n"));
+      mpl_set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
       free(buf_p);
       return -1;
     }
+    buf_p = new_buf_p;
 
-    if ((buffer_size - total_bytes_read) < MPL_FILE_READ_CHUNKSIZE)
-    {
-      buffer_size += MPL_FILE_READ_CHUNKSIZE;
-      buf_p = realloc(buf_p, buffer_size + 1); /* Allocate an extra byte
-                                                  for zero termination */
-      if (buf_p == NULL)
-      {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("realloc buf_p\n"));
-        mpl_set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        return -1;
-      }
-      buf_pos_p = buf_p + total_bytes_read;
-    }
-    else
-    {
-      buf_pos_p += bytes_read;
-    }
+    bytes_read = fread(buf_p + total_bytes_read,
+                       sizeof(char),
+                       buffer_size - total_bytes_read,
+                       fp);
+    total_bytes_read += bytes_read;
   }
-  while (bytes_read > 0);
+  while ((total_bytes_read == buffer_size) && !feof(fp) && !ferror(fp));
 
   if (ferror(fp))
   {
     MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                        ("fread returned %zu (trying to read %d bytes)\n",
-                         bytes_read,
-                         MPL_FILE_READ_CHUNKSIZE));/*lint !e557 zu is C99 */
+                        ("fread failed after %zu bytes\n",
+                         total_bytes_read));/*lint !e557 zu is C99 */
     mpl_set_errno(E_MPL_FAILED_OPERATION);
     free(buf_p);
     return -1;
   }
 
-  buf_p[total_bytes_read] = '\0';
-  *buf_pp = buf_p;
-
-  return (int)total_bytes_read;
+  file_buf_p->data_p = buf_p;
+  file_buf_p->len = total_bytes_read;
+  file_buf_p->map_len = 0;
+  return 0;
 }
 
 /**
- * mpl_buffer_gets()
+ * mpl_release_file()
  **/
-static int mpl_buffer_gets(char *dest_p, size_t maxline, char **src_pp)
+static void mpl_release_file(mpl_file_buf_t *file_buf_p)
 {
-  char *p;
-  size_t len;
-  size_t copylen;
-
-  for (p = *src_pp, len = 0; (*p != '\n') && (*p != '\0'); p++, len++)
-  {
-    /* Nothing */
-  }
-
-  if (*p == '\n')
-  {
-    p++;
-    len++;
-  }
-
-  copylen = len < (maxline-1) ? len : (maxline-1);
-  strncpy(dest_p, *src_pp, copylen);
-  dest_p[copylen] = '\0';
-
-  *src_pp = p;
-
-  if (copylen == len)
+#ifdef MPL_FILE_USE_MMAP
+  if (file_buf_p->map_len > 0)
   {
-    return (int)copylen;
-  }
-  else
-  {
-    MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                        ("Maximum allowed line length exceeded (%zu bytes)\n",
-                         maxline - 1));/*lint !e557 zu is C99 */
-    mpl_set_errno(E_MPL_FAILED_OPERATION);
-    return -1;
+    /* data_p is at the file position, the mapping starts at offset 0 */
+    (void)munmap(file_buf_p->data_p - (file_buf_p->map_len - file_buf_p->len),
+                 file_buf_p->map_len);
+    file_buf_p->data_p = NULL;
+    return;
   }
+#endif
+  free(file_buf_p->data_p);
+  file_buf_p->data_p = NULL;
 }
 
-
 /**
- * mpl_buffer_get_line()
+ * mpl_file_get_line()
+ *
+ * Get the next line that is not empty or a comment, with comments and
+ * surrounding white space removed. The line is copied to a buffer that
+ * grows with the longest line, so there is no limit on line length.
+ *
+ * Returns 1 and the line in *line_pp, 0 at end of file or -1 on error.
  **/
-static int mpl_buffer_get_line(char *s,
-                               size_t size,
-                               char **file_pos_pp,
-                               int *line)
+static int mpl_file_get_line(mpl_file_reader_t *reader_p, char **line_pp)
 {
+  const char *nl_p;
+  size_t len;
+  size_t size;
+  char *new_line_p;
   char *pos, *end;
-  int res;
 
-  while ((res = mpl_buffer_gets(s, size, file_pos_pp)) > 0) {
-    (*line)++;
-    s[size - 1] = '\0';
-    pos = s;
+  while (reader_p->pos_p < reader_p->end_p)
+  {
+    nl_p = memchr(reader_p->pos_p, '\n', reader_p->end_p - reader_p->pos_p);
+    if (nl_p == NULL)
+      nl_p = reader_p->end_p;
+    len = nl_p - reader_p->pos_p;
+    reader_p->line++;
+
+    if (len >= reader_p->line_size)
+    {
+      size = (reader_p->line_size > 0) ?
+        reader_p->line_size : MPL_FILE_INITIAL_LINE_SIZE;
+      while (len >= size)
+        size *= 2;
+      new_line_p = realloc(reader_p->line_p, size);
+      if (new_line_p == NULL)
+      {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("realloc line_p\n"));
+        mpl_set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return -1;
+      }
+      reader_p->line_p = new_line_p;
+      reader_p->line_size = size;
+    }
+
+    memcpy(reader_p->line_p, reader_p->pos_p, len);
+    reader_p->line_p[len] = '\0';
+    reader_p->pos_p = (nl_p < reader_p->end_p) ? (nl_p + 1) : nl_p;
+
+    pos = reader_p->line_p;
     // Skip white space from the beginning of line.
-    while(isspace(*pos))
+    while(isspace((unsigned char)*pos))
       pos++;
     // Skip comment lines and empty lines
     if(*pos == '#')
@@ -409,14 +433,15 @@ static int mpl_buffer_get_line(char *s,
       end = pos + strlen(pos) - 1;
 
     // Remove trailing white space.
-    while (end > pos && isspace(*end))
+    while (end > pos && isspace((unsigned char)*end))
       *end-- = '\0';
 
     if (*pos == '\0')
       continue;
 
-    return (int)strlen(s);
+    *line_pp = pos;
+    return 1;
   }
 
-  return res;
+  return 0;
 }
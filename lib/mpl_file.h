@@ -110,7 +110,8 @@ int mpl_file_read_params_bl(FILE *fp,
  * @param fp                  file descriptor (must be open for writing)
  * @param param_list_p        parameter list
  *
- * @return              0 on success, -1 on error
+ * @return              0 on success, -1 on error (an empty list is an
+ *                      error)
  *
  **/
 #define mpl_file_write_params(fp, param_list_p) \
@@ -127,7 +128,8 @@ int mpl_file_read_params_bl(FILE *fp,
  * @param fp                  file descriptor (must be open for writing)
  * @param param_list_p        parameter list
  *
- * @return              0 on success, -1 on error
+ * @return              0 on success, -1 on error (an empty list is an
+ *                      error)
  *
  **/
 #define mpl_file_write_params_no_prefix(fp, param_list_p) \
@@ -137,6 +139,23 @@ int mpl_file_write_params_internal(FILE *fp,
                                    mpl_list_t *param_list_p,
                                    bool no_prefix);
 
+/**
+ * @ingroup MPL_FILE
+ *
+ * mpl_file_write_func
+ *
+ * Writer callback for mpl_param_list_pack_stream() writing to a file
+ *
+ * @param ctx_p               file descriptor (FILE*, must be open for
+ *                            writing)
+ * @param data_p              data to write
+ * @param len                 number of bytes
+ *
+ * @return              0 on success, -1 on error
+ *
+ **/
+int mpl_file_write_func(void *ctx_p, const char *data_p, size_t len);
+
 
 
 
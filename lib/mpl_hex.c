@@ -0,0 +1,548 @@
+/*
+ *   Copyright 2013 ST-Ericsson SA
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ */
+
+/*************************************************************************
+ *
+ * File name: mpl_hex.c
+ *
+ * Description: Hex encoding and decoding of integer arrays
+ *
+ **************************************************************************/
+/*****************************************************************************
+ *
+ * Include files
+ *
+ *****************************************************************************/
+
+#include "mpl_hex.h"
+
+#if defined(__SSE2__) && !defined(MPL_HEX_NO_SIMD)
+#define MPL_HEX_HAVE_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+/* AVX2 functions are compiled with the target attribute and only
+   called when the CPU has AVX2 */
+#define MPL_HEX_HAVE_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+/*****************************************************************************
+ *
+ * Defines & Type definitions
+ *
+ *****************************************************************************/
+
+/* uint16 and uint32 elements are converted to big endian bytes in
+   blocks of this size and then encoded as bytes (and the other way) */
+#define MPL_HEX_BLOCK_SIZE 512
+
+typedef void (*hex_encode_fp)(const uint8_t *src_p, size_t num, char *dst_p);
+typedef int (*hex_decode_fp)(const char *src_p, size_t num, uint8_t *dst_p);
+
+/*****************************************************************************
+ *
+ * Private function prototypes
+ *
+ *****************************************************************************/
+
+static void hex_encode_scalar(const uint8_t *src_p, size_t num, char *dst_p);
+static int hex_decode_scalar(const char *src_p, size_t num, uint8_t *dst_p);
+#ifdef MPL_HEX_HAVE_SSE2
+static void hex_encode_sse2(const uint8_t *src_p, size_t num, char *dst_p);
+static int hex_decode_sse2(const char *src_p, size_t num, uint8_t *dst_p);
+#endif
+#ifdef MPL_HEX_HAVE_AVX2
+static void hex_encode_avx2(const uint8_t *src_p, size_t num, char *dst_p);
+static int hex_decode_avx2(const char *src_p, size_t num, uint8_t *dst_p);
+#endif
+static hex_encode_fp hex_encoder(void);
+static hex_decode_fp hex_decoder(void);
+
+/*****************************************************************************
+ *
+ * Variables
+ *
+ *****************************************************************************/
+
+static const char hex_digits[] = "0123456789abcdef";
+
+/* Value of a hex digit character, -1 if it is not one */
+static const signed char hex_values[256] =
+{
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+};
+
+/* Set by mpl_hex_set_impl(), -1 means the best available */
+static int hex_forced_impl = -1;
+
+/****************************************************************************
+ *
+ * Public Functions
+ *
+ ****************************************************************************/
+
+/**
+ * mpl_hex_encode_uint8
+ */
+void mpl_hex_encode_uint8(const uint8_t *src_p, size_t num, char *dst_p)
+{
+    hex_encoder()(src_p, num, dst_p);
+}
+
+/**
+ * mpl_hex_encode_uint16
+ */
+void mpl_hex_encode_uint16(const uint16_t *src_p, size_t num, char *dst_p)
+{
+    uint8_t block[MPL_HEX_BLOCK_SIZE];
+    hex_encode_fp encode = hex_encoder();
+    size_t n;
+    size_t i;
+
+    while (num > 0)
+    {
+        n = (num < (MPL_HEX_BLOCK_SIZE / 2)) ? num : (MPL_HEX_BLOCK_SIZE / 2);
+        for (i = 0; i < n; i++)
+        {
+            block[2 * i] = (uint8_t) (src_p[i] >> 8);
+            block[2 * i + 1] = (uint8_t) src_p[i];
+        }
+        encode(block, 2 * n, dst_p);
+        src_p += n;
+        dst_p += 4 * n;
+        num -= n;
+    }
+}
+
+/**
+ * mpl_hex_encode_uint32
+ */
+void mpl_hex_encode_uint32(const uint32_t *src_p, size_t num, char *dst_p)
+{
+    uint8_t block[MPL_HEX_BLOCK_SIZE];
+    hex_encode_fp encode = hex_encoder();
+    size_t n;
+    size_t i;
+
+    while (num > 0)
+    {
+        n = (num < (MPL_HEX_BLOCK_SIZE / 4)) ? num : (MPL_HEX_BLOCK_SIZE / 4);
+        for (i = 0; i < n; i++)
+        {
+            block[4 * i] = (uint8_t) (src_p[i] >> 24);
+            block[4 * i + 1] = (uint8_t) (src_p[i] >> 16);
+            block[4 * i + 2] = (uint8_t) (src_p[i] >> 8);
+            block[4 * i + 3] = (uint8_t) src_p[i];
+        }
+        encode(block, 4 * n, dst_p);
+        src_p += n;
+        dst_p += 8 * n;
+        num -= n;
+    }
+}
+
+/**
+ * mpl_hex_decode_uint8
+ */
+int mpl_hex_decode_uint8(const char *src_p, size_t num, uint8_t *dst_p)
+{
+    return hex_decoder()(src_p, num, dst_p);
+}
+
+/**
+ * mpl_hex_decode_uint16
+ */
+int mpl_hex_decode_uint16(const char *src_p, size_t num, uint16_t *dst_p)
+{
+    uint8_t block[MPL_HEX_BLOCK_SIZE];
+    hex_decode_fp decode = hex_decoder();
+    size_t n;
+    size_t i;
+
+    while (num > 0)
+    {
+        n = (num < (MPL_HEX_BLOCK_SIZE / 2)) ? num : (MPL_HEX_BLOCK_SIZE / 2);
+        if (decode(src_p, 2 * n, block) < 0)
+            return -1;
+        for (i = 0; i < n; i++)
+            dst_p[i] = (uint16_t) ((block[2 * i] << 8) | block[2 * i + 1]);
+        src_p += 4 * n;
+        dst_p += n;
+        num -= n;
+    }
+    return 0;
+}
+
+/**
+ * mpl_hex_decode_uint32
+ */
+int mpl_hex_decode_uint32(const char *src_p, size_t num, uint32_t *dst_p)
+{
+    uint8_t block[MPL_HEX_BLOCK_SIZE];
+    hex_decode_fp decode = hex_decoder();
+    size_t n;
+    size_t i;
+
+    while (num > 0)
+    {
+        n = (num < (MPL_HEX_BLOCK_SIZE / 4)) ? num : (MPL_HEX_BLOCK_SIZE / 4);
+        if (decode(src_p, 4 * n, block) < 0)
+            return -1;
+        for (i = 0; i < n; i++)
+            dst_p[i] = ((uint32_t) block[4 * i] << 24) |
+                ((uint32_t) block[4 * i + 1] << 16) |
+                ((uint32_t) block[4 * i + 2] << 8) |
+                (uint32_t) block[4 * i + 3];
+        src_p += 8 * n;
+        dst_p += n;
+        num -= n;
+    }
+    return 0;
+}
+
+/**
+ * mpl_hex_get_impl
+ */
+mpl_hex_impl_t mpl_hex_get_impl(void)
+{
+    if (hex_forced_impl >= 0)
+        return (mpl_hex_impl_t) hex_forced_impl;
+#ifdef MPL_HEX_HAVE_AVX2
+    if (__builtin_cpu_supports("avx2"))
+        return mpl_hex_impl_avx2;
+#endif
+#ifdef MPL_HEX_HAVE_SSE2
+    return mpl_hex_impl_sse2;
+#else
+    return mpl_hex_impl_scalar;
+#endif
+}
+
+/**
+ * mpl_hex_set_impl
+ */
+int mpl_hex_set_impl(mpl_hex_impl_t impl)
+{
+    switch (impl)
+    {
+        case mpl_hex_impl_scalar:
+            break;
+#ifdef MPL_HEX_HAVE_SSE2
+        case mpl_hex_impl_sse2:
+            break;
+#endif
+#ifdef MPL_HEX_HAVE_AVX2
+        case mpl_hex_impl_avx2:
+            if (!__builtin_cpu_supports("avx2"))
+                return -1;
+            break;
+#endif
+        default:
+            return -1;
+    }
+    hex_forced_impl = (int) impl;
+    return 0;
+}
+
+/****************************************************************************
+ *
+ * Private Functions
+ *
+ ****************************************************************************/
+
+/**
+ * hex_encoder
+ */
+static hex_encode_fp hex_encoder(void)
+{
+    switch (mpl_hex_get_impl())
+    {
+#ifdef MPL_HEX_HAVE_AVX2
+        case mpl_hex_impl_avx2:
+            return hex_encode_avx2;
+#endif
+#ifdef MPL_HEX_HAVE_SSE2
+        case mpl_hex_impl_sse2:
+            return hex_encode_sse2;
+#endif
+        default:
+            return hex_encode_scalar;
+    }
+}
+
+/**
+ * hex_decoder
+ */
+static hex_decode_fp hex_decoder(void)
+{
+    switch (mpl_hex_get_impl())
+    {
+#ifdef MPL_HEX_HAVE_AVX2
+        case mpl_hex_impl_avx2:
+            return hex_decode_avx2;
+#endif
+#ifdef MPL_HEX_HAVE_SSE2
+        case mpl_hex_impl_sse2:
+            return hex_decode_sse2;
+#endif
+        default:
+            return hex_decode_scalar;
+    }
+}
+
+/**
+ * hex_encode_scalar
+ */
+static void hex_encode_scalar(const uint8_t *src_p, size_t num, char *dst_p)
+{
+    size_t i;
+
+    for (i = 0; i < num; i++)
+    {
+        dst_p[2 * i] = hex_digits[src_p[i] >> 4];
+        dst_p[2 * i + 1] = hex_digits[src_p[i] & 0x0f];
+    }
+}
+
+/**
+ * hex_decode_scalar
+ */
+static int hex_decode_scalar(const char *src_p, size_t num, uint8_t *dst_p)
+{
+    size_t i;
+    int hi;
+    int lo;
+
+    for (i = 0; i < num; i++)
+    {
+        hi = hex_values[(unsigned char) src_p[2 * i]];
+        lo = hex_values[(unsigned char) src_p[2 * i + 1]];
+        if ((hi | lo) < 0)
+            return -1;
+        dst_p[i] = (uint8_t) ((hi << 4) | lo);
+    }
+    return 0;
+}
+
+#ifdef MPL_HEX_HAVE_SSE2
+
+/**
+ * hex_chars_sse2
+ *
+ * Nibble values (0..15) to hex digit characters
+ */
+static __m128i hex_chars_sse2(__m128i nibbles)
+{
+    __m128i letters = _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+
+    return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')),
+                        _mm_and_si128(letters, _mm_set1_epi8('a' - '0' - 10)));
+}
+
+/**
+ * hex_nibbles_sse2
+ *
+ * Hex digit characters to nibble values, clears *valid_p if one is not
+ * a hex digit
+ */
+static __m128i hex_nibbles_sse2(__m128i chars, int *valid_p)
+{
+    __m128i digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    __m128i letter = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)),
+                                  _mm_set1_epi8('a'));
+    /* Unsigned x <= n is min(x, n) == x */
+    __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)),
+                                      digit);
+    __m128i is_letter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)),
+                                       letter);
+
+    if (_mm_movemask_epi8(_mm_or_si128(is_digit, is_letter)) != 0xffff)
+        *valid_p = 0;
+    return _mm_or_si128(_mm_and_si128(is_digit, digit),
+                        _mm_and_si128(is_letter,
+                                      _mm_add_epi8(letter, _mm_set1_epi8(10))));
+}
+
+/**
+ * hex_bytes_sse2
+ *
+ * Pairs of nibbles (high first) to bytes, one per 16 bit lane
+ */
+static __m128i hex_bytes_sse2(__m128i nibbles)
+{
+    return _mm_or_si128(_mm_and_si128(_mm_slli_epi16(nibbles, 4),
+                                      _mm_set1_epi16(0x00f0)),
+                        _mm_srli_epi16(nibbles, 8));
+}
+
+/**
+ * hex_encode_sse2
+ */
+static void hex_encode_sse2(const uint8_t *src_p, size_t num, char *dst_p)
+{
+    const __m128i mask = _mm_set1_epi8(0x0f);
+    __m128i v;
+    __m128i hi;
+    __m128i lo;
+    size_t i;
+
+    for (i = 0; (i + 16) <= num; i += 16)
+    {
+        v = _mm_loadu_si128((const __m128i*) (src_p + i));
+        hi = hex_chars_sse2(_mm_and_si128(_mm_srli_epi16(v, 4), mask));
+        lo = hex_chars_sse2(_mm_and_si128(v, mask));
+        _mm_storeu_si128((__m128i*) (dst_p + 2 * i),
+                         _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128((__m128i*) (dst_p + 2 * i + 16),
+                         _mm_unpackhi_epi8(hi, lo));
+    }
+    hex_encode_scalar(src_p + i, num - i, dst_p + 2 * i);
+}
+
+/**
+ * hex_decode_sse2
+ */
+static int hex_decode_sse2(const char *src_p, size_t num, uint8_t *dst_p)
+{
+    __m128i a;
+    __m128i b;
+    int valid = 1;
+    size_t i;
+
+    for (i = 0; (i + 16) <= num; i += 16)
+    {
+        a = hex_nibbles_sse2(_mm_loadu_si128((const __m128i*) (src_p + 2 * i)),
+                             &valid);
+        b = hex_nibbles_sse2(_mm_loadu_si128((const __m128i*) (src_p + 2 * i + 16)),
+                             &valid);
+        if (!valid)
+            return -1;
+        _mm_storeu_si128((__m128i*) (dst_p + i),
+                         _mm_packus_epi16(hex_bytes_sse2(a), hex_bytes_sse2(b)));
+    }
+    return hex_decode_scalar(src_p + 2 * i, num - i, dst_p + i);
+}
+
+#endif /* MPL_HEX_HAVE_SSE2 */
+
+#ifdef MPL_HEX_HAVE_AVX2
+
+/**
+ * hex_encode_avx2
+ */
+__attribute__((target("avx2")))
+static void hex_encode_avx2(const uint8_t *src_p, size_t num, char *dst_p)
+{
+    const __m256i mask = _mm256_set1_epi8(0x0f);
+    const __m256i nine = _mm256_set1_epi8(9);
+    const __m256i zero = _mm256_set1_epi8('0');
+    const __m256i letter = _mm256_set1_epi8('a' - '0' - 10);
+    __m256i v;
+    __m256i hi;
+    __m256i lo;
+    __m256i first;
+    __m256i second;
+    size_t i;
+
+    for (i = 0; (i + 32) <= num; i += 32)
+    {
+        v = _mm256_loadu_si256((const __m256i*) (src_p + i));
+        hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), mask);
+        lo = _mm256_and_si256(v, mask);
+        hi = _mm256_add_epi8(_mm256_add_epi8(hi, zero),
+                             _mm256_and_si256(_mm256_cmpgt_epi8(hi, nine),
+                                              letter));
+        lo = _mm256_add_epi8(_mm256_add_epi8(lo, zero),
+                             _mm256_and_si256(_mm256_cmpgt_epi8(lo, nine),
+                                              letter));
+        /* Unpacking works within 128 bit lanes, the lanes are put back
+           in order afterwards */
+        first = _mm256_unpacklo_epi8(hi, lo);
+        second = _mm256_unpackhi_epi8(hi, lo);
+        _mm256_storeu_si256((__m256i*) (dst_p + 2 * i),
+                            _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256((__m256i*) (dst_p + 2 * i + 32),
+                            _mm256_permute2x128_si256(first, second, 0x31));
+    }
+    hex_encode_sse2(src_p + i, num - i, dst_p + 2 * i);
+}
+
+/**
+ * hex_decode_avx2
+ */
+__attribute__((target("avx2")))
+static int hex_decode_avx2(const char *src_p, size_t num, uint8_t *dst_p)
+{
+    const __m256i nine = _mm256_set1_epi8(9);
+    const __m256i five = _mm256_set1_epi8(5);
+    __m256i chars;
+    __m256i digit;
+    __m256i letter;
+    __m256i is_digit;
+    __m256i is_letter;
+    __m256i nibbles[2];
+    __m256i bytes[2];
+    size_t i;
+    int j;
+
+    for (i = 0; (i + 32) <= num; i += 32)
+    {
+        for (j = 0; j < 2; j++)
+        {
+            chars = _mm256_loadu_si256((const __m256i*) (src_p + 2 * i + 32 * j));
+            digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+            letter = _mm256_sub_epi8(_mm256_or_si256(chars,
+                                                     _mm256_set1_epi8(0x20)),
+                                     _mm256_set1_epi8('a'));
+            is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, nine), digit);
+            is_letter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter, five), letter);
+            if (_mm256_movemask_epi8(_mm256_or_si256(is_digit, is_letter)) != -1)
+                return -1;
+            nibbles[j] = _mm256_or_si256(_mm256_and_si256(is_digit, digit),
+                                         _mm256_and_si256(is_letter,
+                                                          _mm256_add_epi8(letter,
+                                                                          _mm256_set1_epi8(10))));
+            bytes[j] = _mm256_or_si256(_mm256_and_si256(_mm256_slli_epi16(nibbles[j], 4),
+                                                        _mm256_set1_epi16(0x00f0)),
+                                       _mm256_srli_epi16(nibbles[j], 8));
+        }
+        /* Packing works within 128 bit lanes, 0xd8 puts them in order */
+        _mm256_storeu_si256((__m256i*) (dst_p + i),
+                            _mm256_permute4x64_epi64(_mm256_packus_epi16(bytes[0],
+                                                                         bytes[1]),
+                                                     0xd8));
+    }
+    return hex_decode_sse2(src_p + 2 * i, num - i, dst_p + i);
+}
+
+#endif /* MPL_HEX_HAVE_AVX2 */
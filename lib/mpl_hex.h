@@ -0,0 +1,144 @@
+/*
+ *   Copyright 2013 ST-Ericsson SA
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ */
+
+
+/*************************************************************************
+ *
+ * File name: mpl_hex.h
+ *
+ * Description: Hex encoding and decoding of integer arrays
+ *
+ **************************************************************************/
+#ifndef _MPL_HEX_H
+#define _MPL_HEX_H
+
+/**************************************************************************
+ * Includes
+ *************************************************************************/
+#include <stddef.h>
+#include "mpl_stdint.h"
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file mpl_hex.h
+ * @brief Hex encoding and decoding of integer arrays
+ */
+
+/** @defgroup MPL_HEX Hex encoding of integer arrays
+ *  @ingroup MPL
+ * The text format of the uint8, uint16 and uint32 array parameters:
+ * each element is written with a fixed number of lowercase hex digits,
+ * most significant first (as printf "%02x", "%04x" and "%08x"), with
+ * nothing in between. Decoding takes upper and lower case digits.
+ *
+ * SSE2 is used where the compiler targets it, and AVX2 where the CPU
+ * has it (chosen at run time). MPL_HEX_NO_SIMD builds the portable
+ * code only. All implementations give the same result.
+ */
+
+/**
+ * @ingroup MPL_HEX
+ * Implementations
+ */
+typedef enum
+{
+    mpl_hex_impl_scalar,        /**< Portable C */
+    mpl_hex_impl_sse2,          /**< SSE2 */
+    mpl_hex_impl_avx2           /**< AVX2 */
+} mpl_hex_impl_t;
+
+/**
+ * @ingroup MPL_HEX
+ * mpl_hex_encode_uint8
+ *
+ * Encode num elements into 2 * num characters (not '\0' terminated).
+ */
+void mpl_hex_encode_uint8(const uint8_t *src_p, size_t num, char *dst_p);
+
+/**
+ * @ingroup MPL_HEX
+ * mpl_hex_encode_uint16
+ *
+ * Encode num elements into 4 * num characters (not '\0' terminated).
+ */
+void mpl_hex_encode_uint16(const uint16_t *src_p, size_t num, char *dst_p);
+
+/**
+ * @ingroup MPL_HEX
+ * mpl_hex_encode_uint32
+ *
+ * Encode num elements into 8 * num characters (not '\0' terminated).
+ */
+void mpl_hex_encode_uint32(const uint32_t *src_p, size_t num, char *dst_p);
+
+/**
+ * @ingroup MPL_HEX
+ * mpl_hex_decode_uint8
+ *
+ * Decode num elements from 2 * num characters, which must all be there.
+ *
+ * @return 0 on success, -1 if a character is not a hex digit
+ */
+int mpl_hex_decode_uint8(const char *src_p, size_t num, uint8_t *dst_p);
+
+/**
+ * @ingroup MPL_HEX
+ * mpl_hex_decode_uint16
+ *
+ * Decode num elements from 4 * num characters, which must all be there.
+ *
+ * @return 0 on success, -1 if a character is not a hex digit
+ */
+int mpl_hex_decode_uint16(const char *src_p, size_t num, uint16_t *dst_p);
+
+/**
+ * @ingroup MPL_HEX
+ * mpl_hex_decode_uint32
+ *
+ * Decode num elements from 8 * num characters, which must all be there.
+ *
+ * @return 0 on success, -1 if a character is not a hex digit
+ */
+int mpl_hex_decode_uint32(const char *src_p, size_t num, uint32_t *dst_p);
+
+/**
+ * @ingroup MPL_HEX
+ * mpl_hex_get_impl
+ *
+ * @return The implementation in use
+ */
+mpl_hex_impl_t mpl_hex_get_impl(void);
+
+/**
+ * @ingroup MPL_HEX
+ * mpl_hex_set_impl
+ *
+ * Use a particular implementation (for testing and benchmarking), must
+ * not be called while other threads encode or decode.
+ *
+ * @return 0 on success, -1 if it is not available
+ */
+int mpl_hex_set_impl(mpl_hex_impl_t impl);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* _MPL_HEX_H */
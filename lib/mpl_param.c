@@ -47,6 +47,7 @@
 #include "mpl_dbgtrace.h"
 #include "mpl_snprintf.h"
 #include "mpl_pthread.h"
+#include "mpl_hex.h"
 
 /*****************************************************************************
  *
@@ -65,12 +66,203 @@
      MPL_PARAM_SET_ID_TO_PARAMID_BASE((param_descr_p)->param_set_id) +  \
      1 + MPL_PARAMID_POSITION_VIRTUAL(((param_descr_p)->array2[index].is_virtual?1:0)))
 
+/* The values of the parameter are freed with free() alone */
+#define DESCR_VALUE_IS_FLAT(descr_p) ((descr_p)->free_func == mpl_free_param_value)
 
+/* Binary transfer format element flags */
+#define MPL_BIN_FLAG_TAG 0x01
+#define MPL_BIN_FLAG_FIELD 0x02
+#define MPL_BIN_FLAG_VALUE 0x04
+#define MPL_BIN_FLAGS (MPL_BIN_FLAG_TAG | MPL_BIN_FLAG_FIELD | MPL_BIN_FLAG_VALUE)
+
+/* Initial size of the key/value array allocated by mpl_get_args_2() */
+#define MPL_ARGS_INITIAL_LEN 8
+
+/* Max length of a varint encoded 64 bit value */
+#define MPL_BIN_VARINT_MAXLEN 10
+
+
+/*
+ * Name lookup index: open addressing hash table mapping a name to its
+ * position in the array the index was built from.
+ */
 typedef struct
 {
-    mpl_param_descr_set_t *paramset_p;
-    mpl_list_t list_entry;
-} mpl_paramset_container_t;
+    uint32_t hash;
+    int pos;                  /* -1 means empty slot */
+    const char *name_p;
+} mpl_name_index_entry_t;
+
+typedef struct
+{
+    uint32_t mask;
+    mpl_name_index_entry_t *entries;
+} mpl_name_index_t;
+
+typedef const char *(*mpl_name_index_get_name_fp)(const void *array_p, int pos);
+
+/* Arrays with fewer names than this are searched linearly */
+#define MPL_NAME_INDEX_MIN_SIZE 8
+
+/*
+ * Packed id of a parameter ("prefix.name") or bag field
+ * ("prefix.name%field"), rendered once. Without prefix it starts at
+ * name_offset of the parameter set index, for a field packed in context
+ * mode at field_offset.
+ */
+typedef struct
+{
+    const char *text_p;
+    int len;
+    int field_offset;
+} mpl_rendered_key_t;
+
+/* Per parameter set index, hangs off mpl_param_descr_set_t.index_p */
+typedef struct mpl_paramset_index_s
+{
+    mpl_name_index_t params;
+    mpl_name_index_t *fields;   /* One per parameter, NULL if none has fields */
+    mpl_rendered_key_t *keys;   /* One per parameter, then the fields */
+    mpl_rendered_key_t **field_keys; /* One array per parameter (in field
+                                        value order), NULL if no fields */
+    int name_offset;            /* strlen(prefix) + 1 */
+    char *key_text_p;           /* The rendered keys */
+} mpl_paramset_index_t;
+
+/* Index of enum value arrays, keyed by array address */
+typedef struct
+{
+    const mpl_enum_value_t *enum_values;
+    mpl_name_index_t index;
+    int *by_value;            /* Positions sorted on value (then position) */
+} mpl_enum_index_entry_t;
+
+/*
+ * Index of integer range arrays, keyed by array address: the ranges as
+ * sorted, disjoint intervals, each with the id of the first range in
+ * the array covering it.
+ */
+typedef struct
+{
+    const mpl_integer_range_t *integer_ranges;
+    mpl_integer_range_t *intervals;
+    int num_intervals;
+} mpl_range_index_entry_t;
+
+/* Range arrays with fewer ranges than this are searched linearly */
+#define MPL_RANGE_INDEX_MIN_SIZE 8
+
+/*
+ * Parameter set registry. A registration publishes a new snapshot and
+ * a published snapshot is never changed, so readers need no locking.
+ * Replaced snapshots are kept on the retired_p chain until
+ * mpl_param_system_deinit(), as readers may still be using them.
+ */
+typedef struct mpl_paramset_registry_s
+{
+    mpl_param_descr_set_t **by_id;      /* Indexed by param_set_id */
+    int by_id_size;
+    mpl_param_descr_set_t **paramsets;  /* Newest registration first */
+    int num_paramsets;
+    mpl_name_index_t prefix_index;      /* Prefix to position in paramsets */
+    /* Enum name lookup, the name indexes are shared with older snapshots */
+    mpl_enum_index_entry_t *enum_index_p;
+    uint32_t enum_index_mask;
+    uint32_t enum_index_count;
+    /* Integer range lookup, the intervals are shared like the enum indexes */
+    mpl_range_index_entry_t *range_index_p;
+    uint32_t range_index_mask;
+    uint32_t range_index_count;
+    struct mpl_paramset_registry_s *retired_p;
+} mpl_paramset_registry_t;
+
+/*
+ * Parameter list index: open addressing hash table from a key to the
+ * first element in the list having that key. Slots whose elements have
+ * all been removed keep their key (count 0) until the table is grown.
+ *
+ * An index made with mpl_param_list_index_create() is attached: it is
+ * kept on a list of indexes, and the first element of its list has
+ * heads_index set, which makes the mpl_param_list_find*() functions
+ * look for the index. The indexes that mpl_compare_param_lists() makes
+ * for itself are not attached.
+ */
+typedef enum
+{
+    list_key_none = 0,          /* Empty slot */
+    list_key_id,                /* Element id, any tag */
+    list_key_id_tag,            /* Element id and tag */
+    list_key_field,             /* Context and id in context, any tag */
+    list_key_field_tag          /* Context, id in context and tag */
+} mpl_list_key_kind_t;
+
+/* Most keys of an element, see list_index_keys() */
+#define MPL_LIST_INDEX_MAX_KEYS 4
+
+typedef struct
+{
+    mpl_list_key_kind_t kind;
+    int id;
+    int id_in_context;
+    int tag;
+    int count;                  /* Number of elements having the key */
+    mpl_param_element_t *first_p;
+} mpl_list_index_entry_t;
+
+struct mpl_param_list_index_s
+{
+    mpl_list_t **list_pp;
+    bool attached;
+    mpl_list_t *head_p;         /* *list_pp, changed under mutex if attached */
+    mpl_list_t list_entry;      /* In attached_indexes_p if attached */
+    uint32_t mask;
+    uint32_t used;              /* Slots with a key */
+    mpl_list_index_entry_t *entries;
+};
+
+/* Initial number of slots of a parameter list index */
+#define MPL_LIST_INDEX_MIN_SIZE 16
+
+/* Lists shorter than this are compared without an index */
+#define MPL_LIST_INDEX_COMPARE_MIN_LEN 16
+
+/* Initial batch size of mpl_param_list_pack_stream() */
+#define MPL_PACK_STREAM_BATCH_SIZE 4096
+
+/* Parts of a packed parameter id, see pack_key_resolve() */
+typedef struct
+{
+    mpl_param_descr_set_t *param_descr_p; /* Of the element */
+    const char *key_p;          /* [prefix.][name][%field], pre-rendered */
+    int key_len;
+    const char *field_p;        /* NULL if not a field */
+    const char *child_prefix_p; /* NULL if not packed */
+    const char *child_name_p;   /* NULL if not a child */
+    char tag_str[12];
+    int tag_len;
+} mpl_pack_key_t;
+
+/* Initial text buffer size of an mpl_unpack_stream_t */
+#define MPL_UNPACK_STREAM_INITIAL_SIZE 256
+
+struct mpl_unpack_stream_s
+{
+    mpl_pack_options_t options;
+    char terminator;
+    mpl_unpack_element_fp element_func;
+    mpl_unpack_message_fp message_func;
+    void *ctx_p;
+    char *buf_p;                /* Text of the parameter being received */
+    size_t len;
+    size_t size;
+    int depth;                  /* Of {} in a bracketed value */
+    bool escaped;               /* Previous character was an escape */
+    bool in_value;              /* After the = */
+    bool value_started;         /* Seen first non-space of the value */
+    bool in_message;            /* Seen a parameter of the message */
+    bool has_error;
+    mpl_list_t *param_list_p;   /* Message being received */
+};
 
 #define num_scratch_strings 4
 #define initial_scratch_string_len (255+1)
@@ -82,6 +274,7 @@ typedef struct
     int scratch_string_current;
     char *scratch_string[num_scratch_strings];
     int scratch_string_len[num_scratch_strings];
+    mpl_arena_t *arena_p;       /* See mpl_param_arena_set() */
     mpl_list_t list_entry;
 } mpl_pc_t;
 
@@ -98,6 +291,32 @@ static const char *mpl_type_names[] =
 };
 #undef MPL_TYPE_ID_ELEMENT
 
+/* Default binary pack/unpack methods, used when not given by the descriptor */
+#define MPL_TYPE_ID_ELEMENT(TYPE)                                       \
+    { mpl_pack_bin_param_value_##TYPE, mpl_unpack_bin_param_value_##TYPE },
+static const struct
+{
+    mpl_pack_bin_param_fp pack_bin_func;
+    mpl_unpack_bin_param_fp unpack_bin_func;
+} mpl_bin_methods[] =
+{
+    MPL_TYPE_IDS
+};
+#undef MPL_TYPE_ID_ELEMENT
+
+/* Default packed size methods, valid with the default pack method only */
+#define MPL_TYPE_ID_ELEMENT(TYPE)                                       \
+    { mpl_pack_param_value_##TYPE, mpl_packed_size_param_value_##TYPE },
+static const struct
+{
+    mpl_pack_param_fp pack_func;
+    mpl_packed_size_param_fp packed_size_func;
+} mpl_packed_size_methods[] =
+{
+    MPL_TYPE_IDS
+};
+#undef MPL_TYPE_ID_ELEMENT
+
 
 /*****************************************************************************
  *
@@ -108,7 +327,27 @@ static const char *mpl_type_names[] =
 static mpl_mutex_t *mutex;   // The mutex
 static bool MutexCreated = false;
 static mpl_list_t *mpl_pc_list_p;
-static mpl_list_t *paramset_list_p = NULL;
+#ifdef MPL_HAVE_THREAD_LOCAL
+/* Context of the calling thread, freed by pc_destructor() at thread exit */
+static mpl_thread_local_key_t pc_key;
+#endif
+/* Current parameter set registry, replaced under mutex, read without */
+static mpl_paramset_registry_t *registry_p = NULL;
+
+/* Number of threads with an arena set, changed under mutex and read
+   without it through the atomic accessors */
+static int arenas_active = 0;
+
+/* Attached parameter list indexes, under mutex */
+static mpl_list_t *attached_indexes_p = NULL;
+
+#ifdef MPL_HAVE_ATOMIC_INT
+#define ARENAS_ACTIVE_ADD(n) mpl_atomic_add_int(&arenas_active, n)
+#define ARENAS_ACTIVE_RESET() mpl_atomic_store_int(&arenas_active, 0)
+#else
+#define ARENAS_ACTIVE_ADD(n) (arenas_active += (n))
+#define ARENAS_ACTIVE_RESET() (arenas_active = 0)
+#endif
 
 static const char* mpl_names_bool[] =
 {
@@ -136,7 +375,8 @@ static const char* mpl_names_bool8[] =
 static char *strchr_escape(char *s, char c, char escape);
 static int snprintf_escape(char delimiter, char escape,
                            char *str, size_t size, const char *format, ...);
-static int fill_escape(char *str, int size, char delimiter, char escape);
+static size_t escaped_len(const char *text_p, size_t len,
+                          char delimiter, char escape);
 static char *remove_escape(const char *src, char escape);
 
 static char *get_matching_close_bracket(char open_bracket, char close_bracket, char *str_p, char escape);
@@ -146,17 +386,32 @@ static char *get_bracket_contents(const char *str,
                                   size_t *len_p);
 static int convert_int(const char* value_str, int *value_p);
 static int convert_int64(const char* value_str, int64_t *value_p);
+static int convert_uint64(const char* value_str, uint64_t *value_p);
+static const char *parse_integer(const char *value_str,
+                                 bool c_syntax,
+                                 bool *negative_p,
+                                 uint64_t *magnitude_p);
+static int pack_text(char *buf, size_t buflen, const char *text_p, size_t len);
+static int pack_int(char *buf, size_t buflen, int64_t value);
+static int pack_hex(char *buf, size_t buflen, uint64_t value);
+static int pack_name(char *buf, size_t buflen, const char *name_p);
+static int decimal_width(int64_t value);
+static int hex_width(uint64_t value);
 static int convert_stringarr_to_int(const char* value_str,
                                     int *value_p,
                                     const char* stringarr[],
                                     int stringarr_size);
 static int convert_enum_name_to_int64(const char* name_p,
                                       int64_t *value_p,
-                                      const mpl_enum_value_t enum_values[],
-                                      int enum_values_size);
+                                      const mpl_param_descr2_t *descr_p);
 static const char *convert_enum_value_to_name(int64_t value,
-                                              const mpl_enum_value_t enum_values[],
-                                              int enum_values_size);
+                                              const mpl_param_descr2_t *descr_p);
+static int enum_table_name_lookup(const char *name_p,
+                                  const mpl_enum_table_t *table_p,
+                                  const mpl_enum_value_t enum_values[]);
+static int enum_table_value_lookup(int64_t value,
+                                   const mpl_enum_table_t *table_p,
+                                   const mpl_enum_value_t enum_values[]);
 static int check_integer_ranges(int64_t value,
                                 const mpl_integer_range_t integer_ranges[],
                                 int integer_ranges_size);
@@ -165,8 +420,8 @@ static const mpl_field_value_t *get_field_from_id(int field_id,
                                                   int field_values_size);
 static const mpl_field_value_t *get_field_from_name(const char *field_str,
                                                     size_t field_strlen,
-                                                    const mpl_field_value_t field_values[],
-                                                    int field_values_size);
+                                                    const mpl_param_descr_set_t *param_descr_p,
+                                                    int index);
 static const char *get_field_name(int param_id,
                                   int field_id,
                                   mpl_param_descr_set_t *param_descr_p);
@@ -184,15 +439,92 @@ static int get_child_index(mpl_param_element_id_t param_id,
                            mpl_param_descr_set_t *param_descr_p);
 static void set_errno(int error_value);
 
+static int bin_put_varint(uint8_t *buf_p, size_t buflen, size_t pos,
+                          uint64_t value);
+static int bin_get_varint(const uint8_t *buf_p, size_t buflen, size_t *pos_p,
+                          uint64_t *value_p);
+static void bin_put_le(uint8_t *p, uint64_t value, size_t size);
+static uint64_t bin_get_le(const uint8_t *p, size_t size);
+static int64_t bin_sign_extend(uint64_t value, size_t size);
+static int bin_put_string(uint8_t *buf_p, size_t buflen, size_t pos,
+                          const char *str_p);
+static int bin_get_string(const uint8_t *buf_p, size_t buflen, size_t *pos_p,
+                          char **str_pp);
+static mpl_pack_bin_param_fp get_pack_bin_func(const mpl_param_descr_t *descr_p);
+static mpl_packed_size_param_fp get_packed_size_func(const mpl_param_descr_t *descr_p);
+static mpl_unpack_bin_param_fp get_unpack_bin_func(const mpl_param_descr_t *descr_p);
+static int check_bin_context(mpl_param_element_id_t param_id,
+                             mpl_param_element_id_t context,
+                             int id_in_context);
+static int param_pack_bin(const mpl_param_element_t *element_p,
+                          uint8_t *buf_p,
+                          size_t buflen);
+static int param_unpack_bin(const uint8_t *buf_p,
+                            size_t buflen,
+                            size_t *pos_p,
+                            mpl_param_element_t **element_pp);
+static int param_list_pack_bin_body(mpl_list_t *param_list_p,
+                                    uint8_t *buf_p,
+                                    size_t buflen);
+static mpl_list_t *param_list_unpack_buf(char *buf_p,
+                                         const mpl_pack_options_t *options_p,
+                                         mpl_param_element_id_t unpack_context,
+                                         bool *has_error_p);
+static char *param_list_parse(char *p,
+                              const mpl_pack_options_t *options_p,
+                              mpl_param_element_id_t unpack_context,
+                              bool nested,
+                              mpl_list_t **param_list_pp);
+static int param_unpack_key(const char* id_str,
+                            const mpl_pack_options_t *options_p,
+                            mpl_param_element_id_t unpack_context,
+                            mpl_param_element_t** element_pp);
+static int param_unpack_value(mpl_param_element_t* element_p,
+                              const char* id_str,
+                              const char* value_str,
+                              const mpl_pack_options_t *options_p);
+static int check_bag_len(const mpl_list_t *l_p,
+                         const mpl_param_descr2_t *descr_p);
+static mpl_list_t *param_list_unpack_bin_body(const uint8_t *buf_p,
+                                              size_t buflen,
+                                              bool *has_error_p);
+
 static char *get_scratch_string(int len);
 
 static mpl_pc_t* get_pc(void);
+static void pc_free(mpl_pc_t* pc_p);
+#ifdef MPL_HAVE_THREAD_LOCAL
+static void pc_destructor(void *arg_p);
+#endif
 
 #if !defined(__linux__) && !defined(WIN32)
 static char *mpl_strdup(const char *s);
 #define strdup mpl_strdup
 #endif
 
+/*
+ * Element and value allocations come from the arena of the calling
+ * thread, if it has one (see mpl_param_arena_set()). Library state that
+ * must outlive an arena, or memory handed to the caller to free(), is
+ * allocated with the heap_ functions. param_free() can be given both
+ * kinds of memory.
+ */
+static void *param_malloc(size_t size);
+static void *param_calloc(size_t nmemb, size_t size);
+static void *param_realloc(void *ptr, size_t size);
+static void param_free(void *ptr);
+static mpl_arena_t *current_arena(void);
+
+#define heap_malloc(size) (malloc)(size)
+#define heap_calloc(nmemb, size) (calloc)(nmemb, size)
+#define heap_realloc(ptr, size) (realloc)(ptr, size)
+#define heap_free(ptr) (free)(ptr)
+
+#define malloc(size) param_malloc(size)
+#define calloc(nmemb, size) param_calloc(nmemb, size)
+#define realloc(ptr, size) param_realloc(ptr, size)
+#define free(ptr) param_free(ptr)
+
 #ifdef MPL_MODULE_TEST
 static void mpl_module_test_param_deinit(void);
 #endif
@@ -221,6 +553,125 @@ static mpl_param_descr_set_t* paramset_find(int param_set_id,
  */
 static int paramset_add(mpl_param_descr_set_t* paramset_p);
 
+/**
+ * paramset_find_prefix
+ *
+ * Find parameter set from a "prefix.name" string.
+ *
+ * Returns parameter descriptor set of NULL if not found.
+ *
+ */
+static mpl_param_descr_set_t* paramset_find_prefix(const char *id_str);
+
+/* Name lookup indexes */
+static int name_index_build(mpl_name_index_t *index_p,
+                            const void *array_p,
+                            int size,
+                            mpl_name_index_get_name_fp get_name);
+static int name_index_lookup(const mpl_name_index_t *index_p,
+                             const char *name_p,
+                             size_t namelen);
+static void name_index_free(mpl_name_index_t *index_p);
+static const char *paramset_prefix_get(const void *array_p, int pos);
+static int paramset_index_build(mpl_param_descr_set_t *param_descr_p);
+static int paramset_keys_build(mpl_param_descr_set_t *param_descr_p,
+                               mpl_paramset_index_t *index_p);
+static void paramset_index_free(mpl_param_descr_set_t *param_descr_p);
+static int paramset_name_lookup(const mpl_param_descr_set_t *param_descr_p,
+                                const char *name_p,
+                                size_t namelen);
+static int enum_index_add(mpl_paramset_registry_t *reg_p,
+                          const mpl_enum_value_t enum_values[],
+                          int enum_values_size);
+static int enum_index_lookup(const char *name_p,
+                             const mpl_enum_value_t enum_values[]);
+static const mpl_enum_index_entry_t *enum_index_get(const mpl_enum_value_t enum_values[]);
+static int range_index_add(mpl_paramset_registry_t *reg_p,
+                           const mpl_integer_range_t integer_ranges[],
+                           int integer_ranges_size);
+static const mpl_range_index_entry_t *range_index_get(const mpl_integer_range_t integer_ranges[]);
+
+/* Parameter ids */
+static int pack_key_resolve(const mpl_param_element_t* element_p,
+                            const mpl_pack_options_t *options_p,
+                            mpl_pack_key_t *key_p);
+static int pack_key(char *buf, size_t buflen, const mpl_pack_key_t *key_p);
+static size_t pack_key_put(char *buf,
+                           size_t buflen,
+                           size_t pos,
+                           const char *text_p,
+                           size_t len);
+static int render_tag(char *tag_str, int tag);
+static int pack_key_len(const mpl_pack_key_t *key_p);
+
+/* Streaming pack */
+static int pack_stream_flush(mpl_pack_write_fp write_func,
+                             void *ctx_p,
+                             const char *data_p,
+                             size_t len);
+
+/* Hex arrays */
+static int pack_hex_array(char *buf,
+                          size_t buflen,
+                          uint32_t len,
+                          const void *arr_p,
+                          int width);
+static bool unpack_hex_array_complete(const char *value_str,
+                                      unsigned int len,
+                                      int width);
+
+/* Streaming unpack */
+static int unpack_stream_append(mpl_unpack_stream_t *stream_p,
+                                const char *data_p,
+                                size_t len);
+static int unpack_stream_element(mpl_unpack_stream_t *stream_p);
+static int unpack_stream_message_end(mpl_unpack_stream_t *stream_p);
+
+/* Parameter list index */
+static mpl_param_list_index_t *list_index_create(mpl_list_t **param_list_pp,
+                                                 bool attach);
+static mpl_param_list_index_t *list_index_attached(mpl_list_t *param_list_p);
+static void list_index_set_head(mpl_param_list_index_t *index_p);
+static mpl_param_element_t *param_list_find(mpl_param_element_id_t param_id,
+                                            mpl_list_t *param_list_p);
+static mpl_param_element_t *param_list_find_tag(mpl_param_element_id_t param_id,
+                                                int tag,
+                                                mpl_list_t *param_list_p);
+static mpl_param_element_t *param_list_find_field(mpl_param_element_id_t context,
+                                                  int id_in_context,
+                                                  mpl_list_t *param_list_p);
+static mpl_param_element_t *param_list_find_field_tag(mpl_param_element_id_t context,
+                                                      int id_in_context,
+                                                      int tag,
+                                                      mpl_list_t *param_list_p);
+static int list_index_insert(mpl_param_list_index_t *index_p,
+                             mpl_param_element_t *param_elem_p,
+                             bool at_front);
+static void list_index_delete(mpl_param_list_index_t *index_p,
+                              mpl_param_element_t *param_elem_p,
+                              mpl_list_t *next_p);
+static mpl_list_index_entry_t *list_index_slot(const mpl_param_list_index_t *index_p,
+                                               mpl_list_key_kind_t kind,
+                                               int id,
+                                               int id_in_context,
+                                               int tag);
+static int list_index_grow(mpl_param_list_index_t *index_p);
+static int list_index_keys(const mpl_param_element_t *param_elem_p,
+                           mpl_list_index_entry_t keys[]);
+static bool list_key_matches(const mpl_list_index_entry_t *key_p,
+                             const mpl_param_element_t *param_elem_p);
+static bool param_has_children(mpl_param_element_id_t param_id);
+static int param_list_compare_one_way(mpl_list_t *list1_p,
+                                      mpl_list_t *list2_p,
+                                      const mpl_param_list_index_t *index2_p);
+
+/* Parameter set registry */
+static mpl_paramset_registry_t *registry_get(void);
+static mpl_paramset_registry_t *registry_create(mpl_paramset_registry_t *old_p,
+                                                mpl_param_descr_set_t *paramset_p);
+static void registry_free(mpl_paramset_registry_t *reg_p,
+                          bool free_shared_indexes);
+
 /* MPL version upgrade */
 static int upgrade_param_descr_set(mpl_param_descr_set_t *param_descr_p);
 
@@ -240,6 +691,16 @@ int mpl_param_init(mpl_param_descr_set_t *param_descr_p)
     {
         mpl_threads_init();
         (void)mpl_mutex_init(&mutex);
+#ifdef MPL_HAVE_THREAD_LOCAL
+        if (mpl_thread_local_create(&pc_key, pc_destructor) != 0)
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("Could not create thread local key\n"));
+            (void)mpl_mutex_destroy(mutex);
+            mpl_threads_deinit();
+            return -1;
+        }
+#endif
         MutexCreated = true;
 
         /* Initialize the debugtrace */
@@ -279,16 +740,26 @@ int mpl_param_init(mpl_param_descr_set_t *param_descr_p)
         return -1;
     }
 
-    return paramset_add(param_descr_p);
+    if (paramset_index_build(param_descr_p) < 0) {
+        return -1;
+    }
+
+    if (paramset_add(param_descr_p) < 0) {
+        paramset_index_free(param_descr_p);
+        return -1;
+    }
+
+    return 0;
 }
 
 void mpl_param_deinit(void)
 {
     mpl_list_t *tmp_p;
     mpl_pc_t* pc_p;
-    int i;
 
     pc_p = get_pc();
+    if (NULL == pc_p)
+        return;
 
     (void)mpl_mutex_lock(mutex);
     tmp_p = mpl_list_remove(&mpl_pc_list_p, &pc_p->list_entry);
@@ -300,12 +771,14 @@ void mpl_param_deinit(void)
         (void)mpl_mutex_unlock(mutex);
         return;
     }
-
-    for (i = 0; i < num_scratch_strings; i++)
-        free(pc_p->scratch_string[i]);
-
-    free(pc_p);
+    if (NULL != pc_p->arena_p)
+        (void)ARENAS_ACTIVE_ADD(-1);
     (void)mpl_mutex_unlock(mutex);
+
+#ifdef MPL_HAVE_THREAD_LOCAL
+    (void)mpl_thread_local_set(pc_key, NULL);
+#endif
+    pc_free(pc_p);
 #ifdef MPL_MODULE_TEST
     mpl_module_test_param_deinit();
 #endif
@@ -317,43 +790,85 @@ void mpl_param_system_deinit(void)
     mpl_list_t *elem_p;
     mpl_list_t *tmp_p;
     mpl_pc_t* pc_p;
-    mpl_paramset_container_t *paramset_container_p;
+    mpl_param_descr_set_t *paramset_p;
+    mpl_paramset_registry_t *reg_p;
+    mpl_paramset_registry_t *retired_p;
     int i;
+    int j;
 
     (void)mpl_mutex_lock(mutex);
+#ifdef MPL_HAVE_THREAD_LOCAL
+    /* Contexts of live threads are freed here, not at thread exit */
+    (void)mpl_thread_local_delete(pc_key);
+#endif
     MPL_LIST_FOR_EACH_SAFE(mpl_pc_list_p, elem_p, tmp_p)
     {
         pc_p = MPL_LIST_CONTAINER(elem_p, mpl_pc_t, list_entry);
-        for (i = 0; i < num_scratch_strings; i++)
-            free(pc_p->scratch_string[i]);
-        free(pc_p);
+        pc_free(pc_p);
     }
 
     mpl_pc_list_p = NULL;
+    (void)ARENAS_ACTIVE_RESET();
 
-    MPL_LIST_FOR_EACH_SAFE(paramset_list_p, elem_p, tmp_p)
+    reg_p = registry_p;
+    for (j = 0; (NULL != reg_p) && (j < reg_p->num_paramsets); j++)
     {
-        paramset_container_p = MPL_LIST_CONTAINER(elem_p,
-                                                  mpl_paramset_container_t,
-                                                  list_entry);
+        paramset_p = reg_p->paramsets[j];
 
-        if (paramset_container_p->paramset_p->is_dynamic_array2) {
-            int size = PARAM_SET_SIZE(paramset_container_p->paramset_p);
+        paramset_index_free(paramset_p);
+        if (paramset_p->is_dynamic_array2) {
+            int size = PARAM_SET_SIZE(paramset_p);
             for(i=0;i<size;i++) {
-                free((void*)paramset_container_p->paramset_p->array2[i].max_p);
-                free((void*)paramset_container_p->paramset_p->array2[i].enum_values);
+                free((void*)paramset_p->array2[i].max_p);
+                free((void*)paramset_p->array2[i].enum_values);
             }
-            free((void*)paramset_container_p->paramset_p->array2);
+            free((void*)paramset_p->array2);
         }
-        free(paramset_container_p);
     }
 
+    while (NULL != reg_p)
+    {
+        retired_p = reg_p->retired_p;
+        registry_free(reg_p, reg_p == registry_p);
+        reg_p = retired_p;
+    }
+    registry_p = NULL;
+
     (void)mpl_mutex_unlock(mutex);
     (void)mpl_mutex_destroy(mutex);
     mpl_threads_deinit();
+    MutexCreated = false;
     return;
 }
 
+/**
+ * mpl_param_arena_set
+ *
+ */
+mpl_arena_t *mpl_param_arena_set(mpl_arena_t *arena_p)
+{
+    mpl_pc_t* pc_p = get_pc();
+    mpl_arena_t *old_arena_p;
+
+    if (NULL == pc_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Could not find process context\n"));
+        return NULL;
+    }
+
+    old_arena_p = pc_p->arena_p;
+    if ((NULL == old_arena_p) != (NULL == arena_p))
+    {
+        (void)mpl_mutex_lock(mutex);
+        (void)ARENAS_ACTIVE_ADD((NULL != arena_p) ? 1 : -1);
+        (void)mpl_mutex_unlock(mutex);
+    }
+    pc_p->arena_p = arena_p;
+
+    return old_arena_p;
+}
+
 #ifdef MPL_MODULE_TEST
 static void mpl_module_test_param_deinit(void)
 {
@@ -479,28 +994,27 @@ int
 }
 
 /**
- * mpl_param_pack - pack a parameter to be sent to psccd (PS Connection
- *                          Control Daemon)
- */
-int
-    mpl_param_pack_internal(const mpl_param_element_t* element_p,
-                            char *buf,
-                            size_t buflen,
-                            const mpl_pack_options_t *options_p)
+ * pack_key_resolve()
+ *
+ * Check an element and find the parts of its packed id.
+ **/
+static int pack_key_resolve(const mpl_param_element_t* element_p,
+                            const mpl_pack_options_t *options_p,
+                            mpl_pack_key_t *key_p)
 {
-    int len;
-    int tmp_len;
     mpl_param_descr_set_t *param_descr_p;
-    const char *field_str_p = NULL;
-    char tag_str[5];
-    char *child_str_p = NULL;
     mpl_param_element_id_t field_param_id;
     mpl_param_descr_set_t *context_param_descr_p;
+    const mpl_param_descr2_t *context_descr2_p;
+    const mpl_field_value_t *field_value_p = NULL;
+    const mpl_rendered_key_t *rendered_key_p;
     bool no_pfx = options_p->no_prefix;
     bool fm_ctxt = false;
     int child_idx = -1;
+    int offset;
     mpl_param_element_id_t outer_param_id;
     mpl_param_descr_set_t *outer_param_descr_p;
+    const mpl_paramset_index_t *index_p;
 
     if (NULL == element_p) {
         MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("element_p is NULL\n"));
@@ -535,14 +1049,12 @@ int
         return (-1);
     }
 
-    if (element_p->tag > 0)
-    {
-        sprintf(tag_str, "[%d]", element_p->tag);
-    }
-    else
-    {
-        tag_str[0] = 0;
-    }
+    key_p->param_descr_p = param_descr_p;
+    key_p->field_p = NULL;
+    key_p->child_prefix_p = NULL;
+    key_p->child_name_p = NULL;
+
+    key_p->tag_len = render_tag(key_p->tag_str, element_p->tag);
 
     if (element_p->context != MPL_PARAM_ID_UNDEFINED) {
         context_param_descr_p = paramset_find(MPL_PARAMID_TO_PARAMSET(element_p->context),
@@ -561,20 +1073,22 @@ int
             set_errno(E_MPL_INVALID_PARAMETER);
             return (-1);
         }
-        field_param_id = get_field_paramid(element_p->context,
-                                           element_p->id_in_context,
-                                           context_param_descr_p);
-        if (field_param_id == MPL_PARAM_ID_UNDEFINED)
+        context_descr2_p =
+            &context_param_descr_p->array2[PARAMID_TO_INDEX(element_p->context)];
+        field_value_p = get_field_from_id(element_p->id_in_context,
+                                          context_descr2_p->field_values,
+                                          context_descr2_p->field_values_size);
+        if ((NULL == field_value_p) ||
+            (field_value_p->param_id == MPL_PARAM_ID_UNDEFINED))
         {
             MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Illegal id in context: %d\n",
                                                          element_p->id_in_context));
             set_errno(E_MPL_INVALID_PARAMETER);
             return (-1);
         }
-        field_str_p = get_field_name(element_p->context,
-                                     element_p->id_in_context,
-                                     context_param_descr_p);
-        assert(field_str_p != NULL);
+        field_param_id = field_value_p->param_id;
+        key_p->field_p = field_value_p->name_p;
+        assert(key_p->field_p != NULL);
 
         outer_param_descr_p = context_param_descr_p;
         outer_param_id = element_p->context;
@@ -597,40 +1111,13 @@ int
                 set_errno(E_MPL_INVALID_PARAMETER);
                 return (-1);
             }
-            else {
-                mpl_param_element_t *tmp_p;
-                mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
-                tmp_p = mpl_param_element_create_empty_tag(element_p->id,
-                                                           0);
-                if (tmp_p == NULL)
-                    return -1;
-                if (MPL_PARAMID_TO_PARAMSET(element_p->id) ==
-                    MPL_PARAMID_TO_PARAMSET(element_p->context)) {
-                    options.no_prefix = true;
-                }
-                len = mpl_param_pack_internal(tmp_p, NULL, 0, &options);
-                if (len < 0) {
-                    mpl_param_element_destroy(tmp_p);
-                    return -1;
-                }
-                child_str_p = calloc(1, len+1);
-                if (child_str_p == NULL) {
-                    MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                                        ("Failed allocating memory\n"));
-                    set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-                    mpl_param_element_destroy(tmp_p);
-                    return -1;
-                }
-                if (mpl_param_pack_internal(tmp_p,
-                                            child_str_p,
-                                            len+1,
-                                            &options) != len) {
-                    mpl_param_element_destroy(tmp_p);
-                    free(child_str_p);
-                    return -1;
-                }
-                mpl_param_element_destroy(tmp_p);
-            }
+            /* The child is packed as its own id, without prefix if it
+               is in the parameter set of the context */
+            if (MPL_PARAMID_TO_PARAMSET(element_p->id) !=
+                MPL_PARAMID_TO_PARAMSET(element_p->context))
+                key_p->child_prefix_p = param_descr_p->paramid_prefix;
+            key_p->child_name_p =
+                param_descr_p->array[PARAMID_TO_INDEX(element_p->id)].name;
         }
     }
     else {
@@ -638,25 +1125,151 @@ int
         outer_param_id = element_p->id;
     }
 
-    len = snprintf(buf, buflen, "%s%s%s%s%s%s%s%s%s",
-                   (fm_ctxt || no_pfx) ? "" : outer_param_descr_p->paramid_prefix,
-                   (fm_ctxt || no_pfx) ? "" : ".",
-                   fm_ctxt ? "" : outer_param_descr_p->array[PARAMID_TO_INDEX(outer_param_id)].name,
-                   fm_ctxt ? "" : field_str_p != NULL ? "%" : "",
-                   field_str_p != NULL ? field_str_p : "",
-                   child_str_p ? "(" : "",
-                   child_str_p ? child_str_p : "",
-                   child_str_p ? ")" : "",
-                   tag_str);
-    if (child_str_p)
-        free(child_str_p);
+    index_p = outer_param_descr_p->index_p;
+    assert(NULL != index_p);
+    if (NULL != field_value_p)
+    {
+        rendered_key_p =
+            &index_p->field_keys[PARAMID_TO_INDEX(outer_param_id)]
+            [field_value_p - context_descr2_p->field_values];
+    }
+    else
+        rendered_key_p = &index_p->keys[PARAMID_TO_INDEX(outer_param_id)];
+
+    if (fm_ctxt)
+        offset = rendered_key_p->field_offset;
+    else if (no_pfx)
+        offset = index_p->name_offset;
+    else
+        offset = 0;
+    key_p->key_p = rendered_key_p->text_p + offset;
+    key_p->key_len = rendered_key_p->len - offset;
+    return 0;
+}
 
-    if (len < 0)
+/**
+ * render_tag()
+ *
+ * Same as sprintf(tag_str, "[%d]", tag), or "" if tag is 0.
+ **/
+static int render_tag(char *tag_str, int tag)
+{
+    char tmp[12];
+    char *p = tmp + sizeof(tmp);
+    int len;
+
+    if (tag <= 0)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,("snprintf failed\n"));
-        set_errno(E_MPL_FAILED_OPERATION);
-        return (len);
+        tag_str[0] = '\0';
+        return 0;
+    }
+
+    *--p = ']';
+    do
+    {
+        *--p = (char)('0' + (tag % 10));
+        tag /= 10;
+    } while (tag > 0);
+    *--p = '[';
+
+    len = (int)(tmp + sizeof(tmp) - p);
+    memcpy(tag_str, p, len);
+    tag_str[len] = '\0';
+    return len;
+}
+
+/**
+ * pack_key()
+ *
+ * Pack the id of an element: [prefix.][name][%field][([prefix.]child)][tag]
+ * Truncates and returns the length like snprintf().
+ **/
+static int pack_key(char *buf, size_t buflen, const mpl_pack_key_t *key_p)
+{
+    size_t len = key_p->key_len;
+
+    /* The common case, not a child and room for all of it */
+    if ((NULL == key_p->child_name_p) && (len + key_p->tag_len < buflen))
+    {
+        memcpy(buf, key_p->key_p, len);
+        memcpy(buf + len, key_p->tag_str, key_p->tag_len + 1);
+        return (int)(len + key_p->tag_len);
+    }
+
+    len = pack_key_put(buf, buflen, 0, key_p->key_p, len);
+    if (NULL != key_p->child_name_p)
+    {
+        len = pack_key_put(buf, buflen, len, "(", 1);
+        if (NULL != key_p->child_prefix_p)
+        {
+            len = pack_key_put(buf, buflen, len,
+                               key_p->child_prefix_p,
+                               strlen(key_p->child_prefix_p));
+            len = pack_key_put(buf, buflen, len, ".", 1);
+        }
+        len = pack_key_put(buf, buflen, len,
+                           key_p->child_name_p,
+                           strlen(key_p->child_name_p));
+        len = pack_key_put(buf, buflen, len, ")", 1);
     }
+    len = pack_key_put(buf, buflen, len, key_p->tag_str, key_p->tag_len);
+    return (int)len;
+}
+
+/**
+ * pack_key_put()
+ *
+ * Put len characters at pos of buf, as many as fit. Returns pos + len.
+ **/
+static size_t pack_key_put(char *buf,
+                           size_t buflen,
+                           size_t pos,
+                           const char *text_p,
+                           size_t len)
+{
+    if (pos < buflen)
+        (void)pack_text(buf + pos, buflen - pos, text_p, len);
+    return pos + len;
+}
+
+/**
+ * pack_key_len()
+ *
+ * What pack_key() returns, without formatting.
+ **/
+static int pack_key_len(const mpl_pack_key_t *key_p)
+{
+    size_t len = key_p->key_len + key_p->tag_len;
+
+    if (key_p->child_prefix_p)
+        len += strlen(key_p->child_prefix_p) + 1;
+    if (key_p->child_name_p)
+        len += strlen(key_p->child_name_p) + 2;
+    return (int)len;
+}
+
+/**
+ * mpl_param_pack - pack a parameter to be sent to psccd (PS Connection
+ *                          Control Daemon)
+ */
+int
+    mpl_param_pack_internal(const mpl_param_element_t* element_p,
+                            char *buf,
+                            size_t buflen,
+                            const mpl_pack_options_t *options_p)
+{
+    int len;
+    int tmp_len;
+    mpl_pack_key_t key;
+    mpl_param_descr_set_t *param_descr_p;
+
+    if (pack_key_resolve(element_p, options_p, &key) < 0)
+        return (-1);
+    param_descr_p = key.param_descr_p;
+
+    len = pack_key(buf, buflen, &key);
+    if (len < 0)
+        return (len);
 
     /* We also accept no value (used by e.g. 'get' command) */
     if (NULL == element_p->value_p)
@@ -686,8 +1299,8 @@ int
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
                             ("Param value pack failed for %s%s%s\n",
                              mpl_param_id_get_string(element_p->id),
-                             field_str_p != NULL ? "%" : "",
-                             field_str_p != NULL ? field_str_p : ""
+                             key.field_p != NULL ? "%" : "",
+                             key.field_p != NULL ? key.field_p : ""
                             ));
         return (tmp_len);
     }
@@ -697,6 +1310,56 @@ int
     return (len);
 }
 
+/**
+ * mpl_param_packed_size()
+ **/
+int mpl_param_packed_size(const mpl_param_element_t* element_p)
+{
+    mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
+    options.no_prefix = false;
+    return mpl_param_packed_size_internal(element_p, &options);
+}
+
+/**
+ * mpl_param_packed_size_internal()
+ **/
+int mpl_param_packed_size_internal(const mpl_param_element_t* element_p,
+                                   const mpl_pack_options_t *options_p)
+{
+    int len;
+    int tmp_len;
+    mpl_pack_key_t key;
+    const mpl_param_descr_t *descr_p;
+    mpl_packed_size_param_fp packed_size_func;
+
+    if (pack_key_resolve(element_p, options_p, &key) < 0)
+        return (-1);
+
+    len = pack_key_len(&key);
+
+    /* We also accept no value (used by e.g. 'get' command) */
+    if (NULL == element_p->value_p)
+        return (len);
+
+    descr_p = &key.param_descr_p->array[PARAMID_TO_INDEX(element_p->id)];
+    packed_size_func = get_packed_size_func(descr_p);
+    if (NULL != packed_size_func)
+        tmp_len = (*packed_size_func)(element_p->value_p,
+                                      &key.param_descr_p->array2[PARAMID_TO_INDEX(element_p->id)],
+                                      options_p);
+    else
+        /* Unknown type, measure by packing */
+        tmp_len = (*descr_p->pack_func)(element_p->value_p,
+                                        NULL,
+                                        0,
+                                        &key.param_descr_p->array2[PARAMID_TO_INDEX(element_p->id)],
+                                        options_p);
+    if (tmp_len < 0)
+        return (tmp_len);
+
+    return (len + tmp_len);
+}
+
 
 int
     mpl_param_unpack(const char* id_str,
@@ -736,22 +1399,8 @@ int
                               const mpl_pack_options_t *options_p,
                               mpl_param_element_id_t unpack_context)
 {
-    int id, res;
     mpl_param_element_t* tmp_p;
-    mpl_param_descr_set_t *param_descr_p = NULL;
-    mpl_list_t *elem_p;
-    int prefix_len;
-    int size;
-    int tag = 0;
-    const char *name_str = NULL;
-    size_t name_strlen = 0;
-    const char *field_str = NULL;
-    size_t field_strlen = 0;
-    const char *child_str = NULL;
-    size_t child_strlen = 0;
-    const char *tag_str = NULL;
-    size_t tag_strlen = 0;
-    mpl_param_element_id_t child_id = MPL_PARAM_ID_UNDEFINED;
+    int res;
 
     if (NULL == element_pp)
     {
@@ -760,22 +1409,51 @@ int
         return (-1);
     }
 
-    (void)mpl_mutex_lock(mutex);
-    MPL_LIST_FOR_EACH(paramset_list_p, elem_p)
-    {
-        param_descr_p = MPL_LIST_CONTAINER(elem_p,
-                                           mpl_paramset_container_t,
-                                           list_entry)->paramset_p;
-        prefix_len = strlen(param_descr_p->paramid_prefix);
-        if (!strncmp(param_descr_p->paramid_prefix, id_str, prefix_len) &&
-            ('.' == id_str[prefix_len]))
+    if (param_unpack_key(id_str, options_p, unpack_context, &tmp_p) < 0)
+        return (-1);
+
+    /* We also accept no value (used by 'get' command) */
+    if (NULL != value_str)
+    {
+        res = param_unpack_value(tmp_p, id_str, value_str, options_p);
+        if (res < 0)
         {
-            id_str += (prefix_len + 1);
-            break;
+            mpl_param_element_destroy(tmp_p);
+            return (res);
         }
-        param_descr_p = NULL;
     }
-    (void)mpl_mutex_unlock(mutex);
+
+    *element_pp = tmp_p;
+    return (0);
+}
+
+/**
+ * param_unpack_key()
+ *
+ * Create an element, without value, from a packed parameter id.
+ **/
+static int param_unpack_key(const char* id_str,
+                            const mpl_pack_options_t *options_p,
+                            mpl_param_element_id_t unpack_context,
+                            mpl_param_element_t** element_pp)
+{
+    int id;
+    mpl_param_element_t* tmp_p;
+    mpl_param_descr_set_t *param_descr_p = NULL;
+    int tag = 0;
+    const char *name_str = NULL;
+    size_t name_strlen = 0;
+    const char *field_str = NULL;
+    size_t field_strlen = 0;
+    const char *child_str = NULL;
+    size_t child_strlen = 0;
+    const char *tag_str = NULL;
+    size_t tag_strlen = 0;
+    mpl_param_element_id_t child_id = MPL_PARAM_ID_UNDEFINED;
+
+    param_descr_p = paramset_find_prefix(id_str);
+    if (NULL != param_descr_p)
+        id_str += (strlen(param_descr_p->paramid_prefix) + 1);
 
     if (NULL == param_descr_p)
     {
@@ -835,8 +1513,8 @@ int
             field_strlen = strlen(field_str);
         if (get_field_from_name(field_str,
                                 field_strlen,
-                                param_descr_p->array2[PARAMID_TO_INDEX(unpack_context)].field_values,
-                                param_descr_p->array2[PARAMID_TO_INDEX(unpack_context)].field_values_size
+                                param_descr_p,
+                                PARAMID_TO_INDEX(unpack_context)
                                ) == NULL) {
             /* Not recognized as a field in the context, back off to normal type decoding */
             field_str = NULL;
@@ -903,119 +1581,116 @@ int
         mpl_param_element_destroy(child_elem_p);
     }
 
-    size = PARAM_SET_SIZE(param_descr_p);
-
-    for (id=0; id < size; id++)
+    id = paramset_name_lookup(param_descr_p, name_str, name_strlen);
+    if (id >= 0)
     {
         int field_id = -1;
         int eff_param_id;
-        mpl_param_descr_set_t *eff_param_descr_p;
-        char *p;
-        const char *n;
-        int i;
-        int found;
-        
-        p = param_descr_p->array[id].name;
-        n = name_str;
-        found = 0;
-        i = 0;
-        do {
-            if (*p != *n)
-                break;
-            p++;
-            if ((++i == name_strlen) && !*p) {
-                found = 1;
-                break;
-            }
-            n++;
-        } while (*p && (i < name_strlen));
 
-        if (found)
+        if (field_strlen != 0)
         {
-            if (field_strlen != 0)
+            const mpl_field_value_t *field_value_p;
+            field_value_p = get_field_from_name(field_str,
+                                                field_strlen,
+                                                param_descr_p,
+                                                id
+                                               );
+            if (field_value_p == NULL)
             {
-                const mpl_field_value_t *field_value_p;
-                field_value_p = get_field_from_name(field_str,
-                                                    field_strlen,
-                                                    param_descr_p->array2[id].field_values,
-                                                    param_descr_p->array2[id].field_values_size
-                                                   );
-                if (field_value_p == NULL)
-                {
-                    MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
-                                        ("Invalid field: %s\n", field_str));
+                MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                                    ("Invalid field: %s\n", field_str));
+                set_errno(E_MPL_INVALID_PARAMETER);
+                return (-1);
+            }
+            if (child_id != MPL_PARAM_ID_UNDEFINED) {
+                if (mpl_param_get_child_index(field_value_p->param_id, child_id) < 0) {
+                    MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Param '%s.%s' is not child of '%s.%s'\n",
+                                                                 mpl_param_id_get_prefix(child_id),
+                                                                 mpl_param_id_get_string(child_id),
+                                                                 mpl_param_id_get_prefix(field_value_p->param_id),
+                                                                 mpl_param_id_get_string(field_value_p->param_id)));
                     set_errno(E_MPL_INVALID_PARAMETER);
                     return (-1);
                 }
-                if (child_id != MPL_PARAM_ID_UNDEFINED) {
-                    if (mpl_param_get_child_index(field_value_p->param_id, child_id) < 0) {
-                        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Param '%s.%s' is not child of '%s.%s'\n",
-                                                                     mpl_param_id_get_prefix(child_id),
-                                                                     mpl_param_id_get_string(child_id),
-                                                                     mpl_param_id_get_prefix(field_value_p->param_id),
-                                                                     mpl_param_id_get_string(field_value_p->param_id)));
-                        set_errno(E_MPL_INVALID_PARAMETER);
-                        return (-1);
-                    }
-                    eff_param_id = child_id;
-                }
-                else {
-                    eff_param_id = field_value_p->param_id;
-                }
-                field_id = field_value_p->field_id;
+                eff_param_id = child_id;
             }
-            else
-                eff_param_id = INDEX_TO_PARAMID(id, param_descr_p);
+            else {
+                eff_param_id = field_value_p->param_id;
+            }
+            field_id = field_value_p->field_id;
+        }
+        else
+            eff_param_id = INDEX_TO_PARAMID(id, param_descr_p);
 
-            eff_param_descr_p = paramset_find(MPL_PARAMID_TO_PARAMSET(eff_param_id),
-                                              NULL);
-            assert(eff_param_descr_p);
+        assert(paramset_find(MPL_PARAMID_TO_PARAMSET(eff_param_id), NULL));
 
-            tmp_p =
-                mpl_param_element_create_empty_tag(eff_param_id, tag);
-            if (NULL == tmp_p)
-            {
-                return (-1);
-            }
+        tmp_p =
+            mpl_param_element_create_empty_tag(eff_param_id, tag);
+        if (NULL == tmp_p)
+        {
+            return (-1);
+        }
 
-            if (field_id >= 0) {
-                tmp_p->context = get_field_context_paramid(INDEX_TO_PARAMID(id, param_descr_p),
-                                                           field_id,
-                                                           param_descr_p);
-                tmp_p->id_in_context = field_id;
-            }
+        if (field_id >= 0) {
+            tmp_p->context = get_field_context_paramid(INDEX_TO_PARAMID(id, param_descr_p),
+                                                       field_id,
+                                                       param_descr_p);
+            tmp_p->id_in_context = field_id;
+        }
 
-            /* We also accept no value (used by 'get' command) */
-            if (NULL == value_str)
-            {
-                *element_pp = tmp_p;
-                return (0);
-            }
+        *element_pp = tmp_p;
+        return (0);
+    }
+
+    return (-1);
+}
 
-            assert(NULL != eff_param_descr_p->array[PARAMID_TO_INDEX(eff_param_id)].unpack_func);
+/**
+ * param_unpack_value()
+ *
+ * Unpack the value of an element created by param_unpack_key().
+ **/
+static int param_unpack_value(mpl_param_element_t* element_p,
+                              const char* id_str,
+                              const char* value_str,
+                              const mpl_pack_options_t *options_p)
+{
+    mpl_param_descr_set_t *param_descr_p;
+    const mpl_param_descr_t *descr_p;
+    int res;
 
-            res = (*eff_param_descr_p->array[PARAMID_TO_INDEX(eff_param_id)].unpack_func)
-                  (value_str,
-                   &tmp_p->value_p,
-                   &eff_param_descr_p->array2[PARAMID_TO_INDEX(eff_param_id)],
-                   options_p,
-                   eff_param_id);
+    param_descr_p = paramset_find(MPL_PARAMID_TO_PARAMSET(element_p->id), NULL);
+    assert(param_descr_p);
+    descr_p = &param_descr_p->array[PARAMID_TO_INDEX(element_p->id)];
 
-            if (res < 0)
-            {
-                mpl_param_element_destroy(tmp_p);
-                MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                                    ("Param value unpack failed for %s=%s\n",
-                                     id_str, value_str));
-                return (res);
-            }
+    assert(NULL != descr_p->unpack_func);
 
-            *element_pp = tmp_p;
-            return (0);
-        }
+    res = (*descr_p->unpack_func)
+          (value_str,
+           &element_p->value_p,
+           &param_descr_p->array2[PARAMID_TO_INDEX(element_p->id)],
+           options_p,
+           element_p->id);
+
+    if (res < 0)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Param value unpack failed for %s=%s\n",
+                             id_str, value_str));
+        return (res);
     }
 
-    return (-1);
+    element_p->value_is_flat = DESCR_VALUE_IS_FLAT(descr_p);
+
+    /* The string unpack returns value_str itself for a view */
+    if (options_p->string_views &&
+        (descr_p->type == mpl_type_string) &&
+        (element_p->value_p == (void*)value_str))
+    {
+        element_p->value_is_view = true;
+    }
+
+    return (0);
 }
 
 /**
@@ -1457,3005 +2132,3544 @@ int
 }
 
 /**
- * mpl_param_allow_get_bl
+ * mpl_param_value_lookup
+ *
+ * Find the parameter set of a parameter id, NULL if the id is not valid.
  */
-bool
-    mpl_param_allow_get_bl(mpl_param_element_id_t param_id,
-                           mpl_blacklist_t blacklist)
+static mpl_param_descr_set_t *mpl_param_value_lookup(mpl_param_element_id_t param_id)
 {
     mpl_param_descr_set_t *param_descr_p;
 
     param_descr_p = paramset_find(MPL_PARAMID_TO_PARAMSET(param_id), NULL);
-
-    if (NULL == param_descr_p) {
-        // [DOC] The specified MPL parameter has an unrecognized parameter set
+    if (NULL == param_descr_p)
+    {
         MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Parameter set is NULL\n"));
         set_errno(E_MPL_INVALID_PARAMETER);
-        return false;
+        return NULL;
     }
 
     if (!PARAMID_OK(param_id, param_descr_p))
     {
         MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Unknown parameter id\n"));
         set_errno(E_MPL_INVALID_PARAMETER);
-        return false;
+        return NULL;
     }
+    return param_descr_p;
+}
 
-    /* Is the parameter in the blacklist? */
-    if (mpl_param_list_find(param_id, blacklist))
-        return false;
+/**
+ * mpl_param_value_pack
+ *
+ */
+int mpl_param_value_pack(mpl_param_element_id_t param_id,
+                         const void *value_p,
+                         char *buf,
+                         size_t buflen)
+{
+    mpl_param_descr_set_t *param_descr_p;
+    mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
 
-    return param_descr_p->array[PARAMID_TO_INDEX(param_id)].allow_get;
+    param_descr_p = mpl_param_value_lookup(param_id);
+    if ((NULL == param_descr_p) || (NULL == value_p))
+        return (-1);
+
+    return (*param_descr_p->array[PARAMID_TO_INDEX(param_id)].pack_func)
+        (value_p,
+         buf,
+         buflen,
+         &param_descr_p->array2[PARAMID_TO_INDEX(param_id)],
+         &options);
 }
 
 /**
- * mpl_param_allow_set_bl
+ * mpl_param_value_unpack
+ *
  */
-bool
-    mpl_param_allow_set_bl(mpl_param_element_id_t param_id,
-                           mpl_blacklist_t blacklist)
+int mpl_param_value_unpack(mpl_param_element_id_t param_id,
+                           const char *value_str,
+                           void **value_pp)
 {
     mpl_param_descr_set_t *param_descr_p;
+    mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
 
-    param_descr_p = paramset_find(MPL_PARAMID_TO_PARAMSET(param_id), NULL);
-
-    if (NULL == param_descr_p) {
-        // [DOC] The specified MPL parameter has an unrecognized parameter set
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,("Parameter set is NULL\n"));
-        return false;
-    }
+    param_descr_p = mpl_param_value_lookup(param_id);
+    if ((NULL == param_descr_p) || (NULL == value_str) || (NULL == value_pp))
+        return (-1);
 
-    if (!PARAMID_OK(param_id, param_descr_p))
+    if ((*param_descr_p->array[PARAMID_TO_INDEX(param_id)].unpack_func)
+        (value_str,
+         value_pp,
+         &param_descr_p->array2[PARAMID_TO_INDEX(param_id)],
+         &options,
+         MPL_PARAM_ID_UNDEFINED) < 0)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Unknown parameter id\n"));
-        set_errno(E_MPL_INVALID_PARAMETER);
-        return false;
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Param value unpack failed for %s=%s\n",
+                             param_descr_p->array[PARAMID_TO_INDEX(param_id)].name,
+                             value_str));
+        return (-1);
     }
-
-    /* Is the parameter in the blacklist? */
-    if (mpl_param_list_find(param_id, blacklist))
-        return false;
-
-    return param_descr_p->array[PARAMID_TO_INDEX(param_id)].allow_set;
+    return (0);
 }
 
 /**
- * mpl_param_allow_config_bl
+ * mpl_param_value_unpack_to
+ *
  */
-bool
-    mpl_param_allow_config_bl(mpl_param_element_id_t param_id,
-                              mpl_blacklist_t blacklist)
+int mpl_param_value_unpack_to(mpl_param_element_id_t param_id,
+                              const char *value_str,
+                              void *to_p,
+                              int size)
 {
     mpl_param_descr_set_t *param_descr_p;
+    void *value_p = NULL;
+    int len;
 
-    param_descr_p = paramset_find(MPL_PARAMID_TO_PARAMSET(param_id), NULL);
+    if (mpl_param_value_unpack(param_id, value_str, &value_p) < 0)
+        return (-1);
 
-    if (NULL == param_descr_p) {
-        // [DOC] The specified MPL parameter has an unrecognized parameter set
-        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
-                            ("Parameter set is NULL, param_id=%x\n",
-                             param_id));
-        set_errno(E_MPL_INVALID_PARAMETER);
-        return false;
-    }
+    param_descr_p = paramset_find(MPL_PARAMID_TO_PARAMSET(param_id), NULL);
+    len = (*param_descr_p->array[PARAMID_TO_INDEX(param_id)].copy_func)
+          (to_p,
+           value_p,
+           size,
+           &param_descr_p->array2[PARAMID_TO_INDEX(param_id)]);
+    (*param_descr_p->array[PARAMID_TO_INDEX(param_id)].free_func)(value_p);
 
-    if (!PARAMID_OK(param_id, param_descr_p))
+    if ((len < 0) || (len > size))
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Unknown parameter id\n"));
-        set_errno(E_MPL_INVALID_PARAMETER);
-        return false;
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Param value does not fit: %s=%s\n",
+                             param_descr_p->array[PARAMID_TO_INDEX(param_id)].name,
+                             value_str));
+        set_errno(E_MPL_FAILED_OPERATION);
+        return (-1);
     }
+    return len;
+}
 
-    /* Is the parameter in the blacklist? */
-    if (mpl_param_list_find(param_id, blacklist))
-        return false;
+/**
+ * mpl_param_value_free
+ *
+ */
+void mpl_param_value_free(mpl_param_element_id_t param_id, void *value_p)
+{
+    mpl_param_descr_set_t *param_descr_p;
 
-    return param_descr_p->array[PARAMID_TO_INDEX(param_id)].allow_config;
+    if (NULL == value_p)
+        return;
+
+    param_descr_p = mpl_param_value_lookup(param_id);
+    if (NULL == param_descr_p)
+        return;
+
+    (*param_descr_p->array[PARAMID_TO_INDEX(param_id)].free_func)(value_p);
 }
 
 /**
- * mpl_param_element_create_stringn_tag
+ * mpl_param_struct_pack_name
  *
  */
-mpl_param_element_t*
-    mpl_param_element_create_stringn_tag(mpl_param_element_id_t param_id,
-                                         int tag,
-                                         const char* value,
-                                         size_t len)
+int mpl_param_struct_pack_name(char *buf,
+                               size_t buflen,
+                               bool first,
+                               const char *field_name_p,
+                               int tag)
 {
-    mpl_param_element_t* element_p;
-    size_t size;
+    if (tag > 0)
+        return snprintf(buf, buflen, "%s%s[%d]",
+                        first ? "" : ",", field_name_p, tag);
+    return snprintf(buf, buflen, "%s%s", first ? "" : ",", field_name_p);
+}
 
-    size = len + 1;
+/**
+ * mpl_param_struct_value
+ *
+ */
+const char *mpl_param_struct_value(const char *str,
+                                   const char *prefix_p,
+                                   const char *name_p)
+{
+    const char *value_p;
+    const char *key_p = str;
+    size_t prefix_len = strlen(prefix_p);
+    size_t name_len = strlen(name_p);
+    size_t len;
+
+    /* An empty bag is packed without value */
+    value_p = strchr(str, '=');
+    if (NULL == value_p)
+        len = strlen(str);
+    else
+        len = value_p - str;
 
-    element_p = mpl_param_element_create_empty_tag(param_id, tag);
-    if (NULL == element_p)
+    /* The prefix is optional, as when unpacking a parameter */
+    if ((len == (prefix_len + 1 + name_len)) &&
+        !strncmp(key_p, prefix_p, prefix_len) &&
+        (key_p[prefix_len] == '.'))
     {
-        return NULL;
+        key_p += prefix_len + 1;
+        len = name_len;
     }
 
-    element_p->value_p = malloc(size);
-    if (NULL == element_p->value_p)
+    if ((len != name_len) || strncmp(key_p, name_p, name_len))
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        mpl_param_element_destroy(element_p);
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                            ("Not a %s.%s: %s\n", prefix_p, name_p, str));
+        set_errno(E_MPL_INVALID_PARAMETER);
         return NULL;
     }
+    return (NULL != value_p) ? value_p + 1 : "";
+}
 
-    strncpy((char*)element_p->value_p, value, len);
+typedef struct
+{
+    int tag;
+    int index;
+} struct_arg_order_t;
 
-    // add null termination
-    ((char*)element_p->value_p)[len] = 0;
+static int struct_arg_tag(const char *key_p)
+{
+    const char *open_p = strchr(key_p, '[');
 
-    return (element_p);
+    /* Invalid tags are found later, by mpl_param_struct_key_tag() */
+    return (NULL != open_p) ? atoi(open_p + 1) : 0;
+}
+
+static int struct_arg_order_compare(const void *a_p, const void *b_p)
+{
+    const struct_arg_order_t *a = a_p;
+    const struct_arg_order_t *b = b_p;
+
+    if (a->tag != b->tag)
+        return (a->tag < b->tag) ? -1 : 1;
+    return a->index - b->index;
 }
 
 /**
- * mpl_param_element_create_wstringn_tag
+ * struct_args_sort
  *
+ * Sort fields by tag (keeping the order of fields with the same tag), so
+ * that the elements of a multiple field come in tag order. Lists built
+ * with the add macros are packed with the last added element first.
  */
-mpl_param_element_t*
-    mpl_param_element_create_wstringn_tag(mpl_param_element_id_t param_id,
-                                          int tag,
-                                          const wchar_t* value,
-                                          size_t len)
+static int struct_args_sort(mpl_arg_t *args_p, int numargs)
 {
-    mpl_param_element_t* element_p;
-    size_t size;
-
-    size = len + 1;
+    struct_arg_order_t *order_p;
+    mpl_arg_t *sorted_p;
+    int prev_tag = 0;
+    int tag;
+    int i;
 
-    element_p = mpl_param_element_create_empty_tag(param_id, tag);
-    if (NULL == element_p)
+    for (i = 0; i < numargs; i++)
     {
-        return NULL;
+        tag = struct_arg_tag(args_p[i].key_p);
+        if ((tag != 0) && (tag < prev_tag))
+            break;
+        if (tag != 0)
+            prev_tag = tag;
     }
+    if (i == numargs)
+        return 0;
 
-    element_p->value_p = malloc(size * sizeof(L'\0'));
-    if (NULL == element_p->value_p)
+    order_p = heap_malloc(numargs * sizeof(struct_arg_order_t));
+    sorted_p = heap_malloc(numargs * sizeof(mpl_arg_t));
+    if ((NULL == order_p) || (NULL == sorted_p))
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
                             ("Failed allocating memory\n"));
         set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        mpl_param_element_destroy(element_p);
-        return NULL;
+        heap_free(order_p);
+        heap_free(sorted_p);
+        return (-1);
     }
 
-    (void)wcsncpy((wchar_t*)element_p->value_p, value, size);
+    for (i = 0; i < numargs; i++)
+    {
+        order_p[i].tag = struct_arg_tag(args_p[i].key_p);
+        order_p[i].index = i;
+    }
+    qsort(order_p, numargs, sizeof(struct_arg_order_t), struct_arg_order_compare);
+    for (i = 0; i < numargs; i++)
+        sorted_p[i] = args_p[order_p[i].index];
+    memcpy(args_p, sorted_p, numargs * sizeof(mpl_arg_t));
 
-    // add null termination
-    ((wchar_t*)element_p->value_p)[len] = L'\0';
-
-    return (element_p);
-}
+    heap_free(order_p);
+    heap_free(sorted_p);
+    return 0;
+}
 
 /**
- * mpl_param_element_create_empty_tag
+ * mpl_param_struct_split
  *
  */
-mpl_param_element_t*
-    mpl_param_element_create_empty_tag(mpl_param_element_id_t param_id, int tag)
+int mpl_param_struct_split(const char *value_str,
+                           char **copy_pp,
+                           mpl_arg_t **args_pp)
 {
-    mpl_param_element_t* element_p;
-    mpl_param_descr_set_t *param_descr_p;
+    char *start_p;
+    char *end_p = NULL;
+    char *copy_p;
+    int numargs;
 
-    if (MPL_PARAMID_IS_VIRTUAL(param_id))
+    *copy_pp = NULL;
+    *args_pp = NULL;
+
+    /* Empty bag (packed without value) */
+    if (*value_str == '\0')
+        return 0;
+
+    start_p = strchr((char*)value_str, '{');
+    if (start_p != NULL)
+        end_p = get_matching_close_bracket('{', '}', start_p, '\\');
+    if ((start_p == NULL) || (end_p == NULL))
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Parameter is VIRTUAL\n"));
-        set_errno(E_MPL_INVALID_PARAMETER);
-        return NULL;
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack struct failed, no delimiter: %s\n",
+                             value_str));
+        set_errno(E_MPL_FAILED_OPERATION);
+        return (-1);
     }
+    start_p++;
 
-    param_descr_p = paramset_find(MPL_PARAMID_TO_PARAMSET(param_id), NULL);
+    /* Only the caller sees this memory, so not from the arena */
+    copy_p = heap_malloc((end_p - start_p) + 1);
+    if (copy_p == NULL)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return (-1);
+    }
+    memcpy(copy_p, start_p, end_p - start_p);
+    copy_p[end_p - start_p] = '\0';
 
-    if (NULL == param_descr_p) {
-        // [DOC] The specified MPL parameter has an unrecognized parameter set
-        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Parameter set is NULL\n"));
-        set_errno(E_MPL_INVALID_PARAMETER);
-        return NULL;
+    numargs = mpl_get_args_2(args_pp, 0, copy_p, '=', ',', '\\');
+    if (numargs < 0)
+    {
+        heap_free(copy_p);
+        return (-1);
     }
 
-    if (!PARAMID_OK(param_id, param_descr_p))
+    if (struct_args_sort(*args_pp, numargs) < 0)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
-                            ("Unknown parameter ID: %x\n", param_id));
-        set_errno(E_MPL_INVALID_PARAMETER);
-        return (NULL);
+        heap_free(*args_pp);
+        *args_pp = NULL;
+        heap_free(copy_p);
+        return (-1);
     }
 
-    if ((tag < 0) || (tag >= MPL_MAX_ARGS))
+    *copy_pp = copy_p;
+    return numargs;
+}
+
+/**
+ * mpl_param_struct_grow
+ *
+ */
+int mpl_param_struct_grow(void **array_pp, int count, size_t elem_size)
+{
+    void *new_p;
+    int new_len;
+
+    /* The array is full when count is 0 or a power of two */
+    if ((count & (count - 1)) != 0)
+        return 0;
+
+    new_len = (count > 0) ? (2 * count) : 4;
+    if ((size_t)new_len > ((size_t)-1 / elem_size))
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
-                            ("Illegal tag value: %d\n", tag));
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Array too large\n"));
         set_errno(E_MPL_INVALID_PARAMETER);
-        return (NULL);
+        return (-1);
     }
 
-    element_p = calloc(1, sizeof(mpl_param_element_t));
-    if (NULL == element_p)
+    /* Owned by the caller, so not from the arena */
+    new_p = heap_realloc(*array_pp, new_len * elem_size);
+    if (NULL == new_p)
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
                             ("Failed allocating memory\n"));
         set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        return NULL;
+        return (-1);
     }
-
-    element_p->id = param_id;
-    element_p->tag = tag;
-    element_p->value_p = NULL;
-    element_p->list_entry.next_p = NULL;
-
-    return (element_p);
+    *array_pp = new_p;
+    return 0;
 }
 
 /**
- * mpl_param_element_create_n_tag
+ * mpl_param_struct_key_tag
  *
  */
-mpl_param_element_t*
-    mpl_param_element_create_n_tag(mpl_param_element_id_t param_id,
-                                   int tag,
-                                   const void* value_p,
-                                   size_t len)
+int mpl_param_struct_key_tag(char *key_p)
 {
-    mpl_param_descr_set_t *param_descr_p;
-    size_t size;
+    char *open_p;
+    char *end_p;
+    long tag;
 
-    param_descr_p = paramset_find(MPL_PARAMID_TO_PARAMSET(param_id), NULL);
+    open_p = strchr(key_p, '[');
+    if (NULL == open_p)
+        return 0;
 
-    if (NULL == param_descr_p)
+    tag = strtol(open_p + 1, &end_p, 10);
+    if ((end_p == (open_p + 1)) || (*end_p != ']') || (end_p[1] != '\0') ||
+        (tag < 0) || (tag >= MPL_MAX_ARGS))
     {
-        // [DOC] The specified MPL parameter has an unrecognized parameter set
         MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
-                            ("Parameter set is NULL (paramid=%x)\n", param_id));
+                            ("Invalid tag: %s\n", key_p));
         set_errno(E_MPL_INVALID_PARAMETER);
-        return NULL;
+        return (-1);
     }
 
-    size = (*param_descr_p->array[PARAMID_TO_INDEX(param_id)].sizeof_func)
-           (&param_descr_p->array2[PARAMID_TO_INDEX(param_id)]);
+    *open_p = '\0';
+    return (int)tag;
+}
 
-    if ((size > 0) && (size != len))
+/**
+ * struct_array_type
+ *
+ * Type of an array parameter, mpl_type_invalid (with errno set) if the
+ * parameter is not an array.
+ */
+static mpl_type_t struct_array_type(mpl_param_element_id_t param_id)
+{
+    mpl_param_descr_set_t *param_descr_p;
+    mpl_type_t type;
+
+    param_descr_p = mpl_param_value_lookup(param_id);
+    if (NULL == param_descr_p)
+        return mpl_type_invalid;
+
+    type = param_descr_p->array[PARAMID_TO_INDEX(param_id)].type;
+    if ((type != mpl_type_uint8_array) &&
+        (type != mpl_type_uint16_array) &&
+        (type != mpl_type_uint32_array))
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
-                            ("Param length check failed for %s\n",
-                             mpl_param_id_get_string(param_id)));
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Not an array\n"));
         set_errno(E_MPL_INVALID_PARAMETER);
-        return NULL;
+        return mpl_type_invalid;
     }
-
-    return mpl_param_element_create_tag(param_id, tag, value_p);
+    return type;
 }
 
 /**
- * mpl_param_element_create_uint8_array_tag
+ * mpl_param_struct_pack_array
  *
  */
-mpl_param_element_t*
-    mpl_param_element_create_uint8_array_tag(mpl_param_element_id_t param_id,
-                                             int tag,
-                                             const uint8_t* value, size_t size)
+int mpl_param_struct_pack_array(mpl_param_element_id_t param_id,
+                                const void *arr_p,
+                                int len,
+                                char *buf,
+                                size_t buflen)
 {
-    mpl_param_element_t* element_p;
-    mpl_uint8_array_t *p;
-
-    p = malloc(sizeof(mpl_uint8_array_t));
-    if(NULL == p)
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        return NULL;
-    }
+    mpl_uint8_array_t a8;
+    mpl_uint16_array_t a16;
+    mpl_uint32_array_t a32;
+    const void *value_p;
 
-    p->arr_p = malloc(size * sizeof(uint8_t));
-    if (NULL == p->arr_p)
+    if ((len < 0) || ((len > 0) && (NULL == arr_p)))
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        free(p);
-        return NULL;
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Invalid array\n"));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return (-1);
     }
 
-    element_p = mpl_param_element_create_empty_tag(param_id, tag);
-    if (NULL == element_p)
+    switch (struct_array_type(param_id))
     {
-        free(p->arr_p);
-        free(p);
-        return NULL;
+        case mpl_type_uint8_array:
+            a8.len = len;
+            a8.arr_p = (uint8_t*) arr_p;
+            value_p = &a8;
+            break;
+        case mpl_type_uint16_array:
+            a16.len = len;
+            a16.arr_p = (uint16_t*) arr_p;
+            value_p = &a16;
+            break;
+        case mpl_type_uint32_array:
+            a32.len = (uint32_t) len;
+            a32.arr_p = (uint32_t*) arr_p;
+            value_p = &a32;
+            break;
+        default:
+            return (-1);
     }
 
-    element_p->value_p = p;
-    p->len = size;
-    memcpy(p->arr_p, value, size * sizeof(uint8_t));
-    return (element_p);
+    return mpl_param_value_pack(param_id, value_p, buf, buflen);
 }
 
-
 /**
- * mpl_param_element_create_uint16_array_tag
+ * mpl_param_struct_unpack_array
  *
  */
-mpl_param_element_t*
-    mpl_param_element_create_uint16_array_tag(mpl_param_element_id_t param_id,
-                                              int tag,
-                                              const uint16_t* value, size_t size)
+int mpl_param_struct_unpack_array(mpl_param_element_id_t param_id,
+                                  const char *value_str,
+                                  void *arr_p,
+                                  int max,
+                                  int *len_p)
 {
-    mpl_param_element_t* element_p;
-    mpl_uint16_array_t *p;
+    mpl_type_t type;
+    void *value_p = NULL;
+    const void *from_p;
+    size_t elem_size;
+    int64_t len;
 
-    p = malloc(sizeof(mpl_uint16_array_t));
-    if(NULL == p)
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        return NULL;
-    }
+    type = struct_array_type(param_id);
+    if (type == mpl_type_invalid)
+        return (-1);
 
-    p->arr_p = malloc(size * sizeof(uint16_t));
-    if (NULL == p->arr_p)
+    if (mpl_param_value_unpack(param_id, value_str, &value_p) < 0)
+        return (-1);
+
+    switch (type)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        free(p);
-        return NULL;
+        case mpl_type_uint8_array:
+            len = ((mpl_uint8_array_t*) value_p)->len;
+            from_p = ((mpl_uint8_array_t*) value_p)->arr_p;
+            elem_size = sizeof(uint8_t);
+            break;
+        case mpl_type_uint16_array:
+            len = ((mpl_uint16_array_t*) value_p)->len;
+            from_p = ((mpl_uint16_array_t*) value_p)->arr_p;
+            elem_size = sizeof(uint16_t);
+            break;
+        default:
+            len = ((mpl_uint32_array_t*) value_p)->len;
+            from_p = ((mpl_uint32_array_t*) value_p)->arr_p;
+            elem_size = sizeof(uint32_t);
+            break;
     }
 
-    element_p = mpl_param_element_create_empty_tag(param_id, tag);
-    if (NULL == element_p)
+    if ((len < 0) || (len > max))
     {
-        free(p->arr_p);
-        free(p);
-        return NULL;
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Array does not fit: %s\n", value_str));
+        set_errno(E_MPL_FAILED_OPERATION);
+        mpl_param_value_free(param_id, value_p);
+        return (-1);
     }
 
-    element_p->value_p = p;
-    p->len = size;
-    memcpy(p->arr_p, value, size * sizeof(uint16_t));
-    return (element_p);
+    if (len > 0)
+        memcpy(arr_p, from_p, (size_t) len * elem_size);
+    *len_p = (int) len;
+    mpl_param_value_free(param_id, value_p);
+    return (0);
 }
 
-
 /**
- * mpl_param_element_create_uint32_array_tag
+ * mpl_param_gen_malloc
  *
  */
-mpl_param_element_t*
-    mpl_param_element_create_uint32_array_tag(mpl_param_element_id_t param_id,
-                                              int tag,
-                                              const uint32_t* value, size_t size)
+void *mpl_param_gen_malloc(size_t size)
 {
-    mpl_param_element_t* element_p;
-    mpl_uint32_array_t *p;
-
-    p = malloc(sizeof(mpl_uint32_array_t));
-    if(NULL == p)
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        return NULL;
-    }
-
-    p->arr_p = malloc(size * sizeof(uint32_t));
-    if (NULL == p->arr_p)
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        free(p);
-        return NULL;
-    }
-
-    element_p = mpl_param_element_create_empty_tag(param_id, tag);
-    if (NULL == element_p)
-    {
-        free(p->arr_p);
-        free(p);
-        return NULL;
-    }
+    return malloc(size);
+}
 
-    element_p->value_p = p;
-    p->len = size;
-    memcpy(p->arr_p, value, size * sizeof(uint32_t));
-    return (element_p);
+/**
+ * mpl_param_gen_error
+ *
+ */
+int mpl_param_gen_error(int error_value,
+                        const char *name_p,
+                        const char *value_str)
+{
+    MPL_DBG_TRACE_ERROR(error_value,
+                        ("Parameter %s failed on value: %s\n",
+                         name_p,
+                         (NULL != value_str) ? value_str : "-"));
+    set_errno(error_value);
+    return (-1);
 }
 
+/**
+ * mpl_param_gen_pack_int
+ *
+ */
+int mpl_param_gen_pack_int(char *buf, size_t buflen, int64_t value)
+{
+    return pack_int(buf, buflen, value);
+}
 
 /**
- * mpl_param_element_create_string_tuple_tag
+ * mpl_param_gen_pack_hex
  *
  */
-mpl_param_element_t*
-    mpl_param_element_create_string_tuple_tag(mpl_param_element_id_t param_id,
-                                              int tag,
-                                              const char* key, const char *val)
+int mpl_param_gen_pack_hex(char *buf, size_t buflen, uint64_t value)
 {
-    mpl_param_element_t* element_p;
-    mpl_string_tuple_t *p;
+    return pack_hex(buf, buflen, value);
+}
 
-    p = malloc(sizeof(mpl_string_tuple_t));
-    if(NULL == p)
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        return NULL;
+/**
+ * mpl_param_gen_pack_text
+ *
+ */
+int mpl_param_gen_pack_text(char *buf,
+                            size_t buflen,
+                            const char *text_p,
+                            size_t len)
+{
+    return pack_text(buf, buflen, text_p, len);
+}
+
+/**
+ * mpl_param_gen_int_len
+ *
+ */
+int mpl_param_gen_int_len(int64_t value)
+{
+    return 1 + decimal_width(value);
+}
+
+/**
+ * mpl_param_gen_hex_len
+ *
+ */
+int mpl_param_gen_hex_len(uint64_t value)
+{
+    return 3 + hex_width(value);
+}
+
+/**
+ * mpl_param_gen_convert_int
+ *
+ */
+int mpl_param_gen_convert_int(const char *value_str, int64_t *value_p)
+{
+    return convert_int64(value_str, value_p);
+}
+
+/**
+ * mpl_param_gen_convert_uint
+ *
+ */
+int mpl_param_gen_convert_uint(const char *value_str, uint64_t *value_p)
+{
+    return convert_uint64(value_str, value_p);
+}
+
+/**
+ * mpl_param_allow_get_bl
+ */
+bool
+    mpl_param_allow_get_bl(mpl_param_element_id_t param_id,
+                           mpl_blacklist_t blacklist)
+{
+    mpl_param_descr_set_t *param_descr_p;
+
+    param_descr_p = paramset_find(MPL_PARAMID_TO_PARAMSET(param_id), NULL);
+
+    if (NULL == param_descr_p) {
+        // [DOC] The specified MPL parameter has an unrecognized parameter set
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Parameter set is NULL\n"));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return false;
     }
 
-    p->key_p = malloc(strlen(key) + 1);
-    if (NULL == p->key_p)
+    if (!PARAMID_OK(param_id, param_descr_p))
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        free(p);
-        return NULL;
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Unknown parameter id\n"));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return false;
     }
 
-    p->value_p = malloc(strlen(val) + 1);
-    if (NULL == p->value_p)
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        free(p->key_p);
-        free(p);
-        return NULL;
+    /* Is the parameter in the blacklist? */
+    if (mpl_param_list_find(param_id, blacklist))
+        return false;
+
+    return param_descr_p->array[PARAMID_TO_INDEX(param_id)].allow_get;
+}
+
+/**
+ * mpl_param_allow_set_bl
+ */
+bool
+    mpl_param_allow_set_bl(mpl_param_element_id_t param_id,
+                           mpl_blacklist_t blacklist)
+{
+    mpl_param_descr_set_t *param_descr_p;
+
+    param_descr_p = paramset_find(MPL_PARAMID_TO_PARAMSET(param_id), NULL);
+
+    if (NULL == param_descr_p) {
+        // [DOC] The specified MPL parameter has an unrecognized parameter set
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,("Parameter set is NULL\n"));
+        return false;
     }
 
-    element_p = mpl_param_element_create_empty_tag(param_id, tag);
-    if (NULL == element_p)
+    if (!PARAMID_OK(param_id, param_descr_p))
     {
-        free(p->key_p);
-        free(p->value_p);
-        free(p);
-        return NULL;
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Unknown parameter id\n"));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return false;
     }
 
-    element_p->value_p = p;
-    strcpy(p->key_p, key);
-    strcpy(p->value_p, val);
-    return (element_p);
-}
+    /* Is the parameter in the blacklist? */
+    if (mpl_param_list_find(param_id, blacklist))
+        return false;
 
+    return param_descr_p->array[PARAMID_TO_INDEX(param_id)].allow_set;
+}
 
 /**
- * mpl_param_element_create_int_tuple_tag
- *
+ * mpl_param_allow_config_bl
  */
-mpl_param_element_t*
-    mpl_param_element_create_int_tuple_tag(mpl_param_element_id_t param_id,
-                                           int tag,
-                                           int key, int val)
+bool
+    mpl_param_allow_config_bl(mpl_param_element_id_t param_id,
+                              mpl_blacklist_t blacklist)
 {
-    mpl_param_element_t* element_p;
-    mpl_int_tuple_t *p;
+    mpl_param_descr_set_t *param_descr_p;
 
-    p = malloc(sizeof(mpl_int_tuple_t));
-    if(NULL == p)
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        return NULL;
+    param_descr_p = paramset_find(MPL_PARAMID_TO_PARAMSET(param_id), NULL);
+
+    if (NULL == param_descr_p) {
+        // [DOC] The specified MPL parameter has an unrecognized parameter set
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                            ("Parameter set is NULL, param_id=%x\n",
+                             param_id));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return false;
     }
 
-    element_p = mpl_param_element_create_empty_tag(param_id, tag);
-    if (NULL == element_p)
+    if (!PARAMID_OK(param_id, param_descr_p))
     {
-        free(p);
-        return NULL;
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Unknown parameter id\n"));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return false;
     }
 
-    element_p->value_p = p;
-    p->key = key;
-    p->value = val;
-    return (element_p);
-}
+    /* Is the parameter in the blacklist? */
+    if (mpl_param_list_find(param_id, blacklist))
+        return false;
 
+    return param_descr_p->array[PARAMID_TO_INDEX(param_id)].allow_config;
+}
 
 /**
- * mpl_param_element_create_strint_tuple_tag
+ * mpl_param_element_create_stringn_tag
  *
  */
 mpl_param_element_t*
-    mpl_param_element_create_strint_tuple_tag(mpl_param_element_id_t param_id,
-                                              int tag,
-                                              const char* key, int val)
+    mpl_param_element_create_stringn_tag(mpl_param_element_id_t param_id,
+                                         int tag,
+                                         const char* value,
+                                         size_t len)
 {
     mpl_param_element_t* element_p;
-    mpl_strint_tuple_t *p;
+    size_t size;
 
-    p = malloc(sizeof(mpl_strint_tuple_t));
-    if(NULL == p)
+    size = len + 1;
+
+    element_p = mpl_param_element_create_empty_tag(param_id, tag);
+    if (NULL == element_p)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
         return NULL;
     }
 
-    p->key_p = malloc(strlen(key) + 1);
-    if (NULL == p->key_p)
+    element_p->value_p = malloc(size);
+    if (NULL == element_p->value_p)
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
                             ("Failed allocating memory\n"));
         set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        free(p);
+        mpl_param_element_destroy(element_p);
         return NULL;
     }
 
-    element_p = mpl_param_element_create_empty_tag(param_id, tag);
-    if (NULL == element_p)
-    {
-        free(p->key_p);
-        free(p);
-        return NULL;
-    }
+    strncpy((char*)element_p->value_p, value, len);
+
+    // add null termination
+    ((char*)element_p->value_p)[len] = 0;
 
-    element_p->value_p = p;
-    strcpy(p->key_p, key);
-    p->value = val;
     return (element_p);
 }
 
-
 /**
- * mpl_param_element_create_struint8_tuple_tag
+ * mpl_param_element_create_wstringn_tag
  *
  */
 mpl_param_element_t*
-    mpl_param_element_create_struint8_tuple_tag(mpl_param_element_id_t param_id,
-                                                int tag,
-                                                const char* key, uint8_t val)
+    mpl_param_element_create_wstringn_tag(mpl_param_element_id_t param_id,
+                                          int tag,
+                                          const wchar_t* value,
+                                          size_t len)
 {
     mpl_param_element_t* element_p;
-    mpl_struint8_tuple_t *p;
+    size_t size;
 
-    p = malloc(sizeof(mpl_struint8_tuple_t));
-    if(NULL == p)
+    size = len + 1;
+
+    element_p = mpl_param_element_create_empty_tag(param_id, tag);
+    if (NULL == element_p)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
         return NULL;
     }
 
-    p->key_p = malloc(strlen(key) + 1);
-    if (NULL == p->key_p)
+    element_p->value_p = malloc(size * sizeof(L'\0'));
+    if (NULL == element_p->value_p)
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
                             ("Failed allocating memory\n"));
         set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        free(p);
+        mpl_param_element_destroy(element_p);
         return NULL;
     }
 
-    element_p = mpl_param_element_create_empty_tag(param_id, tag);
-    if (NULL == element_p)
-    {
-        free(p->key_p);
-        free(p);
-        return NULL;
-    }
+    (void)wcsncpy((wchar_t*)element_p->value_p, value, size);
+
+    // add null termination
+    ((wchar_t*)element_p->value_p)[len] = L'\0';
 
-    element_p->value_p = p;
-    strcpy(p->key_p, key);
-    p->value = val;
     return (element_p);
 }
 
-
-#ifdef UNIT_TEST
-typedef struct
+/**
+ * mpl_param_element_create_empty_tag
+ *
+ */
+mpl_param_element_t*
+    mpl_param_element_create_empty_tag(mpl_param_element_id_t param_id, int tag)
 {
-    bool param_test_active;
-    mpl_param_element_id_t param_id;
-    MPL_ErrorCode_t errno_code;
-} mpl_unittest_response_t;
+    mpl_param_element_t* element_p;
+    mpl_param_descr_set_t *param_descr_p;
 
-static mpl_unittest_response_t mpl_param_unittest;
-
-
-void unittest_force_mpl_init(void)
-{
-    mpl_param_unittest.param_test_active = false;
-}
-
-void unittest_force_mpl_set(mpl_param_element_id_t param_id,
-                            MPL_ErrorCode_t errno_code)
-{
-    mpl_param_unittest.param_test_active = true;
-    mpl_param_unittest.param_id = param_id;
-    mpl_param_unittest.errno_code = errno_code;
-}
-
-
-bool unittest_force_mpl_errno_response(mpl_param_element_id_t param_id,
-                                       MPL_ErrorCode_t *errno_code)
-{
-    if (mpl_param_unittest.param_test_active == false)
-        return false;
-    if (param_id != mpl_param_unittest.param_id)
-        return false;
-    *errno_code = mpl_param_unittest.errno_code;
-    return true;
-}
-#endif
-
-/**
- * mpl_param_element_create_tag
- */
-mpl_param_element_t*
-    mpl_param_element_create_tag(mpl_param_element_id_t param_id,
-                                 int tag,
-                                 const void* value_p)
-{
-    mpl_param_element_t* element_p;
-    mpl_param_descr_set_t *param_descr_p;
-    mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
-
-#ifdef UNIT_TEST
+    if (MPL_PARAMID_IS_VIRTUAL(param_id))
     {
-        MPL_ErrorCode_t error_code;
-        if (unittest_force_mpl_errno_response(param_id, &error_code))
-        {
-            set_errno(error_code);
-            return NULL;
-        }
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Parameter is VIRTUAL\n"));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return NULL;
     }
-#endif
-
 
     param_descr_p = paramset_find(MPL_PARAMID_TO_PARAMSET(param_id), NULL);
 
-    if (NULL == param_descr_p)
-    {
+    if (NULL == param_descr_p) {
         // [DOC] The specified MPL parameter has an unrecognized parameter set
         MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Parameter set is NULL\n"));
         set_errno(E_MPL_INVALID_PARAMETER);
         return NULL;
     }
 
-    element_p = mpl_param_element_create_empty_tag(param_id, tag);
-    if (NULL == element_p)
+    if (!PARAMID_OK(param_id, param_descr_p))
     {
-        return NULL;
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                            ("Unknown parameter ID: %x\n", param_id));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return (NULL);
     }
 
-    if (NULL != value_p)
+    if ((tag < 0) || (tag >= MPL_MAX_ARGS))
     {
-        int res;
-        char *scratch_string_p;
-        int len;
-        void *scratch_value_p = NULL;
-
-        res = (*param_descr_p->array[PARAMID_TO_INDEX(param_id)].pack_func)
-              (value_p,
-               NULL,
-               0,
-               &param_descr_p->array2[PARAMID_TO_INDEX(param_id)],
-               &options);
-
-        if (res < 0)
-        {
-            MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
-                                ("Param value pack failed for %s\n",
-                                 mpl_param_id_get_string(param_id)));
-            mpl_param_element_destroy(element_p);
-            return NULL;
-        }
-
-        len = res + 1;
-        scratch_string_p = get_scratch_string(len);
-        if (NULL == scratch_string_p)
-        {
-            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                                ("Could not get scratch string\n"));
-            set_errno(E_MPL_FAILED_OPERATION);
-            mpl_param_element_destroy(element_p);
-            return NULL;
-        }
-
-        res = (*param_descr_p->array[PARAMID_TO_INDEX(param_id)].pack_func)
-              (value_p,
-               scratch_string_p,
-               len,
-               &param_descr_p->array2[PARAMID_TO_INDEX(param_id)],
-               &options);
-
-        if (res >= 0)
-        {
-            mpl_param_element_id_t ctxt;
-            if (param_descr_p->array[PARAMID_TO_INDEX(param_id)].type == mpl_type_bag)
-                ctxt = param_id;
-            else
-                ctxt = MPL_PARAM_ID_UNDEFINED;
-
-            res = (*param_descr_p->array[PARAMID_TO_INDEX(param_id)].unpack_func)
-                  (&scratch_string_p[1],
-                   &scratch_value_p,
-                   &param_descr_p->array2[PARAMID_TO_INDEX(param_id)],
-                   &options,
-                   ctxt);
-            (*param_descr_p->array[PARAMID_TO_INDEX(param_id)].free_func)
-                (scratch_value_p);
-        }
-
-        if (res < 0)
-        {
-            MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
-                                ("Param value check failed for %s\n",
-                                 mpl_param_id_get_string(param_id)));
-            mpl_param_element_destroy(element_p);
-            return NULL;
-        }
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                            ("Illegal tag value: %d\n", tag));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return (NULL);
+    }
 
-        res = (*param_descr_p->array[PARAMID_TO_INDEX(param_id)].clone_func)
-              (&element_p->value_p,
-               value_p,
-               &param_descr_p->array2[PARAMID_TO_INDEX(param_id)]);
-        if (res < 0)
-        {
-            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                                ("Param value clone failed for %s\n",
-                                 mpl_param_id_get_string(param_id)));
-            mpl_param_element_destroy(element_p);
-            return NULL;
-        }
+    element_p = calloc(1, sizeof(mpl_param_element_t));
+    if (NULL == element_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return NULL;
     }
 
+    element_p->id = param_id;
+    element_p->tag = tag;
+    element_p->value_p = NULL;
+    element_p->list_entry.next_p = NULL;
+    element_p->in_arena = (NULL != current_arena());
+
     return (element_p);
 }
 
-
 /**
- * mpl_param_element_set_tag
+ * mpl_param_element_init
+ *
  */
-int
-    mpl_param_element_set_tag(mpl_param_element_t* element_p, int tag)
+void mpl_param_element_init(mpl_param_element_t *element_p,
+                            mpl_param_element_id_t param_id)
 {
-    if ((tag < 0) || (tag >= MPL_MAX_ARGS))
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
-                            ("Illegal tag value: %d\n", tag));
-        set_errno(E_MPL_INVALID_PARAMETER);
-        return -1;
-    }
-    element_p->tag = tag;
-    return 0;
+    assert(NULL != element_p);
+
+    /* No value, and none of the flags set */
+    memset(element_p, 0, sizeof(mpl_param_element_t));
+    element_p->id = param_id;
+    element_p->value_p = NULL;
+    element_p->list_entry.next_p = NULL;
 }
 
 /**
- * mpl_param_element_clone
+ * mpl_param_element_create_n_tag
+ *
  */
 mpl_param_element_t*
-    mpl_param_element_clone(const mpl_param_element_t* element_p)
+    mpl_param_element_create_n_tag(mpl_param_element_id_t param_id,
+                                   int tag,
+                                   const void* value_p,
+                                   size_t len)
 {
-    mpl_param_element_t* new_element_p;
-    int res;
     mpl_param_descr_set_t *param_descr_p;
+    size_t size;
 
-    if (NULL == element_p)
-        return NULL;
-
-    param_descr_p = paramset_find(MPL_PARAMID_TO_PARAMSET(element_p->id),
-                                  NULL);
+    param_descr_p = paramset_find(MPL_PARAMID_TO_PARAMSET(param_id), NULL);
 
     if (NULL == param_descr_p)
     {
         // [DOC] The specified MPL parameter has an unrecognized parameter set
-        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Parameter set is NULL\n"));
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                            ("Parameter set is NULL (paramid=%x)\n", param_id));
         set_errno(E_MPL_INVALID_PARAMETER);
         return NULL;
     }
 
-    new_element_p = mpl_param_element_create_empty_tag(element_p->id,
-                                                       element_p->tag);
-    if (NULL == new_element_p)
+    size = (*param_descr_p->array[PARAMID_TO_INDEX(param_id)].sizeof_func)
+           (&param_descr_p->array2[PARAMID_TO_INDEX(param_id)]);
+
+    if ((size > 0) && (size != len))
     {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                            ("Param length check failed for %s\n",
+                             mpl_param_id_get_string(param_id)));
+        set_errno(E_MPL_INVALID_PARAMETER);
         return NULL;
     }
-    MPL_PARAM_ELEMENT_SET_FIELD_INFO(new_element_p,
-                                     element_p->context,
-                                     element_p->id_in_context);
-    if (NULL != element_p->value_p)
-    {
-        res = (*param_descr_p->array[PARAMID_TO_INDEX(element_p->id)].clone_func)
-              (&new_element_p->value_p,
-               element_p->value_p,
-               &param_descr_p->array2[PARAMID_TO_INDEX(element_p->id)]);
-        if (res < 0)
-        {
-            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                                ("Param value clone failed for %s\n",
-                                 mpl_param_id_get_string(element_p->id)));
-            mpl_param_element_destroy(new_element_p);
-            return NULL;
-        }
-    }
 
-    return new_element_p;
+    return mpl_param_element_create_tag(param_id, tag, value_p);
 }
 
-
 /**
- * mpl_param_element_compare
+ * mpl_param_element_create_uint8_array_tag
+ *
  */
-int
-    mpl_param_element_compare(const mpl_param_element_t* element1_p,
-                              const mpl_param_element_t* element2_p)
+mpl_param_element_t*
+    mpl_param_element_create_uint8_array_tag(mpl_param_element_id_t param_id,
+                                             int tag,
+                                             const uint8_t* value, size_t size)
 {
-    mpl_param_descr_set_t *param_descr_p;
+    mpl_param_element_t* element_p;
+    mpl_uint8_array_t *p;
 
-    if (NULL == element1_p)
-        return -1;
+    p = malloc(sizeof(mpl_uint8_array_t));
+    if(NULL == p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return NULL;
+    }
 
-    if (NULL == element2_p)
-        return -1;
-
-    if (element1_p->id != element2_p->id)
-        return -1;
+    p->arr_p = malloc(size * sizeof(uint8_t));
+    if (NULL == p->arr_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        free(p);
+        return NULL;
+    }
 
-    if (element1_p->tag != element2_p->tag)
-        return -1;
+    element_p = mpl_param_element_create_empty_tag(param_id, tag);
+    if (NULL == element_p)
+    {
+        free(p->arr_p);
+        free(p);
+        return NULL;
+    }
 
-    if (element1_p->context != element2_p->context)
-        return -1;
+    element_p->value_p = p;
+    p->len = size;
+    memcpy(p->arr_p, value, size * sizeof(uint8_t));
+    return (element_p);
+}
 
-    if (element1_p->id_in_context != element2_p->id_in_context)
-        return -1;
 
-    param_descr_p = paramset_find(MPL_PARAMID_TO_PARAMSET(element1_p->id),
-                                  NULL);
+/**
+ * mpl_param_element_create_uint16_array_tag
+ *
+ */
+mpl_param_element_t*
+    mpl_param_element_create_uint16_array_tag(mpl_param_element_id_t param_id,
+                                              int tag,
+                                              const uint16_t* value, size_t size)
+{
+    mpl_param_element_t* element_p;
+    mpl_uint16_array_t *p;
 
-    if (NULL == param_descr_p)
+    p = malloc(sizeof(mpl_uint16_array_t));
+    if(NULL == p)
     {
-        // [DOC] The specified MPL parameter has an unrecognized parameter set
-        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Parameter set is NULL\n"));
-        set_errno(E_MPL_INVALID_PARAMETER);
-        return -1;
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return NULL;
     }
 
-    if ((element1_p->value_p == NULL) && (element2_p->value_p == NULL))
-        return 0;
+    p->arr_p = malloc(size * sizeof(uint16_t));
+    if (NULL == p->arr_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        free(p);
+        return NULL;
+    }
 
-    if ((element1_p->value_p == NULL) || (element2_p->value_p == NULL))
-        return -1;
+    element_p = mpl_param_element_create_empty_tag(param_id, tag);
+    if (NULL == element_p)
+    {
+        free(p->arr_p);
+        free(p);
+        return NULL;
+    }
 
-    return (*param_descr_p->array[PARAMID_TO_INDEX(element1_p->id)].compare_func)
-        (element1_p->value_p,
-         element2_p->value_p,
-         &param_descr_p->array2[PARAMID_TO_INDEX(element1_p->id)]);
+    element_p->value_p = p;
+    p->len = size;
+    memcpy(p->arr_p, value, size * sizeof(uint16_t));
+    return (element_p);
 }
 
 
 /**
- * mpl_param_element_get_default_bl
+ * mpl_param_element_create_uint32_array_tag
+ *
  */
 mpl_param_element_t*
-    mpl_param_element_get_default_bl(mpl_param_element_id_t param_id,
-                                     mpl_blacklist_t blacklist)
+    mpl_param_element_create_uint32_array_tag(mpl_param_element_id_t param_id,
+                                              int tag,
+                                              const uint32_t* value, size_t size)
 {
     mpl_param_element_t* element_p;
-    int res;
-    mpl_param_descr_set_t *param_descr_p;
+    mpl_uint32_array_t *p;
 
-    param_descr_p = paramset_find(MPL_PARAMID_TO_PARAMSET(param_id), NULL);
+    p = malloc(sizeof(mpl_uint32_array_t));
+    if(NULL == p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return NULL;
+    }
 
-    if (NULL == param_descr_p)
+    p->arr_p = malloc(size * sizeof(uint32_t));
+    if (NULL == p->arr_p)
     {
-        // [DOC] The specified MPL parameter has an unrecognized parameter set
-        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Parameter set is NULL\n"));
-        set_errno(E_MPL_INVALID_PARAMETER);
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        free(p);
         return NULL;
     }
 
-    if (!PARAMID_OK(param_id, param_descr_p))
+    element_p = mpl_param_element_create_empty_tag(param_id, tag);
+    if (NULL == element_p)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
-                            ("Unknown parameter ID: %d\n", param_id));
-        set_errno(E_MPL_INVALID_PARAMETER);
-        return (NULL);
+        free(p->arr_p);
+        free(p);
+        return NULL;
     }
 
-    /* Is the parameter in the blacklist? */
-    if (mpl_param_list_find(param_id, blacklist))
+    element_p->value_p = p;
+    p->len = size;
+    memcpy(p->arr_p, value, size * sizeof(uint32_t));
+    return (element_p);
+}
+
+
+/**
+ * mpl_param_element_create_string_tuple_tag
+ *
+ */
+mpl_param_element_t*
+    mpl_param_element_create_string_tuple_tag(mpl_param_element_id_t param_id,
+                                              int tag,
+                                              const char* key, const char *val)
+{
+    mpl_param_element_t* element_p;
+    mpl_string_tuple_t *p;
+
+    p = malloc(sizeof(mpl_string_tuple_t));
+    if(NULL == p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
         return NULL;
+    }
 
-    /* Do we have a default value? */
-    if (param_descr_p->array[PARAMID_TO_INDEX(param_id)].default_value_p == NULL)
+    p->key_p = malloc(strlen(key) + 1);
+    if (NULL == p->key_p)
     {
-        /* There is no default value for parameter */
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        free(p);
         return NULL;
     }
 
-    element_p = mpl_param_element_create_empty(param_id);
-    if (NULL == element_p)
+    p->value_p = malloc(strlen(val) + 1);
+    if (NULL == p->value_p)
     {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        free(p->key_p);
+        free(p);
         return NULL;
     }
 
-    res = (*param_descr_p->array[PARAMID_TO_INDEX(param_id)].clone_func)
-          (&element_p->value_p,
-           param_descr_p->array[PARAMID_TO_INDEX(param_id)].default_value_p,
-           &param_descr_p->array2[PARAMID_TO_INDEX(param_id)]);
-    if (res < 0)
+    element_p = mpl_param_element_create_empty_tag(param_id, tag);
+    if (NULL == element_p)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Param value clone failed for %s\n",
-                             mpl_param_id_get_string(param_id)));
-        mpl_param_element_destroy(element_p);
+        free(p->key_p);
+        free(p->value_p);
+        free(p);
         return NULL;
     }
 
-    return element_p;
+    element_p->value_p = p;
+    strcpy(p->key_p, key);
+    strcpy(p->value_p, val);
+    return (element_p);
 }
 
+
 /**
- * mpl_param_element_destroy
+ * mpl_param_element_create_int_tuple_tag
+ *
  */
-void
-    mpl_param_element_destroy(mpl_param_element_t* element_p)
+mpl_param_element_t*
+    mpl_param_element_create_int_tuple_tag(mpl_param_element_id_t param_id,
+                                           int tag,
+                                           int key, int val)
 {
-    if (NULL == element_p)
-        return;
+    mpl_param_element_t* element_p;
+    mpl_int_tuple_t *p;
 
-    if (NULL != element_p->value_p)
+    p = malloc(sizeof(mpl_int_tuple_t));
+    if(NULL == p)
     {
-        mpl_param_descr_set_t *param_descr_p;
-
-        param_descr_p = paramset_find(MPL_PARAMID_TO_PARAMSET(element_p->id),
-                                      NULL);
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return NULL;
+    }
 
-        if (NULL != param_descr_p)
-        {
-            if (PARAMID_OK(element_p->id, param_descr_p))
-            {
-                (*param_descr_p->array[PARAMID_TO_INDEX(element_p->id)].free_func)
-                    (element_p->value_p);
-            }
-            else
-            {
-                MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
-                                    ("param id not ok, element not freed\n"));
-                set_errno(E_MPL_INVALID_PARAMETER);
-            }
-        }
-        else
-        {
-            MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
-                                ("param descr set not found, element not freed\n"));
-            set_errno(E_MPL_INVALID_PARAMETER);
-        }
+    element_p = mpl_param_element_create_empty_tag(param_id, tag);
+    if (NULL == element_p)
+    {
+        free(p);
+        return NULL;
     }
 
-    free(element_p);
+    element_p->value_p = p;
+    p->key = key;
+    p->value = val;
+    return (element_p);
 }
 
-int mpl_param_list_pack(mpl_list_t *param_list_p,
-                        char *buf_p,
-                        int buflen)
-{
-    mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
-    options.no_prefix = false;
-    return mpl_param_list_pack_extended(param_list_p,
-                                        buf_p,
-                                        buflen,
-                                        &options);
-}
-
-int mpl_param_list_pack_no_prefix(mpl_list_t *param_list_p,
-                                  char *buf_p,
-                                  int buflen)
-{
-    mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
-    options.no_prefix = true;
-    return mpl_param_list_pack_extended(param_list_p,
-                                        buf_p,
-                                        buflen,
-                                        &options);
-}
 
 /**
- * mpl_param_list_pack_extended
+ * mpl_param_element_create_strint_tuple_tag
+ *
  */
-int mpl_param_list_pack_extended(mpl_list_t *param_list_p,
-                                 char *buf_p,
-                                 int buflen,
-                                 const mpl_pack_options_t *options_p)
+mpl_param_element_t*
+    mpl_param_element_create_strint_tuple_tag(mpl_param_element_id_t param_id,
+                                              int tag,
+                                              const char* key, int val)
 {
-    int total_len = 0;
-    int tmplen;
-    mpl_list_t *elem_p;
-    mpl_param_element_t* param_elem_p;
-    int res;
-    mpl_pack_options_t *new_options_p = calloc(1, sizeof(mpl_pack_options_t));
+    mpl_param_element_t* element_p;
+    mpl_strint_tuple_t *p;
 
-    if (new_options_p == NULL) {
+    p = malloc(sizeof(mpl_strint_tuple_t));
+    if(NULL == p)
+    {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
                             ("Failed allocating memory\n"));
         set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        res = -1;
-        goto error_return;
+        return NULL;
     }
 
-    *new_options_p = *options_p;
-    if (!new_options_p->force_field_pack_mode)
-        new_options_p->field_pack_mode = field_pack_mode_context;
-
-    /* Make sure we always terminate the buffer */
-    if ((NULL != buf_p) && (buflen > 0))
-        buf_p[0] = '\0';
+    p->key_p = malloc(strlen(key) + 1);
+    if (NULL == p->key_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        free(p);
+        return NULL;
+    }
 
-    /* Loop over all parameters in parameter list and pack them */
-    /*lint -esym(613, buf_p) */
-    MPL_LIST_FOR_EACH(param_list_p, elem_p)
+    element_p = mpl_param_element_create_empty_tag(param_id, tag);
+    if (NULL == element_p)
     {
-        /* Add a delimiter between all parameters */
-        if (total_len > 0)
-        {
-            tmplen = snprintf((total_len < buflen)?buf_p+total_len:NULL,
-                              (total_len < buflen)?buflen-total_len:0,
-                              "%c",
-                              new_options_p->message_delimiter);
-            if (tmplen < 0)
-            {
-                res = tmplen;
-                goto error_return;
-            }
+        free(p->key_p);
+        free(p);
+        return NULL;
+    }
 
-            total_len += tmplen;
-        }
+    element_p->value_p = p;
+    strcpy(p->key_p, key);
+    p->value = val;
+    return (element_p);
+}
 
-        param_elem_p = MPL_LIST_CONTAINER(elem_p, mpl_param_element_t, list_entry);
-        tmplen = mpl_param_pack_internal(param_elem_p,
-                                         (total_len < buflen)?buf_p+total_len:NULL,
-                                         (total_len < buflen)?buflen-total_len:0,
-                                         new_options_p);
-        if (tmplen < 0)
-        {
-            res = tmplen;
-            goto error_return;
-        }
 
-        total_len += tmplen;
+/**
+ * mpl_param_element_create_struint8_tuple_tag
+ *
+ */
+mpl_param_element_t*
+    mpl_param_element_create_struint8_tuple_tag(mpl_param_element_id_t param_id,
+                                                int tag,
+                                                const char* key, uint8_t val)
+{
+    mpl_param_element_t* element_p;
+    mpl_struint8_tuple_t *p;
+
+    p = malloc(sizeof(mpl_struint8_tuple_t));
+    if(NULL == p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return NULL;
     }
-    free(new_options_p);
 
-    return total_len;
+    p->key_p = malloc(strlen(key) + 1);
+    if (NULL == p->key_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        free(p);
+        return NULL;
+    }
 
-error_return:
-    if (new_options_p != NULL)
-        free(new_options_p);
-    return res;
-}
+    element_p = mpl_param_element_create_empty_tag(param_id, tag);
+    if (NULL == element_p)
+    {
+        free(p->key_p);
+        free(p);
+        return NULL;
+    }
 
-/* for backward compatibility */
-int mpl_param_list_pack_internal(mpl_list_t *param_list_p,
-                                 char *buf_p,
-                                 int buflen,
-                                 char message_delimiter,
-                                 bool no_prefix)
-{
-    mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
-    options.no_prefix = no_prefix;
-    options.message_delimiter = message_delimiter;
-    return mpl_param_list_pack_extended(param_list_p,
-                                        buf_p,
-                                        buflen,
-                                        &options);
+    element_p->value_p = p;
+    strcpy(p->key_p, key);
+    p->value = val;
+    return (element_p);
 }
 
-mpl_list_t *mpl_param_list_unpack(char *buf_p)
+
+#ifdef UNIT_TEST
+typedef struct
 {
-    mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
-    return mpl_param_list_unpack_internal(buf_p,
-                                          &options,
-                                          MPL_PARAM_ID_UNDEFINED,
-                                          NULL);
-}
+    bool param_test_active;
+    mpl_param_element_id_t param_id;
+    MPL_ErrorCode_t errno_code;
+} mpl_unittest_response_t;
 
-mpl_list_t *mpl_param_list_unpack_error(char *buf_p, bool *has_error_p)
+static mpl_unittest_response_t mpl_param_unittest;
+
+
+void unittest_force_mpl_init(void)
 {
-    mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
-    return mpl_param_list_unpack_internal(buf_p,
-                                          &options,
-                                          MPL_PARAM_ID_UNDEFINED,
-                                          has_error_p);
+    mpl_param_unittest.param_test_active = false;
 }
 
-mpl_list_t *mpl_param_list_unpack_param_set(char *buf_p, int param_set_id)
+void unittest_force_mpl_set(mpl_param_element_id_t param_id,
+                            MPL_ErrorCode_t errno_code)
 {
-    mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
-    options.param_set_id = param_set_id;
-    return mpl_param_list_unpack_internal(buf_p,
-                                          &options,
-                                          MPL_PARAM_ID_UNDEFINED,
-                                          NULL);
+    mpl_param_unittest.param_test_active = true;
+    mpl_param_unittest.param_id = param_id;
+    mpl_param_unittest.errno_code = errno_code;
 }
 
-mpl_list_t *mpl_param_list_unpack_param_set_error(char *buf_p,
-                                                  int param_set_id,
-                                                  bool *has_error_p)
+
+bool unittest_force_mpl_errno_response(mpl_param_element_id_t param_id,
+                                       MPL_ErrorCode_t *errno_code)
 {
-    mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
-    options.param_set_id = param_set_id;
-    return mpl_param_list_unpack_internal(buf_p,
-                                          &options,
-                                          MPL_PARAM_ID_UNDEFINED,
-                                          has_error_p);
+    if (mpl_param_unittest.param_test_active == false)
+        return false;
+    if (param_id != mpl_param_unittest.param_id)
+        return false;
+    *errno_code = mpl_param_unittest.errno_code;
+    return true;
 }
+#endif
 
 /**
- * mpl_param_list_unpack_internal - unpack packed parameter list
- *
- **/
-mpl_list_t *mpl_param_list_unpack_internal(char *buf_p,
-                                           const mpl_pack_options_t *options_p,
-                                           mpl_param_element_id_t unpack_context,
-                                           bool *has_error_p)
+ * mpl_param_element_create_tag
+ */
+mpl_param_element_t*
+    mpl_param_element_create_tag(mpl_param_element_id_t param_id,
+                                 int tag,
+                                 const void* value_p)
 {
-    int i;
-    mpl_param_element_t *param_elem_p;
-    mpl_list_t *param_list_p=NULL;
-    int numargs;
-    mpl_arg_t *args_p = NULL;
-    char *tmp_buf_p;
+    mpl_param_element_t* element_p;
+    mpl_param_descr_set_t *param_descr_p;
+    mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
 
-    if (NULL == buf_p)
+#ifdef UNIT_TEST
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("buf_p is NULL\n"));
-        set_errno(E_MPL_INVALID_PARAMETER);
-        if (has_error_p != NULL)
-            *has_error_p = true;
-        return NULL;
+        MPL_ErrorCode_t error_code;
+        if (unittest_force_mpl_errno_response(param_id, &error_code))
+        {
+            set_errno(error_code);
+            return NULL;
+        }
     }
+#endif
 
-    tmp_buf_p = malloc(strlen(buf_p) + 1);
-    if (NULL == tmp_buf_p)
+
+    param_descr_p = paramset_find(MPL_PARAMID_TO_PARAMSET(param_id), NULL);
+
+    if (NULL == param_descr_p)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        if (has_error_p != NULL)
-            *has_error_p = true;
-        free(args_p);
+        // [DOC] The specified MPL parameter has an unrecognized parameter set
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Parameter set is NULL\n"));
+        set_errno(E_MPL_INVALID_PARAMETER);
         return NULL;
     }
-    strcpy(tmp_buf_p, buf_p);
-
-    /* Split buffer into array of key, value string pointers */
-    numargs = mpl_get_args_2(&args_p,
-                             0,
-                             tmp_buf_p,
-                             '=',
-                             options_p->message_delimiter,
-                             '\\');
 
-    if (numargs < 0) {
-        if (has_error_p != NULL)
-            *has_error_p = true;
-        free(args_p);
-        free(tmp_buf_p);
+    element_p = mpl_param_element_create_empty_tag(param_id, tag);
+    if (NULL == element_p)
+    {
         return NULL;
     }
 
-    /* Loop over arguments and make list of parameter elements */
-    for (i = 0; i < numargs; i++)
+    if (NULL != value_p)
     {
-        assert(NULL != args_p[i].key_p);
-
-        if (mpl_param_unpack_internal(args_p[i].key_p,
-                                      args_p[i].value_p,
-                                      &param_elem_p,
-                                      options_p,
-                                      unpack_context) < 0)
-        {
-            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                                ("Param unpack failed for param: %s=%s\n",
-                                 args_p[i].key_p,
-                                 args_p[i].value_p));
-            mpl_param_list_destroy(&param_list_p);
-            if (has_error_p != NULL)
-                *has_error_p = true;
-            free(args_p);
-            free(tmp_buf_p);
+        int res;
+        char *scratch_string_p;
+        int len;
+        void *scratch_value_p = NULL;
+
+        res = (*param_descr_p->array[PARAMID_TO_INDEX(param_id)].pack_func)
+              (value_p,
+               NULL,
+               0,
+               &param_descr_p->array2[PARAMID_TO_INDEX(param_id)],
+               &options);
+
+        if (res < 0)
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                                ("Param value pack failed for %s\n",
+                                 mpl_param_id_get_string(param_id)));
+            mpl_param_element_destroy(element_p);
             return NULL;
         }
 
-        mpl_list_add(&param_list_p, &param_elem_p->list_entry);
-    }
+        len = res + 1;
+        scratch_string_p = get_scratch_string(len);
+        if (NULL == scratch_string_p)
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("Could not get scratch string\n"));
+            set_errno(E_MPL_FAILED_OPERATION);
+            mpl_param_element_destroy(element_p);
+            return NULL;
+        }
 
-    if (has_error_p != NULL)
-        *has_error_p = false;
-    free(args_p);
-    free(tmp_buf_p);
-    return param_list_p;
-}
+        res = (*param_descr_p->array[PARAMID_TO_INDEX(param_id)].pack_func)
+              (value_p,
+               scratch_string_p,
+               len,
+               &param_descr_p->array2[PARAMID_TO_INDEX(param_id)],
+               &options);
 
+        if (res >= 0)
+        {
+            mpl_param_element_id_t ctxt;
+            if (param_descr_p->array[PARAMID_TO_INDEX(param_id)].type == mpl_type_bag)
+                ctxt = param_id;
+            else
+                ctxt = MPL_PARAM_ID_UNDEFINED;
 
-/**
- * mpl_param_list_clone
- */
-mpl_list_t *mpl_param_list_clone(mpl_list_t *param_list_p)
-{
-    mpl_list_t *elem_p;
-    mpl_param_element_t *cloned_param_p;
-    mpl_list_t *cloned_list_p=NULL;
+            res = (*param_descr_p->array[PARAMID_TO_INDEX(param_id)].unpack_func)
+                  (&scratch_string_p[1],
+                   &scratch_value_p,
+                   &param_descr_p->array2[PARAMID_TO_INDEX(param_id)],
+                   &options,
+                   ctxt);
+            (*param_descr_p->array[PARAMID_TO_INDEX(param_id)].free_func)
+                (scratch_value_p);
+        }
 
+        if (res < 0)
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                                ("Param value check failed for %s\n",
+                                 mpl_param_id_get_string(param_id)));
+            mpl_param_element_destroy(element_p);
+            return NULL;
+        }
 
-    MPL_LIST_FOR_EACH(param_list_p, elem_p)
-    {
-        cloned_param_p =
-            mpl_param_element_clone(MPL_LIST_CONTAINER(elem_p,
-                                                       mpl_param_element_t,
-                                                       list_entry));
-        if(cloned_param_p == NULL)
+        res = (*param_descr_p->array[PARAMID_TO_INDEX(param_id)].clone_func)
+              (&element_p->value_p,
+               value_p,
+               &param_descr_p->array2[PARAMID_TO_INDEX(param_id)]);
+        if (res < 0)
         {
-            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,("clone parameter\n"));
-            goto error_return;
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("Param value clone failed for %s\n",
+                                 mpl_param_id_get_string(param_id)));
+            mpl_param_element_destroy(element_p);
+            return NULL;
         }
-        mpl_list_append(&cloned_list_p, &cloned_param_p->list_entry);
+        element_p->value_is_flat =
+            DESCR_VALUE_IS_FLAT(&param_descr_p->array[PARAMID_TO_INDEX(param_id)]);
     }
-    return cloned_list_p;
 
-error_return:
-    mpl_param_list_destroy(&cloned_list_p);
-    return NULL;
+    return (element_p);
 }
 
+
 /**
- * mpl_param_list_destroy
- *
+ * mpl_param_element_set_tag
  */
-void mpl_param_list_destroy( mpl_list_t **param_list_pp )
+int
+    mpl_param_element_set_tag(mpl_param_element_t* element_p, int tag)
 {
-    mpl_list_t *elem_p, *tmp_p;
-
-    if (NULL == param_list_pp)
-        return;
-
-    MPL_LIST_FOR_EACH_SAFE(*param_list_pp, elem_p, tmp_p)
+    if ((tag < 0) || (tag >= MPL_MAX_ARGS))
     {
-        (void)mpl_list_remove(param_list_pp, elem_p);
-        mpl_param_element_destroy(MPL_LIST_CONTAINER(elem_p,
-                                                     mpl_param_element_t,
-                                                     list_entry));
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                            ("Illegal tag value: %d\n", tag));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return -1;
     }
-    *param_list_pp = NULL;
+    element_p->tag = tag;
+    return 0;
 }
 
 /**
- * mpl_param_list_find
- *
+ * mpl_param_element_clone
  */
 mpl_param_element_t*
-    mpl_param_list_find( mpl_param_element_id_t param_id,
-                         mpl_list_t *param_list_p )
+    mpl_param_element_clone(const mpl_param_element_t* element_p)
 {
-    mpl_list_t *elem_p;
-    mpl_param_element_t *res;
+    mpl_param_element_t* new_element_p;
+    int res;
+    mpl_param_descr_set_t *param_descr_p;
 
-    MPL_LIST_FOR_EACH(param_list_p, elem_p)
+    if (NULL == element_p)
+        return NULL;
+
+    param_descr_p = paramset_find(MPL_PARAMID_TO_PARAMSET(element_p->id),
+                                  NULL);
+
+    if (NULL == param_descr_p)
     {
-        res = MPL_LIST_CONTAINER(elem_p, mpl_param_element_t, list_entry);
-        if (mpl_param_id_is_same_or_child(param_id, res->id))
-            return res;
+        // [DOC] The specified MPL parameter has an unrecognized parameter set
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Parameter set is NULL\n"));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return NULL;
     }
 
-    return NULL;
+    new_element_p = mpl_param_element_create_empty_tag(element_p->id,
+                                                       element_p->tag);
+    if (NULL == new_element_p)
+    {
+        return NULL;
+    }
+    MPL_PARAM_ELEMENT_SET_FIELD_INFO(new_element_p,
+                                     element_p->context,
+                                     element_p->id_in_context);
+    if (NULL != element_p->value_p)
+    {
+        res = (*param_descr_p->array[PARAMID_TO_INDEX(element_p->id)].clone_func)
+              (&new_element_p->value_p,
+               element_p->value_p,
+               &param_descr_p->array2[PARAMID_TO_INDEX(element_p->id)]);
+        if (res < 0)
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("Param value clone failed for %s\n",
+                                 mpl_param_id_get_string(element_p->id)));
+            mpl_param_element_destroy(new_element_p);
+            return NULL;
+        }
+        new_element_p->value_is_flat =
+            DESCR_VALUE_IS_FLAT(&param_descr_p->array[PARAMID_TO_INDEX(element_p->id)]);
+    }
+
+    return new_element_p;
 }
 
 /**
- * mpl_param_list_find_tag
- *
+ * mpl_param_element_own_value
  */
-mpl_param_element_t*
-    mpl_param_list_find_tag( mpl_param_element_id_t param_id,
-                             int tag,
-                             mpl_list_t *param_list_p )
+int mpl_param_element_own_value(mpl_param_element_t *element_p)
 {
-    mpl_list_t *elem_p;
-    mpl_param_element_t *res;
+    void *value_p = NULL;
+    mpl_param_descr_set_t *param_descr_p;
 
-    MPL_LIST_FOR_EACH(param_list_p, elem_p)
+    if (NULL == element_p)
     {
-        res = MPL_LIST_CONTAINER(elem_p, mpl_param_element_t, list_entry);
-        if (((param_id == MPL_PARAM_ID_UNDEFINED) || mpl_param_id_is_same_or_child(param_id, res->id)) &&
-            (res->tag == tag))
-            return res;
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("element_p is NULL\n"));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return (-1);
     }
 
-    return NULL;
-}
-
-/**
- * mpl_param_list_find_all
- *
- */
-mpl_list_t*
-    mpl_param_list_find_all( mpl_param_element_id_t param_id,
-                             mpl_list_t *param_list_p )
-{
-    mpl_param_element_t* param_elem_p;
-    mpl_param_element_t* found_param_elem_p;
-    mpl_list_t* result_list_p = NULL;
+    if (!element_p->value_is_view)
+    {
+        /* The contents of a bag may be views too */
+        if ((NULL != element_p->value_p) &&
+            (mpl_param_id_get_type(element_p->id) == mpl_type_bag))
+            return mpl_param_list_own_values(element_p->value_p);
+        return (0);
+    }
 
-    param_elem_p = mpl_param_list_find(param_id, param_list_p);
-    if (NULL != param_elem_p)
+    param_descr_p = paramset_find(MPL_PARAMID_TO_PARAMSET(element_p->id),
+                                  NULL);
+    if ((NULL == param_descr_p) || !PARAMID_OK(element_p->id, param_descr_p))
     {
-        found_param_elem_p = mpl_param_element_clone(param_elem_p);
-        if (NULL == found_param_elem_p)
-            goto error_return;
-        mpl_list_add(&result_list_p, &found_param_elem_p->list_entry);
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Unknown parameter id\n"));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return (-1);
     }
 
-    while (NULL != param_elem_p)
+    if ((*param_descr_p->array[PARAMID_TO_INDEX(element_p->id)].clone_func)
+        (&value_p,
+         element_p->value_p,
+         &param_descr_p->array2[PARAMID_TO_INDEX(element_p->id)]) < 0)
     {
-        param_elem_p = mpl_param_list_find_next(param_id, param_elem_p);
-        if (NULL != param_elem_p)
-        {
-            found_param_elem_p = mpl_param_element_clone(param_elem_p);
-            if (NULL == found_param_elem_p)
-                goto error_return;
-            mpl_list_add(&result_list_p, &found_param_elem_p->list_entry);
-        }
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Param value clone failed for %s\n",
+                             mpl_param_id_get_string(element_p->id)));
+        return (-1);
     }
-    return result_list_p;
 
-error_return:
-    mpl_param_list_destroy(&result_list_p);
-    return NULL;
+    element_p->value_p = value_p;
+    element_p->value_is_view = false;
+    return (0);
 }
 
 /**
- * mpl_param_list_find_all_tag
- *
+ * mpl_param_list_own_values
  */
-mpl_list_t*
-    mpl_param_list_find_all_tag( mpl_param_element_id_t param_id,
-                                 int tag,
-                                 mpl_list_t *param_list_p )
+int mpl_param_list_own_values(mpl_list_t *param_list_p)
 {
-    mpl_param_element_t* param_elem_p;
-    mpl_param_element_t* found_param_elem_p;
-    mpl_list_t* result_list_p = NULL;
+    mpl_list_t *elem_p;
 
-    param_elem_p = mpl_param_list_find_tag(param_id, tag, param_list_p);
-    if (NULL != param_elem_p)
+    MPL_LIST_FOR_EACH(param_list_p, elem_p)
     {
-        found_param_elem_p = mpl_param_element_clone(param_elem_p);
-        if (NULL == found_param_elem_p)
-            goto error_return;
-        mpl_list_add(&result_list_p, &found_param_elem_p->list_entry);
-    }
-
-    while (NULL != param_elem_p)
-    {
-        param_elem_p = mpl_param_list_find_next_tag(param_id, tag, param_elem_p);
-        if (NULL != param_elem_p)
-        {
-            found_param_elem_p = mpl_param_element_clone(param_elem_p);
-            if (NULL == found_param_elem_p)
-                goto error_return;
-            mpl_list_add(&result_list_p, &found_param_elem_p->list_entry);
-        }
+        if (mpl_param_element_own_value(MPL_LIST_CONTAINER(elem_p,
+                                                           mpl_param_element_t,
+                                                           list_entry)) < 0)
+            return (-1);
     }
-    return result_list_p;
-
-error_return:
-    mpl_param_list_destroy(&result_list_p);
-    return NULL;
+    return (0);
 }
 
-int mpl_param_list_param_count( mpl_param_element_id_t param_id,
-                                mpl_list_t *param_list_p )
+
+/**
+ * mpl_param_element_compare
+ */
+int
+    mpl_param_element_compare(const mpl_param_element_t* element1_p,
+                              const mpl_param_element_t* element2_p)
 {
-    mpl_param_element_t* param_elem_p;
-    int count = 0;
+    mpl_param_descr_set_t *param_descr_p;
 
-    param_elem_p = mpl_param_list_find(param_id, param_list_p);
-    if (NULL != param_elem_p)
-        count++;
+    if (NULL == element1_p)
+        return -1;
 
-    while (NULL != param_elem_p)
-    {
-        param_elem_p = mpl_param_list_find_next(param_id, param_elem_p);
-        if (NULL != param_elem_p)
-            count++;
-    }
-    return count;
-}
+    if (NULL == element2_p)
+        return -1;
 
-int mpl_param_list_param_count_tag( mpl_param_element_id_t param_id,
-                                    int tag,
-                                    mpl_list_t *param_list_p )
-{
-    mpl_param_element_t* param_elem_p;
-    int count = 0;
+    if (element1_p->id != element2_p->id)
+        return -1;
 
-    param_elem_p = mpl_param_list_find_tag(param_id, tag, param_list_p);
-    if (NULL != param_elem_p)
-        count++;
+    if (element1_p->tag != element2_p->tag)
+        return -1;
 
-    while (NULL != param_elem_p)
-    {
-        param_elem_p = mpl_param_list_find_next_tag(param_id, tag, param_elem_p);
-        if (NULL != param_elem_p)
-            count++;
-    }
-    return count;
-}
+    if (element1_p->context != element2_p->context)
+        return -1;
 
-mpl_param_element_t*
-    mpl_param_list_find_field( mpl_param_element_id_t context,
-                               int id_in_context,
-                               mpl_list_t *param_list_p )
-{
-    mpl_list_t *elem_p;
-    mpl_param_element_t *res;
-    mpl_param_element_id_t bag_field_context =
-        mpl_param_get_bag_field_context(context,id_in_context);
+    if (element1_p->id_in_context != element2_p->id_in_context)
+        return -1;
 
-    MPL_LIST_FOR_EACH(param_list_p, elem_p)
+    param_descr_p = paramset_find(MPL_PARAMID_TO_PARAMSET(element1_p->id),
+                                  NULL);
+
+    if (NULL == param_descr_p)
     {
-        res = MPL_LIST_CONTAINER(elem_p, mpl_param_element_t, list_entry);
-        if ((res->context == bag_field_context) &&
-            (res->id_in_context == id_in_context))
-            return res;
+        // [DOC] The specified MPL parameter has an unrecognized parameter set
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Parameter set is NULL\n"));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return -1;
     }
 
-    return NULL;
-}
-
-mpl_param_element_t*
-    mpl_param_list_find_field_tag( mpl_param_element_id_t context,
-                                   int id_in_context,
-                                   int tag,
-                                   mpl_list_t *param_list_p )
-{
-    mpl_list_t *elem_p;
-    mpl_param_element_t *res;
+    if ((element1_p->value_p == NULL) && (element2_p->value_p == NULL))
+        return 0;
 
-    MPL_LIST_FOR_EACH(param_list_p, elem_p)
-    {
-        res = MPL_LIST_CONTAINER(elem_p, mpl_param_element_t, list_entry);
-        if ((res->context == mpl_param_get_bag_field_context(context,id_in_context)) &&
-            (res->id_in_context == id_in_context) &&
-            (res->tag == tag))
-            return res;
-    }
+    if ((element1_p->value_p == NULL) || (element2_p->value_p == NULL))
+        return -1;
 
-    return NULL;
+    return (*param_descr_p->array[PARAMID_TO_INDEX(element1_p->id)].compare_func)
+        (element1_p->value_p,
+         element2_p->value_p,
+         &param_descr_p->array2[PARAMID_TO_INDEX(element1_p->id)]);
 }
 
-mpl_list_t*
-    mpl_param_list_find_field_all( mpl_param_element_id_t context,
-                                   int id_in_context,
-                                   mpl_list_t *param_list_p )
+
+/**
+ * mpl_param_element_get_default_bl
+ */
+mpl_param_element_t*
+    mpl_param_element_get_default_bl(mpl_param_element_id_t param_id,
+                                     mpl_blacklist_t blacklist)
 {
-    mpl_param_element_t* param_elem_p;
-    mpl_param_element_t* found_param_elem_p;
-    mpl_list_t* result_list_p = NULL;
+    mpl_param_element_t* element_p;
+    int res;
+    mpl_param_descr_set_t *param_descr_p;
 
-    param_elem_p = mpl_param_list_find_field(context,
-                                             id_in_context,
-                                             param_list_p);
-    if (NULL != param_elem_p)
+    param_descr_p = paramset_find(MPL_PARAMID_TO_PARAMSET(param_id), NULL);
+
+    if (NULL == param_descr_p)
     {
-        found_param_elem_p = mpl_param_element_clone(param_elem_p);
-        if (NULL == found_param_elem_p)
-            goto error_return;
-        mpl_list_add(&result_list_p, &found_param_elem_p->list_entry);
+        // [DOC] The specified MPL parameter has an unrecognized parameter set
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Parameter set is NULL\n"));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return NULL;
     }
 
-    while (NULL != param_elem_p)
+    if (!PARAMID_OK(param_id, param_descr_p))
     {
-        param_elem_p = mpl_param_list_find_field_next(context,
-                                                      id_in_context,
-                                                      param_elem_p);
-        if (NULL != param_elem_p)
-        {
-            found_param_elem_p = mpl_param_element_clone(param_elem_p);
-            if (NULL == found_param_elem_p)
-                goto error_return;
-            mpl_list_add(&result_list_p, &found_param_elem_p->list_entry);
-        }
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                            ("Unknown parameter ID: %d\n", param_id));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return (NULL);
     }
-    return result_list_p;
 
-error_return:
-    mpl_param_list_destroy(&result_list_p);
-    return NULL;
-}
+    /* Is the parameter in the blacklist? */
+    if (mpl_param_list_find(param_id, blacklist))
+        return NULL;
 
-mpl_list_t*
-    mpl_param_list_find_field_all_tag( mpl_param_element_id_t context,
-                                       int id_in_context,
-                                       int tag,
-                                       mpl_list_t *param_list_p )
-{
-    mpl_param_element_t* param_elem_p;
-    mpl_param_element_t* found_param_elem_p;
-    mpl_list_t* result_list_p = NULL;
+    /* Do we have a default value? */
+    if (param_descr_p->array[PARAMID_TO_INDEX(param_id)].default_value_p == NULL)
+    {
+        /* There is no default value for parameter */
+        return NULL;
+    }
 
-    param_elem_p = mpl_param_list_find_field_tag(context,
-                                                 id_in_context,
-                                                 tag,
-                                                 param_list_p);
-    if (NULL != param_elem_p)
+    element_p = mpl_param_element_create_empty(param_id);
+    if (NULL == element_p)
     {
-        found_param_elem_p = mpl_param_element_clone(param_elem_p);
-        if (NULL == found_param_elem_p)
-            goto error_return;
-        mpl_list_add(&result_list_p, &found_param_elem_p->list_entry);
+        return NULL;
     }
 
-    while (NULL != param_elem_p)
+    res = (*param_descr_p->array[PARAMID_TO_INDEX(param_id)].clone_func)
+          (&element_p->value_p,
+           param_descr_p->array[PARAMID_TO_INDEX(param_id)].default_value_p,
+           &param_descr_p->array2[PARAMID_TO_INDEX(param_id)]);
+    if (res < 0)
     {
-        param_elem_p = mpl_param_list_find_field_next_tag(context,
-                                                          id_in_context,
-                                                          tag,
-                                                          param_elem_p);
-        if (NULL != param_elem_p)
-        {
-            found_param_elem_p = mpl_param_element_clone(param_elem_p);
-            if (NULL == found_param_elem_p)
-                goto error_return;
-            mpl_list_add(&result_list_p, &found_param_elem_p->list_entry);
-        }
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Param value clone failed for %s\n",
+                             mpl_param_id_get_string(param_id)));
+        mpl_param_element_destroy(element_p);
+        return NULL;
     }
-    return result_list_p;
+    element_p->value_is_flat =
+        DESCR_VALUE_IS_FLAT(&param_descr_p->array[PARAMID_TO_INDEX(param_id)]);
 
-error_return:
-    mpl_param_list_destroy(&result_list_p);
-    return NULL;
+    return element_p;
 }
 
-int mpl_param_list_field_count( mpl_param_element_id_t context,
-                                int id_in_context,
-                                mpl_list_t *param_list_p )
+/**
+ * mpl_param_element_destroy
+ */
+void
+    mpl_param_element_destroy(mpl_param_element_t* element_p)
 {
-    mpl_param_element_t* param_elem_p;
-    int count = 0;
+    if (NULL == element_p)
+        return;
 
-    param_elem_p = mpl_param_list_find_field(context,
-                                             id_in_context,
-                                             param_list_p);
-    if (NULL != param_elem_p)
-        count++;
+    /* Freed with the arena */
+    if (element_p->in_arena)
+        return;
 
-    while (NULL != param_elem_p)
+    /* A view into an unpack buffer is owned by the buffer, and a flat
+       value needs no lookup of its free method */
+    if ((NULL != element_p->value_p) && !element_p->value_is_view &&
+        element_p->value_is_flat)
     {
-        param_elem_p = mpl_param_list_find_field_next(context,
-                                                      id_in_context,
-                                                      param_elem_p);
-        if (NULL != param_elem_p)
-            count++;
+        free(element_p->value_p);
     }
-    return count;
+    else if ((NULL != element_p->value_p) && !element_p->value_is_view)
+    {
+        mpl_param_descr_set_t *param_descr_p;
+
+        param_descr_p = paramset_find(MPL_PARAMID_TO_PARAMSET(element_p->id),
+                                      NULL);
+
+        if (NULL != param_descr_p)
+        {
+            if (PARAMID_OK(element_p->id, param_descr_p))
+            {
+                (*param_descr_p->array[PARAMID_TO_INDEX(element_p->id)].free_func)
+                    (element_p->value_p);
+            }
+            else
+            {
+                MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                                    ("param id not ok, element not freed\n"));
+                set_errno(E_MPL_INVALID_PARAMETER);
+            }
+        }
+        else
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                                ("param descr set not found, element not freed\n"));
+            set_errno(E_MPL_INVALID_PARAMETER);
+        }
+    }
+
+    free(element_p);
 }
 
-int mpl_param_list_field_count_tag( mpl_param_element_id_t context,
-                                    int id_in_context,
-                                    int tag,
-                                    mpl_list_t *param_list_p )
+int mpl_param_list_pack(mpl_list_t *param_list_p,
+                        char *buf_p,
+                        int buflen)
 {
-    mpl_param_element_t* param_elem_p;
-    int count = 0;
-
-    param_elem_p = mpl_param_list_find_field_tag(context,
-                                                 id_in_context,
-                                                 tag,
-                                                 param_list_p);
-    if (NULL != param_elem_p)
-        count++;
+    mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
+    options.no_prefix = false;
+    return mpl_param_list_pack_extended(param_list_p,
+                                        buf_p,
+                                        buflen,
+                                        &options);
+}
 
-    while (NULL != param_elem_p)
-    {
-        param_elem_p = mpl_param_list_find_field_next_tag(context,
-                                                          id_in_context,
-                                                          tag,
-                                                          param_elem_p);
-        if (NULL != param_elem_p)
-            count++;
-    }
-    return count;
+int mpl_param_list_pack_no_prefix(mpl_list_t *param_list_p,
+                                  char *buf_p,
+                                  int buflen)
+{
+    mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
+    options.no_prefix = true;
+    return mpl_param_list_pack_extended(param_list_p,
+                                        buf_p,
+                                        buflen,
+                                        &options);
 }
 
 /**
- * mpl_param_list_string_tuple_key_find
- *
+ * mpl_param_list_pack_extended
  */
-mpl_param_element_t*
-    mpl_param_list_string_tuple_key_find( mpl_param_element_id_t param_id,
-                                          char *key_p,
-                                          mpl_list_t *param_list_p )
+int mpl_param_list_pack_extended(mpl_list_t *param_list_p,
+                                 char *buf_p,
+                                 int buflen,
+                                 const mpl_pack_options_t *options_p)
 {
-    mpl_param_element_t *param_elem_p;
-    mpl_string_tuple_t *st_p;
+    int total_len = 0;
+    int tmplen;
+    mpl_list_t *elem_p;
+    mpl_param_element_t* param_elem_p;
+    mpl_pack_options_t options = *options_p;
 
-    if (mpl_param_id_get_type(param_id) != mpl_type_string_tuple)
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
-                            ("Invalid type '%s'\n",
-                             mpl_param_id_get_type_string(param_id)));
-        set_errno(E_MPL_INVALID_PARAMETER);
-        return NULL;
-    }
+    if (!options.force_field_pack_mode)
+        options.field_pack_mode = field_pack_mode_context;
 
-    if ((NULL == key_p) || (0 == strlen(key_p)))
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Invalid key_p\n"));
-        set_errno(E_MPL_INVALID_PARAMETER);
-        return NULL;
-    }
+    /* Make sure we always terminate the buffer */
+    if ((NULL != buf_p) && (buflen > 0))
+        buf_p[0] = '\0';
 
-    param_elem_p = mpl_param_list_find(param_id, param_list_p);
-    while (NULL != param_elem_p)
+    /* Loop over all parameters in parameter list and pack them */
+    /*lint -esym(613, buf_p) */
+    MPL_LIST_FOR_EACH(param_list_p, elem_p)
     {
-        st_p = MPL_GET_VALUE_PTR_FROM_PARAM_ELEMENT(mpl_string_tuple_t*,
-                                                    param_elem_p);
-        if ((NULL != st_p) &&
-            (NULL != st_p->key_p) &&
-            (strlen(st_p->key_p) == strlen(key_p)) &&
-            !strncmp(st_p->key_p, key_p, strlen(key_p)))
-            return param_elem_p;
+        /* Add a delimiter between all parameters */
+        if (total_len > 0)
+        {
+            if ((total_len + 1) < buflen)
+            {
+                buf_p[total_len] = options.message_delimiter;
+                buf_p[total_len + 1] = '\0';
+            }
+            total_len++;
+        }
 
-        param_elem_p = mpl_param_list_find_next(param_id, param_elem_p);
+        param_elem_p = MPL_LIST_CONTAINER(elem_p, mpl_param_element_t, list_entry);
+        tmplen = mpl_param_pack_internal(param_elem_p,
+                                         (total_len < buflen)?buf_p+total_len:NULL,
+                                         (total_len < buflen)?buflen-total_len:0,
+                                         &options);
+        if (tmplen < 0)
+            return tmplen;
+
+        total_len += tmplen;
     }
-    return NULL;
+
+    return total_len;
 }
 
+/**
+ * mpl_param_list_packed_size
+ */
+int mpl_param_list_packed_size(mpl_list_t *param_list_p)
+{
+    mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
+    options.no_prefix = false;
+    return mpl_param_list_packed_size_extended(param_list_p, &options);
+}
 
 /**
- * mpl_param_list_strint_tuple_key_find
- *
+ * mpl_param_list_packed_size_extended
  */
-mpl_param_element_t*
-    mpl_param_list_strint_tuple_key_find( mpl_param_element_id_t param_id,
-                                          char *key_p,
-                                          mpl_list_t *param_list_p )
+int mpl_param_list_packed_size_extended(mpl_list_t *param_list_p,
+                                        const mpl_pack_options_t *options_p)
 {
-    mpl_param_element_t *param_elem_p;
-    mpl_strint_tuple_t *st_p;
+    mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
+    mpl_list_t *elem_p;
+    mpl_param_element_t* param_elem_p;
+    int total_len = 0;
+    int tmplen;
 
-    if (mpl_param_id_get_type(param_id) != mpl_type_strint_tuple)
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
-                            ("Invalid type '%s'\n",
-                             mpl_param_id_get_type_string(param_id)));
-        set_errno(E_MPL_INVALID_PARAMETER);
-        return NULL;
-    }
+    if (NULL != options_p)
+        options = *options_p;
+    if (!options.force_field_pack_mode)
+        options.field_pack_mode = field_pack_mode_context;
 
-    if ((NULL == key_p) || (0 == strlen(key_p)))
+    MPL_LIST_FOR_EACH(param_list_p, elem_p)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Invalid key_p\n"));
-        set_errno(E_MPL_INVALID_PARAMETER);
-        return NULL;
-    }
+        /* A delimiter between all parameters */
+        if (total_len > 0)
+            total_len++;
 
-    param_elem_p = mpl_param_list_find(param_id, param_list_p);
-    while (NULL != param_elem_p)
-    {
-        st_p = MPL_GET_VALUE_PTR_FROM_PARAM_ELEMENT(mpl_strint_tuple_t*,
-                                                    param_elem_p);
-        if ((NULL != st_p) &&
-            (NULL != st_p->key_p) &&
-            (strlen(st_p->key_p) == strlen(key_p)) &&
-            !strncmp(st_p->key_p, key_p, strlen(key_p)))
-            return param_elem_p;
+        param_elem_p = MPL_LIST_CONTAINER(elem_p, mpl_param_element_t, list_entry);
+        tmplen = mpl_param_packed_size_internal(param_elem_p, &options);
+        if (tmplen < 0)
+            return tmplen;
 
-        param_elem_p = mpl_param_list_find_next(param_id, param_elem_p);
+        total_len += tmplen;
     }
-    return NULL;
+
+    return total_len;
+}
+
+/* for backward compatibility */
+int mpl_param_list_pack_internal(mpl_list_t *param_list_p,
+                                 char *buf_p,
+                                 int buflen,
+                                 char message_delimiter,
+                                 bool no_prefix)
+{
+    mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
+    options.no_prefix = no_prefix;
+    options.message_delimiter = message_delimiter;
+    return mpl_param_list_pack_extended(param_list_p,
+                                        buf_p,
+                                        buflen,
+                                        &options);
 }
 
 /**
- * mpl_param_list_struint8_tuple_key_find
+ * mpl_param_list_pack_stream
  *
  */
-mpl_param_element_t*
-    mpl_param_list_struint8_tuple_key_find( mpl_param_element_id_t param_id,
-                                            char *key_p,
-                                            mpl_list_t *param_list_p )
+int mpl_param_list_pack_stream(mpl_list_t *param_list_p,
+                               mpl_pack_write_fp write_func,
+                               void *ctx_p,
+                               const mpl_pack_options_t *options_p)
 {
-    mpl_param_element_t *param_elem_p;
-    mpl_struint8_tuple_t *st_p;
+    mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
+    mpl_list_t *elem_p;
+    mpl_param_element_t* param_elem_p;
+    char *batch_p;
+    size_t batch_size = MPL_PACK_STREAM_BATCH_SIZE;
+    size_t used = 0;
+    int total_len = 0;
+    int tmplen;
 
-    if (mpl_param_id_get_type(param_id) != mpl_type_struint8_tuple)
+    if (NULL == write_func)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
-                            ("Invalid type '%s'\n",
-                             mpl_param_id_get_type_string(param_id)));
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("write_func is NULL\n"));
         set_errno(E_MPL_INVALID_PARAMETER);
-        return NULL;
+        return (-1);
     }
 
-    if ((NULL == key_p) || (0 == strlen(key_p)))
+    if (NULL != options_p)
+        options = *options_p;
+    if (!options.force_field_pack_mode)
+        options.field_pack_mode = field_pack_mode_context;
+
+    /* Temporary, so not from the arena */
+    batch_p = heap_malloc(batch_size);
+    if (NULL == batch_p)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Invalid key_p\n"));
-        set_errno(E_MPL_INVALID_PARAMETER);
-        return NULL;
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return (-1);
     }
 
-    param_elem_p = mpl_param_list_find(param_id, param_list_p);
-    while (NULL != param_elem_p)
+    MPL_LIST_FOR_EACH(param_list_p, elem_p)
     {
-        st_p = MPL_GET_VALUE_PTR_FROM_PARAM_ELEMENT(mpl_struint8_tuple_t*,
-                                                    param_elem_p);
-        if ((NULL != st_p) &&
-            (NULL != st_p->key_p) &&
-            (strlen(st_p->key_p) == strlen(key_p)) &&
-            !strncmp(st_p->key_p, key_p, strlen(key_p)))
-            return param_elem_p;
-
-        param_elem_p = mpl_param_list_find_next(param_id, param_elem_p);
-    }
-    return NULL;
-}
+        /* Add a delimiter between all parameters */
+        if (total_len > 0)
+        {
+            if ((used + 1) >= batch_size)
+            {
+                if (pack_stream_flush(write_func, ctx_p, batch_p, used) < 0)
+                    goto error_return;
+                used = 0;
+            }
+            batch_p[used++] = options.message_delimiter;
+            total_len++;
+        }
 
-/**
- * mpl_param_list_int_tuple_key_find
+        param_elem_p = MPL_LIST_CONTAINER(elem_p, mpl_param_element_t, list_entry);
+        tmplen = mpl_param_pack_internal(param_elem_p,
+                                         batch_p + used,
+                                         (int)(batch_size - used),
+                                         &options);
+        if (tmplen < 0)
+            goto error_return;
+
+        if ((size_t)tmplen >= (batch_size - used))
+        {
+            /* Did not fit, flush the batch and pack the parameter again */
+            if (pack_stream_flush(write_func, ctx_p, batch_p, used) < 0)
+                goto error_return;
+            used = 0;
+
+            if ((size_t)tmplen >= batch_size)
+            {
+                while ((size_t)tmplen >= batch_size)
+                    batch_size *= 2;
+                heap_free(batch_p);
+                batch_p = heap_malloc(batch_size);
+                if (NULL == batch_p)
+                {
+                    MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                                        ("Failed allocating memory\n"));
+                    set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+                    return (-1);
+                }
+            }
+
+            tmplen = mpl_param_pack_internal(param_elem_p,
+                                             batch_p,
+                                             (int)batch_size,
+                                             &options);
+            if (tmplen < 0)
+                goto error_return;
+        }
+
+        used += (size_t)tmplen;
+        total_len += tmplen;
+    }
+
+    if (pack_stream_flush(write_func, ctx_p, batch_p, used) < 0)
+        goto error_return;
+
+    heap_free(batch_p);
+    return total_len;
+
+error_return:
+    heap_free(batch_p);
+    return (-1);
+}
+
+/**
+ * mpl_param_list_pack_alloc
  *
  */
-mpl_param_element_t*
-    mpl_param_list_int_tuple_key_find( mpl_param_element_id_t param_id,
-                                       int key,
-                                       mpl_list_t *param_list_p )
+char *mpl_param_list_pack_alloc(mpl_list_t *param_list_p,
+                                const mpl_pack_options_t *options_p,
+                                size_t *len_p)
 {
-    mpl_param_element_t *param_elem_p;
-    mpl_int_tuple_t *it_p;
+    mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
+    char *buf_p;
+    int len;
 
-    if (mpl_param_id_get_type(param_id) != mpl_type_int_tuple)
+    if (NULL != options_p)
+        options = *options_p;
+
+    len = mpl_param_list_packed_size_extended(param_list_p, &options);
+    if (len < 0)
+        return NULL;
+
+    buf_p = heap_malloc((size_t)len + 1);
+    if (NULL == buf_p)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
-                            ("Invalid type '%s'\n",
-                             mpl_param_id_get_type_string(param_id)));
-        set_errno(E_MPL_INVALID_PARAMETER);
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
         return NULL;
     }
 
-    param_elem_p = mpl_param_list_find(param_id, param_list_p);
-    while (NULL != param_elem_p)
+    if (mpl_param_list_pack_extended(param_list_p,
+                                     buf_p,
+                                     len + 1,
+                                     &options) != len)
     {
-        it_p = MPL_GET_VALUE_PTR_FROM_PARAM_ELEMENT(mpl_int_tuple_t*,
-                                                    param_elem_p);
-        if ((NULL != it_p) && (it_p->key == key))
-            return param_elem_p;
-
-        param_elem_p = mpl_param_list_find_next(param_id, param_elem_p);
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Packed size does not match\n"));
+        set_errno(E_MPL_FAILED_OPERATION);
+        heap_free(buf_p);
+        return NULL;
     }
-    return NULL;
-}
 
+    if (NULL != len_p)
+        *len_p = (size_t)len;
+    return buf_p;
+}
 
-mpl_param_element_t*
-    mpl_param_list_string_tuple_find( mpl_param_element_id_t param_id,
-                                      char *key_p,
-                                      char *value_p,
-                                      mpl_list_t *param_list_p )
+mpl_list_t *mpl_param_list_unpack(char *buf_p)
 {
-    mpl_param_element_t* param_elem_p;
-    mpl_string_tuple_t *st_p;
-
-    param_elem_p = mpl_param_list_string_tuple_key_find(param_id,
-                                                        key_p,
-                                                        param_list_p);
-    while (NULL != param_elem_p)
-    {
-        st_p = MPL_GET_VALUE_PTR_FROM_PARAM_ELEMENT(mpl_string_tuple_t*,
-                                                    param_elem_p);
-        if ((NULL != st_p) &&
-            (NULL != st_p->value_p) &&
-            (strlen(st_p->value_p) == strlen(value_p)) &&
-            !strncmp(st_p->value_p, value_p, strlen(value_p)))
-            return param_elem_p;
-
-        param_elem_p =
-            mpl_param_list_string_tuple_key_find(param_id,
-                                                 key_p,
-                                                 param_elem_p->list_entry.next_p);
-    }
-    return NULL;
+    mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
+    return mpl_param_list_unpack_internal(buf_p,
+                                          &options,
+                                          MPL_PARAM_ID_UNDEFINED,
+                                          NULL);
 }
 
-mpl_param_element_t*
-    mpl_param_list_strint_tuple_find( mpl_param_element_id_t param_id,
-                                      char *key_p,
-                                      int value,
-                                      mpl_list_t *param_list_p )
+mpl_list_t *mpl_param_list_unpack_error(char *buf_p, bool *has_error_p)
 {
-    mpl_param_element_t* param_elem_p;
-    mpl_strint_tuple_t *it_p;
+    mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
+    return mpl_param_list_unpack_internal(buf_p,
+                                          &options,
+                                          MPL_PARAM_ID_UNDEFINED,
+                                          has_error_p);
+}
 
-    param_elem_p = mpl_param_list_strint_tuple_key_find(param_id,
-                                                        key_p,
-                                                        param_list_p);
-    while (NULL != param_elem_p)
-    {
-        it_p = MPL_GET_VALUE_PTR_FROM_PARAM_ELEMENT(mpl_strint_tuple_t*,
-                                                    param_elem_p);
-        if ((NULL != it_p) && (it_p->value == value))
-            return param_elem_p;
+mpl_list_t *mpl_param_list_unpack_param_set(char *buf_p, int param_set_id)
+{
+    mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
+    options.param_set_id = param_set_id;
+    return mpl_param_list_unpack_internal(buf_p,
+                                          &options,
+                                          MPL_PARAM_ID_UNDEFINED,
+                                          NULL);
+}
 
-        param_elem_p =
-            mpl_param_list_strint_tuple_key_find(param_id,
-                                                 key_p,
-                                                 param_elem_p->list_entry.next_p);
-    }
-    return NULL;
+mpl_list_t *mpl_param_list_unpack_param_set_error(char *buf_p,
+                                                  int param_set_id,
+                                                  bool *has_error_p)
+{
+    mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
+    options.param_set_id = param_set_id;
+    return mpl_param_list_unpack_internal(buf_p,
+                                          &options,
+                                          MPL_PARAM_ID_UNDEFINED,
+                                          has_error_p);
 }
 
-mpl_param_element_t*
-    mpl_param_list_struint8_tuple_find( mpl_param_element_id_t param_id,
-                                        char *key_p,
-                                        uint8_t value,
-                                        mpl_list_t *param_list_p )
+mpl_list_t *mpl_param_list_unpack_in_place(char *buf_p,
+                                           int param_set_id,
+                                           bool *has_error_p)
 {
-    mpl_param_element_t* param_elem_p;
-    mpl_struint8_tuple_t *it_p;
+    mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
 
-    param_elem_p = mpl_param_list_struint8_tuple_key_find(param_id,
-                                                          key_p,
-                                                          param_list_p);
-    while (NULL != param_elem_p)
+    if (NULL == buf_p)
     {
-        it_p = MPL_GET_VALUE_PTR_FROM_PARAM_ELEMENT(mpl_struint8_tuple_t*,
-                                                    param_elem_p);
-        if ((NULL != it_p) && (it_p->value == value))
-            return param_elem_p;
-
-        param_elem_p =
-            mpl_param_list_strint_tuple_key_find(param_id,
-                                                 key_p,
-                                                 param_elem_p->list_entry.next_p);
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("buf_p is NULL\n"));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        if (has_error_p != NULL)
+            *has_error_p = true;
+        return NULL;
     }
-    return NULL;
+
+    options.param_set_id = param_set_id;
+    options.string_views = true;
+    return param_list_unpack_buf(buf_p,
+                                 &options,
+                                 MPL_PARAM_ID_UNDEFINED,
+                                 has_error_p);
 }
 
-mpl_param_element_t*
-    mpl_param_list_int_tuple_find( mpl_param_element_id_t param_id,
-                                   int key,
-                                   int value,
-                                   mpl_list_t *param_list_p )
+/**
+ * mpl_param_list_unpack_internal - unpack packed parameter list
+ *
+ **/
+mpl_list_t *mpl_param_list_unpack_internal(char *buf_p,
+                                           const mpl_pack_options_t *options_p,
+                                           mpl_param_element_id_t unpack_context,
+                                           bool *has_error_p)
 {
-    mpl_param_element_t* param_elem_p;
-    mpl_int_tuple_t *it_p;
+    mpl_list_t *param_list_p;
+    mpl_pack_options_t options;
+    char *tmp_buf_p;
 
-    param_elem_p = mpl_param_list_int_tuple_key_find(param_id,
-                                                     key,
-                                                     param_list_p);
-    while (NULL != param_elem_p)
+    if (NULL == buf_p)
     {
-        it_p = MPL_GET_VALUE_PTR_FROM_PARAM_ELEMENT(mpl_int_tuple_t*,
-                                                    param_elem_p);
-        if ((NULL != it_p) && (it_p->value == value))
-            return param_elem_p;
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("buf_p is NULL\n"));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        if (has_error_p != NULL)
+            *has_error_p = true;
+        return NULL;
+    }
 
-        param_elem_p =
-            mpl_param_list_int_tuple_key_find(param_id,
-                                              key,
-                                              param_elem_p->list_entry.next_p);
+    tmp_buf_p = malloc(strlen(buf_p) + 1);
+    if (NULL == tmp_buf_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        if (has_error_p != NULL)
+            *has_error_p = true;
+        return NULL;
     }
-    return NULL;
-}
+    strcpy(tmp_buf_p, buf_p);
 
+    /* Views would point into tmp_buf_p */
+    options = *options_p;
+    options.string_views = false;
 
+    param_list_p = param_list_unpack_buf(tmp_buf_p,
+                                         &options,
+                                         unpack_context,
+                                         has_error_p);
+    free(tmp_buf_p);
+    return param_list_p;
+}
 
 /**
- * mpl_param_list_tuple_key_find_wildcard
+ * param_list_unpack_buf
+ *
+ * Unpack a packed parameter list, splitting buf_p in place.
  *
  */
-mpl_param_element_t*
-    mpl_param_list_tuple_key_find_wildcard( mpl_param_element_id_t param_id,
-                                            char *key_p,
-                                            char *wildcard_p,
-                                            mpl_list_t *param_list_p )
+static mpl_list_t *param_list_unpack_buf(char *buf_p,
+                                         const mpl_pack_options_t *options_p,
+                                         mpl_param_element_id_t unpack_context,
+                                         bool *has_error_p)
 {
-    mpl_param_element_t *param_elem_p;
+    mpl_list_t *param_list_p = NULL;
 
-    if (mpl_param_id_get_type(param_id) != mpl_type_string_tuple)
+    if (NULL == param_list_parse(buf_p,
+                                 options_p,
+                                 unpack_context,
+                                 false,
+                                 &param_list_p))
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
-                            ("Invalid type '%s'\n",
-                             mpl_param_id_get_type_string(param_id)));
-        set_errno(E_MPL_INVALID_PARAMETER);
+        if (has_error_p != NULL)
+            *has_error_p = true;
         return NULL;
     }
 
-    param_elem_p = mpl_param_list_tuple_key_find(param_id, key_p, param_list_p);
-    if (NULL != param_elem_p)
-        return param_elem_p;
+    if (has_error_p != NULL)
+        *has_error_p = false;
+    return param_list_p;
+}
 
-    return mpl_param_list_tuple_key_find(param_id, wildcard_p, param_list_p);
-}
+/**
+ * param_list_parse
+ *
+ * Unpack the parameters of a packed list, walking p once and splitting
+ * it in place. The value of a bag is unpacked by a recursive call when
+ * its '{' is reached, so nested bags are neither copied nor scanned
+ * again. A nested list ends at its matching '}'; braces are matched
+ * even when escaped, as strings are packed without escaping them.
+ *
+ * Keys and values are trimmed, and empty parameters are skipped, as by
+ * mpl_get_args_2(). The parameters are added to *param_list_pp (in the
+ * order of mpl_param_list_unpack()), which is destroyed on error.
+ *
+ * Returns where the list ended (the '}' of a nested list, which may have
+ * been overwritten by the '\0' of the last value), or NULL on error.
+ */
+static char *param_list_parse(char *p,
+                              const mpl_pack_options_t *options_p,
+                              mpl_param_element_id_t unpack_context,
+                              bool nested,
+                              mpl_list_t **param_list_pp)
+{
+    const char delimiter = options_p->message_delimiter;
+    const char escape = '\\';
+    const char close = nested ? '}' : '\0';
+    mpl_pack_options_t value_options;
+    mpl_param_element_t *param_elem_p;
+    mpl_param_descr_set_t *param_descr_p;
+    mpl_list_t *bag_p;
+    char *key_p;
+    char *key_end_p;
+    char *value_p;
+    char *value_end_p;
+    char *end_p;
+    char c;
+    int depth;
+    int value_depth = 0;
+    int index;
 
+    for (;;)
+    {
+        /* Skip space and empty parameters */
+        while ((*p == delimiter) || isspace((unsigned char)*p))
+            p++;
+        c = *p;
+        if ((c == '\0') || (c == close))
+            break;
 
-/**
- * mpl_pack_param_value_string()
- **/
-int mpl_pack_param_value_string(const void* param_value_p,
-                                char *buf,
-                                size_t buflen,
-                                const mpl_param_descr2_t *descr_p,
-                                const mpl_pack_options_t *options_p)
-{
-    assert(NULL != param_value_p);
+        /* The key, up to '=', the delimiter or the end of the list */
+        key_p = p;
+        key_end_p = p;
+        while ((*p != '\0') && (*p != '=') && (*p != delimiter) && (*p != close))
+        {
+            if ((*p == escape) && (p[1] != '\0'))
+                p++;
+            else if (isspace((unsigned char)*p))
+            {
+                p++;
+                continue;
+            }
+            p++;
+            key_end_p = p;
+        }
 
-    return snprintf_escape(options_p->message_delimiter, '\\',
-                           buf, buflen, "=%s", (char*)param_value_p);
-}
+        value_p = NULL;
+        c = *p;
+        if (c == '=')
+        {
+            *key_end_p = '\0';
+            p++;
+            while ((*p != delimiter) && isspace((unsigned char)*p))
+                p++;
+            value_p = p;
+        }
+        else
+        {
+            /* No value */
+            *key_end_p = '\0';
+        }
 
-/**
- * mpl_unpack_param_value_string()
- **/
-int
-    mpl_unpack_param_value_string(const char* value_str, void **value_pp,
-                                  const mpl_param_descr2_t *descr_p,
-                                  const mpl_pack_options_t *options_p,
-                                  mpl_param_element_id_t unpack_context)
-{
-    char* p;
-    size_t size;
-    char *temp_str;
-    int temp_string_allocated = 0;
-    const int *max_p = descr_p->max_p;
-    const int *min_p = descr_p->min_p;
+        if (param_unpack_key(key_p, options_p, unpack_context, &param_elem_p) < 0)
+            goto error_return;
 
-    MPL_IDENTIFIER_NOT_USED(options_p);
-    MPL_IDENTIFIER_NOT_USED(unpack_context);
+        if ((NULL != value_p) && (*value_p == '{'))
+        {
+            end_p = NULL;
+            param_descr_p = paramset_find(MPL_PARAMID_TO_PARAMSET(param_elem_p->id),
+                                          NULL);
+            index = PARAMID_TO_INDEX(param_elem_p->id);
+            if (param_descr_p->array[index].unpack_func ==
+                mpl_unpack_param_value_bag)
+            {
+                /* Unpack the bag contents in place */
+                bag_p = NULL;
+                end_p = param_list_parse(value_p + 1,
+                                         options_p,
+                                         param_elem_p->id,
+                                         true,
+                                         &bag_p);
+                if (NULL == end_p)
+                {
+                    MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                        ("Param unpack failed for param: %s\n",
+                                         key_p));
+                    mpl_param_element_destroy(param_elem_p);
+                    goto error_return;
+                }
+                param_elem_p->value_p = bag_p;
+                if (check_bag_len(bag_p, &param_descr_p->array2[index]) < 0)
+                {
+                    mpl_param_element_destroy(param_elem_p);
+                    goto error_return;
+                }
+            }
+            else
+            {
+                /* Any other bracketed value, up to the matching '}' */
+                depth = 0;
+                for (end_p = value_p; *end_p != '\0'; end_p++)
+                {
+                    if ((*end_p == escape) && (end_p[1] != '\0') &&
+                        (end_p[1] != '{') && (end_p[1] != '}'))
+                        end_p++;
+                    else if (*end_p == '{')
+                        depth++;
+                    else if ((*end_p == '}') && (--depth == 0))
+                        break;
+                }
+                if (*end_p == '\0')
+                {
+                    MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                        ("Unpack failed, no matching '}': %s\n",
+                                         value_p));
+                    set_errno(E_MPL_FAILED_OPERATION);
+                    mpl_param_element_destroy(param_elem_p);
+                    goto error_return;
+                }
 
+                /* Terminated temporarily, so no views of it */
+                c = end_p[1];
+                end_p[1] = '\0';
+                value_options = *options_p;
+                value_options.string_views = false;
+                if (param_unpack_value(param_elem_p,
+                                       key_p,
+                                       value_p,
+                                       &value_options) < 0)
+                {
+                    end_p[1] = c;
+                    mpl_param_element_destroy(param_elem_p);
+                    goto error_return;
+                }
+                end_p[1] = c;
+            }
 
-    if (strchr(value_str, '\\')) {
-        temp_str = remove_escape(value_str, '\\');
-        if (temp_str == NULL) {
-            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                                ("Failed allocating memory\n"));
-            set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-            return (-1);
+            /* Only space may follow, up to the next parameter */
+            p = end_p + 1;
+            while ((*p != delimiter) && isspace((unsigned char)*p))
+                p++;
+            c = *p;
+            if ((c != '\0') && (c != delimiter) && (c != close))
+            {
+                MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                    ("Unpack failed, garbage after '}': %s\n",
+                                     p));
+                set_errno(E_MPL_FAILED_OPERATION);
+                mpl_param_element_destroy(param_elem_p);
+                goto error_return;
+            }
         }
-        temp_string_allocated = 1;
-    }
-    else {
-        temp_str = (char*) value_str;
-    }
+        else if (NULL != value_p)
+        {
+            /*
+             * The value, up to the delimiter or the end of the list. In a
+             * nested list the braces of the values are counted (over all
+             * of them, as the '}' of the list is matched), and only a '}'
+             * outside of them ends the list. Escaped braces are counted
+             * too, as they are not escaped when packed.
+             */
+            value_end_p = p;
+            while ((*p != '\0') && (*p != delimiter) &&
+                   ((*p != close) || (value_depth > 0)))
+            {
+                if ((*p == escape) && (p[1] != '\0') &&
+                    (!nested || ((p[1] != '{') && (p[1] != '}'))))
+                    p++;
+                else if (isspace((unsigned char)*p))
+                {
+                    p++;
+                    continue;
+                }
+                else if (nested && (*p == '{'))
+                    value_depth++;
+                else if (nested && (*p == '}'))
+                    value_depth--;
+                p++;
+                value_end_p = p;
+            }
+            c = *p;
+            *value_end_p = '\0';
 
-    if ((max_p != NULL) &&
-        ((int)strlen(temp_str) > *max_p))
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack string failed on max length check: %zu > %d\n",
-                             strlen(temp_str), *max_p));/*lint !e557 %zu is C99 */
-        set_errno(E_MPL_FAILED_OPERATION);
-        if (temp_string_allocated)
-            free(temp_str);
-        return (-1);
+            if (param_unpack_value(param_elem_p, key_p, value_p, options_p) < 0)
+            {
+                MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                    ("Param unpack failed for param: %s=%s\n",
+                                     key_p,
+                                     value_p));
+                mpl_param_element_destroy(param_elem_p);
+                goto error_return;
+            }
+        }
+
+        mpl_list_add(param_list_pp, &param_elem_p->list_entry);
+
+        /* c is what was at p, before a value was terminated there */
+        if (c != delimiter)
+            break;
+        p++;
     }
 
-    if ((min_p != NULL) &&
-        ((int)strlen(temp_str) < *min_p))
+    if ((c != close) || (value_depth != 0))
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack string failed on min length check: %zu < %d\n",
-                             strlen(temp_str), *min_p));/*lint !e557 %zu is C99 */
+                            ("Unpack list failed, no closing '}'\n"));
         set_errno(E_MPL_FAILED_OPERATION);
-        if (temp_string_allocated)
-            free(temp_str);
-        return (-1);
+        goto error_return;
     }
+    return p;
 
-    size = strlen(temp_str)+1;
-    p = malloc(size);
-    if (NULL == p)
+error_return:
+    mpl_param_list_destroy(param_list_pp);
+    return NULL;
+}
+
+/**
+ * mpl_unpack_stream_create
+ *
+ */
+mpl_unpack_stream_t *mpl_unpack_stream_create(const mpl_pack_options_t *options_p,
+                                              char message_terminator,
+                                              mpl_unpack_element_fp element_func,
+                                              mpl_unpack_message_fp message_func,
+                                              void *ctx_p)
+{
+    mpl_unpack_stream_t *stream_p;
+    mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
+
+    if (NULL != options_p)
+        options = *options_p;
+
+    /* The text buffer is reused */
+    options.string_views = false;
+
+    stream_p = heap_calloc(1, sizeof(mpl_unpack_stream_t));
+    if (NULL == stream_p)
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
                             ("Failed allocating memory\n"));
         set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        if (temp_string_allocated)
-            free(temp_str);
-        return (-1);
+        return NULL;
     }
 
-    strncpy(p, temp_str, size);
-    if (temp_string_allocated)
-        free(temp_str);
-    *value_pp = p;
-
-    return (0);
+    stream_p->options = options;
+    stream_p->terminator = message_terminator;
+    stream_p->element_func = element_func;
+    stream_p->message_func = message_func;
+    stream_p->ctx_p = ctx_p;
+    return stream_p;
 }
 
 /**
- * mpl_clone_param_value_string()
- **/
-int mpl_clone_param_value_string(void **new_value_pp,
-                                 const void* old_value_p,
-                                 const mpl_param_descr2_t *descr_p)
+ * mpl_unpack_stream_feed
+ *
+ */
+int mpl_unpack_stream_feed(mpl_unpack_stream_t *stream_p,
+                           const char *data_p,
+                           size_t len)
 {
-    size_t size = strlen((char*)old_value_p) + 1;
-    char* p = malloc(size);
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    if (NULL == p)
+    const char *start_p = data_p;
+    const char *p;
+    const char *end_p = data_p + len;
+    char c;
+
+    if ((NULL == stream_p) || ((NULL == data_p) && (len > 0)))
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                            ("stream_p or data_p is NULL\n"));
+        set_errno(E_MPL_INVALID_PARAMETER);
         return (-1);
     }
 
-    strncpy(p, (char*)old_value_p, size);
-    *new_value_pp = p;
+    for (p = data_p; p < end_p; p++)
+    {
+        c = *p;
 
-    return (0);
+        if (stream_p->escaped)
+        {
+            stream_p->escaped = false;
+            continue;
+        }
+
+        if ('\\' == c)
+        {
+            stream_p->escaped = true;
+            continue;
+        }
+
+        if (stream_p->depth > 0)
+        {
+            /* Inside a {} value, only count brackets */
+            if ('{' == c)
+                stream_p->depth++;
+            else if ('}' == c)
+                stream_p->depth--;
+            continue;
+        }
+
+        if ((c == stream_p->options.message_delimiter) ||
+            ((c == stream_p->terminator) && ('\0' != c)))
+        {
+            if ((unpack_stream_append(stream_p, start_p, p - start_p) < 0) ||
+                (unpack_stream_element(stream_p) < 0))
+                return (-1);
+            start_p = p + 1;
+
+            if ((c == stream_p->terminator) &&
+                (unpack_stream_message_end(stream_p) < 0))
+                return (-1);
+            continue;
+        }
+
+        if (!stream_p->in_value)
+        {
+            if ('=' == c)
+                stream_p->in_value = true;
+        }
+        else if (!stream_p->value_started && !isspace((unsigned char)c))
+        {
+            /* Like mpl_get_args_2(), only a value starting with { is bracketed */
+            stream_p->value_started = true;
+            if ('{' == c)
+                stream_p->depth = 1;
+        }
+    }
+
+    return unpack_stream_append(stream_p, start_p, end_p - start_p);
 }
 
 /**
- * mpl_copy_param_value_string()
- **/
-int mpl_copy_param_value_string(void *to_value_p,
-                                const void* from_value_p,
-                                int size,
-                                const mpl_param_descr2_t *descr_p)
+ * mpl_unpack_stream_finish
+ *
+ */
+int mpl_unpack_stream_finish(mpl_unpack_stream_t *stream_p)
 {
-    int real_size = strlen((char*)from_value_p) + 1;
-    MPL_IDENTIFIER_NOT_USED(descr_p);
+    int res = 0;
 
-    if (real_size <= size)
-        strncpy(to_value_p, (char*)from_value_p, real_size);
+    if (NULL == stream_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("stream_p is NULL\n"));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return (-1);
+    }
 
-    return real_size;
+    if (unpack_stream_element(stream_p) < 0)
+        res = -1;
+    if (unpack_stream_message_end(stream_p) < 0)
+        res = -1;
+
+    stream_p->escaped = false;
+    return res;
 }
 
 /**
- * mpl_compare_param_value_string()
- **/
-int mpl_compare_param_value_string(const void *value1_p,
-                                   const void* value2_p,
-                                   const mpl_param_descr2_t *descr_p)
+ * mpl_unpack_stream_destroy
+ *
+ */
+void mpl_unpack_stream_destroy(mpl_unpack_stream_t *stream_p)
 {
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    return strcmp(value1_p, value2_p);
+    if (NULL == stream_p)
+        return;
+
+    mpl_param_list_destroy(&stream_p->param_list_p);
+    heap_free(stream_p->buf_p);
+    heap_free(stream_p);
 }
 
 /**
- * mpl_sizeof_param_value_string()
- **/
-size_t mpl_sizeof_param_value_string(const mpl_param_descr2_t *descr_p)
+ * mpl_param_list_pack_bin
+ */
+int mpl_param_list_pack_bin(mpl_list_t *param_list_p,
+                            uint8_t *buf_p,
+                            int buflen)
 {
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    return 0;
+    uint8_t *body_p = NULL;
+    size_t bodylen = 0;
+    int len;
+
+    if ((NULL != buf_p) && (buflen >= MPL_BIN_HEADER_LEN))
+    {
+        buf_p[0] = MPL_BIN_FORMAT_MAGIC;
+        buf_p[1] = MPL_BIN_FORMAT_VERSION;
+        body_p = buf_p + MPL_BIN_HEADER_LEN;
+        bodylen = buflen - MPL_BIN_HEADER_LEN;
+    }
+
+    len = param_list_pack_bin_body(param_list_p, body_p, bodylen);
+    if (len < 0)
+        return len;
+
+    return (len + MPL_BIN_HEADER_LEN);
 }
 
+mpl_list_t *mpl_param_list_unpack_bin(const uint8_t *buf_p, int buflen)
+{
+    return mpl_param_list_unpack_bin_error(buf_p, buflen, NULL);
+}
 
 /**
- * mpl_pack_param_value_wstring()
+ * mpl_param_list_unpack_bin_error - unpack binary packed parameter list
+ *
  **/
-int mpl_pack_param_value_wstring(const void* param_value_p,
-                                 char *buf,
-                                 size_t buflen,
-                                 const mpl_param_descr2_t *descr_p,
-                                 const mpl_pack_options_t *options_p)
+mpl_list_t *mpl_param_list_unpack_bin_error(const uint8_t *buf_p,
+                                            int buflen,
+                                            bool *has_error_p)
 {
-    mpl_uint32_array_t a;
-    int res;
-
-    assert(NULL != param_value_p);
+    mpl_list_t *param_list_p;
+    bool err = true;
 
-    a.len = wcslen((wchar_t*)param_value_p) + 1;
-    if (sizeof(wchar_t) == sizeof(uint32_t))
+    if ((NULL == buf_p) || (buflen < MPL_BIN_HEADER_LEN))
     {
-        a.arr_p = (uint32_t*)param_value_p;
-    }
-    else if (sizeof(wchar_t) == sizeof(uint16_t))
-    {
-        unsigned int i;
-
-        a.arr_p = malloc(a.len * sizeof(uint32_t));
-        if (NULL == a.arr_p)
-        {
-            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                                ("Failed allocating memory\n"));
-            set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-            return (-1);
-        }
-
-        for (i = 0; i < a.len; i++)
-        {
-            a.arr_p[i] = ((uint16_t*)param_value_p)[i];
-        }
-    }
-    else
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unsupported wchar width: %zu\n",
-                             sizeof(wchar_t)));/*lint !e557 %zu is C99 */
-        set_errno(E_MPL_FAILED_OPERATION);
-        return (-1);
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                            ("buf_p is NULL or too short\n"));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        if (has_error_p != NULL)
+            *has_error_p = true;
+        return NULL;
     }
 
-    res = mpl_pack_param_value_uint32_array(&a,
-                                            buf,
-                                            buflen,
-                                            descr_p,
-                                            options_p);
-
-    if (sizeof(wchar_t) == sizeof(uint16_t))
+    if ((buf_p[0] != MPL_BIN_FORMAT_MAGIC) ||
+        (buf_p[1] == 0) ||
+        (buf_p[1] > MPL_BIN_FORMAT_VERSION))
     {
-        free(a.arr_p);
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                            ("Unsupported binary format: 0x%02x 0x%02x\n",
+                             buf_p[0], buf_p[1]));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        if (has_error_p != NULL)
+            *has_error_p = true;
+        return NULL;
     }
 
-    return res;
-
+    param_list_p = param_list_unpack_bin_body(buf_p + MPL_BIN_HEADER_LEN,
+                                              buflen - MPL_BIN_HEADER_LEN,
+                                              &err);
+    if (has_error_p != NULL)
+        *has_error_p = err;
+    return param_list_p;
 }
 
 /**
- * mpl_unpack_param_value_wstring()
- **/
-int
-    mpl_unpack_param_value_wstring(const char* value_str, void **value_pp,
-                                   const mpl_param_descr2_t *descr_p,
-                                   const mpl_pack_options_t *options_p,
-                                   mpl_param_element_id_t unpack_context)
+ * mpl_param_list_clone
+ */
+mpl_list_t *mpl_param_list_clone(mpl_list_t *param_list_p)
 {
-    mpl_uint32_array_t *a_p;
-    int res;
-    const int *max_p = descr_p->max_p;
-    const int *min_p = descr_p->min_p;
-
-    if ((res = mpl_unpack_param_value_uint32_array(value_str,
-                                                   (void **)&a_p,
-                                                   descr_p,
-                                                   options_p,
-                                                   unpack_context)) < 0)
-    {
-        return res;
-    }
-
-    if ((max_p != NULL) &&
-        ((int)(a_p->len - 1) > *max_p))
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack wstring failed on max length check: %d > %d\n",
-                             a_p->len - 1, *max_p));
-        set_errno(E_MPL_FAILED_OPERATION);
-        mpl_free_param_value_uint32_array(a_p);
-        return (-1);
-    }
+    mpl_list_t *elem_p;
+    mpl_param_element_t *cloned_param_p;
+    mpl_list_t *cloned_list_p=NULL;
 
-    if ((min_p != NULL) &&
-        ((int)(a_p->len - 1) < *min_p))
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack wstring failed on min length check: %d < %d\n",
-                             a_p->len - 1, *min_p));
-        set_errno(E_MPL_FAILED_OPERATION);
-        mpl_free_param_value_uint32_array(a_p);
-        return (-1);
-    }
 
-    if (sizeof(wchar_t) == sizeof(uint16_t))
+    MPL_LIST_FOR_EACH(param_list_p, elem_p)
     {
-        unsigned int i;
-        uint16_t *arr_p;
-
-        arr_p = malloc(a_p->len * sizeof(wchar_t));
-        if (NULL == arr_p)
-        {
-            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                                ("Failed allocating memory\n"));
-            set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-            free(a_p);
-            return (-1);
-        }
-
-        for (i = 0; i < a_p->len; i++)
+        cloned_param_p =
+            mpl_param_element_clone(MPL_LIST_CONTAINER(elem_p,
+                                                       mpl_param_element_t,
+                                                       list_entry));
+        if(cloned_param_p == NULL)
         {
-            arr_p[i] = a_p->arr_p[i];
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,("clone parameter\n"));
+            goto error_return;
         }
-        *value_pp = arr_p;
-        free(a_p->arr_p);
-    }
-    else if (sizeof(wchar_t) == sizeof(uint32_t))
-    {
-        *value_pp = a_p->arr_p;
-    }
-    else
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unsupported wchar width: %zu\n",
-                             sizeof(wchar_t)));/*lint !e557 %zu is C99 */
-        set_errno(E_MPL_FAILED_OPERATION);
-        mpl_free_param_value_uint32_array(a_p);
-        return (-1);
+        mpl_list_append(&cloned_list_p, &cloned_param_p->list_entry);
     }
+    return cloned_list_p;
 
-    free(a_p);
-    return 0;
+error_return:
+    mpl_param_list_destroy(&cloned_list_p);
+    return NULL;
 }
 
 /**
- * mpl_clone_param_value_wstring()
- **/
-int mpl_clone_param_value_wstring(void **new_value_pp,
-                                  const void* old_value_p,
-                                  const mpl_param_descr2_t *descr_p)
+ * mpl_param_list_destroy
+ *
+ */
+void mpl_param_list_destroy( mpl_list_t **param_list_pp )
 {
-    size_t size = wcslen((wchar_t*)old_value_p) + 1;
-    wchar_t* p = malloc(size * sizeof(L'\0'));
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    if (NULL == p)
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        return (-1);
-    }
+    mpl_list_t *elem_p, *tmp_p;
 
-    (void)wcsncpy(p, (wchar_t*)old_value_p, size);
-    *new_value_pp = p;
+    if (NULL == param_list_pp)
+        return;
 
-    return (0);
+    MPL_LIST_FOR_EACH_SAFE(*param_list_pp, elem_p, tmp_p)
+    {
+        (void)mpl_list_remove(param_list_pp, elem_p);
+        mpl_param_element_destroy(MPL_LIST_CONTAINER(elem_p,
+                                                     mpl_param_element_t,
+                                                     list_entry));
+    }
+    *param_list_pp = NULL;
 }
 
 /**
- * mpl_copy_param_value_wstring()
- **/
-int mpl_copy_param_value_wstring(void *to_value_p,
-                                 const void* from_value_p,
-                                 int size,
-                                 const mpl_param_descr2_t *descr_p)
+ * mpl_param_list_find
+ *
+ */
+mpl_param_element_t*
+    mpl_param_list_find( mpl_param_element_id_t param_id,
+                         mpl_list_t *param_list_p )
 {
-    int real_size = (wcslen((wchar_t*)from_value_p) + 1) * sizeof(L'\0');
-    MPL_IDENTIFIER_NOT_USED(descr_p);
+    mpl_param_list_index_t *index_p = list_index_attached(param_list_p);
 
-    if (real_size <= size)
-        (void)wcsncpy(to_value_p, (wchar_t*)from_value_p, real_size / (int)sizeof(L'\0'));
+    if (NULL != index_p)
+        return mpl_param_list_index_find(index_p, param_id);
 
-    return real_size;
+    return param_list_find(param_id, param_list_p);
 }
 
 /**
- * mpl_compare_param_value_wstring()
- **/
-int mpl_compare_param_value_wstring(const void *value1_p,
-                                    const void* value2_p,
-                                    const mpl_param_descr2_t *descr_p)
+ * mpl_param_list_find_tag
+ *
+ */
+mpl_param_element_t*
+    mpl_param_list_find_tag( mpl_param_element_id_t param_id,
+                             int tag,
+                             mpl_list_t *param_list_p )
 {
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    return wcscmp(value1_p, value2_p);
+    mpl_param_list_index_t *index_p = list_index_attached(param_list_p);
+
+    if (NULL != index_p)
+        return mpl_param_list_index_find_tag(index_p, param_id, tag);
+
+    return param_list_find_tag(param_id, tag, param_list_p);
 }
 
 /**
- * mpl_sizeof_param_value_wstring()
- **/
-size_t mpl_sizeof_param_value_wstring(const mpl_param_descr2_t *descr_p)
+ * mpl_param_list_find_all
+ *
+ */
+mpl_list_t*
+    mpl_param_list_find_all( mpl_param_element_id_t param_id,
+                             mpl_list_t *param_list_p )
 {
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    return 0;
-}
+    mpl_param_element_t* param_elem_p;
+    mpl_param_element_t* found_param_elem_p;
+    mpl_list_t* result_list_p = NULL;
 
+    param_elem_p = mpl_param_list_find(param_id, param_list_p);
+    if (NULL != param_elem_p)
+    {
+        found_param_elem_p = mpl_param_element_clone(param_elem_p);
+        if (NULL == found_param_elem_p)
+            goto error_return;
+        mpl_list_add(&result_list_p, &found_param_elem_p->list_entry);
+    }
 
+    while (NULL != param_elem_p)
+    {
+        param_elem_p = mpl_param_list_find_next(param_id, param_elem_p);
+        if (NULL != param_elem_p)
+        {
+            found_param_elem_p = mpl_param_element_clone(param_elem_p);
+            if (NULL == found_param_elem_p)
+                goto error_return;
+            mpl_list_add(&result_list_p, &found_param_elem_p->list_entry);
+        }
+    }
+    return result_list_p;
 
-/**
- * mpl_pack_param_value_int()
- **/
-int mpl_pack_param_value_int(const void* param_value_p,
-                             char *buf,
-                             size_t buflen,
-                             const mpl_param_descr2_t *descr_p,
-                             const mpl_pack_options_t *options_p)
-{
-    assert(NULL != param_value_p);
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    MPL_IDENTIFIER_NOT_USED(options_p)
-        return snprintf(buf, buflen, "=%d", *(int*)param_value_p);
+error_return:
+    mpl_param_list_destroy(&result_list_p);
+    return NULL;
 }
 
 /**
- * mpl_unpack_param_value_int()
- **/
-int
-    mpl_unpack_param_value_int(const char* value_str,
-                               void **value_pp,
-                               const mpl_param_descr2_t *descr_p,
-                               const mpl_pack_options_t *options_p,
-                               mpl_param_element_id_t unpack_context)
+ * mpl_param_list_find_all_tag
+ *
+ */
+mpl_list_t*
+    mpl_param_list_find_all_tag( mpl_param_element_id_t param_id,
+                                 int tag,
+                                 mpl_list_t *param_list_p )
 {
-    int* p;
-    const int *max_p = descr_p->max_p;
-    const int *min_p = descr_p->min_p;
-    int range_id = 0;
-
-    MPL_IDENTIFIER_NOT_USED(options_p);
-    MPL_IDENTIFIER_NOT_USED(unpack_context);
+    mpl_param_element_t* param_elem_p;
+    mpl_param_element_t* found_param_elem_p;
+    mpl_list_t* result_list_p = NULL;
 
-    p = malloc(sizeof(int));
-    if (NULL == p)
+    param_elem_p = mpl_param_list_find_tag(param_id, tag, param_list_p);
+    if (NULL != param_elem_p)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        return (-1);
+        found_param_elem_p = mpl_param_element_clone(param_elem_p);
+        if (NULL == found_param_elem_p)
+            goto error_return;
+        mpl_list_add(&result_list_p, &found_param_elem_p->list_entry);
     }
 
-    if (convert_int(value_str, p) < 0)
+    while (NULL != param_elem_p)
     {
-        free(p);
-        return (-1);
+        param_elem_p = mpl_param_list_find_next_tag(param_id, tag, param_elem_p);
+        if (NULL != param_elem_p)
+        {
+            found_param_elem_p = mpl_param_element_clone(param_elem_p);
+            if (NULL == found_param_elem_p)
+                goto error_return;
+            mpl_list_add(&result_list_p, &found_param_elem_p->list_entry);
+        }
     }
+    return result_list_p;
 
-    if ((max_p != NULL) &&
-        (*p > *max_p))
+error_return:
+    mpl_param_list_destroy(&result_list_p);
+    return NULL;
+}
+
+int mpl_param_list_param_count( mpl_param_element_id_t param_id,
+                                mpl_list_t *param_list_p )
+{
+    mpl_param_element_t* param_elem_p;
+    int count = 0;
+
+    param_elem_p = mpl_param_list_find(param_id, param_list_p);
+    if (NULL != param_elem_p)
+        count++;
+
+    while (NULL != param_elem_p)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack int failed on max check: %d > %d\n",
-                             *p, *max_p));
-        set_errno(E_MPL_FAILED_OPERATION);
-        free(p);
-        return (-1);
+        param_elem_p = mpl_param_list_find_next(param_id, param_elem_p);
+        if (NULL != param_elem_p)
+            count++;
     }
+    return count;
+}
 
-    if ((min_p != NULL) &&
-        (*p < *min_p))
+int mpl_param_list_param_count_tag( mpl_param_element_id_t param_id,
+                                    int tag,
+                                    mpl_list_t *param_list_p )
+{
+    mpl_param_element_t* param_elem_p;
+    int count = 0;
+
+    param_elem_p = mpl_param_list_find_tag(param_id, tag, param_list_p);
+    if (NULL != param_elem_p)
+        count++;
+
+    while (NULL != param_elem_p)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack int failed on min check: %d < %d\n",
-                             *p, *min_p));
-        set_errno(E_MPL_FAILED_OPERATION);
-        free(p);
-        return (-1);
+        param_elem_p = mpl_param_list_find_next_tag(param_id, tag, param_elem_p);
+        if (NULL != param_elem_p)
+            count++;
     }
+    return count;
+}
 
-    if (descr_p->integer_ranges_size > 0) {
-        range_id = check_integer_ranges(*p,
-                                        descr_p->integer_ranges,
-                                        descr_p->integer_ranges_size);
-        if (range_id < 0) {
-            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                                ("Unpack int failed on range check: %d\n",
-                                 *p));
-            set_errno(E_MPL_FAILED_OPERATION);
-            free(p);
-            return (-1);
+mpl_param_element_t*
+    mpl_param_list_find_field( mpl_param_element_id_t context,
+                               int id_in_context,
+                               mpl_list_t *param_list_p )
+{
+    mpl_param_list_index_t *index_p = list_index_attached(param_list_p);
+
+    if (NULL != index_p)
+        return mpl_param_list_index_find_field(index_p, context, id_in_context);
+
+    return param_list_find_field(context, id_in_context, param_list_p);
+}
+
+mpl_param_element_t*
+    mpl_param_list_find_field_tag( mpl_param_element_id_t context,
+                                   int id_in_context,
+                                   int tag,
+                                   mpl_list_t *param_list_p )
+{
+    mpl_param_list_index_t *index_p = list_index_attached(param_list_p);
+
+    if (NULL != index_p)
+        return mpl_param_list_index_find_field_tag(index_p,
+                                                   context,
+                                                   id_in_context,
+                                                   tag);
+
+    return param_list_find_field_tag(context, id_in_context, tag, param_list_p);
+}
+
+/**
+ * mpl_param_list_index_create
+ *
+ */
+mpl_param_list_index_t *mpl_param_list_index_create(mpl_list_t **param_list_pp)
+{
+    return list_index_create(param_list_pp, true);
+}
+
+/**
+ * mpl_param_list_index_destroy
+ *
+ */
+void mpl_param_list_index_destroy(mpl_param_list_index_t *index_p)
+{
+    mpl_list_t *entry_p;
+    mpl_param_list_index_t *other_p;
+    bool head_indexed = false;
+
+    if (NULL == index_p)
+        return;
+
+    if (index_p->attached)
+    {
+        (void)mpl_mutex_lock(mutex);
+        (void)mpl_list_remove(&attached_indexes_p, &index_p->list_entry);
+        MPL_LIST_FOR_EACH(attached_indexes_p, entry_p)
+        {
+            other_p = MPL_LIST_CONTAINER(entry_p,
+                                         mpl_param_list_index_t,
+                                         list_entry);
+            if (other_p->head_p == index_p->head_p)
+                head_indexed = true;
         }
+        (void)mpl_mutex_unlock(mutex);
+
+        /* The list may already be destroyed */
+        if ((NULL != index_p->head_p) &&
+            (*index_p->list_pp == index_p->head_p) &&
+            !head_indexed)
+            MPL_LIST_CONTAINER(index_p->head_p,
+                               mpl_param_element_t,
+                               list_entry)->heads_index = false;
     }
-    assert(NULL != value_pp);
-    *value_pp = p;
 
-    return range_id;
+    free(index_p->entries);
+    free(index_p);
 }
 
 /**
- * mpl_clone_param_value_int()
- **/
-int
-    mpl_clone_param_value_int(void **new_value_pp,
-                              const void* old_value_p,
-                              const mpl_param_descr2_t *descr_p)
+ * mpl_param_list_index_add
+ *
+ */
+int mpl_param_list_index_add(mpl_param_list_index_t *index_p,
+                             mpl_param_element_t *param_elem_p)
 {
-    int* p = malloc(sizeof(int));
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    if (NULL == p)
+    if ((NULL == index_p) || (NULL == param_elem_p))
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                            ("index_p or param_elem_p is NULL\n"));
+        set_errno(E_MPL_INVALID_PARAMETER);
         return (-1);
     }
 
-    *p = *(int*)old_value_p;
-    *new_value_pp = p;
+    if (list_index_insert(index_p, param_elem_p, true) < 0)
+        return (-1);
 
+    mpl_list_add(index_p->list_pp, &param_elem_p->list_entry);
+    list_index_set_head(index_p);
     return (0);
 }
 
 /**
- * mpl_copy_param_value_int()
- **/
-int
-    mpl_copy_param_value_int(void *to_value_p,
-                             const void* from_value_p,
-                             int size,
-                             const mpl_param_descr2_t *descr_p)
+ * mpl_param_list_index_remove
+ *
+ */
+mpl_param_element_t *mpl_param_list_index_remove(mpl_param_list_index_t *index_p,
+                                                 mpl_param_element_t *param_elem_p)
 {
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    if (size >= (int)sizeof(int))
-        *(int*)to_value_p = *(int*)from_value_p;
+    mpl_list_t *next_p;
 
-    return sizeof(int);
+    if ((NULL == index_p) || (NULL == param_elem_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                            ("index_p or param_elem_p is NULL\n"));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return NULL;
+    }
+
+    next_p = param_elem_p->list_entry.next_p;
+    if (NULL == mpl_list_remove(index_p->list_pp, &param_elem_p->list_entry))
+        return NULL;
+
+    list_index_delete(index_p, param_elem_p, next_p);
+    list_index_set_head(index_p);
+    return param_elem_p;
 }
 
 /**
- * mpl_compare_param_value_int()
- **/
-int mpl_compare_param_value_int(const void *value1_p,
-                                const void* value2_p,
-                                const mpl_param_descr2_t *descr_p)
+ * mpl_param_list_index_find
+ *
+ */
+mpl_param_element_t *mpl_param_list_index_find(const mpl_param_list_index_t *index_p,
+                                               mpl_param_element_id_t param_id)
 {
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    return (*((int*) value1_p) != *((int*) value2_p));
+    if (param_has_children(param_id))
+        return param_list_find(param_id, *index_p->list_pp);
+
+    return list_index_slot(index_p, list_key_id, param_id, 0, 0)->first_p;
 }
 
 /**
- * mpl_sizeof_param_value_int()
- **/
-size_t mpl_sizeof_param_value_int(const mpl_param_descr2_t *descr_p)
+ * mpl_param_list_index_find_tag
+ *
+ */
+mpl_param_element_t *mpl_param_list_index_find_tag(const mpl_param_list_index_t *index_p,
+                                                   mpl_param_element_id_t param_id,
+                                                   int tag)
 {
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    return sizeof(int);
-}
-
+    if ((MPL_PARAM_ID_UNDEFINED == param_id) || param_has_children(param_id))
+        return param_list_find_tag(param_id, tag, *index_p->list_pp);
 
+    return list_index_slot(index_p, list_key_id_tag, param_id, 0, tag)->first_p;
+}
 
 /**
- * mpl_pack_param_value_sint8()
- **/
-int mpl_pack_param_value_sint8(const void* param_value_p,
-                               char *buf,
-                               size_t buflen,
-                               const mpl_param_descr2_t *descr_p,
-                               const mpl_pack_options_t *options_p)
+ * mpl_param_list_index_find_field
+ *
+ */
+mpl_param_element_t *mpl_param_list_index_find_field(const mpl_param_list_index_t *index_p,
+                                                     mpl_param_element_id_t context,
+                                                     int id_in_context)
 {
-    assert(NULL != param_value_p);
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    MPL_IDENTIFIER_NOT_USED(options_p)
-        return snprintf(buf, buflen, "=%d", *(sint8_t*)param_value_p);
+    mpl_param_element_id_t field_context;
+
+    field_context = mpl_param_get_bag_field_context(context, id_in_context);
+    if (MPL_PARAM_ID_UNDEFINED == field_context)
+        return param_list_find_field(context,
+                                     id_in_context,
+                                     *index_p->list_pp);
+
+    return list_index_slot(index_p,
+                           list_key_field,
+                           field_context,
+                           id_in_context,
+                           0)->first_p;
 }
 
 /**
- * mpl_unpack_param_value_sint8()
- **/
-int
-    mpl_unpack_param_value_sint8(const char* value_str, void **value_pp,
-                                 const mpl_param_descr2_t *descr_p,
-                                 const mpl_pack_options_t *options_p,
-                                 mpl_param_element_id_t unpack_context)
+ * mpl_param_list_index_find_field_tag
+ *
+ */
+mpl_param_element_t *mpl_param_list_index_find_field_tag(const mpl_param_list_index_t *index_p,
+                                                         mpl_param_element_id_t context,
+                                                         int id_in_context,
+                                                         int tag)
 {
-    int temp;
-    sint8_t* p;
-    const sint8_t *max_p = descr_p->max_p;
-    const sint8_t *min_p = descr_p->min_p;
-    int range_id = 0;
+    mpl_param_element_id_t field_context;
 
-    MPL_IDENTIFIER_NOT_USED(options_p);
-    MPL_IDENTIFIER_NOT_USED(unpack_context);
+    field_context = mpl_param_get_bag_field_context(context, id_in_context);
+    if (MPL_PARAM_ID_UNDEFINED == field_context)
+        return param_list_find_field_tag(context,
+                                         id_in_context,
+                                         tag,
+                                         *index_p->list_pp);
 
-    p = malloc(sizeof(sint8_t));
-    if (NULL == p)
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        return (-1);
-    }
+    return list_index_slot(index_p,
+                           list_key_field_tag,
+                           field_context,
+                           id_in_context,
+                           tag)->first_p;
+}
 
-    if (convert_int(value_str, &temp) < 0)
-    {
-        free(p);
-        return (-1);
-    }
-
-    if ((temp < SCHAR_MIN) ||
-        (temp > (int)SCHAR_MAX))
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack sint8 failed on range check: %d\n", temp));
-        set_errno(E_MPL_FAILED_OPERATION);
-        free(p);
-        return (-1);
-    }
+mpl_list_t*
+    mpl_param_list_find_field_all( mpl_param_element_id_t context,
+                                   int id_in_context,
+                                   mpl_list_t *param_list_p )
+{
+    mpl_param_element_t* param_elem_p;
+    mpl_param_element_t* found_param_elem_p;
+    mpl_list_t* result_list_p = NULL;
 
-    if ((max_p != NULL) &&
-        ((sint8_t)temp > *max_p))
+    param_elem_p = mpl_param_list_find_field(context,
+                                             id_in_context,
+                                             param_list_p);
+    if (NULL != param_elem_p)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack sint8 failed on max check: %d > %d\n",
-                             temp, *max_p));
-        set_errno(E_MPL_FAILED_OPERATION);
-        free(p);
-        return (-1);
+        found_param_elem_p = mpl_param_element_clone(param_elem_p);
+        if (NULL == found_param_elem_p)
+            goto error_return;
+        mpl_list_add(&result_list_p, &found_param_elem_p->list_entry);
     }
 
-    if ((min_p != NULL) &&
-        ((sint8_t)temp < *min_p))
+    while (NULL != param_elem_p)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack sint8 failed on min check: %d < %d\n",
-                             temp, *min_p));
-        set_errno(E_MPL_FAILED_OPERATION);
-        free(p);
-        return (-1);
-    }
-
-    if (descr_p->integer_ranges_size > 0) {
-        range_id = check_integer_ranges(temp,
-                                        descr_p->integer_ranges,
-                                        descr_p->integer_ranges_size);
-        if (range_id < 0) {
-            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                                ("Unpack sint8 failed on range check: %d\n",
-                                 temp));
-            set_errno(E_MPL_FAILED_OPERATION);
-            free(p);
-            return (-1);
+        param_elem_p = mpl_param_list_find_field_next(context,
+                                                      id_in_context,
+                                                      param_elem_p);
+        if (NULL != param_elem_p)
+        {
+            found_param_elem_p = mpl_param_element_clone(param_elem_p);
+            if (NULL == found_param_elem_p)
+                goto error_return;
+            mpl_list_add(&result_list_p, &found_param_elem_p->list_entry);
         }
     }
+    return result_list_p;
 
-    *p = (sint8_t)temp;
-
-    assert(NULL != value_pp);
-    *value_pp = p;
-
-    return range_id;
+error_return:
+    mpl_param_list_destroy(&result_list_p);
+    return NULL;
 }
 
-/**
- * mpl_clone_param_value_sint8()
- **/
-int
-    mpl_clone_param_value_sint8(void **new_value_pp,
-                                const void* old_value_p,
-                                const mpl_param_descr2_t *descr_p)
+mpl_list_t*
+    mpl_param_list_find_field_all_tag( mpl_param_element_id_t context,
+                                       int id_in_context,
+                                       int tag,
+                                       mpl_list_t *param_list_p )
 {
-    sint8_t* p = malloc(sizeof(sint8_t));
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    if (NULL == p)
+    mpl_param_element_t* param_elem_p;
+    mpl_param_element_t* found_param_elem_p;
+    mpl_list_t* result_list_p = NULL;
+
+    param_elem_p = mpl_param_list_find_field_tag(context,
+                                                 id_in_context,
+                                                 tag,
+                                                 param_list_p);
+    if (NULL != param_elem_p)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        return (-1);
+        found_param_elem_p = mpl_param_element_clone(param_elem_p);
+        if (NULL == found_param_elem_p)
+            goto error_return;
+        mpl_list_add(&result_list_p, &found_param_elem_p->list_entry);
     }
 
-    *p = *(sint8_t*)old_value_p;
-    *new_value_pp = p;
+    while (NULL != param_elem_p)
+    {
+        param_elem_p = mpl_param_list_find_field_next_tag(context,
+                                                          id_in_context,
+                                                          tag,
+                                                          param_elem_p);
+        if (NULL != param_elem_p)
+        {
+            found_param_elem_p = mpl_param_element_clone(param_elem_p);
+            if (NULL == found_param_elem_p)
+                goto error_return;
+            mpl_list_add(&result_list_p, &found_param_elem_p->list_entry);
+        }
+    }
+    return result_list_p;
 
-    return (0);
+error_return:
+    mpl_param_list_destroy(&result_list_p);
+    return NULL;
 }
 
-/**
- * mpl_copy_param_value_sint8()
- **/
-int
-    mpl_copy_param_value_sint8(void *to_value_p,
-                               const void* from_value_p,
-                               int size,
-                               const mpl_param_descr2_t *descr_p)
+int mpl_param_list_field_count( mpl_param_element_id_t context,
+                                int id_in_context,
+                                mpl_list_t *param_list_p )
 {
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    if (size >= (int)sizeof(sint8_t))
-        *(sint8_t*)to_value_p = *(sint8_t*)from_value_p;
+    mpl_param_element_t* param_elem_p;
+    int count = 0;
 
-    return sizeof(sint8_t);
-}
+    param_elem_p = mpl_param_list_find_field(context,
+                                             id_in_context,
+                                             param_list_p);
+    if (NULL != param_elem_p)
+        count++;
 
-/**
- * mpl_compare_param_value_sint8()
- **/
-int mpl_compare_param_value_sint8(const void *value1_p,
-                                  const void* value2_p,
-                                  const mpl_param_descr2_t *descr_p)
-{
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    return (*((sint8_t*) value1_p) != *((sint8_t*) value2_p));
+    while (NULL != param_elem_p)
+    {
+        param_elem_p = mpl_param_list_find_field_next(context,
+                                                      id_in_context,
+                                                      param_elem_p);
+        if (NULL != param_elem_p)
+            count++;
+    }
+    return count;
 }
 
+int mpl_param_list_field_count_tag( mpl_param_element_id_t context,
+                                    int id_in_context,
+                                    int tag,
+                                    mpl_list_t *param_list_p )
+{
+    mpl_param_element_t* param_elem_p;
+    int count = 0;
 
+    param_elem_p = mpl_param_list_find_field_tag(context,
+                                                 id_in_context,
+                                                 tag,
+                                                 param_list_p);
+    if (NULL != param_elem_p)
+        count++;
 
-/**
- * mpl_pack_param_value_sint16()
- **/
-int mpl_pack_param_value_sint16(const void* param_value_p,
-                                char *buf,
-                                size_t buflen,
-                                const mpl_param_descr2_t *descr_p,
-                                const mpl_pack_options_t *options_p)
-{
-    assert(NULL != param_value_p);
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    MPL_IDENTIFIER_NOT_USED(options_p)
-        return snprintf(buf, buflen, "=%d", *(sint16_t*)param_value_p);
+    while (NULL != param_elem_p)
+    {
+        param_elem_p = mpl_param_list_find_field_next_tag(context,
+                                                          id_in_context,
+                                                          tag,
+                                                          param_elem_p);
+        if (NULL != param_elem_p)
+            count++;
+    }
+    return count;
 }
 
 /**
- * mpl_unpack_param_value_sint16()
- **/
-int
-    mpl_unpack_param_value_sint16(const char* value_str, void **value_pp,
-                                  const mpl_param_descr2_t *descr_p,
-                                  const mpl_pack_options_t *options_p,
-                                  mpl_param_element_id_t unpack_context)
+ * mpl_param_list_string_tuple_key_find
+ *
+ */
+mpl_param_element_t*
+    mpl_param_list_string_tuple_key_find( mpl_param_element_id_t param_id,
+                                          char *key_p,
+                                          mpl_list_t *param_list_p )
 {
-    int temp;
-    sint16_t* p;
-    const sint16_t *max_p = descr_p->max_p;
-    const sint16_t *min_p = descr_p->min_p;
-    int range_id = 0;
-
-    MPL_IDENTIFIER_NOT_USED(options_p);
-    MPL_IDENTIFIER_NOT_USED(unpack_context);
+    mpl_param_element_t *param_elem_p;
+    mpl_string_tuple_t *st_p;
 
-    p = malloc(sizeof(sint16_t));
-    if (NULL == p)
+    if (mpl_param_id_get_type(param_id) != mpl_type_string_tuple)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        return (-1);
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                            ("Invalid type '%s'\n",
+                             mpl_param_id_get_type_string(param_id)));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return NULL;
     }
 
-    if (convert_int(value_str, &temp) < 0)
+    if ((NULL == key_p) || (0 == strlen(key_p)))
     {
-        free(p);
-        return (-1);
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Invalid key_p\n"));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return NULL;
     }
 
-    if ((temp < SHRT_MIN) ||
-        (temp > (int)SHRT_MAX))
+    param_elem_p = mpl_param_list_find(param_id, param_list_p);
+    while (NULL != param_elem_p)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack sint16 failed on range check: %d\n", temp));
-        set_errno(E_MPL_FAILED_OPERATION);
-        free(p);
-        return (-1);
-    }
+        st_p = MPL_GET_VALUE_PTR_FROM_PARAM_ELEMENT(mpl_string_tuple_t*,
+                                                    param_elem_p);
+        if ((NULL != st_p) &&
+            (NULL != st_p->key_p) &&
+            (strlen(st_p->key_p) == strlen(key_p)) &&
+            !strncmp(st_p->key_p, key_p, strlen(key_p)))
+            return param_elem_p;
 
-    if ((max_p != NULL) &&
-        ((sint16_t)temp > *max_p))
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack sint16 failed on max check: %d > %d\n",
-                             temp, *max_p));
-        set_errno(E_MPL_FAILED_OPERATION);
-        free(p);
-        return (-1);
+        param_elem_p = mpl_param_list_find_next(param_id, param_elem_p);
     }
+    return NULL;
+}
 
-    if ((min_p != NULL) &&
-        ((sint16_t)temp < *min_p))
+
+/**
+ * mpl_param_list_strint_tuple_key_find
+ *
+ */
+mpl_param_element_t*
+    mpl_param_list_strint_tuple_key_find( mpl_param_element_id_t param_id,
+                                          char *key_p,
+                                          mpl_list_t *param_list_p )
+{
+    mpl_param_element_t *param_elem_p;
+    mpl_strint_tuple_t *st_p;
+
+    if (mpl_param_id_get_type(param_id) != mpl_type_strint_tuple)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack sint16 failed on min check: %d < %d\n",
-                             temp, *min_p));
-        set_errno(E_MPL_FAILED_OPERATION);
-        free(p);
-        return (-1);
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                            ("Invalid type '%s'\n",
+                             mpl_param_id_get_type_string(param_id)));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return NULL;
     }
 
-    if (descr_p->integer_ranges_size > 0) {
-        range_id = check_integer_ranges(temp,
-                                        descr_p->integer_ranges,
-                                        descr_p->integer_ranges_size);
-        if (range_id < 0) {
-            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                                ("Unpack sint16 failed on range check: %d\n",
-                                 temp));
-            set_errno(E_MPL_FAILED_OPERATION);
-            free(p);
-            return (-1);
-        }
+    if ((NULL == key_p) || (0 == strlen(key_p)))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Invalid key_p\n"));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return NULL;
     }
 
-    *p = (sint16_t)temp;
-
-    assert(NULL != value_pp);
-    *value_pp = p;
+    param_elem_p = mpl_param_list_find(param_id, param_list_p);
+    while (NULL != param_elem_p)
+    {
+        st_p = MPL_GET_VALUE_PTR_FROM_PARAM_ELEMENT(mpl_strint_tuple_t*,
+                                                    param_elem_p);
+        if ((NULL != st_p) &&
+            (NULL != st_p->key_p) &&
+            (strlen(st_p->key_p) == strlen(key_p)) &&
+            !strncmp(st_p->key_p, key_p, strlen(key_p)))
+            return param_elem_p;
 
-    return range_id;
+        param_elem_p = mpl_param_list_find_next(param_id, param_elem_p);
+    }
+    return NULL;
 }
 
 /**
- * mpl_clone_param_value_sint16()
- **/
-int
-    mpl_clone_param_value_sint16(void **new_value_pp,
-                                 const void* old_value_p,
-                                 const mpl_param_descr2_t *descr_p)
+ * mpl_param_list_struint8_tuple_key_find
+ *
+ */
+mpl_param_element_t*
+    mpl_param_list_struint8_tuple_key_find( mpl_param_element_id_t param_id,
+                                            char *key_p,
+                                            mpl_list_t *param_list_p )
 {
-    sint16_t* p = malloc(sizeof(sint16_t));
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    if (NULL == p)
+    mpl_param_element_t *param_elem_p;
+    mpl_struint8_tuple_t *st_p;
+
+    if (mpl_param_id_get_type(param_id) != mpl_type_struint8_tuple)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        return (-1);
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                            ("Invalid type '%s'\n",
+                             mpl_param_id_get_type_string(param_id)));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return NULL;
     }
 
-    *p = *(sint16_t*)old_value_p;
-    *new_value_pp = p;
-
-    return (0);
-}
+    if ((NULL == key_p) || (0 == strlen(key_p)))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Invalid key_p\n"));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return NULL;
+    }
 
-/**
- * mpl_copy_param_value_sint16()
- **/
-int
-    mpl_copy_param_value_sint16(void *to_value_p,
-                                const void* from_value_p,
-                                int size,
-                                const mpl_param_descr2_t *descr_p)
-{
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    if (size >= (int)sizeof(sint16_t))
-        *(sint16_t*)to_value_p = *(sint16_t*)from_value_p;
+    param_elem_p = mpl_param_list_find(param_id, param_list_p);
+    while (NULL != param_elem_p)
+    {
+        st_p = MPL_GET_VALUE_PTR_FROM_PARAM_ELEMENT(mpl_struint8_tuple_t*,
+                                                    param_elem_p);
+        if ((NULL != st_p) &&
+            (NULL != st_p->key_p) &&
+            (strlen(st_p->key_p) == strlen(key_p)) &&
+            !strncmp(st_p->key_p, key_p, strlen(key_p)))
+            return param_elem_p;
 
-    return sizeof(sint16_t);
+        param_elem_p = mpl_param_list_find_next(param_id, param_elem_p);
+    }
+    return NULL;
 }
 
 /**
- * mpl_compare_param_value_sint16()
- **/
-int mpl_compare_param_value_sint16(const void *value1_p,
-                                   const void* value2_p,
-                                   const mpl_param_descr2_t *descr_p)
+ * mpl_param_list_int_tuple_key_find
+ *
+ */
+mpl_param_element_t*
+    mpl_param_list_int_tuple_key_find( mpl_param_element_id_t param_id,
+                                       int key,
+                                       mpl_list_t *param_list_p )
 {
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    return (*((sint16_t*) value1_p) != *((sint16_t*) value2_p));
-}
+    mpl_param_element_t *param_elem_p;
+    mpl_int_tuple_t *it_p;
 
+    if (mpl_param_id_get_type(param_id) != mpl_type_int_tuple)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                            ("Invalid type '%s'\n",
+                             mpl_param_id_get_type_string(param_id)));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return NULL;
+    }
 
+    param_elem_p = mpl_param_list_find(param_id, param_list_p);
+    while (NULL != param_elem_p)
+    {
+        it_p = MPL_GET_VALUE_PTR_FROM_PARAM_ELEMENT(mpl_int_tuple_t*,
+                                                    param_elem_p);
+        if ((NULL != it_p) && (it_p->key == key))
+            return param_elem_p;
 
-/**
- * mpl_pack_param_value_sint32()
- **/
-int mpl_pack_param_value_sint32(const void* param_value_p,
-                                char *buf,
-                                size_t buflen,
-                                const mpl_param_descr2_t *descr_p,
-                                const mpl_pack_options_t *options_p)
-{
-    assert(NULL != param_value_p);
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    MPL_IDENTIFIER_NOT_USED(options_p)
-        return snprintf(buf, buflen, "=%" PRId32, *(sint32_t*)param_value_p);
+        param_elem_p = mpl_param_list_find_next(param_id, param_elem_p);
+    }
+    return NULL;
 }
 
-/**
- * mpl_unpack_param_value_sint32()
- **/
-int
-    mpl_unpack_param_value_sint32(const char* value_str, void **value_pp,
-                                  const mpl_param_descr2_t *descr_p,
-                                  const mpl_pack_options_t *options_p,
-                                  mpl_param_element_id_t unpack_context)
-{
-    int temp;
-    sint32_t* p;
-    const sint32_t *max_p = descr_p->max_p;
-    const sint32_t *min_p = descr_p->min_p;
-    int range_id = 0;
 
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    MPL_IDENTIFIER_NOT_USED(options_p);
-    MPL_IDENTIFIER_NOT_USED(unpack_context);
+mpl_param_element_t*
+    mpl_param_list_string_tuple_find( mpl_param_element_id_t param_id,
+                                      char *key_p,
+                                      char *value_p,
+                                      mpl_list_t *param_list_p )
+{
+    mpl_param_element_t* param_elem_p;
+    mpl_string_tuple_t *st_p;
 
-    p = malloc(sizeof(sint32_t));
-    if (NULL == p)
+    param_elem_p = mpl_param_list_string_tuple_key_find(param_id,
+                                                        key_p,
+                                                        param_list_p);
+    while (NULL != param_elem_p)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        return (-1);
-    }
+        st_p = MPL_GET_VALUE_PTR_FROM_PARAM_ELEMENT(mpl_string_tuple_t*,
+                                                    param_elem_p);
+        if ((NULL != st_p) &&
+            (NULL != st_p->value_p) &&
+            (strlen(st_p->value_p) == strlen(value_p)) &&
+            !strncmp(st_p->value_p, value_p, strlen(value_p)))
+            return param_elem_p;
 
-    if (convert_int(value_str, &temp) < 0)
-    {
-        free(p);
-        return (-1);
+        param_elem_p =
+            mpl_param_list_string_tuple_key_find(param_id,
+                                                 key_p,
+                                                 param_elem_p->list_entry.next_p);
     }
+    return NULL;
+}
 
-    if ((max_p != NULL) &&
-        ((sint32_t)temp > *max_p))
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack sint32 failed on max check: %d > %d\n",
-                             temp, *max_p));
-        set_errno(E_MPL_FAILED_OPERATION);
-        free(p);
-        return (-1);
-    }
+mpl_param_element_t*
+    mpl_param_list_strint_tuple_find( mpl_param_element_id_t param_id,
+                                      char *key_p,
+                                      int value,
+                                      mpl_list_t *param_list_p )
+{
+    mpl_param_element_t* param_elem_p;
+    mpl_strint_tuple_t *it_p;
 
-    if ((min_p != NULL) &&
-        ((sint32_t)temp < *min_p))
+    param_elem_p = mpl_param_list_strint_tuple_key_find(param_id,
+                                                        key_p,
+                                                        param_list_p);
+    while (NULL != param_elem_p)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack sint32 failed on min check: %d < %d\n",
-                             temp, *min_p));
-        set_errno(E_MPL_FAILED_OPERATION);
-        free(p);
-        return (-1);
-    }
+        it_p = MPL_GET_VALUE_PTR_FROM_PARAM_ELEMENT(mpl_strint_tuple_t*,
+                                                    param_elem_p);
+        if ((NULL != it_p) && (it_p->value == value))
+            return param_elem_p;
 
-    if (descr_p->integer_ranges_size > 0) {
-        range_id = check_integer_ranges(temp,
-                                        descr_p->integer_ranges,
-                                        descr_p->integer_ranges_size);
-        if (range_id < 0) {
-            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                                ("Unpack sint32 failed on range check: %d\n",
-                                 temp));
-            set_errno(E_MPL_FAILED_OPERATION);
-            free(p);
-            return (-1);
-        }
+        param_elem_p =
+            mpl_param_list_strint_tuple_key_find(param_id,
+                                                 key_p,
+                                                 param_elem_p->list_entry.next_p);
     }
+    return NULL;
+}
 
-    *p = (sint32_t)temp;
+mpl_param_element_t*
+    mpl_param_list_struint8_tuple_find( mpl_param_element_id_t param_id,
+                                        char *key_p,
+                                        uint8_t value,
+                                        mpl_list_t *param_list_p )
+{
+    mpl_param_element_t* param_elem_p;
+    mpl_struint8_tuple_t *it_p;
 
-    assert(NULL != value_pp);
-    *value_pp = p;
+    param_elem_p = mpl_param_list_struint8_tuple_key_find(param_id,
+                                                          key_p,
+                                                          param_list_p);
+    while (NULL != param_elem_p)
+    {
+        it_p = MPL_GET_VALUE_PTR_FROM_PARAM_ELEMENT(mpl_struint8_tuple_t*,
+                                                    param_elem_p);
+        if ((NULL != it_p) && (it_p->value == value))
+            return param_elem_p;
 
-    return range_id;
+        param_elem_p =
+            mpl_param_list_strint_tuple_key_find(param_id,
+                                                 key_p,
+                                                 param_elem_p->list_entry.next_p);
+    }
+    return NULL;
 }
 
-/**
- * mpl_clone_param_value_sint32()
- **/
-int
-    mpl_clone_param_value_sint32(void **new_value_pp,
-                                 const void* old_value_p,
-                                 const mpl_param_descr2_t *descr_p)
+mpl_param_element_t*
+    mpl_param_list_int_tuple_find( mpl_param_element_id_t param_id,
+                                   int key,
+                                   int value,
+                                   mpl_list_t *param_list_p )
 {
-    sint32_t* p = malloc(sizeof(sint32_t));
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    if (NULL == p)
+    mpl_param_element_t* param_elem_p;
+    mpl_int_tuple_t *it_p;
+
+    param_elem_p = mpl_param_list_int_tuple_key_find(param_id,
+                                                     key,
+                                                     param_list_p);
+    while (NULL != param_elem_p)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        return (-1);
+        it_p = MPL_GET_VALUE_PTR_FROM_PARAM_ELEMENT(mpl_int_tuple_t*,
+                                                    param_elem_p);
+        if ((NULL != it_p) && (it_p->value == value))
+            return param_elem_p;
+
+        param_elem_p =
+            mpl_param_list_int_tuple_key_find(param_id,
+                                              key,
+                                              param_elem_p->list_entry.next_p);
     }
+    return NULL;
+}
 
-    *p = *(sint32_t*)old_value_p;
-    *new_value_pp = p;
 
-    return (0);
-}
 
 /**
- * mpl_copy_param_value_sint32()
- **/
-int
-    mpl_copy_param_value_sint32(void *to_value_p,
-                                const void* from_value_p,
-                                int size,
-                                const mpl_param_descr2_t *descr_p)
+ * mpl_param_list_tuple_key_find_wildcard
+ *
+ */
+mpl_param_element_t*
+    mpl_param_list_tuple_key_find_wildcard( mpl_param_element_id_t param_id,
+                                            char *key_p,
+                                            char *wildcard_p,
+                                            mpl_list_t *param_list_p )
 {
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    if (size >= (int)sizeof(sint32_t))
-        *(sint32_t*)to_value_p = *(sint32_t*)from_value_p;
+    mpl_param_element_t *param_elem_p;
 
-    return sizeof(sint32_t);
-}
+    if (mpl_param_id_get_type(param_id) != mpl_type_string_tuple)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                            ("Invalid type '%s'\n",
+                             mpl_param_id_get_type_string(param_id)));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return NULL;
+    }
 
-/**
- * mpl_compare_param_value_sint32()
- **/
-int mpl_compare_param_value_sint32(const void *value1_p,
-                                   const void* value2_p,
-                                   const mpl_param_descr2_t *descr_p)
-{
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    return (*((sint32_t*) value1_p) != *((sint32_t*) value2_p));
+    param_elem_p = mpl_param_list_tuple_key_find(param_id, key_p, param_list_p);
+    if (NULL != param_elem_p)
+        return param_elem_p;
+
+    return mpl_param_list_tuple_key_find(param_id, wildcard_p, param_list_p);
 }
 
 
 /**
- * mpl_pack_param_value_sint64()
+ * mpl_pack_param_value_string()
  **/
-int mpl_pack_param_value_sint64(const void* param_value_p,
+int mpl_pack_param_value_string(const void* param_value_p,
                                 char *buf,
                                 size_t buflen,
                                 const mpl_param_descr2_t *descr_p,
                                 const mpl_pack_options_t *options_p)
 {
     assert(NULL != param_value_p);
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    MPL_IDENTIFIER_NOT_USED(options_p)
-        return snprintf(buf, buflen, "=%" PRIi64, *(int64_t*)param_value_p);
+
+    return snprintf_escape(options_p->message_delimiter, '\\',
+                           buf, buflen, "=%s", (char*)param_value_p);
 }
 
 /**
- * mpl_unpack_param_value_sint64()
+ * mpl_unpack_param_value_string()
  **/
 int
-    mpl_unpack_param_value_sint64(const char* value_str, void **value_pp,
+    mpl_unpack_param_value_string(const char* value_str, void **value_pp,
                                   const mpl_param_descr2_t *descr_p,
                                   const mpl_pack_options_t *options_p,
                                   mpl_param_element_id_t unpack_context)
 {
-    int64_t temp;
-    int64_t* p;
-    const int64_t *max_p = descr_p->max_p;
-    const int64_t *min_p = descr_p->min_p;
-    int range_id = 0;
-    char *endp;
+    char* p;
+    size_t size;
+    char *temp_str;
+    int temp_string_allocated = 0;
+    const int *max_p = descr_p->max_p;
+    const int *min_p = descr_p->min_p;
 
-    MPL_IDENTIFIER_NOT_USED(options_p);
     MPL_IDENTIFIER_NOT_USED(unpack_context);
 
-    p = malloc(sizeof(int64_t));
-    if (NULL == p)
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        return (-1);
-    }
-
-    temp = strtoll(value_str, &endp, 0);
 
-    if (*endp != '\0')
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,("strtoll failed %s\n",
-                                                    value_str));
-        free(p);
-        return (-1);
+    if (strchr(value_str, '\\')) {
+        temp_str = remove_escape(value_str, '\\');
+        if (temp_str == NULL) {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                                ("Failed allocating memory\n"));
+            set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+            return (-1);
+        }
+        temp_string_allocated = 1;
+    }
+    else {
+        temp_str = (char*) value_str;
     }
 
     if ((max_p != NULL) &&
-        (temp > *max_p))
+        ((int)strlen(temp_str) > *max_p))
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack sint64 failed on max check: %"
-                             PRIi64 " > %" PRIi64 "\n", temp, *max_p));
+                            ("Unpack string failed on max length check: %zu > %d\n",
+                             strlen(temp_str), *max_p));/*lint !e557 %zu is C99 */
         set_errno(E_MPL_FAILED_OPERATION);
-        free(p);
+        if (temp_string_allocated)
+            free(temp_str);
         return (-1);
     }
 
     if ((min_p != NULL) &&
-        (temp < *min_p))
+        ((int)strlen(temp_str) < *min_p))
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack sint64 failed on min check: %"
-                             PRIi64 " < %" PRIi64 "\n", temp, *min_p));
+                            ("Unpack string failed on min length check: %zu < %d\n",
+                             strlen(temp_str), *min_p));/*lint !e557 %zu is C99 */
         set_errno(E_MPL_FAILED_OPERATION);
-        free(p);
+        if (temp_string_allocated)
+            free(temp_str);
         return (-1);
     }
 
-    if (descr_p->integer_ranges_size > 0) {
-        range_id = check_integer_ranges(temp,
-                                        descr_p->integer_ranges,
-                                        descr_p->integer_ranges_size);
-        if (range_id < 0) {
-            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                                ("Unpack sint64 failed on range check: %" PRIi64 "\n",
-                                 temp));
-            set_errno(E_MPL_FAILED_OPERATION);
-            free(p);
-            return (-1);
-        }
+    if (options_p->string_views && !temp_string_allocated)
+    {
+        *value_pp = (void*)value_str;
+        return (0);
     }
 
-    *p = temp;
+    size = strlen(temp_str)+1;
+    p = malloc(size);
+    if (NULL == p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        if (temp_string_allocated)
+            free(temp_str);
+        return (-1);
+    }
 
-    assert(NULL != value_pp);
+    strncpy(p, temp_str, size);
+    if (temp_string_allocated)
+        free(temp_str);
     *value_pp = p;
 
-    return range_id;
+    return (0);
 }
 
 /**
- * mpl_clone_param_value_sint64()
+ * mpl_clone_param_value_string()
  **/
-int
-    mpl_clone_param_value_sint64(void **new_value_pp,
+int mpl_clone_param_value_string(void **new_value_pp,
                                  const void* old_value_p,
                                  const mpl_param_descr2_t *descr_p)
 {
-    int64_t* p = malloc(sizeof(int64_t));
+    size_t size = strlen((char*)old_value_p) + 1;
+    char* p = malloc(size);
     MPL_IDENTIFIER_NOT_USED(descr_p);
     if (NULL == p)
     {
@@ -4465,161 +5679,205 @@ int
         return (-1);
     }
 
-    *p = *(int64_t*)old_value_p;
+    strncpy(p, (char*)old_value_p, size);
     *new_value_pp = p;
 
     return (0);
 }
 
 /**
- * mpl_copy_param_value_sint64()
+ * mpl_copy_param_value_string()
  **/
-int
-    mpl_copy_param_value_sint64(void *to_value_p,
+int mpl_copy_param_value_string(void *to_value_p,
                                 const void* from_value_p,
                                 int size,
                                 const mpl_param_descr2_t *descr_p)
 {
+    int real_size = strlen((char*)from_value_p) + 1;
     MPL_IDENTIFIER_NOT_USED(descr_p);
-    if ((size_t)size >= sizeof(int64_t))
-        *(int64_t*)to_value_p = *(int64_t*)from_value_p;
 
-    return sizeof(int64_t);
+    if (real_size <= size)
+        strncpy(to_value_p, (char*)from_value_p, real_size);
+
+    return real_size;
 }
 
 /**
- * mpl_compare_param_value_sint64()
+ * mpl_compare_param_value_string()
  **/
-int mpl_compare_param_value_sint64(const void *value1_p,
+int mpl_compare_param_value_string(const void *value1_p,
                                    const void* value2_p,
                                    const mpl_param_descr2_t *descr_p)
 {
     MPL_IDENTIFIER_NOT_USED(descr_p);
-    return (*((int64_t*) value1_p) != *((int64_t*) value2_p));
+    return strcmp(value1_p, value2_p);
 }
 
 /**
- * mpl_sizeof_param_value_sint64()
+ * mpl_sizeof_param_value_string()
  **/
-size_t mpl_sizeof_param_value_sint64(const mpl_param_descr2_t *descr_p)
+size_t mpl_sizeof_param_value_string(const mpl_param_descr2_t *descr_p)
 {
     MPL_IDENTIFIER_NOT_USED(descr_p);
-    return sizeof(int64_t);
+    return 0;
 }
 
 
-
 /**
- * mpl_pack_param_value_uint8()
+ * mpl_pack_param_value_wstring()
  **/
-int mpl_pack_param_value_uint8(const void* param_value_p,
-                               char *buf,
-                               size_t buflen,
-                               const mpl_param_descr2_t *descr_p,
-                               const mpl_pack_options_t *options_p)
+int mpl_pack_param_value_wstring(const void* param_value_p,
+                                 char *buf,
+                                 size_t buflen,
+                                 const mpl_param_descr2_t *descr_p,
+                                 const mpl_pack_options_t *options_p)
 {
+    mpl_uint32_array_t a;
+    int res;
+
     assert(NULL != param_value_p);
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    MPL_IDENTIFIER_NOT_USED(options_p)
-        return snprintf(buf, buflen, "=0x%x", *(uint8_t*)param_value_p);
-}
 
-/**
- * mpl_unpack_param_value_uint8()
- **/
-int
-    mpl_unpack_param_value_uint8(const char* value_str, void **value_pp,
-                                 const mpl_param_descr2_t *descr_p,
-                                 const mpl_pack_options_t *options_p,
-                                 mpl_param_element_id_t unpack_context)
-{
-    int temp;
-    uint8_t* p;
-    const uint8_t *max_p = descr_p->max_p;
-    const uint8_t *min_p = descr_p->min_p;
-    int range_id = 0;
+    a.len = wcslen((wchar_t*)param_value_p) + 1;
+    if (sizeof(wchar_t) == sizeof(uint32_t))
+    {
+        a.arr_p = (uint32_t*)param_value_p;
+    }
+    else if (sizeof(wchar_t) == sizeof(uint16_t))
+    {
+        unsigned int i;
 
-    MPL_IDENTIFIER_NOT_USED(options_p);
-    MPL_IDENTIFIER_NOT_USED(unpack_context);
+        a.arr_p = malloc(a.len * sizeof(uint32_t));
+        if (NULL == a.arr_p)
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                                ("Failed allocating memory\n"));
+            set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+            return (-1);
+        }
 
-    p = malloc(sizeof(uint8_t));
-    if (NULL == p)
+        for (i = 0; i < a.len; i++)
+        {
+            a.arr_p[i] = ((uint16_t*)param_value_p)[i];
+        }
+    }
+    else
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unsupported wchar width: %zu\n",
+                             sizeof(wchar_t)));/*lint !e557 %zu is C99 */
+        set_errno(E_MPL_FAILED_OPERATION);
         return (-1);
     }
 
-    if (convert_int(value_str, &temp) < 0)
+    res = mpl_pack_param_value_uint32_array(&a,
+                                            buf,
+                                            buflen,
+                                            descr_p,
+                                            options_p);
+
+    if (sizeof(wchar_t) == sizeof(uint16_t))
     {
-        free(p);
-        return (-1);
+        free(a.arr_p);
     }
 
-    if ((temp < 0) ||
-        (temp > (int)UINT8_MAX))
+    return res;
+
+}
+
+/**
+ * mpl_unpack_param_value_wstring()
+ **/
+int
+    mpl_unpack_param_value_wstring(const char* value_str, void **value_pp,
+                                   const mpl_param_descr2_t *descr_p,
+                                   const mpl_pack_options_t *options_p,
+                                   mpl_param_element_id_t unpack_context)
+{
+    mpl_uint32_array_t *a_p;
+    int res;
+    const int *max_p = descr_p->max_p;
+    const int *min_p = descr_p->min_p;
+
+    if ((res = mpl_unpack_param_value_uint32_array(value_str,
+                                                   (void **)&a_p,
+                                                   descr_p,
+                                                   options_p,
+                                                   unpack_context)) < 0)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack uint8 failed on range check: %d\n", temp));
-        set_errno(E_MPL_FAILED_OPERATION);
-        free(p);
-        return (-1);
+        return res;
     }
 
     if ((max_p != NULL) &&
-        ((uint8_t)temp > *max_p))
+        ((int)(a_p->len - 1) > *max_p))
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack uint8 failed on max check: %d > %d\n",
-                             temp, *max_p));
+                            ("Unpack wstring failed on max length check: %d > %d\n",
+                             a_p->len - 1, *max_p));
         set_errno(E_MPL_FAILED_OPERATION);
-        free(p);
+        mpl_free_param_value_uint32_array(a_p);
         return (-1);
     }
 
     if ((min_p != NULL) &&
-        ((uint8_t)temp < *min_p))
+        ((int)(a_p->len - 1) < *min_p))
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack uint8 failed on min check: %d < %d\n",
-                             temp, *min_p));
+                            ("Unpack wstring failed on min length check: %d < %d\n",
+                             a_p->len - 1, *min_p));
         set_errno(E_MPL_FAILED_OPERATION);
-        free(p);
+        mpl_free_param_value_uint32_array(a_p);
         return (-1);
     }
 
-    if (descr_p->integer_ranges_size > 0) {
-        range_id = check_integer_ranges(temp,
-                                        descr_p->integer_ranges,
-                                        descr_p->integer_ranges_size);
-        if (range_id < 0) {
-            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                                ("Unpack uint8 failed on range check: %d\n",
-                                 temp));
-            set_errno(E_MPL_FAILED_OPERATION);
-            free(p);
+    if (sizeof(wchar_t) == sizeof(uint16_t))
+    {
+        unsigned int i;
+        uint16_t *arr_p;
+
+        arr_p = malloc(a_p->len * sizeof(wchar_t));
+        if (NULL == arr_p)
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                                ("Failed allocating memory\n"));
+            set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+            free(a_p);
             return (-1);
         }
-    }
-
-    *p = (uint8_t)temp;
 
-    assert(NULL != value_pp);
-    *value_pp = p;
+        for (i = 0; i < a_p->len; i++)
+        {
+            arr_p[i] = a_p->arr_p[i];
+        }
+        *value_pp = arr_p;
+        free(a_p->arr_p);
+    }
+    else if (sizeof(wchar_t) == sizeof(uint32_t))
+    {
+        *value_pp = a_p->arr_p;
+    }
+    else
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unsupported wchar width: %zu\n",
+                             sizeof(wchar_t)));/*lint !e557 %zu is C99 */
+        set_errno(E_MPL_FAILED_OPERATION);
+        mpl_free_param_value_uint32_array(a_p);
+        return (-1);
+    }
 
-    return range_id;
+    free(a_p);
+    return 0;
 }
 
 /**
- * mpl_clone_param_value_uint8()
+ * mpl_clone_param_value_wstring()
  **/
-int
-    mpl_clone_param_value_uint8(void **new_value_pp,
-                                const void* old_value_p,
-                                const mpl_param_descr2_t *descr_p)
+int mpl_clone_param_value_wstring(void **new_value_pp,
+                                  const void* old_value_p,
+                                  const mpl_param_descr2_t *descr_p)
 {
-    uint8_t* p = malloc(sizeof(uint8_t));
+    size_t size = wcslen((wchar_t*)old_value_p) + 1;
+    wchar_t* p = malloc(size * sizeof(L'\0'));
     MPL_IDENTIFIER_NOT_USED(descr_p);
     if (NULL == p)
     {
@@ -4629,84 +5887,85 @@ int
         return (-1);
     }
 
-    *p = *(uint8_t*)old_value_p;
+    (void)wcsncpy(p, (wchar_t*)old_value_p, size);
     *new_value_pp = p;
 
     return (0);
 }
 
 /**
- * mpl_copy_param_value_uint8()
+ * mpl_copy_param_value_wstring()
  **/
-int
-    mpl_copy_param_value_uint8(void *to_value_p,
-                               const void* from_value_p,
-                               int size,
-                               const mpl_param_descr2_t *descr_p)
+int mpl_copy_param_value_wstring(void *to_value_p,
+                                 const void* from_value_p,
+                                 int size,
+                                 const mpl_param_descr2_t *descr_p)
 {
+    int real_size = (wcslen((wchar_t*)from_value_p) + 1) * sizeof(L'\0');
     MPL_IDENTIFIER_NOT_USED(descr_p);
-    if (size >= (int)sizeof(uint8_t))
-        *(uint8_t*)to_value_p = *(uint8_t*)from_value_p;
 
-    return sizeof(uint8_t);
+    if (real_size <= size)
+        (void)wcsncpy(to_value_p, (wchar_t*)from_value_p, real_size / (int)sizeof(L'\0'));
+
+    return real_size;
 }
 
 /**
- * mpl_compare_param_value_uint8()
+ * mpl_compare_param_value_wstring()
  **/
-int mpl_compare_param_value_uint8(const void *value1_p,
-                                  const void* value2_p,
-                                  const mpl_param_descr2_t *descr_p)
+int mpl_compare_param_value_wstring(const void *value1_p,
+                                    const void* value2_p,
+                                    const mpl_param_descr2_t *descr_p)
 {
     MPL_IDENTIFIER_NOT_USED(descr_p);
-    return (*((uint8_t*) value1_p) != *((uint8_t*) value2_p));
+    return wcscmp(value1_p, value2_p);
 }
 
 /**
- * mpl_sizeof_param_value_uint8()
+ * mpl_sizeof_param_value_wstring()
  **/
-size_t mpl_sizeof_param_value_uint8(const mpl_param_descr2_t *descr_p)
+size_t mpl_sizeof_param_value_wstring(const mpl_param_descr2_t *descr_p)
 {
     MPL_IDENTIFIER_NOT_USED(descr_p);
-    return sizeof(uint8_t);
+    return 0;
 }
 
+
+
 /**
- * mpl_pack_param_value_uint16()
+ * mpl_pack_param_value_int()
  **/
-int mpl_pack_param_value_uint16(const void* param_value_p,
-                                char *buf,
-                                size_t buflen,
-                                const mpl_param_descr2_t *descr_p,
-                                const mpl_pack_options_t *options_p)
+int mpl_pack_param_value_int(const void* param_value_p,
+                             char *buf,
+                             size_t buflen,
+                             const mpl_param_descr2_t *descr_p,
+                             const mpl_pack_options_t *options_p)
 {
     assert(NULL != param_value_p);
     MPL_IDENTIFIER_NOT_USED(descr_p);
     MPL_IDENTIFIER_NOT_USED(options_p)
-        return snprintf(buf, buflen, "=0x%" PRIx16, *(uint16_t*)param_value_p);
+        return pack_int(buf, buflen, *(int*)param_value_p);
 }
 
 /**
- * mpl_unpack_param_value_uint16()
+ * mpl_unpack_param_value_int()
  **/
 int
-    mpl_unpack_param_value_uint16(const char* value_str, void **value_pp,
-                                  const mpl_param_descr2_t *descr_p,
-                                  const mpl_pack_options_t *options_p,
-                                  mpl_param_element_id_t unpack_context)
+    mpl_unpack_param_value_int(const char* value_str,
+                               void **value_pp,
+                               const mpl_param_descr2_t *descr_p,
+                               const mpl_pack_options_t *options_p,
+                               mpl_param_element_id_t unpack_context)
 {
-    uint64_t temp;
-    uint16_t* p;
-    const uint16_t *max_p = descr_p->max_p;
-    const uint16_t *min_p = descr_p->min_p;
+    int* p;
+    const int *max_p = descr_p->max_p;
+    const int *min_p = descr_p->min_p;
     int range_id = 0;
-    char *endp;
-    int base = 10;
 
     MPL_IDENTIFIER_NOT_USED(options_p);
     MPL_IDENTIFIER_NOT_USED(unpack_context);
 
-    p = malloc(sizeof(uint16_t));
+    p = malloc(sizeof(int));
     if (NULL == p)
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
@@ -4715,68 +5974,47 @@ int
         return (-1);
     }
 
-    if ((NULL != strstr(value_str, "0x")) ||
-        (NULL != strstr(value_str, "0X")))
-        base = 16;
-
-    temp = strtoull(value_str, &endp, base);
-
-    if (*endp != '\0')
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,("strtoull failed %s\n",
-                                                    value_str));
-        free(p);
-        return (-1);
-    }
-
-    if (temp > UINT16_MAX)
+    if (convert_int(value_str, p) < 0)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack uint16 failed on range check: 0x%"
-                             PRIu64 "\n", temp));
-        set_errno(E_MPL_FAILED_OPERATION);
         free(p);
         return (-1);
     }
 
     if ((max_p != NULL) &&
-        ((uint16_t)temp > *max_p))
+        (*p > *max_p))
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack uint16 failed on max check: %"
-                             PRIu64 " > %" PRIu16 "\n", temp, *max_p));
+                            ("Unpack int failed on max check: %d > %d\n",
+                             *p, *max_p));
         set_errno(E_MPL_FAILED_OPERATION);
         free(p);
         return (-1);
     }
 
     if ((min_p != NULL) &&
-        ((uint16_t)temp < *min_p))
+        (*p < *min_p))
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack uint16 failed on min check: %"
-                             PRIu64 " < %" PRIu16 "\n", temp, *min_p));
+                            ("Unpack int failed on min check: %d < %d\n",
+                             *p, *min_p));
         set_errno(E_MPL_FAILED_OPERATION);
         free(p);
         return (-1);
     }
 
     if (descr_p->integer_ranges_size > 0) {
-        range_id = check_integer_ranges(temp,
+        range_id = check_integer_ranges(*p,
                                         descr_p->integer_ranges,
                                         descr_p->integer_ranges_size);
         if (range_id < 0) {
             MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                                ("Unpack uint16 failed on range check: %" PRIu64 "\n",
-                                 temp));
+                                ("Unpack int failed on range check: %d\n",
+                                 *p));
             set_errno(E_MPL_FAILED_OPERATION);
             free(p);
             return (-1);
         }
     }
-
-    *p = (uint16_t)temp;
-
     assert(NULL != value_pp);
     *value_pp = p;
 
@@ -4784,14 +6022,14 @@ int
 }
 
 /**
- * mpl_clone_param_value_uint16()
+ * mpl_clone_param_value_int()
  **/
 int
-    mpl_clone_param_value_uint16(void **new_value_pp,
-                                 const void* old_value_p,
-                                 const mpl_param_descr2_t *descr_p)
+    mpl_clone_param_value_int(void **new_value_pp,
+                              const void* old_value_p,
+                              const mpl_param_descr2_t *descr_p)
 {
-    uint16_t* p = malloc(sizeof(uint16_t));
+    int* p = malloc(sizeof(int));
     MPL_IDENTIFIER_NOT_USED(descr_p);
     if (NULL == p)
     {
@@ -4801,84 +6039,84 @@ int
         return (-1);
     }
 
-    *p = *(uint16_t*)old_value_p;
+    *p = *(int*)old_value_p;
     *new_value_pp = p;
 
     return (0);
 }
 
 /**
- * mpl_copy_param_value_uint16()
+ * mpl_copy_param_value_int()
  **/
 int
-    mpl_copy_param_value_uint16(void *to_value_p,
-                                const void* from_value_p,
-                                int size,
-                                const mpl_param_descr2_t *descr_p)
+    mpl_copy_param_value_int(void *to_value_p,
+                             const void* from_value_p,
+                             int size,
+                             const mpl_param_descr2_t *descr_p)
 {
     MPL_IDENTIFIER_NOT_USED(descr_p);
-    if (size >= (int)sizeof(uint16_t))
-        *(uint16_t*)to_value_p = *(uint16_t*)from_value_p;
+    if (size >= (int)sizeof(int))
+        *(int*)to_value_p = *(int*)from_value_p;
 
-    return sizeof(uint16_t);
+    return sizeof(int);
 }
 
 /**
- * mpl_compare_param_value_uint16()
+ * mpl_compare_param_value_int()
  **/
-int mpl_compare_param_value_uint16(const void *value1_p,
-                                   const void* value2_p,
-                                   const mpl_param_descr2_t *descr_p)
+int mpl_compare_param_value_int(const void *value1_p,
+                                const void* value2_p,
+                                const mpl_param_descr2_t *descr_p)
 {
     MPL_IDENTIFIER_NOT_USED(descr_p);
-    return (*((uint16_t*) value1_p) != *((uint16_t*) value2_p));
+    return (*((int*) value1_p) != *((int*) value2_p));
 }
 
 /**
- * mpl_sizeof_param_value_uint16()
+ * mpl_sizeof_param_value_int()
  **/
-size_t mpl_sizeof_param_value_uint16(const mpl_param_descr2_t *descr_p)
+size_t mpl_sizeof_param_value_int(const mpl_param_descr2_t *descr_p)
 {
     MPL_IDENTIFIER_NOT_USED(descr_p);
-    return sizeof(uint16_t);
+    return sizeof(int);
 }
 
 
+
 /**
- * mpl_pack_param_value_uint32()
+ * mpl_pack_param_value_sint8()
  **/
-int mpl_pack_param_value_uint32(const void* param_value_p,
-                                char *buf, size_t buflen,
-                                const mpl_param_descr2_t *descr_p,
-                                const mpl_pack_options_t *options_p)
+int mpl_pack_param_value_sint8(const void* param_value_p,
+                               char *buf,
+                               size_t buflen,
+                               const mpl_param_descr2_t *descr_p,
+                               const mpl_pack_options_t *options_p)
 {
     assert(NULL != param_value_p);
     MPL_IDENTIFIER_NOT_USED(descr_p);
     MPL_IDENTIFIER_NOT_USED(options_p)
-        return snprintf(buf, buflen, "=0x%" PRIx32, *(uint32_t*)param_value_p);
+        return pack_int(buf, buflen, *(sint8_t*)param_value_p);
 }
 
 /**
- * mpl_unpack_param_value_uint32()
+ * mpl_unpack_param_value_sint8()
  **/
 int
-    mpl_unpack_param_value_uint32(const char* value_str, void **value_pp,
-                                  const mpl_param_descr2_t *descr_p,
-                                  const mpl_pack_options_t *options_p,
-                                  mpl_param_element_id_t unpack_context)
+    mpl_unpack_param_value_sint8(const char* value_str, void **value_pp,
+                                 const mpl_param_descr2_t *descr_p,
+                                 const mpl_pack_options_t *options_p,
+                                 mpl_param_element_id_t unpack_context)
 {
-    uint64_t temp;
-    uint32_t* p;
-    const uint32_t *max_p = descr_p->max_p;
-    const uint32_t *min_p = descr_p->min_p;
+    int temp;
+    sint8_t* p;
+    const sint8_t *max_p = descr_p->max_p;
+    const sint8_t *min_p = descr_p->min_p;
     int range_id = 0;
-    char *endp;
-    int base = 10;
 
     MPL_IDENTIFIER_NOT_USED(options_p);
     MPL_IDENTIFIER_NOT_USED(unpack_context);
 
-    p = malloc(sizeof(uint32_t));
+    p = malloc(sizeof(sint8_t));
     if (NULL == p)
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
@@ -4887,47 +6125,39 @@ int
         return (-1);
     }
 
-    if ((NULL != strstr(value_str, "0x")) ||
-        (NULL != strstr(value_str, "0X")))
-        base = 16;
-
-    temp = strtoull(value_str, &endp, base);
-
-    if (*endp != '\0')
+    if (convert_int(value_str, &temp) < 0)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,("strtoull failed %s\n",
-                                                    value_str));
         free(p);
         return (-1);
     }
 
-    if (temp > UINT32_MAX)
+    if ((temp < SCHAR_MIN) ||
+        (temp > (int)SCHAR_MAX))
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack uint32 failed on range check: 0x%"
-                             PRIu64 "\n", temp));
+                            ("Unpack sint8 failed on range check: %d\n", temp));
         set_errno(E_MPL_FAILED_OPERATION);
         free(p);
         return (-1);
     }
 
     if ((max_p != NULL) &&
-        ((uint32_t)temp > *max_p))
+        ((sint8_t)temp > *max_p))
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack uint32 failed on max check: %"
-                             PRIu64 " > %" PRIu32 "\n", temp, *max_p));
+                            ("Unpack sint8 failed on max check: %d > %d\n",
+                             temp, *max_p));
         set_errno(E_MPL_FAILED_OPERATION);
         free(p);
         return (-1);
     }
 
     if ((min_p != NULL) &&
-        ((uint32_t)temp < *min_p))
+        ((sint8_t)temp < *min_p))
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack uint32 failed on min check: %"
-                             PRIu64 " < %" PRIu32 "\n", temp, *min_p));
+                            ("Unpack sint8 failed on min check: %d < %d\n",
+                             temp, *min_p));
         set_errno(E_MPL_FAILED_OPERATION);
         free(p);
         return (-1);
@@ -4939,7 +6169,7 @@ int
                                         descr_p->integer_ranges_size);
         if (range_id < 0) {
             MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                                ("Unpack uint32 failed on range check: %" PRIu64 "\n",
+                                ("Unpack sint8 failed on range check: %d\n",
                                  temp));
             set_errno(E_MPL_FAILED_OPERATION);
             free(p);
@@ -4947,7 +6177,7 @@ int
         }
     }
 
-    *p = (uint32_t)temp;
+    *p = (sint8_t)temp;
 
     assert(NULL != value_pp);
     *value_pp = p;
@@ -4956,14 +6186,14 @@ int
 }
 
 /**
- * mpl_clone_param_value_uint32()
+ * mpl_clone_param_value_sint8()
  **/
 int
-    mpl_clone_param_value_uint32(void **new_value_pp,
-                                 const void* old_value_p,
-                                 const mpl_param_descr2_t *descr_p)
+    mpl_clone_param_value_sint8(void **new_value_pp,
+                                const void* old_value_p,
+                                const mpl_param_descr2_t *descr_p)
 {
-    uint32_t* p = malloc(sizeof(uint32_t));
+    sint8_t* p = malloc(sizeof(sint8_t));
     MPL_IDENTIFIER_NOT_USED(descr_p);
     if (NULL == p)
     {
@@ -4973,52 +6203,45 @@ int
         return (-1);
     }
 
-    *p = *(uint32_t*)old_value_p;
+    *p = *(sint8_t*)old_value_p;
     *new_value_pp = p;
 
     return (0);
 }
 
 /**
- * mpl_copy_param_value_uint32()
+ * mpl_copy_param_value_sint8()
  **/
 int
-    mpl_copy_param_value_uint32(void *to_value_p,
-                                const void* from_value_p,
-                                int size,
-                                const mpl_param_descr2_t *descr_p)
+    mpl_copy_param_value_sint8(void *to_value_p,
+                               const void* from_value_p,
+                               int size,
+                               const mpl_param_descr2_t *descr_p)
 {
-    if (size >= (int)sizeof(uint32_t))
-        *(uint32_t*)to_value_p = *(uint32_t*)from_value_p;
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    if (size >= (int)sizeof(sint8_t))
+        *(sint8_t*)to_value_p = *(sint8_t*)from_value_p;
 
-    return sizeof(uint32_t);
+    return sizeof(sint8_t);
 }
 
 /**
- * mpl_compare_param_value_uint32()
+ * mpl_compare_param_value_sint8()
  **/
-int mpl_compare_param_value_uint32(const void *value1_p,
-                                   const void* value2_p,
-                                   const mpl_param_descr2_t *descr_p)
+int mpl_compare_param_value_sint8(const void *value1_p,
+                                  const void* value2_p,
+                                  const mpl_param_descr2_t *descr_p)
 {
     MPL_IDENTIFIER_NOT_USED(descr_p);
-    return (*((uint32_t*) value1_p) != *((uint32_t*) value2_p));
+    return (*((sint8_t*) value1_p) != *((sint8_t*) value2_p));
 }
 
-/**
- * mpl_sizeof_param_value_uint32()
- **/
-size_t mpl_sizeof_param_value_uint32(const mpl_param_descr2_t *descr_p)
-{
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    return sizeof(uint32_t);
-}
 
 
 /**
- * mpl_pack_param_value_uint64()
+ * mpl_pack_param_value_sint16()
  **/
-int mpl_pack_param_value_uint64(const void* param_value_p,
+int mpl_pack_param_value_sint16(const void* param_value_p,
                                 char *buf,
                                 size_t buflen,
                                 const mpl_param_descr2_t *descr_p,
@@ -5026,31 +6249,29 @@ int mpl_pack_param_value_uint64(const void* param_value_p,
 {
     assert(NULL != param_value_p);
     MPL_IDENTIFIER_NOT_USED(descr_p);
-    MPL_IDENTIFIER_NOT_USED(options_p);
-    return snprintf(buf, buflen, "=0x%" PRIx64, *(uint64_t*)param_value_p);
+    MPL_IDENTIFIER_NOT_USED(options_p)
+        return pack_int(buf, buflen, *(sint16_t*)param_value_p);
 }
 
 /**
- * mpl_unpack_param_value_uint64()
+ * mpl_unpack_param_value_sint16()
  **/
 int
-    mpl_unpack_param_value_uint64(const char* value_str, void **value_pp,
+    mpl_unpack_param_value_sint16(const char* value_str, void **value_pp,
                                   const mpl_param_descr2_t *descr_p,
                                   const mpl_pack_options_t *options_p,
                                   mpl_param_element_id_t unpack_context)
 {
-    uint64_t temp;
-    uint64_t* p;
-    const uint64_t *max_p = descr_p->max_p;
-    const uint64_t *min_p = descr_p->min_p;
+    int temp;
+    sint16_t* p;
+    const sint16_t *max_p = descr_p->max_p;
+    const sint16_t *min_p = descr_p->min_p;
     int range_id = 0;
-    int base = 10;
-    char *endp = NULL;
 
     MPL_IDENTIFIER_NOT_USED(options_p);
     MPL_IDENTIFIER_NOT_USED(unpack_context);
 
-    p = malloc(sizeof(uint64_t));
+    p = malloc(sizeof(sint16_t));
     if (NULL == p)
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
@@ -5059,37 +6280,39 @@ int
         return (-1);
     }
 
-    if ((NULL != strstr(value_str, "0x")) ||
-        (NULL != strstr(value_str, "0X")))
-        base = 16;
-
-    temp = strtoull(value_str, &endp, base);
-
-    if (*endp != '\0')
+    if (convert_int(value_str, &temp) < 0)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,("strtoull failed %s\n",
-                                                    value_str));
         free(p);
         return (-1);
     }
 
-    if ((max_p != NULL) &&
-        (temp > *max_p))
+    if ((temp < SHRT_MIN) ||
+        (temp > (int)SHRT_MAX))
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack uint64 failed on max check: %"
-                             PRIu64 " > %" PRIu64 "\n", temp, *max_p));
+                            ("Unpack sint16 failed on range check: %d\n", temp));
         set_errno(E_MPL_FAILED_OPERATION);
         free(p);
         return (-1);
     }
 
-    if ((min_p != NULL) &&
-        (temp < *min_p))
+    if ((max_p != NULL) &&
+        ((sint16_t)temp > *max_p))
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack uint64 failed on min check: %"
-                             PRIu64 " < %" PRIu64 "\n", temp, *min_p));
+                            ("Unpack sint16 failed on max check: %d > %d\n",
+                             temp, *max_p));
+        set_errno(E_MPL_FAILED_OPERATION);
+        free(p);
+        return (-1);
+    }
+
+    if ((min_p != NULL) &&
+        ((sint16_t)temp < *min_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack sint16 failed on min check: %d < %d\n",
+                             temp, *min_p));
         set_errno(E_MPL_FAILED_OPERATION);
         free(p);
         return (-1);
@@ -5101,7 +6324,7 @@ int
                                         descr_p->integer_ranges_size);
         if (range_id < 0) {
             MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                                ("Unpack uint64 failed on range check: %" PRIu64 "\n",
+                                ("Unpack sint16 failed on range check: %d\n",
                                  temp));
             set_errno(E_MPL_FAILED_OPERATION);
             free(p);
@@ -5109,7 +6332,7 @@ int
         }
     }
 
-    *p = temp;
+    *p = (sint16_t)temp;
 
     assert(NULL != value_pp);
     *value_pp = p;
@@ -5118,14 +6341,14 @@ int
 }
 
 /**
- * mpl_clone_param_value_uint64()
+ * mpl_clone_param_value_sint16()
  **/
 int
-    mpl_clone_param_value_uint64(void **new_value_pp,
+    mpl_clone_param_value_sint16(void **new_value_pp,
                                  const void* old_value_p,
                                  const mpl_param_descr2_t *descr_p)
 {
-    uint64_t* p = malloc(sizeof(uint64_t));
+    sint16_t* p = malloc(sizeof(sint16_t));
     MPL_IDENTIFIER_NOT_USED(descr_p);
     if (NULL == p)
     {
@@ -5135,142 +6358,144 @@ int
         return (-1);
     }
 
-    *p = *(uint64_t*)old_value_p;
+    *p = *(sint16_t*)old_value_p;
     *new_value_pp = p;
 
     return (0);
 }
 
 /**
- * mpl_copy_param_value_uint64()
+ * mpl_copy_param_value_sint16()
  **/
 int
-    mpl_copy_param_value_uint64(void *to_value_p,
+    mpl_copy_param_value_sint16(void *to_value_p,
                                 const void* from_value_p,
                                 int size,
                                 const mpl_param_descr2_t *descr_p)
 {
     MPL_IDENTIFIER_NOT_USED(descr_p);
-    if ((size_t)size >= sizeof(uint64_t))
-        *(uint64_t*)to_value_p = *(uint64_t*)from_value_p;
+    if (size >= (int)sizeof(sint16_t))
+        *(sint16_t*)to_value_p = *(sint16_t*)from_value_p;
 
-    return sizeof(uint64_t);
+    return sizeof(sint16_t);
 }
 
 /**
- * mpl_compare_param_value_uint64()
+ * mpl_compare_param_value_sint16()
  **/
-int mpl_compare_param_value_uint64(const void *value1_p,
+int mpl_compare_param_value_sint16(const void *value1_p,
                                    const void* value2_p,
                                    const mpl_param_descr2_t *descr_p)
 {
     MPL_IDENTIFIER_NOT_USED(descr_p);
-    return (*((uint64_t*) value1_p) != *((uint64_t*) value2_p));
+    return (*((sint16_t*) value1_p) != *((sint16_t*) value2_p));
 }
 
+
+
 /**
- * mpl_sizeof_param_value_uint64()
+ * mpl_pack_param_value_sint32()
  **/
-size_t mpl_sizeof_param_value_uint64(const mpl_param_descr2_t *descr_p)
+int mpl_pack_param_value_sint32(const void* param_value_p,
+                                char *buf,
+                                size_t buflen,
+                                const mpl_param_descr2_t *descr_p,
+                                const mpl_pack_options_t *options_p)
 {
+    assert(NULL != param_value_p);
     MPL_IDENTIFIER_NOT_USED(descr_p);
-    return sizeof(uint64_t);
+    MPL_IDENTIFIER_NOT_USED(options_p)
+        return pack_int(buf, buflen, *(sint32_t*)param_value_p);
 }
 
 /**
- * mpl_pack_param_value_enum()
+ * mpl_unpack_param_value_sint32()
  **/
-int mpl_pack_param_value_enum (const void* param_value_p,
-                               char *buf,
-                               size_t buflen,
-                               const mpl_param_descr2_t *descr_p,
-                               const mpl_pack_options_t *options_p)
+int
+    mpl_unpack_param_value_sint32(const char* value_str, void **value_pp,
+                                  const mpl_param_descr2_t *descr_p,
+                                  const mpl_pack_options_t *options_p,
+                                  mpl_param_element_id_t unpack_context)
 {
-    int64_t value;
-    const char *name_p;
-    MPL_IDENTIFIER_NOT_USED(options_p)
-        assert(NULL != param_value_p);
-    assert(NULL != descr_p->enum_values);
+    int temp;
+    sint32_t* p;
+    const sint32_t *max_p = descr_p->max_p;
+    const sint32_t *min_p = descr_p->min_p;
+    int range_id = 0;
 
-    switch (descr_p->enum_representation_bytesize) {
-        case 1:
-            if (descr_p->enum_representation_signed)
-                value = *((sint8_t*)param_value_p);
-            else
-                value = *((uint8_t*)param_value_p);
-            break;
-        case 2:
-            if (descr_p->enum_representation_signed)
-                value = *((sint16_t*)param_value_p);
-            else
-                value = *((uint16_t*)param_value_p);
-            break;
-        case 4:
-            if (descr_p->enum_representation_signed)
-                value = *((sint32_t*)param_value_p);
-            else
-                value = *((uint32_t*)param_value_p);
-            break;
-        default:
-            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                                ("Pack enum failed: no support for 8 byte enum representations\n"));
-            set_errno(E_MPL_FAILED_OPERATION);
-            return (-1);
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    MPL_IDENTIFIER_NOT_USED(options_p);
+    MPL_IDENTIFIER_NOT_USED(unpack_context);
+
+    p = malloc(sizeof(sint32_t));
+    if (NULL == p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return (-1);
     }
 
-    name_p = convert_enum_value_to_name(value, descr_p->enum_values, descr_p->enum_values_size);
-    if (name_p == NULL)
+    if (convert_int(value_str, &temp) < 0)
+    {
+        free(p);
+        return (-1);
+    }
+
+    if ((max_p != NULL) &&
+        ((sint32_t)temp > *max_p))
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Pack enum failed: unknown value %" PRIi64 "\n",
-                             value));
+                            ("Unpack sint32 failed on max check: %d > %d\n",
+                             temp, *max_p));
         set_errno(E_MPL_FAILED_OPERATION);
+        free(p);
         return (-1);
     }
-    return snprintf(buf, buflen, "=%s", name_p);
-}
 
-#define DEFINE_MPL_PACK_PARAM_VALUE_ENUM(enum_name, enum_type, format)         \
-    int mpl_pack_param_value_##enum_name (const void* param_value_p,    \
-                                          char *buf,                    \
-                                          size_t buflen,                \
-                                          const mpl_param_descr2_t *descr_p, \
-                                          const mpl_pack_options_t *options_p) \
-    {                                                                   \
-        enum_type value;                                                \
-        const char *name_p;                                             \
-        MPL_IDENTIFIER_NOT_USED(options_p)                              \
-            assert(NULL != param_value_p);                              \
-        assert(NULL != descr_p->enum_values);                           \
-                                                                        \
-        value = *((enum_type*)param_value_p);                           \
-        name_p = convert_enum_value_to_name(value, descr_p->enum_values, descr_p->enum_values_size); \
-        if (name_p == NULL)                                             \
-        {                                                               \
-            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,                 \
-                                ("Pack enum failed: unknown value %" format "\n", \
-                                 value));                               \
-            set_errno(E_MPL_FAILED_OPERATION);                          \
-            return (-1);                                                \
-        }                                                               \
-                                                                        \
-        return snprintf(buf, buflen, "=%s", name_p);                    \
-    }                                                                   \
+    if ((min_p != NULL) &&
+        ((sint32_t)temp < *min_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack sint32 failed on min check: %d < %d\n",
+                             temp, *min_p));
+        set_errno(E_MPL_FAILED_OPERATION);
+        free(p);
+        return (-1);
+    }
+
+    if (descr_p->integer_ranges_size > 0) {
+        range_id = check_integer_ranges(temp,
+                                        descr_p->integer_ranges,
+                                        descr_p->integer_ranges_size);
+        if (range_id < 0) {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("Unpack sint32 failed on range check: %d\n",
+                                 temp));
+            set_errno(E_MPL_FAILED_OPERATION);
+            free(p);
+            return (-1);
+        }
+    }
+
+    *p = (sint32_t)temp;
+
+    assert(NULL != value_pp);
+    *value_pp = p;
 
+    return range_id;
+}
 
 /**
- * mpl_unpack_param_value_enum()
+ * mpl_clone_param_value_sint32()
  **/
-int mpl_unpack_param_value_enum(const char* value_str,
-                                void **value_pp,
-                                const mpl_param_descr2_t *descr_p,
-                                const mpl_pack_options_t *options_p,
-                                mpl_param_element_id_t unpack_context)
+int
+    mpl_clone_param_value_sint32(void **new_value_pp,
+                                 const void* old_value_p,
+                                 const mpl_param_descr2_t *descr_p)
 {
-    void* p = malloc(descr_p->enum_representation_bytesize);
-    int64_t value;
-    MPL_IDENTIFIER_NOT_USED(options_p);
-    MPL_IDENTIFIER_NOT_USED(unpack_context);
+    sint32_t* p = malloc(sizeof(sint32_t));
+    MPL_IDENTIFIER_NOT_USED(descr_p);
     if (NULL == p)
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
@@ -5278,129 +6503,75 @@ int mpl_unpack_param_value_enum(const char* value_str,
         set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
         return (-1);
     }
-    if (convert_enum_name_to_int64(value_str,
-                                   &value,
-                                   descr_p->enum_values,
-                                   descr_p->enum_values_size) < 0)
-    {
-        int64_t i;
-        if (convert_int64(value_str, &i) < 0)
-        {
-            free(p);
-            return (-1);
-        }
-        value = i;
-        if (convert_enum_value_to_name(value,
-                                       descr_p->enum_values,
-                                       descr_p->enum_values_size) == NULL)
-        {
-            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                                ("Unpack enum failed: unknown value %" PRIi64 "\n",
-                                 i));
-            set_errno(E_MPL_FAILED_OPERATION);
-            free(p);
-            return (-1);
-        }
-    }
-    assert(NULL != value_pp);
 
-    switch (descr_p->enum_representation_bytesize) {
-        case 1:
-            if (descr_p->enum_representation_signed)
-                *((sint8_t*)p) = value;
-            else
-                *((uint8_t*)p) = value;
-            break;
-        case 2:
-            if (descr_p->enum_representation_signed)
-                *((sint16_t*)p) = value;
-            else
-                *((uint16_t*)p) = value;
-            break;
-        case 4:
-            if (descr_p->enum_representation_signed)
-                *((sint32_t*)p) = value;
-            else
-                *((uint32_t*)p) = value;
-            break;
-        default:
-            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                                ("Unpack enum failed: no support for 8 byte enum representations\n"));
-            set_errno(E_MPL_FAILED_OPERATION);
-            free(p);
-            return (-1);
-    }
-    *value_pp = p;
+    *p = *(sint32_t*)old_value_p;
+    *new_value_pp = p;
+
     return (0);
 }
 
+/**
+ * mpl_copy_param_value_sint32()
+ **/
+int
+    mpl_copy_param_value_sint32(void *to_value_p,
+                                const void* from_value_p,
+                                int size,
+                                const mpl_param_descr2_t *descr_p)
+{
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    if (size >= (int)sizeof(sint32_t))
+        *(sint32_t*)to_value_p = *(sint32_t*)from_value_p;
 
-#define DEFINE_MPL_UNPACK_PARAM_VALUE_ENUM(enum_name, enum_type)        \
-    int mpl_unpack_param_value_##enum_name (const char* value_str,      \
-                                            void **value_pp,            \
-                                            const mpl_param_descr2_t *descr_p, \
-                                            const mpl_pack_options_t *options_p, \
-                                            mpl_param_element_id_t unpack_context) \
-    {                                                                   \
-        enum_type* p = malloc(sizeof(enum_type));                       \
-        int64_t value;                                                  \
-                                                                        \
-        MPL_IDENTIFIER_NOT_USED(options_p);                             \
-        MPL_IDENTIFIER_NOT_USED(unpack_context);                        \
-                                                                        \
-        if (NULL == p)                                                  \
-        {                                                               \
-            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,         \
-                                ("Failed allocating memory\n"));        \
-            set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);                  \
-            return (-1);                                                \
-        }                                                               \
-                                                                        \
-        if (convert_enum_name_to_int64(value_str,                       \
-                                       &value,                          \
-                                       descr_p->enum_values,            \
-                                       descr_p->enum_values_size) < 0)  \
-        {                                                               \
-            int64_t i;                                                      \
-                                                                        \
-            if (convert_int64(value_str, &i) < 0)                         \
-            {                                                           \
-                free(p);                                                \
-                return (-1);                                            \
-            }                                                           \
-                                                                        \
-            value = i;                                                  \
-                                                                        \
-            if (convert_enum_value_to_name(value,                       \
-                                           descr_p->enum_values,        \
-                                           descr_p->enum_values_size) == NULL) \
-            {                                                           \
-                MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,             \
-                                    ("Unpack enum failed: unknown value %" PRIi64 "\n", \
-                                     i));                               \
-                set_errno(E_MPL_FAILED_OPERATION);                      \
-                free(p);                                                \
-                return (-1);                                            \
-            }                                                           \
-        }                                                               \
-                                                                        \
-        assert(NULL != value_pp);                                       \
-        *p = (enum_type)value;                                          \
-        *value_pp = p;                                                  \
-                                                                        \
-        return (0);                                                     \
-    }
-
+    return sizeof(sint32_t);
+}
 
 /**
- * mpl_clone_param_value_enum()
+ * mpl_compare_param_value_sint32()
  **/
-    int
-    mpl_clone_param_value_enum(void **new_value_pp,
-                               const void* old_value_p,
-                               const mpl_param_descr2_t *descr_p)
+int mpl_compare_param_value_sint32(const void *value1_p,
+                                   const void* value2_p,
+                                   const mpl_param_descr2_t *descr_p)
 {
-    void* p = malloc(descr_p->enum_representation_bytesize);
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    return (*((sint32_t*) value1_p) != *((sint32_t*) value2_p));
+}
+
+
+/**
+ * mpl_pack_param_value_sint64()
+ **/
+int mpl_pack_param_value_sint64(const void* param_value_p,
+                                char *buf,
+                                size_t buflen,
+                                const mpl_param_descr2_t *descr_p,
+                                const mpl_pack_options_t *options_p)
+{
+    assert(NULL != param_value_p);
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    MPL_IDENTIFIER_NOT_USED(options_p)
+        return pack_int(buf, buflen, *(int64_t*)param_value_p);
+}
+
+/**
+ * mpl_unpack_param_value_sint64()
+ **/
+int
+    mpl_unpack_param_value_sint64(const char* value_str, void **value_pp,
+                                  const mpl_param_descr2_t *descr_p,
+                                  const mpl_pack_options_t *options_p,
+                                  mpl_param_element_id_t unpack_context)
+{
+    int64_t temp;
+    int64_t* p;
+    const int64_t *max_p = descr_p->max_p;
+    const int64_t *min_p = descr_p->min_p;
+    int range_id = 0;
+
+    MPL_IDENTIFIER_NOT_USED(options_p);
+    MPL_IDENTIFIER_NOT_USED(unpack_context);
+
+    p = malloc(sizeof(int64_t));
     if (NULL == p)
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
@@ -5409,181 +6580,232 @@ int mpl_unpack_param_value_enum(const char* value_str,
         return (-1);
     }
 
-    memcpy(p, old_value_p, descr_p->enum_representation_bytesize);
-    *new_value_pp = p;
+    /* An empty value is 0, as from strtoll() */
+    if (*value_str == '\0')
+        temp = 0;
+    else if (convert_int64(value_str, &temp) < 0)
+    {
+        free(p);
+        return (-1);
+    }
 
-    return (0);
+    if ((max_p != NULL) &&
+        (temp > *max_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack sint64 failed on max check: %"
+                             PRIi64 " > %" PRIi64 "\n", temp, *max_p));
+        set_errno(E_MPL_FAILED_OPERATION);
+        free(p);
+        return (-1);
+    }
+
+    if ((min_p != NULL) &&
+        (temp < *min_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack sint64 failed on min check: %"
+                             PRIi64 " < %" PRIi64 "\n", temp, *min_p));
+        set_errno(E_MPL_FAILED_OPERATION);
+        free(p);
+        return (-1);
+    }
+
+    if (descr_p->integer_ranges_size > 0) {
+        range_id = check_integer_ranges(temp,
+                                        descr_p->integer_ranges,
+                                        descr_p->integer_ranges_size);
+        if (range_id < 0) {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("Unpack sint64 failed on range check: %" PRIi64 "\n",
+                                 temp));
+            set_errno(E_MPL_FAILED_OPERATION);
+            free(p);
+            return (-1);
+        }
+    }
+
+    *p = temp;
+
+    assert(NULL != value_pp);
+    *value_pp = p;
+
+    return range_id;
 }
 
 /**
- * mpl_copy_param_value_enum()
+ * mpl_clone_param_value_sint64()
  **/
 int
-    mpl_copy_param_value_enum(void *to_value_p,
-                              const void* from_value_p,
-                              int size,
-                              const mpl_param_descr2_t *descr_p)
+    mpl_clone_param_value_sint64(void **new_value_pp,
+                                 const void* old_value_p,
+                                 const mpl_param_descr2_t *descr_p)
 {
-    if (size >= (int)descr_p->enum_representation_bytesize)
-        memcpy(to_value_p, from_value_p, descr_p->enum_representation_bytesize);
-    return descr_p->enum_representation_bytesize;
+    int64_t* p = malloc(sizeof(int64_t));
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    if (NULL == p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return (-1);
+    }
+
+    *p = *(int64_t*)old_value_p;
+    *new_value_pp = p;
+
+    return (0);
 }
 
 /**
- * mpl_compare_param_value_enum()
+ * mpl_copy_param_value_sint64()
  **/
-int mpl_compare_param_value_enum(const void *value1_p,
-                                 const void* value2_p,
-                                 const mpl_param_descr2_t *descr_p)
+int
+    mpl_copy_param_value_sint64(void *to_value_p,
+                                const void* from_value_p,
+                                int size,
+                                const mpl_param_descr2_t *descr_p)
 {
-    return memcmp(value1_p, value2_p, descr_p->enum_representation_bytesize);
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    if ((size_t)size >= sizeof(int64_t))
+        *(int64_t*)to_value_p = *(int64_t*)from_value_p;
+
+    return sizeof(int64_t);
 }
 
 /**
- * mpl_sizeof_param_value_enum()
+ * mpl_compare_param_value_sint64()
  **/
-size_t mpl_sizeof_param_value_enum(const mpl_param_descr2_t *descr_p)
+int mpl_compare_param_value_sint64(const void *value1_p,
+                                   const void* value2_p,
+                                   const mpl_param_descr2_t *descr_p)
 {
-    return descr_p->enum_representation_bytesize;
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    return (*((int64_t*) value1_p) != *((int64_t*) value2_p));
 }
 
 /**
- * mpl_pack_param_value_enum8()
+ * mpl_sizeof_param_value_sint64()
  **/
-DEFINE_MPL_PACK_PARAM_VALUE_ENUM(enum8, uint8_t, "d")
+size_t mpl_sizeof_param_value_sint64(const mpl_param_descr2_t *descr_p)
+{
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    return sizeof(int64_t);
+}
 
 
-/**
- * mpl_unpack_param_value_enum8()
- **/
-    DEFINE_MPL_UNPACK_PARAM_VALUE_ENUM(enum8, uint8_t)
 
 /**
- * mpl_pack_param_value_enum16()
+ * mpl_pack_param_value_uint8()
  **/
-    DEFINE_MPL_PACK_PARAM_VALUE_ENUM(enum16, uint16_t, "d")
+int mpl_pack_param_value_uint8(const void* param_value_p,
+                               char *buf,
+                               size_t buflen,
+                               const mpl_param_descr2_t *descr_p,
+                               const mpl_pack_options_t *options_p)
+{
+    assert(NULL != param_value_p);
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    MPL_IDENTIFIER_NOT_USED(options_p)
+        return pack_hex(buf, buflen, *(uint8_t*)param_value_p);
+}
 
 /**
- * mpl_unpack_param_value_enum16()
+ * mpl_unpack_param_value_uint8()
  **/
-    DEFINE_MPL_UNPACK_PARAM_VALUE_ENUM(enum16, uint16_t)
-
+int
+    mpl_unpack_param_value_uint8(const char* value_str, void **value_pp,
+                                 const mpl_param_descr2_t *descr_p,
+                                 const mpl_pack_options_t *options_p,
+                                 mpl_param_element_id_t unpack_context)
+{
+    int temp;
+    uint8_t* p;
+    const uint8_t *max_p = descr_p->max_p;
+    const uint8_t *min_p = descr_p->min_p;
+    int range_id = 0;
 
-/**
- * mpl_pack_param_value_enum32()
- **/
-    DEFINE_MPL_PACK_PARAM_VALUE_ENUM(enum32, uint32_t, "d")
+    MPL_IDENTIFIER_NOT_USED(options_p);
+    MPL_IDENTIFIER_NOT_USED(unpack_context);
 
-/**
- * mpl_unpack_param_value_enum32()
- **/
-    DEFINE_MPL_UNPACK_PARAM_VALUE_ENUM(enum32, uint32_t)
-
-/**
- * mpl_pack_param_value_signed_enum8()
- **/
-    DEFINE_MPL_PACK_PARAM_VALUE_ENUM(signed_enum8, sint8_t, "d")
-
-/**
- * mpl_unpack_param_value_signed_enum8()
- **/
-    DEFINE_MPL_UNPACK_PARAM_VALUE_ENUM(signed_enum8, sint8_t)
-
-/**
- * mpl_pack_param_value_signed_enum16()
- **/
-    DEFINE_MPL_PACK_PARAM_VALUE_ENUM(signed_enum16, sint16_t, "d")
-
-/**
- * mpl_unpack_param_value_signed_enum16()
- **/
-    DEFINE_MPL_UNPACK_PARAM_VALUE_ENUM(signed_enum16, sint16_t)
-
-/**
- * mpl_pack_param_value_signed_enum32()
- **/
-    DEFINE_MPL_PACK_PARAM_VALUE_ENUM(signed_enum32, sint32_t, "d")
-
-/**
- * mpl_unpack_param_value_signed_enum32()
- **/
-    DEFINE_MPL_UNPACK_PARAM_VALUE_ENUM(signed_enum32, sint32_t)
-
-/**
- * mpl_pack_param_value_bool()
- **/
-    int mpl_pack_param_value_bool(const void* param_value_p,
-                                  char *buf,
-                                  size_t buflen,
-                                  const mpl_param_descr2_t *descr_p,
-                                  const mpl_pack_options_t *options_p)
-{
-    int index;
-
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    MPL_IDENTIFIER_NOT_USED(options_p)
+    p = malloc(sizeof(uint8_t));
+    if (NULL == p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return (-1);
+    }
 
-        assert(NULL != param_value_p);
+    if (convert_int(value_str, &temp) < 0)
+    {
+        free(p);
+        return (-1);
+    }
 
-    index = *(bool*)param_value_p;
-    if (index >= (int)ARRAY_SIZE(mpl_names_bool))
+    if ((temp < 0) ||
+        (temp > (int)UINT8_MAX))
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Pack bool failed on range check: %d >= %zu\n",
-                             index, ARRAY_SIZE(mpl_names_bool)));/*lint !e557 %zu is C99 */
+                            ("Unpack uint8 failed on range check: %d\n", temp));
         set_errno(E_MPL_FAILED_OPERATION);
-        return -1;
+        free(p);
+        return (-1);
     }
 
-    return snprintf(buf, buflen, "=%s", mpl_names_bool[index]);
-}
-
-/**
- * mpl_unpack_param_value_bool()
- **/
-int mpl_unpack_param_value_bool(const char* value_str, void **value_pp,
-                                const mpl_param_descr2_t *descr_p,
-                                const mpl_pack_options_t *options_p,
-                                mpl_param_element_id_t unpack_context)
-{
-    int temp;
-    bool* p = malloc(sizeof(bool));
-
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    MPL_IDENTIFIER_NOT_USED(options_p);
-    MPL_IDENTIFIER_NOT_USED(unpack_context);
-
-    if (NULL == p)
+    if ((max_p != NULL) &&
+        ((uint8_t)temp > *max_p))
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack uint8 failed on max check: %d > %d\n",
+                             temp, *max_p));
+        set_errno(E_MPL_FAILED_OPERATION);
+        free(p);
         return (-1);
     }
 
-    if (convert_stringarr_to_int(value_str, &temp,
-                                 mpl_names_bool, ARRAY_SIZE(mpl_names_bool)) < 0)
+    if ((min_p != NULL) &&
+        ((uint8_t)temp < *min_p))
     {
-        if (convert_int(value_str, &temp) < 0)
-        {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack uint8 failed on min check: %d < %d\n",
+                             temp, *min_p));
+        set_errno(E_MPL_FAILED_OPERATION);
+        free(p);
+        return (-1);
+    }
+
+    if (descr_p->integer_ranges_size > 0) {
+        range_id = check_integer_ranges(temp,
+                                        descr_p->integer_ranges,
+                                        descr_p->integer_ranges_size);
+        if (range_id < 0) {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("Unpack uint8 failed on range check: %d\n",
+                                 temp));
+            set_errno(E_MPL_FAILED_OPERATION);
             free(p);
             return (-1);
         }
     }
 
-    *p = (bool)temp;
+    *p = (uint8_t)temp;
 
     assert(NULL != value_pp);
     *value_pp = p;
 
-    return (0);
+    return range_id;
 }
 
-int mpl_clone_param_value_bool(void **new_value_pp,
-                               const void* old_value_p,
-                               const mpl_param_descr2_t *descr_p)
+/**
+ * mpl_clone_param_value_uint8()
+ **/
+int
+    mpl_clone_param_value_uint8(void **new_value_pp,
+                                const void* old_value_p,
+                                const mpl_param_descr2_t *descr_p)
 {
-    bool* p = malloc(sizeof(bool));
+    uint8_t* p = malloc(sizeof(uint8_t));
     MPL_IDENTIFIER_NOT_USED(descr_p);
     if (NULL == p)
     {
@@ -5593,93 +6815,82 @@ int mpl_clone_param_value_bool(void **new_value_pp,
         return (-1);
     }
 
-    *p = *(bool*)old_value_p;
+    *p = *(uint8_t*)old_value_p;
     *new_value_pp = p;
 
     return (0);
 }
 
 /**
- * mpl_copy_param_value_bool()
+ * mpl_copy_param_value_uint8()
  **/
 int
-    mpl_copy_param_value_bool(void *to_value_p,
-                              const void* from_value_p,
-                              int size,
-                              const mpl_param_descr2_t *descr_p)
+    mpl_copy_param_value_uint8(void *to_value_p,
+                               const void* from_value_p,
+                               int size,
+                               const mpl_param_descr2_t *descr_p)
 {
     MPL_IDENTIFIER_NOT_USED(descr_p);
-    if (size >= (int)sizeof(bool))
-        *(bool*)to_value_p = *(bool*)from_value_p;
+    if (size >= (int)sizeof(uint8_t))
+        *(uint8_t*)to_value_p = *(uint8_t*)from_value_p;
 
-    return sizeof(bool);
+    return sizeof(uint8_t);
 }
 
 /**
- * mpl_compare_param_value_bool()
+ * mpl_compare_param_value_uint8()
  **/
-int mpl_compare_param_value_bool(const void *value1_p,
-                                 const void* value2_p,
-                                 const mpl_param_descr2_t *descr_p)
+int mpl_compare_param_value_uint8(const void *value1_p,
+                                  const void* value2_p,
+                                  const mpl_param_descr2_t *descr_p)
 {
     MPL_IDENTIFIER_NOT_USED(descr_p);
-    return (*((bool*) value1_p) != *((bool*) value2_p));
+    return (*((uint8_t*) value1_p) != *((uint8_t*) value2_p));
 }
 
 /**
- * mpl_sizeof_param_value_bool()
+ * mpl_sizeof_param_value_uint8()
  **/
-size_t mpl_sizeof_param_value_bool(const mpl_param_descr2_t *descr_p)
+size_t mpl_sizeof_param_value_uint8(const mpl_param_descr2_t *descr_p)
 {
     MPL_IDENTIFIER_NOT_USED(descr_p);
-    return sizeof(bool);
+    return sizeof(uint8_t);
 }
 
 /**
- * mpl_pack_param_value_bool8()
+ * mpl_pack_param_value_uint16()
  **/
-int mpl_pack_param_value_bool8(const void* param_value_p,
-                               char *buf,
-                               size_t buflen,
-                               const mpl_param_descr2_t *descr_p,
-                               const mpl_pack_options_t *options_p)
+int mpl_pack_param_value_uint16(const void* param_value_p,
+                                char *buf,
+                                size_t buflen,
+                                const mpl_param_descr2_t *descr_p,
+                                const mpl_pack_options_t *options_p)
 {
-    int index;
-
+    assert(NULL != param_value_p);
     MPL_IDENTIFIER_NOT_USED(descr_p);
     MPL_IDENTIFIER_NOT_USED(options_p)
-
-        assert(NULL != param_value_p);
-
-    index = *(uint8_t*)param_value_p;
-    if (index >= (int)ARRAY_SIZE(mpl_names_bool8))
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Pack bool8 failed on range check: %d >= %zu\n",
-                             index, ARRAY_SIZE(mpl_names_bool8)));/*lint !e557 %zu is C99 */
-        set_errno(E_MPL_FAILED_OPERATION);
-        return -1;
-    }
-
-    return snprintf(buf, buflen, "=%s", mpl_names_bool8[index]);
+        return pack_hex(buf, buflen, *(uint16_t*)param_value_p);
 }
 
 /**
- * mpl_unpack_param_value_bool8()
+ * mpl_unpack_param_value_uint16()
  **/
-int mpl_unpack_param_value_bool8(const char* value_str,
-                                 void **value_pp,
-                                 const mpl_param_descr2_t *descr_p,
-                                 const mpl_pack_options_t *options_p,
-                                 mpl_param_element_id_t unpack_context)
+int
+    mpl_unpack_param_value_uint16(const char* value_str, void **value_pp,
+                                  const mpl_param_descr2_t *descr_p,
+                                  const mpl_pack_options_t *options_p,
+                                  mpl_param_element_id_t unpack_context)
 {
-    int temp;
-    uint8_t* p = malloc(sizeof(uint8_t));
+    uint64_t temp;
+    uint16_t* p;
+    const uint16_t *max_p = descr_p->max_p;
+    const uint16_t *min_p = descr_p->min_p;
+    int range_id = 0;
 
-    MPL_IDENTIFIER_NOT_USED(descr_p);
     MPL_IDENTIFIER_NOT_USED(options_p);
     MPL_IDENTIFIER_NOT_USED(unpack_context);
 
+    p = malloc(sizeof(uint16_t));
     if (NULL == p)
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
@@ -5688,89 +6899,161 @@ int mpl_unpack_param_value_bool8(const char* value_str,
         return (-1);
     }
 
-    if (convert_stringarr_to_int(value_str, &temp,
-                                 mpl_names_bool8,
-                                 ARRAY_SIZE(mpl_names_bool8)) < 0)
+    if (convert_uint64(value_str, &temp) < 0)
     {
-        if (convert_int(value_str, &temp) < 0)
-        {
-            free(p);
-            return (-1);
-        }
+        free(p);
+        return (-1);
     }
 
-    *p = (uint8_t)temp;
+    if (temp > UINT16_MAX)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack uint16 failed on range check: 0x%"
+                             PRIu64 "\n", temp));
+        set_errno(E_MPL_FAILED_OPERATION);
+        free(p);
+        return (-1);
+    }
 
-    assert(NULL != value_pp);
-    *value_pp = p;
+    if ((max_p != NULL) &&
+        ((uint16_t)temp > *max_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack uint16 failed on max check: %"
+                             PRIu64 " > %" PRIu16 "\n", temp, *max_p));
+        set_errno(E_MPL_FAILED_OPERATION);
+        free(p);
+        return (-1);
+    }
 
-    return (0);
-}
+    if ((min_p != NULL) &&
+        ((uint16_t)temp < *min_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack uint16 failed on min check: %"
+                             PRIu64 " < %" PRIu16 "\n", temp, *min_p));
+        set_errno(E_MPL_FAILED_OPERATION);
+        free(p);
+        return (-1);
+    }
+
+    if (descr_p->integer_ranges_size > 0) {
+        range_id = check_integer_ranges(temp,
+                                        descr_p->integer_ranges,
+                                        descr_p->integer_ranges_size);
+        if (range_id < 0) {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("Unpack uint16 failed on range check: %" PRIu64 "\n",
+                                 temp));
+            set_errno(E_MPL_FAILED_OPERATION);
+            free(p);
+            return (-1);
+        }
+    }
 
+    *p = (uint16_t)temp;
+
+    assert(NULL != value_pp);
+    *value_pp = p;
+
+    return range_id;
+}
 
 /**
- * mpl_pack_param_value_uint8_array()
+ * mpl_clone_param_value_uint16()
  **/
-int mpl_pack_param_value_uint8_array(const void* param_value_p,
-                                     char *buf,
-                                     size_t buflen,
-                                     const mpl_param_descr2_t *descr_p,
-                                     const mpl_pack_options_t *options_p)
+int
+    mpl_clone_param_value_uint16(void **new_value_pp,
+                                 const void* old_value_p,
+                                 const mpl_param_descr2_t *descr_p)
 {
-    int i;
-    const mpl_uint8_array_t *a_p;
-    int len;
-    int total_len;
-
-    assert(NULL != param_value_p);
+    uint16_t* p = malloc(sizeof(uint16_t));
     MPL_IDENTIFIER_NOT_USED(descr_p);
-    MPL_IDENTIFIER_NOT_USED(options_p)
+    if (NULL == p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return (-1);
+    }
 
-        a_p = param_value_p;
+    *p = *(uint16_t*)old_value_p;
+    *new_value_pp = p;
 
-    len = snprintf(buf, buflen, "=%08x", a_p->len);
-    if ((int)buflen > len)
-        buf += len;
-    total_len = len;
+    return (0);
+}
 
-    for (i = 0; i < a_p->len; i++)
-    {
-        int left;
+/**
+ * mpl_copy_param_value_uint16()
+ **/
+int
+    mpl_copy_param_value_uint16(void *to_value_p,
+                                const void* from_value_p,
+                                int size,
+                                const mpl_param_descr2_t *descr_p)
+{
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    if (size >= (int)sizeof(uint16_t))
+        *(uint16_t*)to_value_p = *(uint16_t*)from_value_p;
 
-        left = (int)buflen > total_len ? (int)buflen - total_len : 0;
+    return sizeof(uint16_t);
+}
 
-        len = snprintf(buf, left, "%02x", a_p->arr_p[i]);
-        if (left > len)
-            buf += len;
-        total_len += len;
-    }
+/**
+ * mpl_compare_param_value_uint16()
+ **/
+int mpl_compare_param_value_uint16(const void *value1_p,
+                                   const void* value2_p,
+                                   const mpl_param_descr2_t *descr_p)
+{
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    return (*((uint16_t*) value1_p) != *((uint16_t*) value2_p));
+}
 
-    return total_len;
+/**
+ * mpl_sizeof_param_value_uint16()
+ **/
+size_t mpl_sizeof_param_value_uint16(const mpl_param_descr2_t *descr_p)
+{
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    return sizeof(uint16_t);
 }
 
 
 /**
- * mpl_unpack_param_value_uint8_array()
+ * mpl_pack_param_value_uint32()
+ **/
+int mpl_pack_param_value_uint32(const void* param_value_p,
+                                char *buf, size_t buflen,
+                                const mpl_param_descr2_t *descr_p,
+                                const mpl_pack_options_t *options_p)
+{
+    assert(NULL != param_value_p);
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    MPL_IDENTIFIER_NOT_USED(options_p)
+        return pack_hex(buf, buflen, *(uint32_t*)param_value_p);
+}
+
+/**
+ * mpl_unpack_param_value_uint32()
  **/
 int
-    mpl_unpack_param_value_uint8_array(const char* value_str, void **value_pp,
-                                       const mpl_param_descr2_t *descr_p,
-                                       const mpl_pack_options_t *options_p,
-                                       mpl_param_element_id_t unpack_context)
+    mpl_unpack_param_value_uint32(const char* value_str, void **value_pp,
+                                  const mpl_param_descr2_t *descr_p,
+                                  const mpl_pack_options_t *options_p,
+                                  mpl_param_element_id_t unpack_context)
 {
-    unsigned int len;
-    unsigned int i;
-    unsigned int val;
-    mpl_uint8_array_t *a_p;
-    uint8_t* p;
-    const int *max_p = descr_p->max_p;
-    const int *min_p = descr_p->min_p;
+    uint64_t temp;
+    uint32_t* p;
+    const uint32_t *max_p = descr_p->max_p;
+    const uint32_t *min_p = descr_p->min_p;
+    int range_id = 0;
 
     MPL_IDENTIFIER_NOT_USED(options_p);
     MPL_IDENTIFIER_NOT_USED(unpack_context);
 
-    a_p = malloc(sizeof(mpl_uint8_array_t));
-    if (NULL == a_p)
+    p = malloc(sizeof(uint32_t));
+    if (NULL == p)
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
                             ("Failed allocating memory\n"));
@@ -5778,237 +7061,161 @@ int
         return (-1);
     }
 
-    if (sscanf(value_str, "%8x", &len) <= 0)
+    if (convert_uint64(value_str, &temp) < 0)
     {
-        free(a_p);
+        free(p);
         return (-1);
     }
 
-    if ((max_p != NULL) &&
-        ((int)len > *max_p))
+    if (temp > UINT32_MAX)
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack uint8_array failed on max length check: %d > %d\n",
-                             len, *max_p));
+                            ("Unpack uint32 failed on range check: 0x%"
+                             PRIu64 "\n", temp));
         set_errno(E_MPL_FAILED_OPERATION);
-        free(a_p);
+        free(p);
         return (-1);
     }
 
-    if ((min_p != NULL) &&
-        ((int)len < *min_p))
+    if ((max_p != NULL) &&
+        ((uint32_t)temp > *max_p))
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack uint8_array failed on min length check: %d < %d\n",
-                             len, *min_p));
+                            ("Unpack uint32 failed on max check: %"
+                             PRIu64 " > %" PRIu32 "\n", temp, *max_p));
         set_errno(E_MPL_FAILED_OPERATION);
-        free(a_p);
+        free(p);
         return (-1);
     }
 
-    a_p->arr_p = malloc(len * sizeof(uint8_t));
-
-    if (NULL == a_p->arr_p)
+    if ((min_p != NULL) &&
+        ((uint32_t)temp < *min_p))
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        free(a_p);
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack uint32 failed on min check: %"
+                             PRIu64 " < %" PRIu32 "\n", temp, *min_p));
+        set_errno(E_MPL_FAILED_OPERATION);
+        free(p);
         return (-1);
     }
 
-    p = (uint8_t *) value_str + 8;
-    for (i = 0; i < len; i++)
-    {
-        if (sscanf((char*) p, "%2x", &val) <= 0)
-        {
-            free(a_p->arr_p);
-            free(a_p);
-            return -1;
+    if (descr_p->integer_ranges_size > 0) {
+        range_id = check_integer_ranges(temp,
+                                        descr_p->integer_ranges,
+                                        descr_p->integer_ranges_size);
+        if (range_id < 0) {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("Unpack uint32 failed on range check: %" PRIu64 "\n",
+                                 temp));
+            set_errno(E_MPL_FAILED_OPERATION);
+            free(p);
+            return (-1);
         }
-        a_p->arr_p[i] = (uint8_t) val;
-        p += 2;
     }
 
-    a_p->len = len;
+    *p = (uint32_t)temp;
 
     assert(NULL != value_pp);
-    *value_pp = a_p;
+    *value_pp = p;
 
-    return (0);
+    return range_id;
 }
 
 /**
- * mpl_clone_param_value_uint8_array()
+ * mpl_clone_param_value_uint32()
  **/
 int
-    mpl_clone_param_value_uint8_array(void **new_value_pp,
-                                      const void* old_value_p,
-                                      const mpl_param_descr2_t *descr_p)
+    mpl_clone_param_value_uint32(void **new_value_pp,
+                                 const void* old_value_p,
+                                 const mpl_param_descr2_t *descr_p)
 {
-    mpl_uint8_array_t *a_p;
-    const mpl_uint8_array_t *old_a_p;
-
+    uint32_t* p = malloc(sizeof(uint32_t));
     MPL_IDENTIFIER_NOT_USED(descr_p);
-    a_p = malloc(sizeof(mpl_uint8_array_t));
-    if (NULL == a_p)
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        return (-1);
-    }
-
-    old_a_p = old_value_p;
-
-    a_p->arr_p = malloc(old_a_p->len * sizeof(uint8_t));
-    if (NULL == a_p->arr_p)
+    if (NULL == p)
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
                             ("Failed allocating memory\n"));
         set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        free(a_p);
         return (-1);
     }
 
-    a_p->len = old_a_p->len;
-    memcpy(a_p->arr_p, old_a_p->arr_p, a_p->len * sizeof(uint8_t));
-
-    *new_value_pp = a_p;
+    *p = *(uint32_t*)old_value_p;
+    *new_value_pp = p;
 
     return (0);
 }
 
 /**
- * mpl_copy_param_value_uint8_array()
+ * mpl_copy_param_value_uint32()
  **/
 int
-    mpl_copy_param_value_uint8_array(void *to_value_p,
-                                     const void* from_value_p,
-                                     int size,
-                                     const mpl_param_descr2_t *descr_p)
+    mpl_copy_param_value_uint32(void *to_value_p,
+                                const void* from_value_p,
+                                int size,
+                                const mpl_param_descr2_t *descr_p)
 {
-    const mpl_uint8_array_t *arr_p = from_value_p;
-    int real_size = arr_p->len;
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-
-    if (real_size <= size )
-        memcpy(to_value_p, arr_p->arr_p, real_size);
+    if (size >= (int)sizeof(uint32_t))
+        *(uint32_t*)to_value_p = *(uint32_t*)from_value_p;
 
-    return real_size;
+    return sizeof(uint32_t);
 }
 
 /**
- * mpl_compare_param_value_uint8_array()
+ * mpl_compare_param_value_uint32()
  **/
-int mpl_compare_param_value_uint8_array(const void *value1_p,
-                                        const void* value2_p,
-                                        const mpl_param_descr2_t *descr_p)
+int mpl_compare_param_value_uint32(const void *value1_p,
+                                   const void* value2_p,
+                                   const mpl_param_descr2_t *descr_p)
 {
-    const mpl_uint8_array_t *a1_p;
-    const mpl_uint8_array_t *a2_p;
     MPL_IDENTIFIER_NOT_USED(descr_p);
-
-    a1_p = value1_p;
-    a2_p = value2_p;
-
-    if (a1_p->len != a2_p->len)
-        return -1;
-
-    return memcmp(a1_p->arr_p, a2_p->arr_p, a1_p->len * sizeof(uint8_t));
+    return (*((uint32_t*) value1_p) != *((uint32_t*) value2_p));
 }
 
 /**
- * mpl_sizeof_param_value_uint8_array()
+ * mpl_sizeof_param_value_uint32()
  **/
-size_t mpl_sizeof_param_value_uint8_array(const mpl_param_descr2_t *descr_p)
+size_t mpl_sizeof_param_value_uint32(const mpl_param_descr2_t *descr_p)
 {
     MPL_IDENTIFIER_NOT_USED(descr_p);
-    return 0;
-}
-
-/**
- * mpl_free_param_value_uint8_array()
- **/
-void mpl_free_param_value_uint8_array(void *value_p)
-{
-    mpl_uint8_array_t *a_p;
-
-    a_p = value_p;
-    if (NULL != a_p)
-    {
-        if (NULL != a_p->arr_p)
-        {
-            free(a_p->arr_p);
-        }
-        free(a_p);
-    }
+    return sizeof(uint32_t);
 }
 
 
 /**
- * mpl_pack_param_value_uint16_array()
+ * mpl_pack_param_value_uint64()
  **/
-int mpl_pack_param_value_uint16_array(const void* param_value_p,
-                                      char *buf,
-                                      size_t buflen,
-                                      const mpl_param_descr2_t *descr_p,
-                                      const mpl_pack_options_t *options_p)
+int mpl_pack_param_value_uint64(const void* param_value_p,
+                                char *buf,
+                                size_t buflen,
+                                const mpl_param_descr2_t *descr_p,
+                                const mpl_pack_options_t *options_p)
 {
-    int i;
-    const mpl_uint16_array_t *a_p;
-    int len;
-    int total_len;
-
     assert(NULL != param_value_p);
     MPL_IDENTIFIER_NOT_USED(descr_p);
-    MPL_IDENTIFIER_NOT_USED(options_p)
-
-        a_p = param_value_p;
-
-    len = snprintf(buf, buflen, "=%08x", a_p->len);
-    if ((int)buflen > len)
-        buf += len;
-    total_len = len;
-
-    for (i = 0; i < a_p->len; i++)
-    {
-        int left;
-
-        left = (int)buflen > total_len ? (int)buflen - total_len : 0;
-
-        len = snprintf(buf, left, "%04x", a_p->arr_p[i]);
-        if (left > len)
-            buf += len;
-        total_len += len;
-    }
-
-    return total_len;
+    MPL_IDENTIFIER_NOT_USED(options_p);
+    return pack_hex(buf, buflen, *(uint64_t*)param_value_p);
 }
 
-
 /**
- * mpl_unpack_param_value_uint16_array()
+ * mpl_unpack_param_value_uint64()
  **/
 int
-    mpl_unpack_param_value_uint16_array(const char* value_str, void **value_pp,
-                                        const mpl_param_descr2_t *descr_p,
-                                        const mpl_pack_options_t *options_p,
-                                        mpl_param_element_id_t unpack_context)
+    mpl_unpack_param_value_uint64(const char* value_str, void **value_pp,
+                                  const mpl_param_descr2_t *descr_p,
+                                  const mpl_pack_options_t *options_p,
+                                  mpl_param_element_id_t unpack_context)
 {
-    unsigned int len;
-    unsigned int i;
-    unsigned int val;
-    mpl_uint16_array_t *a_p;
-    uint8_t* p;
-    const int *max_p = descr_p->max_p;
-    const int *min_p = descr_p->min_p;
+    uint64_t temp;
+    uint64_t* p;
+    const uint64_t *max_p = descr_p->max_p;
+    const uint64_t *min_p = descr_p->min_p;
+    int range_id = 0;
 
     MPL_IDENTIFIER_NOT_USED(options_p);
     MPL_IDENTIFIER_NOT_USED(unpack_context);
 
-    a_p = malloc(sizeof(mpl_uint16_array_t));
-    if (NULL == a_p)
+    p = malloc(sizeof(uint64_t));
+    if (NULL == p)
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
                             ("Failed allocating memory\n"));
@@ -6016,612 +7223,763 @@ int
         return (-1);
     }
 
-    if (sscanf(value_str, "%8x", &len) <= 0)
+    if (convert_uint64(value_str, &temp) < 0)
     {
-        free(a_p);
+        free(p);
         return (-1);
     }
 
     if ((max_p != NULL) &&
-        ((int)len > *max_p))
+        (temp > *max_p))
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack uint16_array failed on "
-                             "max length check: %d > %d\n", len, *max_p));
+                            ("Unpack uint64 failed on max check: %"
+                             PRIu64 " > %" PRIu64 "\n", temp, *max_p));
         set_errno(E_MPL_FAILED_OPERATION);
-        free(a_p);
+        free(p);
         return (-1);
     }
 
     if ((min_p != NULL) &&
-        ((int)len < *min_p))
+        (temp < *min_p))
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack uint16_array failed on "
-                             "min length check: %d < %d\n", len, *min_p));
+                            ("Unpack uint64 failed on min check: %"
+                             PRIu64 " < %" PRIu64 "\n", temp, *min_p));
         set_errno(E_MPL_FAILED_OPERATION);
-        free(a_p);
-        return (-1);
-    }
-
-    a_p->arr_p = malloc(len * sizeof(uint16_t));
-
-    if (NULL == a_p->arr_p)
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        free(a_p);
+        free(p);
         return (-1);
     }
 
-    p = (uint8_t *) value_str + 8;
-    for (i = 0; i < len; i++)
-    {
-        if (sscanf((char*) p, "%4x", &val) <= 0)
-        {
-            free(a_p->arr_p);
-            free(a_p);
-            return -1;
+    if (descr_p->integer_ranges_size > 0) {
+        range_id = check_integer_ranges(temp,
+                                        descr_p->integer_ranges,
+                                        descr_p->integer_ranges_size);
+        if (range_id < 0) {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("Unpack uint64 failed on range check: %" PRIu64 "\n",
+                                 temp));
+            set_errno(E_MPL_FAILED_OPERATION);
+            free(p);
+            return (-1);
         }
-        a_p->arr_p[i] = (uint16_t) val;
-        p += 4;
     }
 
-    a_p->len = len;
+    *p = temp;
 
     assert(NULL != value_pp);
-    *value_pp = a_p;
+    *value_pp = p;
 
-    return (0);
+    return range_id;
 }
 
 /**
- * mpl_clone_param_value_uint16_array()
+ * mpl_clone_param_value_uint64()
  **/
 int
-    mpl_clone_param_value_uint16_array(void **new_value_pp,
-                                       const void* old_value_p,
-                                       const mpl_param_descr2_t *descr_p)
+    mpl_clone_param_value_uint64(void **new_value_pp,
+                                 const void* old_value_p,
+                                 const mpl_param_descr2_t *descr_p)
 {
-    mpl_uint16_array_t *a_p;
-    const mpl_uint16_array_t *old_a_p;
+    uint64_t* p = malloc(sizeof(uint64_t));
     MPL_IDENTIFIER_NOT_USED(descr_p);
-
-    a_p = malloc(sizeof(mpl_uint16_array_t));
-    if (NULL == a_p)
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        return (-1);
-    }
-
-    old_a_p = old_value_p;
-
-    a_p->arr_p = malloc(old_a_p->len * sizeof(uint16_t));
-    if (NULL == a_p->arr_p)
+    if (NULL == p)
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
                             ("Failed allocating memory\n"));
         set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        free(a_p);
         return (-1);
     }
 
-    a_p->len = old_a_p->len;
-    memcpy(a_p->arr_p, old_a_p->arr_p, a_p->len * sizeof(uint16_t));
-
-    *new_value_pp = a_p;
+    *p = *(uint64_t*)old_value_p;
+    *new_value_pp = p;
 
     return (0);
 }
 
 /**
- * mpl_copy_param_value_uint16_array()
+ * mpl_copy_param_value_uint64()
  **/
 int
-    mpl_copy_param_value_uint16_array(void *to_value_p,
-                                      const void* from_value_p,
-                                      int size,
-                                      const mpl_param_descr2_t *descr_p)
+    mpl_copy_param_value_uint64(void *to_value_p,
+                                const void* from_value_p,
+                                int size,
+                                const mpl_param_descr2_t *descr_p)
 {
-    const mpl_uint16_array_t *arr_p = from_value_p;
-    int real_size = arr_p->len * sizeof(uint16_t);
     MPL_IDENTIFIER_NOT_USED(descr_p);
+    if ((size_t)size >= sizeof(uint64_t))
+        *(uint64_t*)to_value_p = *(uint64_t*)from_value_p;
 
-    if (real_size <= size )
-        memcpy(to_value_p, arr_p->arr_p, real_size);
-
-    return real_size;
+    return sizeof(uint64_t);
 }
 
 /**
- * mpl_compare_param_value_uint16_array()
+ * mpl_compare_param_value_uint64()
  **/
-int mpl_compare_param_value_uint16_array(const void *value1_p,
-                                         const void* value2_p,
-                                         const mpl_param_descr2_t *descr_p)
+int mpl_compare_param_value_uint64(const void *value1_p,
+                                   const void* value2_p,
+                                   const mpl_param_descr2_t *descr_p)
 {
-    const mpl_uint16_array_t *a1_p;
-    const mpl_uint16_array_t *a2_p;
     MPL_IDENTIFIER_NOT_USED(descr_p);
-
-    a1_p = value1_p;
-    a2_p = value2_p;
-
-    if (a1_p->len != a2_p->len)
-        return -1;
-
-    return memcmp(a1_p->arr_p, a2_p->arr_p, a1_p->len * sizeof(uint16_t));
+    return (*((uint64_t*) value1_p) != *((uint64_t*) value2_p));
 }
 
 /**
- * mpl_sizeof_param_value_uint16_array()
+ * mpl_sizeof_param_value_uint64()
  **/
-size_t mpl_sizeof_param_value_uint16_array(const mpl_param_descr2_t *descr_p)
+size_t mpl_sizeof_param_value_uint64(const mpl_param_descr2_t *descr_p)
 {
     MPL_IDENTIFIER_NOT_USED(descr_p);
-    return 0;
-}
-
-/**
- * mpl_free_param_value_uint16_array()
- **/
-void mpl_free_param_value_uint16_array(void *value_p)
-{
-    mpl_uint16_array_t *a_p;
-
-    a_p = value_p;
-    if (NULL != a_p)
-    {
-        if (NULL != a_p->arr_p)
-        {
-            free(a_p->arr_p);
-        }
-        free(a_p);
-    }
+    return sizeof(uint64_t);
 }
 
-
 /**
- * mpl_pack_param_value_uint32_array()
+ * mpl_pack_param_value_enum()
  **/
-int mpl_pack_param_value_uint32_array(const void* param_value_p,
-                                      char *buf,
-                                      size_t buflen,
-                                      const mpl_param_descr2_t *descr_p,
-                                      const mpl_pack_options_t *options_p)
+int mpl_pack_param_value_enum (const void* param_value_p,
+                               char *buf,
+                               size_t buflen,
+                               const mpl_param_descr2_t *descr_p,
+                               const mpl_pack_options_t *options_p)
 {
-    unsigned int i;
-    const mpl_uint32_array_t *a_p;
-    int len;
-    int total_len;
-
-    assert(NULL != param_value_p);
-    MPL_IDENTIFIER_NOT_USED(descr_p);
+    int64_t value;
+    const char *name_p;
     MPL_IDENTIFIER_NOT_USED(options_p)
+        assert(NULL != param_value_p);
+    assert(NULL != descr_p->enum_values);
 
-        a_p = param_value_p;
-
-    len = snprintf(buf, buflen, "=%08" PRIx32, a_p->len);
-    if ((int)buflen > len)
-        buf += len;
-    total_len = len;
+    switch (descr_p->enum_representation_bytesize) {
+        case 1:
+            if (descr_p->enum_representation_signed)
+                value = *((sint8_t*)param_value_p);
+            else
+                value = *((uint8_t*)param_value_p);
+            break;
+        case 2:
+            if (descr_p->enum_representation_signed)
+                value = *((sint16_t*)param_value_p);
+            else
+                value = *((uint16_t*)param_value_p);
+            break;
+        case 4:
+            if (descr_p->enum_representation_signed)
+                value = *((sint32_t*)param_value_p);
+            else
+                value = *((uint32_t*)param_value_p);
+            break;
+        default:
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("Pack enum failed: no support for 8 byte enum representations\n"));
+            set_errno(E_MPL_FAILED_OPERATION);
+            return (-1);
+    }
 
-    for (i = 0; i < a_p->len; i++)
+    name_p = convert_enum_value_to_name(value, descr_p);
+    if (name_p == NULL)
     {
-        int left;
-
-        left = (int)buflen > total_len ? (int)buflen - total_len : 0;
-
-        len = snprintf(buf, left, "%08" PRIx32, a_p->arr_p[i]);
-        if (left > len)
-            buf += len;
-        total_len += len;
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Pack enum failed: unknown value %" PRIi64 "\n",
+                             value));
+        set_errno(E_MPL_FAILED_OPERATION);
+        return (-1);
     }
-
-    return total_len;
+    return pack_name(buf, buflen, name_p);
 }
 
+#define DEFINE_MPL_PACK_PARAM_VALUE_ENUM(enum_name, enum_type, format)         \
+    int mpl_pack_param_value_##enum_name (const void* param_value_p,    \
+                                          char *buf,                    \
+                                          size_t buflen,                \
+                                          const mpl_param_descr2_t *descr_p, \
+                                          const mpl_pack_options_t *options_p) \
+    {                                                                   \
+        enum_type value;                                                \
+        const char *name_p;                                             \
+        MPL_IDENTIFIER_NOT_USED(options_p)                              \
+            assert(NULL != param_value_p);                              \
+        assert(NULL != descr_p->enum_values);                           \
+                                                                        \
+        value = *((enum_type*)param_value_p);                           \
+        name_p = convert_enum_value_to_name(value, descr_p);            \
+        if (name_p == NULL)                                             \
+        {                                                               \
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,                 \
+                                ("Pack enum failed: unknown value %" format "\n", \
+                                 value));                               \
+            set_errno(E_MPL_FAILED_OPERATION);                          \
+            return (-1);                                                \
+        }                                                               \
+                                                                        \
+        return pack_name(buf, buflen, name_p);                          \
+    }                                                                   \
+
 
 /**
- * mpl_unpack_param_value_uint32_array()
+ * mpl_unpack_param_value_enum()
  **/
-int
-    mpl_unpack_param_value_uint32_array(const char* value_str,
-                                        void **value_pp,
-                                        const mpl_param_descr2_t *descr_p,
-                                        const mpl_pack_options_t *options_p,
-                                        mpl_param_element_id_t unpack_context)
+int mpl_unpack_param_value_enum(const char* value_str,
+                                void **value_pp,
+                                const mpl_param_descr2_t *descr_p,
+                                const mpl_pack_options_t *options_p,
+                                mpl_param_element_id_t unpack_context)
 {
-    unsigned int len;
-    unsigned int i;
-    unsigned int val;
-    mpl_uint32_array_t *a_p;
-    uint8_t* p;
-    const int *max_p = descr_p->max_p;
-    const int *min_p = descr_p->min_p;
-
+    void* p = malloc(descr_p->enum_representation_bytesize);
+    int64_t value;
     MPL_IDENTIFIER_NOT_USED(options_p);
     MPL_IDENTIFIER_NOT_USED(unpack_context);
-
-    a_p = malloc(sizeof(mpl_uint32_array_t));
-    if (NULL == a_p)
+    if (NULL == p)
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
                             ("Failed allocating memory\n"));
         set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
         return (-1);
     }
-
-    if (sscanf(value_str, "%8x", &len) <= 0)
+    if (convert_enum_name_to_int64(value_str,
+                                   &value,
+                                   descr_p) < 0)
     {
-        free(a_p);
-        return (-1);
+        int64_t i;
+        if (convert_int64(value_str, &i) < 0)
+        {
+            free(p);
+            return (-1);
+        }
+        value = i;
+        if (convert_enum_value_to_name(value, descr_p) == NULL)
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("Unpack enum failed: unknown value %" PRIi64 "\n",
+                                 i));
+            set_errno(E_MPL_FAILED_OPERATION);
+            free(p);
+            return (-1);
+        }
     }
+    assert(NULL != value_pp);
 
-    if ((max_p != NULL) &&
-        ((int)len > *max_p))
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack uint32_array failed on "
-                             "max length check: %d > %d\n", len, *max_p));
-        set_errno(E_MPL_FAILED_OPERATION);
-        free(a_p);
-        return (-1);
+    switch (descr_p->enum_representation_bytesize) {
+        case 1:
+            if (descr_p->enum_representation_signed)
+                *((sint8_t*)p) = value;
+            else
+                *((uint8_t*)p) = value;
+            break;
+        case 2:
+            if (descr_p->enum_representation_signed)
+                *((sint16_t*)p) = value;
+            else
+                *((uint16_t*)p) = value;
+            break;
+        case 4:
+            if (descr_p->enum_representation_signed)
+                *((sint32_t*)p) = value;
+            else
+                *((uint32_t*)p) = value;
+            break;
+        default:
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("Unpack enum failed: no support for 8 byte enum representations\n"));
+            set_errno(E_MPL_FAILED_OPERATION);
+            free(p);
+            return (-1);
     }
+    *value_pp = p;
+    return (0);
+}
 
-    if ((min_p != NULL) &&
-        ((int)len < *min_p))
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack uint32_array failed on "
-                             "min length check: %d < %d\n", len, *min_p));
-        set_errno(E_MPL_FAILED_OPERATION);
-        free(a_p);
-        return (-1);
+
+#define DEFINE_MPL_UNPACK_PARAM_VALUE_ENUM(enum_name, enum_type)        \
+    int mpl_unpack_param_value_##enum_name (const char* value_str,      \
+                                            void **value_pp,            \
+                                            const mpl_param_descr2_t *descr_p, \
+                                            const mpl_pack_options_t *options_p, \
+                                            mpl_param_element_id_t unpack_context) \
+    {                                                                   \
+        enum_type* p = malloc(sizeof(enum_type));                       \
+        int64_t value;                                                  \
+                                                                        \
+        MPL_IDENTIFIER_NOT_USED(options_p);                             \
+        MPL_IDENTIFIER_NOT_USED(unpack_context);                        \
+                                                                        \
+        if (NULL == p)                                                  \
+        {                                                               \
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,         \
+                                ("Failed allocating memory\n"));        \
+            set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);                  \
+            return (-1);                                                \
+        }                                                               \
+                                                                        \
+        if (convert_enum_name_to_int64(value_str,                       \
+                                       &value,                          \
+                                       descr_p) < 0)                    \
+        {                                                               \
+            int64_t i;                                                      \
+                                                                        \
+            if (convert_int64(value_str, &i) < 0)                         \
+            {                                                           \
+                free(p);                                                \
+                return (-1);                                            \
+            }                                                           \
+                                                                        \
+            value = i;                                                  \
+                                                                        \
+            if (convert_enum_value_to_name(value, descr_p) == NULL)     \
+            {                                                           \
+                MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,             \
+                                    ("Unpack enum failed: unknown value %" PRIi64 "\n", \
+                                     i));                               \
+                set_errno(E_MPL_FAILED_OPERATION);                      \
+                free(p);                                                \
+                return (-1);                                            \
+            }                                                           \
+        }                                                               \
+                                                                        \
+        assert(NULL != value_pp);                                       \
+        *p = (enum_type)value;                                          \
+        *value_pp = p;                                                  \
+                                                                        \
+        return (0);                                                     \
     }
 
-    a_p->arr_p = malloc(len * sizeof(uint32_t));
 
-    if (NULL == a_p->arr_p)
+/**
+ * mpl_clone_param_value_enum()
+ **/
+    int
+    mpl_clone_param_value_enum(void **new_value_pp,
+                               const void* old_value_p,
+                               const mpl_param_descr2_t *descr_p)
+{
+    void* p = malloc(descr_p->enum_representation_bytesize);
+    if (NULL == p)
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
                             ("Failed allocating memory\n"));
         set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        free(a_p);
         return (-1);
     }
 
-    p = (uint8_t *) value_str + 8;
-    for (i = 0; i < len; i++)
-    {
-        if (sscanf((char*) p, "%8x", &val) <= 0)
-        {
-            free(a_p->arr_p);
-            free(a_p);
-            return -1;
-        }
-        a_p->arr_p[i] = (uint32_t) val;
-        p += 8;
-    }
-
-    a_p->len = len;
-
-    assert(NULL != value_pp);
-    *value_pp = a_p;
+    memcpy(p, old_value_p, descr_p->enum_representation_bytesize);
+    *new_value_pp = p;
 
     return (0);
 }
 
 /**
- * mpl_clone_param_value_uint32_array()
+ * mpl_copy_param_value_enum()
  **/
 int
-    mpl_clone_param_value_uint32_array(void **new_value_pp,
-                                       const void* old_value_p,
-                                       const mpl_param_descr2_t *descr_p)
+    mpl_copy_param_value_enum(void *to_value_p,
+                              const void* from_value_p,
+                              int size,
+                              const mpl_param_descr2_t *descr_p)
 {
-    mpl_uint32_array_t *a_p;
-    const mpl_uint32_array_t *old_a_p;
-    MPL_IDENTIFIER_NOT_USED(descr_p);
+    if (size >= (int)descr_p->enum_representation_bytesize)
+        memcpy(to_value_p, from_value_p, descr_p->enum_representation_bytesize);
+    return descr_p->enum_representation_bytesize;
+}
 
-    a_p = malloc(sizeof(mpl_uint32_array_t));
-    if (NULL == a_p)
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        return (-1);
-    }
-
-    old_a_p = old_value_p;
+/**
+ * mpl_compare_param_value_enum()
+ **/
+int mpl_compare_param_value_enum(const void *value1_p,
+                                 const void* value2_p,
+                                 const mpl_param_descr2_t *descr_p)
+{
+    return memcmp(value1_p, value2_p, descr_p->enum_representation_bytesize);
+}
 
-    a_p->arr_p = malloc(old_a_p->len * sizeof(uint32_t));
-    if (NULL == a_p->arr_p)
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        free(a_p);
-        return (-1);
-    }
+/**
+ * mpl_sizeof_param_value_enum()
+ **/
+size_t mpl_sizeof_param_value_enum(const mpl_param_descr2_t *descr_p)
+{
+    return descr_p->enum_representation_bytesize;
+}
 
-    a_p->len = old_a_p->len;
-    memcpy(a_p->arr_p, old_a_p->arr_p, a_p->len * sizeof(uint32_t));
+/**
+ * mpl_pack_param_value_enum8()
+ **/
+DEFINE_MPL_PACK_PARAM_VALUE_ENUM(enum8, uint8_t, "d")
 
-    *new_value_pp = a_p;
 
-    return (0);
-}
+/**
+ * mpl_unpack_param_value_enum8()
+ **/
+    DEFINE_MPL_UNPACK_PARAM_VALUE_ENUM(enum8, uint8_t)
 
 /**
- * mpl_copy_param_value_uint32_array()
+ * mpl_pack_param_value_enum16()
  **/
-int
-    mpl_copy_param_value_uint32_array(void *to_value_p,
-                                      const void* from_value_p,
-                                      int size,
-                                      const mpl_param_descr2_t *descr_p)
-{
-    const mpl_uint32_array_t *arr_p = from_value_p;
-    int real_size = arr_p->len * sizeof(uint32_t);
-    MPL_IDENTIFIER_NOT_USED(descr_p);
+    DEFINE_MPL_PACK_PARAM_VALUE_ENUM(enum16, uint16_t, "d")
 
-    if (real_size <= size )
-        memcpy(to_value_p, arr_p->arr_p, real_size);
+/**
+ * mpl_unpack_param_value_enum16()
+ **/
+    DEFINE_MPL_UNPACK_PARAM_VALUE_ENUM(enum16, uint16_t)
 
-    return real_size;
-}
 
 /**
- * mpl_compare_param_value_uint32_array()
+ * mpl_pack_param_value_enum32()
  **/
-int mpl_compare_param_value_uint32_array(const void *value1_p,
-                                         const void* value2_p,
-                                         const mpl_param_descr2_t *descr_p)
-{
-    const mpl_uint32_array_t *a1_p;
-    const mpl_uint32_array_t *a2_p;
-    MPL_IDENTIFIER_NOT_USED(descr_p);
+    DEFINE_MPL_PACK_PARAM_VALUE_ENUM(enum32, uint32_t, "d")
 
-    a1_p = value1_p;
-    a2_p = value2_p;
+/**
+ * mpl_unpack_param_value_enum32()
+ **/
+    DEFINE_MPL_UNPACK_PARAM_VALUE_ENUM(enum32, uint32_t)
 
-    if (a1_p->len != a2_p->len)
-        return -1;
+/**
+ * mpl_pack_param_value_signed_enum8()
+ **/
+    DEFINE_MPL_PACK_PARAM_VALUE_ENUM(signed_enum8, sint8_t, "d")
 
-    return memcmp(a1_p->arr_p, a2_p->arr_p, a1_p->len * sizeof(uint32_t));
-}
+/**
+ * mpl_unpack_param_value_signed_enum8()
+ **/
+    DEFINE_MPL_UNPACK_PARAM_VALUE_ENUM(signed_enum8, sint8_t)
 
 /**
- * mpl_sizeof_param_value_uint32_array()
+ * mpl_pack_param_value_signed_enum16()
  **/
-size_t mpl_sizeof_param_value_uint32_array(const mpl_param_descr2_t *descr_p)
-{
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    return 0;
-}
+    DEFINE_MPL_PACK_PARAM_VALUE_ENUM(signed_enum16, sint16_t, "d")
 
 /**
- * mpl_free_param_value_uint32_array()
+ * mpl_unpack_param_value_signed_enum16()
  **/
-void mpl_free_param_value_uint32_array(void *value_p)
-{
-    mpl_uint32_array_t *a_p;
+    DEFINE_MPL_UNPACK_PARAM_VALUE_ENUM(signed_enum16, sint16_t)
 
-    a_p = value_p;
-    if (NULL != a_p)
-    {
-        if (NULL != a_p->arr_p)
-        {
-            free(a_p->arr_p);
-        }
-        free(a_p);
-    }
-}
+/**
+ * mpl_pack_param_value_signed_enum32()
+ **/
+    DEFINE_MPL_PACK_PARAM_VALUE_ENUM(signed_enum32, sint32_t, "d")
 
+/**
+ * mpl_unpack_param_value_signed_enum32()
+ **/
+    DEFINE_MPL_UNPACK_PARAM_VALUE_ENUM(signed_enum32, sint32_t)
 
 /**
- * mpl_pack_param_value_string_tuple()
+ * mpl_pack_param_value_bool()
  **/
-int mpl_pack_param_value_string_tuple(const void* param_value_p,
-                                      char *buf,
-                                      size_t buflen,
-                                      const mpl_param_descr2_t *descr_p,
-                                      const mpl_pack_options_t *options_p)
+    int mpl_pack_param_value_bool(const void* param_value_p,
+                                  char *buf,
+                                  size_t buflen,
+                                  const mpl_param_descr2_t *descr_p,
+                                  const mpl_pack_options_t *options_p)
 {
-    const mpl_string_tuple_t *st_p;
+    int index;
+
     MPL_IDENTIFIER_NOT_USED(descr_p);
+    MPL_IDENTIFIER_NOT_USED(options_p)
 
-    assert(NULL != param_value_p);
+        assert(NULL != param_value_p);
 
-    st_p = param_value_p;
-    assert(NULL != st_p->key_p);
+    index = *(bool*)param_value_p;
+    if (index >= (int)ARRAY_SIZE(mpl_names_bool))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Pack bool failed on range check: %d >= %zu\n",
+                             index, ARRAY_SIZE(mpl_names_bool)));/*lint !e557 %zu is C99 */
+        set_errno(E_MPL_FAILED_OPERATION);
+        return -1;
+    }
 
-    if (NULL != st_p->value_p)
-        return snprintf_escape(options_p->message_delimiter, '\\',
-                               buf, buflen, "=%s:%s", st_p->key_p, st_p->value_p);
-    else
-        return snprintf_escape(options_p->message_delimiter, '\\',
-                               buf, buflen, "=%s:", st_p->key_p);
+    return pack_name(buf, buflen, mpl_names_bool[index]);
 }
 
-
 /**
- * mpl_unpack_param_value_string_tuple()
+ * mpl_unpack_param_value_bool()
  **/
-int
-    mpl_unpack_param_value_string_tuple(const char* value_str, void **value_pp,
-                                        const mpl_param_descr2_t *descr_p,
-                                        const mpl_pack_options_t *options_p,
-                                        mpl_param_element_id_t unpack_context)
+int mpl_unpack_param_value_bool(const char* value_str, void **value_pp,
+                                const mpl_param_descr2_t *descr_p,
+                                const mpl_pack_options_t *options_p,
+                                mpl_param_element_id_t unpack_context)
 {
-    mpl_string_tuple_t *st_p;
-    char* p;
-    size_t slen;
-    char *temp_str;
-    int temp_string_allocated = 0;
-    const int *max_p = descr_p->max_p;
-    const int *min_p = descr_p->min_p;
-    MPL_IDENTIFIER_NOT_USED(unpack_context);
+    int temp;
+    bool* p = malloc(sizeof(bool));
 
-    if (strchr(value_str, '\\')) {
-        temp_str = remove_escape(value_str, '\\');
-        if (temp_str == NULL) {
-            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                                ("Failed allocating memory\n"));
-            set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-            return (-1);
-        }
-        temp_string_allocated = 1;
-    }
-    else {
-        temp_str = (char*) value_str;
-    }
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    MPL_IDENTIFIER_NOT_USED(options_p);
+    MPL_IDENTIFIER_NOT_USED(unpack_context);
 
-    p = strchr(temp_str, ':');
     if (NULL == p)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack string_tuple failed, no delimiter: %s\n",
-                             temp_str));
-        set_errno(E_MPL_FAILED_OPERATION);
-        if (temp_string_allocated)
-            free(temp_str);
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
         return (-1);
     }
 
-    st_p = malloc(sizeof(mpl_string_tuple_t));
-    if (NULL == st_p)
+    if (convert_stringarr_to_int(value_str, &temp,
+                                 mpl_names_bool, ARRAY_SIZE(mpl_names_bool)) < 0)
+    {
+        if (convert_int(value_str, &temp) < 0)
+        {
+            free(p);
+            return (-1);
+        }
+    }
+
+    *p = (bool)temp;
+
+    assert(NULL != value_pp);
+    *value_pp = p;
+
+    return (0);
+}
+
+int mpl_clone_param_value_bool(void **new_value_pp,
+                               const void* old_value_p,
+                               const mpl_param_descr2_t *descr_p)
+{
+    bool* p = malloc(sizeof(bool));
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    if (NULL == p)
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
                             ("Failed allocating memory\n"));
         set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        if (temp_string_allocated)
-            free(temp_str);
         return (-1);
     }
 
-    slen = p - temp_str;
+    *p = *(bool*)old_value_p;
+    *new_value_pp = p;
 
-    if ((max_p != NULL) &&
-        ((int)slen > *max_p))
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack string_tuple key failed on "
-                             "max length check: %zu > %d\n",
-                             slen,
-                             *max_p));/*lint !e557 %zu is C99 */
-        set_errno(E_MPL_FAILED_OPERATION);
-        free(st_p);
-        if (temp_string_allocated)
-            free(temp_str);
-        return (-1);
-    }
+    return (0);
+}
 
-    if ((min_p != NULL) &&
-        ((int)slen < *min_p))
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack string_tuple key failed on "
-                             "min length check: %zu < %d\n",
-                             slen,
-                             *min_p));/*lint !e557 %zu is C99 */
+/**
+ * mpl_copy_param_value_bool()
+ **/
+int
+    mpl_copy_param_value_bool(void *to_value_p,
+                              const void* from_value_p,
+                              int size,
+                              const mpl_param_descr2_t *descr_p)
+{
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    if (size >= (int)sizeof(bool))
+        *(bool*)to_value_p = *(bool*)from_value_p;
+
+    return sizeof(bool);
+}
+
+/**
+ * mpl_compare_param_value_bool()
+ **/
+int mpl_compare_param_value_bool(const void *value1_p,
+                                 const void* value2_p,
+                                 const mpl_param_descr2_t *descr_p)
+{
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    return (*((bool*) value1_p) != *((bool*) value2_p));
+}
+
+/**
+ * mpl_sizeof_param_value_bool()
+ **/
+size_t mpl_sizeof_param_value_bool(const mpl_param_descr2_t *descr_p)
+{
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    return sizeof(bool);
+}
+
+/**
+ * mpl_pack_param_value_bool8()
+ **/
+int mpl_pack_param_value_bool8(const void* param_value_p,
+                               char *buf,
+                               size_t buflen,
+                               const mpl_param_descr2_t *descr_p,
+                               const mpl_pack_options_t *options_p)
+{
+    int index;
+
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    MPL_IDENTIFIER_NOT_USED(options_p)
+
+        assert(NULL != param_value_p);
+
+    index = *(uint8_t*)param_value_p;
+    if (index >= (int)ARRAY_SIZE(mpl_names_bool8))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Pack bool8 failed on range check: %d >= %zu\n",
+                             index, ARRAY_SIZE(mpl_names_bool8)));/*lint !e557 %zu is C99 */
         set_errno(E_MPL_FAILED_OPERATION);
-        free(st_p);
-        if (temp_string_allocated)
-            free(temp_str);
+        return -1;
+    }
+
+    return pack_name(buf, buflen, mpl_names_bool8[index]);
+}
+
+/**
+ * mpl_unpack_param_value_bool8()
+ **/
+int mpl_unpack_param_value_bool8(const char* value_str,
+                                 void **value_pp,
+                                 const mpl_param_descr2_t *descr_p,
+                                 const mpl_pack_options_t *options_p,
+                                 mpl_param_element_id_t unpack_context)
+{
+    int temp;
+    uint8_t* p = malloc(sizeof(uint8_t));
+
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    MPL_IDENTIFIER_NOT_USED(options_p);
+    MPL_IDENTIFIER_NOT_USED(unpack_context);
+
+    if (NULL == p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
         return (-1);
     }
 
-    st_p->key_p = malloc(slen + 1);
-    if (NULL == st_p->key_p)
+    if (convert_stringarr_to_int(value_str, &temp,
+                                 mpl_names_bool8,
+                                 ARRAY_SIZE(mpl_names_bool8)) < 0)
+    {
+        if (convert_int(value_str, &temp) < 0)
+        {
+            free(p);
+            return (-1);
+        }
+    }
+
+    *p = (uint8_t)temp;
+
+    assert(NULL != value_pp);
+    *value_pp = p;
+
+    return (0);
+}
+
+
+/**
+ * mpl_pack_param_value_uint8_array()
+ **/
+int mpl_pack_param_value_uint8_array(const void* param_value_p,
+                                     char *buf,
+                                     size_t buflen,
+                                     const mpl_param_descr2_t *descr_p,
+                                     const mpl_pack_options_t *options_p)
+{
+    const mpl_uint8_array_t *a_p;
+
+    assert(NULL != param_value_p);
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    MPL_IDENTIFIER_NOT_USED(options_p)
+
+        a_p = param_value_p;
+
+    return pack_hex_array(buf, buflen, a_p->len, a_p->arr_p, 1);
+}
+
+
+/**
+ * mpl_unpack_param_value_uint8_array()
+ **/
+int
+    mpl_unpack_param_value_uint8_array(const char* value_str, void **value_pp,
+                                       const mpl_param_descr2_t *descr_p,
+                                       const mpl_pack_options_t *options_p,
+                                       mpl_param_element_id_t unpack_context)
+{
+    unsigned int len;
+    mpl_uint8_array_t *a_p;
+    const int *max_p = descr_p->max_p;
+    const int *min_p = descr_p->min_p;
+
+    MPL_IDENTIFIER_NOT_USED(options_p);
+    MPL_IDENTIFIER_NOT_USED(unpack_context);
+
+    a_p = malloc(sizeof(mpl_uint8_array_t));
+    if (NULL == a_p)
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
                             ("Failed allocating memory\n"));
         set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        free(st_p);
-        if (temp_string_allocated)
-            free(temp_str);
         return (-1);
     }
-    strncpy(st_p->key_p, temp_str, slen);
-    st_p->key_p[slen] = 0;
 
-    p++;
-    slen = strlen(p);
+    if (sscanf(value_str, "%8x", &len) <= 0)
+    {
+        free(a_p);
+        return (-1);
+    }
 
     if ((max_p != NULL) &&
-        ((int)slen > *max_p))
+        ((int)len > *max_p))
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack string_tuple value failed on "
-                             "max length check: %zu > %d\n",
-                             slen,
-                             *max_p));/*lint !e557 %zu is C99 */
+                            ("Unpack uint8_array failed on max length check: %d > %d\n",
+                             len, *max_p));
         set_errno(E_MPL_FAILED_OPERATION);
-        free(st_p->key_p);
-        free(st_p);
-        if (temp_string_allocated)
-            free(temp_str);
+        free(a_p);
         return (-1);
     }
 
     if ((min_p != NULL) &&
-        ((int)slen < *min_p))
+        ((int)len < *min_p))
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack string_tuple value failed on "
-                             "min length check: %zu < %d\n",
-                             slen,
-                             *min_p));/*lint !e557 %zu is C99 */
+                            ("Unpack uint8_array failed on min length check: %d < %d\n",
+                             len, *min_p));
         set_errno(E_MPL_FAILED_OPERATION);
-        free(st_p->key_p);
-        free(st_p);
-        if (temp_string_allocated)
-            free(temp_str);
+        free(a_p);
         return (-1);
     }
 
-    st_p->value_p = malloc(slen + 1);
-    if (NULL == st_p->value_p)
+    /* All the digits must be there before anything is allocated */
+    if (!unpack_hex_array_complete(value_str, len, 1))
+    {
+        free(a_p);
+        return (-1);
+    }
+
+    a_p->arr_p = malloc(len * sizeof(uint8_t));
+
+    if (NULL == a_p->arr_p)
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
                             ("Failed allocating memory\n"));
         set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        free(st_p->key_p);
-        free(st_p);
-        if (temp_string_allocated)
-            free(temp_str);
+        free(a_p);
         return (-1);
     }
 
-    strncpy(st_p->value_p, p, slen);
-    st_p->value_p[slen] = 0;
-    *value_pp = st_p;
+    if (mpl_hex_decode_uint8(value_str + 8, len, a_p->arr_p) < 0)
+    {
+        free(a_p->arr_p);
+        free(a_p);
+        return -1;
+    }
 
-    if (temp_string_allocated)
-        free(temp_str);
+    a_p->len = len;
+
+    assert(NULL != value_pp);
+    *value_pp = a_p;
 
     return (0);
 }
 
 /**
- * mpl_clone_param_value_string_tuple()
+ * mpl_clone_param_value_uint8_array()
  **/
 int
-    mpl_clone_param_value_string_tuple(void **new_value_pp,
-                                       const void* old_value_p,
-                                       const mpl_param_descr2_t *descr_p)
+    mpl_clone_param_value_uint8_array(void **new_value_pp,
+                                      const void* old_value_p,
+                                      const mpl_param_descr2_t *descr_p)
 {
-    mpl_string_tuple_t *st_p;
-    const mpl_string_tuple_t *old_st_p;
-    MPL_IDENTIFIER_NOT_USED(descr_p);
+    mpl_uint8_array_t *a_p;
+    const mpl_uint8_array_t *old_a_p;
 
-    st_p = malloc(sizeof(mpl_string_tuple_t));
-    if (NULL == st_p)
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    a_p = malloc(sizeof(mpl_uint8_array_t));
+    if (NULL == a_p)
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
                             ("Failed allocating memory\n"));
@@ -6629,286 +7987,223 @@ int
         return (-1);
     }
 
-    old_st_p = old_value_p;
+    old_a_p = old_value_p;
 
-    st_p->key_p = malloc(strlen(old_st_p->key_p) + 1);
-    if (NULL == st_p->key_p)
+    a_p->arr_p = malloc(old_a_p->len * sizeof(uint8_t));
+    if (NULL == a_p->arr_p)
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
                             ("Failed allocating memory\n"));
         set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        free(st_p);
+        free(a_p);
         return (-1);
     }
 
-    st_p->value_p = malloc(strlen(old_st_p->value_p) + 1);
-    if (NULL == st_p->value_p)
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        free(st_p->key_p);
-        free(st_p);
-        return (-1);
-    }
+    a_p->len = old_a_p->len;
+    memcpy(a_p->arr_p, old_a_p->arr_p, a_p->len * sizeof(uint8_t));
 
-    strcpy(st_p->key_p, old_st_p->key_p);
-    strcpy(st_p->value_p, old_st_p->value_p);
-
-    *new_value_pp = st_p;
+    *new_value_pp = a_p;
 
     return (0);
 }
 
 /**
- * mpl_copy_param_value_string_tuple()
+ * mpl_copy_param_value_uint8_array()
  **/
-/* NOTE: Copy on a tuple means copy of the value part of the tuple */
 int
-    mpl_copy_param_value_string_tuple(void *to_value_p,
-                                      const void* from_value_p,
-                                      int size,
-                                      const mpl_param_descr2_t *descr_p)
+    mpl_copy_param_value_uint8_array(void *to_value_p,
+                                     const void* from_value_p,
+                                     int size,
+                                     const mpl_param_descr2_t *descr_p)
 {
-    const mpl_string_tuple_t *tuple_p = from_value_p;
-    int real_size = strlen(tuple_p->value_p) + 1;
+    const mpl_uint8_array_t *arr_p = from_value_p;
+    int real_size = arr_p->len;
     MPL_IDENTIFIER_NOT_USED(descr_p);
 
-    if (real_size <= size)
-        strncpy(to_value_p, tuple_p->value_p, real_size);
+    if (real_size <= size )
+        memcpy(to_value_p, arr_p->arr_p, real_size);
 
     return real_size;
 }
 
 /**
- * mpl_compare_param_value_string_tuple()
+ * mpl_compare_param_value_uint8_array()
  **/
-int mpl_compare_param_value_string_tuple(const void *value1_p,
-                                         const void* value2_p,
-                                         const mpl_param_descr2_t *descr_p)
+int mpl_compare_param_value_uint8_array(const void *value1_p,
+                                        const void* value2_p,
+                                        const mpl_param_descr2_t *descr_p)
 {
-    const mpl_string_tuple_t *st1_p;
-    const mpl_string_tuple_t *st2_p;
+    const mpl_uint8_array_t *a1_p;
+    const mpl_uint8_array_t *a2_p;
     MPL_IDENTIFIER_NOT_USED(descr_p);
 
-    st1_p = value1_p;
-    st2_p = value2_p;
-
-    if ((NULL == st1_p->key_p) || (NULL == st2_p->key_p))
-    {
-        if (st1_p->key_p != st2_p->key_p)
-            return -1;
-    }
-    else if (strcmp(st1_p->key_p, st2_p->key_p))
-        return -1;
+    a1_p = value1_p;
+    a2_p = value2_p;
 
-    if ((NULL == st1_p->value_p) || (NULL == st2_p->value_p))
-    {
-        if (st1_p->value_p != st2_p->value_p)
-            return -1;
-    }
-    else if (strcmp(st1_p->value_p, st2_p->value_p))
+    if (a1_p->len != a2_p->len)
         return -1;
 
-    return 0;
+    return memcmp(a1_p->arr_p, a2_p->arr_p, a1_p->len * sizeof(uint8_t));
 }
 
 /**
- * mpl_sizeof_param_value_string_tuple()
+ * mpl_sizeof_param_value_uint8_array()
  **/
-size_t mpl_sizeof_param_value_string_tuple(const mpl_param_descr2_t *descr_p)
+size_t mpl_sizeof_param_value_uint8_array(const mpl_param_descr2_t *descr_p)
 {
     MPL_IDENTIFIER_NOT_USED(descr_p);
     return 0;
 }
 
 /**
- * mpl_free_param_value_string_tuple()
+ * mpl_free_param_value()
  **/
-void mpl_free_param_value_string_tuple(void *value_p)
+void mpl_free_param_value(void *value_p)
 {
-    mpl_string_tuple_t *st_p;
+    free(value_p);
+}
 
-    st_p = value_p;
-    if (NULL != st_p)
+/**
+ * mpl_free_param_value_uint8_array()
+ **/
+void mpl_free_param_value_uint8_array(void *value_p)
+{
+    mpl_uint8_array_t *a_p;
+
+    a_p = value_p;
+    if (NULL != a_p)
     {
-        if (NULL != st_p->key_p)
-        {
-            free(st_p->key_p);
-        }
-        if (NULL != st_p->value_p)
+        if (NULL != a_p->arr_p)
         {
-            free(st_p->value_p);
+            free(a_p->arr_p);
         }
-        free(st_p);
+        free(a_p);
     }
 }
 
 
-
 /**
- * mpl_pack_param_value_int_tuple()
+ * mpl_pack_param_value_uint16_array()
  **/
-int mpl_pack_param_value_int_tuple(const void* param_value_p,
-                                   char *buf,
-                                   size_t buflen,
-                                   const mpl_param_descr2_t *descr_p,
-                                   const mpl_pack_options_t *options_p)
+int mpl_pack_param_value_uint16_array(const void* param_value_p,
+                                      char *buf,
+                                      size_t buflen,
+                                      const mpl_param_descr2_t *descr_p,
+                                      const mpl_pack_options_t *options_p)
 {
-    const mpl_int_tuple_t *it_p;
-    MPL_IDENTIFIER_NOT_USED(descr_p);
+    const mpl_uint16_array_t *a_p;
 
     assert(NULL != param_value_p);
+    MPL_IDENTIFIER_NOT_USED(descr_p);
     MPL_IDENTIFIER_NOT_USED(options_p)
 
-        it_p = param_value_p;
+        a_p = param_value_p;
 
-    return snprintf(buf, buflen, "=%d:%d", it_p->key, it_p->value);
+    return pack_hex_array(buf, buflen, a_p->len, a_p->arr_p, 2);
 }
 
 
 /**
- * mpl_unpack_param_value_int_tuple()
+ * mpl_unpack_param_value_uint16_array()
  **/
 int
-    mpl_unpack_param_value_int_tuple(const char* value_str, void **value_pp,
-                                     const mpl_param_descr2_t *descr_p,
-                                     const mpl_pack_options_t *options_p,
-                                     mpl_param_element_id_t unpack_context)
+    mpl_unpack_param_value_uint16_array(const char* value_str, void **value_pp,
+                                        const mpl_param_descr2_t *descr_p,
+                                        const mpl_pack_options_t *options_p,
+                                        mpl_param_element_id_t unpack_context)
 {
-    mpl_int_tuple_t *it_p;
-    char* p;
-    char *tmp_buf_p;
+    unsigned int len;
+    mpl_uint16_array_t *a_p;
     const int *max_p = descr_p->max_p;
     const int *min_p = descr_p->min_p;
 
     MPL_IDENTIFIER_NOT_USED(options_p);
     MPL_IDENTIFIER_NOT_USED(unpack_context);
 
-    tmp_buf_p = malloc(strlen(value_str) + 1);
-    if (NULL == tmp_buf_p)
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        return -1;
-    }
-    strcpy(tmp_buf_p, value_str);
-
-    p = strchr(tmp_buf_p, ':');
-    if (NULL == p)
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack int_tuple failed, no delimiter: %s\n",
-                             value_str));
-        set_errno(E_MPL_FAILED_OPERATION);
-        free(tmp_buf_p);
-        return (-1);
-    }
-
-    *p = '\0';
-
-    it_p = malloc(sizeof(mpl_int_tuple_t));
-    if (NULL == it_p)
+    a_p = malloc(sizeof(mpl_uint16_array_t));
+    if (NULL == a_p)
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
                             ("Failed allocating memory\n"));
         set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        free(tmp_buf_p);
         return (-1);
     }
 
-    if (convert_int(tmp_buf_p, &it_p->key) < 0)
+    if (sscanf(value_str, "%8x", &len) <= 0)
     {
-        free(it_p);
-        free(tmp_buf_p);
+        free(a_p);
         return (-1);
     }
 
     if ((max_p != NULL) &&
-        (it_p->key > *max_p))
+        ((int)len > *max_p))
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack int_tuple key failed on "
-                             "max check: %d > %d\n",
-                             it_p->key,
-                             *max_p));
+                            ("Unpack uint16_array failed on "
+                             "max length check: %d > %d\n", len, *max_p));
         set_errno(E_MPL_FAILED_OPERATION);
-        free(it_p);
-        free(tmp_buf_p);
+        free(a_p);
         return (-1);
     }
 
     if ((min_p != NULL) &&
-        (it_p->key < *min_p))
+        ((int)len < *min_p))
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack int_tuple key failed on "
-                             "min check: %d < %d\n",
-                             it_p->key,
-                             *min_p));
+                            ("Unpack uint16_array failed on "
+                             "min length check: %d < %d\n", len, *min_p));
         set_errno(E_MPL_FAILED_OPERATION);
-        free(it_p);
-        free(tmp_buf_p);
+        free(a_p);
         return (-1);
     }
 
-    p++;
-
-    if (convert_int(p, &it_p->value) < 0)
+    /* All the digits must be there before anything is allocated */
+    if (!unpack_hex_array_complete(value_str, len, 2))
     {
-        free(it_p);
-        free(tmp_buf_p);
+        free(a_p);
         return (-1);
     }
 
-    if ((max_p != NULL) &&
-        (it_p->value > *max_p))
+    a_p->arr_p = malloc(len * sizeof(uint16_t));
+
+    if (NULL == a_p->arr_p)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack int_tuple value failed on "
-                             "max check: %d > %d\n",
-                             it_p->value,
-                             *max_p));
-        set_errno(E_MPL_FAILED_OPERATION);
-        free(it_p);
-        free(tmp_buf_p);
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        free(a_p);
         return (-1);
     }
 
-    if ((min_p != NULL) &&
-        (it_p->value < *min_p))
+    if (mpl_hex_decode_uint16(value_str + 8, len, a_p->arr_p) < 0)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack int_tuple value failed on "
-                             "min check: %d < %d\n",
-                             it_p->value,
-                             *min_p));
-        set_errno(E_MPL_FAILED_OPERATION);
-        free(it_p);
-        free(tmp_buf_p);
-        return (-1);
+        free(a_p->arr_p);
+        free(a_p);
+        return -1;
     }
 
-    *value_pp = it_p;
+    a_p->len = len;
+
+    assert(NULL != value_pp);
+    *value_pp = a_p;
 
-    free(tmp_buf_p);
     return (0);
 }
 
 /**
- * mpl_clone_param_value_int_tuple()
+ * mpl_clone_param_value_uint16_array()
  **/
 int
-    mpl_clone_param_value_int_tuple(void **new_value_pp,
-                                    const void* old_value_p,
-                                    const mpl_param_descr2_t *descr_p)
+    mpl_clone_param_value_uint16_array(void **new_value_pp,
+                                       const void* old_value_p,
+                                       const mpl_param_descr2_t *descr_p)
 {
-    mpl_int_tuple_t *it_p;
+    mpl_uint16_array_t *a_p;
+    const mpl_uint16_array_t *old_a_p;
     MPL_IDENTIFIER_NOT_USED(descr_p);
 
-    it_p = malloc(sizeof(mpl_int_tuple_t));
-    if (NULL == it_p)
+    a_p = malloc(sizeof(mpl_uint16_array_t));
+    if (NULL == a_p)
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
                             ("Failed allocating memory\n"));
@@ -6916,2404 +8211,7179 @@ int
         return (-1);
     }
 
-    *it_p = *(mpl_int_tuple_t*)old_value_p;
-    *new_value_pp = it_p;
+    old_a_p = old_value_p;
+
+    a_p->arr_p = malloc(old_a_p->len * sizeof(uint16_t));
+    if (NULL == a_p->arr_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        free(a_p);
+        return (-1);
+    }
+
+    a_p->len = old_a_p->len;
+    memcpy(a_p->arr_p, old_a_p->arr_p, a_p->len * sizeof(uint16_t));
+
+    *new_value_pp = a_p;
+
+    return (0);
+}
+
+/**
+ * mpl_copy_param_value_uint16_array()
+ **/
+int
+    mpl_copy_param_value_uint16_array(void *to_value_p,
+                                      const void* from_value_p,
+                                      int size,
+                                      const mpl_param_descr2_t *descr_p)
+{
+    const mpl_uint16_array_t *arr_p = from_value_p;
+    int real_size = arr_p->len * sizeof(uint16_t);
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+
+    if (real_size <= size )
+        memcpy(to_value_p, arr_p->arr_p, real_size);
+
+    return real_size;
+}
+
+/**
+ * mpl_compare_param_value_uint16_array()
+ **/
+int mpl_compare_param_value_uint16_array(const void *value1_p,
+                                         const void* value2_p,
+                                         const mpl_param_descr2_t *descr_p)
+{
+    const mpl_uint16_array_t *a1_p;
+    const mpl_uint16_array_t *a2_p;
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+
+    a1_p = value1_p;
+    a2_p = value2_p;
+
+    if (a1_p->len != a2_p->len)
+        return -1;
+
+    return memcmp(a1_p->arr_p, a2_p->arr_p, a1_p->len * sizeof(uint16_t));
+}
+
+/**
+ * mpl_sizeof_param_value_uint16_array()
+ **/
+size_t mpl_sizeof_param_value_uint16_array(const mpl_param_descr2_t *descr_p)
+{
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    return 0;
+}
+
+/**
+ * mpl_free_param_value_uint16_array()
+ **/
+void mpl_free_param_value_uint16_array(void *value_p)
+{
+    mpl_uint16_array_t *a_p;
+
+    a_p = value_p;
+    if (NULL != a_p)
+    {
+        if (NULL != a_p->arr_p)
+        {
+            free(a_p->arr_p);
+        }
+        free(a_p);
+    }
+}
+
+
+/**
+ * mpl_pack_param_value_uint32_array()
+ **/
+int mpl_pack_param_value_uint32_array(const void* param_value_p,
+                                      char *buf,
+                                      size_t buflen,
+                                      const mpl_param_descr2_t *descr_p,
+                                      const mpl_pack_options_t *options_p)
+{
+    const mpl_uint32_array_t *a_p;
+
+    assert(NULL != param_value_p);
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    MPL_IDENTIFIER_NOT_USED(options_p)
+
+        a_p = param_value_p;
+
+    return pack_hex_array(buf, buflen, a_p->len, a_p->arr_p, 4);
+}
+
+
+/**
+ * mpl_unpack_param_value_uint32_array()
+ **/
+int
+    mpl_unpack_param_value_uint32_array(const char* value_str,
+                                        void **value_pp,
+                                        const mpl_param_descr2_t *descr_p,
+                                        const mpl_pack_options_t *options_p,
+                                        mpl_param_element_id_t unpack_context)
+{
+    unsigned int len;
+    mpl_uint32_array_t *a_p;
+    const int *max_p = descr_p->max_p;
+    const int *min_p = descr_p->min_p;
+
+    MPL_IDENTIFIER_NOT_USED(options_p);
+    MPL_IDENTIFIER_NOT_USED(unpack_context);
+
+    a_p = malloc(sizeof(mpl_uint32_array_t));
+    if (NULL == a_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return (-1);
+    }
+
+    if (sscanf(value_str, "%8x", &len) <= 0)
+    {
+        free(a_p);
+        return (-1);
+    }
+
+    if ((max_p != NULL) &&
+        ((int)len > *max_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack uint32_array failed on "
+                             "max length check: %d > %d\n", len, *max_p));
+        set_errno(E_MPL_FAILED_OPERATION);
+        free(a_p);
+        return (-1);
+    }
+
+    if ((min_p != NULL) &&
+        ((int)len < *min_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack uint32_array failed on "
+                             "min length check: %d < %d\n", len, *min_p));
+        set_errno(E_MPL_FAILED_OPERATION);
+        free(a_p);
+        return (-1);
+    }
+
+    /* All the digits must be there before anything is allocated */
+    if (!unpack_hex_array_complete(value_str, len, 4))
+    {
+        free(a_p);
+        return (-1);
+    }
+
+    a_p->arr_p = malloc(len * sizeof(uint32_t));
+
+    if (NULL == a_p->arr_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        free(a_p);
+        return (-1);
+    }
+
+    if (mpl_hex_decode_uint32(value_str + 8, len, a_p->arr_p) < 0)
+    {
+        free(a_p->arr_p);
+        free(a_p);
+        return -1;
+    }
+
+    a_p->len = len;
+
+    assert(NULL != value_pp);
+    *value_pp = a_p;
+
+    return (0);
+}
+
+/**
+ * mpl_clone_param_value_uint32_array()
+ **/
+int
+    mpl_clone_param_value_uint32_array(void **new_value_pp,
+                                       const void* old_value_p,
+                                       const mpl_param_descr2_t *descr_p)
+{
+    mpl_uint32_array_t *a_p;
+    const mpl_uint32_array_t *old_a_p;
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+
+    a_p = malloc(sizeof(mpl_uint32_array_t));
+    if (NULL == a_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return (-1);
+    }
+
+    old_a_p = old_value_p;
+
+    a_p->arr_p = malloc(old_a_p->len * sizeof(uint32_t));
+    if (NULL == a_p->arr_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        free(a_p);
+        return (-1);
+    }
+
+    a_p->len = old_a_p->len;
+    memcpy(a_p->arr_p, old_a_p->arr_p, a_p->len * sizeof(uint32_t));
+
+    *new_value_pp = a_p;
+
+    return (0);
+}
+
+/**
+ * mpl_copy_param_value_uint32_array()
+ **/
+int
+    mpl_copy_param_value_uint32_array(void *to_value_p,
+                                      const void* from_value_p,
+                                      int size,
+                                      const mpl_param_descr2_t *descr_p)
+{
+    const mpl_uint32_array_t *arr_p = from_value_p;
+    int real_size = arr_p->len * sizeof(uint32_t);
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+
+    if (real_size <= size )
+        memcpy(to_value_p, arr_p->arr_p, real_size);
+
+    return real_size;
+}
+
+/**
+ * mpl_compare_param_value_uint32_array()
+ **/
+int mpl_compare_param_value_uint32_array(const void *value1_p,
+                                         const void* value2_p,
+                                         const mpl_param_descr2_t *descr_p)
+{
+    const mpl_uint32_array_t *a1_p;
+    const mpl_uint32_array_t *a2_p;
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+
+    a1_p = value1_p;
+    a2_p = value2_p;
+
+    if (a1_p->len != a2_p->len)
+        return -1;
+
+    return memcmp(a1_p->arr_p, a2_p->arr_p, a1_p->len * sizeof(uint32_t));
+}
+
+/**
+ * mpl_sizeof_param_value_uint32_array()
+ **/
+size_t mpl_sizeof_param_value_uint32_array(const mpl_param_descr2_t *descr_p)
+{
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    return 0;
+}
+
+/**
+ * mpl_free_param_value_uint32_array()
+ **/
+void mpl_free_param_value_uint32_array(void *value_p)
+{
+    mpl_uint32_array_t *a_p;
+
+    a_p = value_p;
+    if (NULL != a_p)
+    {
+        if (NULL != a_p->arr_p)
+        {
+            free(a_p->arr_p);
+        }
+        free(a_p);
+    }
+}
+
+
+/**
+ * mpl_pack_param_value_string_tuple()
+ **/
+int mpl_pack_param_value_string_tuple(const void* param_value_p,
+                                      char *buf,
+                                      size_t buflen,
+                                      const mpl_param_descr2_t *descr_p,
+                                      const mpl_pack_options_t *options_p)
+{
+    const mpl_string_tuple_t *st_p;
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+
+    assert(NULL != param_value_p);
+
+    st_p = param_value_p;
+    assert(NULL != st_p->key_p);
+
+    if (NULL != st_p->value_p)
+        return snprintf_escape(options_p->message_delimiter, '\\',
+                               buf, buflen, "=%s:%s", st_p->key_p, st_p->value_p);
+    else
+        return snprintf_escape(options_p->message_delimiter, '\\',
+                               buf, buflen, "=%s:", st_p->key_p);
+}
+
+
+/**
+ * mpl_unpack_param_value_string_tuple()
+ **/
+int
+    mpl_unpack_param_value_string_tuple(const char* value_str, void **value_pp,
+                                        const mpl_param_descr2_t *descr_p,
+                                        const mpl_pack_options_t *options_p,
+                                        mpl_param_element_id_t unpack_context)
+{
+    mpl_string_tuple_t *st_p;
+    char* p;
+    size_t slen;
+    char *temp_str;
+    int temp_string_allocated = 0;
+    const int *max_p = descr_p->max_p;
+    const int *min_p = descr_p->min_p;
+    MPL_IDENTIFIER_NOT_USED(unpack_context);
+
+    if (strchr(value_str, '\\')) {
+        temp_str = remove_escape(value_str, '\\');
+        if (temp_str == NULL) {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                                ("Failed allocating memory\n"));
+            set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+            return (-1);
+        }
+        temp_string_allocated = 1;
+    }
+    else {
+        temp_str = (char*) value_str;
+    }
+
+    p = strchr(temp_str, ':');
+    if (NULL == p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack string_tuple failed, no delimiter: %s\n",
+                             temp_str));
+        set_errno(E_MPL_FAILED_OPERATION);
+        if (temp_string_allocated)
+            free(temp_str);
+        return (-1);
+    }
+
+    st_p = malloc(sizeof(mpl_string_tuple_t));
+    if (NULL == st_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        if (temp_string_allocated)
+            free(temp_str);
+        return (-1);
+    }
+
+    slen = p - temp_str;
+
+    if ((max_p != NULL) &&
+        ((int)slen > *max_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack string_tuple key failed on "
+                             "max length check: %zu > %d\n",
+                             slen,
+                             *max_p));/*lint !e557 %zu is C99 */
+        set_errno(E_MPL_FAILED_OPERATION);
+        free(st_p);
+        if (temp_string_allocated)
+            free(temp_str);
+        return (-1);
+    }
+
+    if ((min_p != NULL) &&
+        ((int)slen < *min_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack string_tuple key failed on "
+                             "min length check: %zu < %d\n",
+                             slen,
+                             *min_p));/*lint !e557 %zu is C99 */
+        set_errno(E_MPL_FAILED_OPERATION);
+        free(st_p);
+        if (temp_string_allocated)
+            free(temp_str);
+        return (-1);
+    }
+
+    st_p->key_p = malloc(slen + 1);
+    if (NULL == st_p->key_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        free(st_p);
+        if (temp_string_allocated)
+            free(temp_str);
+        return (-1);
+    }
+    strncpy(st_p->key_p, temp_str, slen);
+    st_p->key_p[slen] = 0;
+
+    p++;
+    slen = strlen(p);
+
+    if ((max_p != NULL) &&
+        ((int)slen > *max_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack string_tuple value failed on "
+                             "max length check: %zu > %d\n",
+                             slen,
+                             *max_p));/*lint !e557 %zu is C99 */
+        set_errno(E_MPL_FAILED_OPERATION);
+        free(st_p->key_p);
+        free(st_p);
+        if (temp_string_allocated)
+            free(temp_str);
+        return (-1);
+    }
+
+    if ((min_p != NULL) &&
+        ((int)slen < *min_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack string_tuple value failed on "
+                             "min length check: %zu < %d\n",
+                             slen,
+                             *min_p));/*lint !e557 %zu is C99 */
+        set_errno(E_MPL_FAILED_OPERATION);
+        free(st_p->key_p);
+        free(st_p);
+        if (temp_string_allocated)
+            free(temp_str);
+        return (-1);
+    }
+
+    st_p->value_p = malloc(slen + 1);
+    if (NULL == st_p->value_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        free(st_p->key_p);
+        free(st_p);
+        if (temp_string_allocated)
+            free(temp_str);
+        return (-1);
+    }
+
+    strncpy(st_p->value_p, p, slen);
+    st_p->value_p[slen] = 0;
+    *value_pp = st_p;
+
+    if (temp_string_allocated)
+        free(temp_str);
+
+    return (0);
+}
+
+/**
+ * mpl_clone_param_value_string_tuple()
+ **/
+int
+    mpl_clone_param_value_string_tuple(void **new_value_pp,
+                                       const void* old_value_p,
+                                       const mpl_param_descr2_t *descr_p)
+{
+    mpl_string_tuple_t *st_p;
+    const mpl_string_tuple_t *old_st_p;
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+
+    st_p = malloc(sizeof(mpl_string_tuple_t));
+    if (NULL == st_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return (-1);
+    }
+
+    old_st_p = old_value_p;
+
+    st_p->key_p = malloc(strlen(old_st_p->key_p) + 1);
+    if (NULL == st_p->key_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        free(st_p);
+        return (-1);
+    }
+
+    st_p->value_p = malloc(strlen(old_st_p->value_p) + 1);
+    if (NULL == st_p->value_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        free(st_p->key_p);
+        free(st_p);
+        return (-1);
+    }
+
+    strcpy(st_p->key_p, old_st_p->key_p);
+    strcpy(st_p->value_p, old_st_p->value_p);
+
+    *new_value_pp = st_p;
+
+    return (0);
+}
+
+/**
+ * mpl_copy_param_value_string_tuple()
+ **/
+/* NOTE: Copy on a tuple means copy of the value part of the tuple */
+int
+    mpl_copy_param_value_string_tuple(void *to_value_p,
+                                      const void* from_value_p,
+                                      int size,
+                                      const mpl_param_descr2_t *descr_p)
+{
+    const mpl_string_tuple_t *tuple_p = from_value_p;
+    int real_size = strlen(tuple_p->value_p) + 1;
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+
+    if (real_size <= size)
+        strncpy(to_value_p, tuple_p->value_p, real_size);
+
+    return real_size;
+}
+
+/**
+ * mpl_compare_param_value_string_tuple()
+ **/
+int mpl_compare_param_value_string_tuple(const void *value1_p,
+                                         const void* value2_p,
+                                         const mpl_param_descr2_t *descr_p)
+{
+    const mpl_string_tuple_t *st1_p;
+    const mpl_string_tuple_t *st2_p;
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+
+    st1_p = value1_p;
+    st2_p = value2_p;
+
+    if ((NULL == st1_p->key_p) || (NULL == st2_p->key_p))
+    {
+        if (st1_p->key_p != st2_p->key_p)
+            return -1;
+    }
+    else if (strcmp(st1_p->key_p, st2_p->key_p))
+        return -1;
+
+    if ((NULL == st1_p->value_p) || (NULL == st2_p->value_p))
+    {
+        if (st1_p->value_p != st2_p->value_p)
+            return -1;
+    }
+    else if (strcmp(st1_p->value_p, st2_p->value_p))
+        return -1;
+
+    return 0;
+}
+
+/**
+ * mpl_sizeof_param_value_string_tuple()
+ **/
+size_t mpl_sizeof_param_value_string_tuple(const mpl_param_descr2_t *descr_p)
+{
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    return 0;
+}
+
+/**
+ * mpl_free_param_value_string_tuple()
+ **/
+void mpl_free_param_value_string_tuple(void *value_p)
+{
+    mpl_string_tuple_t *st_p;
+
+    st_p = value_p;
+    if (NULL != st_p)
+    {
+        if (NULL != st_p->key_p)
+        {
+            free(st_p->key_p);
+        }
+        if (NULL != st_p->value_p)
+        {
+            free(st_p->value_p);
+        }
+        free(st_p);
+    }
+}
+
+
+
+/**
+ * mpl_pack_param_value_int_tuple()
+ **/
+int mpl_pack_param_value_int_tuple(const void* param_value_p,
+                                   char *buf,
+                                   size_t buflen,
+                                   const mpl_param_descr2_t *descr_p,
+                                   const mpl_pack_options_t *options_p)
+{
+    const mpl_int_tuple_t *it_p;
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+
+    assert(NULL != param_value_p);
+    MPL_IDENTIFIER_NOT_USED(options_p)
+
+        it_p = param_value_p;
+
+    return snprintf(buf, buflen, "=%d:%d", it_p->key, it_p->value);
+}
+
+
+/**
+ * mpl_unpack_param_value_int_tuple()
+ **/
+int
+    mpl_unpack_param_value_int_tuple(const char* value_str, void **value_pp,
+                                     const mpl_param_descr2_t *descr_p,
+                                     const mpl_pack_options_t *options_p,
+                                     mpl_param_element_id_t unpack_context)
+{
+    mpl_int_tuple_t *it_p;
+    char* p;
+    char *tmp_buf_p;
+    const int *max_p = descr_p->max_p;
+    const int *min_p = descr_p->min_p;
+
+    MPL_IDENTIFIER_NOT_USED(options_p);
+    MPL_IDENTIFIER_NOT_USED(unpack_context);
+
+    tmp_buf_p = malloc(strlen(value_str) + 1);
+    if (NULL == tmp_buf_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return -1;
+    }
+    strcpy(tmp_buf_p, value_str);
+
+    p = strchr(tmp_buf_p, ':');
+    if (NULL == p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack int_tuple failed, no delimiter: %s\n",
+                             value_str));
+        set_errno(E_MPL_FAILED_OPERATION);
+        free(tmp_buf_p);
+        return (-1);
+    }
+
+    *p = '\0';
+
+    it_p = malloc(sizeof(mpl_int_tuple_t));
+    if (NULL == it_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        free(tmp_buf_p);
+        return (-1);
+    }
+
+    if (convert_int(tmp_buf_p, &it_p->key) < 0)
+    {
+        free(it_p);
+        free(tmp_buf_p);
+        return (-1);
+    }
+
+    if ((max_p != NULL) &&
+        (it_p->key > *max_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack int_tuple key failed on "
+                             "max check: %d > %d\n",
+                             it_p->key,
+                             *max_p));
+        set_errno(E_MPL_FAILED_OPERATION);
+        free(it_p);
+        free(tmp_buf_p);
+        return (-1);
+    }
+
+    if ((min_p != NULL) &&
+        (it_p->key < *min_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack int_tuple key failed on "
+                             "min check: %d < %d\n",
+                             it_p->key,
+                             *min_p));
+        set_errno(E_MPL_FAILED_OPERATION);
+        free(it_p);
+        free(tmp_buf_p);
+        return (-1);
+    }
+
+    p++;
+
+    if (convert_int(p, &it_p->value) < 0)
+    {
+        free(it_p);
+        free(tmp_buf_p);
+        return (-1);
+    }
+
+    if ((max_p != NULL) &&
+        (it_p->value > *max_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack int_tuple value failed on "
+                             "max check: %d > %d\n",
+                             it_p->value,
+                             *max_p));
+        set_errno(E_MPL_FAILED_OPERATION);
+        free(it_p);
+        free(tmp_buf_p);
+        return (-1);
+    }
+
+    if ((min_p != NULL) &&
+        (it_p->value < *min_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack int_tuple value failed on "
+                             "min check: %d < %d\n",
+                             it_p->value,
+                             *min_p));
+        set_errno(E_MPL_FAILED_OPERATION);
+        free(it_p);
+        free(tmp_buf_p);
+        return (-1);
+    }
+
+    *value_pp = it_p;
+
+    free(tmp_buf_p);
+    return (0);
+}
+
+/**
+ * mpl_clone_param_value_int_tuple()
+ **/
+int
+    mpl_clone_param_value_int_tuple(void **new_value_pp,
+                                    const void* old_value_p,
+                                    const mpl_param_descr2_t *descr_p)
+{
+    mpl_int_tuple_t *it_p;
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+
+    it_p = malloc(sizeof(mpl_int_tuple_t));
+    if (NULL == it_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return (-1);
+    }
+
+    *it_p = *(mpl_int_tuple_t*)old_value_p;
+    *new_value_pp = it_p;
+
+    return (0);
+}
+
+/**
+ * mpl_copy_param_value_int_tuple()
+ **/
+/* NOTE: Copy on a tuple means copy of the value part of the tuple */
+int
+    mpl_copy_param_value_int_tuple(void *to_value_p,
+                                   const void* from_value_p,
+                                   int size,
+                                   const mpl_param_descr2_t *descr_p)
+{
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    if (size >= (int)sizeof(int))
+        *(int*)to_value_p = ((mpl_int_tuple_t*)from_value_p)->value;
+
+    return sizeof(int);
+}
+
+/**
+ * mpl_compare_param_value_int_tuple()
+ **/
+int mpl_compare_param_value_int_tuple(const void *value1_p,
+                                      const void* value2_p,
+                                      const mpl_param_descr2_t *descr_p)
+{
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    return (memcmp(value1_p, value2_p, sizeof(mpl_int_tuple_t)) != 0);
+}
+
+/**
+ * mpl_sizeof_param_value_int_tuple()
+ **/
+size_t mpl_sizeof_param_value_int_tuple(const mpl_param_descr2_t *descr_p)
+{
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    return sizeof(mpl_int_tuple_t);
+}
+
+
+/**
+ * mpl_pack_param_value_strint_tuple()
+ **/
+int mpl_pack_param_value_strint_tuple(const void* param_value_p,
+                                      char *buf,
+                                      size_t buflen,
+                                      const mpl_param_descr2_t *descr_p,
+                                      const mpl_pack_options_t *options_p)
+{
+    const mpl_strint_tuple_t *t_p;
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+
+    assert(NULL != param_value_p);
+
+    t_p = param_value_p;
+    assert(NULL != t_p->key_p);
+
+    return snprintf_escape(options_p->message_delimiter, '\\',
+                           buf, buflen, "=%s:%d", t_p->key_p, t_p->value);
+}
+
+
+/**
+ * mpl_unpack_param_value_strint_tuple()
+ **/
+int
+    mpl_unpack_param_value_strint_tuple(const char* value_str, void **value_pp,
+                                        const mpl_param_descr2_t *descr_p,
+                                        const mpl_pack_options_t *options_p,
+                                        mpl_param_element_id_t unpack_context)
+{
+    mpl_strint_tuple_t *t_p;
+    char* p;
+    int slen;
+    char *temp_str;
+    int temp_string_allocated = 0;
+    const int *max_p = descr_p->max_p;
+    const int *min_p = descr_p->min_p;
+    MPL_IDENTIFIER_NOT_USED(unpack_context);
+
+    if (strchr(value_str, '\\')) {
+        temp_str = remove_escape(value_str, '\\');
+        if (temp_str == NULL) {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                                ("Failed allocating memory\n"));
+            set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+            return (-1);
+        }
+        temp_string_allocated = 1;
+    }
+    else {
+        temp_str = (char*) value_str;
+    }
+
+    p = strchr(temp_str, ':');
+    if (NULL == p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack strint_tuple failed, no delimiter: %s\n",
+                             temp_str));
+        set_errno(E_MPL_FAILED_OPERATION);
+        if (temp_string_allocated)
+            free(temp_str);
+        return (-1);
+    }
+
+    t_p = malloc(sizeof(mpl_strint_tuple_t));
+    if (NULL == t_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        if (temp_string_allocated)
+            free(temp_str);
+        return (-1);
+    }
+
+    slen = p - temp_str;
+
+    t_p->key_p = malloc(slen + 1);
+    if (NULL == t_p->key_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        free(t_p);
+        if (temp_string_allocated)
+            free(temp_str);
+        return (-1);
+    }
+    strncpy(t_p->key_p, temp_str, slen);
+    t_p->key_p[slen] = 0;
+
+
+    p++;
+
+    if (convert_int(p, &t_p->value) < 0)
+    {
+        free(t_p->key_p);
+        free(t_p);
+        if (temp_string_allocated)
+            free(temp_str);
+        return (-1);
+    }
+
+    if ((max_p != NULL) &&
+        (t_p->value > *max_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack strint_tuple value failed on "
+                             "max check: %d > %d\n", t_p->value, *max_p));
+        set_errno(E_MPL_FAILED_OPERATION);
+        free(t_p->key_p);
+        free(t_p);
+        if (temp_string_allocated)
+            free(temp_str);
+        return (-1);
+    }
+
+    if ((min_p != NULL) &&
+        (t_p->value < *min_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack strint_tuple value failed on "
+                             "min check: %d < %d\n", t_p->value, *min_p));
+        set_errno(E_MPL_FAILED_OPERATION);
+        free(t_p->key_p);
+        free(t_p);
+        if (temp_string_allocated)
+            free(temp_str);
+        return (-1);
+    }
+
+    *value_pp = t_p;
+
+    if (temp_string_allocated)
+        free(temp_str);
+    return (0);
+}
+
+/**
+ * mpl_clone_param_value_strint_tuple()
+ **/
+int
+    mpl_clone_param_value_strint_tuple(void **new_value_pp,
+                                       const void* old_value_p,
+                                       const mpl_param_descr2_t *descr_p)
+{
+    mpl_strint_tuple_t *t_p;
+    const mpl_strint_tuple_t *old_t_p;
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+
+    t_p = malloc(sizeof(mpl_strint_tuple_t));
+    if (NULL == t_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return (-1);
+    }
+
+    old_t_p = old_value_p;
+
+    t_p->key_p = malloc(strlen(old_t_p->key_p) + 1);
+    if (NULL == t_p->key_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        free(t_p);
+        return (-1);
+    }
+
+    strcpy(t_p->key_p, old_t_p->key_p);
+    t_p->value = old_t_p->value;
+
+    *new_value_pp = t_p;
+
+    return (0);
+}
+
+/**
+ * mpl_copy_param_value_strint_tuple()
+ **/
+/* NOTE: Copy on a tuple means copy of the value part of the tuple */
+int
+    mpl_copy_param_value_strint_tuple(void *to_value_p,
+                                      const void* from_value_p,
+                                      int size,
+                                      const mpl_param_descr2_t *descr_p)
+{
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    if (size >= (int)sizeof(int))
+        *(int*)to_value_p = ((mpl_strint_tuple_t*)from_value_p)->value;
+
+    return sizeof(int);
+}
+
+/**
+ * mpl_compare_param_value_strint_tuple()
+ **/
+int mpl_compare_param_value_strint_tuple(const void *value1_p,
+                                         const void* value2_p,
+                                         const mpl_param_descr2_t *descr_p)
+{
+    const mpl_strint_tuple_t *t1_p;
+    const mpl_strint_tuple_t *t2_p;
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+
+    t1_p = value1_p;
+    t2_p = value2_p;
+
+    if ((NULL == t1_p->key_p) || (NULL == t2_p->key_p))
+    {
+        if (t1_p->key_p != t2_p->key_p)
+            return -1;
+    }
+    else if (strcmp(t1_p->key_p, t2_p->key_p))
+        return -1;
+
+    return (t1_p->value != t2_p->value);
+}
+
+/**
+ * mpl_sizeof_param_value_strint_tuple()
+ **/
+size_t mpl_sizeof_param_value_strint_tuple(const mpl_param_descr2_t *descr_p)
+{
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    return 0;
+}
+
+
+/**
+ * mpl_free_param_value_strint_tuple()
+ **/
+void mpl_free_param_value_strint_tuple(void *value_p)
+{
+    mpl_strint_tuple_t *t_p;
+
+    t_p = value_p;
+    if (NULL != t_p)
+    {
+        if (NULL != t_p->key_p)
+        {
+            free(t_p->key_p);
+        }
+
+        free(t_p);
+    }
+}
+
+/**
+ * mpl_pack_param_value_struint8_tuple()
+ **/
+int mpl_pack_param_value_struint8_tuple(const void* param_value_p,
+                                        char *buf,
+                                        size_t buflen,
+                                        const mpl_param_descr2_t *descr_p,
+                                        const mpl_pack_options_t *options_p)
+{
+    const mpl_struint8_tuple_t *t_p;
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+
+    assert(NULL != param_value_p);
+
+    t_p = param_value_p;
+    assert(NULL != t_p->key_p);
+
+    return snprintf_escape(options_p->message_delimiter, '\\',
+                           buf, buflen, "=%s/%d", t_p->key_p, t_p->value);
+}
+
+
+/**
+ * mpl_unpack_param_value_struint8_tuple()
+ **/
+int
+    mpl_unpack_param_value_struint8_tuple(const char* value_str,
+                                          void **value_pp,
+                                          const mpl_param_descr2_t *descr_p,
+                                          const mpl_pack_options_t *options_p,
+                                          mpl_param_element_id_t unpack_context)
+{
+    mpl_struint8_tuple_t *t_p;
+    char* p;
+    int slen;
+    int temp;
+    char *temp_str;
+    int temp_string_allocated = 0;
+    const uint8_t *max_p = descr_p->max_p;
+    const uint8_t *min_p = descr_p->min_p;
+    MPL_IDENTIFIER_NOT_USED(unpack_context);
+
+    if (strchr(value_str, '\\')) {
+        temp_str = remove_escape(value_str, '\\');
+        if (temp_str == NULL) {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                                ("Failed allocating memory\n"));
+            set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+            return (-1);
+        }
+        temp_string_allocated = 1;
+    }
+    else {
+        temp_str = (char*) value_str;
+    }
+
+    p = strchr(temp_str, '/');
+    if (NULL == p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack struint8_tuple failed, no delimiter: %s\n",
+                             temp_str));
+        set_errno(E_MPL_FAILED_OPERATION);
+        if (temp_string_allocated)
+            free(temp_str);
+        return (-1);
+    }
+
+    t_p = malloc(sizeof(mpl_struint8_tuple_t));
+    if (NULL == t_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        if (temp_string_allocated)
+            free(temp_str);
+        return (-1);
+    }
+
+    slen = p - temp_str;
+
+    t_p->key_p = malloc(slen + 1);
+    if (NULL == t_p->key_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        free(t_p);
+        if (temp_string_allocated)
+            free(temp_str);
+        return (-1);
+    }
+    strncpy(t_p->key_p, temp_str, slen);
+    t_p->key_p[slen] = 0;
+
+
+    p++;
+
+    if (convert_int(p, &temp) < 0)
+    {
+        free(t_p->key_p);
+        free(t_p);
+        if (temp_string_allocated)
+            free(temp_str);
+        return (-1);
+    }
+
+    if ((temp < 0) ||
+        (temp > (int)UINT8_MAX))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack struint8_tuple failed on range check: %d\n", temp));
+        set_errno(E_MPL_FAILED_OPERATION);
+        free(t_p->key_p);
+        free(t_p);
+        if (temp_string_allocated)
+            free(temp_str);
+        return (-1);
+    }
+
+    t_p->value = (uint8_t)temp;
+
+    if ((max_p != NULL) &&
+        (t_p->value > *max_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack struint8_tuple value failed on "
+                             "max check: %d > %d\n", t_p->value, *max_p));
+        set_errno(E_MPL_FAILED_OPERATION);
+        free(t_p->key_p);
+        free(t_p);
+        if (temp_string_allocated)
+            free(temp_str);
+        return (-1);
+    }
+
+    if ((min_p != NULL) &&
+        (t_p->value < *min_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack struint8_tuple value failed on "
+                             "min check: %d < %d\n", t_p->value, *min_p));
+        set_errno(E_MPL_FAILED_OPERATION);
+        free(t_p->key_p);
+        free(t_p);
+        if (temp_string_allocated)
+            free(temp_str);
+        return (-1);
+    }
+
+    *value_pp = t_p;
+
+    if (temp_string_allocated)
+        free(temp_str);
+    return (0);
+}
+
+/**
+ * mpl_clone_param_value_struint8_tuple()
+ **/
+int
+    mpl_clone_param_value_struint8_tuple(void **new_value_pp,
+                                         const void* old_value_p,
+                                         const mpl_param_descr2_t *descr_p)
+{
+    mpl_struint8_tuple_t *t_p;
+    const mpl_struint8_tuple_t *old_t_p;
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+
+    t_p = malloc(sizeof(mpl_struint8_tuple_t));
+    if (NULL == t_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return (-1);
+    }
+
+    old_t_p = old_value_p;
+
+    t_p->key_p = malloc(strlen(old_t_p->key_p) + 1);
+    if (NULL == t_p->key_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        free(t_p);
+        return (-1);
+    }
+
+    strcpy(t_p->key_p, old_t_p->key_p);
+    t_p->value = old_t_p->value;
+
+    *new_value_pp = t_p;
+
+    return (0);
+}
+
+/**
+ * mpl_copy_param_value_struint8_tuple()
+ **/
+/* NOTE: Copy on a tuple means copy of the value part of the tuple */
+int
+    mpl_copy_param_value_struint8_tuple(void *to_value_p,
+                                        const void* from_value_p,
+                                        int size,
+                                        const mpl_param_descr2_t *descr_p)
+{
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    if (size >= (int)sizeof(int))
+        *(uint8_t*)to_value_p = ((mpl_struint8_tuple_t*)from_value_p)->value;
+
+    return sizeof(uint8_t);
+}
+
+/**
+ * mpl_compare_param_value_struint8_tuple()
+ **/
+int mpl_compare_param_value_struint8_tuple(const void *value1_p,
+                                           const void* value2_p,
+                                           const mpl_param_descr2_t *descr_p)
+{
+    const mpl_struint8_tuple_t *t1_p;
+    const mpl_struint8_tuple_t *t2_p;
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+
+    t1_p = value1_p;
+    t2_p = value2_p;
+
+    if ((NULL == t1_p->key_p) || (NULL == t2_p->key_p))
+    {
+        if (t1_p->key_p != t2_p->key_p)
+            return -1;
+    }
+    else if (strcmp(t1_p->key_p, t2_p->key_p))
+        return -1;
+
+    return (t1_p->value != t2_p->value);
+}
+
+/**
+ * mpl_sizeof_param_value_struint8_tuple()
+ **/
+size_t mpl_sizeof_param_value_struint8_tuple(const mpl_param_descr2_t *descr_p)
+{
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    return 0;
+}
+
+
+/**
+ * mpl_free_param_value_struint8_tuple()
+ **/
+void mpl_free_param_value_struint8_tuple(void *value_p)
+{
+    mpl_struint8_tuple_t *t_p;
+
+    t_p = value_p;
+    if (NULL != t_p)
+    {
+        if (NULL != t_p->key_p)
+        {
+            free(t_p->key_p);
+        }
+
+        free(t_p);
+    }
+}
+
+
+
+
+/**
+ * mpl_pack_param_value_bag()
+ **/
+int mpl_pack_param_value_bag(const void* param_value_p,
+                             char *buf,
+                             size_t buflen,
+                             const mpl_param_descr2_t *descr_p,
+                             const  mpl_pack_options_t *options_p)
+{
+    mpl_list_t* l_p = (mpl_list_t*)param_value_p;
+    int tmplen;
+    mpl_pack_options_t options = *options_p;
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+
+    assert(NULL != param_value_p);
+    options.message_delimiter = MESSAGE_DELIMITER;
+
+    /* Without room for the contents, only the size is needed */
+    if (buflen <= 2)
+    {
+        tmplen = mpl_param_list_packed_size_extended(l_p, &options);
+        if (tmplen < 0)
+            return tmplen;
+
+        if (buflen == 2)
+        {
+            buf[0] = '=';
+            buf[1] = '\0';
+        }
+        else if (buflen == 1)
+            buf[0] = '\0';
+        return (tmplen+3);
+    }
+
+    /* Pack the contents in place, once, behind the "={" */
+    buf[0] = '=';
+    buf[1] = '{';
+    tmplen = mpl_param_list_pack_extended(l_p,
+                                          buf+2,
+                                          (int)(buflen-2),
+                                          &options);
+    if (tmplen < 0)
+        return tmplen;
+
+    /* If truncated, the contents are already terminated */
+    if ((size_t)(tmplen+3) < buflen)
+    {
+        buf[tmplen+2] = '}';
+        buf[tmplen+3] = '\0';
+    }
+    return (tmplen+3);
+}
+
+
+/**
+ * mpl_unpack_param_value_bag()
+ **/
+int
+    mpl_unpack_param_value_bag(const char* value_str,
+                               void **value_pp,
+                               const mpl_param_descr2_t *descr_p,
+                               const mpl_pack_options_t *options_p,
+                               mpl_param_element_id_t unpack_context)
+{
+    mpl_list_t *l_p = NULL;
+    const char* start_p;
+    char* copy_p;
+    mpl_pack_options_t options = *options_p;
+
+    start_p = strchr(value_str, '{');
+    if (start_p == NULL)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack list failed, no delimiter: %s\n",
+                             value_str));
+        set_errno(E_MPL_FAILED_OPERATION);
+        return (-1);
+    }
+
+    /* Split in place by param_list_parse(), so no views of it */
+    copy_p = strdup(start_p + 1);
+    if (copy_p == NULL)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("copy_p\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return (-1);
+    }
+    options.string_views = false;
+
+    if (NULL == param_list_parse(copy_p,
+                                 &options,
+                                 unpack_context,
+                                 true,
+                                 &l_p))
+    {
+        free(copy_p);
+        return (-1);
+    }
+    free(copy_p);
+
+    if (check_bag_len(l_p, descr_p) < 0)
+    {
+        mpl_param_list_destroy(&l_p);
+        return (-1);
+    }
+
+    *value_pp = l_p;
+
+    return (0);
+}
+
+/**
+ * check_bag_len()
+ **/
+static int check_bag_len(const mpl_list_t *l_p,
+                         const mpl_param_descr2_t *descr_p)
+{
+    const int *max_p = descr_p->max_p;
+    const int *min_p = descr_p->min_p;
+
+    if ((max_p != NULL) &&
+        ((int)mpl_list_len(l_p) > *max_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack list value failed on "
+                             "max check: %zu > %d\n", mpl_list_len(l_p),
+                             *max_p));/*lint !e557 %zu is C99 */
+        set_errno(E_MPL_FAILED_OPERATION);
+        return (-1);
+    }
+
+    if ((min_p != NULL) &&
+        ((int)mpl_list_len(l_p) < *min_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack list value failed on "
+                             "min check: %zu < %d\n", mpl_list_len(l_p),
+                             *min_p));/*lint !e557 %zu is C99 */
+        set_errno(E_MPL_FAILED_OPERATION);
+        return (-1);
+    }
+
+    return (0);
+}
+
+/**
+ * mpl_clone_param_value_bag()
+ **/
+int
+    mpl_clone_param_value_bag(void **new_value_pp,
+                              const void* old_value_p,
+                              const mpl_param_descr2_t *descr_p)
+{
+    mpl_list_t *l_p;
+    mpl_list_t *ol_p = (mpl_list_t *)old_value_p;
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+
+    l_p = mpl_param_list_clone(ol_p);
+    if (l_p == NULL)
+        return (-1);
+
+    *new_value_pp = l_p;
+    return 0;
+}
+
+
+/**
+ * mpl_copy_param_value_bag()
+ **/
+/* NOTE: Copy on a bag means copy of the list pointer
+   (rather pointless unless cloning a list from an element) */
+int
+    mpl_copy_param_value_bag(void *to_value_p,
+                             const void* from_value_p,
+                             int size,
+                             const mpl_param_descr2_t *descr_p)
+{
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    if (size >= (int)sizeof(mpl_list_t*))
+        *(mpl_list_t**)to_value_p = (mpl_list_t*)from_value_p;
+
+    return sizeof(mpl_list_t*);
+}
+
+/**
+ * mpl_compare_param_value_bag()
+ **/
+int mpl_compare_param_value_bag(const void *value1_p,
+                                const void* value2_p,
+                                const mpl_param_descr2_t *descr_p)
+{
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    return mpl_compare_param_lists((mpl_list_t *)value1_p,
+                                   (mpl_list_t *)value2_p);
+}
+
+/**
+ * mpl_sizeof_param_value_bag()
+ **/
+size_t mpl_sizeof_param_value_bag(const mpl_param_descr2_t *descr_p)
+{
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    return 0;
+}
+
+
+/**
+ * mpl_free_param_value_bag()
+ **/
+void mpl_free_param_value_bag(void *value_p)
+{
+    mpl_list_t *l_p = value_p;
+    mpl_param_list_destroy(&l_p);
+}
+
+
+
+/**
+ * mpl_pack_param_value_addr()
+ **/
+int mpl_pack_param_value_addr(const void* param_value_p,
+                              char *buf, size_t buflen,
+                              const mpl_param_descr2_t *descr_p,
+                              const mpl_pack_options_t *options_p)
+{
+    assert(NULL != param_value_p);
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    MPL_IDENTIFIER_NOT_USED(options_p)
+        return snprintf(buf, buflen, "=%p", *(void**)param_value_p);
+}
+
+/**
+ * mpl_unpack_param_value_addr()
+ **/
+int
+    mpl_unpack_param_value_addr(const char* value_str, void **value_pp,
+                                const mpl_param_descr2_t *descr_p,
+                                const mpl_pack_options_t *options_p,
+                                mpl_param_element_id_t unpack_context)
+{
+    void** p;
+    int res;
+
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    MPL_IDENTIFIER_NOT_USED(options_p);
+    MPL_IDENTIFIER_NOT_USED(unpack_context);
+
+    p = malloc(sizeof(void*));
+    if (NULL == p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return (-1);
+    }
+
+    res = sscanf(value_str, "%p", p);
+
+    if (res <= 0)
+    {
+        free(p);
+        return (-1);
+    }
+
+    assert(NULL != value_pp);
+    *value_pp = p;
+
+    return (0);
+}
+
+/**
+ * mpl_clone_param_value_addr()
+ **/
+int
+    mpl_clone_param_value_addr(void **new_value_pp,
+                               const void* old_value_p,
+                               const mpl_param_descr2_t *descr_p)
+{
+    void** p = malloc(sizeof(void*));
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    if (NULL == p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return (-1);
+    }
+
+    *p = *(void**)old_value_p;
+    *new_value_pp = p;
+
+    return (0);
+}
+
+/**
+ * mpl_copy_param_value_addr()
+ **/
+int
+    mpl_copy_param_value_addr(void *to_value_p,
+                              const void* from_value_p,
+                              int size,
+                              const mpl_param_descr2_t *descr_p)
+{
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    if (size >= (int)sizeof(void*))
+        *(void**)to_value_p = *(void**)from_value_p;
+
+    return sizeof(void*);
+}
+
+/**
+ * mpl_compare_param_value_addr()
+ **/
+int mpl_compare_param_value_addr(const void *value1_p,
+                                 const void* value2_p,
+                                 const mpl_param_descr2_t *descr_p)
+{
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    return (*((void**) value1_p) != *((void**) value2_p));
+}
+
+/**
+ * mpl_sizeof_param_value_addr()
+ **/
+size_t mpl_sizeof_param_value_addr(const mpl_param_descr2_t *descr_p)
+{
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    return sizeof(void*);
+}
+
+
+/**
+ * Packed sizes, per type
+ *
+ * What the text pack method of the type returns, computed without
+ * formatting. Enums, bools and addresses are measured by packing them
+ * without a buffer, which costs the same for those types.
+ **/
+
+#define DEFINE_MPL_PACKED_SIZE_PARAM_VALUE_DECIMAL(type_name, value_type) \
+    int mpl_packed_size_param_value_##type_name(const void* param_value_p, \
+                                                const mpl_param_descr2_t *descr_p, \
+                                                const mpl_pack_options_t *options_p) \
+    {                                                                   \
+        MPL_IDENTIFIER_NOT_USED(descr_p);                               \
+        MPL_IDENTIFIER_NOT_USED(options_p);                             \
+        assert(NULL != param_value_p);                                  \
+        /* "=" and the digits */                                        \
+        return 1 + decimal_width(*(const value_type*)param_value_p);    \
+    }
+
+#define DEFINE_MPL_PACKED_SIZE_PARAM_VALUE_HEX(type_name, value_type)   \
+    int mpl_packed_size_param_value_##type_name(const void* param_value_p, \
+                                                const mpl_param_descr2_t *descr_p, \
+                                                const mpl_pack_options_t *options_p) \
+    {                                                                   \
+        MPL_IDENTIFIER_NOT_USED(descr_p);                               \
+        MPL_IDENTIFIER_NOT_USED(options_p);                             \
+        assert(NULL != param_value_p);                                  \
+        /* "=0x" and the digits */                                      \
+        return 3 + hex_width(*(const value_type*)param_value_p);        \
+    }
+
+#define DEFINE_MPL_PACKED_SIZE_PARAM_VALUE_BY_PACK(type_name)           \
+    int mpl_packed_size_param_value_##type_name(const void* param_value_p, \
+                                                const mpl_param_descr2_t *descr_p, \
+                                                const mpl_pack_options_t *options_p) \
+    {                                                                   \
+        return mpl_pack_param_value_##type_name(param_value_p,          \
+                                                NULL,                   \
+                                                0,                      \
+                                                descr_p,                \
+                                                options_p);             \
+    }
+
+#define DEFINE_MPL_PACKED_SIZE_PARAM_VALUE_ARRAY(type_name, array_type, element_type) \
+    int mpl_packed_size_param_value_##type_name(const void* param_value_p, \
+                                                const mpl_param_descr2_t *descr_p, \
+                                                const mpl_pack_options_t *options_p) \
+    {                                                                   \
+        MPL_IDENTIFIER_NOT_USED(descr_p);                               \
+        MPL_IDENTIFIER_NOT_USED(options_p);                             \
+        assert(NULL != param_value_p);                                  \
+        /* "=", the length and the elements, as hex digits */           \
+        return 9 + (int)(((const array_type*)param_value_p)->len *      \
+                         2 * sizeof(element_type));                     \
+    }
+
+DEFINE_MPL_PACKED_SIZE_PARAM_VALUE_DECIMAL(int, int)
+DEFINE_MPL_PACKED_SIZE_PARAM_VALUE_DECIMAL(sint8, sint8_t)
+DEFINE_MPL_PACKED_SIZE_PARAM_VALUE_DECIMAL(sint16, sint16_t)
+DEFINE_MPL_PACKED_SIZE_PARAM_VALUE_DECIMAL(sint32, sint32_t)
+DEFINE_MPL_PACKED_SIZE_PARAM_VALUE_DECIMAL(sint64, int64_t)
+DEFINE_MPL_PACKED_SIZE_PARAM_VALUE_HEX(uint8, uint8_t)
+DEFINE_MPL_PACKED_SIZE_PARAM_VALUE_HEX(uint16, uint16_t)
+DEFINE_MPL_PACKED_SIZE_PARAM_VALUE_HEX(uint32, uint32_t)
+DEFINE_MPL_PACKED_SIZE_PARAM_VALUE_HEX(uint64, uint64_t)
+DEFINE_MPL_PACKED_SIZE_PARAM_VALUE_BY_PACK(enum)
+DEFINE_MPL_PACKED_SIZE_PARAM_VALUE_BY_PACK(enum8)
+DEFINE_MPL_PACKED_SIZE_PARAM_VALUE_BY_PACK(enum16)
+DEFINE_MPL_PACKED_SIZE_PARAM_VALUE_BY_PACK(enum32)
+DEFINE_MPL_PACKED_SIZE_PARAM_VALUE_BY_PACK(signed_enum8)
+DEFINE_MPL_PACKED_SIZE_PARAM_VALUE_BY_PACK(signed_enum16)
+DEFINE_MPL_PACKED_SIZE_PARAM_VALUE_BY_PACK(signed_enum32)
+DEFINE_MPL_PACKED_SIZE_PARAM_VALUE_BY_PACK(bool)
+DEFINE_MPL_PACKED_SIZE_PARAM_VALUE_BY_PACK(bool8)
+DEFINE_MPL_PACKED_SIZE_PARAM_VALUE_BY_PACK(addr)
+DEFINE_MPL_PACKED_SIZE_PARAM_VALUE_ARRAY(uint8_array, mpl_uint8_array_t, uint8_t)
+DEFINE_MPL_PACKED_SIZE_PARAM_VALUE_ARRAY(uint16_array, mpl_uint16_array_t, uint16_t)
+DEFINE_MPL_PACKED_SIZE_PARAM_VALUE_ARRAY(uint32_array, mpl_uint32_array_t, uint32_t)
+
+/**
+ * mpl_packed_size_param_value_string()
+ **/
+int mpl_packed_size_param_value_string(const void* param_value_p,
+                                       const mpl_param_descr2_t *descr_p,
+                                       const mpl_pack_options_t *options_p)
+{
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    assert(NULL != param_value_p);
+
+    return (int)(escaped_len("=", 1, options_p->message_delimiter, '\\') +
+                 escaped_len(param_value_p,
+                             strlen(param_value_p),
+                             options_p->message_delimiter,
+                             '\\'));
+}
+
+/**
+ * mpl_packed_size_param_value_wstring()
+ **/
+int mpl_packed_size_param_value_wstring(const void* param_value_p,
+                                        const mpl_param_descr2_t *descr_p,
+                                        const mpl_pack_options_t *options_p)
+{
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    MPL_IDENTIFIER_NOT_USED(options_p);
+    assert(NULL != param_value_p);
+
+    /* Packed as an uint32 array, including the terminator */
+    return 9 + (int)((wcslen(param_value_p) + 1) * 2 * sizeof(uint32_t));
+}
+
+/**
+ * mpl_packed_size_param_value_string_tuple()
+ **/
+int mpl_packed_size_param_value_string_tuple(const void* param_value_p,
+                                             const mpl_param_descr2_t *descr_p,
+                                             const mpl_pack_options_t *options_p)
+{
+    const mpl_string_tuple_t *st_p = param_value_p;
+    char delimiter = options_p->message_delimiter;
+    size_t len;
+
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    assert(NULL != param_value_p);
+    assert(NULL != st_p->key_p);
+
+    len = escaped_len("=", 1, delimiter, '\\') +
+        escaped_len(st_p->key_p, strlen(st_p->key_p), delimiter, '\\') +
+        escaped_len(":", 1, delimiter, '\\');
+    if (NULL != st_p->value_p)
+        len += escaped_len(st_p->value_p, strlen(st_p->value_p), delimiter, '\\');
+    return (int)len;
+}
+
+/**
+ * mpl_packed_size_param_value_int_tuple()
+ **/
+int mpl_packed_size_param_value_int_tuple(const void* param_value_p,
+                                          const mpl_param_descr2_t *descr_p,
+                                          const mpl_pack_options_t *options_p)
+{
+    const mpl_int_tuple_t *it_p = param_value_p;
+
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    MPL_IDENTIFIER_NOT_USED(options_p);
+    assert(NULL != param_value_p);
+
+    return 2 + decimal_width(it_p->key) + decimal_width(it_p->value);
+}
+
+/**
+ * mpl_packed_size_param_value_strint_tuple()
+ **/
+int mpl_packed_size_param_value_strint_tuple(const void* param_value_p,
+                                             const mpl_param_descr2_t *descr_p,
+                                             const mpl_pack_options_t *options_p)
+{
+    const mpl_strint_tuple_t *t_p = param_value_p;
+    char delimiter = options_p->message_delimiter;
+    char tmp[24];
+    int n;
+
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    assert(NULL != param_value_p);
+    assert(NULL != t_p->key_p);
+
+    /* The number is escaped too, if the delimiter is '-' or a digit */
+    n = pack_int(tmp, sizeof(tmp), t_p->value);
+    tmp[0] = ':';
+    return (int)(escaped_len("=", 1, delimiter, '\\') +
+                 escaped_len(t_p->key_p, strlen(t_p->key_p), delimiter, '\\') +
+                 escaped_len(tmp, n, delimiter, '\\'));
+}
+
+/**
+ * mpl_packed_size_param_value_struint8_tuple()
+ **/
+int mpl_packed_size_param_value_struint8_tuple(const void* param_value_p,
+                                               const mpl_param_descr2_t *descr_p,
+                                               const mpl_pack_options_t *options_p)
+{
+    const mpl_struint8_tuple_t *t_p = param_value_p;
+    char delimiter = options_p->message_delimiter;
+    char tmp[24];
+    int n;
+
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    assert(NULL != param_value_p);
+    assert(NULL != t_p->key_p);
+
+    n = pack_int(tmp, sizeof(tmp), t_p->value);
+    tmp[0] = '/';
+    return (int)(escaped_len("=", 1, delimiter, '\\') +
+                 escaped_len(t_p->key_p, strlen(t_p->key_p), delimiter, '\\') +
+                 escaped_len(tmp, n, delimiter, '\\'));
+}
+
+/**
+ * mpl_packed_size_param_value_bag()
+ **/
+int mpl_packed_size_param_value_bag(const void* param_value_p,
+                                    const mpl_param_descr2_t *descr_p,
+                                    const mpl_pack_options_t *options_p)
+{
+    mpl_pack_options_t options = *options_p;
+    int len;
+
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    assert(NULL != param_value_p);
+
+    /* As mpl_pack_param_value_bag() */
+    options.message_delimiter = MESSAGE_DELIMITER;
+    len = mpl_param_list_packed_size_extended((mpl_list_t*)param_value_p,
+                                              &options);
+    if (len < 0)
+        return len;
+
+    /* "={" and "}" */
+    return len + 3;
+}
+
+
+/**
+ * Binary transfer format, per type pack and unpack methods
+ *
+ * Integers are fixed width little endian (int is 32 bits on the wire),
+ * enums use their representation size. Strings are raw characters (no
+ * terminator), arrays are raw little endian elements and bags are nested
+ * list bodies. The length of each value is given by the element header.
+ **/
+
+#define DEFINE_MPL_BIN_PARAM_VALUE_INTEGER(type_name, value_type, min_max_type, wire_size, is_signed) \
+    int mpl_pack_bin_param_value_##type_name(const void* param_value_p, \
+                                             uint8_t *buf,              \
+                                             size_t buflen,             \
+                                             const mpl_param_descr2_t *descr_p) \
+    {                                                                   \
+        MPL_IDENTIFIER_NOT_USED(descr_p);                               \
+        assert(NULL != param_value_p);                                  \
+                                                                        \
+        if ((NULL != buf) && (buflen >= (wire_size)))                   \
+            bin_put_le(buf,                                             \
+                       (uint64_t)*(const value_type*)param_value_p,     \
+                       (wire_size));                                    \
+        return (wire_size);                                             \
+    }                                                                   \
+                                                                        \
+    int mpl_unpack_bin_param_value_##type_name(const uint8_t *buf,      \
+                                               size_t buflen,           \
+                                               void **value_pp,         \
+                                               const mpl_param_descr2_t *descr_p) \
+    {                                                                   \
+        value_type* p;                                                  \
+        value_type value;                                               \
+        const min_max_type *max_p = descr_p->max_p;                     \
+        const min_max_type *min_p = descr_p->min_p;                     \
+        int range_id = 0;                                               \
+                                                                        \
+        if (buflen != (wire_size))                                      \
+        {                                                               \
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,                 \
+                                ("Unpack " #type_name " failed on length check: %zu\n", \
+                                 buflen));/*lint !e557 %zu is C99 */    \
+            set_errno(E_MPL_FAILED_OPERATION);                          \
+            return (-1);                                                \
+        }                                                               \
+                                                                        \
+        if (is_signed)                                                  \
+            value = (value_type)bin_sign_extend(bin_get_le(buf, (wire_size)), \
+                                                (wire_size));           \
+        else                                                            \
+            value = (value_type)bin_get_le(buf, (wire_size));           \
+                                                                        \
+        if ((max_p != NULL) &&                                          \
+            (value > *max_p))                                           \
+        {                                                               \
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,                 \
+                                ("Unpack " #type_name " failed on max check\n")); \
+            set_errno(E_MPL_FAILED_OPERATION);                          \
+            return (-1);                                                \
+        }                                                               \
+                                                                        \
+        if ((min_p != NULL) &&                                          \
+            (value < *min_p))                                           \
+        {                                                               \
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,                 \
+                                ("Unpack " #type_name " failed on min check\n")); \
+            set_errno(E_MPL_FAILED_OPERATION);                          \
+            return (-1);                                                \
+        }                                                               \
+                                                                        \
+        if (descr_p->integer_ranges_size > 0) {                         \
+            range_id = check_integer_ranges((int64_t)value,             \
+                                            descr_p->integer_ranges,    \
+                                            descr_p->integer_ranges_size); \
+            if (range_id < 0) {                                         \
+                MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,             \
+                                    ("Unpack " #type_name " failed on range check\n")); \
+                set_errno(E_MPL_FAILED_OPERATION);                      \
+                return (-1);                                            \
+            }                                                           \
+        }                                                               \
+                                                                        \
+        p = malloc(sizeof(value_type));                                 \
+        if (NULL == p)                                                  \
+        {                                                               \
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,         \
+                                ("Failed allocating memory\n"));        \
+            set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);                  \
+            return (-1);                                                \
+        }                                                               \
+                                                                        \
+        *p = value;                                                     \
+        assert(NULL != value_pp);                                       \
+        *value_pp = p;                                                  \
+                                                                        \
+        return range_id;                                                \
+    }
+
+DEFINE_MPL_BIN_PARAM_VALUE_INTEGER(int, int, int, 4, 1)
+DEFINE_MPL_BIN_PARAM_VALUE_INTEGER(sint8, sint8_t, sint8_t, 1, 1)
+DEFINE_MPL_BIN_PARAM_VALUE_INTEGER(sint16, sint16_t, sint16_t, 2, 1)
+DEFINE_MPL_BIN_PARAM_VALUE_INTEGER(sint32, sint32_t, sint32_t, 4, 1)
+DEFINE_MPL_BIN_PARAM_VALUE_INTEGER(sint64, int64_t, int64_t, 8, 1)
+DEFINE_MPL_BIN_PARAM_VALUE_INTEGER(uint8, uint8_t, uint8_t, 1, 0)
+DEFINE_MPL_BIN_PARAM_VALUE_INTEGER(uint16, uint16_t, uint16_t, 2, 0)
+DEFINE_MPL_BIN_PARAM_VALUE_INTEGER(uint32, uint32_t, uint32_t, 4, 0)
+DEFINE_MPL_BIN_PARAM_VALUE_INTEGER(uint64, uint64_t, uint64_t, 8, 0)
+
+
+/**
+ * mpl_pack_bin_param_value_enum()
+ **/
+int mpl_pack_bin_param_value_enum(const void* param_value_p,
+                                  uint8_t *buf,
+                                  size_t buflen,
+                                  const mpl_param_descr2_t *descr_p)
+{
+    size_t size = descr_p->enum_representation_bytesize;
+    int64_t value;
+
+    assert(NULL != param_value_p);
+    assert(NULL != descr_p->enum_values);
+
+    switch (size) {
+        case 1:
+            if (descr_p->enum_representation_signed)
+                value = *((sint8_t*)param_value_p);
+            else
+                value = *((uint8_t*)param_value_p);
+            break;
+        case 2:
+            if (descr_p->enum_representation_signed)
+                value = *((sint16_t*)param_value_p);
+            else
+                value = *((uint16_t*)param_value_p);
+            break;
+        case 4:
+            if (descr_p->enum_representation_signed)
+                value = *((sint32_t*)param_value_p);
+            else
+                value = *((uint32_t*)param_value_p);
+            break;
+        default:
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("Pack enum failed: no support for 8 byte enum representations\n"));
+            set_errno(E_MPL_FAILED_OPERATION);
+            return (-1);
+    }
+
+    if (convert_enum_value_to_name(value, descr_p) == NULL)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Pack enum failed: unknown value %" PRIi64 "\n",
+                             value));
+        set_errno(E_MPL_FAILED_OPERATION);
+        return (-1);
+    }
+
+    if ((NULL != buf) && (buflen >= size))
+        bin_put_le(buf, (uint64_t)value, size);
+    return (int)size;
+}
+
+/**
+ * mpl_unpack_bin_param_value_enum()
+ **/
+int mpl_unpack_bin_param_value_enum(const uint8_t *buf,
+                                    size_t buflen,
+                                    void **value_pp,
+                                    const mpl_param_descr2_t *descr_p)
+{
+    size_t size = descr_p->enum_representation_bytesize;
+    int64_t value;
+    void *p;
+
+    if ((size != 1) && (size != 2) && (size != 4))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack enum failed: no support for 8 byte enum representations\n"));
+        set_errno(E_MPL_FAILED_OPERATION);
+        return (-1);
+    }
+
+    if (buflen != size)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack enum failed on length check: %zu\n",
+                             buflen));/*lint !e557 %zu is C99 */
+        set_errno(E_MPL_FAILED_OPERATION);
+        return (-1);
+    }
+
+    if (descr_p->enum_representation_signed)
+        value = bin_sign_extend(bin_get_le(buf, size), size);
+    else
+        value = (int64_t)bin_get_le(buf, size);
+
+    if (convert_enum_value_to_name(value, descr_p) == NULL)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack enum failed: unknown value %" PRIi64 "\n",
+                             value));
+        set_errno(E_MPL_FAILED_OPERATION);
+        return (-1);
+    }
+
+    p = malloc(size);
+    if (NULL == p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return (-1);
+    }
+
+    /* Local representation has the same size as the wire representation */
+    switch (size) {
+        case 1:
+            *((uint8_t*)p) = (uint8_t)value;
+            break;
+        case 2:
+            *((uint16_t*)p) = (uint16_t)value;
+            break;
+        default:
+            *((uint32_t*)p) = (uint32_t)value;
+            break;
+    }
+
+    assert(NULL != value_pp);
+    *value_pp = p;
+    return (0);
+}
+
+#define DEFINE_MPL_BIN_PARAM_VALUE_ENUM(enum_name, enum_type, is_signed) \
+    int mpl_pack_bin_param_value_##enum_name(const void* param_value_p, \
+                                             uint8_t *buf,              \
+                                             size_t buflen,             \
+                                             const mpl_param_descr2_t *descr_p) \
+    {                                                                   \
+        enum_type value;                                                \
+                                                                        \
+        assert(NULL != param_value_p);                                  \
+        assert(NULL != descr_p->enum_values);                           \
+                                                                        \
+        value = *((const enum_type*)param_value_p);                     \
+        if (convert_enum_value_to_name(value, descr_p) == NULL)         \
+        {                                                               \
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,                 \
+                                ("Pack enum failed: unknown value %" PRIi64 "\n", \
+                                 (int64_t)value));                      \
+            set_errno(E_MPL_FAILED_OPERATION);                          \
+            return (-1);                                                \
+        }                                                               \
+                                                                        \
+        if ((NULL != buf) && (buflen >= sizeof(enum_type)))             \
+            bin_put_le(buf, (uint64_t)value, sizeof(enum_type));        \
+        return sizeof(enum_type);                                       \
+    }                                                                   \
+                                                                        \
+    int mpl_unpack_bin_param_value_##enum_name(const uint8_t *buf,      \
+                                               size_t buflen,           \
+                                               void **value_pp,         \
+                                               const mpl_param_descr2_t *descr_p) \
+    {                                                                   \
+        enum_type* p;                                                   \
+        int64_t value;                                                  \
+                                                                        \
+        if (buflen != sizeof(enum_type))                                \
+        {                                                               \
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,                 \
+                                ("Unpack " #enum_name " failed on length check: %zu\n", \
+                                 buflen));/*lint !e557 %zu is C99 */    \
+            set_errno(E_MPL_FAILED_OPERATION);                          \
+            return (-1);                                                \
+        }                                                               \
+                                                                        \
+        if (is_signed)                                                  \
+            value = bin_sign_extend(bin_get_le(buf, sizeof(enum_type)), \
+                                    sizeof(enum_type));                 \
+        else                                                            \
+            value = (int64_t)bin_get_le(buf, sizeof(enum_type));        \
+                                                                        \
+        if (convert_enum_value_to_name(value, descr_p) == NULL)         \
+        {                                                               \
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,                 \
+                                ("Unpack enum failed: unknown value %" PRIi64 "\n", \
+                                 value));                               \
+            set_errno(E_MPL_FAILED_OPERATION);                          \
+            return (-1);                                                \
+        }                                                               \
+                                                                        \
+        p = malloc(sizeof(enum_type));                                  \
+        if (NULL == p)                                                  \
+        {                                                               \
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,         \
+                                ("Failed allocating memory\n"));        \
+            set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);                  \
+            return (-1);                                                \
+        }                                                               \
+                                                                        \
+        *p = (enum_type)value;                                          \
+        assert(NULL != value_pp);                                       \
+        *value_pp = p;                                                  \
+                                                                        \
+        return (0);                                                     \
+    }
+
+DEFINE_MPL_BIN_PARAM_VALUE_ENUM(enum8, uint8_t, 0)
+DEFINE_MPL_BIN_PARAM_VALUE_ENUM(enum16, uint16_t, 0)
+DEFINE_MPL_BIN_PARAM_VALUE_ENUM(enum32, uint32_t, 0)
+DEFINE_MPL_BIN_PARAM_VALUE_ENUM(signed_enum8, sint8_t, 1)
+DEFINE_MPL_BIN_PARAM_VALUE_ENUM(signed_enum16, sint16_t, 1)
+DEFINE_MPL_BIN_PARAM_VALUE_ENUM(signed_enum32, sint32_t, 1)
+
+#define DEFINE_MPL_BIN_PARAM_VALUE_BOOL(bool_name, bool_type)            \
+    int mpl_pack_bin_param_value_##bool_name(const void* param_value_p, \
+                                             uint8_t *buf,              \
+                                             size_t buflen,             \
+                                             const mpl_param_descr2_t *descr_p) \
+    {                                                                   \
+        int value;                                                      \
+                                                                        \
+        MPL_IDENTIFIER_NOT_USED(descr_p);                               \
+        assert(NULL != param_value_p);                                  \
+                                                                        \
+        value = *(const bool_type*)param_value_p;                       \
+        if ((value != 0) && (value != 1))                               \
+        {                                                               \
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,                 \
+                                ("Pack " #bool_name " failed on range check: %d\n", \
+                                 value));                               \
+            set_errno(E_MPL_FAILED_OPERATION);                          \
+            return (-1);                                                \
+        }                                                               \
+                                                                        \
+        if ((NULL != buf) && (buflen >= 1))                             \
+            buf[0] = (uint8_t)value;                                    \
+        return 1;                                                       \
+    }                                                                   \
+                                                                        \
+    int mpl_unpack_bin_param_value_##bool_name(const uint8_t *buf,      \
+                                               size_t buflen,           \
+                                               void **value_pp,         \
+                                               const mpl_param_descr2_t *descr_p) \
+    {                                                                   \
+        bool_type* p;                                                   \
+                                                                        \
+        MPL_IDENTIFIER_NOT_USED(descr_p);                               \
+                                                                        \
+        if ((buflen != 1) || (buf[0] > 1))                              \
+        {                                                               \
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,                 \
+                                ("Unpack " #bool_name " failed on range check\n")); \
+            set_errno(E_MPL_FAILED_OPERATION);                          \
+            return (-1);                                                \
+        }                                                               \
+                                                                        \
+        p = malloc(sizeof(bool_type));                                  \
+        if (NULL == p)                                                  \
+        {                                                               \
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,         \
+                                ("Failed allocating memory\n"));        \
+            set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);                  \
+            return (-1);                                                \
+        }                                                               \
+                                                                        \
+        *p = (bool_type)buf[0];                                         \
+        assert(NULL != value_pp);                                       \
+        *value_pp = p;                                                  \
+                                                                        \
+        return (0);                                                     \
+    }
+
+DEFINE_MPL_BIN_PARAM_VALUE_BOOL(bool, bool)
+DEFINE_MPL_BIN_PARAM_VALUE_BOOL(bool8, uint8_t)
+
+/**
+ * mpl_pack_bin_param_value_string()
+ **/
+int mpl_pack_bin_param_value_string(const void* param_value_p,
+                                    uint8_t *buf,
+                                    size_t buflen,
+                                    const mpl_param_descr2_t *descr_p)
+{
+    size_t len;
+
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    assert(NULL != param_value_p);
+
+    len = strlen((const char*)param_value_p);
+    if ((NULL != buf) && (buflen >= len))
+        memcpy(buf, param_value_p, len);
+    return (int)len;
+}
+
+/**
+ * mpl_unpack_bin_param_value_string()
+ **/
+int mpl_unpack_bin_param_value_string(const uint8_t *buf,
+                                      size_t buflen,
+                                      void **value_pp,
+                                      const mpl_param_descr2_t *descr_p)
+{
+    char *p;
+    const int *max_p = descr_p->max_p;
+    const int *min_p = descr_p->min_p;
+
+    if (memchr(buf, '\0', buflen) != NULL)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack string failed: embedded zero\n"));
+        set_errno(E_MPL_FAILED_OPERATION);
+        return (-1);
+    }
+
+    if ((max_p != NULL) &&
+        ((int)buflen > *max_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack string failed on max length check: %zu > %d\n",
+                             buflen, *max_p));/*lint !e557 %zu is C99 */
+        set_errno(E_MPL_FAILED_OPERATION);
+        return (-1);
+    }
+
+    if ((min_p != NULL) &&
+        ((int)buflen < *min_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack string failed on min length check: %zu < %d\n",
+                             buflen, *min_p));/*lint !e557 %zu is C99 */
+        set_errno(E_MPL_FAILED_OPERATION);
+        return (-1);
+    }
+
+    p = malloc(buflen + 1);
+    if (NULL == p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return (-1);
+    }
+
+    memcpy(p, buf, buflen);
+    p[buflen] = '\0';
+    assert(NULL != value_pp);
+    *value_pp = p;
+
+    return (0);
+}
+
+/**
+ * mpl_pack_bin_param_value_wstring()
+ **/
+int mpl_pack_bin_param_value_wstring(const void* param_value_p,
+                                     uint8_t *buf,
+                                     size_t buflen,
+                                     const mpl_param_descr2_t *descr_p)
+{
+    const wchar_t *ws_p = param_value_p;
+    size_t len;
+    size_t i;
+
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    assert(NULL != param_value_p);
+
+    len = wcslen(ws_p);
+    if ((NULL != buf) && (buflen >= (len * sizeof(uint32_t))))
+    {
+        for (i = 0; i < len; i++)
+            bin_put_le(buf + (i * sizeof(uint32_t)),
+                       (uint32_t)ws_p[i],
+                       sizeof(uint32_t));
+    }
+    return (int)(len * sizeof(uint32_t));
+}
+
+/**
+ * mpl_unpack_bin_param_value_wstring()
+ **/
+int mpl_unpack_bin_param_value_wstring(const uint8_t *buf,
+                                       size_t buflen,
+                                       void **value_pp,
+                                       const mpl_param_descr2_t *descr_p)
+{
+    wchar_t *p;
+    size_t len;
+    size_t i;
+    uint32_t c;
+    const int *max_p = descr_p->max_p;
+    const int *min_p = descr_p->min_p;
+
+    if ((buflen % sizeof(uint32_t)) != 0)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack wstring failed on length check: %zu\n",
+                             buflen));/*lint !e557 %zu is C99 */
+        set_errno(E_MPL_FAILED_OPERATION);
+        return (-1);
+    }
+    len = buflen / sizeof(uint32_t);
+
+    if ((max_p != NULL) &&
+        ((int)len > *max_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack wstring failed on max length check: %zu > %d\n",
+                             len, *max_p));/*lint !e557 %zu is C99 */
+        set_errno(E_MPL_FAILED_OPERATION);
+        return (-1);
+    }
+
+    if ((min_p != NULL) &&
+        ((int)len < *min_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack wstring failed on min length check: %zu < %d\n",
+                             len, *min_p));/*lint !e557 %zu is C99 */
+        set_errno(E_MPL_FAILED_OPERATION);
+        return (-1);
+    }
+
+    p = malloc((len + 1) * sizeof(wchar_t));
+    if (NULL == p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return (-1);
+    }
+
+    for (i = 0; i < len; i++)
+    {
+        c = (uint32_t)bin_get_le(buf + (i * sizeof(uint32_t)), sizeof(uint32_t));
+        if (c == 0)
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("Unpack wstring failed: embedded zero\n"));
+            set_errno(E_MPL_FAILED_OPERATION);
+            free(p);
+            return (-1);
+        }
+        p[i] = (wchar_t)c;
+    }
+    p[len] = 0;
+
+    assert(NULL != value_pp);
+    *value_pp = p;
+
+    return (0);
+}
+
+#define DEFINE_MPL_BIN_PARAM_VALUE_ARRAY(array_name, array_type, elem_type) \
+    int mpl_pack_bin_param_value_##array_name(const void* param_value_p, \
+                                              uint8_t *buf,             \
+                                              size_t buflen,            \
+                                              const mpl_param_descr2_t *descr_p) \
+    {                                                                   \
+        const array_type *a_p = param_value_p;                          \
+        size_t len;                                                     \
+        size_t i;                                                       \
+                                                                        \
+        MPL_IDENTIFIER_NOT_USED(descr_p);                               \
+        assert(NULL != param_value_p);                                  \
+                                                                        \
+        len = a_p->len * sizeof(elem_type);                             \
+        if ((NULL != buf) && (buflen >= len))                           \
+        {                                                               \
+            for (i = 0; i < (size_t)a_p->len; i++)                      \
+                bin_put_le(buf + (i * sizeof(elem_type)),               \
+                           a_p->arr_p[i],                               \
+                           sizeof(elem_type));                          \
+        }                                                               \
+        return (int)len;                                                \
+    }                                                                   \
+                                                                        \
+    int mpl_unpack_bin_param_value_##array_name(const uint8_t *buf,     \
+                                                size_t buflen,          \
+                                                void **value_pp,        \
+                                                const mpl_param_descr2_t *descr_p) \
+    {                                                                   \
+        array_type *a_p;                                                \
+        size_t len;                                                     \
+        size_t i;                                                       \
+        const int *max_p = descr_p->max_p;                              \
+        const int *min_p = descr_p->min_p;                              \
+                                                                        \
+        if ((buflen % sizeof(elem_type)) != 0)                          \
+        {                                                               \
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,                 \
+                                ("Unpack " #array_name " failed on length check: %zu\n", \
+                                 buflen));/*lint !e557 %zu is C99 */    \
+            set_errno(E_MPL_FAILED_OPERATION);                          \
+            return (-1);                                                \
+        }                                                               \
+        len = buflen / sizeof(elem_type);                               \
+                                                                        \
+        if ((max_p != NULL) &&                                          \
+            ((int)len > *max_p))                                        \
+        {                                                               \
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,                 \
+                                ("Unpack " #array_name " failed on max length check: %zu > %d\n", \
+                                 len, *max_p));/*lint !e557 %zu is C99 */ \
+            set_errno(E_MPL_FAILED_OPERATION);                          \
+            return (-1);                                                \
+        }                                                               \
+                                                                        \
+        if ((min_p != NULL) &&                                          \
+            ((int)len < *min_p))                                        \
+        {                                                               \
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,                 \
+                                ("Unpack " #array_name " failed on min length check: %zu < %d\n", \
+                                 len, *min_p));/*lint !e557 %zu is C99 */ \
+            set_errno(E_MPL_FAILED_OPERATION);                          \
+            return (-1);                                                \
+        }                                                               \
+                                                                        \
+        a_p = malloc(sizeof(array_type));                               \
+        if (NULL == a_p)                                                \
+        {                                                               \
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,         \
+                                ("Failed allocating memory\n"));        \
+            set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);                  \
+            return (-1);                                                \
+        }                                                               \
+                                                                        \
+        a_p->arr_p = malloc(len * sizeof(elem_type));                   \
+        if ((NULL == a_p->arr_p) && (len > 0))                          \
+        {                                                               \
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,         \
+                                ("Failed allocating memory\n"));        \
+            set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);                  \
+            free(a_p);                                                  \
+            return (-1);                                                \
+        }                                                               \
+                                                                        \
+        for (i = 0; i < len; i++)                                       \
+            a_p->arr_p[i] = (elem_type)bin_get_le(buf + (i * sizeof(elem_type)), \
+                                                  sizeof(elem_type));   \
+        a_p->len = len;                                                 \
+                                                                        \
+        assert(NULL != value_pp);                                       \
+        *value_pp = a_p;                                                \
+                                                                        \
+        return (0);                                                     \
+    }
+
+DEFINE_MPL_BIN_PARAM_VALUE_ARRAY(uint8_array, mpl_uint8_array_t, uint8_t)
+DEFINE_MPL_BIN_PARAM_VALUE_ARRAY(uint16_array, mpl_uint16_array_t, uint16_t)
+DEFINE_MPL_BIN_PARAM_VALUE_ARRAY(uint32_array, mpl_uint32_array_t, uint32_t)
+
+/**
+ * mpl_pack_bin_param_value_string_tuple()
+ *
+ * varint(keylen) key varint(valuelen + 1 or 0 if no value) value
+ **/
+int mpl_pack_bin_param_value_string_tuple(const void* param_value_p,
+                                          uint8_t *buf,
+                                          size_t buflen,
+                                          const mpl_param_descr2_t *descr_p)
+{
+    const mpl_string_tuple_t *st_p = param_value_p;
+    size_t len;
+    size_t value_len = 0;
+
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    assert(NULL != param_value_p);
+    assert(NULL != st_p->key_p);
+
+    len = bin_put_string(NULL, 0, 0, st_p->key_p);
+    if (NULL != st_p->value_p)
+        value_len = strlen(st_p->value_p);
+    len += bin_put_varint(NULL, 0, 0, (NULL != st_p->value_p) ? value_len + 1 : 0);
+    len += value_len;
+
+    if ((NULL != buf) && (buflen >= len))
+    {
+        size_t pos;
+        pos = bin_put_string(buf, buflen, 0, st_p->key_p);
+        pos += bin_put_varint(buf, buflen, pos,
+                              (NULL != st_p->value_p) ? value_len + 1 : 0);
+        if (value_len > 0)
+            memcpy(buf + pos, st_p->value_p, value_len);
+    }
+    return (int)len;
+}
+
+/**
+ * mpl_unpack_bin_param_value_string_tuple()
+ **/
+int mpl_unpack_bin_param_value_string_tuple(const uint8_t *buf,
+                                            size_t buflen,
+                                            void **value_pp,
+                                            const mpl_param_descr2_t *descr_p)
+{
+    mpl_string_tuple_t *st_p;
+    size_t pos = 0;
+    uint64_t value_len;
+    int slen;
+    const int *max_p = descr_p->max_p;
+    const int *min_p = descr_p->min_p;
+
+    st_p = calloc(1, sizeof(mpl_string_tuple_t));
+    if (NULL == st_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return (-1);
+    }
+
+    slen = bin_get_string(buf, buflen, &pos, &st_p->key_p);
+    if (slen < 0)
+        goto error_return;
+
+    if (((max_p != NULL) && (slen > *max_p)) ||
+        ((min_p != NULL) && (slen < *min_p)))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack string_tuple key failed on "
+                             "length check: %d\n", slen));
+        set_errno(E_MPL_FAILED_OPERATION);
+        goto error_return;
+    }
+
+    if (bin_get_varint(buf, buflen, &pos, &value_len) < 0)
+        goto error_return;
+
+    if (value_len == 0)
+    {
+        /* No value */
+        if (pos != buflen)
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("Unpack string_tuple failed on length check\n"));
+            set_errno(E_MPL_FAILED_OPERATION);
+            goto error_return;
+        }
+        *value_pp = st_p;
+        return (0);
+    }
+
+    value_len--;
+    if ((value_len != (buflen - pos)) ||
+        (memchr(buf + pos, '\0', value_len) != NULL))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack string_tuple value failed on format check\n"));
+        set_errno(E_MPL_FAILED_OPERATION);
+        goto error_return;
+    }
+
+    if (((max_p != NULL) && ((int)value_len > *max_p)) ||
+        ((min_p != NULL) && ((int)value_len < *min_p)))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack string_tuple value failed on "
+                             "length check: %d\n", (int)value_len));
+        set_errno(E_MPL_FAILED_OPERATION);
+        goto error_return;
+    }
+
+    st_p->value_p = malloc(value_len + 1);
+    if (NULL == st_p->value_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        goto error_return;
+    }
+    memcpy(st_p->value_p, buf + pos, value_len);
+    st_p->value_p[value_len] = '\0';
+
+    assert(NULL != value_pp);
+    *value_pp = st_p;
+    return (0);
+
+error_return:
+    mpl_free_param_value_string_tuple(st_p);
+    return (-1);
+}
+
+/**
+ * mpl_pack_bin_param_value_int_tuple()
+ **/
+int mpl_pack_bin_param_value_int_tuple(const void* param_value_p,
+                                       uint8_t *buf,
+                                       size_t buflen,
+                                       const mpl_param_descr2_t *descr_p)
+{
+    const mpl_int_tuple_t *it_p = param_value_p;
+
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    assert(NULL != param_value_p);
+
+    if ((NULL != buf) && (buflen >= 8))
+    {
+        bin_put_le(buf, (uint64_t)it_p->key, 4);
+        bin_put_le(buf + 4, (uint64_t)it_p->value, 4);
+    }
+    return 8;
+}
+
+/**
+ * mpl_unpack_bin_param_value_int_tuple()
+ **/
+int mpl_unpack_bin_param_value_int_tuple(const uint8_t *buf,
+                                         size_t buflen,
+                                         void **value_pp,
+                                         const mpl_param_descr2_t *descr_p)
+{
+    mpl_int_tuple_t *it_p;
+    int key;
+    int value;
+    const int *max_p = descr_p->max_p;
+    const int *min_p = descr_p->min_p;
+
+    if (buflen != 8)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack int_tuple failed on length check: %zu\n",
+                             buflen));/*lint !e557 %zu is C99 */
+        set_errno(E_MPL_FAILED_OPERATION);
+        return (-1);
+    }
+
+    key = (int)bin_sign_extend(bin_get_le(buf, 4), 4);
+    value = (int)bin_sign_extend(bin_get_le(buf + 4, 4), 4);
+
+    if (((max_p != NULL) && ((key > *max_p) || (value > *max_p))) ||
+        ((min_p != NULL) && ((key < *min_p) || (value < *min_p))))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack int_tuple failed on min/max check: %d:%d\n",
+                             key, value));
+        set_errno(E_MPL_FAILED_OPERATION);
+        return (-1);
+    }
+
+    it_p = malloc(sizeof(mpl_int_tuple_t));
+    if (NULL == it_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return (-1);
+    }
+    it_p->key = key;
+    it_p->value = value;
+
+    assert(NULL != value_pp);
+    *value_pp = it_p;
+    return (0);
+}
+
+/**
+ * mpl_pack_bin_param_value_strint_tuple()
+ **/
+int mpl_pack_bin_param_value_strint_tuple(const void* param_value_p,
+                                          uint8_t *buf,
+                                          size_t buflen,
+                                          const mpl_param_descr2_t *descr_p)
+{
+    const mpl_strint_tuple_t *t_p = param_value_p;
+    size_t len;
+
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    assert(NULL != param_value_p);
+    assert(NULL != t_p->key_p);
+
+    len = bin_put_string(NULL, 0, 0, t_p->key_p) + 4;
+    if ((NULL != buf) && (buflen >= len))
+    {
+        size_t pos = bin_put_string(buf, buflen, 0, t_p->key_p);
+        bin_put_le(buf + pos, (uint64_t)t_p->value, 4);
+    }
+    return (int)len;
+}
+
+/**
+ * mpl_unpack_bin_param_value_strint_tuple()
+ **/
+int mpl_unpack_bin_param_value_strint_tuple(const uint8_t *buf,
+                                            size_t buflen,
+                                            void **value_pp,
+                                            const mpl_param_descr2_t *descr_p)
+{
+    mpl_strint_tuple_t *t_p;
+    size_t pos = 0;
+    const int *max_p = descr_p->max_p;
+    const int *min_p = descr_p->min_p;
+
+    t_p = calloc(1, sizeof(mpl_strint_tuple_t));
+    if (NULL == t_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return (-1);
+    }
+
+    if (bin_get_string(buf, buflen, &pos, &t_p->key_p) < 0)
+        goto error_return;
+
+    if ((buflen - pos) != 4)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack strint_tuple failed on length check\n"));
+        set_errno(E_MPL_FAILED_OPERATION);
+        goto error_return;
+    }
+    t_p->value = (int)bin_sign_extend(bin_get_le(buf + pos, 4), 4);
+
+    if (((max_p != NULL) && (t_p->value > *max_p)) ||
+        ((min_p != NULL) && (t_p->value < *min_p)))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack strint_tuple value failed on "
+                             "min/max check: %d\n", t_p->value));
+        set_errno(E_MPL_FAILED_OPERATION);
+        goto error_return;
+    }
+
+    assert(NULL != value_pp);
+    *value_pp = t_p;
+    return (0);
+
+error_return:
+    mpl_free_param_value_strint_tuple(t_p);
+    return (-1);
+}
+
+/**
+ * mpl_pack_bin_param_value_struint8_tuple()
+ **/
+int mpl_pack_bin_param_value_struint8_tuple(const void* param_value_p,
+                                            uint8_t *buf,
+                                            size_t buflen,
+                                            const mpl_param_descr2_t *descr_p)
+{
+    const mpl_struint8_tuple_t *t_p = param_value_p;
+    size_t len;
+
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    assert(NULL != param_value_p);
+    assert(NULL != t_p->key_p);
+
+    len = bin_put_string(NULL, 0, 0, t_p->key_p) + 1;
+    if ((NULL != buf) && (buflen >= len))
+    {
+        size_t pos = bin_put_string(buf, buflen, 0, t_p->key_p);
+        buf[pos] = t_p->value;
+    }
+    return (int)len;
+}
+
+/**
+ * mpl_unpack_bin_param_value_struint8_tuple()
+ **/
+int mpl_unpack_bin_param_value_struint8_tuple(const uint8_t *buf,
+                                              size_t buflen,
+                                              void **value_pp,
+                                              const mpl_param_descr2_t *descr_p)
+{
+    mpl_struint8_tuple_t *t_p;
+    size_t pos = 0;
+    const uint8_t *max_p = descr_p->max_p;
+    const uint8_t *min_p = descr_p->min_p;
+
+    t_p = calloc(1, sizeof(mpl_struint8_tuple_t));
+    if (NULL == t_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return (-1);
+    }
+
+    if (bin_get_string(buf, buflen, &pos, &t_p->key_p) < 0)
+        goto error_return;
+
+    if ((buflen - pos) != 1)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack struint8_tuple failed on length check\n"));
+        set_errno(E_MPL_FAILED_OPERATION);
+        goto error_return;
+    }
+    t_p->value = buf[pos];
+
+    if (((max_p != NULL) && (t_p->value > *max_p)) ||
+        ((min_p != NULL) && (t_p->value < *min_p)))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack struint8_tuple value failed on "
+                             "min/max check: %d\n", t_p->value));
+        set_errno(E_MPL_FAILED_OPERATION);
+        goto error_return;
+    }
+
+    assert(NULL != value_pp);
+    *value_pp = t_p;
+    return (0);
+
+error_return:
+    mpl_free_param_value_struint8_tuple(t_p);
+    return (-1);
+}
+
+/**
+ * mpl_pack_bin_param_value_bag()
+ **/
+int mpl_pack_bin_param_value_bag(const void* param_value_p,
+                                 uint8_t *buf,
+                                 size_t buflen,
+                                 const mpl_param_descr2_t *descr_p)
+{
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    assert(NULL != param_value_p);
+
+    return param_list_pack_bin_body((mpl_list_t*)param_value_p, buf, buflen);
+}
+
+/**
+ * mpl_unpack_bin_param_value_bag()
+ **/
+int mpl_unpack_bin_param_value_bag(const uint8_t *buf,
+                                   size_t buflen,
+                                   void **value_pp,
+                                   const mpl_param_descr2_t *descr_p)
+{
+    mpl_list_t *l_p;
+    bool err = false;
+    const int *max_p = descr_p->max_p;
+    const int *min_p = descr_p->min_p;
+
+    l_p = param_list_unpack_bin_body(buf, buflen, &err);
+    if (err)
+        return (-1);
+
+    if ((max_p != NULL) &&
+        ((int)mpl_list_len(l_p) > *max_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack list value failed on "
+                             "max check: %zu > %d\n", mpl_list_len(l_p),
+                             *max_p));/*lint !e557 %zu is C99 */
+        set_errno(E_MPL_FAILED_OPERATION);
+        mpl_param_list_destroy(&l_p);
+        return (-1);
+    }
+
+    if ((min_p != NULL) &&
+        ((int)mpl_list_len(l_p) < *min_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack list value failed on "
+                             "min check: %zu < %d\n", mpl_list_len(l_p),
+                             *min_p));/*lint !e557 %zu is C99 */
+        set_errno(E_MPL_FAILED_OPERATION);
+        mpl_param_list_destroy(&l_p);
+        return (-1);
+    }
+
+    assert(NULL != value_pp);
+    *value_pp = l_p;
+    return (0);
+}
+
+/**
+ * mpl_pack_bin_param_value_addr()
+ **/
+int mpl_pack_bin_param_value_addr(const void* param_value_p,
+                                  uint8_t *buf,
+                                  size_t buflen,
+                                  const mpl_param_descr2_t *descr_p)
+{
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+    assert(NULL != param_value_p);
+
+    if ((NULL != buf) && (buflen >= 8))
+        bin_put_le(buf, (uint64_t)(uintptr_t)*(void**)param_value_p, 8);
+    return 8;
+}
+
+/**
+ * mpl_unpack_bin_param_value_addr()
+ **/
+int mpl_unpack_bin_param_value_addr(const uint8_t *buf,
+                                    size_t buflen,
+                                    void **value_pp,
+                                    const mpl_param_descr2_t *descr_p)
+{
+    void** p;
+
+    MPL_IDENTIFIER_NOT_USED(descr_p);
+
+    if (buflen != 8)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unpack addr failed on length check: %zu\n",
+                             buflen));/*lint !e557 %zu is C99 */
+        set_errno(E_MPL_FAILED_OPERATION);
+        return (-1);
+    }
+
+    p = malloc(sizeof(void*));
+    if (NULL == p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return (-1);
+    }
+
+    *p = (void*)(uintptr_t)bin_get_le(buf, 8);
+    assert(NULL != value_pp);
+    *value_pp = p;
+    return (0);
+}
+
+
+/**
+ * mpl_get_args()
+ **/
+int mpl_get_args(mpl_arg_t *args,
+                 int args_len,
+                 char *buf,
+                 char equal,
+                 char delimiter,
+                 char escape)
+{
+    assert(NULL != args);
+    return mpl_get_args_2(&args,
+                          args_len,
+                          buf,
+                          equal,
+                          delimiter,
+                          escape);
+}
+
+int mpl_get_args_2(mpl_arg_t **args_pp,
+                   int args_len,
+                   char *buf,
+                   char equal,
+                   char delimiter,
+                   char escape)
+{
+    char *p;
+    char *kp;
+    char *vp;
+    char *buf_end;
+    int i = 0;
+    mpl_arg_t *args_p = NULL;
+    int externally_allocated = 0;
+
+    assert(args_pp);
+    if (args_len == 0) {
+        args_p = heap_calloc(MPL_ARGS_INITIAL_LEN, sizeof(mpl_arg_t));
+        if (NULL == args_p)
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                                ("failed allocating memory\n"));
+            set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+            return -1;
+        }
+        args_len = MPL_ARGS_INITIAL_LEN;
+    }
+    else {
+        assert(*args_pp != NULL);
+        args_p = *args_pp;
+        externally_allocated = 1;
+    }
+
+    p = mpl_trimstring(buf, escape);
+
+    buf_end = p + strlen(p);
+
+    while ((p < buf_end) && (i < args_len))
+    {
+        char *mid;
+        char *end;
+        char end_copy;
+
+        end = strchr_escape( p, delimiter, escape);
+
+        if (NULL == end)
+        {
+            end = p + strlen(p);
+            end_copy = *end;
+        }
+        else
+        {
+            end_copy = *end;
+            *end = '\0';
+        }
+
+        mid = strchr_escape( p, equal, escape );
+        if (NULL != mid)
+        {
+            *mid = '\0';
+            kp = mpl_trimstring(p, escape);
+            args_p[i].key_p = kp;
+            vp = mpl_trimstring(mid + 1, escape);
+            if (*vp == '{')
+            {
+                *end = end_copy;
+                end = get_matching_close_bracket('{', '}', vp, escape);
+                if (NULL == end)
+                    end = vp + strlen(vp);
+                else
+                    end++;
+                *end = '\0';
+            }
+            args_p[i].value_p = vp;
+        }
+        else
+        {
+            args_p[i].key_p = mpl_trimstring(p, escape);
+            args_p[i].value_p = NULL;
+        }
+
+        while (((end+1) < buf_end) &&
+               *(end+1) == delimiter)
+            end++;
+
+        p = end + 1;
+        i++;
+
+        /* Grow geometrically, so that the total copying stays linear */
+        if ((i >= args_len) && (p < buf_end) && !externally_allocated) {
+            mpl_arg_t *new_args_p;
+
+            new_args_p = heap_realloc(args_p, sizeof(mpl_arg_t)*(2*args_len));
+            if (NULL == new_args_p)
+            {
+                MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                                    ("failed allocating memory\n"));
+                set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+                free(args_p);
+                return -1;
+            }
+            args_p = new_args_p;
+            memset(args_p+args_len,0,sizeof(mpl_arg_t)*args_len);
+            args_len *= 2;
+        }
+    }
+
+
+    if (p < buf_end) {
+        if (!externally_allocated)
+            free(args_p);
+        return -1;
+    }
+
+    if (!externally_allocated)
+        *args_pp = args_p;
+
+    return i;
+}
+
+/**
+ * mpl_add_param_to_list_n_tag - add parameter to param list
+ *                               with value length check
+ *
+ */
+int mpl_add_param_to_list_n_tag(mpl_list_t **param_list_pp,
+                                mpl_param_element_id_t param_id,
+                                int tag,
+                                const void *value_p,
+                                size_t len)
+{
+    mpl_param_element_t* param_elem_p;
+
+    /* Add msgtype to the parameter list */
+    param_elem_p = mpl_param_element_create_n_tag(param_id, tag, value_p, len);
+    if (NULL == param_elem_p)
+    {
+        return -1;
+    }
+
+    mpl_list_add(param_list_pp, &param_elem_p->list_entry);
+    return 0;
+}
+
+/**
+ * mpl_add_param_to_list_tag - add parameter to param list
+ *
+ */
+int mpl_add_param_to_list_tag(mpl_list_t **param_list_pp,
+                              mpl_param_element_id_t param_id,
+                              int tag,
+                              const void *value_p)
+{
+    mpl_param_element_t* param_elem_p;
+
+    /* Add msgtype to the parameter list */
+    param_elem_p = mpl_param_element_create_tag(param_id, tag, value_p);
+    if (NULL == param_elem_p)
+    {
+        return -1;
+    }
+
+    mpl_list_add(param_list_pp, &param_elem_p->list_entry);
+    return 0;
+}
+
+/**
+ * mpl_param_list_add_int_tag - add integer parameter to param list
+ *
+ */
+int mpl_param_list_add_int_tag(mpl_list_t **param_list_pp,
+                               mpl_param_element_id_t param_id,
+                               int tag,
+                               int value)
+{
+    return mpl_add_param_to_list_n_tag(param_list_pp,
+                                       param_id,
+                                       tag,
+                                       &value,
+                                       sizeof(value));
+}
+
+/**
+ * mpl_param_list_add_uint8_tag - add bool8 parameter to param list
+ *
+ */
+int mpl_param_list_add_uint8_tag(mpl_list_t **param_list_pp,
+                                 mpl_param_element_id_t param_id,
+                                 int tag,
+                                 uint8_t value)
+{
+    return mpl_add_param_to_list_n_tag(param_list_pp,
+                                       param_id,
+                                       tag,
+                                       &value,
+                                       sizeof(value));
+}
+
+/**
+ * mpl_param_list_add_sint8_tag - add sint8 parameter to param list
+ *
+ */
+int mpl_param_list_add_sint8_tag(mpl_list_t **param_list_pp,
+                                 mpl_param_element_id_t param_id,
+                                 int tag,
+                                 sint8_t value)
+{
+    return mpl_add_param_to_list_n_tag(param_list_pp,
+                                       param_id,
+                                       tag,
+                                       &value,
+                                       sizeof(value));
+}
+
+/**
+ * mpl_param_list_add_uint16_tag - add bool8 parameter to param list
+ *
+ */
+int mpl_param_list_add_uint16_tag(mpl_list_t **param_list_pp,
+                                  mpl_param_element_id_t param_id,
+                                  int tag,
+                                  uint16_t value)
+{
+    return mpl_add_param_to_list_n_tag(param_list_pp,
+                                       param_id,
+                                       tag,
+                                       &value,
+                                       sizeof(value));
+}
+
+/**
+ * mpl_param_list_add_sint16_tag - add sint16 parameter to param list
+ *
+ */
+int mpl_param_list_add_sint16_tag(mpl_list_t **param_list_pp,
+                                  mpl_param_element_id_t param_id,
+                                  int tag,
+                                  sint16_t value)
+{
+    return mpl_add_param_to_list_n_tag(param_list_pp,
+                                       param_id,
+                                       tag,
+                                       &value,
+                                       sizeof(value));
+}
+
+/**
+ * mpl_param_list_add_uint32_tag - add uint32 parameter to param list
+ *
+ */
+int mpl_param_list_add_uint32_tag(mpl_list_t **param_list_pp,
+                                  mpl_param_element_id_t param_id,
+                                  int tag,
+                                  uint32_t value)
+{
+    return mpl_add_param_to_list_n_tag(param_list_pp,
+                                       param_id,
+                                       tag,
+                                       &value,
+                                       sizeof(value));
+}
+
+/**
+ * mpl_param_list_add_uint64_tag - add uint64 parameter to param list
+ *
+ */
+int mpl_param_list_add_uint64_tag(mpl_list_t **param_list_pp,
+                                  mpl_param_element_id_t param_id,
+                                  int tag,
+                                  uint64_t value)
+{
+    return mpl_add_param_to_list_n_tag(param_list_pp,
+                                       param_id,
+                                       tag,
+                                       &value,
+                                       sizeof(value));
+}
+
+/**
+ * mpl_param_list_add_sint32_tag - add sint32 parameter to param list
+ *
+ */
+int mpl_param_list_add_sint32_tag(mpl_list_t **param_list_pp,
+                                  mpl_param_element_id_t param_id,
+                                  int tag,
+                                  sint32_t value)
+{
+    return mpl_add_param_to_list_n_tag(param_list_pp,
+                                       param_id,
+                                       tag,
+                                       &value,
+                                       sizeof(value));
+}
+
+/**
+ * mpl_param_list_add_sint64_tag - add sint64 parameter to param list
+ *
+ */
+int mpl_param_list_add_sint64_tag(mpl_list_t **param_list_pp,
+                                  mpl_param_element_id_t param_id,
+                                  int tag,
+                                  int64_t value)
+{
+    return mpl_add_param_to_list_n_tag(param_list_pp,
+                                       param_id,
+                                       tag,
+                                       &value,
+                                       sizeof(value));
+}
+
+/**
+ * mpl_param_list_add_bool8_tag - add bool8 parameter to param list
+ *
+ */
+int mpl_param_list_add_bool8_tag(mpl_list_t **param_list_pp,
+                                 mpl_param_element_id_t param_id,
+                                 int tag,
+                                 uint8_t value)
+{
+    return mpl_add_param_to_list_n_tag(param_list_pp,
+                                       param_id,
+                                       tag,
+                                       &value,
+                                       sizeof(value));
+}
+
+/**
+ * mpl_param_list_add_bool_tag - add bool8 parameter to param list
+ *
+ */
+int mpl_param_list_add_bool_tag(mpl_list_t **param_list_pp,
+                                mpl_param_element_id_t param_id,
+                                int tag,
+                                bool value)
+{
+    return mpl_add_param_to_list_n_tag(param_list_pp,
+                                       param_id,
+                                       tag,
+                                       &value,
+                                       sizeof(value));
+}
+
+/**
+ * mpl_param_list_add_enum_tag - add enum parameter to param list
+ *
+ */
+int mpl_param_list_add_enum_tag(mpl_list_t **param_list_pp,
+                                mpl_param_element_id_t param_id,
+                                int tag,
+                                int64_t value)
+{
+    return mpl_add_param_to_list_n_tag(param_list_pp,
+                                       param_id,
+                                       tag,
+                                       &value,
+                                       mpl_param_id_sizeof_param_value(param_id));
+}
+
+/**
+ * mpl_param_list_add_enum8_tag - add enum parameter to param list
+ *
+ */
+int mpl_param_list_add_enum8_tag(mpl_list_t **param_list_pp,
+                                 mpl_param_element_id_t param_id,
+                                 int tag,
+                                 uint8_t value)
+{
+    return mpl_add_param_to_list_n_tag(param_list_pp,
+                                       param_id,
+                                       tag,
+                                       &value,
+                                       sizeof(value));
+}
+
+/**
+ * mpl_param_list_add_enum16_tag - add enum parameter to param list
+ *
+ */
+int mpl_param_list_add_enum16_tag(mpl_list_t **param_list_pp,
+                                  mpl_param_element_id_t param_id,
+                                  int tag,
+                                  uint16_t value)
+{
+    return mpl_add_param_to_list_n_tag(param_list_pp,
+                                       param_id,
+                                       tag,
+                                       &value,
+                                       sizeof(value));
+}
+
+/**
+ * mpl_param_list_add_enum32_tag - add enum parameter to param list
+ *
+ */
+int mpl_param_list_add_enum32_tag(mpl_list_t **param_list_pp,
+                                  mpl_param_element_id_t param_id,
+                                  int tag,
+                                  uint32_t value)
+{
+    return mpl_add_param_to_list_n_tag(param_list_pp,
+                                       param_id,
+                                       tag,
+                                       &value,
+                                       sizeof(value));
+}
+
+/**
+ * mpl_param_list_add_signed_enum8_tag - add enum parameter to param list
+ *
+ */
+int mpl_param_list_add_signed_enum8_tag(mpl_list_t **param_list_pp,
+                                        mpl_param_element_id_t param_id,
+                                        int tag,
+                                        sint8_t value)
+{
+    return mpl_add_param_to_list_n_tag(param_list_pp,
+                                       param_id,
+                                       tag,
+                                       &value,
+                                       sizeof(value));
+}
+
+/**
+ * mpl_param_list_add_signed_enum16_tag - add enum parameter to param list
+ *
+ */
+int mpl_param_list_add_signed_enum16_tag(mpl_list_t **param_list_pp,
+                                         mpl_param_element_id_t param_id,
+                                         int tag,
+                                         sint16_t value)
+{
+    return mpl_add_param_to_list_n_tag(param_list_pp,
+                                       param_id,
+                                       tag,
+                                       &value,
+                                       sizeof(value));
+}
+
+/**
+ * mpl_param_list_add_signed_enum32_tag - add enum parameter to param list
+ *
+ */
+int mpl_param_list_add_signed_enum32_tag(mpl_list_t **param_list_pp,
+                                         mpl_param_element_id_t param_id,
+                                         int tag,
+                                         sint32_t value)
+{
+    return mpl_add_param_to_list_n_tag(param_list_pp,
+                                       param_id,
+                                       tag,
+                                       &value,
+                                       sizeof(value));
+}
+
+/**
+ * mpl_remove_from_blacklist - remove parameter id from blacklist
+ *
+ */
+int mpl_remove_from_blacklist(mpl_blacklist_t *blacklist_p,
+                              mpl_param_element_id_t param_id)
+{
+    mpl_param_element_t *elem_p;
+
+    elem_p = mpl_param_list_find(param_id, *blacklist_p);
+
+    if (elem_p == NULL)
+        return -1;
+
+    (void) mpl_list_remove(blacklist_p, &elem_p->list_entry);
+
+    mpl_param_element_destroy(elem_p);
+
+    return 0;
+}
+
+/**
+ * mpl_trimstring()
+ **/
+char *mpl_trimstring(char *s, char escape)
+{
+    char *p = s;
+    char *e;
+
+    // Trim start
+    while ((*s != '\0') && isspace((unsigned char)s[0]))
+        s++;
+
+    // Trim end, taking escape into account
+    p = s + (strlen(s) - 1);
+
+    while ((p > s) && isspace(*p)) {
+        // did we find an escaped character?
+        e = p;
+        while (e && (e > s) && (*(e-1) == escape))
+            e--;
+
+        // An odd number of escapes in a row? (then it is escaped)
+        if (1 == ((p - e) % 2))
+            break;
+
+        *p = '\0';
+        p--;
+    }
+
+    return s;
+}
+
+/**
+ * mpl_get_errno
+ *
+ */
+int mpl_get_errno()
+{
+    mpl_pc_t* pc_p = get_pc();
+    if (pc_p)
+    {
+        return pc_p->error;
+    }
+    else
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Could not find process context\n"));
+        return -1;
+    }
+}
+
+
+/**
+ * mpl_compare_param_lists
+ *
+ */
+int mpl_compare_param_lists(mpl_list_t *list1_p, mpl_list_t *list2_p)
+{
+    mpl_param_list_index_t *index1_p = NULL;
+    mpl_param_list_index_t *index2_p = NULL;
+    int res;
+
+    if ((NULL == list1_p) && (NULL != list2_p)) {
+        return -1;
+    }
+
+    if ((NULL == list2_p) && (NULL != list1_p)) {
+        return -1;
+    }
+
+    /* Index long lists, the linear search makes the compare quadratic */
+    if ((mpl_list_len(list1_p) >= MPL_LIST_INDEX_COMPARE_MIN_LEN) &&
+        (mpl_list_len(list2_p) >= MPL_LIST_INDEX_COMPARE_MIN_LEN)) {
+        index1_p = list_index_create(&list1_p, false);
+        index2_p = list_index_create(&list2_p, false);
+    }
+
+    res = param_list_compare_one_way(list1_p, list2_p, index2_p);
+    if (0 == res)
+        res = param_list_compare_one_way(list2_p, list1_p, index1_p);
+
+    mpl_param_list_index_destroy(index1_p);
+    mpl_param_list_index_destroy(index2_p);
+    return res;
+}
+
+int mpl_convert_int(const char* value_str, int *value_p)
+{
+    return convert_int(value_str, value_p);
+}
+
+
+/**
+ * mpl_set_errno
+ *
+ */
+void mpl_set_errno(int error_value)
+{
+    set_errno(error_value);
+}
+
+/****************************************************************************
+ *
+ * Private Functions
+ *
+ ****************************************************************************/
+
+
+static void *allocate_and_copy_max(mpl_type_t mpl_type, uint64_t max)
+{
+    void *ret_p = NULL;
+
+    switch (mpl_type) {
+        case mpl_type_int:
+        case mpl_type_string:
+        case mpl_type_wstring:
+        case mpl_type_uint8_array:
+        case mpl_type_uint16_array:
+        case mpl_type_uint32_array:
+        case mpl_type_string_tuple:
+        case mpl_type_int_tuple:
+        case mpl_type_strint_tuple:
+        case mpl_type_bag:
+            ret_p = heap_malloc(sizeof(int));
+            if (ret_p == NULL)
+                break;
+            *((int*)ret_p) = (int) max;
+            break;
+        case mpl_type_sint8:
+            ret_p = heap_malloc(sizeof(sint8_t));
+            if (ret_p == NULL)
+                break;
+            *((sint8_t*)ret_p) = (sint8_t) max;
+            break;
+        case mpl_type_sint16:
+            ret_p = heap_malloc(sizeof(sint16_t));
+            if (ret_p == NULL)
+                break;
+            *((sint16_t*)ret_p) = (sint16_t) max;
+            break;
+        case mpl_type_sint32:
+            ret_p = heap_malloc(sizeof(sint32_t));
+            if (ret_p == NULL)
+                break;
+            *((sint32_t*)ret_p) = (sint32_t) max;
+            break;
+        case mpl_type_sint64:
+            ret_p = heap_malloc(sizeof(int64_t));
+            if (ret_p == NULL)
+                break;
+            *((int64_t*)ret_p) = (int64_t) max;
+            break;
+        case mpl_type_uint8:
+        case mpl_type_struint8_tuple:
+            ret_p = heap_malloc(sizeof(uint8_t));
+            if (ret_p == NULL)
+                break;
+            *((uint8_t*)ret_p) = (uint8_t) max;
+            break;
+        case mpl_type_uint16:
+            ret_p = heap_malloc(sizeof(uint16_t));
+            if (ret_p == NULL)
+                break;
+            *((uint16_t*)ret_p) = (uint16_t) max;
+            break;
+        case mpl_type_uint32:
+            ret_p = heap_malloc(sizeof(uint32_t));
+            if (ret_p == NULL)
+                break;
+            *((uint32_t*)ret_p) = (uint32_t) max;
+            break;
+        case mpl_type_uint64:
+            ret_p = heap_malloc(sizeof(uint64_t));
+            if (ret_p == NULL)
+                break;
+            *((uint64_t*)ret_p) = max;
+            break;
+        default:
+            assert(0);
+    }
+
+    if (ret_p == NULL)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+    }
+    return ret_p;
+}
+
+
+static int upgrade_param_descr_set(mpl_param_descr_set_t *param_descr_p)
+{
+    int size;
+    int i;
+    int upgrade = 0;
+    mpl_param_descr_t *pd_p;
+    mpl_param_descr2_t *pd2_p;
+
+    size = PARAM_SET_SIZE(param_descr_p);
+    if (MPL_PARAMID_TO_PARAMSET(param_descr_p->paramid_enum_size) == param_descr_p->param_set_id) {
+        /* the enum size indicates that this is an old
+           parameter set and must be re-calculated */
+        int base = MPL_PARAM_SET_ID_TO_PARAMID_BASE(param_descr_p->param_set_id);
+        size = param_descr_p->paramid_enum_size - 1 - base;
+        param_descr_p->paramid_enum_size = size + 1;
+    }
+
+    for (i = 0; i < size; i++) {
+        pd_p = (mpl_param_descr_t *) &param_descr_p->array[i];
+        if ((pd_p->max_p != NULL) || (pd_p->stringarr != NULL)) {
+            upgrade = 1;
+            break;
+        }
+    }
+
+    if (!upgrade)
+        return 0;
+
+    param_descr_p->array2 = heap_calloc(size, sizeof(mpl_param_descr2_t));
+    if (param_descr_p->array2 == NULL) {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        return -1;
+    }
+    param_descr_p->is_dynamic_array2 = true;
+    for (i = 0; i < size; i++) {
+        int j;
+        /* Only positive values in old enums, and no holes */
+        enum {
+            dummy_small_min = 0,
+            dummy_small_max = 127
+        } dummy_small_enum;
+
+        enum {
+            dummy_medium_min = 0,
+            dummy_medium_max = 255
+        } dummy_medium_enum;
+
+        enum {
+            dummy_big_min = 0,
+            dummy_big_max = INT_MAX
+        } dummy_big_enum;
+
+        pd_p = (mpl_param_descr_t *) &param_descr_p->array[i];
+        pd2_p = (mpl_param_descr2_t *) &param_descr_p->array2[i];
+        if (pd_p->max_p != NULL) {
+            pd2_p = (mpl_param_descr2_t *) &param_descr_p->array2[i];
+            pd2_p->max_p = allocate_and_copy_max(pd_p->type, *pd_p->max_p);
+        }
+
+        if (pd_p->stringarr != NULL) {
+            mpl_enum_value_t *enum_values;
+            pd2_p->enum_values = heap_calloc(pd_p->stringarr_size, sizeof(mpl_enum_value_t));
+            if (pd2_p->enum_values == NULL) {
+                MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                                    ("Failed allocating memory\n"));
+                return -1;
+            }
+            enum_values = (mpl_enum_value_t *) pd2_p->enum_values;
+            for (j = 0; j < pd_p->stringarr_size; j++) {
+                enum_values[j].name_p = pd_p->stringarr[j];
+                enum_values[j].value = j;
+            }
+            pd2_p->enum_values_size = pd_p->stringarr_size;
+            if (j < 128)
+                pd2_p->enum_representation_bytesize =
+                    sizeof(dummy_small_enum);
+            else if (j < 256)
+                pd2_p->enum_representation_bytesize =
+                    sizeof(dummy_medium_enum);
+            else
+                pd2_p->enum_representation_bytesize =
+                    sizeof(dummy_big_enum);
+            pd2_p->enum_representation_signed = false;
+        }
+    } /*lint !e550 */
+
+    return 1;
+}
+
+
+/**
+ * get_pc
+ *
+ */
+static mpl_pc_t* get_pc(void)
+{
+    mpl_pc_t* pc_p;
+    mpl_thread_t pid;
+#ifndef MPL_HAVE_THREAD_LOCAL
+    mpl_list_t *elem_p;
+#endif
+    int i;
+
+#ifdef MPL_HAVE_THREAD_LOCAL
+    /* Fast path, no locking */
+    pc_p = mpl_thread_local_get(pc_key);
+    if (NULL != pc_p)
+        return pc_p;
+
+    pid = mpl_get_current_thread_id();
+#else
+    pid = mpl_get_current_thread_id();
+
+    (void)mpl_mutex_lock(mutex);
+    MPL_LIST_FOR_EACH(mpl_pc_list_p, elem_p)
+    {
+        pc_p = MPL_LIST_CONTAINER(elem_p, mpl_pc_t, list_entry);
+        if (pc_p->pid == pid)
+        {
+            (void)mpl_mutex_unlock(mutex);
+            goto found;
+        }
+    }
+    (void)mpl_mutex_unlock(mutex);
+#endif
+
+    pc_p = heap_malloc(sizeof(mpl_pc_t));
+    if (NULL == pc_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        return NULL;
+    }
+    memset(pc_p, 0, sizeof(mpl_pc_t));
+    for (i = 0; i < num_scratch_strings; i++) {
+        pc_p->scratch_string[i] = heap_malloc(initial_scratch_string_len);
+        if (pc_p->scratch_string[i] == NULL)
+        {
+            i--;
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                                ("Failed allocating memory\n"));
+            /* free previously allocated scratch strings */
+            for(;i>=0;i--)/*lint !e445 reuse of i is ok */
+                heap_free(pc_p->scratch_string[i]);
+            heap_free(pc_p);
+            return NULL;
+        }
+        pc_p->scratch_string_len[i] = initial_scratch_string_len;
+    }
+    pc_p->pid = pid;
+
+#ifdef MPL_HAVE_THREAD_LOCAL
+    if (mpl_thread_local_set(pc_key, pc_p) != 0)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Could not set thread local context\n"));
+        pc_free(pc_p);
+        return NULL;
+    }
+#endif
+
+    (void)mpl_mutex_lock(mutex);
+    mpl_list_add(&mpl_pc_list_p, &pc_p->list_entry);
+    (void)mpl_mutex_unlock(mutex);
 
-    return (0);
+#ifndef MPL_HAVE_THREAD_LOCAL
+found:
+#endif
+    return pc_p;
 }
 
 /**
- * mpl_copy_param_value_int_tuple()
- **/
-/* NOTE: Copy on a tuple means copy of the value part of the tuple */
-int
-    mpl_copy_param_value_int_tuple(void *to_value_p,
-                                   const void* from_value_p,
-                                   int size,
-                                   const mpl_param_descr2_t *descr_p)
+ * pc_free
+ *
+ */
+static void pc_free(mpl_pc_t* pc_p)
 {
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    if (size >= (int)sizeof(int))
-        *(int*)to_value_p = ((mpl_int_tuple_t*)from_value_p)->value;
+    int i;
 
-    return sizeof(int);
+    for (i = 0; i < num_scratch_strings; i++)
+        heap_free(pc_p->scratch_string[i]);
+    heap_free(pc_p);
 }
 
+#ifdef MPL_HAVE_THREAD_LOCAL
 /**
- * mpl_compare_param_value_int_tuple()
- **/
-int mpl_compare_param_value_int_tuple(const void *value1_p,
-                                      const void* value2_p,
-                                      const mpl_param_descr2_t *descr_p)
+ * pc_destructor
+ *
+ * Called at exit of a thread that has a context.
+ */
+static void pc_destructor(void *arg_p)
 {
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    return (memcmp(value1_p, value2_p, sizeof(mpl_int_tuple_t)) != 0);
-}
+    mpl_pc_t* pc_p = arg_p;
 
-/**
- * mpl_sizeof_param_value_int_tuple()
- **/
-size_t mpl_sizeof_param_value_int_tuple(const mpl_param_descr2_t *descr_p)
-{
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    return sizeof(mpl_int_tuple_t);
-}
+    (void)mpl_mutex_lock(mutex);
+    (void)mpl_list_remove(&mpl_pc_list_p, &pc_p->list_entry);
+    if (NULL != pc_p->arena_p)
+        (void)ARENAS_ACTIVE_ADD(-1);
+    (void)mpl_mutex_unlock(mutex);
 
+    pc_free(pc_p);
+}
+#endif
 
 /**
- * mpl_pack_param_value_strint_tuple()
- **/
-int mpl_pack_param_value_strint_tuple(const void* param_value_p,
-                                      char *buf,
-                                      size_t buflen,
-                                      const mpl_param_descr2_t *descr_p,
-                                      const mpl_pack_options_t *options_p)
+ * current_arena
+ *
+ * Returns the arena of the calling thread, or NULL.
+ *
+ */
+static mpl_arena_t *current_arena(void)
 {
-    const mpl_strint_tuple_t *t_p;
-    MPL_IDENTIFIER_NOT_USED(descr_p);
+    mpl_pc_t* pc_p;
 
-    assert(NULL != param_value_p);
+#ifdef MPL_HAVE_ATOMIC_INT
+    /* The thread's own update is always visible to itself, so a zero
+       count means the calling thread has no arena */
+    if (0 == mpl_atomic_load_int(&arenas_active))
+        return NULL;
+#endif
 
-    t_p = param_value_p;
-    assert(NULL != t_p->key_p);
+    pc_p = get_pc();
+    if (NULL == pc_p)
+        return NULL;
 
-    return snprintf_escape(options_p->message_delimiter, '\\',
-                           buf, buflen, "=%s:%d", t_p->key_p, t_p->value);
+    return pc_p->arena_p;
 }
 
-
-/**
- * mpl_unpack_param_value_strint_tuple()
- **/
-int
-    mpl_unpack_param_value_strint_tuple(const char* value_str, void **value_pp,
-                                        const mpl_param_descr2_t *descr_p,
-                                        const mpl_pack_options_t *options_p,
-                                        mpl_param_element_id_t unpack_context)
+static void *param_malloc(size_t size)
 {
-    mpl_strint_tuple_t *t_p;
-    char* p;
-    int slen;
-    char *temp_str;
-    int temp_string_allocated = 0;
-    const int *max_p = descr_p->max_p;
-    const int *min_p = descr_p->min_p;
-    MPL_IDENTIFIER_NOT_USED(unpack_context);
+    mpl_arena_t *arena_p = current_arena();
 
-    if (strchr(value_str, '\\')) {
-        temp_str = remove_escape(value_str, '\\');
-        if (temp_str == NULL) {
-            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                                ("Failed allocating memory\n"));
-            set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-            return (-1);
-        }
-        temp_string_allocated = 1;
-    }
-    else {
-        temp_str = (char*) value_str;
-    }
+    if (NULL != arena_p)
+        return mpl_arena_alloc(arena_p, size);
 
-    p = strchr(temp_str, ':');
-    if (NULL == p)
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack strint_tuple failed, no delimiter: %s\n",
-                             temp_str));
-        set_errno(E_MPL_FAILED_OPERATION);
-        if (temp_string_allocated)
-            free(temp_str);
-        return (-1);
-    }
+    return heap_malloc(size);
+}
 
-    t_p = malloc(sizeof(mpl_strint_tuple_t));
-    if (NULL == t_p)
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        if (temp_string_allocated)
-            free(temp_str);
-        return (-1);
-    }
+static void *param_calloc(size_t nmemb, size_t size)
+{
+    mpl_arena_t *arena_p = current_arena();
+    void *p;
 
-    slen = p - temp_str;
+    if (NULL == arena_p)
+        return heap_calloc(nmemb, size);
 
-    t_p->key_p = malloc(slen + 1);
-    if (NULL == t_p->key_p)
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        free(t_p);
-        if (temp_string_allocated)
-            free(temp_str);
-        return (-1);
-    }
-    strncpy(t_p->key_p, temp_str, slen);
-    t_p->key_p[slen] = 0;
+    if ((size != 0) && (nmemb > ((size_t)-1 / size)))
+        return NULL;
 
+    p = mpl_arena_alloc(arena_p, nmemb * size);
+    if (NULL != p)
+        memset(p, 0, nmemb * size);
+    return p;
+}
 
-    p++;
+static void *param_realloc(void *ptr, size_t size)
+{
+    mpl_arena_t *arena_p = current_arena();
 
-    if (convert_int(p, &t_p->value) < 0)
-    {
-        free(t_p->key_p);
-        free(t_p);
-        if (temp_string_allocated)
-            free(temp_str);
-        return (-1);
-    }
+    if ((NULL != arena_p) &&
+        ((NULL == ptr) || mpl_arena_contains(arena_p, ptr)))
+        return mpl_arena_realloc(arena_p, ptr, size);
 
-    if ((max_p != NULL) &&
-        (t_p->value > *max_p))
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack strint_tuple value failed on "
-                             "max check: %d > %d\n", t_p->value, *max_p));
-        set_errno(E_MPL_FAILED_OPERATION);
-        free(t_p->key_p);
-        free(t_p);
-        if (temp_string_allocated)
-            free(temp_str);
-        return (-1);
-    }
+    return heap_realloc(ptr, size);
+}
 
-    if ((min_p != NULL) &&
-        (t_p->value < *min_p))
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack strint_tuple value failed on "
-                             "min check: %d < %d\n", t_p->value, *min_p));
-        set_errno(E_MPL_FAILED_OPERATION);
-        free(t_p->key_p);
-        free(t_p);
-        if (temp_string_allocated)
-            free(temp_str);
-        return (-1);
-    }
+static void param_free(void *ptr)
+{
+    mpl_arena_t *arena_p = current_arena();
 
-    *value_pp = t_p;
+    /* Arena memory is freed with the arena */
+    if ((NULL != arena_p) && mpl_arena_contains(arena_p, ptr))
+        return;
 
-    if (temp_string_allocated)
-        free(temp_str);
-    return (0);
+    heap_free(ptr);
 }
 
 /**
- * mpl_clone_param_value_strint_tuple()
- **/
-int
-    mpl_clone_param_value_strint_tuple(void **new_value_pp,
-                                       const void* old_value_p,
-                                       const mpl_param_descr2_t *descr_p)
+ * set_errno
+ *
+ */
+static void set_errno(int error_value)
 {
-    mpl_strint_tuple_t *t_p;
-    const mpl_strint_tuple_t *old_t_p;
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-
-    t_p = malloc(sizeof(mpl_strint_tuple_t));
-    if (NULL == t_p)
+    mpl_pc_t* pc_p = get_pc();
+    if (pc_p)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        return (-1);
+        pc_p->error = error_value;
     }
-
-    old_t_p = old_value_p;
-
-    t_p->key_p = malloc(strlen(old_t_p->key_p) + 1);
-    if (NULL == t_p->key_p)
+    else
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        free(t_p);
-        return (-1);
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Could not find process context\n"));
     }
-
-    strcpy(t_p->key_p, old_t_p->key_p);
-    t_p->value = old_t_p->value;
-
-    *new_value_pp = t_p;
-
-    return (0);
 }
 
 /**
- * mpl_copy_param_value_strint_tuple()
- **/
-/* NOTE: Copy on a tuple means copy of the value part of the tuple */
-int
-    mpl_copy_param_value_strint_tuple(void *to_value_p,
-                                      const void* from_value_p,
-                                      int size,
-                                      const mpl_param_descr2_t *descr_p)
+ * get_scratch_string
+ *
+ */
+static char *get_scratch_string(int len)
 {
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    if (size >= (int)sizeof(int))
-        *(int*)to_value_p = ((mpl_strint_tuple_t*)from_value_p)->value;
+    mpl_pc_t* pc_p = get_pc();
+    if (pc_p)
+    {
+        if (pc_p->scratch_string_current >= num_scratch_strings)
+            pc_p->scratch_string_current = 0;
+        if (len > pc_p->scratch_string_len[pc_p->scratch_string_current])
+        {
+            pc_p->scratch_string[pc_p->scratch_string_current] =
+                heap_realloc(pc_p->scratch_string[pc_p->scratch_string_current], len);
+            if (pc_p->scratch_string[pc_p->scratch_string_current] == NULL)
+            {
+                MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                                    ("Failed allocating memory\n"));
+                pc_p->scratch_string_len[pc_p->scratch_string_current] = 0;
+                return NULL;
+            }
+
+            pc_p->scratch_string_len[pc_p->scratch_string_current] = len;
+        }
+
+        return pc_p->scratch_string[pc_p->scratch_string_current++];
+    }
 
-    return sizeof(int);
+    MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                        ("Could not find process context\n"));
+    return NULL;
 }
 
 /**
- * mpl_compare_param_value_strint_tuple()
- **/
-int mpl_compare_param_value_strint_tuple(const void *value1_p,
-                                         const void* value2_p,
-                                         const mpl_param_descr2_t *descr_p)
+ * paramset_find
+ *
+ */
+static mpl_param_descr_set_t* paramset_find(int param_set_id,
+                                            char *paramid_prefix)
 {
-    const mpl_strint_tuple_t *t1_p;
-    const mpl_strint_tuple_t *t2_p;
-    MPL_IDENTIFIER_NOT_USED(descr_p);
+    mpl_paramset_registry_t *reg_p = registry_get();
+    mpl_param_descr_set_t *paramset_p = NULL;
+    int pos;
 
-    t1_p = value1_p;
-    t2_p = value2_p;
+    if (NULL == reg_p)
+        return NULL;
 
-    if ((NULL == t1_p->key_p) || (NULL == t2_p->key_p))
+    if (param_set_id > 0)
     {
-        if (t1_p->key_p != t2_p->key_p)
-            return -1;
+        if (param_set_id < reg_p->by_id_size)
+        {
+            paramset_p = reg_p->by_id[param_set_id];
+        }
+        else
+        {
+            /* Not representable in a parameter id, so not in by_id */
+            for (pos = 0; pos < reg_p->num_paramsets; pos++)
+            {
+                if (reg_p->paramsets[pos]->param_set_id == param_set_id)
+                {
+                    paramset_p = reg_p->paramsets[pos];
+                    break;
+                }
+            }
+        }
+
+        if ((NULL != paramset_p) &&
+            (NULL != paramid_prefix) &&
+            strncmp(paramset_p->paramid_prefix,
+                    paramid_prefix,
+                    MPL_PARAMID_PREFIX_MAXLEN))
+        {
+            return NULL;
+        }
+        return paramset_p;
     }
-    else if (strcmp(t1_p->key_p, t2_p->key_p))
-        return -1;
 
-    return (t1_p->value != t2_p->value);
-}
+    if (NULL == paramid_prefix)
+        return NULL;
 
-/**
- * mpl_sizeof_param_value_strint_tuple()
- **/
-size_t mpl_sizeof_param_value_strint_tuple(const mpl_param_descr2_t *descr_p)
-{
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    return 0;
-}
+    pos = name_index_lookup(&reg_p->prefix_index,
+                            paramid_prefix,
+                            strlen(paramid_prefix));
+    if (pos < 0)
+        return NULL;
 
+    return reg_p->paramsets[pos];
+}
 
 /**
- * mpl_free_param_value_strint_tuple()
- **/
-void mpl_free_param_value_strint_tuple(void *value_p)
+ * paramset_add
+ *
+ */
+static int paramset_add(mpl_param_descr_set_t* paramset_p)
 {
-    mpl_strint_tuple_t *t_p;
+    mpl_paramset_registry_t *new_p;
 
-    t_p = value_p;
-    if (NULL != t_p)
+    if (NULL == paramset_p)
     {
-        if (NULL != t_p->key_p)
-        {
-            free(t_p->key_p);
-        }
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("paramset_p is NULL\n"));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return -1;
+    }
 
-        free(t_p);
+    (void)mpl_mutex_lock(mutex);
+    new_p = registry_create(registry_p, paramset_p);
+    if (NULL == new_p)
+    {
+        (void)mpl_mutex_unlock(mutex);
+        return -1;
     }
+#ifdef MPL_HAVE_ATOMIC_PTR
+    mpl_atomic_store_ptr(&registry_p, new_p);
+#else
+    registry_p = new_p;
+#endif
+    (void)mpl_mutex_unlock(mutex);
+
+    return 0;
 }
 
 /**
- * mpl_pack_param_value_struint8_tuple()
- **/
-int mpl_pack_param_value_struint8_tuple(const void* param_value_p,
-                                        char *buf,
-                                        size_t buflen,
-                                        const mpl_param_descr2_t *descr_p,
-                                        const mpl_pack_options_t *options_p)
+ * paramset_find_prefix
+ *
+ */
+static mpl_param_descr_set_t* paramset_find_prefix(const char *id_str)
 {
-    const mpl_struint8_tuple_t *t_p;
-    MPL_IDENTIFIER_NOT_USED(descr_p);
+    mpl_paramset_registry_t *reg_p;
+    size_t prefix_len = 0;
+    int pos;
 
-    assert(NULL != param_value_p);
+    while ((prefix_len <= MPL_PARAMID_PREFIX_MAXLEN) &&
+           (id_str[prefix_len] != '\0') &&
+           (id_str[prefix_len] != '.'))
+        prefix_len++;
+    if (id_str[prefix_len] != '.')
+        return NULL;
 
-    t_p = param_value_p;
-    assert(NULL != t_p->key_p);
+    reg_p = registry_get();
+    if (NULL == reg_p)
+        return NULL;
 
-    return snprintf_escape(options_p->message_delimiter, '\\',
-                           buf, buflen, "=%s/%d", t_p->key_p, t_p->value);
+    pos = name_index_lookup(&reg_p->prefix_index, id_str, prefix_len);
+    if (pos < 0)
+        return NULL;
+
+    return reg_p->paramsets[pos];
 }
 
+/**
+ * registry_get
+ *
+ * Returns the current parameter set registry snapshot, or NULL if no
+ * parameter set is registered.
+ *
+ */
+static mpl_paramset_registry_t *registry_get(void)
+{
+#ifdef MPL_HAVE_ATOMIC_PTR
+    return mpl_atomic_load_ptr(&registry_p);
+#else
+    mpl_paramset_registry_t *reg_p;
+
+    (void)mpl_mutex_lock(mutex);
+    reg_p = registry_p;
+    (void)mpl_mutex_unlock(mutex);
+    return reg_p;
+#endif
+}
 
 /**
- * mpl_unpack_param_value_struint8_tuple()
- **/
-int
-    mpl_unpack_param_value_struint8_tuple(const char* value_str,
-                                          void **value_pp,
-                                          const mpl_param_descr2_t *descr_p,
-                                          const mpl_pack_options_t *options_p,
-                                          mpl_param_element_id_t unpack_context)
+ * registry_create
+ *
+ * Create a registry snapshot holding the contents of old_p (may be NULL)
+ * and paramset_p. The new snapshot is linked to old_p as retired. Must
+ * be called with mutex locked.
+ *
+ */
+static mpl_paramset_registry_t *registry_create(mpl_paramset_registry_t *old_p,
+                                                mpl_param_descr_set_t *paramset_p)
 {
-    mpl_struint8_tuple_t *t_p;
-    char* p;
-    int slen;
-    int temp;
-    char *temp_str;
-    int temp_string_allocated = 0;
-    const uint8_t *max_p = descr_p->max_p;
-    const uint8_t *min_p = descr_p->min_p;
-    MPL_IDENTIFIER_NOT_USED(unpack_context);
+    mpl_paramset_registry_t *new_p;
+    int old_num = (NULL != old_p) ? old_p->num_paramsets : 0;
+    int old_by_id_size = (NULL != old_p) ? old_p->by_id_size : 0;
+    int param_set_id = paramset_p->param_set_id;
+    int i;
 
-    if (strchr(value_str, '\\')) {
-        temp_str = remove_escape(value_str, '\\');
-        if (temp_str == NULL) {
-            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                                ("Failed allocating memory\n"));
-            set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-            return (-1);
-        }
-        temp_string_allocated = 1;
-    }
-    else {
-        temp_str = (char*) value_str;
-    }
+    new_p = heap_calloc(1, sizeof(mpl_paramset_registry_t));
+    if (NULL == new_p)
+        goto error_return;
 
-    p = strchr(temp_str, '/');
-    if (NULL == p)
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack struint8_tuple failed, no delimiter: %s\n",
-                             temp_str));
-        set_errno(E_MPL_FAILED_OPERATION);
-        if (temp_string_allocated)
-            free(temp_str);
-        return (-1);
+    new_p->paramsets = heap_malloc((old_num + 1) * sizeof(mpl_param_descr_set_t*));
+    if (NULL == new_p->paramsets)
+        goto error_return;
+    /* Newest first, so that the first match of an id or a prefix is the
+       latest registration, as with the original parameter set list */
+    new_p->paramsets[0] = paramset_p;
+    if (old_num > 0)
+        memcpy(new_p->paramsets + 1,
+               old_p->paramsets,
+               old_num * sizeof(mpl_param_descr_set_t*));
+    new_p->num_paramsets = old_num + 1;
+
+    new_p->by_id_size = old_by_id_size;
+    if ((param_set_id > 0) &&
+        (param_set_id <= (MPL_PARAMID_PARAMSET_MASK >> MPL_PARAMID_PARAMSET_SHIFT)) &&
+        (param_set_id >= new_p->by_id_size))
+    {
+        new_p->by_id_size = param_set_id + 1;
+    }
+    if (new_p->by_id_size > 0)
+    {
+        new_p->by_id = heap_calloc(new_p->by_id_size, sizeof(mpl_param_descr_set_t*));
+        if (NULL == new_p->by_id)
+            goto error_return;
+        if (old_by_id_size > 0)
+            memcpy(new_p->by_id,
+                   old_p->by_id,
+                   old_by_id_size * sizeof(mpl_param_descr_set_t*));
+        if ((param_set_id > 0) && (param_set_id < new_p->by_id_size))
+            new_p->by_id[param_set_id] = paramset_p;
     }
 
-    t_p = malloc(sizeof(mpl_struint8_tuple_t));
-    if (NULL == t_p)
+    if (name_index_build(&new_p->prefix_index,
+                         new_p->paramsets,
+                         new_p->num_paramsets,
+                         paramset_prefix_get) < 0)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        if (temp_string_allocated)
-            free(temp_str);
-        return (-1);
+        registry_free(new_p, false);
+        return NULL;
     }
 
-    slen = p - temp_str;
-
-    t_p->key_p = malloc(slen + 1);
-    if (NULL == t_p->key_p)
+    if ((NULL != old_p) && (NULL != old_p->enum_index_p))
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        free(t_p);
-        if (temp_string_allocated)
-            free(temp_str);
-        return (-1);
+        new_p->enum_index_p = heap_malloc((old_p->enum_index_mask + 1) *
+                                     sizeof(mpl_enum_index_entry_t));
+        if (NULL == new_p->enum_index_p)
+            goto error_return;
+        memcpy(new_p->enum_index_p,
+               old_p->enum_index_p,
+               (old_p->enum_index_mask + 1) * sizeof(mpl_enum_index_entry_t));
+        new_p->enum_index_mask = old_p->enum_index_mask;
+        new_p->enum_index_count = old_p->enum_index_count;
     }
-    strncpy(t_p->key_p, temp_str, slen);
-    t_p->key_p[slen] = 0;
-
-
-    p++;
 
-    if (convert_int(p, &temp) < 0)
+    if ((NULL != old_p) && (NULL != old_p->range_index_p))
     {
-        free(t_p->key_p);
-        free(t_p);
-        if (temp_string_allocated)
-            free(temp_str);
-        return (-1);
+        new_p->range_index_p = heap_malloc((old_p->range_index_mask + 1) *
+                                      sizeof(mpl_range_index_entry_t));
+        if (NULL == new_p->range_index_p)
+            goto error_return;
+        memcpy(new_p->range_index_p,
+               old_p->range_index_p,
+               (old_p->range_index_mask + 1) * sizeof(mpl_range_index_entry_t));
+        new_p->range_index_mask = old_p->range_index_mask;
+        new_p->range_index_count = old_p->range_index_count;
     }
 
-    if ((temp < 0) ||
-        (temp > (int)UINT8_MAX))
+    if (NULL != paramset_p->array2)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack struint8_tuple failed on range check: %d\n", temp));
-        set_errno(E_MPL_FAILED_OPERATION);
-        free(t_p->key_p);
-        free(t_p);
-        if (temp_string_allocated)
-            free(temp_str);
-        return (-1);
+        for (i = 0; i < PARAM_SET_SIZE(paramset_p); i++)
+        {
+            if (enum_index_add(new_p,
+                               paramset_p->array2[i].enum_values,
+                               paramset_p->array2[i].enum_values_size) < 0)
+            {
+                /* Enum lookup falls back to linear search */
+                break;
+            }
+        }
+        for (i = 0; i < PARAM_SET_SIZE(paramset_p); i++)
+        {
+            if (range_index_add(new_p,
+                                paramset_p->array2[i].integer_ranges,
+                                paramset_p->array2[i].integer_ranges_size) < 0)
+            {
+                /* Range check falls back to linear search */
+                break;
+            }
+        }
     }
 
-    t_p->value = (uint8_t)temp;
+    new_p->retired_p = old_p;
+    return new_p;
 
-    if ((max_p != NULL) &&
-        (t_p->value > *max_p))
+error_return:
+    MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                        ("Failed allocating memory\n"));
+    set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+    registry_free(new_p, false);
+    return NULL;
+}
+
+/**
+ * registry_free
+ *
+ * Free a registry snapshot, but not the parameter sets in it. The enum
+ * name indexes and the range intervals are shared between snapshots and
+ * only freed when free_shared_indexes is set.
+ *
+ */
+static void registry_free(mpl_paramset_registry_t *reg_p,
+                          bool free_shared_indexes)
+{
+    uint32_t i;
+
+    if (NULL == reg_p)
+        return;
+
+    if (free_shared_indexes && (NULL != reg_p->enum_index_p))
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack struint8_tuple value failed on "
-                             "max check: %d > %d\n", t_p->value, *max_p));
-        set_errno(E_MPL_FAILED_OPERATION);
-        free(t_p->key_p);
-        free(t_p);
-        if (temp_string_allocated)
-            free(temp_str);
-        return (-1);
+        for (i = 0; i <= reg_p->enum_index_mask; i++)
+        {
+            name_index_free(&reg_p->enum_index_p[i].index);
+            free(reg_p->enum_index_p[i].by_value);
+        }
     }
-
-    if ((min_p != NULL) &&
-        (t_p->value < *min_p))
+    free(reg_p->enum_index_p);
+    if (free_shared_indexes && (NULL != reg_p->range_index_p))
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack struint8_tuple value failed on "
-                             "min check: %d < %d\n", t_p->value, *min_p));
-        set_errno(E_MPL_FAILED_OPERATION);
-        free(t_p->key_p);
-        free(t_p);
-        if (temp_string_allocated)
-            free(temp_str);
-        return (-1);
+        for (i = 0; i <= reg_p->range_index_mask; i++)
+            free(reg_p->range_index_p[i].intervals);
     }
-
-    *value_pp = t_p;
-
-    if (temp_string_allocated)
-        free(temp_str);
-    return (0);
+    free(reg_p->range_index_p);
+    name_index_free(&reg_p->prefix_index);
+    free(reg_p->by_id);
+    free(reg_p->paramsets);
+    free(reg_p);
 }
 
-/**
- * mpl_clone_param_value_struint8_tuple()
- **/
-int
-    mpl_clone_param_value_struint8_tuple(void **new_value_pp,
-                                         const void* old_value_p,
-                                         const mpl_param_descr2_t *descr_p)
+static uint32_t name_hash(const char *name_p, size_t namelen)
 {
-    mpl_struint8_tuple_t *t_p;
-    const mpl_struint8_tuple_t *old_t_p;
-    MPL_IDENTIFIER_NOT_USED(descr_p);
+    /* FNV-1a */
+    uint32_t hash = 2166136261u;
+    size_t i;
 
-    t_p = malloc(sizeof(mpl_struint8_tuple_t));
-    if (NULL == t_p)
+    for (i = 0; i < namelen; i++)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        return (-1);
+        hash ^= (uint8_t)name_p[i];
+        hash *= 16777619u;
     }
+    return hash;
+}
 
-    old_t_p = old_value_p;
+/**
+ * name_index_build
+ *
+ * Build index of the names in an array. Duplicate names resolve to the
+ * first occurence, like a linear search would. NULL names are skipped.
+ *
+ * Returns 0 on success, -1 on failure.
+ */
+static int name_index_build(mpl_name_index_t *index_p,
+                            const void *array_p,
+                            int size,
+                            mpl_name_index_get_name_fp get_name)
+{
+    uint32_t num_entries = 1;
+    uint32_t slot;
+    uint32_t hash;
+    const char *name_p;
+    int pos;
 
-    t_p->key_p = malloc(strlen(old_t_p->key_p) + 1);
-    if (NULL == t_p->key_p)
+    /* At most half full */
+    while (num_entries < (2 * (uint32_t)size))
+        num_entries <<= 1;
+
+    index_p->entries = heap_malloc(num_entries * sizeof(mpl_name_index_entry_t));
+    if (NULL == index_p->entries)
     {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
                             ("Failed allocating memory\n"));
         set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        free(t_p);
-        return (-1);
+        index_p->mask = 0;
+        return -1;
     }
+    index_p->mask = num_entries - 1;
 
-    strcpy(t_p->key_p, old_t_p->key_p);
-    t_p->value = old_t_p->value;
+    for (slot = 0; slot < num_entries; slot++)
+        index_p->entries[slot].pos = -1;
 
-    *new_value_pp = t_p;
+    for (pos = 0; pos < size; pos++)
+    {
+        name_p = (*get_name)(array_p, pos);
+        if (NULL == name_p)
+            continue;
 
-    return (0);
-}
+        hash = name_hash(name_p, strlen(name_p));
+        slot = hash & index_p->mask;
+        while (index_p->entries[slot].pos >= 0)
+        {
+            if ((index_p->entries[slot].hash == hash) &&
+                !strcmp(index_p->entries[slot].name_p, name_p))
+                break;
+            slot = (slot + 1) & index_p->mask;
+        }
 
-/**
- * mpl_copy_param_value_struint8_tuple()
- **/
-/* NOTE: Copy on a tuple means copy of the value part of the tuple */
-int
-    mpl_copy_param_value_struint8_tuple(void *to_value_p,
-                                        const void* from_value_p,
-                                        int size,
-                                        const mpl_param_descr2_t *descr_p)
-{
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    if (size >= (int)sizeof(int))
-        *(uint8_t*)to_value_p = ((mpl_struint8_tuple_t*)from_value_p)->value;
+        if (index_p->entries[slot].pos >= 0)
+            continue;
 
-    return sizeof(uint8_t);
+        index_p->entries[slot].hash = hash;
+        index_p->entries[slot].pos = pos;
+        index_p->entries[slot].name_p = name_p;
+    }
+
+    return 0;
 }
 
 /**
- * mpl_compare_param_value_struint8_tuple()
- **/
-int mpl_compare_param_value_struint8_tuple(const void *value1_p,
-                                           const void* value2_p,
-                                           const mpl_param_descr2_t *descr_p)
+ * name_index_lookup
+ *
+ * Returns array position of name, or -1 if not found.
+ */
+static int name_index_lookup(const mpl_name_index_t *index_p,
+                             const char *name_p,
+                             size_t namelen)
 {
-    const mpl_struint8_tuple_t *t1_p;
-    const mpl_struint8_tuple_t *t2_p;
-    MPL_IDENTIFIER_NOT_USED(descr_p);
+    uint32_t hash;
+    uint32_t slot;
+    const mpl_name_index_entry_t *entry_p;
 
-    t1_p = value1_p;
-    t2_p = value2_p;
+    if (NULL == index_p->entries)
+        return -1;
 
-    if ((NULL == t1_p->key_p) || (NULL == t2_p->key_p))
+    hash = name_hash(name_p, namelen);
+    slot = hash & index_p->mask;
+    for (entry_p = &index_p->entries[slot];
+         entry_p->pos >= 0;
+         entry_p = &index_p->entries[slot])
     {
-        if (t1_p->key_p != t2_p->key_p)
-            return -1;
+        if ((entry_p->hash == hash) &&
+            !strncmp(entry_p->name_p, name_p, namelen) &&
+            (entry_p->name_p[namelen] == '\0'))
+            return entry_p->pos;
+        slot = (slot + 1) & index_p->mask;
     }
-    else if (strcmp(t1_p->key_p, t2_p->key_p))
-        return -1;
 
-    return (t1_p->value != t2_p->value);
+    return -1;
 }
 
-/**
- * mpl_sizeof_param_value_struint8_tuple()
- **/
-size_t mpl_sizeof_param_value_struint8_tuple(const mpl_param_descr2_t *descr_p)
+static void name_index_free(mpl_name_index_t *index_p)
 {
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    return 0;
+    free(index_p->entries);
+    index_p->entries = NULL;
+    index_p->mask = 0;
+}
+
+static const char *param_name_get(const void *array_p, int pos)
+{
+    return ((const mpl_param_descr_t*)array_p)[pos].name;
+}
+
+static const char *field_name_get(const void *array_p, int pos)
+{
+    return ((const mpl_field_value_t*)array_p)[pos].name_p;
+}
+
+static const char *enum_name_get(const void *array_p, int pos)
+{
+    return ((const mpl_enum_value_t*)array_p)[pos].name_p;
 }
 
+static const char *paramset_prefix_get(const void *array_p, int pos)
+{
+    return ((mpl_param_descr_set_t* const *)array_p)[pos]->paramid_prefix;
+}
 
 /**
- * mpl_free_param_value_struint8_tuple()
- **/
-void mpl_free_param_value_struint8_tuple(void *value_p)
+ * paramset_index_build
+ *
+ * Build name lookup index for parameter names and bag field names
+ * of a parameter set.
+ *
+ */
+static int paramset_index_build(mpl_param_descr_set_t *param_descr_p)
 {
-    mpl_struint8_tuple_t *t_p;
+    mpl_paramset_index_t *index_p;
+    int size = PARAM_SET_SIZE(param_descr_p);
+    int i;
 
-    t_p = value_p;
-    if (NULL != t_p)
+    index_p = heap_calloc(1, sizeof(mpl_paramset_index_t));
+    if (NULL == index_p)
     {
-        if (NULL != t_p->key_p)
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return -1;
+    }
+    param_descr_p->index_p = index_p;
+
+    if (name_index_build(&index_p->params,
+                         param_descr_p->array,
+                         size,
+                         param_name_get) < 0)
+        goto error_return;
+
+    if (paramset_keys_build(param_descr_p, index_p) < 0)
+        goto error_return;
+
+    if (NULL == param_descr_p->array2)
+        return 0;
+
+    for (i = 0; i < size; i++)
+    {
+        if (param_descr_p->array2[i].field_values_size < MPL_NAME_INDEX_MIN_SIZE)
+            continue;
+
+        if (NULL == index_p->fields)
         {
-            free(t_p->key_p);
+            index_p->fields = heap_calloc(size, sizeof(mpl_name_index_t));
+            if (NULL == index_p->fields)
+            {
+                MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                                    ("Failed allocating memory\n"));
+                set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+                goto error_return;
+            }
         }
 
-        free(t_p);
+        if (name_index_build(&index_p->fields[i],
+                             param_descr_p->array2[i].field_values,
+                             param_descr_p->array2[i].field_values_size,
+                             field_name_get) < 0)
+            goto error_return;
     }
+
+    return 0;
+
+error_return:
+    paramset_index_free(param_descr_p);
+    return -1;
 }
 
+static void paramset_index_free(mpl_param_descr_set_t *param_descr_p)
+{
+    mpl_paramset_index_t *index_p = param_descr_p->index_p;
+    int size = PARAM_SET_SIZE(param_descr_p);
+    int i;
 
+    if (NULL == index_p)
+        return;
 
+    name_index_free(&index_p->params);
+    if (NULL != index_p->fields)
+    {
+        for (i = 0; i < size; i++)
+            name_index_free(&index_p->fields[i]);
+        free(index_p->fields);
+    }
+    free(index_p->keys);
+    free(index_p->field_keys);
+    free(index_p->key_text_p);
+    free(index_p);
+    param_descr_p->index_p = NULL;
+}
 
 /**
- * mpl_pack_param_value_bag()
- **/
-int mpl_pack_param_value_bag(const void* param_value_p,
-                             char *buf,
-                             size_t buflen,
-                             const mpl_param_descr2_t *descr_p,
-                             const  mpl_pack_options_t *options_p)
+ * paramset_keys_build
+ *
+ * Render the packed ids of the parameters and bag fields of a parameter
+ * set, so that packing a key is a copy.
+ *
+ */
+static int paramset_keys_build(mpl_param_descr_set_t *param_descr_p,
+                               mpl_paramset_index_t *index_p)
+{
+    const mpl_param_descr2_t *descr2_p;
+    int size = PARAM_SET_SIZE(param_descr_p);
+    size_t prefix_len = strlen(param_descr_p->paramid_prefix);
+    size_t text_size = 0;
+    size_t name_len;
+    size_t field_len;
+    int num_keys = size;
+    int num_fields;
+    char *text_p;
+    mpl_rendered_key_t *key_p;
+    int i;
+    int j;
+
+    for (i = 0; i < size; i++)
+    {
+        name_len = (NULL != param_descr_p->array[i].name) ?
+            strlen(param_descr_p->array[i].name) : 0;
+        text_size += prefix_len + 1 + name_len + 1;
+        if (NULL == param_descr_p->array2)
+            continue;
+        descr2_p = &param_descr_p->array2[i];
+        for (j = 0; j < descr2_p->field_values_size; j++)
+            text_size += prefix_len + 1 + name_len + 1 +
+                strlen(descr2_p->field_values[j].name_p) + 1;
+        num_keys += descr2_p->field_values_size;
+    }
+
+    index_p->name_offset = (int)prefix_len + 1;
+    index_p->key_text_p = heap_malloc(text_size + 1);
+    index_p->keys = heap_calloc(num_keys + 1, sizeof(mpl_rendered_key_t));
+    if (num_keys > size)
+        index_p->field_keys = heap_calloc(size, sizeof(mpl_rendered_key_t*));
+    if ((NULL == index_p->key_text_p) || (NULL == index_p->keys) ||
+        ((num_keys > size) && (NULL == index_p->field_keys)))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return -1;
+    }
+
+    text_p = index_p->key_text_p;
+    key_p = &index_p->keys[size];
+    for (i = 0; i < size; i++)
+    {
+        name_len = (NULL != param_descr_p->array[i].name) ?
+            strlen(param_descr_p->array[i].name) : 0;
+
+        /* prefix.name */
+        index_p->keys[i].text_p = text_p;
+        index_p->keys[i].len = (int)(prefix_len + 1 + name_len);
+        index_p->keys[i].field_offset = index_p->keys[i].len;
+        memcpy(text_p, param_descr_p->paramid_prefix, prefix_len);
+        text_p[prefix_len] = '.';
+        if (name_len > 0)
+            memcpy(text_p + prefix_len + 1, param_descr_p->array[i].name, name_len);
+        text_p += index_p->keys[i].len;
+        *text_p++ = '\0';
+
+        if (NULL == param_descr_p->array2)
+            continue;
+        descr2_p = &param_descr_p->array2[i];
+        num_fields = descr2_p->field_values_size;
+        if (num_fields == 0)
+            continue;
+
+        /* prefix.name%field */
+        index_p->field_keys[i] = key_p;
+        for (j = 0; j < num_fields; j++, key_p++)
+        {
+            field_len = strlen(descr2_p->field_values[j].name_p);
+            key_p->text_p = text_p;
+            key_p->len = (int)(prefix_len + 1 + name_len + 1 + field_len);
+            key_p->field_offset = key_p->len - (int)field_len;
+            memcpy(text_p, index_p->keys[i].text_p, index_p->keys[i].len);
+            text_p[index_p->keys[i].len] = '%';
+            memcpy(text_p + index_p->keys[i].len + 1,
+                   descr2_p->field_values[j].name_p,
+                   field_len);
+            text_p += key_p->len;
+            *text_p++ = '\0';
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * paramset_name_lookup
+ *
+ * Returns index (not id) of named parameter in set, or -1 if not found.
+ */
+static int paramset_name_lookup(const mpl_param_descr_set_t *param_descr_p,
+                                const char *name_p,
+                                size_t namelen)
 {
-    mpl_list_t* l_p = (mpl_list_t*)param_value_p;
-    int tmplen;
-    mpl_pack_options_t options = *options_p;
-    MPL_IDENTIFIER_NOT_USED(descr_p);
+    assert(NULL != param_descr_p->index_p);
+    return name_index_lookup(&param_descr_p->index_p->params,
+                             name_p,
+                             namelen);
+}
 
-    assert(NULL != param_value_p);
-    options.message_delimiter = MESSAGE_DELIMITER;
+/**
+ * enum_index_add
+ *
+ * Add name index for an enum value array to a registry snapshot that is
+ * not yet published, unless too small to be worth it or already there.
+ *
+ */
+static int enum_index_add(mpl_paramset_registry_t *reg_p,
+                          const mpl_enum_value_t enum_values[],
+                          int enum_values_size)
+{
+    mpl_enum_index_entry_t *enum_index_p = reg_p->enum_index_p;
+    int *by_value;
+    uint32_t slot;
+    uint32_t i;
+    int n;
+    int k;
 
-    tmplen = mpl_param_list_pack_extended(l_p,
-                                          NULL,
-                                          0,
-                                          &options);
-    if (tmplen < 0)
-        return tmplen;
+    if ((NULL == enum_values) || (enum_values_size < MPL_NAME_INDEX_MIN_SIZE))
+        return 0;
 
-    if ((tmplen+3) > (int)buflen)
-        return (tmplen+3);
+    /* Grow when more than half full */
+    if ((2 * (reg_p->enum_index_count + 1)) > (reg_p->enum_index_mask + 1))
+    {
+        mpl_enum_index_entry_t *old_p = enum_index_p;
+        uint32_t old_size = (NULL != old_p) ? (reg_p->enum_index_mask + 1) : 0;
+        uint32_t new_size = (old_size > 0) ? (2 * old_size) : 64;
+
+        enum_index_p = heap_calloc(new_size, sizeof(mpl_enum_index_entry_t));
+        if (NULL == enum_index_p)
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                                ("Failed allocating memory\n"));
+            set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+            return -1;
+        }
+        reg_p->enum_index_p = enum_index_p;
+        reg_p->enum_index_mask = new_size - 1;
+
+        for (i = 0; i < old_size; i++)
+        {
+            if (NULL == old_p[i].enum_values)
+                continue;
+            slot = ((uint32_t)((uintptr_t)old_p[i].enum_values >> 4)) & reg_p->enum_index_mask;
+            while (NULL != enum_index_p[slot].enum_values)
+                slot = (slot + 1) & reg_p->enum_index_mask;
+            enum_index_p[slot] = old_p[i];
+        }
+        free(old_p);
+    }
 
+    slot = ((uint32_t)((uintptr_t)enum_values >> 4)) & reg_p->enum_index_mask;
+    while (NULL != enum_index_p[slot].enum_values)
+    {
+        if (enum_index_p[slot].enum_values == enum_values)
+            return 0;
+        slot = (slot + 1) & reg_p->enum_index_mask;
+    }
 
-    if (mpl_param_list_pack_extended(l_p,
-                                     buf+2,
-                                     tmplen+1,
-                                     &options) != (int)tmplen)
+    by_value = heap_malloc(enum_values_size * sizeof(int));
+    if (NULL == by_value)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
         return -1;
+    }
+    /* Insertion sort, stable so that the first name of a value comes first */
+    for (n = 0; n < enum_values_size; n++)
+    {
+        for (k = n;
+             (k > 0) && (enum_values[by_value[k - 1]].value > enum_values[n].value);
+             k--)
+        {
+            by_value[k] = by_value[k - 1];
+        }
+        by_value[k] = n;
+    }
 
-    buf[0] = '=';
-    buf[1] = '{';
-    buf[tmplen+2] = '}';
-    buf[tmplen+3] = '\0';
-    return (tmplen+3);
+    if (name_index_build(&enum_index_p[slot].index,
+                         enum_values,
+                         enum_values_size,
+                         enum_name_get) < 0)
+    {
+        free(by_value);
+        return -1;
+    }
+    enum_index_p[slot].enum_values = enum_values;
+    enum_index_p[slot].by_value = by_value;
+    reg_p->enum_index_count++;
+    return 0;
 }
 
+/**
+ * enum_index_lookup
+ *
+ * Returns position of name in enum value array, -1 if not found and
+ * -2 if there is no index for the array.
+ */
+static int enum_index_lookup(const char *name_p,
+                             const mpl_enum_value_t enum_values[])
+{
+    const mpl_enum_index_entry_t *entry_p = enum_index_get(enum_values);
+
+    if (NULL == entry_p)
+        return -2;
+
+    return name_index_lookup(&entry_p->index, name_p, strlen(name_p));
+}
 
 /**
- * mpl_unpack_param_value_bag()
- **/
-int
-    mpl_unpack_param_value_bag(const char* value_str,
-                               void **value_pp,
-                               const mpl_param_descr2_t *descr_p,
-                               const mpl_pack_options_t *options_p,
-                               mpl_param_element_id_t unpack_context)
+ * enum_index_get
+ *
+ * Returns the index of an enum value array, or NULL if there is none.
+ */
+static const mpl_enum_index_entry_t *enum_index_get(const mpl_enum_value_t enum_values[])
 {
-    mpl_list_t *l_p;
-    char* start_p = NULL;
-    char* end_p = NULL;
-    char* copy_p;
-    const int *max_p = descr_p->max_p;
-    const int *min_p = descr_p->min_p;
-    bool err = false;
-    MPL_IDENTIFIER_NOT_USED(descr_p);
+    mpl_paramset_registry_t *reg_p = registry_get();
+    uint32_t slot;
+
+    if ((NULL == reg_p) || (NULL == reg_p->enum_index_p))
+        return NULL;
+
+    slot = ((uint32_t)((uintptr_t)enum_values >> 4)) & reg_p->enum_index_mask;
+    while (NULL != reg_p->enum_index_p[slot].enum_values)
+    {
+        if (reg_p->enum_index_p[slot].enum_values == enum_values)
+            return &reg_p->enum_index_p[slot];
+        slot = (slot + 1) & reg_p->enum_index_mask;
+    }
 
-    start_p = strchr((char*)value_str, '{');
-    if (start_p != NULL)
-        end_p = get_matching_close_bracket('{', '}', start_p, '\\');
+    return NULL;
+}
 
-    if ((start_p == NULL) || (end_p == NULL))
+/**
+ * range_index_add
+ *
+ * Add intervals for an integer range array to a registry snapshot that
+ * is not yet published, unless too small to be worth it or already
+ * there.
+ *
+ */
+static int range_index_add(mpl_paramset_registry_t *reg_p,
+                           const mpl_integer_range_t integer_ranges[],
+                           int integer_ranges_size)
+{
+    mpl_range_index_entry_t *range_index_p = reg_p->range_index_p;
+    mpl_integer_range_t *intervals;
+    int64_t *bounds;
+    int num_bounds;
+    int num_intervals;
+    int64_t first;
+    int64_t last;
+    uint32_t slot;
+    uint32_t i;
+    int n;
+    int k;
+
+    if ((NULL == integer_ranges) ||
+        (integer_ranges_size < MPL_RANGE_INDEX_MIN_SIZE))
+        return 0;
+
+    /* Grow when more than half full */
+    if ((2 * (reg_p->range_index_count + 1)) > (reg_p->range_index_mask + 1))
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack list failed, no delimiter: %s\n",
-                             value_str));
-        set_errno(E_MPL_FAILED_OPERATION);
-        return (-1);
+        mpl_range_index_entry_t *old_p = range_index_p;
+        uint32_t old_size = (NULL != old_p) ? (reg_p->range_index_mask + 1) : 0;
+        uint32_t new_size = (old_size > 0) ? (2 * old_size) : 64;
+
+        range_index_p = heap_calloc(new_size, sizeof(mpl_range_index_entry_t));
+        if (NULL == range_index_p)
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                                ("Failed allocating memory\n"));
+            set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+            return -1;
+        }
+        reg_p->range_index_p = range_index_p;
+        reg_p->range_index_mask = new_size - 1;
+
+        for (i = 0; i < old_size; i++)
+        {
+            if (NULL == old_p[i].integer_ranges)
+                continue;
+            slot = ((uint32_t)((uintptr_t)old_p[i].integer_ranges >> 4)) & reg_p->range_index_mask;
+            while (NULL != range_index_p[slot].integer_ranges)
+                slot = (slot + 1) & reg_p->range_index_mask;
+            range_index_p[slot] = old_p[i];
+        }
+        free(old_p);
     }
 
-    start_p++;
-    if ((start_p > end_p) || (*start_p == '\0'))
+    slot = ((uint32_t)((uintptr_t)integer_ranges >> 4)) & reg_p->range_index_mask;
+    while (NULL != range_index_p[slot].integer_ranges)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack list failed, format error: %s\n",
-                             value_str));
-        set_errno(E_MPL_FAILED_OPERATION);
-        return (-1);
+        if (range_index_p[slot].integer_ranges == integer_ranges)
+            return 0;
+        slot = (slot + 1) & reg_p->range_index_mask;
     }
 
-    copy_p = calloc(1, (end_p - start_p) + 1);
-    if (copy_p == NULL)
+    /*
+     * Every range starts and ends (one past last) on a bound, so between
+     * two bounds next to each other the covering range is the same.
+     */
+    bounds = heap_malloc(2 * integer_ranges_size * sizeof(int64_t));
+    intervals = heap_malloc(2 * integer_ranges_size * sizeof(mpl_integer_range_t));
+    if ((NULL == bounds) || (NULL == intervals))
     {
+        free(bounds);
+        free(intervals);
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("copy_p\n"));
+                            ("Failed allocating memory\n"));
         set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        return (-1);
-    }
-
-    strncpy(copy_p, start_p, (end_p - start_p));
-
-    l_p = mpl_param_list_unpack_internal(copy_p,
-                                         options_p,
-                                         unpack_context,
-                                         &err);
-
-    if (err) {
-        free(copy_p);
         return -1;
     }
 
-    if ((max_p != NULL) &&
-        ((int)mpl_list_len(l_p) > *max_p))
+    num_bounds = 0;
+    for (n = 0; n < integer_ranges_size; n++)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack list value failed on "
-                             "max check: %zu > %d\n", mpl_list_len(l_p),
-                             *max_p));/*lint !e557 %zu is C99 */
-        set_errno(E_MPL_FAILED_OPERATION);
-        mpl_param_list_destroy(&l_p);
-        free(copy_p);
-        return (-1);
+        assert(integer_ranges[n].first <= integer_ranges[n].last);
+        bounds[num_bounds++] = integer_ranges[n].first;
+        if (integer_ranges[n].last < INT64_MAX)
+            bounds[num_bounds++] = integer_ranges[n].last + 1;
     }
-
-    if ((min_p != NULL) &&
-        ((int)mpl_list_len(l_p) < *min_p))
+    for (n = 1; n < num_bounds; n++)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Unpack list value failed on "
-                             "min check: %zu < %d\n", mpl_list_len(l_p),
-                             *min_p));/*lint !e557 %zu is C99 */
-        set_errno(E_MPL_FAILED_OPERATION);
-        mpl_param_list_destroy(&l_p);
-        free(copy_p);
-        return (-1);
+        first = bounds[n];
+        for (k = n; (k > 0) && (bounds[k - 1] > first); k--)
+            bounds[k] = bounds[k - 1];
+        bounds[k] = first;
     }
 
-    free(copy_p);
-    *value_pp = l_p;
+    num_intervals = 0;
+    for (n = 0; n < num_bounds; n++)
+    {
+        if ((n > 0) && (bounds[n] == bounds[n - 1]))
+            continue;
+        first = bounds[n];
+        last = INT64_MAX;
+        for (k = n + 1; k < num_bounds; k++)
+        {
+            if (bounds[k] != first)
+            {
+                last = bounds[k] - 1;
+                break;
+            }
+        }
+        for (k = 0; k < integer_ranges_size; k++)
+        {
+            if ((first >= integer_ranges[k].first) &&
+                (first <= integer_ranges[k].last))
+                break;
+        }
+        if (k == integer_ranges_size)
+            continue;
+        if ((num_intervals > 0) &&
+            (intervals[num_intervals - 1].last == (first - 1)) &&
+            (intervals[num_intervals - 1].id == integer_ranges[k].id))
+        {
+            intervals[num_intervals - 1].last = last;
+            continue;
+        }
+        intervals[num_intervals].first = first;
+        intervals[num_intervals].last = last;
+        intervals[num_intervals].id = integer_ranges[k].id;
+        num_intervals++;
+    }
+    free(bounds);
 
-    return (0);
+    range_index_p[slot].integer_ranges = integer_ranges;
+    range_index_p[slot].intervals = intervals;
+    range_index_p[slot].num_intervals = num_intervals;
+    reg_p->range_index_count++;
+    return 0;
 }
 
 /**
- * mpl_clone_param_value_bag()
- **/
-int
-    mpl_clone_param_value_bag(void **new_value_pp,
-                              const void* old_value_p,
-                              const mpl_param_descr2_t *descr_p)
+ * range_index_get
+ *
+ * Returns the index of an integer range array, or NULL if there is none.
+ */
+static const mpl_range_index_entry_t *range_index_get(const mpl_integer_range_t integer_ranges[])
 {
-    mpl_list_t *l_p;
-    mpl_list_t *ol_p = (mpl_list_t *)old_value_p;
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-
-    l_p = mpl_param_list_clone(ol_p);
-    if (l_p == NULL)
-        return (-1);
-
-    *new_value_pp = l_p;
-    return 0;
-}
+    mpl_paramset_registry_t *reg_p = registry_get();
+    uint32_t slot;
 
+    if ((NULL == reg_p) || (NULL == reg_p->range_index_p))
+        return NULL;
 
-/**
- * mpl_copy_param_value_bag()
- **/
-/* NOTE: Copy on a bag means copy of the list pointer
-   (rather pointless unless cloning a list from an element) */
-int
-    mpl_copy_param_value_bag(void *to_value_p,
-                             const void* from_value_p,
-                             int size,
-                             const mpl_param_descr2_t *descr_p)
-{
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    if (size >= (int)sizeof(mpl_list_t*))
-        *(mpl_list_t**)to_value_p = (mpl_list_t*)from_value_p;
+    slot = ((uint32_t)((uintptr_t)integer_ranges >> 4)) & reg_p->range_index_mask;
+    while (NULL != reg_p->range_index_p[slot].integer_ranges)
+    {
+        if (reg_p->range_index_p[slot].integer_ranges == integer_ranges)
+            return &reg_p->range_index_p[slot];
+        slot = (slot + 1) & reg_p->range_index_mask;
+    }
 
-    return sizeof(mpl_list_t*);
+    return NULL;
 }
 
 /**
- * mpl_compare_param_value_bag()
- **/
-int mpl_compare_param_value_bag(const void *value1_p,
-                                const void* value2_p,
-                                const mpl_param_descr2_t *descr_p)
+ * list_index_create
+ *
+ * Create index of a parameter list. An attached index is used by the
+ * mpl_param_list_find*() functions.
+ *
+ * Returns the index, or NULL on failure.
+ */
+static mpl_param_list_index_t *list_index_create(mpl_list_t **param_list_pp,
+                                                 bool attach)
 {
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    return mpl_compare_param_lists((mpl_list_t *)value1_p,
-                                   (mpl_list_t *)value2_p);
-}
+    mpl_param_list_index_t *index_p;
+    mpl_list_t *elem_p;
+    uint32_t num_entries = MPL_LIST_INDEX_MIN_SIZE;
+    size_t len;
 
-/**
- * mpl_sizeof_param_value_bag()
- **/
-size_t mpl_sizeof_param_value_bag(const mpl_param_descr2_t *descr_p)
-{
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    return 0;
-}
+    if (NULL == param_list_pp)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                            ("param_list_pp is NULL\n"));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return NULL;
+    }
 
+    /* Up to MPL_LIST_INDEX_MAX_KEYS keys per element, at most half full */
+    len = mpl_list_len(*param_list_pp);
+    while ((num_entries < (2 * MPL_LIST_INDEX_MAX_KEYS * len)) &&
+           (num_entries < 0x40000000u))
+        num_entries <<= 1;
 
-/**
- * mpl_free_param_value_bag()
- **/
-void mpl_free_param_value_bag(void *value_p)
-{
-    mpl_list_t *l_p = value_p;
-    mpl_param_list_destroy(&l_p);
-}
+    index_p = calloc(1, sizeof(mpl_param_list_index_t));
+    if (NULL != index_p)
+        index_p->entries = calloc(num_entries, sizeof(mpl_list_index_entry_t));
+
+    if ((NULL == index_p) || (NULL == index_p->entries))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        free(index_p);
+        return NULL;
+    }
+    index_p->list_pp = param_list_pp;
+    index_p->mask = num_entries - 1;
 
+    MPL_LIST_FOR_EACH(*param_list_pp, elem_p)
+    {
+        if (list_index_insert(index_p,
+                              MPL_LIST_CONTAINER(elem_p,
+                                                 mpl_param_element_t,
+                                                 list_entry),
+                              false) < 0)
+        {
+            mpl_param_list_index_destroy(index_p);
+            return NULL;
+        }
+    }
 
+    if (attach)
+    {
+        index_p->attached = true;
+        (void)mpl_mutex_lock(mutex);
+        mpl_list_add(&attached_indexes_p, &index_p->list_entry);
+        (void)mpl_mutex_unlock(mutex);
+        list_index_set_head(index_p);
+    }
 
-/**
- * mpl_pack_param_value_addr()
- **/
-int mpl_pack_param_value_addr(const void* param_value_p,
-                              char *buf, size_t buflen,
-                              const mpl_param_descr2_t *descr_p,
-                              const mpl_pack_options_t *options_p)
-{
-    assert(NULL != param_value_p);
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    MPL_IDENTIFIER_NOT_USED(options_p)
-        return snprintf(buf, buflen, "=%p", *(void**)param_value_p);
+    return index_p;
 }
 
 /**
- * mpl_unpack_param_value_addr()
- **/
-int
-    mpl_unpack_param_value_addr(const char* value_str, void **value_pp,
-                                const mpl_param_descr2_t *descr_p,
-                                const mpl_pack_options_t *options_p,
-                                mpl_param_element_id_t unpack_context)
+ * list_index_attached
+ *
+ * Returns the attached index of a list, or NULL if it has none (or if
+ * param_list_p is not the beginning of the list).
+ */
+static mpl_param_list_index_t *list_index_attached(mpl_list_t *param_list_p)
 {
-    void** p;
-    int res;
+    mpl_list_t *entry_p;
+    mpl_param_list_index_t *index_p;
+    mpl_param_list_index_t *found_p = NULL;
 
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    MPL_IDENTIFIER_NOT_USED(options_p);
-    MPL_IDENTIFIER_NOT_USED(unpack_context);
+    if ((NULL == param_list_p) ||
+        !MPL_LIST_CONTAINER(param_list_p,
+                            mpl_param_element_t,
+                            list_entry)->heads_index)
+        return NULL;
 
-    p = malloc(sizeof(void*));
-    if (NULL == p)
+    (void)mpl_mutex_lock(mutex);
+    MPL_LIST_FOR_EACH(attached_indexes_p, entry_p)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        return (-1);
+        index_p = MPL_LIST_CONTAINER(entry_p, mpl_param_list_index_t, list_entry);
+        if (index_p->head_p == param_list_p)
+        {
+            found_p = index_p;
+            break;
+        }
     }
+    (void)mpl_mutex_unlock(mutex);
 
-    res = sscanf(value_str, "%p", p);
+    return found_p;
+}
 
-    if (res <= 0)
-    {
-        free(p);
-        return (-1);
-    }
+/**
+ * list_index_set_head
+ *
+ * Move heads_index to the current first element of the list of an
+ * attached index.
+ */
+static void list_index_set_head(mpl_param_list_index_t *index_p)
+{
+    mpl_list_t *old_head_p = index_p->head_p;
 
-    assert(NULL != value_pp);
-    *value_pp = p;
+    if (!index_p->attached || (old_head_p == *index_p->list_pp))
+        return;
 
-    return (0);
+    (void)mpl_mutex_lock(mutex);
+    index_p->head_p = *index_p->list_pp;
+    (void)mpl_mutex_unlock(mutex);
+
+    if (NULL != old_head_p)
+        MPL_LIST_CONTAINER(old_head_p,
+                           mpl_param_element_t,
+                           list_entry)->heads_index = false;
+    if (NULL != index_p->head_p)
+        MPL_LIST_CONTAINER(index_p->head_p,
+                           mpl_param_element_t,
+                           list_entry)->heads_index = true;
 }
 
 /**
- * mpl_clone_param_value_addr()
- **/
-int
-    mpl_clone_param_value_addr(void **new_value_pp,
-                               const void* old_value_p,
-                               const mpl_param_descr2_t *descr_p)
+ * param_list_find
+ *
+ * Linear search, see mpl_param_list_find().
+ */
+static mpl_param_element_t *param_list_find(mpl_param_element_id_t param_id,
+                                            mpl_list_t *param_list_p)
 {
-    void** p = malloc(sizeof(void*));
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    if (NULL == p)
+    mpl_list_t *elem_p;
+    mpl_param_element_t *res;
+
+    MPL_LIST_FOR_EACH(param_list_p, elem_p)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        return (-1);
+        res = MPL_LIST_CONTAINER(elem_p, mpl_param_element_t, list_entry);
+        if (mpl_param_id_is_same_or_child(param_id, res->id))
+            return res;
     }
 
-    *p = *(void**)old_value_p;
-    *new_value_pp = p;
-
-    return (0);
+    return NULL;
 }
 
 /**
- * mpl_copy_param_value_addr()
- **/
-int
-    mpl_copy_param_value_addr(void *to_value_p,
-                              const void* from_value_p,
-                              int size,
-                              const mpl_param_descr2_t *descr_p)
+ * param_list_find_tag
+ *
+ * Linear search, see mpl_param_list_find_tag().
+ */
+static mpl_param_element_t *param_list_find_tag(mpl_param_element_id_t param_id,
+                                                int tag,
+                                                mpl_list_t *param_list_p)
 {
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    if (size >= (int)sizeof(void*))
-        *(void**)to_value_p = *(void**)from_value_p;
+    mpl_list_t *elem_p;
+    mpl_param_element_t *res;
 
-    return sizeof(void*);
+    MPL_LIST_FOR_EACH(param_list_p, elem_p)
+    {
+        res = MPL_LIST_CONTAINER(elem_p, mpl_param_element_t, list_entry);
+        if (((param_id == MPL_PARAM_ID_UNDEFINED) || mpl_param_id_is_same_or_child(param_id, res->id)) &&
+            (res->tag == tag))
+            return res;
+    }
+
+    return NULL;
 }
 
 /**
- * mpl_compare_param_value_addr()
- **/
-int mpl_compare_param_value_addr(const void *value1_p,
-                                 const void* value2_p,
-                                 const mpl_param_descr2_t *descr_p)
+ * param_list_find_field
+ *
+ * Linear search, see mpl_param_list_find_field().
+ */
+static mpl_param_element_t *param_list_find_field(mpl_param_element_id_t context,
+                                                  int id_in_context,
+                                                  mpl_list_t *param_list_p)
 {
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    return (*((void**) value1_p) != *((void**) value2_p));
+    mpl_list_t *elem_p;
+    mpl_param_element_t *res;
+    mpl_param_element_id_t bag_field_context =
+        mpl_param_get_bag_field_context(context,id_in_context);
+
+    MPL_LIST_FOR_EACH(param_list_p, elem_p)
+    {
+        res = MPL_LIST_CONTAINER(elem_p, mpl_param_element_t, list_entry);
+        if ((res->context == bag_field_context) &&
+            (res->id_in_context == id_in_context))
+            return res;
+    }
+
+    return NULL;
 }
 
 /**
- * mpl_sizeof_param_value_addr()
- **/
-size_t mpl_sizeof_param_value_addr(const mpl_param_descr2_t *descr_p)
+ * param_list_find_field_tag
+ *
+ * Linear search, see mpl_param_list_find_field_tag().
+ */
+static mpl_param_element_t *param_list_find_field_tag(mpl_param_element_id_t context,
+                                                      int id_in_context,
+                                                      int tag,
+                                                      mpl_list_t *param_list_p)
 {
-    MPL_IDENTIFIER_NOT_USED(descr_p);
-    return sizeof(void*);
-}
+    mpl_list_t *elem_p;
+    mpl_param_element_t *res;
+
+    MPL_LIST_FOR_EACH(param_list_p, elem_p)
+    {
+        res = MPL_LIST_CONTAINER(elem_p, mpl_param_element_t, list_entry);
+        if ((res->context == mpl_param_get_bag_field_context(context,id_in_context)) &&
+            (res->id_in_context == id_in_context) &&
+            (res->tag == tag))
+            return res;
+    }
 
+    return NULL;
+}
 
 /**
- * mpl_get_args()
- **/
-int mpl_get_args(mpl_arg_t *args,
-                 int args_len,
-                 char *buf,
-                 char equal,
-                 char delimiter,
-                 char escape)
+ * list_index_insert
+ *
+ * Add the keys of an element to a list index. The element becomes the
+ * first element having its keys if it is added to the beginning of the
+ * list (at_front), otherwise only if there is no other.
+ *
+ * Returns 0 on success, -1 on failure.
+ */
+static int list_index_insert(mpl_param_list_index_t *index_p,
+                             mpl_param_element_t *param_elem_p,
+                             bool at_front)
 {
-    assert(NULL != args);
-    return mpl_get_args_2(&args,
-                          args_len,
-                          buf,
-                          equal,
-                          delimiter,
-                          escape);
-}
+    mpl_list_index_entry_t keys[MPL_LIST_INDEX_MAX_KEYS];
+    mpl_list_index_entry_t *entry_p;
+    int num_keys;
+    int i;
 
-int mpl_get_args_2(mpl_arg_t **args_pp,
-                   int args_len,
-                   char *buf,
-                   char equal,
-                   char delimiter,
-                   char escape)
-{
-    char *p;
-    char *kp;
-    char *vp;
-    int i = 0;
-    int buflen;
-    mpl_arg_t *args_p = NULL;
-    int externally_allocated = 0;
+    /* At most half full */
+    if ((2 * (index_p->used + MPL_LIST_INDEX_MAX_KEYS)) > (index_p->mask + 1))
+    {
+        if (list_index_grow(index_p) < 0)
+            return -1;
+    }
 
-    assert(args_pp);
-    if (args_len == 0) {
-        args_p = malloc(sizeof(mpl_arg_t)*100);
-        if (NULL == args_p)
+    num_keys = list_index_keys(param_elem_p, keys);
+    for (i = 0; i < num_keys; i++)
+    {
+        entry_p = list_index_slot(index_p,
+                                  keys[i].kind,
+                                  keys[i].id,
+                                  keys[i].id_in_context,
+                                  keys[i].tag);
+        if (list_key_none == entry_p->kind)
         {
-            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                                ("failed allocating memory\n"));
-            set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-            return -1;
+            *entry_p = keys[i];
+            index_p->used++;
         }
-        memset(args_p,0,sizeof(mpl_arg_t)*100);
-        args_len = 100;
-    }
-    else {
-        assert(*args_pp != NULL);
-        args_p = *args_pp;
-        externally_allocated = 1;
+        entry_p->count++;
+        if (at_front || (NULL == entry_p->first_p))
+            entry_p->first_p = param_elem_p;
     }
 
-    p = mpl_trimstring(buf, escape);
+    return 0;
+}
 
-    buflen = strlen(p);
+/**
+ * list_index_delete
+ *
+ * Remove the keys of an element from a list index. If it was the first
+ * element having a key, the next one is searched for from next_p (the
+ * element following it in the list).
+ */
+static void list_index_delete(mpl_param_list_index_t *index_p,
+                              mpl_param_element_t *param_elem_p,
+                              mpl_list_t *next_p)
+{
+    mpl_list_index_entry_t keys[MPL_LIST_INDEX_MAX_KEYS];
+    mpl_list_index_entry_t *entry_p;
+    mpl_param_element_t *candidate_p;
+    mpl_list_t *elem_p;
+    int num_keys;
+    int i;
 
-    while (((p - buf) < buflen) && (i < args_len))
+    num_keys = list_index_keys(param_elem_p, keys);
+    for (i = 0; i < num_keys; i++)
     {
-        char *mid;
-        char *end;
-        char end_copy;
+        entry_p = list_index_slot(index_p,
+                                  keys[i].kind,
+                                  keys[i].id,
+                                  keys[i].id_in_context,
+                                  keys[i].tag);
+        if ((list_key_none == entry_p->kind) || (entry_p->count <= 0))
+            continue;
 
-        end = strchr_escape( p, delimiter, escape);
+        entry_p->count--;
+        if (entry_p->first_p != param_elem_p)
+            continue;
 
-        if (NULL == end)
-        {
-            end = p + strlen(p);
-            end_copy = *end;
-        }
-        else
-        {
-            end_copy = *end;
-            *end = '\0';
-        }
+        entry_p->first_p = NULL;
+        if (0 == entry_p->count)
+            continue;
 
-        mid = strchr_escape( p, equal, escape );
-        if (NULL != mid)
-        {
-            *mid = '\0';
-            kp = mpl_trimstring(p, escape);
-            args_p[i].key_p = kp;
-            vp = mpl_trimstring(mid + 1, escape);
-            if (*vp == '{')
-            {
-                *end = end_copy;
-                end = get_matching_close_bracket('{', '}', vp, escape);
-                if (NULL == end)
-                    end = vp + strlen(vp);
-                else
-                    end++;
-                *end = '\0';
-            }
-            args_p[i].value_p = vp;
-        }
-        else
+        MPL_LIST_FOR_EACH(next_p, elem_p)
         {
-            args_p[i].key_p = mpl_trimstring(p, escape);
-            args_p[i].value_p = NULL;
-        }
-
-        while ((((end+1) - buf) < buflen) &&
-               *(end+1) == delimiter)
-            end++;
-
-        p = end + 1;
-        i++;
-
-        if ((i >= args_len) && !externally_allocated) {
-            args_p = realloc(args_p, sizeof(mpl_arg_t)*(args_len+100));
-            if (NULL == args_p)
+            candidate_p = MPL_LIST_CONTAINER(elem_p,
+                                             mpl_param_element_t,
+                                             list_entry);
+            if (list_key_matches(entry_p, candidate_p))
             {
-                MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                                    ("failed allocating memory\n"));
-                set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-                return -1;
+                entry_p->first_p = candidate_p;
+                break;
             }
-            memset(args_p+args_len,0,sizeof(mpl_arg_t)*100);
-            args_len += 100;
         }
     }
-
-
-    if ((p - buf) < buflen) {
-        free(args_p);
-        return -1;
-    }
-
-    if (!externally_allocated)
-        *args_pp = args_p;
-
-    return i;
 }
 
 /**
- * mpl_add_param_to_list_n_tag - add parameter to param list
- *                               with value length check
+ * list_index_slot
  *
+ * Returns the slot having the key, or the empty slot where it belongs.
  */
-int mpl_add_param_to_list_n_tag(mpl_list_t **param_list_pp,
-                                mpl_param_element_id_t param_id,
-                                int tag,
-                                const void *value_p,
-                                size_t len)
+static mpl_list_index_entry_t *list_index_slot(const mpl_param_list_index_t *index_p,
+                                               mpl_list_key_kind_t kind,
+                                               int id,
+                                               int id_in_context,
+                                               int tag)
 {
-    mpl_param_element_t* param_elem_p;
+    mpl_list_index_entry_t *entry_p;
+    uint32_t hash;
+    uint32_t slot;
 
-    /* Add msgtype to the parameter list */
-    param_elem_p = mpl_param_element_create_n_tag(param_id, tag, value_p, len);
-    if (NULL == param_elem_p)
+    hash = (uint32_t)kind * 0x9e3779b1u;
+    hash = (hash ^ (uint32_t)id) * 0x85ebca6bu;
+    hash = (hash ^ (uint32_t)id_in_context) * 0xc2b2ae35u;
+    hash = (hash ^ (uint32_t)tag) * 0x9e3779b1u;
+    hash ^= hash >> 16;
+
+    slot = hash & index_p->mask;
+    for (entry_p = &index_p->entries[slot];
+         list_key_none != entry_p->kind;
+         entry_p = &index_p->entries[slot])
     {
-        return -1;
+        if ((entry_p->kind == kind) &&
+            (entry_p->id == id) &&
+            (entry_p->id_in_context == id_in_context) &&
+            (entry_p->tag == tag))
+            return entry_p;
+        slot = (slot + 1) & index_p->mask;
     }
 
-    mpl_list_add(param_list_pp, &param_elem_p->list_entry);
-    return 0;
+    return entry_p;
 }
 
 /**
- * mpl_add_param_to_list_tag - add parameter to param list
+ * list_index_grow
  *
+ * Rehash into a table sized for the keys still in use, dropping the keys
+ * of removed elements.
+ *
+ * Returns 0 on success, -1 on failure.
  */
-int mpl_add_param_to_list_tag(mpl_list_t **param_list_pp,
-                              mpl_param_element_id_t param_id,
-                              int tag,
-                              const void *value_p)
+static int list_index_grow(mpl_param_list_index_t *index_p)
 {
-    mpl_param_element_t* param_elem_p;
+    mpl_list_index_entry_t *old_entries = index_p->entries;
+    uint32_t old_num_entries = index_p->mask + 1;
+    uint32_t num_entries = MPL_LIST_INDEX_MIN_SIZE;
+    uint32_t live = 0;
+    uint32_t i;
 
-    /* Add msgtype to the parameter list */
-    param_elem_p = mpl_param_element_create_tag(param_id, tag, value_p);
-    if (NULL == param_elem_p)
+    for (i = 0; i < old_num_entries; i++)
     {
-        return -1;
+        if ((list_key_none != old_entries[i].kind) && (old_entries[i].count > 0))
+            live++;
     }
 
-    mpl_list_add(param_list_pp, &param_elem_p->list_entry);
-    return 0;
-}
+    /* Room for as many keys again */
+    while (num_entries < (4 * (live + MPL_LIST_INDEX_MAX_KEYS)))
+        num_entries <<= 1;
 
-/**
- * mpl_param_list_add_int_tag - add integer parameter to param list
- *
- */
-int mpl_param_list_add_int_tag(mpl_list_t **param_list_pp,
-                               mpl_param_element_id_t param_id,
-                               int tag,
-                               int value)
-{
-    return mpl_add_param_to_list_n_tag(param_list_pp,
-                                       param_id,
-                                       tag,
-                                       &value,
-                                       sizeof(value));
-}
+    index_p->entries = calloc(num_entries, sizeof(mpl_list_index_entry_t));
+    if (NULL == index_p->entries)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Failed allocating memory\n"));
+        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        index_p->entries = old_entries;
+        return -1;
+    }
+    index_p->mask = num_entries - 1;
+    index_p->used = 0;
 
-/**
- * mpl_param_list_add_uint8_tag - add bool8 parameter to param list
- *
- */
-int mpl_param_list_add_uint8_tag(mpl_list_t **param_list_pp,
-                                 mpl_param_element_id_t param_id,
-                                 int tag,
-                                 uint8_t value)
-{
-    return mpl_add_param_to_list_n_tag(param_list_pp,
-                                       param_id,
-                                       tag,
-                                       &value,
-                                       sizeof(value));
+    for (i = 0; i < old_num_entries; i++)
+    {
+        if ((list_key_none == old_entries[i].kind) || (old_entries[i].count <= 0))
+            continue;
+        *list_index_slot(index_p,
+                         old_entries[i].kind,
+                         old_entries[i].id,
+                         old_entries[i].id_in_context,
+                         old_entries[i].tag) = old_entries[i];
+        index_p->used++;
+    }
+
+    free(old_entries);
+    return 0;
 }
 
 /**
- * mpl_param_list_add_sint8_tag - add sint8 parameter to param list
+ * list_index_keys
  *
+ * Returns the number of keys of an element (2, or 4 for a field).
  */
-int mpl_param_list_add_sint8_tag(mpl_list_t **param_list_pp,
-                                 mpl_param_element_id_t param_id,
-                                 int tag,
-                                 sint8_t value)
-{
-    return mpl_add_param_to_list_n_tag(param_list_pp,
-                                       param_id,
-                                       tag,
-                                       &value,
-                                       sizeof(value));
+static int list_index_keys(const mpl_param_element_t *param_elem_p,
+                           mpl_list_index_entry_t keys[])
+{
+    int num_keys = 2;
+
+    memset(keys, 0, MPL_LIST_INDEX_MAX_KEYS * sizeof(mpl_list_index_entry_t));
+    keys[0].kind = list_key_id;
+    keys[0].id = param_elem_p->id;
+    keys[1].kind = list_key_id_tag;
+    keys[1].id = param_elem_p->id;
+    keys[1].tag = param_elem_p->tag;
+
+    if (MPL_PARAM_ELEMENT_IS_FIELD(param_elem_p))
+    {
+        keys[2].kind = list_key_field;
+        keys[2].id = param_elem_p->context;
+        keys[2].id_in_context = param_elem_p->id_in_context;
+        keys[3].kind = list_key_field_tag;
+        keys[3].id = param_elem_p->context;
+        keys[3].id_in_context = param_elem_p->id_in_context;
+        keys[3].tag = param_elem_p->tag;
+        num_keys += 2;
+    }
+
+    return num_keys;
+}
+
+static bool list_key_matches(const mpl_list_index_entry_t *key_p,
+                             const mpl_param_element_t *param_elem_p)
+{
+    switch (key_p->kind)
+    {
+        case list_key_id:
+            return (param_elem_p->id == key_p->id);
+        case list_key_id_tag:
+            return ((param_elem_p->id == key_p->id) &&
+                    (param_elem_p->tag == key_p->tag));
+        case list_key_field:
+            return (MPL_PARAM_ELEMENT_IS_FIELD(param_elem_p) &&
+                    (param_elem_p->context == key_p->id) &&
+                    (param_elem_p->id_in_context == key_p->id_in_context));
+        case list_key_field_tag:
+            return (MPL_PARAM_ELEMENT_IS_FIELD(param_elem_p) &&
+                    (param_elem_p->context == key_p->id) &&
+                    (param_elem_p->id_in_context == key_p->id_in_context) &&
+                    (param_elem_p->tag == key_p->tag));
+        default:
+            return false;
+    }
 }
 
 /**
- * mpl_param_list_add_uint16_tag - add bool8 parameter to param list
+ * param_list_compare_one_way
  *
+ * Check that all elements of list1 are in list2 with the same value.
+ * index2_p is an index of list2, or NULL.
  */
-int mpl_param_list_add_uint16_tag(mpl_list_t **param_list_pp,
-                                  mpl_param_element_id_t param_id,
-                                  int tag,
-                                  uint16_t value)
+static int param_list_compare_one_way(mpl_list_t *list1_p,
+                                      mpl_list_t *list2_p,
+                                      const mpl_param_list_index_t *index2_p)
 {
-    return mpl_add_param_to_list_n_tag(param_list_pp,
-                                       param_id,
-                                       tag,
-                                       &value,
-                                       sizeof(value));
+    mpl_list_t *list_p;
+    mpl_param_element_t* param_elem1_p;
+    mpl_param_element_t* param_elem2_p;
+
+    MPL_LIST_FOR_EACH(list1_p, list_p)
+    {
+        param_elem1_p = MPL_LIST_CONTAINER(list_p, mpl_param_element_t, list_entry);
+
+        if (MPL_PARAM_ELEMENT_IS_FIELD(param_elem1_p)) {
+            if (NULL != index2_p)
+                param_elem2_p = mpl_param_list_index_find_field_tag(index2_p,
+                                                                    param_elem1_p->context,
+                                                                    param_elem1_p->id_in_context,
+                                                                    param_elem1_p->tag);
+            else
+                param_elem2_p = mpl_param_list_find_field_tag(param_elem1_p->context,
+                                                              param_elem1_p->id_in_context,
+                                                              param_elem1_p->tag,
+                                                              list2_p);
+            if (NULL == param_elem2_p) {
+                return -1;
+            }
+        }
+        else if (NULL != index2_p) {
+            if (NULL == mpl_param_list_index_find(index2_p, param_elem1_p->id)) {
+                return -1;
+            }
+            param_elem2_p = mpl_param_list_index_find_tag(index2_p,
+                                                          param_elem1_p->id,
+                                                          param_elem1_p->tag);
+        }
+        else {
+            if (!MPL_PARAM_PRESENT_IN_LIST(param_elem1_p->id, list2_p)) {
+                return -1;
+            }
+            param_elem2_p = mpl_param_list_find_tag(param_elem1_p->id, param_elem1_p->tag, list2_p);
+        }
+
+        if (0 != mpl_param_element_compare(param_elem1_p, param_elem2_p))
+        {
+            return -1;
+        }
+    }
+
+    return 0;
 }
 
 /**
- * mpl_param_list_add_sint16_tag - add sint16 parameter to param list
+ * param_has_children
  *
+ * Parameters with children are matched by the ids of their children as
+ * well, so they cannot be looked up in a list index.
  */
-int mpl_param_list_add_sint16_tag(mpl_list_t **param_list_pp,
-                                  mpl_param_element_id_t param_id,
-                                  int tag,
-                                  sint16_t value)
+static bool param_has_children(mpl_param_element_id_t param_id)
 {
-    return mpl_add_param_to_list_n_tag(param_list_pp,
-                                       param_id,
-                                       tag,
-                                       &value,
-                                       sizeof(value));
+    mpl_param_descr_set_t *param_descr_p;
+
+    param_descr_p = paramset_find(MPL_PARAMID_TO_PARAMSET(param_id), NULL);
+    if ((NULL == param_descr_p) || !PARAMID_OK(param_id, param_descr_p))
+        return false;
+
+    return (param_descr_p->array2[PARAMID_TO_INDEX(param_id)].children_size > 0);
 }
 
-/**
- * mpl_param_list_add_uint32_tag - add uint32 parameter to param list
- *
- */
-int mpl_param_list_add_uint32_tag(mpl_list_t **param_list_pp,
-                                  mpl_param_element_id_t param_id,
-                                  int tag,
-                                  uint32_t value)
+static int pack_stream_flush(mpl_pack_write_fp write_func,
+                             void *ctx_p,
+                             const char *data_p,
+                             size_t len)
 {
-    return mpl_add_param_to_list_n_tag(param_list_pp,
-                                       param_id,
-                                       tag,
-                                       &value,
-                                       sizeof(value));
+    if (0 == len)
+        return 0;
+
+    if ((*write_func)(ctx_p, data_p, len) < 0)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Write of %zu bytes failed\n", len));
+        set_errno(E_MPL_FAILED_OPERATION);
+        return -1;
+    }
+    return 0;
 }
 
 /**
- * mpl_param_list_add_uint64_tag - add uint64 parameter to param list
+ * pack_hex_array
  *
+ * Pack the value of a uint8/16/32 array (width is the element size):
+ * the length and then the elements, as hex digits. Like snprintf(), the
+ * output is truncated to buflen (to whole elements) and the full length
+ * is returned.
  */
-int mpl_param_list_add_uint64_tag(mpl_list_t **param_list_pp,
-                                  mpl_param_element_id_t param_id,
-                                  int tag,
-                                  uint64_t value)
+static int pack_hex_array(char *buf,
+                          size_t buflen,
+                          uint32_t len,
+                          const void *arr_p,
+                          int width)
 {
-    return mpl_add_param_to_list_n_tag(param_list_pp,
-                                       param_id,
-                                       tag,
-                                       &value,
-                                       sizeof(value));
+    int header_len;
+    size_t num;
+
+    header_len = snprintf(buf, buflen, "=%08" PRIx32, len);
+    if (header_len < 0)
+        return -1;
+
+    if (buflen > (size_t) header_len)
+    {
+        num = (buflen - header_len - 1) / (2 * width);
+        if (num > len)
+            num = len;
+        switch (width)
+        {
+            case 1:
+                mpl_hex_encode_uint8(arr_p, num, buf + header_len);
+                break;
+            case 2:
+                mpl_hex_encode_uint16(arr_p, num, buf + header_len);
+                break;
+            default:
+                mpl_hex_encode_uint32(arr_p, num, buf + header_len);
+                break;
+        }
+        buf[header_len + num * 2 * width] = '\0';
+    }
+
+    return header_len + (int) (len * 2 * width);
 }
 
 /**
- * mpl_param_list_add_sint32_tag - add sint32 parameter to param list
+ * unpack_hex_array_complete
  *
+ * True if an array value has the hex digits of all len elements after
+ * its 8 digit length (the value is not read beyond its end).
  */
-int mpl_param_list_add_sint32_tag(mpl_list_t **param_list_pp,
-                                  mpl_param_element_id_t param_id,
-                                  int tag,
-                                  sint32_t value)
+static bool unpack_hex_array_complete(const char *value_str,
+                                      unsigned int len,
+                                      int width)
 {
-    return mpl_add_param_to_list_n_tag(param_list_pp,
-                                       param_id,
-                                       tag,
-                                       &value,
-                                       sizeof(value));
+    if ((size_t) len > ((((size_t) -1) - 8) / (2 * width)))
+        return false;
+    return (memchr(value_str, '\0', 8 + (size_t) len * 2 * width) == NULL);
 }
 
 /**
- * mpl_param_list_add_sint64_tag - add sint64 parameter to param list
+ * unpack_stream_append
  *
+ * Append input to the text of the parameter being received.
  */
-int mpl_param_list_add_sint64_tag(mpl_list_t **param_list_pp,
-                                  mpl_param_element_id_t param_id,
-                                  int tag,
-                                  int64_t value)
+static int unpack_stream_append(mpl_unpack_stream_t *stream_p,
+                                const char *data_p,
+                                size_t len)
 {
-    return mpl_add_param_to_list_n_tag(param_list_pp,
-                                       param_id,
-                                       tag,
-                                       &value,
-                                       sizeof(value));
+    size_t size;
+    char *new_buf_p;
+
+    if (0 == len)
+        return 0;
+
+    /* Room for the terminating '\0' */
+    if ((stream_p->len + len) >= stream_p->size)
+    {
+        size = (stream_p->size > 0) ? stream_p->size : MPL_UNPACK_STREAM_INITIAL_SIZE;
+        while ((stream_p->len + len) >= size)
+            size *= 2;
+
+        new_buf_p = heap_realloc(stream_p->buf_p, size);
+        if (NULL == new_buf_p)
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                                ("Failed allocating memory\n"));
+            set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+            return -1;
+        }
+        stream_p->buf_p = new_buf_p;
+        stream_p->size = size;
+    }
+
+    memcpy(stream_p->buf_p + stream_p->len, data_p, len);
+    stream_p->len += len;
+    return 0;
 }
 
 /**
- * mpl_param_list_add_bool8_tag - add bool8 parameter to param list
+ * unpack_stream_element
  *
+ * Unpack the received parameter text, if any. Unpack errors are
+ * recorded for the message, only callback and memory failures fail.
  */
-int mpl_param_list_add_bool8_tag(mpl_list_t **param_list_pp,
-                                 mpl_param_element_id_t param_id,
-                                 int tag,
-                                 uint8_t value)
+static int unpack_stream_element(mpl_unpack_stream_t *stream_p)
 {
-    return mpl_add_param_to_list_n_tag(param_list_pp,
-                                       param_id,
-                                       tag,
-                                       &value,
-                                       sizeof(value));
+    mpl_arg_t arg;
+    mpl_arg_t *args_p = &arg;
+    mpl_param_element_t *param_elem_p;
+    int numargs;
+
+    stream_p->in_value = false;
+    stream_p->value_started = false;
+    stream_p->depth = 0;
+
+    if (0 == stream_p->len)
+        return 0;
+
+    stream_p->buf_p[stream_p->len] = '\0';
+    stream_p->len = 0;
+
+    /* The rest of a failed message is skipped */
+    if (stream_p->has_error)
+        return 0;
+
+    numargs = mpl_get_args_2(&args_p,
+                             1,
+                             stream_p->buf_p,
+                             '=',
+                             stream_p->options.message_delimiter,
+                             '\\');
+    if (0 == numargs)
+        return 0;
+
+    stream_p->in_message = true;
+
+    if (numargs < 0)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Malformed param: %s\n", stream_p->buf_p));
+        set_errno(E_MPL_FAILED_OPERATION);
+        stream_p->has_error = true;
+    }
+    else if (mpl_param_unpack_internal(arg.key_p,
+                                       arg.value_p,
+                                       &param_elem_p,
+                                       &stream_p->options,
+                                       MPL_PARAM_ID_UNDEFINED) < 0)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Param unpack failed for param: %s=%s\n",
+                             arg.key_p,
+                             arg.value_p));
+        stream_p->has_error = true;
+    }
+
+    if (stream_p->has_error)
+    {
+        mpl_param_list_destroy(&stream_p->param_list_p);
+        return 0;
+    }
+
+    if (NULL != stream_p->element_func)
+        return (*stream_p->element_func)(stream_p->ctx_p, param_elem_p);
+
+    /* Same order as mpl_param_list_unpack() */
+    mpl_list_add(&stream_p->param_list_p, &param_elem_p->list_entry);
+    return 0;
 }
 
 /**
- * mpl_param_list_add_bool_tag - add bool8 parameter to param list
+ * unpack_stream_message_end
  *
+ * Hand over a completed message. Empty messages are ignored.
  */
-int mpl_param_list_add_bool_tag(mpl_list_t **param_list_pp,
-                                mpl_param_element_id_t param_id,
-                                int tag,
-                                bool value)
+static int unpack_stream_message_end(mpl_unpack_stream_t *stream_p)
 {
-    return mpl_add_param_to_list_n_tag(param_list_pp,
-                                       param_id,
-                                       tag,
-                                       &value,
-                                       sizeof(value));
+    mpl_list_t *param_list_p = stream_p->param_list_p;
+    bool has_error = stream_p->has_error;
+
+    if (!stream_p->in_message)
+        return 0;
+
+    stream_p->param_list_p = NULL;
+    stream_p->has_error = false;
+    stream_p->in_message = false;
+
+    if (NULL == stream_p->message_func)
+    {
+        mpl_param_list_destroy(&param_list_p);
+        return 0;
+    }
+
+    return (*stream_p->message_func)(stream_p->ctx_p, param_list_p, has_error);
 }
 
 /**
- * mpl_param_list_add_enum_tag - add enum parameter to param list
- *
- */
-int mpl_param_list_add_enum_tag(mpl_list_t **param_list_pp,
-                                mpl_param_element_id_t param_id,
-                                int tag,
-                                int64_t value)
+ * strchr_escape()
+ **/
+static char *strchr_escape(char *s, char c, char escape)
 {
-    return mpl_add_param_to_list_n_tag(param_list_pp,
-                                       param_id,
-                                       tag,
-                                       &value,
-                                       mpl_param_id_sizeof_param_value(param_id));
+    char *p = s;
+    char *e;
+
+    while (p && *p) {
+        p = strchr(p, c);
+        // did we find an escaped character?
+        if (p==NULL)
+            continue;
+        e = p;
+        while (e && (e > s) && (*(e-1) == escape))
+            e--;
+        if (1 == ((p - e) % 2)) {
+            // An odd number of escapes in a row: yes
+            p++;
+            continue;
+        }
+        else
+            break;
+    }
+    return p;
 }
 
+
 /**
- * mpl_param_list_add_enum8_tag - add enum parameter to param list
+ * escaped_len()
  *
- */
-int mpl_param_list_add_enum8_tag(mpl_list_t **param_list_pp,
-                                 mpl_param_element_id_t param_id,
-                                 int tag,
-                                 uint8_t value)
-{
-    return mpl_add_param_to_list_n_tag(param_list_pp,
-                                       param_id,
-                                       tag,
-                                       &value,
-                                       sizeof(value));
+ * Length of len characters when the delimiter and escape characters are
+ * escaped.
+ **/
+static size_t escaped_len(const char *text_p, size_t len,
+                          char delimiter, char escape)
+{
+    size_t i;
+    size_t n = len;
+
+    for (i = 0; i < len; i++)
+    {
+        if ((text_p[i] == delimiter) || (text_p[i] == escape))
+            n++;
+    }
+    return n;
 }
 
 /**
- * mpl_param_list_add_enum16_tag - add enum parameter to param list
+ * snprintf_escape()
  *
- */
-int mpl_param_list_add_enum16_tag(mpl_list_t **param_list_pp,
-                                  mpl_param_element_id_t param_id,
-                                  int tag,
-                                  uint16_t value)
+ * Like snprintf(), with the delimiter and escape characters of the
+ * output escaped. The output is truncated to size (never between an
+ * escape and the escaped character) and the full length is returned.
+ **/
+static int snprintf_escape(char delimiter, char escape,
+                           char *str, size_t size, const char *format, ...)
 {
-    return mpl_add_param_to_list_n_tag(param_list_pp,
-                                       param_id,
-                                       tag,
-                                       &value,
-                                       sizeof(value));
+    char buf[128];
+    char *tmpstr = buf;
+    int n;
+    size_t i;
+    size_t d;
+    va_list ap;
+
+    va_start(ap, format);
+    n = vsnprintf(buf, sizeof(buf), format, ap);
+    va_end(ap);
+    if (n < 0)
+        return n;
+
+    if ((size_t)n >= sizeof(buf))
+    {
+        tmpstr = malloc(n + 1);
+        if (tmpstr == NULL)
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                                ("Failed allocating memory\n"));
+            set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+            return -1;
+        }
+        va_start(ap, format);
+        n = vsnprintf(tmpstr, n + 1, format, ap);
+        va_end(ap);
+    }
+
+    if (size > 0)
+    {
+        d = 0;
+        for (i = 0; i < (size_t)n; i++)
+        {
+            if ((tmpstr[i] == delimiter) || (tmpstr[i] == escape))
+            {
+                if ((d + 2) >= size)
+                    break;
+                str[d++] = escape;
+            }
+            else if ((d + 1) >= size)
+                break;
+            str[d++] = tmpstr[i];
+        }
+        str[d] = '\0';
+    }
+
+    i = escaped_len(tmpstr, n, delimiter, escape);
+    if (tmpstr != buf)
+        free(tmpstr);
+    return (int)i;
 }
 
-/**
- * mpl_param_list_add_enum32_tag - add enum parameter to param list
- *
- */
-int mpl_param_list_add_enum32_tag(mpl_list_t **param_list_pp,
-                                  mpl_param_element_id_t param_id,
-                                  int tag,
-                                  uint32_t value)
+static char *remove_escape(const char *src, char escape)
 {
-    return mpl_add_param_to_list_n_tag(param_list_pp,
-                                       param_id,
-                                       tag,
-                                       &value,
-                                       sizeof(value));
+    char *s;
+    char *d;
+    char *dst = strdup(src);
+
+    if (dst == NULL) {
+        return NULL;
+    }
+
+    s = (char*) src;
+    d = dst;
+    while (*s) {
+        /* A trailing escape is kept */
+        if ((*s == escape) && (s[1] != '\0')) {
+            s++;
+        }
+        *d = *s;
+        d++;
+        s++;
+    }
+    *d = '\0';
+    return (dst);
 }
 
-/**
- * mpl_param_list_add_signed_enum8_tag - add enum parameter to param list
- *
- */
-int mpl_param_list_add_signed_enum8_tag(mpl_list_t **param_list_pp,
-                                        mpl_param_element_id_t param_id,
-                                        int tag,
-                                        sint8_t value)
+static char *get_matching_close_bracket(char open_bracket, char close_bracket, char *str_p, char escape)
 {
-    return mpl_add_param_to_list_n_tag(param_list_pp,
-                                       param_id,
-                                       tag,
-                                       &value,
-                                       sizeof(value));
+    int num_open = 0;
+    char *p;
+
+    p = str_p;
+
+    if (*p != open_bracket)
+        return NULL;
+
+    while (*p) {
+        if (*p == escape) {
+            p++;
+            continue;
+        }
+
+        if (*p == open_bracket)
+            num_open++;
+        if (*p == close_bracket)
+            num_open--;
+        if (num_open == 0)
+            return p;
+        p++;
+    }
+
+    return NULL;
+}
+
+static char *get_bracket_contents(const char *str,
+                                  char open_bracket,
+                                  char close_bracket,
+                                  size_t *len_p)
+{
+    char *e;
+    char *s = strchr_escape((char*)str, open_bracket, '\\');
+    if (s == NULL)
+        return NULL;
+    e = get_matching_close_bracket(open_bracket,
+                                   close_bracket,
+                                   s,
+                                   '\\');
+    if (e == NULL)
+        return NULL;
+    s++;
+    assert(len_p);
+    *len_p = e - s;
+    return s;
 }
 
+
 /**
- * mpl_param_list_add_signed_enum16_tag - add enum parameter to param list
+ * parse_integer()
  *
- */
-int mpl_param_list_add_signed_enum16_tag(mpl_list_t **param_list_pp,
-                                         mpl_param_element_id_t param_id,
-                                         int tag,
-                                         sint16_t value)
-{
-    return mpl_add_param_to_list_n_tag(param_list_pp,
-                                       param_id,
-                                       tag,
-                                       &value,
-                                       sizeof(value));
+ * Like strtoull(): optional white space and sign, then digits, which are
+ * hex after "0x" and otherwise octal after a leading 0 if c_syntax is
+ * set, else decimal. Does not depend on the locale. Returns a pointer
+ * to the first character not used (value_str if there are no digits),
+ * or NULL if the magnitude does not fit in 64 bits.
+ **/
+static const char *parse_integer(const char *value_str,
+                                 bool c_syntax,
+                                 bool *negative_p,
+                                 uint64_t *magnitude_p)
+{
+    const char *p = value_str;
+    const char *digits_p;
+    uint64_t magnitude = 0;
+    unsigned int digit;
+    unsigned int base = 10;
+
+    while ((*p == ' ') || ((*p >= '\t') && (*p <= '\r')))
+        p++;
+
+    *negative_p = (*p == '-');
+    if ((*p == '-') || (*p == '+'))
+        p++;
+
+    if ((p[0] == '0') && ((p[1] == 'x') || (p[1] == 'X')) &&
+        isxdigit((unsigned char)p[2]))
+    {
+        base = 16;
+        p += 2;
+    }
+    else if (c_syntax && (p[0] == '0'))
+        base = 8;
+
+    digits_p = p;
+    if (base == 16)
+    {
+        for (;; p++)
+        {
+            if ((unsigned int)(*p - '0') < 10)
+                digit = *p - '0';
+            else if ((unsigned int)((*p | 0x20) - 'a') < 6)
+                digit = (*p | 0x20) - 'a' + 10;
+            else
+                break;
+            if (magnitude > (UINT64_MAX >> 4))
+                return NULL;
+            magnitude = (magnitude << 4) | digit;
+        }
+    }
+    else
+    {
+        for (; (digit = (unsigned int)(*p - '0')) < base; p++)
+        {
+            if ((magnitude > (UINT64_MAX / base)) ||
+                ((magnitude * base) > (UINT64_MAX - digit)))
+                return NULL;
+            magnitude = magnitude * base + digit;
+        }
+    }
+
+    if (p == digits_p)
+        return value_str;
+
+    *magnitude_p = magnitude;
+    return p;
 }
 
 /**
- * mpl_param_list_add_signed_enum32_tag - add enum parameter to param list
+ * convert_int()
  *
- */
-int mpl_param_list_add_signed_enum32_tag(mpl_list_t **param_list_pp,
-                                         mpl_param_element_id_t param_id,
-                                         int tag,
-                                         sint32_t value)
+ * As convert_int64(), with the value truncated to an int (as when the
+ * strtol() result was assigned), so e.g. 0x80000000 is INT_MIN.
+ **/
+static int
+    convert_int(const char* value_str, int *value_p)
 {
-    return mpl_add_param_to_list_n_tag(param_list_pp,
-                                       param_id,
-                                       tag,
-                                       &value,
-                                       sizeof(value));
+    int64_t value;
+
+    assert(NULL != value_p);
+
+    if (convert_int64(value_str, &value) < 0)
+        return (-1);
+
+    *value_p = (int)value;
+    return (0);
 }
 
 /**
- * mpl_remove_from_blacklist - remove parameter id from blacklist
- *
- */
-int mpl_remove_from_blacklist(mpl_blacklist_t *blacklist_p,
-                              mpl_param_element_id_t param_id)
+ * convert_int64()
+ **/
+static int
+    convert_int64(const char* value_str, int64_t *value_p)
 {
-    mpl_param_element_t *elem_p;
+    const char *endp;
+    bool negative;
+    uint64_t magnitude;
 
-    elem_p = mpl_param_list_find(param_id, *blacklist_p);
+    assert(NULL != value_p);
+    assert(NULL != value_str);
 
-    if (elem_p == NULL)
+    /* Empty strings are not allowed */
+    if (*value_str == '\0')
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                            ("empty string is not an acceptable integer value\n"));
+        set_errno(E_MPL_INVALID_PARAMETER);
         return -1;
+    }
 
-    (void) mpl_list_remove(blacklist_p, &elem_p->list_entry);
+    endp = parse_integer(value_str, true, &negative, &magnitude);
+    if ((NULL == endp) ||
+        (magnitude > ((uint64_t)INT64_MAX + (negative ? 1 : 0))))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                            ("Integer value out of range: %s\n", value_str));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return (-1);
+    }
 
-    mpl_param_element_destroy(elem_p);
+    /* The whole string should be a number */
+    if (*endp != '\0')
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                            ("Not an acceptable integer value: %s\n", value_str));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return (-1);
+    }
 
-    return 0;
+    *value_p = negative ? (int64_t)(0 - magnitude) : (int64_t)magnitude;
+    return (0);
 }
 
 /**
- * mpl_trimstring()
+ * convert_uint64()
+ *
+ * Decimal, or hex with "0x". A minus sign negates modulo 2^64, as
+ * strtoull() does, and an empty string is 0.
  **/
-char *mpl_trimstring(char *s, char escape)
+static int
+    convert_uint64(const char* value_str, uint64_t *value_p)
 {
-    char *p = s;
-    char *e;
-
-    // Trim start
-    while (strlen(s) && isspace(s[0]))
-        s++;
+    const char *endp;
+    bool negative;
+    uint64_t magnitude;
 
-    // Trim end, taking escape into account
-    p = s + (strlen(s) - 1);
+    assert(NULL != value_p);
+    assert(NULL != value_str);
 
-    while ((p > s) && isspace(*p)) {
-        // did we find an escaped character?
-        e = p;
-        while (e && (e > s) && (*(e-1) == escape))
-            e--;
+    if (*value_str == '\0')
+    {
+        *value_p = 0;
+        return (0);
+    }
 
-        // An odd number of escapes in a row? (then it is escaped)
-        if (1 == ((p - e) % 2))
-            break;
+    endp = parse_integer(value_str, false, &negative, &magnitude);
+    if (NULL == endp)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                            ("Integer value out of range: %s\n", value_str));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return (-1);
+    }
 
-        *p = '\0';
-        p--;
+    /* The whole string should be a number */
+    if (*endp != '\0')
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                            ("Not an acceptable integer value: %s\n", value_str));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return (-1);
     }
 
-    return s;
+    *value_p = negative ? (0 - magnitude) : magnitude;
+    return (0);
 }
 
 /**
- * mpl_get_errno
+ * pack_text()
  *
- */
-int mpl_get_errno()
+ * Copy len characters to buf, truncating and returning len like
+ * snprintf().
+ **/
+static int pack_text(char *buf, size_t buflen, const char *text_p, size_t len)
 {
-    mpl_pc_t* pc_p = get_pc();
-    if (pc_p)
-    {
-        return pc_p->error;
-    }
-    else
+    size_t n;
+
+    if (buflen > 0)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Could not find process context\n"));
-        return -1;
+        n = (len < buflen) ? len : (buflen - 1);
+        memcpy(buf, text_p, n);
+        buf[n] = '\0';
     }
+    return (int)len;
 }
 
-
 /**
- * mpl_compare_param_lists
+ * pack_name()
  *
- */
-int mpl_compare_param_lists(mpl_list_t *list1_p, mpl_list_t *list2_p)
+ * Same as snprintf(buf, buflen, "=%s", name_p).
+ **/
+static int pack_name(char *buf, size_t buflen, const char *name_p)
 {
-    mpl_list_t *list_p;
-    mpl_param_element_t* param_elem1_p;
-    mpl_param_element_t* param_elem2_p;
-
-    if ((NULL == list1_p) && (NULL != list2_p)) {
-        return -1;
-    }
+    size_t len = strlen(name_p);
 
-    if ((NULL == list2_p) && (NULL != list1_p)) {
-        return -1;
+    if (buflen > 1)
+    {
+        buf[0] = '=';
+        (void)pack_text(buf + 1, buflen - 1, name_p, len);
     }
+    else if (buflen == 1)
+        buf[0] = '\0';
+    return (int)len + 1;
+}
 
-    MPL_LIST_FOR_EACH(list1_p, list_p)
-    {
-        param_elem1_p = MPL_LIST_CONTAINER(list_p, mpl_param_element_t, list_entry);
+static const char decimal_pairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
 
-        if (MPL_PARAM_ELEMENT_IS_FIELD(param_elem1_p)) {
-            if (!MPL_FIELD_PRESENT_IN_LIST_TAG(param_elem1_p->context,
-                                               param_elem1_p->id_in_context,
-                                               param_elem1_p->tag,
-                                               list2_p)) {
-                return -1;
-            }
-            param_elem2_p = mpl_param_list_find_field_tag(param_elem1_p->context,
-                                                          param_elem1_p->id_in_context,
-                                                          param_elem1_p->tag,
-                                                          list2_p);
-        }
-        else {
-            if (!MPL_PARAM_PRESENT_IN_LIST(param_elem1_p->id, list2_p)) {
-                return -1;
-            }
-            param_elem2_p = mpl_param_list_find_tag(param_elem1_p->id, param_elem1_p->tag, list2_p);
-        }
+/**
+ * pack_int()
+ *
+ * Same as snprintf(buf, buflen, "=%" PRIi64, value).
+ **/
+static int pack_int(char *buf, size_t buflen, int64_t value)
+{
+    char tmp[24];
+    char *p = tmp + sizeof(tmp);
+    uint64_t u = (value < 0) ? (0 - (uint64_t)value) : (uint64_t)value;
+    unsigned int pair;
 
-        if (0 != mpl_param_element_compare(param_elem1_p, param_elem2_p))
-        {
-            return -1;
-        }
+    while (u >= 100)
+    {
+        pair = (unsigned int)(u % 100) * 2;
+        u /= 100;
+        *--p = decimal_pairs[pair + 1];
+        *--p = decimal_pairs[pair];
     }
-
-    MPL_LIST_FOR_EACH(list2_p, list_p)
+    if (u >= 10)
     {
-        param_elem2_p = MPL_LIST_CONTAINER(list_p, mpl_param_element_t, list_entry);
-
-        if (MPL_PARAM_ELEMENT_IS_FIELD(param_elem2_p)) {
-            if (!MPL_FIELD_PRESENT_IN_LIST_TAG(param_elem2_p->context,
-                                               param_elem2_p->id_in_context,
-                                               param_elem2_p->tag,
-                                               list1_p)) {
-                return -1;
-            }
-            param_elem1_p = mpl_param_list_find_field_tag(param_elem2_p->context,
-                                                          param_elem2_p->id_in_context,
-                                                          param_elem2_p->tag,
-                                                          list1_p);
-        }
-        else {
-            if (!MPL_PARAM_PRESENT_IN_LIST(param_elem2_p->id, list1_p)) {
-                return -1;
-            }
-            param_elem1_p = mpl_param_list_find_tag(param_elem2_p->id, param_elem2_p->tag, list1_p);
-        }
-
-        if (0 != mpl_param_element_compare(param_elem2_p, param_elem1_p))
-        {
-            return -1;
-        }
+        *--p = decimal_pairs[u * 2 + 1];
+        *--p = decimal_pairs[u * 2];
     }
-    return 0;
-}
+    else
+        *--p = (char)('0' + u);
+    if (value < 0)
+        *--p = '-';
+    *--p = '=';
 
-int mpl_convert_int(const char* value_str, int *value_p)
-{
-    return convert_int(value_str, value_p);
+    return pack_text(buf, buflen, p, tmp + sizeof(tmp) - p);
 }
 
-
 /**
- * mpl_set_errno
+ * pack_hex()
  *
- */
-void mpl_set_errno(int error_value)
+ * Same as snprintf(buf, buflen, "=0x%" PRIx64, value).
+ **/
+static int pack_hex(char *buf, size_t buflen, uint64_t value)
 {
-    set_errno(error_value);
-}
+    static const char digits[] = "0123456789abcdef";
+    char tmp[24];
+    char *p = tmp + sizeof(tmp);
 
-/****************************************************************************
- *
- * Private Functions
- *
- ****************************************************************************/
+    do
+    {
+        *--p = digits[value & 0xf];
+        value >>= 4;
+    } while (value != 0);
+    *--p = 'x';
+    *--p = '0';
+    *--p = '=';
 
+    return pack_text(buf, buflen, p, tmp + sizeof(tmp) - p);
+}
 
-static void *allocate_and_copy_max(mpl_type_t mpl_type, uint64_t max)
+/**
+ * decimal_width()
+ *
+ * Number of characters of value in decimal, with a '-' if negative.
+ **/
+static int decimal_width(int64_t value)
 {
-    void *ret_p = NULL;
+    uint64_t u = (value < 0) ? (0 - (uint64_t)value) : (uint64_t)value;
+    int width = (value < 0) ? 2 : 1;
 
-    switch (mpl_type) {
-        case mpl_type_int:
-        case mpl_type_string:
-        case mpl_type_wstring:
-        case mpl_type_uint8_array:
-        case mpl_type_uint16_array:
-        case mpl_type_uint32_array:
-        case mpl_type_string_tuple:
-        case mpl_type_int_tuple:
-        case mpl_type_strint_tuple:
-        case mpl_type_bag:
-            ret_p = malloc(sizeof(int));
-            if (ret_p == NULL)
-                break;
-            *((int*)ret_p) = (int) max;
-            break;
-        case mpl_type_sint8:
-            ret_p = malloc(sizeof(sint8_t));
-            if (ret_p == NULL)
-                break;
-            *((sint8_t*)ret_p) = (sint8_t) max;
-            break;
-        case mpl_type_sint16:
-            ret_p = malloc(sizeof(sint16_t));
-            if (ret_p == NULL)
-                break;
-            *((sint16_t*)ret_p) = (sint16_t) max;
-            break;
-        case mpl_type_sint32:
-            ret_p = malloc(sizeof(sint32_t));
-            if (ret_p == NULL)
-                break;
-            *((sint32_t*)ret_p) = (sint32_t) max;
-            break;
-        case mpl_type_sint64:
-            ret_p = malloc(sizeof(int64_t));
-            if (ret_p == NULL)
-                break;
-            *((int64_t*)ret_p) = (int64_t) max;
-            break;
-        case mpl_type_uint8:
-        case mpl_type_struint8_tuple:
-            ret_p = malloc(sizeof(uint8_t));
-            if (ret_p == NULL)
-                break;
-            *((uint8_t*)ret_p) = (uint8_t) max;
-            break;
-        case mpl_type_uint16:
-            ret_p = malloc(sizeof(uint16_t));
-            if (ret_p == NULL)
-                break;
-            *((uint16_t*)ret_p) = (uint16_t) max;
-            break;
-        case mpl_type_uint32:
-            ret_p = malloc(sizeof(uint32_t));
-            if (ret_p == NULL)
-                break;
-            *((uint32_t*)ret_p) = (uint32_t) max;
-            break;
-        case mpl_type_uint64:
-            ret_p = malloc(sizeof(uint64_t));
-            if (ret_p == NULL)
-                break;
-            *((uint64_t*)ret_p) = max;
-            break;
-        default:
-            assert(0);
+    while (u >= 10)
+    {
+        u /= 10;
+        width++;
     }
+    return width;
+}
 
-    if (ret_p == NULL)
+/**
+ * hex_width()
+ *
+ * Number of hex digits of value, without leading zeros.
+ **/
+static int hex_width(uint64_t value)
+{
+    int width = 1;
+
+    while (value >= 16)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
+        value >>= 4;
+        width++;
     }
-    return ret_p;
+    return width;
 }
 
-
-static int upgrade_param_descr_set(mpl_param_descr_set_t *param_descr_p)
+/**
+ * convert_stringarr_to_int()
+ **/
+static int
+    convert_stringarr_to_int(const char* value_str,
+                             int *value_p,
+                             const char* stringarr[],
+                             int stringarr_size)
 {
-    int size;
-    int i;
-    int upgrade = 0;
-    mpl_param_descr_t *pd_p;
-    mpl_param_descr2_t *pd2_p;
+    int index;
 
-    size = PARAM_SET_SIZE(param_descr_p);
-    if (MPL_PARAMID_TO_PARAMSET(param_descr_p->paramid_enum_size) == param_descr_p->param_set_id) {
-        /* the enum size indicates that this is an old
-           parameter set and must be re-calculated */
-        int base = MPL_PARAM_SET_ID_TO_PARAMID_BASE(param_descr_p->param_set_id);
-        size = param_descr_p->paramid_enum_size - 1 - base;
-        param_descr_p->paramid_enum_size = size + 1;
-    }
+    assert(NULL != value_p);
+    assert(NULL != value_str);
+    assert(NULL != stringarr);
 
-    for (i = 0; i < size; i++) {
-        pd_p = (mpl_param_descr_t *) &param_descr_p->array[i];
-        if ((pd_p->max_p != NULL) || (pd_p->stringarr != NULL)) {
-            upgrade = 1;
-            break;
+    for (index=0; index<stringarr_size; index++)
+    {
+        assert(NULL != stringarr[index]);
+        if (0 == strcmp( value_str, stringarr[index]))
+        {
+            *value_p = index;
+            return (0);
         }
     }
 
-    if (!upgrade)
-        return 0;
+    return (-1);
+}
 
-    param_descr_p->array2 = calloc(size, sizeof(mpl_param_descr2_t));
-    if (param_descr_p->array2 == NULL) {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        return -1;
-    }
-    param_descr_p->is_dynamic_array2 = true;
-    for (i = 0; i < size; i++) {
-        int j;
-        /* Only positive values in old enums, and no holes */
-        enum {
-            dummy_small_min = 0,
-            dummy_small_max = 127
-        } dummy_small_enum;
+#if !defined(__linux__) && !defined(WIN32)
+static char *mpl_strdup(const char *s)
+{
+    char *tmp;
+    int len;
+    len = strlen(s)+1;
+    tmp = malloc(len);
+    if (tmp == NULL)
+        return NULL;
+    memset(tmp,0,len);
+    strcpy(tmp,s);
+    return tmp;
+}
+#endif
+
+
+static int
+    convert_enum_name_to_int64(const char* name_p,
+                               int64_t *value_p,
+                               const mpl_param_descr2_t *descr_p)
+{
+    const mpl_enum_value_t *enum_values = descr_p->enum_values;
+    int enum_values_size = descr_p->enum_values_size;
+    int index;
 
-        enum {
-            dummy_medium_min = 0,
-            dummy_medium_max = 255
-        } dummy_medium_enum;
+    assert(NULL != value_p);
+    assert(NULL != name_p);
+    assert(NULL != enum_values);
 
-        enum {
-            dummy_big_min = 0,
-            dummy_big_max = INT_MAX
-        } dummy_big_enum;
+    /* Small arrays are faster to search */
+    if ((enum_values_size >= MPL_NAME_INDEX_MIN_SIZE) &&
+        (NULL != descr_p->enum_table_p) &&
+        (NULL != descr_p->enum_table_p->name_slots))
+    {
+        index = enum_table_name_lookup(name_p,
+                                       descr_p->enum_table_p,
+                                       enum_values);
+        if (index < 0)
+            return (-1);
+        *value_p = enum_values[index].value;
+        return (0);
+    }
 
-        pd_p = (mpl_param_descr_t *) &param_descr_p->array[i];
-        pd2_p = (mpl_param_descr2_t *) &param_descr_p->array2[i];
-        if (pd_p->max_p != NULL) {
-            pd2_p = (mpl_param_descr2_t *) &param_descr_p->array2[i];
-            pd2_p->max_p = allocate_and_copy_max(pd_p->type, *pd_p->max_p);
+    if (enum_values_size >= MPL_NAME_INDEX_MIN_SIZE)
+    {
+        index = enum_index_lookup(name_p, enum_values);
+        if (index >= 0)
+        {
+            *value_p = enum_values[index].value;
+            return (0);
         }
+        if (index == -1)
+            return (-1);
+        /* No index, search */
+    }
 
-        if (pd_p->stringarr != NULL) {
-            mpl_enum_value_t *enum_values;
-            pd2_p->enum_values = calloc(pd_p->stringarr_size, sizeof(mpl_enum_value_t));
-            if (pd2_p->enum_values == NULL) {
-                MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                                    ("Failed allocating memory\n"));
-                return -1;
-            }
-            enum_values = (mpl_enum_value_t *) pd2_p->enum_values;
-            for (j = 0; j < pd_p->stringarr_size; j++) {
-                enum_values[j].name_p = pd_p->stringarr[j];
-                enum_values[j].value = j;
-            }
-            pd2_p->enum_values_size = pd_p->stringarr_size;
-            if (j < 128)
-                pd2_p->enum_representation_bytesize =
-                    sizeof(dummy_small_enum);
-            else if (j < 256)
-                pd2_p->enum_representation_bytesize =
-                    sizeof(dummy_medium_enum);
-            else
-                pd2_p->enum_representation_bytesize =
-                    sizeof(dummy_big_enum);
-            pd2_p->enum_representation_signed = false;
+    for (index = 0; index < enum_values_size; index++)
+    {
+        assert(NULL != enum_values[index].name_p);
+        if (!strcmp(name_p, enum_values[index].name_p))
+        {
+            *value_p = enum_values[index].value;
+            return (0);
         }
-    } /*lint !e550 */
+    }
 
-    return 1;
+    return (-1);
 }
 
+static const char *convert_enum_value_to_name(int64_t value,
+                                              const mpl_param_descr2_t *descr_p)
+{
+    const mpl_enum_value_t *enum_values = descr_p->enum_values;
+    int enum_values_size = descr_p->enum_values_size;
+    const mpl_enum_index_entry_t *entry_p;
+    int low;
+    int high;
+    int mid;
+    int index;
 
-/**
- * get_pc
- *
- */
-static mpl_pc_t* get_pc(void)
-{
-    mpl_pc_t* pc_p;
-    mpl_thread_t pid;
-    mpl_list_t *elem_p;
-    int i;
-
-    pid = mpl_get_current_thread_id();
+    assert(NULL != enum_values);
 
-    (void)mpl_mutex_lock(mutex);
-    MPL_LIST_FOR_EACH(mpl_pc_list_p, elem_p)
+    if ((enum_values_size >= MPL_NAME_INDEX_MIN_SIZE) &&
+        (NULL != descr_p->enum_table_p) &&
+        (NULL != descr_p->enum_table_p->by_value))
     {
-        pc_p = MPL_LIST_CONTAINER(elem_p, mpl_pc_t, list_entry);
-        if (pc_p->pid == pid)
-        {
-            (void)mpl_mutex_unlock(mutex);
-            goto found;
-        }
+        index = enum_table_value_lookup(value,
+                                        descr_p->enum_table_p,
+                                        enum_values);
+        if (index < 0)
+            return NULL;
+        return enum_values[index].name_p;
     }
-    (void)mpl_mutex_unlock(mutex);
 
-    pc_p = malloc(sizeof(mpl_pc_t));
-    if (NULL == pc_p)
+    if ((enum_values_size >= MPL_NAME_INDEX_MIN_SIZE) &&
+        (NULL != (entry_p = enum_index_get(enum_values))))
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
+        /* First position having the value */
+        low = 0;
+        high = enum_values_size;
+        while (low < high)
+        {
+            mid = low + (high - low) / 2;
+            if (enum_values[entry_p->by_value[mid]].value < value)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+        if ((low < enum_values_size) &&
+            (enum_values[entry_p->by_value[low]].value == value))
+            return enum_values[entry_p->by_value[low]].name_p;
         return NULL;
     }
-    memset(pc_p, 0, sizeof(mpl_pc_t));
-    for (i = 0; i < num_scratch_strings; i++) {
-        pc_p->scratch_string[i] = malloc(initial_scratch_string_len);
-        if (pc_p->scratch_string[i] == NULL)
+
+    for (index = 0; index < enum_values_size; index++) {
+        if (value == enum_values[index].value)
         {
-            i--;
-            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                                ("Failed allocating memory\n"));
-            /* free previously allocated scratch strings */
-            for(;i>=0;i--)/*lint !e445 reuse of i is ok */
-                free(pc_p->scratch_string[i]);
-            free(pc_p);
-            return NULL;
+            assert(NULL != enum_values[index].name_p);
+            return enum_values[index].name_p;
         }
-        pc_p->scratch_string_len[i] = initial_scratch_string_len;
     }
-    pc_p->pid = pid;
 
-    (void)mpl_mutex_lock(mutex);
-    mpl_list_add(&mpl_pc_list_p, &pc_p->list_entry);
-    (void)mpl_mutex_unlock(mutex);
+    return NULL;
+}
 
-found:
-    return pc_p;
+/**
+ * enum_table_name_lookup
+ *
+ * Returns position of name in enum value array, or -1 if not found.
+ */
+static int enum_table_name_lookup(const char *name_p,
+                                  const mpl_enum_table_t *table_p,
+                                  const mpl_enum_value_t enum_values[])
+{
+    uint32_t hash = name_hash(name_p, strlen(name_p));
+    uint32_t displace = table_p->name_displace[hash & table_p->name_bucket_mask];
+    int index;
+
+    index = table_p->name_slots[MPL_ENUM_TABLE_SLOT(hash, displace) &
+                                table_p->name_slot_mask];
+    if ((index < 0) || strcmp(name_p, enum_values[index].name_p))
+        return -1;
+    return index;
 }
 
 /**
- * set_errno
+ * enum_table_value_lookup
  *
+ * Returns first position of value in enum value array, or -1 if not found.
  */
-static void set_errno(int error_value)
+static int enum_table_value_lookup(int64_t value,
+                                   const mpl_enum_table_t *table_p,
+                                   const mpl_enum_value_t enum_values[])
 {
-    mpl_pc_t* pc_p = get_pc();
-    if (pc_p)
+    uint64_t offset;
+    int low;
+    int high;
+    int mid;
+
+    if (table_p->value_dense)
     {
-        pc_p->error = error_value;
+        if (value < table_p->value_min)
+            return -1;
+        offset = (uint64_t)value - (uint64_t)table_p->value_min;
+        if (offset >= (uint64_t)table_p->by_value_size)
+            return -1;
+        return table_p->by_value[offset];
     }
-    else
+
+    low = 0;
+    high = table_p->by_value_size;
+    while (low < high)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Could not find process context\n"));
+        mid = low + (high - low) / 2;
+        if (enum_values[table_p->by_value[mid]].value < value)
+            low = mid + 1;
+        else
+            high = mid;
     }
+    if ((low < table_p->by_value_size) &&
+        (enum_values[table_p->by_value[low]].value == value))
+        return table_p->by_value[low];
+    return -1;
 }
 
-/**
- * get_scratch_string
- *
- */
-static char *get_scratch_string(int len)
+static int check_integer_ranges(int64_t value,
+                                const mpl_integer_range_t integer_ranges[],
+                                int integer_ranges_size)
 {
-    mpl_pc_t* pc_p = get_pc();
-    if (pc_p)
+    const mpl_range_index_entry_t *entry_p;
+    int low;
+    int high;
+    int mid;
+    int i;
+
+    if ((integer_ranges_size >= MPL_RANGE_INDEX_MIN_SIZE) &&
+        (NULL != (entry_p = range_index_get(integer_ranges))))
     {
-        if (pc_p->scratch_string_current >= num_scratch_strings)
-            pc_p->scratch_string_current = 0;
-        if (len > pc_p->scratch_string_len[pc_p->scratch_string_current])
+        /* Last interval starting at or below value */
+        low = 0;
+        high = entry_p->num_intervals;
+        while (low < high)
         {
-            pc_p->scratch_string[pc_p->scratch_string_current] =
-                realloc(pc_p->scratch_string[pc_p->scratch_string_current], len);
-            if (pc_p->scratch_string[pc_p->scratch_string_current] == NULL)
-            {
-                MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                                    ("Failed allocating memory\n"));
-                pc_p->scratch_string_len[pc_p->scratch_string_current] = 0;
-                return NULL;
-            }
+            mid = low + (high - low) / 2;
+            if (entry_p->intervals[mid].first <= value)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+        if ((low > 0) && (value <= entry_p->intervals[low - 1].last))
+            return ((int) entry_p->intervals[low - 1].id);
+        return -1;
+    }
 
-            pc_p->scratch_string_len[pc_p->scratch_string_current] = len;
+    for (i = 0; i < integer_ranges_size; i++) {
+        assert(integer_ranges[i].first <= integer_ranges[i].last);
+        if ((value >= integer_ranges[i].first) &&
+            (value <= integer_ranges[i].last)) {
+            return ((int) integer_ranges[i].id);
         }
+    }
+    return -1;
+}
 
-        return pc_p->scratch_string[pc_p->scratch_string_current++];
+static const mpl_field_value_t *get_field_from_id(int field_id,
+                                                  const mpl_field_value_t field_values[],
+                                                  int field_values_size)
+{
+    int i;
+
+    if (field_values_size == 0)
+        return NULL;
+
+    for (i = 0; i < field_values_size; i++)
+    {
+        if (field_values[i].field_id == field_id)
+            return &field_values[i];
     }
 
-    MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                        ("Could not find process context\n"));
     return NULL;
 }
 
-/**
- * paramset_find
- *
- */
-static mpl_param_descr_set_t* paramset_find(int param_set_id,
-                                            char *paramid_prefix)
+static const mpl_field_value_t *get_field_from_name(const char *field_str,
+                                                    size_t field_strlen,
+                                                    const mpl_param_descr_set_t *param_descr_p,
+                                                    int index)
 {
-    mpl_list_t *elem_p;
-    mpl_param_descr_set_t *paramset_p = NULL;
-    bool id_match = false;
-    bool prefix_match = false;
-    mpl_pc_t* pc_p = get_pc();
+    const mpl_field_value_t *field_values = param_descr_p->array2[index].field_values;
+    int field_values_size = param_descr_p->array2[index].field_values_size;
+    const mpl_paramset_index_t *index_p = param_descr_p->index_p;
+    int i;
 
-    if (NULL == pc_p)
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
-                            ("Could not find process context\n"));
+    if (field_values_size == 0 || field_str == NULL)
         return NULL;
+
+    if ((NULL != index_p) &&
+        (NULL != index_p->fields) &&
+        (NULL != index_p->fields[index].entries))
+    {
+        i = name_index_lookup(&index_p->fields[index], field_str, field_strlen);
+        return (i >= 0) ? &field_values[i] : NULL;
     }
 
-    (void)mpl_mutex_lock(mutex);
-    MPL_LIST_FOR_EACH(paramset_list_p, elem_p)
+    for (i = 0; i < field_values_size; i++)
     {
-        paramset_p = MPL_LIST_CONTAINER(elem_p,
-                                        mpl_paramset_container_t,
-                                        list_entry)->paramset_p;
+        if ((strlen(field_values[i].name_p) == field_strlen) &&
+            (0 == strncmp(field_values[i].name_p, field_str, field_strlen)))
+            return &field_values[i];
+    }
 
-        if ((param_set_id > 0) && (paramset_p->param_set_id == param_set_id))
-        {
-            id_match = true;
-            if (NULL == paramid_prefix)
-            {
-                (void)mpl_mutex_unlock(mutex);
-                return paramset_p;
-            }
-        }
+    return NULL;
+}
 
-        if ((NULL != paramid_prefix) &&
-            !strncmp(paramset_p->paramid_prefix,
-                     paramid_prefix,
-                     MPL_PARAMID_PREFIX_MAXLEN))
-        {
-            prefix_match = true;
-            if (param_set_id <= 0)
-            {
-                (void)mpl_mutex_unlock(mutex);
-                return paramset_p;
-            }
-        }
+static const char *get_field_name(int param_id,
+                                  int field_id,
+                                  mpl_param_descr_set_t *param_descr_p)
+{
+    const mpl_field_value_t *field_value_p;
 
-        if (id_match && prefix_match)
-        {
-            (void)mpl_mutex_unlock(mutex);
-            return paramset_p;
-        }
+    field_value_p = get_field_from_id(field_id,
+                                      param_descr_p->array2[PARAMID_TO_INDEX(param_id)].field_values,
+                                      param_descr_p->array2[PARAMID_TO_INDEX(param_id)].field_values_size
+                                     );
+    if (field_value_p == NULL)
+        return NULL;
+
+    return field_value_p->name_p;
+}
+
+static mpl_param_element_id_t get_field_paramid(int param_id,
+                                                int field_id,
+                                                mpl_param_descr_set_t *param_descr_p)
+{
+    const mpl_field_value_t *field_value_p;
+
+    field_value_p = get_field_from_id(field_id,
+                                      param_descr_p->array2[PARAMID_TO_INDEX(param_id)].field_values,
+                                      param_descr_p->array2[PARAMID_TO_INDEX(param_id)].field_values_size
+                                     );
+    if (field_value_p == NULL)
+        return MPL_PARAM_ID_UNDEFINED;
+
+    return field_value_p->param_id;
+}
+
+static mpl_param_element_id_t get_field_context_paramid(int param_id,
+                                                        int field_id,
+                                                        mpl_param_descr_set_t *param_descr_p)
+{
+    const mpl_field_value_t *field_value_p;
 
-        id_match = false;
-        prefix_match = false;
-    }
-    (void)mpl_mutex_unlock(mutex);
+    field_value_p = get_field_from_id(field_id,
+                                      param_descr_p->array2[PARAMID_TO_INDEX(param_id)].field_values,
+                                      param_descr_p->array2[PARAMID_TO_INDEX(param_id)].field_values_size
+                                     );
+    if (field_value_p == NULL)
+        return MPL_PARAM_ID_UNDEFINED;
 
-    return NULL;
+    return field_value_p->context_id;
 }
 
-/**
- * paramset_add
- *
- */
-static int paramset_add(mpl_param_descr_set_t* paramset_p)
+static int get_child_paramid(int param_id,
+                             int child_idx,
+                             mpl_param_descr_set_t *param_descr_p)
 {
-    /*lint -esym(429, paramset_container_p) freed elswhere */
-    mpl_paramset_container_t *paramset_container_p;
+    int num_children;
 
-    if (NULL == paramset_p)
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("paramset_p is NULL\n"));
+    num_children = param_descr_p->array2[PARAMID_TO_INDEX(param_id)].children_size;
+    if ((child_idx < 0) || (child_idx >= num_children))  {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Child index out of bounds\n"));
         set_errno(E_MPL_INVALID_PARAMETER);
-        return -1;
+        return MPL_PARAM_ID_UNDEFINED;
     }
+    return param_descr_p->array2[PARAMID_TO_INDEX(param_id)].children[child_idx];
+}
 
-    paramset_container_p = malloc(sizeof(mpl_paramset_container_t));
-    if (NULL == paramset_container_p)
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        return -1;
+static int get_child_index(mpl_param_element_id_t param_id,
+                           mpl_param_element_id_t child_id,
+                           mpl_param_descr_set_t *param_descr_p)
+{
+    int num_children;
+    int i;
+
+    num_children = param_descr_p->array2[PARAMID_TO_INDEX(param_id)].children_size;
+    for (i = 0; i < num_children; i++) {
+        if (param_descr_p->array2[PARAMID_TO_INDEX(param_id)].children[i] == child_id)
+            return i;
     }
+    return -1;
+}
 
-    memset(paramset_container_p, 0, sizeof(mpl_paramset_container_t));
+static int bin_put_varint(uint8_t *buf_p, size_t buflen, size_t pos,
+                          uint64_t value)
+{
+    int n = 0;
+    uint64_t v = value;
 
-    paramset_container_p->paramset_p = paramset_p;
+    do {
+        n++;
+        v >>= 7;
+    } while (v != 0);
 
-    (void)mpl_mutex_lock(mutex);
-    mpl_list_add(&paramset_list_p, &paramset_container_p->list_entry);
-    (void)mpl_mutex_unlock(mutex);
+    if ((NULL == buf_p) || ((pos + n) > buflen))
+        return n;
 
-    return 0;
+    buf_p += pos;
+    while (value >= 0x80) {
+        *buf_p++ = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    *buf_p = (uint8_t)value;
+    return n;
 }
 
-/**
- * strchr_escape()
- **/
-static char *strchr_escape(char *s, char c, char escape)
+static int bin_get_varint(const uint8_t *buf_p, size_t buflen, size_t *pos_p,
+                          uint64_t *value_p)
 {
-    char *p = s;
-    char *e;
+    uint64_t value = 0;
+    size_t pos = *pos_p;
+    int shift = 0;
 
-    while (p && strlen(p)) {
-        p = strchr(p, c);
-        // did we find an escaped character?
-        if (p==NULL)
-            continue;
-        e = p;
-        while (e && (e > s) && (*(e-1) == escape))
-            e--;
-        if (1 == ((p - e) % 2)) {
-            // An odd number of escapes in a row: yes
-            p++;
-            continue;
+    while (pos < buflen) {
+        /* The 10th byte holds only the top bit */
+        if ((shift == 63) && (buf_p[pos] & 0x7e))
+            break;
+        value |= ((uint64_t)(buf_p[pos] & 0x7f)) << shift;
+        if ((buf_p[pos++] & 0x80) == 0) {
+            *pos_p = pos;
+            *value_p = value;
+            return 0;
         }
-        else
+        shift += 7;
+        if (shift >= 64)
             break;
     }
-    return p;
+
+    MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                        ("Malformed or truncated varint\n"));
+    set_errno(E_MPL_FAILED_OPERATION);
+    return (-1);
 }
 
+static void bin_put_le(uint8_t *p, uint64_t value, size_t size)
+{
+    size_t i;
 
-/**
- * snprintf_escape()
- **/
-static int snprintf_escape(char delimiter, char escape,
-                           char *str, size_t size, const char *format, ...)
+    for (i = 0; i < size; i++) {
+        p[i] = (uint8_t)value;
+        value >>= 8;
+    }
+}
+
+static uint64_t bin_get_le(const uint8_t *p, size_t size)
 {
-    int n;
-    int size_needed;
-    char *tmpstr;
-    int num_escapes_needed;
-    char *p;
-    va_list ap;
+    uint64_t value = 0;
+    size_t i;
 
-    va_start(ap, format);
-    n = vsnprintf(NULL, 0, format, ap);
-    if (n < 0)
-        return n;
-    va_end(ap);
+    for (i = size; i > 0; i--)
+        value = (value << 8) | p[i - 1];
+    return value;
+}
 
-    tmpstr = malloc(n + 1);
-    if (tmpstr == NULL)
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
-                            ("Failed allocating memory\n"));
-        set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        return -1;
-    }
+static int64_t bin_sign_extend(uint64_t value, size_t size)
+{
+    uint64_t sign_bit;
 
-    va_start(ap, format);
-    n = vsnprintf(tmpstr, n + 1, format, ap);
-    assert(n > 0);
-    va_end(ap);
+    if (size >= sizeof(uint64_t))
+        return (int64_t)value;
 
-    p = tmpstr;
-    num_escapes_needed = 0;
-    while (p && strlen(p)) {
-        char *_p;
-        _p = strchr(p, delimiter);
-        if (!_p)
-            _p = strchr(p, escape);
-        if (!_p)
-            break;
-        p = _p;
-        num_escapes_needed++;
-        p++;
-    }
-    size_needed = n + num_escapes_needed;
+    sign_bit = (uint64_t)1 << ((size * 8) - 1);
+    value &= (sign_bit << 1) - 1;
+    return (int64_t)((value ^ sign_bit) - sign_bit);
+}
 
-    free(tmpstr);
+static int bin_put_string(uint8_t *buf_p, size_t buflen, size_t pos,
+                          const char *str_p)
+{
+    size_t len = strlen(str_p);
+    int n;
 
-    if (size > 0) {
-        va_start(ap, format);
-        n = vsnprintf(str, size - num_escapes_needed, format, ap);
-        assert(n > 0);
-        va_end(ap);
-        if (num_escapes_needed)
-            n = fill_escape(str, size, delimiter, escape);
-        return n;
-    }
-    else {
-        return size_needed;
-    }
+    n = bin_put_varint(buf_p, buflen, pos, len);
+    if ((NULL != buf_p) && ((pos + n + len) <= buflen))
+        memcpy(buf_p + pos + n, str_p, len);
+    return (int)(n + len);
 }
 
-static int fill_escape(char *str, int size, char delimiter, char escape)
+static int bin_get_string(const uint8_t *buf_p, size_t buflen, size_t *pos_p,
+                          char **str_pp)
 {
-    char *s;
-    char *d;
-    char *src = strdup(str);
+    uint64_t len;
+    size_t pos = *pos_p;
+    char *str_p;
+
+    if (bin_get_varint(buf_p, buflen, &pos, &len) < 0)
+        return (-1);
+
+    if ((len > (buflen - pos)) ||
+        (memchr(buf_p + pos, '\0', len) != NULL))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Malformed binary string\n"));
+        set_errno(E_MPL_FAILED_OPERATION);
+        return (-1);
+    }
 
-    if (src == NULL) {
+    str_p = malloc(len + 1);
+    if (NULL == str_p)
+    {
         MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
                             ("Failed allocating memory\n"));
         set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
-        return 1;
+        return (-1);
     }
+    memcpy(str_p, buf_p + pos, len);
+    str_p[len] = '\0';
 
-    s = src;
-    d = str;
-    while (*s) {
-        if ((*s == delimiter) || (*s == escape)) {
-            *d = escape;
-            d++;
-        }
-        *d = *s;
-        d++;
-        s++;
-        if ((d - str) > size)
-            break;
-    }
-    *d = '\0';
-    free(src);
-    return (d - str);
+    *str_pp = str_p;
+    *pos_p = pos + len;
+    return (int)len;
 }
 
-static char *remove_escape(const char *src, char escape)
+static mpl_packed_size_param_fp get_packed_size_func(const mpl_param_descr_t *descr_p)
 {
-    char *s;
-    char *d;
-    char *dst = strdup(src);
+    if (NULL != descr_p->packed_size_func)
+        return descr_p->packed_size_func;
 
-    if (dst == NULL) {
+    if ((descr_p->type <= mpl_type_invalid) || (descr_p->type >= mpl_end_of_types))
         return NULL;
-    }
 
-    s = (char*) src;
-    d = dst;
-    while (*s) {
-        if (*s == escape) {
-            s++;
-        }
-        *d = *s;
-        d++;
-        s++;
-    }
-    *d = '\0';
-    return (dst);
+    /* A pack method of its own must be measured by packing */
+    if (descr_p->pack_func != mpl_packed_size_methods[descr_p->type].pack_func)
+        return NULL;
+
+    return mpl_packed_size_methods[descr_p->type].packed_size_func;
 }
 
-static char *get_matching_close_bracket(char open_bracket, char close_bracket, char *str_p, char escape)
+static mpl_pack_bin_param_fp get_pack_bin_func(const mpl_param_descr_t *descr_p)
 {
-    int num_open = 0;
-    char *p;
-
-    p = str_p;
+    if (NULL != descr_p->pack_bin_func)
+        return descr_p->pack_bin_func;
 
-    if (*p != open_bracket)
+    if ((descr_p->type <= mpl_type_invalid) || (descr_p->type >= mpl_end_of_types))
         return NULL;
 
-    while (*p) {
-        if (*p == escape) {
-            p++;
-            continue;
-        }
-
-        if (*p == open_bracket)
-            num_open++;
-        if (*p == close_bracket)
-            num_open--;
-        if (num_open == 0)
-            return p;
-        p++;
-    }
-
-    return NULL;
+    return mpl_bin_methods[descr_p->type].pack_bin_func;
 }
 
-static char *get_bracket_contents(const char *str,
-                                  char open_bracket,
-                                  char close_bracket,
-                                  size_t *len_p)
+static mpl_unpack_bin_param_fp get_unpack_bin_func(const mpl_param_descr_t *descr_p)
 {
-    char *e;
-    char *s = strchr_escape((char*)str, open_bracket, '\\');
-    if (s == NULL)
-        return NULL;
-    e = get_matching_close_bracket(open_bracket,
-                                   close_bracket,
-                                   s,
-                                   '\\');
-    if (e == NULL)
+    if (NULL != descr_p->unpack_bin_func)
+        return descr_p->unpack_bin_func;
+
+    if ((descr_p->type <= mpl_type_invalid) || (descr_p->type >= mpl_end_of_types))
         return NULL;
-    s++;
-    assert(len_p);
-    *len_p = e - s;
-    return s;
-}
 
+    return mpl_bin_methods[descr_p->type].unpack_bin_func;
+}
 
-/**
- * convert_int()
- **/
-static int
-    convert_int(const char* value_str, int *value_p)
+static int check_bin_context(mpl_param_element_id_t param_id,
+                             mpl_param_element_id_t context,
+                             int id_in_context)
 {
-    char* endp;
-
-    assert(NULL != value_p);
-    assert(NULL != value_str);
+    mpl_param_descr_set_t *context_param_descr_p;
+    mpl_param_descr_set_t *field_param_descr_p;
+    mpl_param_element_id_t field_param_id;
 
-    /* Empty strings are not allowed */
-    if (0 == strlen(value_str))
+    context_param_descr_p = paramset_find(MPL_PARAMID_TO_PARAMSET(context),
+                                          NULL);
+    if ((NULL == context_param_descr_p) ||
+        !PARAMID_OK(context, context_param_descr_p))
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
-                            ("empty string is not an acceptable integer value\n"));
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Illegal context: %d\n",
+                                                     context));
         set_errno(E_MPL_INVALID_PARAMETER);
-        return -1;
+        return (-1);
     }
 
-    *value_p = strtol( value_str, &endp, 0 );
-
-    /* The whole string should be a number */
-    if (*endp != '\0')
+    field_param_id = get_field_paramid(context,
+                                       id_in_context,
+                                       context_param_descr_p);
+    if (field_param_id == MPL_PARAM_ID_UNDEFINED)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
-                            ("Not an acceptable integer value: %s\n", value_str));
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Illegal id in context: %d\n",
+                                                     id_in_context));
         set_errno(E_MPL_INVALID_PARAMETER);
         return (-1);
     }
 
+    if (param_id != field_param_id) {
+        /* Element is a child */
+        field_param_descr_p = paramset_find(MPL_PARAMID_TO_PARAMSET(field_param_id),
+                                            NULL);
+        assert(NULL != field_param_descr_p);
+        if (get_child_index(field_param_id,
+                            param_id,
+                            field_param_descr_p) < 0)
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Param %d is not child of %d\n",
+                                                         param_id,
+                                                         field_param_id));
+            set_errno(E_MPL_INVALID_PARAMETER);
+            return (-1);
+        }
+    }
     return (0);
 }
 
-/**
- * convert_int()
- **/
-static int
-    convert_int64(const char* value_str, int64_t *value_p)
+/*
+ * Returns the number of bytes needed for the element. Bytes are only
+ * written if everything fits in buflen.
+ */
+static int param_pack_bin(const mpl_param_element_t *element_p,
+                          uint8_t *buf_p,
+                          size_t buflen)
 {
-    char* endp;
+    mpl_param_descr_set_t *param_descr_p;
+    mpl_pack_bin_param_fp pack_bin_func;
+    const mpl_param_descr2_t *descr2_p;
+    uint64_t flags = 0;
+    size_t len = 0;
+    size_t value_pos;
+    int value_len;
+    int n;
 
-    assert(NULL != value_p);
-    assert(NULL != value_str);
+    param_descr_p = paramset_find(MPL_PARAMID_TO_PARAMSET(element_p->id),
+                                  NULL);
+    if ((NULL == param_descr_p) || !PARAMID_OK(element_p->id, param_descr_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Illegal param_id: %d\n",
+                                                     element_p->id));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return (-1);
+    }
+
+    if ((element_p->tag < 0) || (element_p->tag >= MPL_MAX_ARGS))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Illegal tag: %d\n",
+                                                     element_p->tag));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return (-1);
+    }
+
+    if (element_p->context != MPL_PARAM_ID_UNDEFINED) {
+        if (check_bin_context(element_p->id,
+                              element_p->context,
+                              element_p->id_in_context) < 0)
+            return (-1);
+        flags |= MPL_BIN_FLAG_FIELD;
+    }
+    if (element_p->tag != 0)
+        flags |= MPL_BIN_FLAG_TAG;
+    if (NULL != element_p->value_p)
+        flags |= MPL_BIN_FLAG_VALUE;
 
-    /* Empty strings are not allowed */
-    if (0 == strlen(value_str))
-    {
-        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
-                            ("empty string is not an acceptable integer value\n"));
-        set_errno(E_MPL_INVALID_PARAMETER);
-        return -1;
+    len += bin_put_varint(buf_p, buflen, len, (uint64_t)element_p->id);
+    len += bin_put_varint(buf_p, buflen, len, flags);
+    if (flags & MPL_BIN_FLAG_TAG)
+        len += bin_put_varint(buf_p, buflen, len, (uint64_t)element_p->tag);
+    if (flags & MPL_BIN_FLAG_FIELD) {
+        len += bin_put_varint(buf_p, buflen, len, (uint64_t)element_p->context);
+        len += bin_put_varint(buf_p, buflen, len,
+                              (uint64_t)(uint32_t)element_p->id_in_context);
     }
 
-    *value_p = strtoll( value_str, &endp, 0 );
+    if (!(flags & MPL_BIN_FLAG_VALUE))
+        return (int)len;
 
-    /* The whole string should be a number */
-    if (*endp != '\0')
+    pack_bin_func = get_pack_bin_func(&param_descr_p->array[PARAMID_TO_INDEX(element_p->id)]);
+    if (NULL == pack_bin_func)
     {
-        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
-                            ("Not an acceptable integer value: %s\n", value_str));
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("No binary pack method for %d\n",
+                                                     element_p->id));
         set_errno(E_MPL_INVALID_PARAMETER);
         return (-1);
     }
+    descr2_p = &param_descr_p->array2[PARAMID_TO_INDEX(element_p->id)];
 
-    return (0);
-}
-
-/**
- * convert_stringarr_to_int()
- **/
-static int
-    convert_stringarr_to_int(const char* value_str,
-                             int *value_p,
-                             const char* stringarr[],
-                             int stringarr_size)
-{
-    int index;
+    /*
+     * Pack the value once, after room for the largest possible length
+     * prefix, then move it into place behind the actual prefix.
+     */
+    value_pos = len + MPL_BIN_VARINT_MAXLEN;
+    if ((NULL != buf_p) && (buflen > value_pos))
+        value_len = (*pack_bin_func)(element_p->value_p,
+                                     buf_p + value_pos,
+                                     buflen - value_pos,
+                                     descr2_p);
+    else
+        value_len = (*pack_bin_func)(element_p->value_p, NULL, 0, descr2_p);
+    if (value_len < 0)
+        return (-1);
 
-    assert(NULL != value_p);
-    assert(NULL != value_str);
-    assert(NULL != stringarr);
+    n = bin_put_varint(NULL, 0, 0, (uint64_t)value_len);
+    if ((NULL == buf_p) || ((len + n + value_len) > buflen))
+        return (int)(len + n + value_len);
 
-    for (index=0; index<stringarr_size; index++)
-    {
-        assert(NULL != stringarr[index]);
-        if (0 == strcmp( value_str, stringarr[index]))
+    bin_put_varint(buf_p, buflen, len, (uint64_t)value_len);
+    if ((value_pos + value_len) <= buflen) {
+        memmove(buf_p + len + n, buf_p + value_pos, value_len);
+    }
+    else {
+        /* Fits in its final place only */
+        if ((*pack_bin_func)(element_p->value_p,
+                             buf_p + len + n,
+                             buflen - (len + n),
+                             descr2_p) != value_len)
         {
-            *value_p = index;
-            return (0);
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("Inconsistent binary pack of %d\n",
+                                 element_p->id));
+            set_errno(E_MPL_FAILED_OPERATION);
+            return (-1);
         }
     }
 
-    return (-1);
+    return (int)(len + n + value_len);
 }
 
-#if !defined(__linux__) && !defined(WIN32)
-static char *mpl_strdup(const char *s)
+static int param_unpack_bin(const uint8_t *buf_p,
+                            size_t buflen,
+                            size_t *pos_p,
+                            mpl_param_element_t **element_pp)
 {
-    char *tmp;
-    int len;
-    len = strlen(s)+1;
-    tmp = malloc(len);
-    if (tmp == NULL)
-        return NULL;
-    memset(tmp,0,len);
-    strcpy(tmp,s);
-    return tmp;
-}
-#endif
+    mpl_param_descr_set_t *param_descr_p;
+    mpl_unpack_bin_param_fp unpack_bin_func;
+    mpl_param_element_t *element_p;
+    uint64_t id;
+    uint64_t flags;
+    uint64_t tag = 0;
+    uint64_t context = MPL_PARAM_ID_UNDEFINED;
+    uint64_t id_in_context = 0;
+    uint64_t value_len;
+    size_t pos = *pos_p;
+    int res;
 
+    if ((bin_get_varint(buf_p, buflen, &pos, &id) < 0) ||
+        (bin_get_varint(buf_p, buflen, &pos, &flags) < 0))
+        return (-1);
 
-static int
-    convert_enum_name_to_int64(const char* name_p,
-                               int64_t *value_p,
-                               const mpl_enum_value_t enum_values[],
-                               int enum_values_size)
-{
-    int index;
+    if ((flags & ~((uint64_t)MPL_BIN_FLAGS)) != 0)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Unknown binary element flags: 0x%" PRIx64 "\n",
+                             flags));
+        set_errno(E_MPL_FAILED_OPERATION);
+        return (-1);
+    }
 
-    assert(NULL != value_p);
-    assert(NULL != name_p);
-    assert(NULL != enum_values);
+    if (flags & MPL_BIN_FLAG_TAG) {
+        if (bin_get_varint(buf_p, buflen, &pos, &tag) < 0)
+            return (-1);
+        if (tag >= MPL_MAX_ARGS)
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("Illegal tag: %" PRIu64 "\n", tag));
+            set_errno(E_MPL_FAILED_OPERATION);
+            return (-1);
+        }
+    }
 
-    for (index = 0; index < enum_values_size; index++)
-    {
-        assert(NULL != enum_values[index].name_p);
-        if (!strcmp(name_p, enum_values[index].name_p))
+    if (flags & MPL_BIN_FLAG_FIELD) {
+        if ((bin_get_varint(buf_p, buflen, &pos, &context) < 0) ||
+            (bin_get_varint(buf_p, buflen, &pos, &id_in_context) < 0))
+            return (-1);
+        if ((context > UINT32_MAX) || (id_in_context > UINT32_MAX))
         {
-            *value_p = enum_values[index].value;
-            return (0);
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("Illegal context\n"));
+            set_errno(E_MPL_FAILED_OPERATION);
+            return (-1);
         }
     }
 
-    return (-1);
-}
+    if (id > UINT32_MAX)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Illegal param_id\n"));
+        set_errno(E_MPL_FAILED_OPERATION);
+        return (-1);
+    }
 
-static const char *convert_enum_value_to_name(int64_t value,
-                                              const mpl_enum_value_t enum_values[],
-                                              int enum_values_size)
-{
-    int index;
+    param_descr_p = paramset_find(MPL_PARAMID_TO_PARAMSET((mpl_param_element_id_t)id),
+                                  NULL);
+    if ((NULL == param_descr_p) ||
+        !PARAMID_OK((mpl_param_element_id_t)id, param_descr_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Illegal param_id: %" PRIu64 "\n",
+                                                     id));
+        set_errno(E_MPL_INVALID_PARAMETER);
+        return (-1);
+    }
 
-    assert(NULL != enum_values);
+    if ((flags & MPL_BIN_FLAG_FIELD) &&
+        (check_bin_context((mpl_param_element_id_t)id,
+                           (mpl_param_element_id_t)context,
+                           (int)id_in_context) < 0))
+        return (-1);
 
-    for (index = 0; index < enum_values_size; index++) {
-        if (value == enum_values[index].value)
+    element_p = mpl_param_element_create_empty_tag((mpl_param_element_id_t)id,
+                                                   (int)tag);
+    if (NULL == element_p)
+        return (-1);
+    element_p->context = (mpl_param_element_id_t)context;
+    element_p->id_in_context = (int)id_in_context;
+
+    if (flags & MPL_BIN_FLAG_VALUE) {
+        if ((bin_get_varint(buf_p, buflen, &pos, &value_len) < 0) ||
+            (value_len > (buflen - pos)))
         {
-            assert(NULL != enum_values[index].name_p);
-            return enum_values[index].name_p;
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("Truncated value for param_id %" PRIu64 "\n",
+                                 id));
+            set_errno(E_MPL_FAILED_OPERATION);
+            mpl_param_element_destroy(element_p);
+            return (-1);
         }
-    }
-
-    return NULL;
-}
 
-static int check_integer_ranges(int64_t value,
-                                const mpl_integer_range_t integer_ranges[],
-                                int integer_ranges_size)
-{
-    int i;
+        unpack_bin_func = get_unpack_bin_func(&param_descr_p->array[PARAMID_TO_INDEX(id)]);
+        if (NULL == unpack_bin_func)
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("No binary unpack method for %" PRIu64 "\n",
+                                                         id));
+            set_errno(E_MPL_INVALID_PARAMETER);
+            mpl_param_element_destroy(element_p);
+            return (-1);
+        }
 
-    for (i = 0; i < integer_ranges_size; i++) {
-        assert(integer_ranges[i].first <= integer_ranges[i].last);
-        if ((value >= integer_ranges[i].first) &&
-            (value <= integer_ranges[i].last)) {
-            return ((int) integer_ranges[i].id);
+        res = (*unpack_bin_func)(buf_p + pos,
+                                 (size_t)value_len,
+                                 &element_p->value_p,
+                                 &param_descr_p->array2[PARAMID_TO_INDEX(id)]);
+        if (res < 0)
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("Param value unpack failed for %" PRIu64 "\n",
+                                 id));
+            mpl_param_element_destroy(element_p);
+            return (res);
         }
+        element_p->value_is_flat =
+            DESCR_VALUE_IS_FLAT(&param_descr_p->array[PARAMID_TO_INDEX(id)]);
+        pos += value_len;
     }
-    return -1;
+
+    *pos_p = pos;
+    *element_pp = element_p;
+    return (0);
 }
 
-static const mpl_field_value_t *get_field_from_id(int field_id,
-                                                  const mpl_field_value_t field_values[],
-                                                  int field_values_size)
+static int param_list_pack_bin_body(mpl_list_t *param_list_p,
+                                    uint8_t *buf_p,
+                                    size_t buflen)
 {
-    int i;
+    mpl_list_t *elem_p;
+    size_t len;
+    int n;
 
-    if (field_values_size == 0)
-        return NULL;
+    len = bin_put_varint(buf_p, buflen, 0, mpl_list_len(param_list_p));
 
-    for (i = 0; i < field_values_size; i++)
+    MPL_LIST_FOR_EACH(param_list_p, elem_p)
     {
-        if (field_values[i].field_id == field_id)
-            return &field_values[i];
+        if ((NULL != buf_p) && (len < buflen))
+            n = param_pack_bin(MPL_LIST_CONTAINER(elem_p,
+                                                  mpl_param_element_t,
+                                                  list_entry),
+                               buf_p + len,
+                               buflen - len);
+        else
+            n = param_pack_bin(MPL_LIST_CONTAINER(elem_p,
+                                                  mpl_param_element_t,
+                                                  list_entry),
+                               NULL,
+                               0);
+        if (n < 0)
+            return (-1);
+        len += n;
     }
 
-    return NULL;
+    return (int)len;
 }
 
-static const mpl_field_value_t *get_field_from_name(const char *field_str,
-                                                    size_t field_strlen,
-                                                    const mpl_field_value_t field_values[],
-                                                    int field_values_size)
+static mpl_list_t *param_list_unpack_bin_body(const uint8_t *buf_p,
+                                              size_t buflen,
+                                              bool *has_error_p)
 {
-    int i;
+    mpl_list_t *param_list_p = NULL;
+    mpl_list_t *last_p = NULL;
+    mpl_param_element_t *element_p;
+    uint64_t count;
+    uint64_t i;
+    size_t pos = 0;
 
-    if (field_values_size == 0 || field_str == NULL)
+    *has_error_p = true;
+
+    if (bin_get_varint(buf_p, buflen, &pos, &count) < 0)
         return NULL;
 
-    for (i = 0; i < field_values_size; i++)
+    /* Each element occupies at least two bytes (id and flags) */
+    if (count > ((buflen - pos) / 2))
     {
-        if ((strlen(field_values[i].name_p) == field_strlen) &&
-            (0 == strncmp(field_values[i].name_p, field_str, field_strlen)))
-            return &field_values[i];
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Illegal element count: %" PRIu64 "\n", count));
+        set_errno(E_MPL_FAILED_OPERATION);
+        return NULL;
     }
 
-    return NULL;
-}
-
-static const char *get_field_name(int param_id,
-                                  int field_id,
-                                  mpl_param_descr_set_t *param_descr_p)
-{
-    const mpl_field_value_t *field_value_p;
+    for (i = 0; i < count; i++)
+    {
+        if (param_unpack_bin(buf_p, buflen, &pos, &element_p) < 0)
+        {
+            mpl_param_list_destroy(&param_list_p);
+            return NULL;
+        }
+        /* Keep wire order, appending behind the last element */
+        if (NULL == last_p)
+            param_list_p = &element_p->list_entry;
+        else
+            mpl_list_append(&last_p, &element_p->list_entry);
+        last_p = &element_p->list_entry;
+    }
 
-    field_value_p = get_field_from_id(field_id,
-                                      param_descr_p->array2[PARAMID_TO_INDEX(param_id)].field_values,
-                                      param_descr_p->array2[PARAMID_TO_INDEX(param_id)].field_values_size
-                                     );
-    if (field_value_p == NULL)
+    if (pos != buflen)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Trailing data after binary list: %zu bytes\n",
+                             buflen - pos));/*lint !e557 %zu is C99 */
+        set_errno(E_MPL_FAILED_OPERATION);
+        mpl_param_list_destroy(&param_list_p);
         return NULL;
-
-    return field_value_p->name_p;
-}
-
-static mpl_param_element_id_t get_field_paramid(int param_id,
-                                                int field_id,
-                                                mpl_param_descr_set_t *param_descr_p)
-{
-    const mpl_field_value_t *field_value_p;
-
-    field_value_p = get_field_from_id(field_id,
-                                      param_descr_p->array2[PARAMID_TO_INDEX(param_id)].field_values,
-                                      param_descr_p->array2[PARAMID_TO_INDEX(param_id)].field_values_size
-                                     );
-    if (field_value_p == NULL)
-        return MPL_PARAM_ID_UNDEFINED;
-
-    return field_value_p->param_id;
-}
-
-static mpl_param_element_id_t get_field_context_paramid(int param_id,
-                                                        int field_id,
-                                                        mpl_param_descr_set_t *param_descr_p)
-{
-    const mpl_field_value_t *field_value_p;
-
-    field_value_p = get_field_from_id(field_id,
-                                      param_descr_p->array2[PARAMID_TO_INDEX(param_id)].field_values,
-                                      param_descr_p->array2[PARAMID_TO_INDEX(param_id)].field_values_size
-                                     );
-    if (field_value_p == NULL)
-        return MPL_PARAM_ID_UNDEFINED;
-
-    return field_value_p->context_id;
-}
-
-static int get_child_paramid(int param_id,
-                             int child_idx,
-                             mpl_param_descr_set_t *param_descr_p)
-{
-    int num_children;
-
-    num_children = param_descr_p->array2[PARAMID_TO_INDEX(param_id)].children_size;
-    if ((child_idx < 0) || (child_idx >= num_children))  {
-        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,("Child index out of bounds\n"));
-        set_errno(E_MPL_INVALID_PARAMETER);
-        return MPL_PARAM_ID_UNDEFINED;
     }
-    return param_descr_p->array2[PARAMID_TO_INDEX(param_id)].children[child_idx];
-}
-
-static int get_child_index(mpl_param_element_id_t param_id,
-                           mpl_param_element_id_t child_id,
-                           mpl_param_descr_set_t *param_descr_p)
-{
-    int num_children;
-    int i;
 
-    num_children = param_descr_p->array2[PARAMID_TO_INDEX(param_id)].children_size;
-    for (i = 0; i < num_children; i++) {
-        if (param_descr_p->array2[PARAMID_TO_INDEX(param_id)].children[i] == child_id)
-            return i;
-    }
-    return -1;
+    *has_error_p = false;
+    return param_list_p;
 }
 
 #if 1
@@ -9322,7 +15392,7 @@ void mpl_dbg_param_list_print(mpl_list_t *list_p)
     size_t buflen;
     char *buf_p;
 
-    buflen = mpl_param_list_pack(list_p, NULL, 0);
+    buflen = mpl_param_list_packed_size(list_p);
     buf_p = malloc(buflen+1);
     (void) mpl_param_list_pack(list_p, buf_p, buflen+1);
     printf("List: %s\n", buf_p);
@@ -35,6 +35,7 @@
 #include "mpl_stdint.h"
 #include "mpl_stdbool.h"
 #include "mpl_list.h"
+#include "mpl_arena.h"
 
 #include "mpl_dbgtrace.h"
 
@@ -1572,9 +1573,15 @@ typedef struct
     int param_set_id;
     mpl_field_pack_mode_t field_pack_mode;
     bool force_field_pack_mode;
+    bool string_views;  /* Unpack strings as views into the buffer */
 } mpl_pack_options_t;
 
-#define MPL_PACK_OPTIONS_DEFAULT {false,MESSAGE_DELIMITER,-1,field_pack_mode_autonomous,false}
+#define MPL_PACK_OPTIONS_DEFAULT {false,MESSAGE_DELIMITER,-1,field_pack_mode_autonomous,false,false}
+
+/* Binary transfer format header (first two bytes of a packed list) */
+#define MPL_BIN_FORMAT_MAGIC 0x4d /* 'M' */
+#define MPL_BIN_FORMAT_VERSION 1
+#define MPL_BIN_HEADER_LEN 2
 
 /**
  * mpl_param_element_id_t
@@ -1601,6 +1608,28 @@ typedef uint32_t mpl_param_element_id_t;
  *     id_in_context identifier that has a meaning in the context
  *     value_p    pointer to parameter value
  *     list_entry list field
+ *     value_is_view value_p points into the buffer the element was unpacked
+ *                from and is not freed with the element (see
+ *                mpl_param_list_unpack_in_place()). Only set by that
+ *                unpack and cleared by mpl_param_element_own_value(), which
+ *                must be called before value_p of such an element is
+ *                replaced or freed by the caller
+ *     in_arena   the element and its value are allocated from an arena and
+ *                are freed with it, not with the element (see
+ *                mpl_param_arena_set())
+ *     heads_index the element is first in a list that has an index (see
+ *                mpl_param_list_index_create())
+ *     value_is_flat the value was made through the parameter descriptor
+ *                and is freed with free() alone, so destroying the element
+ *                needs no lookup of the parameter set
+ *
+ * The fields from value_is_view on are set by the library, and
+ * mpl_param_element_destroy() relies on them. An element must therefore
+ * be made by the mpl_param_element_create*() functions (or by unpacking
+ * or cloning), or, if the caller allocates it, be initialized with
+ * mpl_param_element_init() before it is used. Filling in only id and
+ * value_p leaves the flags undefined. The size of the struct is not
+ * fixed between releases.
  *
  */
 typedef struct
@@ -1611,6 +1640,10 @@ typedef struct
     int                      id_in_context;
     void*                    value_p;
     mpl_list_t              list_entry;
+    bool                     value_is_view;
+    bool                     in_arena;
+    bool                     heads_index;
+    bool                     value_is_flat;
 } mpl_param_element_t;
 
 
@@ -1722,6 +1755,37 @@ typedef struct
     int64_t value; /* We should cover all enum values with this */
 } mpl_enum_value_t;
 
+/*
+ * For enums, lookup tables generated by mplcomp, giving positions in the
+ * enum value array:
+ *
+ * Names: a perfect hash. With hash the FNV-1a hash of the name, the name
+ * is at name_slots[slot], where slot is MPL_ENUM_TABLE_SLOT(hash,
+ * name_displace[hash & name_bucket_mask]) & name_slot_mask (or nowhere,
+ * -1 marks an empty slot).
+ *
+ * Values: when value_dense, by_value[value - value_min] is the position
+ * of the value (-1 if none), otherwise by_value is the first position of
+ * each value, sorted on value.
+ *
+ * A NULL name_slots or by_value means that there is no such table.
+ */
+typedef struct
+{
+    const uint32_t *name_displace;
+    uint32_t name_bucket_mask;
+    const int *name_slots;
+    uint32_t name_slot_mask;
+    int64_t value_min;
+    bool value_dense;
+    const int *by_value;
+    int by_value_size;
+} mpl_enum_table_t;
+
+#define MPL_ENUM_TABLE_SLOT(hash, displace)                       \
+    ((((hash) ^ (displace)) * 0x9e3779b1u) ^                      \
+     ((((hash) ^ (displace)) * 0x9e3779b1u) >> 15))
+
 /* For integers (and friends): */
 typedef struct
 {
@@ -1746,6 +1810,7 @@ typedef struct
  * max_p Pointer to max value (NULL if no min)
  * enum_values Array of name<->value for enums
  * integer_range Array of integer ranges for integers (signed and unsigned)
+ * enum_table_p Lookup tables for enum_values (NULL if none)
  *
  **/
 typedef struct
@@ -1763,6 +1828,7 @@ typedef struct
     int field_values_size;
     const mpl_param_element_id_t *children;
     int children_size;
+    const mpl_enum_table_t *enum_table_p;
 } mpl_param_descr2_t;
 
 
@@ -1897,6 +1963,66 @@ typedef size_t (*mpl_sizeof_param_fp)(const mpl_param_descr2_t *descr_p);
  */
 typedef void (*mpl_free_param_fp)(void *value_p);
 
+/**
+ * mpl_pack_bin_param_fp
+ *
+ * Binary pack function (method) for a specific parameter
+ *
+ * Parameters:
+ *     param_value_p:     Pointer to the parameter value
+ *     buf:               Buffer to pack into (may be NULL)
+ *     buflen:            Length of buffer
+ *     descr_p:           parameter description
+ *
+ * @return Number of bytes written to buf (or the number
+ *                 that would have been written if buflen is too
+ *                 small, in which case the contents of buf is undefined).
+ *                 Never writes more than buflen bytes.
+ *                 Returns negative value on error.
+ *
+ */
+typedef int (*mpl_pack_bin_param_fp)(const void* param_value_p,
+                                     uint8_t *buf, size_t buflen,
+                                     const mpl_param_descr2_t *descr_p);
+
+/**
+ * mpl_unpack_bin_param_fp
+ *
+ * Binary unpack function (method) for a specific parameter
+ *
+ * Parameters:
+ *     buf:               Buffer containing the value (to unpack from)
+ *     buflen:            Exact length of the value in buf
+ *     value_pp:          Pointing to the variable where the value is unpacked
+ *                        into
+ *     descr_p:           parameter description
+ *
+ * @return 0 (or integer range id) on success, -1 on error.
+ *
+ */
+typedef int (*mpl_unpack_bin_param_fp)(const uint8_t *buf,
+                                       size_t buflen,
+                                       void **value_pp,
+                                       const mpl_param_descr2_t *descr_p);
+
+/**
+ * mpl_packed_size_param_fp
+ *
+ * Packed size function (method) for a specific parameter
+ *
+ * Parameters:
+ *     param_value_p:     Pointer to the parameter value
+ *     descr_p:           parameter description
+ *     options_p:         Pack options
+ *
+ * @return Number of bytes the pack function would write (excluding '\0'),
+ *         without writing them. Returns negative value on error.
+ *
+ */
+typedef int (*mpl_packed_size_param_fp)(const void* param_value_p,
+                                        const mpl_param_descr2_t *descr_p,
+                                        const mpl_pack_options_t *options_p);
+
 
 /**
  * mpl_param_descr_t - description of a specific parameter
@@ -1920,6 +2046,9 @@ typedef void (*mpl_free_param_fp)(void *value_p);
  *                    (deprecated)
  * @stringarr_size    size of array
  *                    (deprecated)
+ * @pack_bin_func     binary pack method (NULL means default for type)
+ * @unpack_bin_func   binary unpack method (NULL means default for type)
+ * @packed_size_func  packed size method (NULL means default for type)
  *
  **/
 typedef struct
@@ -1940,6 +2069,9 @@ typedef struct
     mpl_free_param_fp free_func;
     const char **stringarr; /* Deprecated */
     int stringarr_size; /* Deprecated */
+    mpl_pack_bin_param_fp pack_bin_func;
+    mpl_unpack_bin_param_fp unpack_bin_func;
+    mpl_packed_size_param_fp packed_size_func;
 } mpl_param_descr_t;
 
 /**
@@ -1947,6 +2079,7 @@ typedef struct
  *
  * @array              array of parameter decriptors
  * @size               size of array
+ * @index_p            name lookup index (private, built by mpl_param_init())
  *
  **/
 typedef struct
@@ -1958,6 +2091,7 @@ typedef struct
     int param_set_id;
     int paramid_enum_size;
     mpl_list_t list_entry;
+    struct mpl_paramset_index_s *index_p;
 } mpl_param_descr_set_t;
 
 
@@ -2008,6 +2142,26 @@ void mpl_param_deinit(void);
  **/
 void mpl_param_system_deinit(void);
 
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_arena_set - Set the arena of the calling thread
+ *
+ * While an arena is set, parameter elements and values created by the
+ * calling thread (by unpacking, cloning, adding to lists etc.) are
+ * allocated from it. Such elements are marked with in_arena, and
+ * mpl_param_element_destroy() and mpl_param_list_destroy() leave them
+ * alone: they are all freed with mpl_arena_reset() or
+ * mpl_arena_destroy(). Lists not built in an arena work as before.
+ *
+ * Values of such elements must not be freed or replaced with free()
+ * and malloc() by the caller. Only the built-in types are arena aware.
+ *
+ * @param arena_p    the arena, or NULL to go back to the heap
+ * @return  the previous arena of the thread (or NULL)
+ *
+ **/
+mpl_arena_t *mpl_param_arena_set(mpl_arena_t *arena_p);
+
 /**
  * @ingroup MPL_PARAM
  * mpl_param_index_to_paramid
@@ -2122,6 +2276,21 @@ int mpl_param_pack_internal(const mpl_param_element_t* element_p,
                             size_t buflen,
                             const mpl_pack_options_t *options_p);
 
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_packed_size - size of a packed parameter
+ *
+ * @param element_p The parameter element (id + tag + value)
+ *
+ * @return  Bytes mpl_param_pack() would write (excluding '\0'), computed
+ *          without packing, or (-1) on error
+ *
+ **/
+int mpl_param_packed_size(const mpl_param_element_t* element_p);
+
+int mpl_param_packed_size_internal(const mpl_param_element_t* element_p,
+                                   const mpl_pack_options_t *options_p);
+
 /**
  * @ingroup MPL_PARAM
  * mpl_param_unpack - unpack received parameter strings
@@ -2408,6 +2577,342 @@ int mpl_param_value_copy_out(const mpl_param_element_t* element_p,
                              void *to_value_p,
                              int size);
 
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_value_pack
+ *
+ * Pack a parameter value without the parameter name, i.e. "=value".
+ * Used by generated struct pack functions.
+ *
+ * @param param_id   Parameter id (decides the value type)
+ * @param value_p    The value (as in the value_p of a parameter element)
+ * @param buf        Buffer to pack into (may be NULL if buflen is 0)
+ * @param buflen     Size of buffer
+ *
+ * @return The length of the packed value (excluding the terminating
+ *         '\0'), which may be larger than buflen, like snprintf().
+ *         Negative on error.
+ *
+ */
+int mpl_param_value_pack(mpl_param_element_id_t param_id,
+                         const void *value_p,
+                         char *buf,
+                         size_t buflen);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_value_unpack
+ *
+ * Unpack a parameter value (the text after '='). The value is allocated
+ * and must be freed with mpl_param_value_free().
+ *
+ * @param param_id   Parameter id (decides the value type)
+ * @param value_str  The value string
+ * @param value_pp   The allocated value is returned here
+ *
+ * @return 0 on success, -1 on error
+ *
+ */
+int mpl_param_value_unpack(mpl_param_element_id_t param_id,
+                           const char *value_str,
+                           void **value_pp);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_value_unpack_to
+ *
+ * Unpack a parameter value (the text after '=') into user allocated
+ * memory, like mpl_param_value_copy_out().
+ *
+ * @param param_id   Parameter id (decides the value type)
+ * @param value_str  The value string
+ * @param to_p       The value is copied into this memory area
+ * @param size       Size of the destination memory in bytes
+ *
+ * @return Number of bytes occupied by the value, -1 on error or if the
+ *         value does not fit
+ *
+ */
+int mpl_param_value_unpack_to(mpl_param_element_id_t param_id,
+                              const char *value_str,
+                              void *to_p,
+                              int size);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_value_free
+ *
+ * Free a value from mpl_param_value_unpack().
+ *
+ * @param param_id   Parameter id (decides the value type)
+ * @param value_p    The value (may be NULL)
+ *
+ */
+void mpl_param_value_free(mpl_param_element_id_t param_id, void *value_p);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_struct_pack_name
+ *
+ * Pack a bag field name, preceded by a ',' unless it is the first field
+ * and followed by "[tag]" if tag is not 0. Used by generated struct pack
+ * functions.
+ *
+ * @return As snprintf()
+ *
+ */
+int mpl_param_struct_pack_name(char *buf,
+                               size_t buflen,
+                               bool first,
+                               const char *field_name_p,
+                               int tag);
+
+/**
+ * @ingroup MPL_PARAM
+ * MPL_PARAM_STRUCT_BUF
+ *
+ * The buf and buflen arguments for packing at offset len in buf, for
+ * generated struct pack functions.
+ *
+ */
+#define MPL_PARAM_STRUCT_BUF(buf, buflen, len) \
+    (((size_t)(len) < (buflen)) ? (buf) + (len) : NULL), \
+    (((size_t)(len) < (buflen)) ? (buflen) - (len) : 0)
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_struct_value
+ *
+ * Check the name of a packed parameter "prefix.name=value" (the prefix
+ * may be left out) and find the value. Used by generated struct unpack
+ * functions.
+ *
+ * @param str       The packed parameter
+ * @param prefix_p  Parameter set prefix
+ * @param name_p    Parameter name
+ *
+ * @return The value (after '='), "" if there is no value (an empty
+ *         bag), or NULL if the name does not match
+ *
+ */
+const char *mpl_param_struct_value(const char *str,
+                                   const char *prefix_p,
+                                   const char *name_p);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_struct_split
+ *
+ * Split a packed bag value "{field=value,...}" in field names and
+ * values. The fields are sorted by tag, so that the elements of a
+ * multiple field come in tag order. Used by generated struct unpack
+ * functions.
+ *
+ * @param value_str  The bag value ("" for an empty bag)
+ * @param copy_pp    A copy of the bag contents that args point into is
+ *                   returned here, free with free()
+ * @param args_pp    The fields are returned here, free with free()
+ *
+ * @return Number of fields, -1 on error
+ *
+ */
+int mpl_param_struct_split(const char *value_str,
+                           char **copy_pp,
+                           mpl_arg_t **args_pp);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_struct_grow
+ *
+ * Make room for one more element in an array that holds count elements,
+ * doubling its size when it is full. Used by generated struct unpack
+ * functions.
+ *
+ * @param array_pp   The array (NULL when count is 0), free with free()
+ * @param count      Number of elements in the array
+ * @param elem_size  Size of one element
+ *
+ * @return 0 on success, -1 on error (the array is unchanged)
+ *
+ */
+int mpl_param_struct_grow(void **array_pp, int count, size_t elem_size);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_struct_key_tag
+ *
+ * Remove the "[tag]" from a field name.
+ *
+ * @param key_p  The field name, the tag is removed in place
+ *
+ * @return The tag, 0 if there is none, -1 if it is not valid
+ *
+ */
+int mpl_param_struct_key_tag(char *key_p);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_struct_pack_array
+ *
+ * Pack an array value from a plain C array, for generated struct pack
+ * functions.
+ *
+ * @param param_id  Parameter id of an array parameter
+ * @param arr_p     The elements
+ * @param len       Number of elements
+ *
+ * @return As snprintf(), -1 on error
+ *
+ */
+int mpl_param_struct_pack_array(mpl_param_element_id_t param_id,
+                                const void *arr_p,
+                                int len,
+                                char *buf,
+                                size_t buflen);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_struct_unpack_array
+ *
+ * Unpack an array value into a plain C array, for generated struct
+ * unpack functions.
+ *
+ * @param param_id   Parameter id of an array parameter
+ * @param value_str  The value string
+ * @param arr_p      Room for max elements
+ * @param max        Number of elements that fit in arr_p
+ * @param len_p      Returns the number of elements
+ *
+ * @return 0 on success, -1 on error or if the array does not fit
+ *
+ */
+int mpl_param_struct_unpack_array(mpl_param_element_id_t param_id,
+                                  const char *value_str,
+                                  void *arr_p,
+                                  int max,
+                                  int *len_p);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_gen_malloc
+ *
+ * Allocate a parameter value, from the arena of the calling thread if it
+ * has one (see mpl_param_arena_set()). Used by generated specialized
+ * parameter methods (mplcomp -s).
+ *
+ */
+void *mpl_param_gen_malloc(size_t size);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_gen_error
+ *
+ * Report a failure in a generated specialized parameter method: sets
+ * the error code (see mpl_get_errno()).
+ *
+ * @param error_value  The error code
+ * @param name_p       Parameter name
+ * @param value_str    The value that failed (may be NULL)
+ *
+ * @return -1
+ *
+ */
+int mpl_param_gen_error(int error_value,
+                        const char *name_p,
+                        const char *value_str);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_gen_pack_int
+ *
+ * Pack "=<decimal>", as the pack method of signed integers. Used by
+ * generated specialized parameter methods.
+ *
+ * @return As snprintf()
+ *
+ */
+int mpl_param_gen_pack_int(char *buf, size_t buflen, int64_t value);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_gen_pack_hex
+ *
+ * Pack "=0x<hex>", as the pack method of unsigned integers. Used by
+ * generated specialized parameter methods.
+ *
+ * @return As snprintf()
+ *
+ */
+int mpl_param_gen_pack_hex(char *buf, size_t buflen, uint64_t value);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_gen_pack_text
+ *
+ * Copy len characters (a pre-rendered value such as "=name") to buf,
+ * truncating like snprintf(). Used by generated specialized parameter
+ * methods.
+ *
+ * @return len
+ *
+ */
+int mpl_param_gen_pack_text(char *buf,
+                            size_t buflen,
+                            const char *text_p,
+                            size_t len);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_gen_int_len
+ *
+ * @return The length of mpl_param_gen_pack_int() of value
+ *
+ */
+int mpl_param_gen_int_len(int64_t value);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_gen_hex_len
+ *
+ * @return The length of mpl_param_gen_pack_hex() of value
+ *
+ */
+int mpl_param_gen_hex_len(uint64_t value);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_gen_convert_int
+ *
+ * Convert a value string to a signed integer (decimal, octal with a
+ * leading 0 or hex with "0x"), as the unpack methods of int, the signed
+ * integers, uint8 and the enums do. Used by generated specialized
+ * parameter methods.
+ *
+ * An empty value, or one that does not fit in 64 bits, is an error.
+ * The methods of int, sint8/16/32 and uint8 truncate the value to an
+ * int (see mpl_convert_int()), and sint64 takes an empty value as 0.
+ *
+ * @return 0 on success, -1 on error
+ *
+ */
+int mpl_param_gen_convert_int(const char *value_str, int64_t *value_p);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_gen_convert_uint
+ *
+ * Convert a value string to an unsigned integer (decimal or hex with
+ * "0x"), as the unpack methods of uint16, uint32 and uint64 do. Used by
+ * generated specialized parameter methods.
+ *
+ * An empty value is 0, and a minus sign negates modulo 2^64. A value
+ * that does not fit in 64 bits is an error.
+ *
+ * @return 0 on success, -1 on error
+ *
+ */
+int mpl_param_gen_convert_uint(const char *value_str, uint64_t *value_p);
+
 /**
  * @ingroup MPL_PARAM
  * mpl_param_allow_get
@@ -2924,6 +3429,25 @@ mpl_param_element_t *mpl_param_element_create_struint8_tuple_tag(mpl_param_eleme
  */
 mpl_param_element_t *mpl_param_element_create_empty_tag(mpl_param_element_id_t param_id, int tag);
 
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_element_init
+ *
+ * Initialize a parameter element allocated by the caller (with malloc()
+ * or on the stack) to have no value and no tag. The parameter id is not
+ * checked. An element that is not made by the library must be
+ * initialized with this before it is used, see mpl_param_element_t.
+ *
+ * @param    element_p    The element
+ * @param    param_id     Param ID
+ *
+ * @note An element allocated with malloc() may be freed with
+ *       mpl_param_element_destroy(), also as part of a list
+ *
+ */
+void mpl_param_element_init(mpl_param_element_t *element_p,
+                            mpl_param_element_id_t param_id);
+
 /**
  * @ingroup MPL_PARAM
  * mpl_param_element_create_n
@@ -3167,6 +3691,92 @@ int mpl_param_list_pack_extended(mpl_list_t *param_list_p,
                                  int buflen,
                                  const mpl_pack_options_t *options_p);
 
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_list_packed_size
+ *
+ * Size of a packed parameter list, computed without packing it: a buffer
+ * of this size plus one ('\0') is enough for mpl_param_list_pack().
+ *
+ * @param    param_list_p parameter list
+ *
+ * @return  Bytes mpl_param_list_pack() would write (excluding '\0'), or
+ *          -1 on error
+ *
+ */
+int mpl_param_list_packed_size(mpl_list_t *param_list_p);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_list_packed_size_extended
+ *
+ * As mpl_param_list_packed_size(), for mpl_param_list_pack_extended()
+ *
+ * @param    param_list_p parameter list
+ * @param    options_p    pack options (NULL means MPL_PACK_OPTIONS_DEFAULT)
+ *
+ * @return  Bytes mpl_param_list_pack_extended() would write (excluding
+ *          '\0'), or -1 on error
+ *
+ */
+int mpl_param_list_packed_size_extended(mpl_list_t *param_list_p,
+                                        const mpl_pack_options_t *options_p);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_pack_write_fp
+ *
+ * Writer callback of mpl_param_list_pack_stream()
+ *
+ * @param    ctx_p   Context given to mpl_param_list_pack_stream()
+ * @param    data_p  Packed data (not '\0' terminated)
+ * @param    len     Number of bytes
+ *
+ * @return 0 on success, -1 on error (stops the packing)
+ */
+typedef int (*mpl_pack_write_fp)(void *ctx_p, const char *data_p, size_t len);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_list_pack_stream
+ *
+ * Pack a parameter list, handing the packed data to a writer callback in
+ * batches, e.g. to write it to a file or a socket. Each parameter is
+ * packed once (unless it is larger than the batch), so any size of list
+ * is packed in one pass and with memory bounded by the largest
+ * parameter.
+ *
+ * @param    param_list_p parameter list to pack
+ * @param    write_func   writer callback
+ * @param    ctx_p        context passed to write_func
+ * @param    options_p    pack options (NULL means MPL_PACK_OPTIONS_DEFAULT)
+ *
+ * @return  Number of bytes written on success, -1 on error
+ *
+ */
+int mpl_param_list_pack_stream(mpl_list_t *param_list_p,
+                               mpl_pack_write_fp write_func,
+                               void *ctx_p,
+                               const mpl_pack_options_t *options_p);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_list_pack_alloc
+ *
+ * Pack a parameter list into an allocated buffer of the right size
+ *
+ * @param    param_list_p parameter list to pack
+ * @param    options_p    pack options (NULL means MPL_PACK_OPTIONS_DEFAULT)
+ * @param    len_p        returns length of packed string (may be NULL)
+ *
+ * @return  '\0' terminated packed string (to be freed with free()), or
+ *          NULL on error
+ *
+ */
+char *mpl_param_list_pack_alloc(mpl_list_t *param_list_p,
+                                const mpl_pack_options_t *options_p,
+                                size_t *len_p);
+
 /* for backward compatibility */
 int mpl_param_list_pack_internal(mpl_list_t *param_list_p,
                                  char *buf_p,
@@ -3176,67 +3786,293 @@ int mpl_param_list_pack_internal(mpl_list_t *param_list_p,
 
 /**
  * @ingroup MPL_PARAM
- * mpl_param_list_unpack - unpack packed parameter list
+ * mpl_param_list_unpack - unpack packed parameter list
+ *
+ * @param     buf_p           message to be unpacked (zero terminated)
+ *
+ * @return parameter list on success, NULL on failure (or no params)
+ *
+ **/
+mpl_list_t *mpl_param_list_unpack(char *buf_p);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_list_unpack_error - unpack packed parameter list with error
+ *                               indication
+ *
+ * @param     buf_p           message to be unpacked (zero terminated)
+ * @param     has_error_p     Did the unpack fail with errors
+ *
+ * @return parameter list on success, NULL on failure (or no params)
+ *
+ **/
+mpl_list_t *mpl_param_list_unpack_error(char *buf_p, bool *has_error_p);
+
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_list_unpack_param_set - unpack packed parameter list
+ *                              falling back to default parameter set
+ *                              if not indicated by key string
+ *
+ * @param     buf_p           message to be unpacked (zero terminated)
+ * @param     param_set_id    default parameter set id (fallback)
+ *
+ * @return parameter list on success, NULL on failure (or no params)
+ *
+ **/
+mpl_list_t *mpl_param_list_unpack_param_set(char *buf_p, int param_set_id);
+
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_list_unpack_param_set_error -
+ *                              unpack packed parameter list with
+ *                              error indication
+ *                              falling back to default parameter set
+ *                              if not indicated by key string
+ *
+ * @param     buf_p           message to be unpacked (zero terminated)
+ * @param     param_set_id    default parameter set id (fallback)
+ * @param     has_error_p     Did the unpack fail with errors
+ *
+ * @return parameter list on success, NULL on failure (or no params)
+ *
+ **/
+mpl_list_t *mpl_param_list_unpack_param_set_error(char *buf_p,
+                                                  int param_set_id,
+                                                  bool *has_error_p);
+
+mpl_list_t *mpl_param_list_unpack_internal(char *buf_p,
+                                           const mpl_pack_options_t *options_p,
+                                           mpl_param_element_id_t unpack_context,
+                                           bool *has_error_p);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_list_unpack_in_place - unpack packed parameter list without
+ *                                  copying the buffer
+ *
+ * The buffer is split into keys and values in place, so it is modified.
+ * String values without escape characters are not copied: the element
+ * value points into the buffer (value_is_view is set), also inside
+ * bags. The buffer must
+ * therefore be kept until the list is destroyed, or until
+ * mpl_param_list_own_values() has been called on it. The value of a
+ * view element must not be freed or replaced by the caller before
+ * mpl_param_element_own_value(), see mpl_param_element_t.
+ *
+ * @param     buf_p           message to be unpacked (zero terminated)
+ * @param     param_set_id    default parameter set id (fallback), or -1
+ * @param     has_error_p     Did the unpack fail with errors (may be NULL)
+ *
+ * @return parameter list on success, NULL on failure (or no params)
+ *
+ **/
+mpl_list_t *mpl_param_list_unpack_in_place(char *buf_p,
+                                           int param_set_id,
+                                           bool *has_error_p);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_element_own_value - copy a value that is a view into an
+ *                               unpack buffer
+ *
+ * @param     element_p       the element
+ *
+ * @return 0 on success, -1 on failure
+ *
+ **/
+int mpl_param_element_own_value(mpl_param_element_t *element_p);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_list_own_values - copy all values in a list that are views
+ *                             into an unpack buffer
+ *
+ * After this the list (including the contents of its bags) no longer
+ * depends on the buffer it was unpacked from.
+ *
+ * @param     param_list_p    the list
+ *
+ * @return 0 on success, -1 on failure
+ *
+ **/
+int mpl_param_list_own_values(mpl_list_t *param_list_p);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_unpack_stream_t
+ *
+ * Resumable (push) parser for packed parameter lists. Input is fed in
+ * chunks of any size, e.g. as read from a socket or pipe, and parameter
+ * elements are unpacked as soon as they are complete. Only the text of
+ * the parameter being received is buffered, so a message can be larger
+ * than any read buffer.
+ *
+ * A message ends at the message terminator (normally newline) outside
+ * of any {}. Parameters are separated by the message_delimiter of the
+ * pack options.
+ */
+typedef struct mpl_unpack_stream_s mpl_unpack_stream_t;
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_unpack_element_fp
+ *
+ * Called for each unpacked parameter element, which is handed over to
+ * the callback.
+ *
+ * @return 0 to continue, -1 to stop (mpl_unpack_stream_feed() fails)
+ */
+typedef int (*mpl_unpack_element_fp)(void *ctx_p,
+                                     mpl_param_element_t *param_elem_p);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_unpack_message_fp
+ *
+ * Called at the end of each message. If no element callback is set,
+ * param_list_p is the unpacked message (handed over to the callback,
+ * same as mpl_param_list_unpack() would return), otherwise it is NULL.
+ * has_error is set if a parameter of the message failed to unpack, the
+ * rest of that message is then skipped.
+ *
+ * @return 0 to continue, -1 to stop (mpl_unpack_stream_feed() fails)
+ */
+typedef int (*mpl_unpack_message_fp)(void *ctx_p,
+                                     mpl_list_t *param_list_p,
+                                     bool has_error);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_unpack_stream_create
+ *
+ * @param     options_p           unpack options (NULL means
+ *                                MPL_PACK_OPTIONS_DEFAULT), string views
+ *                                are not supported
+ * @param     message_terminator  end of message character, '\0' means
+ *                                that messages end only at
+ *                                mpl_unpack_stream_finish()
+ * @param     element_func        element callback (may be NULL)
+ * @param     message_func        message callback (may be NULL)
+ * @param     ctx_p               context passed to the callbacks
+ *
+ * @return the parser, or NULL on failure
+ *
+ **/
+mpl_unpack_stream_t *mpl_unpack_stream_create(const mpl_pack_options_t *options_p,
+                                              char message_terminator,
+                                              mpl_unpack_element_fp element_func,
+                                              mpl_unpack_message_fp message_func,
+                                              void *ctx_p);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_unpack_stream_feed
+ *
+ * Feed the parser with the next chunk of input. The callbacks are called
+ * for everything completed by the chunk.
+ *
+ * @param     stream_p   the parser
+ * @param     data_p     input (need not be '\0' terminated)
+ * @param     len        number of bytes
+ *
+ * @return 0 on success, -1 on failure or if a callback stopped it
+ *
+ **/
+int mpl_unpack_stream_feed(mpl_unpack_stream_t *stream_p,
+                           const char *data_p,
+                           size_t len);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_unpack_stream_finish
+ *
+ * End of input: completes a message that has no terminator. The parser
+ * can then be fed again.
+ *
+ * @param     stream_p   the parser
+ *
+ * @return 0 on success, -1 on failure or if a callback stopped it
+ *
+ **/
+int mpl_unpack_stream_finish(mpl_unpack_stream_t *stream_p);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_unpack_stream_destroy
  *
- * @param     buf_p           message to be unpacked (zero terminated)
+ * Destroy the parser, discarding any incomplete message
  *
- * @return parameter list on success, NULL on failure (or no params)
+ * @param     stream_p   the parser (may be NULL)
  *
  **/
-mpl_list_t *mpl_param_list_unpack(char *buf_p);
+void mpl_unpack_stream_destroy(mpl_unpack_stream_t *stream_p);
 
 /**
  * @ingroup MPL_PARAM
- * mpl_param_list_unpack_error - unpack packed parameter list with error
- *                               indication
+ * mpl_param_list_pack_bin
  *
- * @param     buf_p           message to be unpacked (zero terminated)
- * @param     has_error_p     Did the unpack fail with errors
+ * Pack a parameter list using the binary transfer format
  *
- * @return parameter list on success, NULL on failure (or no params)
+ * The binary format is a compact alternative to the text format:
+ * <pre>
+ *   list    = magic(1) version(1) body
+ *   body    = varint(count) element*
+ *   element = varint(id) varint(flags) [varint(tag)]
+ *             [varint(context) varint(id_in_context)] [varint(len) value]
+ * </pre>
+ * Varints are unsigned LEB128. Integers are fixed width little endian,
+ * arrays are raw (little endian) elements and bags are nested bodies.
+ * Parameters are identified by parameter id rather than by name, so both
+ * ends must use the same version of the parameter set.
  *
- **/
-mpl_list_t *mpl_param_list_unpack_error(char *buf_p, bool *has_error_p);
-
+ * @param    param_list_p parameter list to pack
+ * @param    buf_p        buffer to store packed list (may be NULL)
+ * @param    buflen       length of the buffer
+ *
+ * @return  Number of bytes written to buf on success, -1 on error.
+ *           If the output did not fit in 'buflen' then the return value
+ *           is the number of bytes which would have been written if enough
+ *           space had been available (the contents of buf is then
+ *           undefined).
+ *
+ *                   The function never writes more than buflen bytes to the
+ *                   buffer. Note that the buffer is not zero terminated.
+ *
+ */
+int mpl_param_list_pack_bin(mpl_list_t *param_list_p,
+                            uint8_t *buf_p,
+                            int buflen);
 
 /**
  * @ingroup MPL_PARAM
- * mpl_param_list_unpack_param_set - unpack packed parameter list
- *                              falling back to default parameter set
- *                              if not indicated by key string
+ * mpl_param_list_unpack_bin - unpack binary packed parameter list
  *
- * @param     buf_p           message to be unpacked (zero terminated)
- * @param     param_set_id    default parameter set id (fallback)
+ * @param     buf_p           message to be unpacked
+ * @param     buflen          length of message
  *
  * @return parameter list on success, NULL on failure (or no params)
  *
  **/
-mpl_list_t *mpl_param_list_unpack_param_set(char *buf_p, int param_set_id);
-
+mpl_list_t *mpl_param_list_unpack_bin(const uint8_t *buf_p, int buflen);
 
 /**
  * @ingroup MPL_PARAM
- * mpl_param_list_unpack_param_set_error -
- *                              unpack packed parameter list with
- *                              error indication
- *                              falling back to default parameter set
- *                              if not indicated by key string
+ * mpl_param_list_unpack_bin_error - unpack binary packed parameter list
+ *                                   with error indication
  *
- * @param     buf_p           message to be unpacked (zero terminated)
- * @param     param_set_id    default parameter set id (fallback)
+ * @param     buf_p           message to be unpacked
+ * @param     buflen          length of message
  * @param     has_error_p     Did the unpack fail with errors
  *
  * @return parameter list on success, NULL on failure (or no params)
  *
  **/
-mpl_list_t *mpl_param_list_unpack_param_set_error(char *buf_p,
-                                                  int param_set_id,
-                                                  bool *has_error_p);
-
-mpl_list_t *mpl_param_list_unpack_internal(char *buf_p,
-                                           const mpl_pack_options_t *options_p,
-                                           mpl_param_element_id_t unpack_context,
-                                           bool *has_error_p);
+mpl_list_t *mpl_param_list_unpack_bin_error(const uint8_t *buf_p,
+                                            int buflen,
+                                            bool *has_error_p);
 
 /**
  * @ingroup MPL_PARAM
@@ -3523,6 +4359,155 @@ int mpl_param_list_field_count( mpl_param_element_id_t context,
                                 int id_in_context,
                                 mpl_list_t *param_list_p );
 
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_list_index_t
+ *
+ * Index of a parameter list, giving constant time lookup of elements by
+ * id, by id and tag, and by field and tag. Worth it for large lists
+ * (bags, configurations) that are searched many times.
+ *
+ * The index refers to the caller's list pointer. While the index
+ * exists, elements must only be added to and removed from the list
+ * with mpl_param_list_index_add() and mpl_param_list_index_remove(),
+ * and the index must be destroyed before the list. The list itself can
+ * be used as usual, e.g. packed.
+ *
+ * While the index exists, mpl_param_list_find(),
+ * mpl_param_list_find_tag(), mpl_param_list_find_field() and
+ * mpl_param_list_find_field_tag() use it when they are given the
+ * list, and so do the generated get macros and functions that are
+ * built on them. The index lookups return the same element as the
+ * linear search, i.e. the first match in the list. Looking up a
+ * parameter that has children falls back to a linear search.
+ */
+typedef struct mpl_param_list_index_s mpl_param_list_index_t;
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_list_index_create
+ *
+ * Create index of a parameter list
+ *
+ * @param    param_list_pp  Address of list pointer, must be valid as long
+ *                          as the index exists
+ *
+ * @return The index, or NULL on error
+ *
+ */
+mpl_param_list_index_t *mpl_param_list_index_create(mpl_list_t **param_list_pp);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_list_index_destroy
+ *
+ * Destroy index of a parameter list (the list is not touched)
+ *
+ * @param    index_p  The index (may be NULL)
+ *
+ */
+void mpl_param_list_index_destroy(mpl_param_list_index_t *index_p);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_list_index_add
+ *
+ * Add parameter element to the beginning of an indexed list
+ *
+ * @param    index_p       The index
+ * @param    param_elem_p  Element to add
+ *
+ * @return 0 on success, -1 on error (element not added)
+ *
+ */
+int mpl_param_list_index_add(mpl_param_list_index_t *index_p,
+                             mpl_param_element_t *param_elem_p);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_list_index_remove
+ *
+ * Remove parameter element from an indexed list (the element is not
+ * destroyed)
+ *
+ * @param    index_p       The index
+ * @param    param_elem_p  Element to remove
+ *
+ * @return The removed element, or NULL if not in the list
+ *
+ */
+mpl_param_element_t *mpl_param_list_index_remove(mpl_param_list_index_t *index_p,
+                                                 mpl_param_element_t *param_elem_p);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_list_index_find
+ *
+ * Indexed version of mpl_param_list_find()
+ *
+ * @param    index_p   The index
+ * @param    param_id  Param ID to search for
+ *
+ * @return Found matching parameter element or NULL
+ *
+ */
+mpl_param_element_t *mpl_param_list_index_find(const mpl_param_list_index_t *index_p,
+                                               mpl_param_element_id_t param_id);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_list_index_find_tag
+ *
+ * Indexed version of mpl_param_list_find_tag()
+ *
+ * @param    index_p   The index
+ * @param    param_id  Param ID to search for (or MPL_PARAM_ID_UNDEFINED to
+ *                     find any parameter having the tag)
+ * @param    tag       Tag to match
+ *
+ * @return Found matching parameter element or NULL
+ *
+ */
+mpl_param_element_t *mpl_param_list_index_find_tag(const mpl_param_list_index_t *index_p,
+                                                   mpl_param_element_id_t param_id,
+                                                   int tag);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_list_index_find_field
+ *
+ * Indexed version of mpl_param_list_find_field()
+ *
+ * @param    index_p        The index
+ * @param    context        Param ID of context
+ * @param    id_in_context  id in the context
+ *
+ * @return Found matching parameter element or NULL
+ *
+ */
+mpl_param_element_t *mpl_param_list_index_find_field(const mpl_param_list_index_t *index_p,
+                                                     mpl_param_element_id_t context,
+                                                     int id_in_context);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_param_list_index_find_field_tag
+ *
+ * Indexed version of mpl_param_list_find_field_tag()
+ *
+ * @param    index_p        The index
+ * @param    context        Param ID of context
+ * @param    id_in_context  id in the context
+ * @param    tag            Tag to match
+ *
+ * @return Found matching parameter element or NULL
+ *
+ */
+mpl_param_element_t *mpl_param_list_index_find_field_tag(const mpl_param_list_index_t *index_p,
+                                                         mpl_param_element_id_t context,
+                                                         int id_in_context,
+                                                         int tag);
+
 /**
  * @ingroup MPL_PARAM
  * mpl_param_list_find_field_count_tag
@@ -4261,35 +5246,388 @@ size_t mpl_sizeof_param_value_addr(const mpl_param_descr2_t *descr_p);
  * See mpl_free_param_fp for more details.
  *
  */
-#define mpl_free_param_value_string free
-#define mpl_free_param_value_wstring free
-#define mpl_free_param_value_int free
-#define mpl_free_param_value_sint8 free
-#define mpl_free_param_value_sint16 free
-#define mpl_free_param_value_sint32 free
-#define mpl_free_param_value_sint64 free
-#define mpl_free_param_value_uint8 free
-#define mpl_free_param_value_uint16 free
-#define mpl_free_param_value_uint32 free
-#define mpl_free_param_value_uint64 free
-#define mpl_free_param_value_enum free
-#define mpl_free_param_value_enum8 free
-#define mpl_free_param_value_enum16 free
-#define mpl_free_param_value_enum32 free
-#define mpl_free_param_value_signed_enum8 free
-#define mpl_free_param_value_signed_enum16 free
-#define mpl_free_param_value_signed_enum32 free
-#define mpl_free_param_value_bool free
-#define mpl_free_param_value_bool8 free
+/* Free a value that is a single allocation (leaves arena memory alone) */
+void mpl_free_param_value(void *value_p);
+#define mpl_free_param_value_string mpl_free_param_value
+#define mpl_free_param_value_wstring mpl_free_param_value
+#define mpl_free_param_value_int mpl_free_param_value
+#define mpl_free_param_value_sint8 mpl_free_param_value
+#define mpl_free_param_value_sint16 mpl_free_param_value
+#define mpl_free_param_value_sint32 mpl_free_param_value
+#define mpl_free_param_value_sint64 mpl_free_param_value
+#define mpl_free_param_value_uint8 mpl_free_param_value
+#define mpl_free_param_value_uint16 mpl_free_param_value
+#define mpl_free_param_value_uint32 mpl_free_param_value
+#define mpl_free_param_value_uint64 mpl_free_param_value
+#define mpl_free_param_value_enum mpl_free_param_value
+#define mpl_free_param_value_enum8 mpl_free_param_value
+#define mpl_free_param_value_enum16 mpl_free_param_value
+#define mpl_free_param_value_enum32 mpl_free_param_value
+#define mpl_free_param_value_signed_enum8 mpl_free_param_value
+#define mpl_free_param_value_signed_enum16 mpl_free_param_value
+#define mpl_free_param_value_signed_enum32 mpl_free_param_value
+#define mpl_free_param_value_bool mpl_free_param_value
+#define mpl_free_param_value_bool8 mpl_free_param_value
 void mpl_free_param_value_uint8_array(void *value_p);
 void mpl_free_param_value_uint16_array(void *value_p);
 void mpl_free_param_value_uint32_array(void *value_p);
 void mpl_free_param_value_string_tuple(void *value_p);
-#define mpl_free_param_value_int_tuple free
+#define mpl_free_param_value_int_tuple mpl_free_param_value
 void mpl_free_param_value_strint_tuple(void *value_p);
 void mpl_free_param_value_struint8_tuple(void *value_p);
 void mpl_free_param_value_bag(void *value_p);
-#define mpl_free_param_value_addr free
+#define mpl_free_param_value_addr mpl_free_param_value
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_pack_bin_param_value_*
+ *
+ * Encode (pack) a value of a specific type from local format to
+ *              binary "on the wire" format
+ *
+ * See mpl_pack_bin_param_fp for more details.
+ *
+ */
+int mpl_pack_bin_param_value_string(const void* param_value_p,
+                                    uint8_t *buf,
+                                    size_t buflen,
+                                    const mpl_param_descr2_t *descr_p);
+int mpl_pack_bin_param_value_wstring(const void* param_value_p,
+                                     uint8_t *buf,
+                                     size_t buflen,
+                                     const mpl_param_descr2_t *descr_p);
+int mpl_pack_bin_param_value_int(const void* param_value_p,
+                                 uint8_t *buf,
+                                 size_t buflen,
+                                 const mpl_param_descr2_t *descr_p);
+int mpl_pack_bin_param_value_sint8(const void* param_value_p,
+                                   uint8_t *buf,
+                                   size_t buflen,
+                                   const mpl_param_descr2_t *descr_p);
+int mpl_pack_bin_param_value_sint16(const void* param_value_p,
+                                    uint8_t *buf,
+                                    size_t buflen,
+                                    const mpl_param_descr2_t *descr_p);
+int mpl_pack_bin_param_value_sint32(const void* param_value_p,
+                                    uint8_t *buf,
+                                    size_t buflen,
+                                    const mpl_param_descr2_t *descr_p);
+int mpl_pack_bin_param_value_sint64(const void* param_value_p,
+                                    uint8_t *buf,
+                                    size_t buflen,
+                                    const mpl_param_descr2_t *descr_p);
+int mpl_pack_bin_param_value_uint8(const void* param_value_p,
+                                   uint8_t *buf,
+                                   size_t buflen,
+                                   const mpl_param_descr2_t *descr_p);
+int mpl_pack_bin_param_value_uint16(const void* param_value_p,
+                                    uint8_t *buf,
+                                    size_t buflen,
+                                    const mpl_param_descr2_t *descr_p);
+int mpl_pack_bin_param_value_uint32(const void* param_value_p,
+                                    uint8_t *buf,
+                                    size_t buflen,
+                                    const mpl_param_descr2_t *descr_p);
+int mpl_pack_bin_param_value_uint64(const void* param_value_p,
+                                    uint8_t *buf,
+                                    size_t buflen,
+                                    const mpl_param_descr2_t *descr_p);
+int mpl_pack_bin_param_value_enum(const void* param_value_p,
+                                  uint8_t *buf,
+                                  size_t buflen,
+                                  const mpl_param_descr2_t *descr_p);
+int mpl_pack_bin_param_value_enum8(const void* param_value_p,
+                                   uint8_t *buf,
+                                   size_t buflen,
+                                   const mpl_param_descr2_t *descr_p);
+int mpl_pack_bin_param_value_enum16(const void* param_value_p,
+                                    uint8_t *buf,
+                                    size_t buflen,
+                                    const mpl_param_descr2_t *descr_p);
+int mpl_pack_bin_param_value_enum32(const void* param_value_p,
+                                    uint8_t *buf,
+                                    size_t buflen,
+                                    const mpl_param_descr2_t *descr_p);
+int mpl_pack_bin_param_value_signed_enum8(const void* param_value_p,
+                                          uint8_t *buf,
+                                          size_t buflen,
+                                          const mpl_param_descr2_t *descr_p);
+int mpl_pack_bin_param_value_signed_enum16(const void* param_value_p,
+                                           uint8_t *buf,
+                                           size_t buflen,
+                                           const mpl_param_descr2_t *descr_p);
+int mpl_pack_bin_param_value_signed_enum32(const void* param_value_p,
+                                           uint8_t *buf,
+                                           size_t buflen,
+                                           const mpl_param_descr2_t *descr_p);
+int mpl_pack_bin_param_value_bool(const void* param_value_p,
+                                  uint8_t *buf,
+                                  size_t buflen,
+                                  const mpl_param_descr2_t *descr_p);
+int mpl_pack_bin_param_value_bool8(const void* param_value_p,
+                                   uint8_t *buf,
+                                   size_t buflen,
+                                   const mpl_param_descr2_t *descr_p);
+int mpl_pack_bin_param_value_uint8_array(const void* param_value_p,
+                                         uint8_t *buf,
+                                         size_t buflen,
+                                         const mpl_param_descr2_t *descr_p);
+int mpl_pack_bin_param_value_uint16_array(const void* param_value_p,
+                                          uint8_t *buf,
+                                          size_t buflen,
+                                          const mpl_param_descr2_t *descr_p);
+int mpl_pack_bin_param_value_uint32_array(const void* param_value_p,
+                                          uint8_t *buf,
+                                          size_t buflen,
+                                          const mpl_param_descr2_t *descr_p);
+int mpl_pack_bin_param_value_string_tuple(const void* param_value_p,
+                                          uint8_t *buf,
+                                          size_t buflen,
+                                          const mpl_param_descr2_t *descr_p);
+int mpl_pack_bin_param_value_int_tuple(const void* param_value_p,
+                                       uint8_t *buf,
+                                       size_t buflen,
+                                       const mpl_param_descr2_t *descr_p);
+int mpl_pack_bin_param_value_strint_tuple(const void* param_value_p,
+                                          uint8_t *buf,
+                                          size_t buflen,
+                                          const mpl_param_descr2_t *descr_p);
+int mpl_pack_bin_param_value_struint8_tuple(const void* param_value_p,
+                                            uint8_t *buf,
+                                            size_t buflen,
+                                            const mpl_param_descr2_t *descr_p);
+int mpl_pack_bin_param_value_bag(const void* param_value_p,
+                                 uint8_t *buf,
+                                 size_t buflen,
+                                 const mpl_param_descr2_t *descr_p);
+int mpl_pack_bin_param_value_addr(const void* param_value_p,
+                                  uint8_t *buf,
+                                  size_t buflen,
+                                  const mpl_param_descr2_t *descr_p);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_packed_size_param_value_*
+ *
+ * Size of a packed value of a specific type
+ *
+ * See mpl_packed_size_param_fp for more details.
+ *
+ */
+int mpl_packed_size_param_value_string(const void* param_value_p,
+                                       const mpl_param_descr2_t *descr_p,
+                                       const mpl_pack_options_t *options_p);
+int mpl_packed_size_param_value_wstring(const void* param_value_p,
+                                        const mpl_param_descr2_t *descr_p,
+                                        const mpl_pack_options_t *options_p);
+int mpl_packed_size_param_value_int(const void* param_value_p,
+                                    const mpl_param_descr2_t *descr_p,
+                                    const mpl_pack_options_t *options_p);
+int mpl_packed_size_param_value_sint8(const void* param_value_p,
+                                      const mpl_param_descr2_t *descr_p,
+                                      const mpl_pack_options_t *options_p);
+int mpl_packed_size_param_value_sint16(const void* param_value_p,
+                                       const mpl_param_descr2_t *descr_p,
+                                       const mpl_pack_options_t *options_p);
+int mpl_packed_size_param_value_sint32(const void* param_value_p,
+                                       const mpl_param_descr2_t *descr_p,
+                                       const mpl_pack_options_t *options_p);
+int mpl_packed_size_param_value_sint64(const void* param_value_p,
+                                       const mpl_param_descr2_t *descr_p,
+                                       const mpl_pack_options_t *options_p);
+int mpl_packed_size_param_value_uint8(const void* param_value_p,
+                                      const mpl_param_descr2_t *descr_p,
+                                      const mpl_pack_options_t *options_p);
+int mpl_packed_size_param_value_uint16(const void* param_value_p,
+                                       const mpl_param_descr2_t *descr_p,
+                                       const mpl_pack_options_t *options_p);
+int mpl_packed_size_param_value_uint32(const void* param_value_p,
+                                       const mpl_param_descr2_t *descr_p,
+                                       const mpl_pack_options_t *options_p);
+int mpl_packed_size_param_value_uint64(const void* param_value_p,
+                                       const mpl_param_descr2_t *descr_p,
+                                       const mpl_pack_options_t *options_p);
+int mpl_packed_size_param_value_enum(const void* param_value_p,
+                                     const mpl_param_descr2_t *descr_p,
+                                     const mpl_pack_options_t *options_p);
+int mpl_packed_size_param_value_enum8(const void* param_value_p,
+                                      const mpl_param_descr2_t *descr_p,
+                                      const mpl_pack_options_t *options_p);
+int mpl_packed_size_param_value_enum16(const void* param_value_p,
+                                       const mpl_param_descr2_t *descr_p,
+                                       const mpl_pack_options_t *options_p);
+int mpl_packed_size_param_value_enum32(const void* param_value_p,
+                                       const mpl_param_descr2_t *descr_p,
+                                       const mpl_pack_options_t *options_p);
+int mpl_packed_size_param_value_signed_enum8(const void* param_value_p,
+                                             const mpl_param_descr2_t *descr_p,
+                                             const mpl_pack_options_t *options_p);
+int mpl_packed_size_param_value_signed_enum16(const void* param_value_p,
+                                              const mpl_param_descr2_t *descr_p,
+                                              const mpl_pack_options_t *options_p);
+int mpl_packed_size_param_value_signed_enum32(const void* param_value_p,
+                                              const mpl_param_descr2_t *descr_p,
+                                              const mpl_pack_options_t *options_p);
+int mpl_packed_size_param_value_bool(const void* param_value_p,
+                                     const mpl_param_descr2_t *descr_p,
+                                     const mpl_pack_options_t *options_p);
+int mpl_packed_size_param_value_bool8(const void* param_value_p,
+                                      const mpl_param_descr2_t *descr_p,
+                                      const mpl_pack_options_t *options_p);
+int mpl_packed_size_param_value_uint8_array(const void* param_value_p,
+                                            const mpl_param_descr2_t *descr_p,
+                                            const mpl_pack_options_t *options_p);
+int mpl_packed_size_param_value_uint16_array(const void* param_value_p,
+                                             const mpl_param_descr2_t *descr_p,
+                                             const mpl_pack_options_t *options_p);
+int mpl_packed_size_param_value_uint32_array(const void* param_value_p,
+                                             const mpl_param_descr2_t *descr_p,
+                                             const mpl_pack_options_t *options_p);
+int mpl_packed_size_param_value_string_tuple(const void* param_value_p,
+                                             const mpl_param_descr2_t *descr_p,
+                                             const mpl_pack_options_t *options_p);
+int mpl_packed_size_param_value_int_tuple(const void* param_value_p,
+                                          const mpl_param_descr2_t *descr_p,
+                                          const mpl_pack_options_t *options_p);
+int mpl_packed_size_param_value_strint_tuple(const void* param_value_p,
+                                             const mpl_param_descr2_t *descr_p,
+                                             const mpl_pack_options_t *options_p);
+int mpl_packed_size_param_value_struint8_tuple(const void* param_value_p,
+                                               const mpl_param_descr2_t *descr_p,
+                                               const mpl_pack_options_t *options_p);
+int mpl_packed_size_param_value_bag(const void* param_value_p,
+                                    const mpl_param_descr2_t *descr_p,
+                                    const mpl_pack_options_t *options_p);
+int mpl_packed_size_param_value_addr(const void* param_value_p,
+                                     const mpl_param_descr2_t *descr_p,
+                                     const mpl_pack_options_t *options_p);
+
+/**
+ * @ingroup MPL_PARAM
+ * mpl_unpack_bin_param_value_*
+ *
+ * Decode (unpack) a value of a specific type from binary "on the wire"
+ *              format to local format
+ *
+ * See mpl_unpack_bin_param_fp for more details.
+ *
+ */
+int mpl_unpack_bin_param_value_string(const uint8_t *buf,
+                                      size_t buflen,
+                                      void **value_pp,
+                                      const mpl_param_descr2_t *descr_p);
+int mpl_unpack_bin_param_value_wstring(const uint8_t *buf,
+                                       size_t buflen,
+                                       void **value_pp,
+                                       const mpl_param_descr2_t *descr_p);
+int mpl_unpack_bin_param_value_int(const uint8_t *buf,
+                                   size_t buflen,
+                                   void **value_pp,
+                                   const mpl_param_descr2_t *descr_p);
+int mpl_unpack_bin_param_value_sint8(const uint8_t *buf,
+                                     size_t buflen,
+                                     void **value_pp,
+                                     const mpl_param_descr2_t *descr_p);
+int mpl_unpack_bin_param_value_sint16(const uint8_t *buf,
+                                      size_t buflen,
+                                      void **value_pp,
+                                      const mpl_param_descr2_t *descr_p);
+int mpl_unpack_bin_param_value_sint32(const uint8_t *buf,
+                                      size_t buflen,
+                                      void **value_pp,
+                                      const mpl_param_descr2_t *descr_p);
+int mpl_unpack_bin_param_value_sint64(const uint8_t *buf,
+                                      size_t buflen,
+                                      void **value_pp,
+                                      const mpl_param_descr2_t *descr_p);
+int mpl_unpack_bin_param_value_uint8(const uint8_t *buf,
+                                     size_t buflen,
+                                     void **value_pp,
+                                     const mpl_param_descr2_t *descr_p);
+int mpl_unpack_bin_param_value_uint16(const uint8_t *buf,
+                                      size_t buflen,
+                                      void **value_pp,
+                                      const mpl_param_descr2_t *descr_p);
+int mpl_unpack_bin_param_value_uint32(const uint8_t *buf,
+                                      size_t buflen,
+                                      void **value_pp,
+                                      const mpl_param_descr2_t *descr_p);
+int mpl_unpack_bin_param_value_uint64(const uint8_t *buf,
+                                      size_t buflen,
+                                      void **value_pp,
+                                      const mpl_param_descr2_t *descr_p);
+int mpl_unpack_bin_param_value_enum(const uint8_t *buf,
+                                    size_t buflen,
+                                    void **value_pp,
+                                    const mpl_param_descr2_t *descr_p);
+int mpl_unpack_bin_param_value_enum8(const uint8_t *buf,
+                                     size_t buflen,
+                                     void **value_pp,
+                                     const mpl_param_descr2_t *descr_p);
+int mpl_unpack_bin_param_value_enum16(const uint8_t *buf,
+                                      size_t buflen,
+                                      void **value_pp,
+                                      const mpl_param_descr2_t *descr_p);
+int mpl_unpack_bin_param_value_enum32(const uint8_t *buf,
+                                      size_t buflen,
+                                      void **value_pp,
+                                      const mpl_param_descr2_t *descr_p);
+int mpl_unpack_bin_param_value_signed_enum8(const uint8_t *buf,
+                                            size_t buflen,
+                                            void **value_pp,
+                                            const mpl_param_descr2_t *descr_p);
+int mpl_unpack_bin_param_value_signed_enum16(const uint8_t *buf,
+                                             size_t buflen,
+                                             void **value_pp,
+                                             const mpl_param_descr2_t *descr_p);
+int mpl_unpack_bin_param_value_signed_enum32(const uint8_t *buf,
+                                             size_t buflen,
+                                             void **value_pp,
+                                             const mpl_param_descr2_t *descr_p);
+int mpl_unpack_bin_param_value_bool(const uint8_t *buf,
+                                    size_t buflen,
+                                    void **value_pp,
+                                    const mpl_param_descr2_t *descr_p);
+int mpl_unpack_bin_param_value_bool8(const uint8_t *buf,
+                                     size_t buflen,
+                                     void **value_pp,
+                                     const mpl_param_descr2_t *descr_p);
+int mpl_unpack_bin_param_value_uint8_array(const uint8_t *buf,
+                                           size_t buflen,
+                                           void **value_pp,
+                                           const mpl_param_descr2_t *descr_p);
+int mpl_unpack_bin_param_value_uint16_array(const uint8_t *buf,
+                                            size_t buflen,
+                                            void **value_pp,
+                                            const mpl_param_descr2_t *descr_p);
+int mpl_unpack_bin_param_value_uint32_array(const uint8_t *buf,
+                                            size_t buflen,
+                                            void **value_pp,
+                                            const mpl_param_descr2_t *descr_p);
+int mpl_unpack_bin_param_value_string_tuple(const uint8_t *buf,
+                                            size_t buflen,
+                                            void **value_pp,
+                                            const mpl_param_descr2_t *descr_p);
+int mpl_unpack_bin_param_value_int_tuple(const uint8_t *buf,
+                                         size_t buflen,
+                                         void **value_pp,
+                                         const mpl_param_descr2_t *descr_p);
+int mpl_unpack_bin_param_value_strint_tuple(const uint8_t *buf,
+                                            size_t buflen,
+                                            void **value_pp,
+                                            const mpl_param_descr2_t *descr_p);
+int mpl_unpack_bin_param_value_struint8_tuple(const uint8_t *buf,
+                                              size_t buflen,
+                                              void **value_pp,
+                                              const mpl_param_descr2_t *descr_p);
+int mpl_unpack_bin_param_value_bag(const uint8_t *buf,
+                                   size_t buflen,
+                                   void **value_pp,
+                                   const mpl_param_descr2_t *descr_p);
+int mpl_unpack_bin_param_value_addr(const uint8_t *buf,
+                                    size_t buflen,
+                                    void **value_pp,
+                                    const mpl_param_descr2_t *descr_p);
 
 #endif /* ! DOXYGEN */
 
@@ -4325,7 +5663,8 @@ int mpl_get_args(mpl_arg_t *args,
  * mpl_get_args_2
  *
  * Split argument-buffer into array of key/value pairs, version 2
- * If args_len == 0, array is allocated internally
+ * If args_len == 0, array is allocated internally, and grown as needed
+ * (no limit on the number of pairs). It must be freed by the caller.
  *
  * @param    args_pp      Pointer to array of key/value pairs
  * @param    args_len     Length of array (0 means allocate internally)
@@ -4972,6 +6311,11 @@ int mpl_compare_param_lists(mpl_list_t *list1_p, mpl_list_t *list2_p);
  *
  * Parse a string and convert to integer
  *
+ * The value is decimal, octal with a leading 0 or hex with "0x", and is
+ * truncated to an int, so e.g. "0x80000000" is INT_MIN. An empty value
+ * is an error, and so is a value that does not fit in 64 bits (it used
+ * to be clamped by strtol()).
+ *
  * @param value_str The source string
  * @param value_p Pointer to returned value (int)
  * @return 0 on success, -1 on error
@@ -51,6 +51,15 @@ int mpl_mutex_destroy(mpl_mutex_t *mutex_p);
 #define mpl_thread_t pthread_t
 #define mpl_get_current_thread_id pthread_self
 
+/* Thread local storage, destructor is called at thread exit */
+#define MPL_HAVE_THREAD_LOCAL
+#define mpl_thread_local_key_t pthread_key_t
+#define mpl_thread_local_create(key_p, destructor) \
+    pthread_key_create(key_p, destructor)
+#define mpl_thread_local_delete(key) pthread_key_delete(key)
+#define mpl_thread_local_get(key) pthread_getspecific(key)
+#define mpl_thread_local_set(key, value_p) pthread_setspecific(key, value_p)
+
 #elif defined(MPL_USE_OSE_MUTEX)
 
 #include "r_os.h"
@@ -122,4 +131,20 @@ extern apr_pool_t *mpl_global_pool_p;
 
 #endif // COMPILER_ARM
 
+/* Pointer publishing for lock free readers, the mutex is used without it */
+#if defined(__GNUC__) && defined(__ATOMIC_ACQUIRE)
+#define MPL_HAVE_ATOMIC_PTR
+#define mpl_atomic_load_ptr(ptr_p) __atomic_load_n(ptr_p, __ATOMIC_ACQUIRE)
+#define mpl_atomic_store_ptr(ptr_p, value_p) \
+    __atomic_store_n(ptr_p, value_p, __ATOMIC_RELEASE)
+
+/* Counters read without the mutex, only coherence per variable is needed */
+#define MPL_HAVE_ATOMIC_INT
+#define mpl_atomic_load_int(int_p) __atomic_load_n(int_p, __ATOMIC_RELAXED)
+#define mpl_atomic_store_int(int_p, value) \
+    __atomic_store_n(int_p, value, __ATOMIC_RELAXED)
+#define mpl_atomic_add_int(int_p, value) \
+    __atomic_add_fetch(int_p, value, __ATOMIC_RELAXED)
+#endif
+
 #endif
@@ -0,0 +1,1410 @@
+/*
+ *   Copyright 2013 ST-Ericsson SA
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ */
+
+/*************************************************************************
+ *
+ * File name: mpl_server.c
+ *
+ * Description: MPL request server runtime implementation
+ *
+ **************************************************************************/
+/*****************************************************************************
+ *
+ * Include files
+ *
+ *****************************************************************************/
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE                     /* accept4() */
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include "mpl_stdint.h"
+#include "mpl_server.h"
+#include "mpl_list.h"
+#include "mpl_dbgtrace.h"
+
+#if defined(__linux__) && defined(MPL_USE_PTHREAD_MUTEX)
+
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/*****************************************************************************
+ *
+ * Defines & Type definitions
+ *
+ *****************************************************************************/
+
+#define MPL_SERVER_READ_SIZE 65536
+#define MPL_SERVER_MAX_EVENTS 64
+#define MPL_SERVER_MAX_IOV 64
+#define MPL_SERVER_INITIAL_MSG_SIZE 256
+
+typedef enum
+{
+    mpl_server_watch_wakeup,
+    mpl_server_watch_listener,
+    mpl_server_watch_in,
+    mpl_server_watch_out
+} mpl_server_watch_kind_t;
+
+/* What an epoll event is for */
+typedef struct
+{
+    mpl_server_watch_kind_t kind;
+    void *owner_p;
+} mpl_server_watch_t;
+
+typedef struct mpl_server_conn_s mpl_server_conn_t;
+
+typedef struct mpl_server_job_s
+{
+    struct mpl_server_job_s *next_p;      /* Connection queue, in request
+                                             order */
+    struct mpl_server_job_s *work_next_p; /* Work queue or done list */
+    mpl_server_conn_t *conn_p;
+    char *resp_p;                         /* Packed response with
+                                             terminator, NULL if none */
+    size_t resp_len;
+    bool cancelled;                       /* Protected by the server lock */
+    bool done;                            /* Loop thread only */
+    char req[1];                          /* Request text, '\0'
+                                             terminated */
+} mpl_server_job_t;
+
+/* Everything in a connection is only used by the loop thread */
+struct mpl_server_conn_s
+{
+    mpl_server_conn_t *prev_p;
+    mpl_server_conn_t *next_p;
+    int in_fd;
+    int out_fd;
+    int in_flags;                       /* File status flags to restore */
+    int out_flags;
+    bool out_is_socket;
+    bool in_pollable;                   /* false for regular files */
+    mpl_server_watch_t in_watch;
+    mpl_server_watch_t out_watch;
+    uint32_t in_events;                 /* Registered with epoll */
+    uint32_t out_events;
+    bool in_eof;
+    bool out_blocked;                   /* Waiting for EPOLLOUT */
+    bool closed;
+    bool flush_pending;                 /* On the flush list */
+    mpl_server_conn_t *flush_next_p;
+    /* Message being received */
+    char *msg_p;
+    size_t msg_len;
+    size_t msg_size;
+    bool escaped;
+    bool in_value;
+    bool value_started;
+    int depth;
+    /* Requests waiting for (the rest of) their response to be written */
+    mpl_server_job_t *first_p;
+    mpl_server_job_t *last_p;
+    int in_flight;
+    int in_worker;                      /* Not yet back from a worker */
+    size_t out_offset;                  /* Written of first_p's response */
+};
+
+typedef struct mpl_server_listener_s
+{
+    struct mpl_server_listener_s *next_p;
+    int fd;
+    char *path_p;                       /* Unix socket file */
+    mpl_server_watch_t watch;
+} mpl_server_listener_t;
+
+struct mpl_server_s
+{
+    mpl_server_options_t options;
+    mpl_server_handler_fp handler;
+    void *ctx_p;
+    int epoll_fd;
+    int wakeup_fd;
+    mpl_server_watch_t wakeup_watch;
+    mpl_server_listener_t *listeners_p;
+    mpl_server_conn_t *conns_p;
+    char *read_buf_p;
+    int stop;                           /* Atomic, set by mpl_server_stop() */
+    /* Shared with the workers, protected by lock */
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    bool lock_created;
+    bool cond_created;
+    mpl_server_job_t *work_first_p;
+    mpl_server_job_t *work_last_p;
+    mpl_server_job_t *done_p;
+    bool quit;
+    pthread_t *workers_p;
+    int num_workers;                    /* Started */
+};
+
+typedef struct
+{
+    char *buf_p;
+    size_t len;
+    size_t size;
+} mpl_server_buf_t;
+
+/*****************************************************************************
+ *
+ * Private function prototypes
+ *
+ *****************************************************************************/
+
+static void *server_worker(void *arg_p);
+static void server_handle(mpl_server_t *server_p, mpl_server_job_t *job_p);
+static int server_buf_write(void *ctx_p, const char *data_p, size_t len);
+static void server_collect(mpl_server_t *server_p);
+static void server_accept(mpl_server_t *server_p,
+                          mpl_server_listener_t *listener_p);
+static void server_reap(mpl_server_t *server_p, bool all);
+static int server_add_listener(mpl_server_t *server_p,
+                               int fd,
+                               const char *path_p);
+static int server_watch(mpl_server_t *server_p,
+                        int fd,
+                        mpl_server_watch_t *watch_p,
+                        uint32_t *current_p,
+                        uint32_t wanted);
+static mpl_server_conn_t *conn_create(mpl_server_t *server_p,
+                                      int in_fd,
+                                      int out_fd);
+static void conn_update(mpl_server_t *server_p, mpl_server_conn_t *conn_p);
+static void conn_read(mpl_server_t *server_p, mpl_server_conn_t *conn_p);
+static int conn_scan(mpl_server_t *server_p,
+                     mpl_server_conn_t *conn_p,
+                     const char *data_p,
+                     size_t len);
+static int conn_append(mpl_server_conn_t *conn_p,
+                       const char *data_p,
+                       size_t len);
+static int conn_submit(mpl_server_t *server_p, mpl_server_conn_t *conn_p);
+static void conn_write(mpl_server_t *server_p, mpl_server_conn_t *conn_p);
+static void conn_close(mpl_server_t *server_p, mpl_server_conn_t *conn_p);
+static void conn_free(mpl_server_conn_t *conn_p);
+
+/****************************************************************************
+ *
+ * Public Functions
+ *
+ ****************************************************************************/
+
+/**
+ * mpl_server_create
+ */
+mpl_server_t *mpl_server_create(const mpl_server_options_t *options_p,
+                                mpl_server_handler_fp handler,
+                                void *ctx_p)
+{
+    mpl_server_t *server_p;
+    struct epoll_event ev;
+    int num_workers;
+    int i;
+
+    if (NULL == handler)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER, ("Missing parameter\n"));
+        mpl_set_errno(E_MPL_INVALID_PARAMETER);
+        return NULL;
+    }
+
+    server_p = calloc(1, sizeof(mpl_server_t));
+    if (NULL == server_p)
+        goto error_return;
+
+    server_p->epoll_fd = -1;
+    server_p->wakeup_fd = -1;
+    if (NULL != options_p)
+        server_p->options = *options_p;
+    if (server_p->options.max_in_flight <= 0)
+        server_p->options.max_in_flight = MPL_SERVER_DEFAULT_MAX_IN_FLIGHT;
+    server_p->handler = handler;
+    server_p->ctx_p = ctx_p;
+
+    server_p->read_buf_p = malloc(MPL_SERVER_READ_SIZE);
+    if (NULL == server_p->read_buf_p)
+        goto error_return;
+
+    if (pthread_mutex_init(&server_p->lock, NULL) != 0)
+        goto error_return;
+    server_p->lock_created = true;
+    if (pthread_cond_init(&server_p->cond, NULL) != 0)
+        goto error_return;
+    server_p->cond_created = true;
+
+    server_p->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    server_p->wakeup_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if ((server_p->epoll_fd < 0) || (server_p->wakeup_fd < 0))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Could not create epoll or eventfd: %s\n",
+                             strerror(errno)));
+        mpl_set_errno(E_MPL_FAILED_OPERATION);
+        mpl_server_destroy(server_p);
+        return NULL;
+    }
+    server_p->wakeup_watch.kind = mpl_server_watch_wakeup;
+    server_p->wakeup_watch.owner_p = server_p;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.ptr = &server_p->wakeup_watch;
+    if (epoll_ctl(server_p->epoll_fd,
+                  EPOLL_CTL_ADD,
+                  server_p->wakeup_fd,
+                  &ev) < 0)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("epoll_ctl failed: %s\n", strerror(errno)));
+        mpl_set_errno(E_MPL_FAILED_OPERATION);
+        mpl_server_destroy(server_p);
+        return NULL;
+    }
+
+    num_workers = server_p->options.num_workers;
+    if (num_workers <= 0)
+        num_workers = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    if (num_workers <= 0)
+        num_workers = 1;
+    server_p->workers_p = calloc(num_workers, sizeof(pthread_t));
+    if (NULL == server_p->workers_p)
+        goto error_return;
+    for (i = 0; i < num_workers; i++)
+    {
+        if (pthread_create(&server_p->workers_p[i],
+                           NULL,
+                           server_worker,
+                           server_p) != 0)
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("Could not start worker thread\n"));
+            mpl_set_errno(E_MPL_FAILED_OPERATION);
+            mpl_server_destroy(server_p);
+            return NULL;
+        }
+        server_p->num_workers++;
+    }
+
+    return server_p;
+
+ error_return:
+    MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY, ("No memory\n"));
+    mpl_set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+    mpl_server_destroy(server_p);
+    return NULL;
+}
+
+/**
+ * mpl_server_destroy
+ */
+void mpl_server_destroy(mpl_server_t *server_p)
+{
+    mpl_server_listener_t *listener_p;
+    mpl_server_conn_t *conn_p;
+    int i;
+
+    if (NULL == server_p)
+        return;
+
+    if (server_p->num_workers > 0)
+    {
+        (void) pthread_mutex_lock(&server_p->lock);
+        server_p->quit = true;
+        (void) pthread_cond_broadcast(&server_p->cond);
+        (void) pthread_mutex_unlock(&server_p->lock);
+        for (i = 0; i < server_p->num_workers; i++)
+            (void) pthread_join(server_p->workers_p[i], NULL);
+    }
+
+    /* The workers are gone, so every job is only in its connection */
+    for (conn_p = server_p->conns_p; NULL != conn_p; conn_p = conn_p->next_p)
+    {
+        conn_close(server_p, conn_p);
+        conn_p->in_worker = 0;
+    }
+    server_reap(server_p, true);
+
+    while (NULL != server_p->listeners_p)
+    {
+        listener_p = server_p->listeners_p;
+        server_p->listeners_p = listener_p->next_p;
+        (void) close(listener_p->fd);
+        if (NULL != listener_p->path_p)
+        {
+            (void) unlink(listener_p->path_p);
+            free(listener_p->path_p);
+        }
+        free(listener_p);
+    }
+
+    if (server_p->wakeup_fd >= 0)
+        (void) close(server_p->wakeup_fd);
+    if (server_p->epoll_fd >= 0)
+        (void) close(server_p->epoll_fd);
+    if (server_p->cond_created)
+        (void) pthread_cond_destroy(&server_p->cond);
+    if (server_p->lock_created)
+        (void) pthread_mutex_destroy(&server_p->lock);
+    free(server_p->workers_p);
+    free(server_p->read_buf_p);
+    free(server_p);
+}
+
+/**
+ * mpl_server_listen_unix
+ */
+int mpl_server_listen_unix(mpl_server_t *server_p, const char *path_p)
+{
+    struct sockaddr_un addr;
+    struct stat st;
+    int fd;
+
+    if ((NULL == server_p) || (NULL == path_p) ||
+        (strlen(path_p) >= sizeof(addr.sun_path)))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                            ("Missing parameter or path too long\n"));
+        mpl_set_errno(E_MPL_INVALID_PARAMETER);
+        return -1;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path_p);
+
+    /* Replace a socket left by an earlier run, but no other file */
+    if ((stat(path_p, &st) == 0) && S_ISSOCK(st.st_mode))
+        (void) unlink(path_p);
+
+    fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if ((fd < 0) ||
+        (bind(fd, (struct sockaddr*) &addr, sizeof(addr)) < 0) ||
+        (listen(fd, SOMAXCONN) < 0))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Could not listen on %s: %s\n",
+                             path_p, strerror(errno)));
+        mpl_set_errno(E_MPL_FAILED_OPERATION);
+        if (fd >= 0)
+            (void) close(fd);
+        return -1;
+    }
+
+    return server_add_listener(server_p, fd, path_p);
+}
+
+/**
+ * mpl_server_listen_tcp
+ */
+int mpl_server_listen_tcp(mpl_server_t *server_p, int port)
+{
+    struct sockaddr_in addr;
+    socklen_t addr_len = sizeof(addr);
+    int fd;
+    int one = 1;
+
+    if ((NULL == server_p) || (port < 0) || (port > 65535))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                            ("Missing parameter or bad port\n"));
+        mpl_set_errno(E_MPL_INVALID_PARAMETER);
+        return -1;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t) port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if ((fd < 0) ||
+        (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) < 0) ||
+        (bind(fd, (struct sockaddr*) &addr, sizeof(addr)) < 0) ||
+        (listen(fd, SOMAXCONN) < 0) ||
+        (getsockname(fd, (struct sockaddr*) &addr, &addr_len) < 0))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Could not listen on port %d: %s\n",
+                             port, strerror(errno)));
+        mpl_set_errno(E_MPL_FAILED_OPERATION);
+        if (fd >= 0)
+            (void) close(fd);
+        return -1;
+    }
+
+    if (server_add_listener(server_p, fd, NULL) < 0)
+        return -1;
+    return ntohs(addr.sin_port);
+}
+
+/**
+ * mpl_server_add_connection
+ */
+int mpl_server_add_connection(mpl_server_t *server_p, int in_fd, int out_fd)
+{
+    if ((NULL == server_p) || (in_fd < 0) || (out_fd < 0))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER, ("Missing parameter\n"));
+        mpl_set_errno(E_MPL_INVALID_PARAMETER);
+        return -1;
+    }
+
+    return (NULL != conn_create(server_p, in_fd, out_fd)) ? 0 : -1;
+}
+
+/**
+ * mpl_server_run
+ */
+int mpl_server_run(mpl_server_t *server_p)
+{
+    struct epoll_event events[MPL_SERVER_MAX_EVENTS];
+    mpl_server_watch_t *watch_p;
+    mpl_server_conn_t *conn_p;
+    mpl_server_conn_t *next_p;
+    bool have_files;
+    int num_events;
+    int i;
+
+    if (NULL == server_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER, ("Missing parameter\n"));
+        mpl_set_errno(E_MPL_INVALID_PARAMETER);
+        return -1;
+    }
+
+    while (!__atomic_load_n(&server_p->stop, __ATOMIC_SEQ_CST))
+    {
+        server_reap(server_p, false);
+        if ((NULL == server_p->listeners_p) && (NULL == server_p->conns_p))
+            break;
+
+        /* Regular files can not be polled, they are always readable */
+        have_files = false;
+        for (conn_p = server_p->conns_p; NULL != conn_p; conn_p = conn_p->next_p)
+        {
+            if (!conn_p->in_pollable && !conn_p->closed && !conn_p->in_eof &&
+                (conn_p->in_flight < server_p->options.max_in_flight))
+                have_files = true;
+        }
+
+        num_events = epoll_wait(server_p->epoll_fd,
+                                events,
+                                MPL_SERVER_MAX_EVENTS,
+                                have_files ? 0 : -1);
+        if (num_events < 0)
+        {
+            if (EINTR == errno)
+                continue;
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("epoll_wait failed: %s\n", strerror(errno)));
+            mpl_set_errno(E_MPL_FAILED_OPERATION);
+            return -1;
+        }
+
+        /* Connections are only freed by server_reap(), so a connection
+           closed by one event is still there for the next */
+        for (i = 0; i < num_events; i++)
+        {
+            watch_p = events[i].data.ptr;
+            switch (watch_p->kind)
+            {
+                case mpl_server_watch_wakeup:
+                    server_collect(server_p);
+                    break;
+                case mpl_server_watch_listener:
+                    server_accept(server_p, watch_p->owner_p);
+                    break;
+                case mpl_server_watch_in:
+                    conn_p = watch_p->owner_p;
+                    if ((events[i].events & EPOLLOUT) ||
+                        ((events[i].events & (EPOLLERR | EPOLLHUP)) &&
+                         !(conn_p->in_events & EPOLLIN)))
+                        conn_write(server_p, conn_p);
+                    if (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP))
+                        conn_read(server_p, conn_p);
+                    break;
+                case mpl_server_watch_out:
+                    conn_write(server_p, watch_p->owner_p);
+                    break;
+            }
+        }
+
+        if (have_files)
+        {
+            for (conn_p = server_p->conns_p; NULL != conn_p; conn_p = next_p)
+            {
+                next_p = conn_p->next_p;
+                if (!conn_p->in_pollable)
+                    conn_read(server_p, conn_p);
+            }
+        }
+    }
+
+    __atomic_store_n(&server_p->stop, 0, __ATOMIC_SEQ_CST);
+    return 0;
+}
+
+/**
+ * mpl_server_stop
+ */
+void mpl_server_stop(mpl_server_t *server_p)
+{
+    uint64_t one = 1;
+
+    if (NULL == server_p)
+        return;
+
+    __atomic_store_n(&server_p->stop, 1, __ATOMIC_SEQ_CST);
+    if (write(server_p->wakeup_fd, &one, sizeof(one)) < 0)
+    {
+        /* The counter is already set */
+    }
+}
+
+/****************************************************************************
+ *
+ * Private Functions
+ *
+ ****************************************************************************/
+
+/**
+ * server_worker
+ *
+ * Handle requests from the work queue. A finished job goes on the done
+ * list, and the loop thread is woken when the list was empty (otherwise
+ * it has not yet taken the list and will see the job anyway).
+ */
+static void *server_worker(void *arg_p)
+{
+    mpl_server_t *server_p = arg_p;
+    mpl_server_job_t *job_p;
+    uint64_t one = 1;
+    bool cancelled;
+    bool wakeup;
+
+    (void) pthread_mutex_lock(&server_p->lock);
+    for (;;)
+    {
+        while (!server_p->quit && (NULL == server_p->work_first_p))
+            (void) pthread_cond_wait(&server_p->cond, &server_p->lock);
+        if (server_p->quit)
+            break;
+
+        job_p = server_p->work_first_p;
+        server_p->work_first_p = job_p->work_next_p;
+        if (NULL == server_p->work_first_p)
+            server_p->work_last_p = NULL;
+        cancelled = job_p->cancelled;
+        (void) pthread_mutex_unlock(&server_p->lock);
+
+        if (!cancelled)
+            server_handle(server_p, job_p);
+
+        (void) pthread_mutex_lock(&server_p->lock);
+        wakeup = (NULL == server_p->done_p);
+        job_p->work_next_p = server_p->done_p;
+        server_p->done_p = job_p;
+        if (wakeup && (write(server_p->wakeup_fd, &one, sizeof(one)) < 0))
+        {
+            /* The counter is already set */
+        }
+    }
+    (void) pthread_mutex_unlock(&server_p->lock);
+    return NULL;
+}
+
+/**
+ * server_handle
+ *
+ * Unpack a request, call the handler and pack the response.
+ */
+static void server_handle(mpl_server_t *server_p, mpl_server_job_t *job_p)
+{
+    mpl_list_t *req_p;
+    mpl_list_t *resp_p;
+    mpl_server_buf_t buf = { NULL, 0, 0 };
+    bool has_error = false;
+
+    req_p = mpl_param_list_unpack_error(job_p->req, &has_error);
+    resp_p = server_p->handler(server_p->ctx_p, req_p, has_error);
+    mpl_param_list_destroy(&req_p);
+    if (NULL == resp_p)
+        return;
+
+    if ((mpl_param_list_pack_stream(resp_p,
+                                    server_buf_write,
+                                    &buf,
+                                    NULL) < 0) ||
+        (server_buf_write(&buf, "\n", 1) < 0))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Could not pack response\n"));
+        free(buf.buf_p);
+    }
+    else
+    {
+        job_p->resp_p = buf.buf_p;
+        job_p->resp_len = buf.len;
+    }
+    mpl_param_list_destroy(&resp_p);
+}
+
+/**
+ * server_buf_write
+ */
+static int server_buf_write(void *ctx_p, const char *data_p, size_t len)
+{
+    mpl_server_buf_t *buf_p = ctx_p;
+    char *new_p;
+    size_t size;
+
+    if (buf_p->len + len > buf_p->size)
+    {
+        size = (buf_p->size > 0) ? buf_p->size : MPL_SERVER_INITIAL_MSG_SIZE;
+        while (buf_p->len + len > size)
+            size *= 2;
+        new_p = realloc(buf_p->buf_p, size);
+        if (NULL == new_p)
+            return -1;
+        buf_p->buf_p = new_p;
+        buf_p->size = size;
+    }
+    memcpy(buf_p->buf_p + buf_p->len, data_p, len);
+    buf_p->len += len;
+    return 0;
+}
+
+/**
+ * server_collect
+ *
+ * Take the jobs finished by the workers and write the responses that
+ * are next in line.
+ */
+static void server_collect(mpl_server_t *server_p)
+{
+    mpl_server_job_t *job_p;
+    mpl_server_conn_t *conn_p;
+    mpl_server_conn_t *flush_p = NULL;
+    uint64_t count;
+
+    if (read(server_p->wakeup_fd, &count, sizeof(count)) < 0)
+    {
+        /* Nothing to read, e.g. woken up twice */
+    }
+
+    (void) pthread_mutex_lock(&server_p->lock);
+    job_p = server_p->done_p;
+    server_p->done_p = NULL;
+    (void) pthread_mutex_unlock(&server_p->lock);
+
+    for (; NULL != job_p; job_p = job_p->work_next_p)
+    {
+        job_p->done = true;
+        conn_p = job_p->conn_p;
+        conn_p->in_worker--;
+        if (!conn_p->flush_pending)
+        {
+            conn_p->flush_pending = true;
+            conn_p->flush_next_p = flush_p;
+            flush_p = conn_p;
+        }
+    }
+
+    while (NULL != flush_p)
+    {
+        conn_p = flush_p;
+        flush_p = conn_p->flush_next_p;
+        conn_p->flush_pending = false;
+        conn_write(server_p, conn_p);
+    }
+}
+
+/**
+ * server_accept
+ */
+static void server_accept(mpl_server_t *server_p,
+                          mpl_server_listener_t *listener_p)
+{
+    int fd;
+
+    for (;;)
+    {
+        fd = accept4(listener_p->fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            if (EINTR == errno)
+                continue;
+            if ((EAGAIN != errno) && (EWOULDBLOCK != errno))
+                MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                    ("accept failed: %s\n", strerror(errno)));
+            return;
+        }
+        if (NULL == conn_create(server_p, fd, fd))
+            (void) close(fd);
+    }
+}
+
+/**
+ * server_reap
+ *
+ * Free the closed connections that no worker is using (all of them if
+ * all is set).
+ */
+static void server_reap(mpl_server_t *server_p, bool all)
+{
+    mpl_server_conn_t *conn_p;
+    mpl_server_conn_t *next_p;
+
+    for (conn_p = server_p->conns_p; NULL != conn_p; conn_p = next_p)
+    {
+        next_p = conn_p->next_p;
+        if (!conn_p->closed || ((conn_p->in_worker > 0) && !all))
+            continue;
+        if (NULL != conn_p->prev_p)
+            conn_p->prev_p->next_p = conn_p->next_p;
+        else
+            server_p->conns_p = conn_p->next_p;
+        if (NULL != conn_p->next_p)
+            conn_p->next_p->prev_p = conn_p->prev_p;
+        conn_free(conn_p);
+    }
+}
+
+/**
+ * server_add_listener
+ */
+static int server_add_listener(mpl_server_t *server_p,
+                               int fd,
+                               const char *path_p)
+{
+    mpl_server_listener_t *listener_p;
+    uint32_t events = 0;
+
+    listener_p = calloc(1, sizeof(mpl_server_listener_t));
+    if ((NULL != listener_p) && (NULL != path_p))
+    {
+        listener_p->path_p = malloc(strlen(path_p) + 1);
+        if (NULL == listener_p->path_p)
+        {
+            free(listener_p);
+            listener_p = NULL;
+        }
+        else
+            strcpy(listener_p->path_p, path_p);
+    }
+    if (NULL == listener_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY, ("No memory\n"));
+        mpl_set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        (void) close(fd);
+        return -1;
+    }
+
+    listener_p->fd = fd;
+    listener_p->watch.kind = mpl_server_watch_listener;
+    listener_p->watch.owner_p = listener_p;
+    listener_p->next_p = server_p->listeners_p;
+    server_p->listeners_p = listener_p;
+    return server_watch(server_p, fd, &listener_p->watch, &events, EPOLLIN);
+}
+
+/**
+ * server_watch
+ *
+ * Register, change or remove the events of a file descriptor.
+ */
+static int server_watch(mpl_server_t *server_p,
+                        int fd,
+                        mpl_server_watch_t *watch_p,
+                        uint32_t *current_p,
+                        uint32_t wanted)
+{
+    struct epoll_event ev;
+    int op;
+
+    if (wanted == *current_p)
+        return 0;
+
+    if (0 == wanted)
+        op = EPOLL_CTL_DEL;
+    else if (0 == *current_p)
+        op = EPOLL_CTL_ADD;
+    else
+        op = EPOLL_CTL_MOD;
+
+    memset(&ev, 0, sizeof(ev));
+    ev.events = wanted;
+    ev.data.ptr = watch_p;
+    if (epoll_ctl(server_p->epoll_fd, op, fd, &ev) < 0)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("epoll_ctl failed: %s\n", strerror(errno)));
+        mpl_set_errno(E_MPL_FAILED_OPERATION);
+        return -1;
+    }
+    *current_p = wanted;
+    return 0;
+}
+
+/**
+ * conn_create
+ */
+static mpl_server_conn_t *conn_create(mpl_server_t *server_p,
+                                      int in_fd,
+                                      int out_fd)
+{
+    mpl_server_conn_t *conn_p;
+    struct stat st;
+
+    conn_p = calloc(1, sizeof(mpl_server_conn_t));
+    if (NULL != conn_p)
+    {
+        conn_p->msg_size = MPL_SERVER_INITIAL_MSG_SIZE;
+        conn_p->msg_p = malloc(conn_p->msg_size);
+    }
+    if ((NULL == conn_p) || (NULL == conn_p->msg_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY, ("No memory\n"));
+        mpl_set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        if (NULL != conn_p)
+            free(conn_p);
+        return NULL;
+    }
+
+    conn_p->in_fd = in_fd;
+    conn_p->out_fd = out_fd;
+    conn_p->in_watch.kind = mpl_server_watch_in;
+    conn_p->in_watch.owner_p = conn_p;
+    conn_p->out_watch.kind = mpl_server_watch_out;
+    conn_p->out_watch.owner_p = conn_p;
+    conn_p->in_pollable = !((fstat(in_fd, &st) == 0) && S_ISREG(st.st_mode));
+    conn_p->out_is_socket = ((fstat(out_fd, &st) == 0) && S_ISSOCK(st.st_mode));
+
+    conn_p->in_flags = fcntl(in_fd, F_GETFL);
+    conn_p->out_flags = fcntl(out_fd, F_GETFL);
+    if ((conn_p->in_flags < 0) || (conn_p->out_flags < 0))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                            ("Bad file descriptor\n"));
+        mpl_set_errno(E_MPL_INVALID_PARAMETER);
+        free(conn_p->msg_p);
+        free(conn_p);
+        return NULL;
+    }
+    (void) fcntl(in_fd, F_SETFL, conn_p->in_flags | O_NONBLOCK);
+    (void) fcntl(out_fd, F_SETFL, conn_p->out_flags | O_NONBLOCK);
+
+    conn_p->next_p = server_p->conns_p;
+    if (NULL != server_p->conns_p)
+        server_p->conns_p->prev_p = conn_p;
+    server_p->conns_p = conn_p;
+
+    conn_update(server_p, conn_p);
+    if (conn_p->closed)
+        return NULL;
+    return conn_p;
+}
+
+/**
+ * conn_update
+ *
+ * Register the events the connection is waiting for: input unless it
+ * has ended or too many requests are in flight, output if a response
+ * could not be written completely. A socket is registered once, with
+ * both.
+ */
+static void conn_update(mpl_server_t *server_p, mpl_server_conn_t *conn_p)
+{
+    uint32_t in_wanted = 0;
+    uint32_t out_wanted = 0;
+    int res;
+
+    if (conn_p->closed)
+        return;
+
+    if (conn_p->in_pollable && !conn_p->in_eof &&
+        (conn_p->in_flight < server_p->options.max_in_flight))
+        in_wanted = EPOLLIN;
+    if (conn_p->out_blocked)
+        out_wanted = EPOLLOUT;
+
+    if (conn_p->in_fd == conn_p->out_fd)
+        res = server_watch(server_p,
+                           conn_p->in_fd,
+                           &conn_p->in_watch,
+                           &conn_p->in_events,
+                           in_wanted | out_wanted);
+    else
+        res = ((server_watch(server_p,
+                             conn_p->in_fd,
+                             &conn_p->in_watch,
+                             &conn_p->in_events,
+                             in_wanted) < 0) ||
+               (server_watch(server_p,
+                             conn_p->out_fd,
+                             &conn_p->out_watch,
+                             &conn_p->out_events,
+                             out_wanted) < 0)) ? -1 : 0;
+    if (res < 0)
+        conn_close(server_p, conn_p);
+}
+
+/**
+ * conn_read
+ *
+ * Read one chunk of input. Level triggered epoll brings us back if there
+ * is more, after the other connections have had their turn.
+ */
+static void conn_read(mpl_server_t *server_p, mpl_server_conn_t *conn_p)
+{
+    ssize_t bytes_read;
+
+    if (conn_p->closed || conn_p->in_eof ||
+        (conn_p->in_flight >= server_p->options.max_in_flight))
+        return;
+
+    do
+    {
+        bytes_read = read(conn_p->in_fd,
+                          server_p->read_buf_p,
+                          MPL_SERVER_READ_SIZE);
+    } while ((bytes_read < 0) && (EINTR == errno));
+
+    if (bytes_read < 0)
+    {
+        if ((EAGAIN == errno) || (EWOULDBLOCK == errno))
+            return;
+        conn_close(server_p, conn_p);
+        return;
+    }
+
+    if (0 == bytes_read)
+    {
+        /* A last message without terminator */
+        conn_p->in_eof = true;
+        if (conn_submit(server_p, conn_p) < 0)
+        {
+            conn_close(server_p, conn_p);
+            return;
+        }
+        conn_update(server_p, conn_p);
+        conn_write(server_p, conn_p);
+        return;
+    }
+
+    if (conn_scan(server_p, conn_p, server_p->read_buf_p, bytes_read) < 0)
+    {
+        conn_close(server_p, conn_p);
+        return;
+    }
+    conn_update(server_p, conn_p);
+}
+
+/**
+ * conn_scan
+ *
+ * Split the input into messages. A message ends at a newline outside
+ * of any {} value, with the same rules as mpl_unpack_stream_feed(), but
+ * nothing is unpacked here: that is done by the workers.
+ */
+static int conn_scan(mpl_server_t *server_p,
+                     mpl_server_conn_t *conn_p,
+                     const char *data_p,
+                     size_t len)
+{
+    mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
+    const char *start_p = data_p;
+    const char *end_p = data_p + len;
+    const char *p;
+    char c;
+
+    for (p = data_p; p < end_p; p++)
+    {
+        c = *p;
+
+        if (conn_p->escaped)
+        {
+            conn_p->escaped = false;
+            continue;
+        }
+
+        if ('\\' == c)
+        {
+            conn_p->escaped = true;
+            continue;
+        }
+
+        if (conn_p->depth > 0)
+        {
+            if ('{' == c)
+                conn_p->depth++;
+            else if ('}' == c)
+                conn_p->depth--;
+            continue;
+        }
+
+        if ('\n' == c)
+        {
+            if ((conn_append(conn_p, start_p, p - start_p) < 0) ||
+                (conn_submit(server_p, conn_p) < 0))
+                return -1;
+            start_p = p + 1;
+            continue;
+        }
+
+        if (c == options.message_delimiter)
+        {
+            conn_p->in_value = false;
+            conn_p->value_started = false;
+        }
+        else if (!conn_p->in_value)
+        {
+            if ('=' == c)
+                conn_p->in_value = true;
+        }
+        else if (!conn_p->value_started && !isspace((unsigned char)c))
+        {
+            conn_p->value_started = true;
+            if ('{' == c)
+                conn_p->depth = 1;
+        }
+    }
+
+    return conn_append(conn_p, start_p, end_p - start_p);
+}
+
+/**
+ * conn_append
+ */
+static int conn_append(mpl_server_conn_t *conn_p,
+                       const char *data_p,
+                       size_t len)
+{
+    char *new_p;
+    size_t size;
+
+    if (conn_p->msg_len + len >= conn_p->msg_size)
+    {
+        size = conn_p->msg_size;
+        while (conn_p->msg_len + len >= size)
+            size *= 2;
+        new_p = realloc(conn_p->msg_p, size);
+        if (NULL == new_p)
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                                ("No memory\n"));
+            mpl_set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+            return -1;
+        }
+        conn_p->msg_p = new_p;
+        conn_p->msg_size = size;
+    }
+    memcpy(conn_p->msg_p + conn_p->msg_len, data_p, len);
+    conn_p->msg_len += len;
+    return 0;
+}
+
+/**
+ * conn_submit
+ *
+ * Queue the received message for the workers (empty lines are
+ * skipped).
+ */
+static int conn_submit(mpl_server_t *server_p, mpl_server_conn_t *conn_p)
+{
+    mpl_server_job_t *job_p;
+    size_t i;
+
+    conn_p->escaped = false;
+    conn_p->in_value = false;
+    conn_p->value_started = false;
+    conn_p->depth = 0;
+
+    for (i = 0; i < conn_p->msg_len; i++)
+    {
+        if (!isspace((unsigned char)conn_p->msg_p[i]))
+            break;
+    }
+    if (i == conn_p->msg_len)
+    {
+        conn_p->msg_len = 0;
+        return 0;
+    }
+
+    job_p = calloc(1, sizeof(mpl_server_job_t) + conn_p->msg_len);
+    if (NULL == job_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY, ("No memory\n"));
+        mpl_set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return -1;
+    }
+    memcpy(job_p->req, conn_p->msg_p, conn_p->msg_len);
+    job_p->req[conn_p->msg_len] = '\0';
+    conn_p->msg_len = 0;
+
+    job_p->conn_p = conn_p;
+    if (NULL != conn_p->last_p)
+        conn_p->last_p->next_p = job_p;
+    else
+        conn_p->first_p = job_p;
+    conn_p->last_p = job_p;
+    conn_p->in_flight++;
+    conn_p->in_worker++;
+
+    (void) pthread_mutex_lock(&server_p->lock);
+    if (NULL != server_p->work_last_p)
+        server_p->work_last_p->work_next_p = job_p;
+    else
+        server_p->work_first_p = job_p;
+    server_p->work_last_p = job_p;
+    (void) pthread_cond_signal(&server_p->cond);
+    (void) pthread_mutex_unlock(&server_p->lock);
+    return 0;
+}
+
+/**
+ * conn_write
+ *
+ * Write the responses at the head of the queue that are ready, several
+ * at a time. A request without response is just dropped when its turn
+ * comes.
+ */
+static void conn_write(mpl_server_t *server_p, mpl_server_conn_t *conn_p)
+{
+    struct iovec iov[MPL_SERVER_MAX_IOV];
+    struct msghdr msg;
+    mpl_server_job_t *job_p;
+    ssize_t written;
+    size_t offset;
+    size_t left;
+    int num_iov;
+
+    if (conn_p->closed)
+        return;
+
+    conn_p->out_blocked = false;
+    for (;;)
+    {
+        while ((NULL != conn_p->first_p) && conn_p->first_p->done &&
+               (NULL == conn_p->first_p->resp_p))
+        {
+            job_p = conn_p->first_p;
+            conn_p->first_p = job_p->next_p;
+            if (NULL == conn_p->first_p)
+                conn_p->last_p = NULL;
+            conn_p->in_flight--;
+            free(job_p);
+        }
+
+        num_iov = 0;
+        offset = conn_p->out_offset;
+        for (job_p = conn_p->first_p;
+             (NULL != job_p) && job_p->done && (num_iov < MPL_SERVER_MAX_IOV);
+             job_p = job_p->next_p)
+        {
+            if (NULL == job_p->resp_p)
+                continue;
+            iov[num_iov].iov_base = job_p->resp_p + offset;
+            iov[num_iov].iov_len = job_p->resp_len - offset;
+            num_iov++;
+            offset = 0;
+        }
+        if (0 == num_iov)
+            break;
+
+        if (conn_p->out_is_socket)
+        {
+            memset(&msg, 0, sizeof(msg));
+            msg.msg_iov = iov;
+            msg.msg_iovlen = num_iov;
+            written = sendmsg(conn_p->out_fd, &msg, MSG_NOSIGNAL);
+        }
+        else
+            written = writev(conn_p->out_fd, iov, num_iov);
+
+        if (written < 0)
+        {
+            if (EINTR == errno)
+                continue;
+            if ((EAGAIN == errno) || (EWOULDBLOCK == errno))
+            {
+                conn_p->out_blocked = true;
+                break;
+            }
+            conn_close(server_p, conn_p);
+            return;
+        }
+
+        /* Free the responses that were written completely */
+        left = (size_t) written;
+        while (left > 0)
+        {
+            job_p = conn_p->first_p;
+            if (NULL == job_p->resp_p)
+            {
+                conn_p->first_p = job_p->next_p;
+                conn_p->in_flight--;
+                free(job_p);
+                continue;
+            }
+            if (left < job_p->resp_len - conn_p->out_offset)
+            {
+                conn_p->out_offset += left;
+                break;
+            }
+            left -= job_p->resp_len - conn_p->out_offset;
+            conn_p->out_offset = 0;
+            conn_p->first_p = job_p->next_p;
+            conn_p->in_flight--;
+            free(job_p->resp_p);
+            free(job_p);
+        }
+        if (NULL == conn_p->first_p)
+            conn_p->last_p = NULL;
+    }
+
+    if (conn_p->in_eof && (NULL == conn_p->first_p))
+    {
+        conn_close(server_p, conn_p);
+        return;
+    }
+    conn_update(server_p, conn_p);
+}
+
+/**
+ * conn_close
+ *
+ * Stop serving the connection. Requests that no worker has started are
+ * cancelled, and the connection is freed by server_reap() when the
+ * workers are done with it.
+ */
+static void conn_close(mpl_server_t *server_p, mpl_server_conn_t *conn_p)
+{
+    mpl_server_job_t *job_p;
+    uint32_t none = 0;
+
+    if (conn_p->closed)
+        return;
+
+    (void) server_watch(server_p,
+                        conn_p->in_fd,
+                        &conn_p->in_watch,
+                        &conn_p->in_events,
+                        none);
+    if (conn_p->out_fd != conn_p->in_fd)
+        (void) server_watch(server_p,
+                            conn_p->out_fd,
+                            &conn_p->out_watch,
+                            &conn_p->out_events,
+                            none);
+    conn_p->closed = true;
+
+    (void) pthread_mutex_lock(&server_p->lock);
+    for (job_p = conn_p->first_p; NULL != job_p; job_p = job_p->next_p)
+        job_p->cancelled = true;
+    (void) pthread_mutex_unlock(&server_p->lock);
+
+    /* Standard streams are left open, as they were found */
+    if (conn_p->in_fd > 2)
+        (void) close(conn_p->in_fd);
+    else
+        (void) fcntl(conn_p->in_fd, F_SETFL, conn_p->in_flags);
+    if (conn_p->out_fd != conn_p->in_fd)
+    {
+        if (conn_p->out_fd > 2)
+            (void) close(conn_p->out_fd);
+        else
+            (void) fcntl(conn_p->out_fd, F_SETFL, conn_p->out_flags);
+    }
+}
+
+/**
+ * conn_free
+ */
+static void conn_free(mpl_server_conn_t *conn_p)
+{
+    mpl_server_job_t *job_p;
+
+    while (NULL != conn_p->first_p)
+    {
+        job_p = conn_p->first_p;
+        conn_p->first_p = job_p->next_p;
+        free(job_p->resp_p);
+        free(job_p);
+    }
+    free(conn_p->msg_p);
+    free(conn_p);
+}
+
+#else /* defined(__linux__) && defined(MPL_USE_PTHREAD_MUTEX) */
+
+/* epoll and pthreads are needed, everything fails elsewhere */
+
+mpl_server_t *mpl_server_create(const mpl_server_options_t *options_p,
+                                mpl_server_handler_fp handler,
+                                void *ctx_p)
+{
+    MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION, ("Not supported\n"));
+    mpl_set_errno(E_MPL_FAILED_OPERATION);
+    return NULL;
+}
+
+void mpl_server_destroy(mpl_server_t *server_p)
+{
+}
+
+int mpl_server_listen_unix(mpl_server_t *server_p, const char *path_p)
+{
+    return -1;
+}
+
+int mpl_server_listen_tcp(mpl_server_t *server_p, int port)
+{
+    return -1;
+}
+
+int mpl_server_add_connection(mpl_server_t *server_p, int in_fd, int out_fd)
+{
+    return -1;
+}
+
+int mpl_server_run(mpl_server_t *server_p)
+{
+    return -1;
+}
+
+void mpl_server_stop(mpl_server_t *server_p)
+{
+}
+
+#endif /* defined(__linux__) && defined(MPL_USE_PTHREAD_MUTEX) */
@@ -0,0 +1,208 @@
+/*
+ *   Copyright 2013 ST-Ericsson SA
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ */
+
+
+/*************************************************************************
+ *
+ * File name: mpl_server.h
+ *
+ * Description: MPL request server runtime API declarations
+ *
+ **************************************************************************/
+#ifndef _MPL_SERVER_H
+#define _MPL_SERVER_H
+
+/**************************************************************************
+ * Includes
+ *************************************************************************/
+#include "mpl_param.h"
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file mpl_server.h
+ * @brief MPL request server runtime
+ */
+
+/** @defgroup MPL_SERVER MPL request server runtime
+ *  @ingroup MPL
+ * A server reads packed request messages (one per line) from its
+ * connections, calls a handler for each of them and writes the packed
+ * responses back.
+ *
+ * Connections are Unix domain sockets, TCP sockets on localhost and
+ * pairs of file descriptors (pipes, fifos, a terminal, or a regular
+ * file for input). All I/O is non-blocking and done by one event loop
+ * thread (the one calling mpl_server_run()), using epoll. Unpacking,
+ * the handler and packing run in a pool of worker threads.
+ *
+ * A client may send many requests without waiting for the responses
+ * (pipelining). The requests of a connection may be handled in
+ * parallel, but the responses are always written in request order.
+ * Reading from a connection pauses while it has max_in_flight requests
+ * that are not completely answered.
+ *
+ * The handler is called from several threads at the same time, so what
+ * it uses must be thread safe. The parameter sets must be initialized
+ * before the server is run.
+ *
+ * Only available on Linux with MPL_USE_PTHREAD_MUTEX. Writing to a
+ * pipe that the other end has closed raises SIGPIPE, so a server with
+ * pipe connections should ignore that signal.
+ */
+
+/**
+ * @ingroup MPL_SERVER
+ * Server options
+ */
+typedef struct
+{
+    int num_workers;    /**< Worker threads, 0 means one per online CPU */
+    int max_in_flight;  /**< Requests per connection that may be waiting
+                             for a response before reading pauses, 0
+                             means MPL_SERVER_DEFAULT_MAX_IN_FLIGHT */
+} mpl_server_options_t;
+
+/**
+ * @ingroup MPL_SERVER
+ * Default value for max_in_flight
+ */
+#define MPL_SERVER_DEFAULT_MAX_IN_FLIGHT 256
+
+typedef struct mpl_server_s mpl_server_t;
+
+/**
+ * @ingroup MPL_SERVER
+ * mpl_server_handler_fp
+ *
+ * Called from a worker thread for each request message. req_p is the
+ * unpacked message, as mpl_param_list_unpack_error() returns it, and
+ * is destroyed by the server after the call. has_error is set if the
+ * message did not unpack completely (req_p may then be NULL).
+ *
+ * @return The response message (handed over to the server), or NULL
+ *         for no response
+ */
+typedef mpl_list_t *(*mpl_server_handler_fp)(void *ctx_p,
+                                             mpl_list_t *req_p,
+                                             bool has_error);
+
+/**
+ * @ingroup MPL_SERVER
+ * mpl_server_create
+ *
+ * Create a server and start its worker threads.
+ *
+ * @param options_p  Options (NULL means all defaults)
+ * @param handler    Request handler
+ * @param ctx_p      Passed to the handler
+ *
+ * @return The server, or NULL on failure
+ */
+mpl_server_t *mpl_server_create(const mpl_server_options_t *options_p,
+                                mpl_server_handler_fp handler,
+                                void *ctx_p);
+
+/**
+ * @ingroup MPL_SERVER
+ * mpl_server_destroy
+ *
+ * Stop the worker threads, close all connections and listening sockets
+ * and free the server. Must not be called while mpl_server_run() is
+ * running.
+ *
+ * @param server_p  The server (may be NULL)
+ */
+void mpl_server_destroy(mpl_server_t *server_p);
+
+/**
+ * @ingroup MPL_SERVER
+ * mpl_server_listen_unix
+ *
+ * Accept connections on a Unix domain socket. A socket file left at
+ * the path is replaced, and the file is removed again by
+ * mpl_server_destroy().
+ *
+ * @param server_p  The server
+ * @param path_p    Socket path
+ *
+ * @return 0 on success, -1 on error
+ */
+int mpl_server_listen_unix(mpl_server_t *server_p, const char *path_p);
+
+/**
+ * @ingroup MPL_SERVER
+ * mpl_server_listen_tcp
+ *
+ * Accept TCP connections on the loopback interface.
+ *
+ * @param server_p  The server
+ * @param port      Port number, 0 picks a free port
+ *
+ * @return The port number, or -1 on error
+ */
+int mpl_server_listen_tcp(mpl_server_t *server_p, int port);
+
+/**
+ * @ingroup MPL_SERVER
+ * mpl_server_add_connection
+ *
+ * Serve requests read from one file descriptor, writing the responses
+ * to another (or the same, for a socket). The descriptors are made
+ * non-blocking while served, and are closed when the input ends and
+ * all responses are written, unless they are 0, 1 or 2.
+ *
+ * @param server_p  The server
+ * @param in_fd     Descriptor to read requests from
+ * @param out_fd    Descriptor to write responses to
+ *
+ * @return 0 on success, -1 on error
+ */
+int mpl_server_add_connection(mpl_server_t *server_p, int in_fd, int out_fd);
+
+/**
+ * @ingroup MPL_SERVER
+ * mpl_server_run
+ *
+ * Run the event loop. Returns when mpl_server_stop() is called, or
+ * when the server has no listening sockets and the last connection is
+ * closed.
+ *
+ * @param server_p  The server
+ *
+ * @return 0 on success, -1 on error
+ */
+int mpl_server_run(mpl_server_t *server_p);
+
+/**
+ * @ingroup MPL_SERVER
+ * mpl_server_stop
+ *
+ * Make mpl_server_run() return. May be called from any thread and from
+ * a signal handler. Requests that are being handled are not answered.
+ *
+ * @param server_p  The server
+ */
+void mpl_server_stop(mpl_server_t *server_p);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* _MPL_SERVER_H */
@@ -0,0 +1,995 @@
+/*
+ *   Copyright 2013 ST-Ericsson SA
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ */
+
+/*************************************************************************
+ *
+ * File name: mpl_store.c
+ *
+ * Description: MPL record store implementation
+ *
+ **************************************************************************/
+/*****************************************************************************
+ *
+ * Include files
+ *
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "mpl_stdint.h"
+#include "mpl_store.h"
+#include "mpl_list.h"
+#include "mpl_dbgtrace.h"
+
+/*****************************************************************************
+ *
+ * Defines & Type definitions
+ *
+ *****************************************************************************/
+
+#define MPL_STORE_INITIAL_BUCKETS 64
+#define MPL_STORE_INITIAL_BUF_SIZE 256
+#define MPL_STORE_TMP_SUFFIX ".tmp"
+
+typedef struct mpl_store_entry_s
+{
+    struct mpl_store_entry_s *hash_next_p;
+    struct mpl_store_entry_s *prev_p;   /* Insertion order */
+    struct mpl_store_entry_s *next_p;
+    uint32_t hash;
+    mpl_param_element_t *record_p;
+    char *key_p;                        /* Stored after the entry */
+} mpl_store_entry_t;
+
+struct mpl_store_s
+{
+    char *path_p;
+    int fd;
+    mpl_store_options_t options;
+    mpl_store_entry_t **buckets_pp;
+    size_t num_buckets;
+    size_t count;
+    mpl_store_entry_t *first_p;
+    mpl_store_entry_t *last_p;
+    size_t dead;                        /* Journal lines not holding a
+                                           live record */
+    off_t size;                         /* Journal size */
+    int unsynced;                       /* Changes since last sync */
+    char *buf_p;                        /* Pack buffer */
+    size_t buf_size;
+    char *key_buf_p;                    /* Key buffer */
+    size_t key_buf_size;
+};
+
+/*****************************************************************************
+ *
+ * Private function prototypes
+ *
+ *****************************************************************************/
+
+static int store_load(mpl_store_t *store_p);
+static int store_pack(mpl_store_t *store_p,
+                      const mpl_param_element_t *record_p,
+                      bool deleted,
+                      char **line_pp,
+                      size_t *len_p);
+static int store_write(int fd, const char *data_p, size_t len);
+static int store_append(mpl_store_t *store_p,
+                        const mpl_param_element_t *record_p,
+                        bool deleted);
+static void store_maybe_compact(mpl_store_t *store_p);
+static const char *store_element_key(mpl_store_t *store_p,
+                                     const mpl_param_element_t *elem_p);
+static const char *store_record_key(mpl_store_t *store_p,
+                                    const mpl_param_element_t *record_p);
+static uint32_t store_hash(const char *key_p);
+static mpl_store_entry_t *store_lookup(const mpl_store_t *store_p,
+                                       const char *key_p,
+                                       uint32_t hash);
+static int store_insert(mpl_store_t *store_p,
+                        const char *key_p,
+                        mpl_param_element_t *record_p);
+static void store_remove(mpl_store_t *store_p, mpl_store_entry_t *entry_p);
+static void store_sync_dir(const char *path_p);
+
+/****************************************************************************
+ *
+ * Public Functions
+ *
+ ****************************************************************************/
+
+/**
+ * mpl_store_open
+ */
+mpl_store_t *mpl_store_open(const char *path_p,
+                            const mpl_store_options_t *options_p)
+{
+    mpl_store_t *store_p;
+
+    if ((NULL == path_p) || (NULL == options_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER, ("Missing parameter\n"));
+        mpl_set_errno(E_MPL_INVALID_PARAMETER);
+        return NULL;
+    }
+
+    if (mpl_param_id_get_type(options_p->record_id) != mpl_type_bag)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                            ("Record parameter is not a bag\n"));
+        mpl_set_errno(E_MPL_INVALID_PARAMETER);
+        return NULL;
+    }
+
+    store_p = calloc(1, sizeof(mpl_store_t));
+    if (NULL == store_p)
+        goto error_return;
+
+    store_p->fd = -1;
+    store_p->options = *options_p;
+    store_p->path_p = malloc(strlen(path_p) + 1);
+    store_p->num_buckets = MPL_STORE_INITIAL_BUCKETS;
+    store_p->buckets_pp = calloc(store_p->num_buckets,
+                                 sizeof(mpl_store_entry_t*));
+    store_p->buf_size = MPL_STORE_INITIAL_BUF_SIZE;
+    store_p->buf_p = malloc(store_p->buf_size);
+    store_p->key_buf_size = MPL_STORE_INITIAL_BUF_SIZE;
+    store_p->key_buf_p = malloc(store_p->key_buf_size);
+    if ((NULL == store_p->path_p) || (NULL == store_p->buckets_pp) ||
+        (NULL == store_p->buf_p) || (NULL == store_p->key_buf_p))
+        goto error_return;
+    strcpy(store_p->path_p, path_p);
+
+    store_p->fd = open(path_p, O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (store_p->fd < 0)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Could not open %s: %s\n",
+                             path_p, strerror(errno)));
+        mpl_set_errno(E_MPL_FAILED_OPERATION);
+        (void) mpl_store_close(store_p);
+        return NULL;
+    }
+
+    if (store_load(store_p) < 0)
+    {
+        (void) mpl_store_close(store_p);
+        return NULL;
+    }
+
+    return store_p;
+
+ error_return:
+    MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY, ("No memory\n"));
+    mpl_set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+    (void) mpl_store_close(store_p);
+    return NULL;
+}
+
+/**
+ * mpl_store_close
+ */
+int mpl_store_close(mpl_store_t *store_p)
+{
+    int res = 0;
+
+    if (NULL == store_p)
+        return 0;
+
+    if (store_p->fd >= 0)
+    {
+        res = mpl_store_sync(store_p);
+        (void) close(store_p->fd);
+    }
+
+    while (NULL != store_p->first_p)
+        store_remove(store_p, store_p->first_p);
+
+    free(store_p->buckets_pp);
+    free(store_p->buf_p);
+    free(store_p->key_buf_p);
+    free(store_p->path_p);
+    free(store_p);
+    return res;
+}
+
+/**
+ * mpl_store_put
+ */
+int mpl_store_put(mpl_store_t *store_p, const mpl_param_element_t *record_p)
+{
+    mpl_param_element_t *copy_p;
+    const char *key_p;
+    mpl_store_entry_t *entry_p;
+
+    if ((NULL == store_p) || (NULL == record_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER, ("Missing parameter\n"));
+        mpl_set_errno(E_MPL_INVALID_PARAMETER);
+        return -1;
+    }
+
+    key_p = store_record_key(store_p, record_p);
+    if (NULL == key_p)
+        return -1;
+
+    copy_p = mpl_param_element_clone(record_p);
+    if (NULL == copy_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                            ("Could not copy record\n"));
+        mpl_set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return -1;
+    }
+
+    /* The journal first, memory is only changed if that succeeds */
+    if (store_append(store_p, copy_p, false) < 0)
+    {
+        mpl_param_element_destroy(copy_p);
+        return -1;
+    }
+
+    /* The pack buffer is reused, but the key buffer is still valid */
+    entry_p = store_lookup(store_p, key_p, store_hash(key_p));
+    if (NULL != entry_p)
+    {
+        mpl_param_element_destroy(entry_p->record_p);
+        entry_p->record_p = copy_p;
+        store_p->dead++;
+    }
+    else if (store_insert(store_p, key_p, copy_p) < 0)
+    {
+        mpl_param_element_destroy(copy_p);
+        return -1;
+    }
+
+    store_maybe_compact(store_p);
+    return 0;
+}
+
+/**
+ * mpl_store_get
+ */
+const mpl_param_element_t *mpl_store_get(mpl_store_t *store_p,
+                                         const mpl_param_element_t *key_p)
+{
+    const char *key_str_p;
+    mpl_store_entry_t *entry_p;
+
+    if ((NULL == store_p) || (NULL == key_p))
+        return NULL;
+
+    key_str_p = store_element_key(store_p, key_p);
+    if (NULL == key_str_p)
+        return NULL;
+
+    entry_p = store_lookup(store_p, key_str_p, store_hash(key_str_p));
+    return (NULL != entry_p) ? entry_p->record_p : NULL;
+}
+
+/**
+ * mpl_store_delete
+ */
+int mpl_store_delete(mpl_store_t *store_p, const mpl_param_element_t *key_p)
+{
+    const char *key_str_p;
+    mpl_store_entry_t *entry_p;
+
+    if ((NULL == store_p) || (NULL == key_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER, ("Missing parameter\n"));
+        mpl_set_errno(E_MPL_INVALID_PARAMETER);
+        return -1;
+    }
+
+    key_str_p = store_element_key(store_p, key_p);
+    if (NULL == key_str_p)
+        return -1;
+
+    entry_p = store_lookup(store_p, key_str_p, store_hash(key_str_p));
+    if (NULL == entry_p)
+        return 0;
+
+    if (store_append(store_p, entry_p->record_p, true) < 0)
+        return -1;
+
+    store_remove(store_p, entry_p);
+    /* Both the record and the delete line are dead */
+    store_p->dead += 2;
+
+    store_maybe_compact(store_p);
+    return 1;
+}
+
+/**
+ * mpl_store_foreach
+ */
+int mpl_store_foreach(mpl_store_t *store_p,
+                      mpl_store_record_fp func,
+                      void *ctx_p)
+{
+    mpl_store_entry_t *entry_p;
+    int res;
+
+    if ((NULL == store_p) || (NULL == func))
+        return 0;
+
+    for (entry_p = store_p->first_p; NULL != entry_p; entry_p = entry_p->next_p)
+    {
+        res = func(ctx_p, entry_p->record_p);
+        if (0 != res)
+            return res;
+    }
+    return 0;
+}
+
+/**
+ * mpl_store_count
+ */
+size_t mpl_store_count(const mpl_store_t *store_p)
+{
+    return (NULL != store_p) ? store_p->count : 0;
+}
+
+/**
+ * mpl_store_sync
+ */
+int mpl_store_sync(mpl_store_t *store_p)
+{
+    if ((NULL == store_p) || (store_p->fd < 0))
+        return -1;
+
+    if (0 == store_p->unsynced)
+        return 0;
+
+    if (fsync(store_p->fd) < 0)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("fsync failed: %s\n", strerror(errno)));
+        mpl_set_errno(E_MPL_FAILED_OPERATION);
+        return -1;
+    }
+    store_p->unsynced = 0;
+    return 0;
+}
+
+/**
+ * mpl_store_compact
+ */
+int mpl_store_compact(mpl_store_t *store_p)
+{
+    char *tmp_path_p;
+    int tmp_fd;
+    int new_fd;
+    mpl_store_entry_t *entry_p;
+    char *line_p;
+    size_t len;
+    off_t size = 0;
+
+    if (NULL == store_p)
+        return -1;
+
+    tmp_path_p = malloc(strlen(store_p->path_p) +
+                        sizeof(MPL_STORE_TMP_SUFFIX));
+    if (NULL == tmp_path_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY, ("No memory\n"));
+        mpl_set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return -1;
+    }
+    sprintf(tmp_path_p, "%s%s", store_p->path_p, MPL_STORE_TMP_SUFFIX);
+
+    tmp_fd = open(tmp_path_p, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (tmp_fd < 0)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Could not open %s: %s\n",
+                             tmp_path_p, strerror(errno)));
+        mpl_set_errno(E_MPL_FAILED_OPERATION);
+        free(tmp_path_p);
+        return -1;
+    }
+
+    for (entry_p = store_p->first_p; NULL != entry_p; entry_p = entry_p->next_p)
+    {
+        if ((store_pack(store_p, entry_p->record_p, false, &line_p, &len) < 0) ||
+            (store_write(tmp_fd, line_p, len) < 0))
+            goto error_return;
+        size += len;
+    }
+
+    if (fsync(tmp_fd) < 0)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("fsync failed: %s\n", strerror(errno)));
+        mpl_set_errno(E_MPL_FAILED_OPERATION);
+        goto error_return;
+    }
+    (void) close(tmp_fd);
+    tmp_fd = -1;
+
+    if (rename(tmp_path_p, store_p->path_p) < 0)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("rename failed: %s\n", strerror(errno)));
+        mpl_set_errno(E_MPL_FAILED_OPERATION);
+        goto error_return;
+    }
+    store_sync_dir(store_p->path_p);
+    free(tmp_path_p);
+
+    new_fd = open(store_p->path_p, O_RDWR | O_APPEND);
+    if (new_fd < 0)
+    {
+        /* The new journal is in place, keep appending to the old one
+           would lose changes */
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("Could not reopen %s: %s\n",
+                             store_p->path_p, strerror(errno)));
+        mpl_set_errno(E_MPL_FAILED_OPERATION);
+        (void) close(store_p->fd);
+        store_p->fd = -1;
+        return -1;
+    }
+
+    (void) close(store_p->fd);
+    store_p->fd = new_fd;
+    store_p->size = size;
+    store_p->dead = 0;
+    store_p->unsynced = 0;
+    return 0;
+
+ error_return:
+    if (tmp_fd >= 0)
+        (void) close(tmp_fd);
+    (void) unlink(tmp_path_p);
+    free(tmp_path_p);
+    return -1;
+}
+
+/****************************************************************************
+ *
+ * Private Functions
+ *
+ ****************************************************************************/
+
+/**
+ * store_load
+ *
+ * Replay the journal. A last line without newline was only partly
+ * written and is cut off. Lines that can not be unpacked are skipped
+ * (and removed by the next compaction).
+ */
+static int store_load(mpl_store_t *store_p)
+{
+    struct stat st;
+    char *data_p;
+    char *line_p;
+    char *nl_p;
+    char *end_p;
+    ssize_t bytes_read;
+    size_t total = 0;
+    int line = 0;
+    int res = 0;
+
+    if (fstat(store_p->fd, &st) < 0)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                            ("fstat failed: %s\n", strerror(errno)));
+        mpl_set_errno(E_MPL_FAILED_OPERATION);
+        return -1;
+    }
+
+    if (0 == st.st_size)
+        return 0;
+
+    data_p = malloc((size_t)st.st_size + 1);
+    if (NULL == data_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY, ("No memory\n"));
+        mpl_set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return -1;
+    }
+
+    while (total < (size_t)st.st_size)
+    {
+        bytes_read = pread(store_p->fd,
+                           data_p + total,
+                           (size_t)st.st_size - total,
+                           (off_t)total);
+        if (bytes_read < 0 && (EINTR == errno))
+            continue;
+        if (bytes_read <= 0)
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("read failed: %s\n", strerror(errno)));
+            mpl_set_errno(E_MPL_FAILED_OPERATION);
+            free(data_p);
+            return -1;
+        }
+        total += (size_t)bytes_read;
+    }
+
+    end_p = data_p + total;
+    for (line_p = data_p; line_p < end_p; line_p = nl_p + 1)
+    {
+        mpl_list_t *list_p;
+        mpl_param_element_t *record_p;
+        mpl_store_entry_t *entry_p;
+        const char *key_p;
+        bool deleted = false;
+        bool has_error = false;
+
+        line++;
+        nl_p = memchr(line_p, '\n', end_p - line_p);
+        if (NULL == nl_p)
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("Removing incomplete line %d from %s\n",
+                                 line, store_p->path_p));
+            if (ftruncate(store_p->fd, (off_t)(line_p - data_p)) < 0)
+            {
+                MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                    ("ftruncate failed: %s\n",
+                                     strerror(errno)));
+                mpl_set_errno(E_MPL_FAILED_OPERATION);
+                res = -1;
+            }
+            end_p = line_p;
+            break;
+        }
+        *nl_p = '\0';
+
+        if (('\0' == *line_p) || ('#' == *line_p))
+            continue;
+
+        if ('-' == *line_p)
+        {
+            deleted = true;
+            line_p++;
+        }
+
+        list_p = mpl_param_list_unpack_param_set_error(line_p,
+                                                       store_p->options.param_set_id,
+                                                       &has_error);
+        key_p = NULL;
+        record_p = NULL;
+        if (!has_error && (mpl_list_len(list_p) == 1))
+        {
+            record_p = MPL_LIST_CONTAINER(mpl_list_remove(&list_p, NULL),
+                                          mpl_param_element_t,
+                                          list_entry);
+            key_p = store_record_key(store_p, record_p);
+        }
+        mpl_param_list_destroy(&list_p);
+
+        if (NULL == key_p)
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("Skipping bad record at line %d in %s\n",
+                                 line, store_p->path_p));
+            mpl_param_element_destroy(record_p);
+            store_p->dead++;
+            continue;
+        }
+
+        entry_p = store_lookup(store_p, key_p, store_hash(key_p));
+        if (deleted)
+        {
+            mpl_param_element_destroy(record_p);
+            store_p->dead++;
+            if (NULL != entry_p)
+            {
+                store_remove(store_p, entry_p);
+                store_p->dead++;
+            }
+        }
+        else if (NULL != entry_p)
+        {
+            mpl_param_element_destroy(entry_p->record_p);
+            entry_p->record_p = record_p;
+            store_p->dead++;
+        }
+        else if (store_insert(store_p, key_p, record_p) < 0)
+        {
+            mpl_param_element_destroy(record_p);
+            res = -1;
+            break;
+        }
+    }
+
+    store_p->size = (off_t)(end_p - data_p);
+    free(data_p);
+    return res;
+}
+
+/**
+ * store_pack
+ *
+ * Pack a record as a journal line in the pack buffer.
+ */
+static int store_pack(mpl_store_t *store_p,
+                      const mpl_param_element_t *record_p,
+                      bool deleted,
+                      char **line_pp,
+                      size_t *len_p)
+{
+    int len;
+    size_t needed;
+    char *new_buf_p;
+
+    /* Room for '-' in front and '\n' at the end */
+    do
+    {
+        len = mpl_param_pack(record_p,
+                             store_p->buf_p + 1,
+                             store_p->buf_size - 2);
+        if (len < 0)
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("Could not pack record\n"));
+            mpl_set_errno(E_MPL_FAILED_OPERATION);
+            return -1;
+        }
+
+        needed = (size_t)len + 3;
+        if (needed <= store_p->buf_size)
+            break;
+
+        if (needed < (2 * store_p->buf_size))
+            needed = 2 * store_p->buf_size;
+        new_buf_p = realloc(store_p->buf_p, needed);
+        if (NULL == new_buf_p)
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                                ("No memory\n"));
+            mpl_set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+            return -1;
+        }
+        store_p->buf_p = new_buf_p;
+        store_p->buf_size = needed;
+    }
+    while (1);
+
+    store_p->buf_p[0] = '-';
+    store_p->buf_p[len + 1] = '\n';
+    *line_pp = deleted ? store_p->buf_p : (store_p->buf_p + 1);
+    *len_p = (size_t)len + (deleted ? 2 : 1);
+    return 0;
+}
+
+/**
+ * store_write
+ */
+static int store_write(int fd, const char *data_p, size_t len)
+{
+    ssize_t written;
+
+    while (len > 0)
+    {
+        written = write(fd, data_p, len);
+        if (written < 0)
+        {
+            if (EINTR == errno)
+                continue;
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("write failed: %s\n", strerror(errno)));
+            mpl_set_errno(E_MPL_FAILED_OPERATION);
+            return -1;
+        }
+        data_p += written;
+        len -= (size_t)written;
+    }
+    return 0;
+}
+
+/**
+ * store_append
+ *
+ * Append a line to the journal. If the write fails, the journal is cut
+ * back so that it does not end with a partial line.
+ */
+static int store_append(mpl_store_t *store_p,
+                        const mpl_param_element_t *record_p,
+                        bool deleted)
+{
+    char *line_p;
+    size_t len;
+
+    if (store_p->fd < 0)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_OPERATION, ("Store is closed\n"));
+        mpl_set_errno(E_MPL_INVALID_OPERATION);
+        return -1;
+    }
+
+    if (store_pack(store_p, record_p, deleted, &line_p, &len) < 0)
+        return -1;
+
+    if (store_write(store_p->fd, line_p, len) < 0)
+    {
+        if (ftruncate(store_p->fd, store_p->size) < 0)
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION,
+                                ("ftruncate failed: %s\n", strerror(errno)));
+        return -1;
+    }
+    store_p->size += (off_t)len;
+
+    /* The line is written, a failed sync is retried with the next one */
+    store_p->unsynced++;
+    if ((store_p->options.sync_interval > 0) &&
+        (store_p->unsynced >= store_p->options.sync_interval))
+        (void) mpl_store_sync(store_p);
+
+    return 0;
+}
+
+/**
+ * store_maybe_compact
+ */
+static void store_maybe_compact(mpl_store_t *store_p)
+{
+    if ((store_p->options.compact_min > 0) &&
+        (store_p->dead >= (size_t)store_p->options.compact_min) &&
+        (store_p->dead > store_p->count))
+    {
+        /* On failure the old journal is still valid */
+        (void) mpl_store_compact(store_p);
+    }
+}
+
+/**
+ * store_element_key
+ *
+ * The key is the packed value of the key field, so that any type can
+ * be used. It is returned in the key buffer.
+ */
+static const char *store_element_key(mpl_store_t *store_p,
+                                     const mpl_param_element_t *elem_p)
+{
+    int len;
+    char *value_p;
+    char *new_buf_p;
+
+    len = mpl_param_pack(elem_p, store_p->key_buf_p, store_p->key_buf_size);
+    if ((len >= 0) && ((size_t)len >= store_p->key_buf_size))
+    {
+        new_buf_p = realloc(store_p->key_buf_p, (size_t)len + 1);
+        if (NULL == new_buf_p)
+        {
+            MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY,
+                                ("No memory\n"));
+            mpl_set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+            return NULL;
+        }
+        store_p->key_buf_p = new_buf_p;
+        store_p->key_buf_size = (size_t)len + 1;
+        len = mpl_param_pack(elem_p, store_p->key_buf_p, store_p->key_buf_size);
+    }
+
+    if (len < 0)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_OPERATION, ("Could not pack key\n"));
+        mpl_set_errno(E_MPL_FAILED_OPERATION);
+        return NULL;
+    }
+
+    /* Skip the parameter name, which differs between a field and a
+       free standing parameter */
+    value_p = strchr(store_p->key_buf_p, '=');
+    return (NULL != value_p) ? (value_p + 1) : "";
+}
+
+/**
+ * store_record_key
+ */
+static const char *store_record_key(mpl_store_t *store_p,
+                                    const mpl_param_element_t *record_p)
+{
+    mpl_param_element_t *field_p;
+
+    if ((record_p->id != store_p->options.record_id) ||
+        (NULL == record_p->value_p))
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                            ("Not a record of the store\n"));
+        mpl_set_errno(E_MPL_INVALID_PARAMETER);
+        return NULL;
+    }
+
+    field_p = mpl_param_list_find_field(store_p->options.key_context,
+                                        store_p->options.key_field,
+                                        record_p->value_p);
+    if (NULL == field_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_INVALID_PARAMETER,
+                            ("Record has no key field\n"));
+        mpl_set_errno(E_MPL_INVALID_PARAMETER);
+        return NULL;
+    }
+
+    return store_element_key(store_p, field_p);
+}
+
+/**
+ * store_hash (FNV-1a)
+ */
+static uint32_t store_hash(const char *key_p)
+{
+    uint32_t hash = 2166136261u;
+
+    while ('\0' != *key_p)
+    {
+        hash ^= (unsigned char) *key_p++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * store_lookup
+ */
+static mpl_store_entry_t *store_lookup(const mpl_store_t *store_p,
+                                       const char *key_p,
+                                       uint32_t hash)
+{
+    mpl_store_entry_t *entry_p;
+
+    entry_p = store_p->buckets_pp[hash & (store_p->num_buckets - 1)];
+    while (NULL != entry_p)
+    {
+        if ((entry_p->hash == hash) && !strcmp(entry_p->key_p, key_p))
+            return entry_p;
+        entry_p = entry_p->hash_next_p;
+    }
+    return NULL;
+}
+
+/**
+ * store_insert
+ *
+ * Add a new entry, growing the table when it is full.
+ */
+static int store_insert(mpl_store_t *store_p,
+                        const char *key_p,
+                        mpl_param_element_t *record_p)
+{
+    mpl_store_entry_t *entry_p;
+    size_t key_len = strlen(key_p);
+    size_t i;
+
+    if (store_p->count >= store_p->num_buckets)
+    {
+        size_t num_buckets = 2 * store_p->num_buckets;
+        mpl_store_entry_t **buckets_pp;
+
+        buckets_pp = calloc(num_buckets, sizeof(mpl_store_entry_t*));
+        if (NULL != buckets_pp)
+        {
+            for (i = 0; i < store_p->num_buckets; i++)
+            {
+                while (NULL != store_p->buckets_pp[i])
+                {
+                    entry_p = store_p->buckets_pp[i];
+                    store_p->buckets_pp[i] = entry_p->hash_next_p;
+                    entry_p->hash_next_p =
+                        buckets_pp[entry_p->hash & (num_buckets - 1)];
+                    buckets_pp[entry_p->hash & (num_buckets - 1)] = entry_p;
+                }
+            }
+            free(store_p->buckets_pp);
+            store_p->buckets_pp = buckets_pp;
+            store_p->num_buckets = num_buckets;
+        }
+        /* Else keep the old table, chains just get longer */
+    }
+
+    entry_p = malloc(sizeof(mpl_store_entry_t) + key_len + 1);
+    if (NULL == entry_p)
+    {
+        MPL_DBG_TRACE_ERROR(E_MPL_FAILED_ALLOCATING_MEMORY, ("No memory\n"));
+        mpl_set_errno(E_MPL_FAILED_ALLOCATING_MEMORY);
+        return -1;
+    }
+
+    entry_p->key_p = (char*)(entry_p + 1);
+    memcpy(entry_p->key_p, key_p, key_len + 1);
+    entry_p->hash = store_hash(key_p);
+    entry_p->record_p = record_p;
+
+    i = entry_p->hash & (store_p->num_buckets - 1);
+    entry_p->hash_next_p = store_p->buckets_pp[i];
+    store_p->buckets_pp[i] = entry_p;
+
+    entry_p->next_p = NULL;
+    entry_p->prev_p = store_p->last_p;
+    if (NULL != store_p->last_p)
+        store_p->last_p->next_p = entry_p;
+    else
+        store_p->first_p = entry_p;
+    store_p->last_p = entry_p;
+
+    store_p->count++;
+    return 0;
+}
+
+/**
+ * store_remove
+ *
+ * Unlink an entry and free it with its record.
+ */
+static void store_remove(mpl_store_t *store_p, mpl_store_entry_t *entry_p)
+{
+    mpl_store_entry_t **pp;
+
+    pp = &store_p->buckets_pp[entry_p->hash & (store_p->num_buckets - 1)];
+    while (*pp != entry_p)
+        pp = &(*pp)->hash_next_p;
+    *pp = entry_p->hash_next_p;
+
+    if (NULL != entry_p->prev_p)
+        entry_p->prev_p->next_p = entry_p->next_p;
+    else
+        store_p->first_p = entry_p->next_p;
+    if (NULL != entry_p->next_p)
+        entry_p->next_p->prev_p = entry_p->prev_p;
+    else
+        store_p->last_p = entry_p->prev_p;
+
+    store_p->count--;
+    mpl_param_element_destroy(entry_p->record_p);
+    free(entry_p);
+}
+
+/**
+ * store_sync_dir
+ *
+ * Sync the directory of a file, so that a rename survives a crash.
+ */
+static void store_sync_dir(const char *path_p)
+{
+    char *dir_p;
+    char *slash_p;
+    int fd;
+
+    dir_p = malloc(strlen(path_p) + 2);
+    if (NULL == dir_p)
+        return;
+
+    strcpy(dir_p, path_p);
+    slash_p = strrchr(dir_p, '/');
+    if (NULL == slash_p)
+        strcpy(dir_p, ".");
+    else if (slash_p == dir_p)
+        dir_p[1] = '\0';
+    else
+        *slash_p = '\0';
+
+    fd = open(dir_p, O_RDONLY);
+    if (fd >= 0)
+    {
+        (void) fsync(fd);
+        (void) close(fd);
+    }
+    free(dir_p);
+}
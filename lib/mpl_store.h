@@ -0,0 +1,236 @@
+/*
+ *   Copyright 2013 ST-Ericsson SA
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ */
+
+
+/*************************************************************************
+ *
+ * File name: mpl_store.h
+ *
+ * Description: MPL record store API declarations
+ *
+ **************************************************************************/
+#ifndef _MPL_STORE_H
+#define _MPL_STORE_H
+
+/**************************************************************************
+ * Includes
+ *************************************************************************/
+#include <stddef.h>
+#include "mpl_param.h"
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file mpl_store.h
+ * @brief MPL record store
+ */
+
+/** @defgroup MPL_STORE MPL record store API
+ *  @ingroup MPL
+ * A record store keeps bag parameters (records) in a file, identified by
+ * the value of one of their fields (the key).
+ *
+ * The file is a journal: each change appends one line, and nothing is
+ * rewritten until the store is compacted. A line is a packed record
+ * (the same format as mpl_file_write_params()), or '-' followed by a
+ * packed record for a delete. A file written by mpl_file_write_params()
+ * can therefore be opened as a store.
+ *
+ * All live records are kept in memory, with a hash index on the key, so
+ * lookups do not touch the file.
+ *
+ * The journal is synced to disk every sync_interval changes, and by
+ * mpl_store_sync() and mpl_store_close(). After a crash, the changes
+ * since the last sync may be lost, and a line that was only partly
+ * written is removed when the store is opened.
+ *
+ * A store is not thread safe. Records are allocated with the normal
+ * parameter allocators, so no arena (see mpl_param_arena_set()) must be
+ * set by the calling thread while using the store.
+ */
+
+/**
+ * @ingroup MPL_STORE
+ * Store options
+ */
+typedef struct
+{
+    int param_set_id;                   /**< Default parameter set when
+                                             reading the file, -1 if none */
+    mpl_param_element_id_t record_id;   /**< Bag parameter of the records */
+    mpl_param_element_id_t key_context; /**< Bag where the key field is
+                                             defined */
+    int key_field;                      /**< Field index (id_in_context)
+                                             of the key field */
+    int sync_interval;                  /**< Sync after this many changes,
+                                             0 means only when asked */
+    int compact_min;                    /**< Compact when there are at
+                                             least this many dead lines
+                                             and more dead than live, 0
+                                             means only when asked */
+} mpl_store_options_t;
+
+/**
+ * @ingroup MPL_STORE
+ * Default values for sync_interval and compact_min
+ */
+#define MPL_STORE_DEFAULT_SYNC_INTERVAL 16
+#define MPL_STORE_DEFAULT_COMPACT_MIN 1024
+
+typedef struct mpl_store_s mpl_store_t;
+
+/**
+ * @ingroup MPL_STORE
+ * mpl_store_record_fp
+ *
+ * Called by mpl_store_foreach() for each record.
+ *
+ * @return 0 to continue, other values stop the iteration
+ */
+typedef int (*mpl_store_record_fp)(void *ctx_p,
+                                   const mpl_param_element_t *record_p);
+
+/**
+ * @ingroup MPL_STORE
+ * mpl_store_open
+ *
+ * Open a store, creating the file if it does not exist. The journal is
+ * read and the live records are kept in memory.
+ *
+ * @param path_p     File name
+ * @param options_p  Options
+ *
+ * @return The store, or NULL on failure
+ */
+mpl_store_t *mpl_store_open(const char *path_p,
+                            const mpl_store_options_t *options_p);
+
+/**
+ * @ingroup MPL_STORE
+ * mpl_store_close
+ *
+ * Sync and close the store, and free all records.
+ *
+ * @param store_p  The store (may be NULL)
+ *
+ * @return 0 on success, -1 if the final sync failed
+ */
+int mpl_store_close(mpl_store_t *store_p);
+
+/**
+ * @ingroup MPL_STORE
+ * mpl_store_put
+ *
+ * Add a record, or replace the record with the same key.
+ *
+ * @param store_p   The store
+ * @param record_p  The record (a bag parameter with the key field),
+ *                  it is copied
+ *
+ * @return 0 on success, -1 on error
+ */
+int mpl_store_put(mpl_store_t *store_p, const mpl_param_element_t *record_p);
+
+/**
+ * @ingroup MPL_STORE
+ * mpl_store_get
+ *
+ * Find a record by key.
+ *
+ * @param store_p  The store
+ * @param key_p    Parameter with the key value, e.g. created with
+ *                 mpl_param_element_create() for the key field type
+ *
+ * @return The record (owned by the store, valid until it is replaced
+ *         or deleted), or NULL if not found
+ */
+const mpl_param_element_t *mpl_store_get(mpl_store_t *store_p,
+                                         const mpl_param_element_t *key_p);
+
+/**
+ * @ingroup MPL_STORE
+ * mpl_store_delete
+ *
+ * Delete a record by key.
+ *
+ * @param store_p  The store
+ * @param key_p    Parameter with the key value
+ *
+ * @return 1 if deleted, 0 if not found, -1 on error
+ */
+int mpl_store_delete(mpl_store_t *store_p, const mpl_param_element_t *key_p);
+
+/**
+ * @ingroup MPL_STORE
+ * mpl_store_foreach
+ *
+ * Call a function for each record, in the order they were first added.
+ * The store must not be changed from the function.
+ *
+ * @param store_p  The store
+ * @param func     Function to call
+ * @param ctx_p    Passed to the function
+ *
+ * @return 0, or the value from the function that stopped the iteration
+ */
+int mpl_store_foreach(mpl_store_t *store_p,
+                      mpl_store_record_fp func,
+                      void *ctx_p);
+
+/**
+ * @ingroup MPL_STORE
+ * mpl_store_count
+ *
+ * @param store_p  The store
+ *
+ * @return Number of records
+ */
+size_t mpl_store_count(const mpl_store_t *store_p);
+
+/**
+ * @ingroup MPL_STORE
+ * mpl_store_sync
+ *
+ * Flush the journal to disk.
+ *
+ * @param store_p  The store
+ *
+ * @return 0 on success, -1 on error
+ */
+int mpl_store_sync(mpl_store_t *store_p);
+
+/**
+ * @ingroup MPL_STORE
+ * mpl_store_compact
+ *
+ * Rewrite the journal with only the live records. The new file is
+ * written and synced next to the old one and then renamed over it, so
+ * a crash leaves either the old or the new journal.
+ *
+ * @param store_p  The store
+ *
+ * @return 0 on success, -1 on error (the old journal is kept)
+ */
+int mpl_store_compact(mpl_store_t *store_p);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* _MPL_STORE_H */
@@ -0,0 +1,695 @@
+/*
+ *   Copyright 2013 ST-Ericsson SA
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ */
+
+/*************************************************************************
+ *
+ * File name: mpl_bench.c
+ *
+ * Description: MPL micro benchmarks
+ *
+ * Usage: mpl_bench [benchmark]
+ *
+ **************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef MPL_TEST_SPECIALIZED
+#include "mpl_test_msg_s.h"
+#else
+#include "mpl_test_msg.h"
+#endif
+#include "mpl_param.h"
+#include "mpl_list.h"
+#include "mpl_hex.h"
+
+typedef int (*bench_fp)(void);
+
+static double now_us(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (ts.tv_sec * 1000000.0) + (ts.tv_nsec / 1000.0);
+}
+
+/* Repeat so that each measurement covers roughly the same work */
+static int bench_repeat(int num_params)
+{
+  int repeat = 1000000 / num_params;
+
+  return (repeat > 0) ? repeat : 1;
+}
+
+static char *make_message(int num_params)
+{
+  char *buf_p;
+  size_t len = 0;
+  int i;
+
+  buf_p = malloc((size_t)num_params * 20 + 1);
+  if (NULL == buf_p)
+    return NULL;
+
+  buf_p[0] = '\0';
+  for (i = 0; i < num_params; i++)
+    len += sprintf(buf_p + len, "%stest.myint=%d", (i > 0) ? "," : "", i % 1000);
+
+  return buf_p;
+}
+
+/*
+ * Tokenizer and unpack of messages with a growing number of top level
+ * parameters.
+ */
+static int bench_get_args(void)
+{
+  static const int counts[] = { 1, 10, 100, 1000, 10000, 100000 };
+  size_t i;
+
+  printf("%-10s %14s %14s %14s\n",
+         "params", "get_args ns/p", "unpack ns/p", "in place ns/p");
+
+  for (i = 0; i < sizeof(counts) / sizeof(counts[0]); i++)
+  {
+    int num_params = counts[i];
+    int repeat = bench_repeat(num_params);
+    char *msg_p = make_message(num_params);
+    size_t msglen;
+    char *buf_p;
+    mpl_arg_t *args_p;
+    mpl_list_t *list_p;
+    double start;
+    double get_args_us;
+    double unpack_us;
+    double in_place_us;
+    int r;
+
+    if (NULL == msg_p)
+      return -1;
+    msglen = strlen(msg_p) + 1;
+    buf_p = malloc(msglen);
+    if (NULL == buf_p)
+    {
+      free(msg_p);
+      return -1;
+    }
+
+    start = now_us();
+    for (r = 0; r < repeat; r++)
+    {
+      memcpy(buf_p, msg_p, msglen);
+      args_p = NULL;
+      if (mpl_get_args_2(&args_p, 0, buf_p, '=', ',', '\\') != num_params)
+      {
+        printf("mpl_get_args_2() failed for %d params\n", num_params);
+        free(args_p);
+        free(buf_p);
+        free(msg_p);
+        return -1;
+      }
+      free(args_p);
+    }
+    get_args_us = now_us() - start;
+
+    start = now_us();
+    for (r = 0; r < repeat; r++)
+    {
+      list_p = mpl_param_list_unpack(msg_p);
+      if (mpl_list_len(list_p) != (size_t)num_params)
+      {
+        printf("mpl_param_list_unpack() failed for %d params\n", num_params);
+        mpl_param_list_destroy(&list_p);
+        free(buf_p);
+        free(msg_p);
+        return -1;
+      }
+      mpl_param_list_destroy(&list_p);
+    }
+    unpack_us = now_us() - start;
+
+    start = now_us();
+    for (r = 0; r < repeat; r++)
+    {
+      memcpy(buf_p, msg_p, msglen);
+      list_p = mpl_param_list_unpack_in_place(buf_p, -1, NULL);
+      mpl_param_list_destroy(&list_p);
+    }
+    in_place_us = now_us() - start;
+
+    printf("%-10d %14.1f %14.1f %14.1f\n",
+           num_params,
+           get_args_us * 1000.0 / ((double)repeat * num_params),
+           unpack_us * 1000.0 / ((double)repeat * num_params),
+           in_place_us * 1000.0 / ((double)repeat * num_params));
+
+    free(buf_p);
+    free(msg_p);
+  }
+
+  return 0;
+}
+
+/* Hex text of byte arrays (uint8_array values), per byte */
+static int bench_hex(void)
+{
+  static const char *names[] = { "scalar", "sse2", "avx2" };
+  const size_t num = 65536;
+  const int repeat = 200;
+  mpl_hex_impl_t best = mpl_hex_get_impl();
+  mpl_hex_impl_t impl;
+  uint8_t *arr_p;
+  char *text_p;
+  double start;
+  double encode_us;
+  double decode_us;
+  unsigned int val;
+  size_t i;
+  int r;
+
+  arr_p = malloc(num);
+  text_p = malloc(2 * num + 1);
+  if ((NULL == arr_p) || (NULL == text_p))
+  {
+    free(arr_p);
+    free(text_p);
+    return -1;
+  }
+  for (i = 0; i < num; i++)
+    arr_p[i] = (uint8_t)(i * 167);
+
+  printf("%-10s %14s %14s\n", "impl", "encode ns/B", "decode ns/B");
+
+  /* What the array pack and unpack did before */
+  start = now_us();
+  for (i = 0; i < num; i++)
+    snprintf(text_p + 2 * i, 3, "%02x", arr_p[i]);
+  encode_us = now_us() - start;
+  start = now_us();
+  for (i = 0; i < num; i++)
+  {
+    sscanf(text_p + 2 * i, "%2x", &val);
+    arr_p[i] = (uint8_t)val;
+  }
+  decode_us = now_us() - start;
+  printf("%-10s %14.2f %14.2f\n", "printf",
+         encode_us * 1000.0 / num, decode_us * 1000.0 / num);
+
+  for (impl = mpl_hex_impl_scalar; impl <= mpl_hex_impl_avx2; impl++)
+  {
+    if (mpl_hex_set_impl(impl) < 0)
+      continue;
+    start = now_us();
+    for (r = 0; r < repeat; r++)
+      mpl_hex_encode_uint8(arr_p, num, text_p);
+    encode_us = now_us() - start;
+    start = now_us();
+    for (r = 0; r < repeat; r++)
+    {
+      if (mpl_hex_decode_uint8(text_p, num, arr_p) < 0)
+      {
+        printf("mpl_hex_decode_uint8() failed\n");
+        free(arr_p);
+        free(text_p);
+        return -1;
+      }
+    }
+    decode_us = now_us() - start;
+    printf("%-10s %14.2f %14.2f\n", names[impl],
+           encode_us * 1000.0 / ((double)repeat * num),
+           decode_us * 1000.0 / ((double)repeat * num));
+  }
+  (void)mpl_hex_set_impl(best);
+
+  free(arr_p);
+  free(text_p);
+  return 0;
+}
+
+/* Pack and unpack of single numeric parameters, per parameter */
+static int bench_numeric(void)
+{
+  static const struct
+  {
+    const char *name_p;
+    const char *value_p;
+  } params[] =
+    {
+      { "test.mysint32_2", "-1234567" },
+      { "test.mysint64_2", "-1234567890123" },
+      { "test.myuint32_2", "0xdeadbeef" },
+      { "test.myuint64_2", "0x123456789abcdef" },
+      { "test.my_ranged_int5", "405" },
+      { "test.my_enum6", "val_last" }
+    };
+  const int repeat = 200000;
+  mpl_param_element_t *param_p;
+  char buf[64];
+  double start;
+  double pack_us;
+  double unpack_us;
+  size_t i;
+  int r;
+
+  printf("%-16s %14s %14s\n", "param", "pack ns", "unpack ns");
+
+  for (i = 0; i < sizeof(params) / sizeof(params[0]); i++)
+  {
+    start = now_us();
+    for (r = 0; r < repeat; r++)
+    {
+      if (mpl_param_unpack(params[i].name_p, params[i].value_p, &param_p) < 0)
+      {
+        printf("mpl_param_unpack() failed for %s\n", params[i].name_p);
+        return -1;
+      }
+      mpl_param_element_destroy(param_p);
+    }
+    unpack_us = now_us() - start;
+
+    if (mpl_param_unpack(params[i].name_p, params[i].value_p, &param_p) < 0)
+      return -1;
+    start = now_us();
+    for (r = 0; r < repeat; r++)
+      (void)mpl_param_pack(param_p, buf, sizeof(buf));
+    pack_us = now_us() - start;
+    mpl_param_element_destroy(param_p);
+
+    printf("%-16s %14.1f %14.1f\n", params[i].name_p + strlen("test."),
+           pack_us * 1000.0 / repeat, unpack_us * 1000.0 / repeat);
+  }
+
+  return 0;
+}
+
+/*
+ * Sizing a packed message by packing it without a buffer, and by
+ * mpl_param_list_packed_size(), against packing it and packing it into
+ * an allocated buffer, per message.
+ */
+static int bench_packed_size(void)
+{
+  static const char message[] =
+    "test.mystring=hello\\, world,test.myint=-123,"
+    "test.myuint32_2=0xdeadbeef,test.my_enum6=val_last,test.mybool=true,"
+    "test.mystrint_tup=key:42,test.myuint8_arr=00000004deadbeef,"
+    "test.mynewbag={i1=1,i2=2,s[1]=first,s[2]=second,b=false}";
+  const int repeat = 100000;
+  mpl_list_t *list_p;
+  char *copy_p;
+  char *buf_p;
+  char buf[512];
+  double start;
+  double pack_null_us;
+  double packed_size_us;
+  double pack_us;
+  double pack_alloc_us;
+  int len = 0;
+  int r;
+
+  copy_p = strdup(message);
+  if (NULL == copy_p)
+    return -1;
+  list_p = mpl_param_list_unpack_param_set(copy_p, TEST_PARAM_SET_ID);
+  free(copy_p);
+  if (NULL == list_p)
+  {
+    printf("mpl_param_list_unpack_param_set() failed\n");
+    return -1;
+  }
+
+  start = now_us();
+  for (r = 0; r < repeat; r++)
+    len += mpl_param_list_pack(list_p, NULL, 0);
+  pack_null_us = now_us() - start;
+
+  start = now_us();
+  for (r = 0; r < repeat; r++)
+    len -= mpl_param_list_packed_size(list_p);
+  packed_size_us = now_us() - start;
+
+  start = now_us();
+  for (r = 0; r < repeat; r++)
+    (void)mpl_param_list_pack(list_p, buf, sizeof(buf));
+  pack_us = now_us() - start;
+
+  start = now_us();
+  for (r = 0; r < repeat; r++)
+  {
+    buf_p = mpl_param_list_pack_alloc(list_p, NULL, NULL);
+    if (NULL == buf_p)
+    {
+      mpl_param_list_destroy(&list_p);
+      return -1;
+    }
+    free(buf_p);
+  }
+  pack_alloc_us = now_us() - start;
+
+  mpl_param_list_destroy(&list_p);
+
+  if (len != 0)
+  {
+    printf("Packed size does not match\n");
+    return -1;
+  }
+
+  printf("%-20s %10s\n", "", "ns/message");
+  printf("%-20s %10.1f\n", "pack(NULL, 0)", pack_null_us * 1000.0 / repeat);
+  printf("%-20s %10.1f\n", "packed_size", packed_size_us * 1000.0 / repeat);
+  printf("%-20s %10.1f\n", "pack", pack_us * 1000.0 / repeat);
+  printf("%-20s %10.1f\n", "pack_alloc", pack_alloc_us * 1000.0 / repeat);
+
+  return 0;
+}
+
+/* A bag nested depth levels deep, with an int at each level */
+static char *make_nested_message(int depth)
+{
+  char *buf_p;
+  size_t len = 0;
+  int i;
+
+  buf_p = malloc((size_t)depth * 40 + 32);
+  if (NULL == buf_p)
+    return NULL;
+
+  for (i = 0; i < depth; i++)
+    len += sprintf(buf_p + len, "test.mylist1={test.myint=%d,", i % 1000);
+  len += sprintf(buf_p + len, "test.myint=0");
+  for (i = 0; i < depth; i++)
+    buf_p[len++] = '}';
+  buf_p[len] = '\0';
+
+  return buf_p;
+}
+
+/*
+ * Text pack and unpack of bags nested to a growing depth, per message.
+ * The time should grow linearly with the depth.
+ */
+static int bench_bag_depth(void)
+{
+  static const int depths[] = { 1, 2, 4, 8, 12, 16, 20, 50, 100 };
+  const int repeat = 20000;
+  mpl_list_t *list_p;
+  char *msg_p;
+  char *buf_p;
+  size_t len;
+  double start;
+  double pack_us;
+  double pack_alloc_us;
+  double unpack_us;
+  size_t i;
+  int r;
+
+  printf("%-8s %10s %14s %14s %14s\n",
+         "depth", "bytes", "pack ns", "pack_alloc ns", "unpack ns");
+
+  for (i = 0; i < sizeof(depths) / sizeof(depths[0]); i++)
+  {
+    msg_p = make_nested_message(depths[i]);
+    if (NULL == msg_p)
+      return -1;
+
+    start = now_us();
+    for (r = 0; r < repeat; r++)
+    {
+      list_p = mpl_param_list_unpack_param_set(msg_p, TEST_PARAM_SET_ID);
+      if (NULL == list_p)
+      {
+        printf("mpl_param_list_unpack_param_set() failed\n");
+        free(msg_p);
+        return -1;
+      }
+      mpl_param_list_destroy(&list_p);
+    }
+    unpack_us = now_us() - start;
+
+    list_p = mpl_param_list_unpack_param_set(msg_p, TEST_PARAM_SET_ID);
+    free(msg_p);
+    if (NULL == list_p)
+      return -1;
+
+    buf_p = mpl_param_list_pack_alloc(list_p, NULL, &len);
+    if (NULL == buf_p)
+    {
+      mpl_param_list_destroy(&list_p);
+      return -1;
+    }
+
+    start = now_us();
+    for (r = 0; r < repeat; r++)
+      (void)mpl_param_list_pack(list_p, buf_p, (int)len + 1);
+    pack_us = now_us() - start;
+    free(buf_p);
+
+    start = now_us();
+    for (r = 0; r < repeat; r++)
+    {
+      buf_p = mpl_param_list_pack_alloc(list_p, NULL, NULL);
+      if (NULL == buf_p)
+      {
+        mpl_param_list_destroy(&list_p);
+        return -1;
+      }
+      free(buf_p);
+    }
+    pack_alloc_us = now_us() - start;
+
+    mpl_param_list_destroy(&list_p);
+
+    printf("%-8d %10zu %14.1f %14.1f %14.1f\n", depths[i], len,
+           pack_us * 1000.0 / repeat, pack_alloc_us * 1000.0 / repeat,
+           unpack_us * 1000.0 / repeat);
+  }
+
+  return 0;
+}
+
+/*
+ * The methods of the type against the methods in the descriptor, which
+ * are the specialized ones when the parameter set is compiled with
+ * mplcomp -s (as the makefile builds mpl_bench), per value.
+ */
+static int bench_methods(void)
+{
+#define BENCH_PARAM(NAME, TYPE, VALUE) \
+  { test_paramid_##NAME, #NAME, VALUE, mpl_pack_param_value_##TYPE, \
+    mpl_unpack_param_value_##TYPE }
+  static const struct
+  {
+    mpl_param_element_id_t id;
+    const char *name_p;
+    const char *value_p;
+    mpl_pack_param_fp pack_func;
+    mpl_unpack_param_fp unpack_func;
+  } params[] =
+    {
+      BENCH_PARAM(myint, int, "-123"),
+      BENCH_PARAM(myuint32_2, uint32, "0xdeadbeef"),
+      BENCH_PARAM(my_ranged_int3, int, "105"),
+      BENCH_PARAM(my_ranged_int5, int, "405"),
+      BENCH_PARAM(my_enum6, enum, "val_last"),
+      BENCH_PARAM(my_enum12, enum, "val9"),
+      BENCH_PARAM(my_senum16, signed_enum16, "val1"),
+    };
+#undef BENCH_PARAM
+  const int repeat = 1000000;
+  const mpl_param_descr_set_t *set_p = test_param_descr_set_external_p;
+  const mpl_param_descr_t *descr_p;
+  const mpl_param_descr2_t *descr2_p;
+  mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
+  void *value_p;
+  char buf[64];
+  double start;
+  double us[4];
+  size_t i;
+  int r;
+  int m;
+
+  printf("%-16s %12s %12s %12s %12s\n", "param",
+         "unpack ns", "(specialized)", "pack ns", "(specialized)");
+
+  for (i = 0; i < sizeof(params) / sizeof(params[0]); i++)
+  {
+    descr_p = &set_p->array[(params[i].id & MPL_PARAMID_TYPE_MASK) - 1];
+    descr2_p = &set_p->array2[(params[i].id & MPL_PARAMID_TYPE_MASK) - 1];
+
+    for (m = 0; m < 2; m++)
+    {
+      mpl_unpack_param_fp unpack_func =
+        (m == 0) ? params[i].unpack_func : descr_p->unpack_func;
+      mpl_pack_param_fp pack_func =
+        (m == 0) ? params[i].pack_func : descr_p->pack_func;
+
+      start = now_us();
+      for (r = 0; r < repeat; r++)
+      {
+        if (unpack_func(params[i].value_p, &value_p, descr2_p, &options,
+                        MPL_PARAM_ID_UNDEFINED) < 0)
+        {
+          printf("Unpack failed for %s\n", params[i].name_p);
+          return -1;
+        }
+        descr_p->free_func(value_p);
+      }
+      us[m] = now_us() - start;
+
+      if (unpack_func(params[i].value_p, &value_p, descr2_p, &options,
+                      MPL_PARAM_ID_UNDEFINED) < 0)
+        return -1;
+      start = now_us();
+      for (r = 0; r < repeat; r++)
+        (void)pack_func(value_p, buf, sizeof(buf), descr2_p, &options);
+      us[2 + m] = now_us() - start;
+      descr_p->free_func(value_p);
+    }
+
+    printf("%-16s %12.1f %12.1f %12.1f %12.1f\n", params[i].name_p,
+           us[0] * 1000.0 / repeat, us[1] * 1000.0 / repeat,
+           us[2] * 1000.0 / repeat, us[3] * 1000.0 / repeat);
+  }
+
+  return 0;
+}
+
+static int bench_enum_tables(void)
+{
+#define BENCH_PARAM(NAME, TYPE, VALUE) \
+  { test_paramid_##NAME, #NAME, VALUE, mpl_pack_param_value_##TYPE, \
+    mpl_unpack_param_value_##TYPE }
+  static const struct
+  {
+    mpl_param_element_id_t id;
+    const char *name_p;
+    const char *value_p;
+    mpl_pack_param_fp pack_func;
+    mpl_unpack_param_fp unpack_func;
+  } params[] =
+    {
+      BENCH_PARAM(my_enum, enum, "val2"),
+      BENCH_PARAM(my_enum6, enum, "val_last"),
+      BENCH_PARAM(my_enum12, enum, "val9"),
+      BENCH_PARAM(my_status_code, enum16, "status_451"),
+    };
+#undef BENCH_PARAM
+  const int repeat = 1000000;
+  const mpl_param_descr_set_t *set_p = test_param_descr_set_external_p;
+  const mpl_param_descr_t *descr_p;
+  mpl_param_descr2_t descr2[2];
+  mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
+  void *value_p;
+  char buf[64];
+  double start;
+  double us[4];
+  size_t i;
+  int r;
+  int m;
+
+  printf("%-16s %12s %12s %12s %12s\n", "param",
+         "unpack ns", "(no tables)", "pack ns", "(no tables)");
+
+  for (i = 0; i < sizeof(params) / sizeof(params[0]); i++)
+  {
+    descr_p = &set_p->array[(params[i].id & MPL_PARAMID_TYPE_MASK) - 1];
+    descr2[0] = set_p->array2[(params[i].id & MPL_PARAMID_TYPE_MASK) - 1];
+    descr2[1] = descr2[0];
+    descr2[1].enum_table_p = NULL;
+
+    for (m = 0; m < 2; m++)
+    {
+      start = now_us();
+      for (r = 0; r < repeat; r++)
+      {
+        if (params[i].unpack_func(params[i].value_p, &value_p, &descr2[m],
+                                  &options, MPL_PARAM_ID_UNDEFINED) < 0)
+        {
+          printf("Unpack failed for %s\n", params[i].name_p);
+          return -1;
+        }
+        descr_p->free_func(value_p);
+      }
+      us[m] = now_us() - start;
+
+      if (params[i].unpack_func(params[i].value_p, &value_p, &descr2[m],
+                                &options, MPL_PARAM_ID_UNDEFINED) < 0)
+        return -1;
+      start = now_us();
+      for (r = 0; r < repeat; r++)
+        (void)params[i].pack_func(value_p, buf, sizeof(buf), &descr2[m],
+                                  &options);
+      us[2 + m] = now_us() - start;
+      descr_p->free_func(value_p);
+    }
+
+    printf("%-16s %12.1f %12.1f %12.1f %12.1f\n", params[i].name_p,
+           us[0] * 1000.0 / repeat, us[1] * 1000.0 / repeat,
+           us[2] * 1000.0 / repeat, us[3] * 1000.0 / repeat);
+  }
+
+  return 0;
+}
+
+static const struct
+{
+  const char *name;
+  bench_fp func;
+} benchmarks[] =
+{
+  { "get_args", bench_get_args },
+  { "hex", bench_hex },
+  { "numeric", bench_numeric },
+  { "packed_size", bench_packed_size },
+  { "bag_depth", bench_bag_depth },
+  { "methods", bench_methods },
+  { "enum_tables", bench_enum_tables },
+};
+
+int main(int argc, char **argv)
+{
+  size_t i;
+  int result = 0;
+  int found = 0;
+
+  if (0 != test_param_init())
+  {
+    printf("test_param_init() failed\n");
+    return -1;
+  }
+
+  for (i = 0; i < sizeof(benchmarks) / sizeof(benchmarks[0]); i++)
+  {
+    if ((argc > 1) && strcmp(argv[1], benchmarks[i].name))
+      continue;
+    found = 1;
+    printf("*** %s\n", benchmarks[i].name);
+    if (benchmarks[i].func() < 0)
+      result = -1;
+  }
+
+  if (!found)
+  {
+    printf("Unknown benchmark: %s\n", argv[1]);
+    result = -1;
+  }
+
+  mpl_param_system_deinit();
+  return result;
+}
@@ -22,22 +22,34 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
+#include <ctype.h>
 #include <inttypes.h>
 #include <unistd.h>
 #include <wchar.h>
 #include <pthread.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
 #ifndef MPL_OSE_TEST
 #define wait dejagnu_wait
 #include <dejagnu.h>
 #undef wait
 #endif
+#ifdef MPL_TEST_SPECIALIZED
+#include "mpl_test_msg_s.h"
+#else
 #include "mpl_test_msg.h"
+#endif
 #include "mpl_test_old_msg.h"
 #include "mpl_dbgtrace.h"
 #include "mpl_param.h"
 #include "mpl_list.h"
 #include "mpl_config.h"
 #include "mpl_file.h"
+#include "mpl_store.h"
+#include "mpl_client.h"
+#include "mpl_hex.h"
+#include "mpl_server.h"
 
 #ifndef MPL_OSE_TEST
 #define CONFIG_FILE tmpnam(NULL)
@@ -73,7 +85,7 @@ static int numberOfFail = 0;
 #endif
 
 const int mpl_test_min = 1;
-const int mpl_test_max = 88;
+const int mpl_test_max = 112;
 
 char *buf=NULL;
 int buflen=0;
@@ -308,6 +320,7 @@ static int tc_pack_unsupported_param_id(void)
     return -1;
   }
   param_elem_p = malloc(sizeof(mpl_param_element_t));
+  mpl_param_element_init(param_elem_p, test_enum_size_paramids);
   param_elem_p->id = test_enum_size_paramids;
   param_elem_p->value_p = NULL;
   param_elem_p->list_entry.next_p = NULL;
@@ -7318,6 +7331,12 @@ static int tc_list_write_read_file(void)
     printf("file write succeeded\n");
     return -1;
   }
+
+  if (mpl_file_write_params_no_prefix(fp, NULL) >= 0)
+  {
+    printf("file write of empty list succeeded\n");
+    return -1;
+  }
   
   if (mpl_file_write_params_no_prefix(fp, param_list_p) < 0)
   {
@@ -7390,9 +7409,10 @@ static int tc_list_write_read_file_negative(void)
     return -1;
   }
 
-  if (mpl_file_read_params(fp, &unpacked_param_list_p, TEST_PARAM_SET_ID) >= 0)
+  /* There is no limit on file size or line length */
+  if (mpl_file_read_params(fp, &unpacked_param_list_p, TEST_PARAM_SET_ID) < 0)
   {
-    printf("file read unexpectedly succeeded\n");
+    printf("file read unexpectedly failed\n");
     return -1;
   }
 
@@ -7461,9 +7481,10 @@ static int tc_list_write_read_file_negative(void)
     return -1;
   }
 
-  if (mpl_file_read_params(fp, &unpacked_param_list_p, TEST_PARAM_SET_ID) >= 0)
+  /* There is no limit on file size or line length */
+  if (mpl_file_read_params(fp, &unpacked_param_list_p, TEST_PARAM_SET_ID) < 0)
   {
-    printf("file read unexpectedly succeeded\n");
+    printf("file read unexpectedly failed\n");
     return -1;
   }
 
@@ -11022,246 +11043,3912 @@ static int tc_long_tagged_list(void)
 }
 
 
-void mpl_test(int test_start, int test_stop)
+static int tc_pack_unpack_bin(void)
 {
-  int testcase;
-  int result;
+    int myint = -400;
+    uint8_t myuint8 = 10;
+    uint16_t myuint16 = 20000;
+    uint32_t myuint32 = 2000;
+    uint64_t myuint64 = 4000;
+    sint8_t mysint8 = -10;
+    sint16_t mysint16 = -100;
+    sint32_t mysint32 = -2000;
+    int64_t mysint64 = 4711;
+    bool mybool = true;
+    uint8_t mybool8 = 1;
+    test_my_enum_t myenum = test_my_enum_val2;
+    uint8_t myenum8 = test_my_enum8_smallval2;
+    sint32_t mysenum32 = test_my_senum32_val2;
+    char *mystring = "hello binary";
+    wchar_t *mywstring = L"hello wide world";
+    uint8_t u8a[] = {11,12,13,14,15};
+    mpl_uint8_array_t u8_arr = {5, u8a};
+    uint16_t u16a[] = {1,2,3,4,65535};
+    mpl_uint16_array_t u16_arr = {5, u16a};
+    uint32_t u32a[] = {6,7,8,9,4000000000u};
+    mpl_uint32_array_t u32_arr = {5, u32a};
+    mpl_string_tuple_t strtup = {"my key", "my value"};
+    mpl_string_tuple_t strtup2 = {"my key", ""};
+    mpl_int_tuple_t ittup = {-50, 60};
+    mpl_strint_tuple_t sittup = {"my strint key", -70};
+    mpl_struint8_tuple_t s8ttup = {"my struint8 key", 80};
+    void *myaddr = &myint;
+    mpl_bag_t *bag_p = NULL;
+    mpl_list_t *param_list_p = NULL;
+    mpl_list_t *result_list_p = NULL;
+    mpl_param_element_t *param_elem_p;
+    uint8_t *buf_p = NULL;
+    char *text_p = NULL;
+    int len;
+    int textlen;
+    bool err;
+    int ret = -1;
+
+    (void) mpl_add_param_to_list(&param_list_p, test_paramid_myint, &myint);
+    (void) mpl_add_param_to_list(&param_list_p, test_paramid_myuint8, &myuint8);
+    (void) mpl_add_param_to_list(&param_list_p, test_paramid_myuint16, &myuint16);
+    (void) mpl_add_param_to_list(&param_list_p, test_paramid_myuint32, &myuint32);
+    (void) mpl_add_param_to_list(&param_list_p, test_paramid_myuint64, &myuint64);
+    (void) mpl_add_param_to_list(&param_list_p, test_paramid_mysint8, &mysint8);
+    (void) mpl_add_param_to_list(&param_list_p, test_paramid_mysint16, &mysint16);
+    (void) mpl_add_param_to_list(&param_list_p, test_paramid_mysint32, &mysint32);
+    (void) mpl_add_param_to_list(&param_list_p, test_paramid_mysint64, &mysint64);
+    (void) mpl_add_param_to_list(&param_list_p, test_paramid_mybool, &mybool);
+    (void) mpl_add_param_to_list(&param_list_p, test_paramid_mybool8, &mybool8);
+    (void) mpl_add_param_to_list(&param_list_p, test_paramid_my_enum, &myenum);
+    (void) mpl_add_param_to_list(&param_list_p, test_paramid_my_enum8, &myenum8);
+    (void) mpl_add_param_to_list(&param_list_p, test_paramid_my_senum32, &mysenum32);
+    (void) mpl_add_param_to_list_tag(&param_list_p, test_paramid_mystring, 1, mystring);
+    (void) mpl_add_param_to_list_tag(&param_list_p, test_paramid_mystring, 9999, mystring);
+    (void) mpl_add_param_to_list(&param_list_p, test_paramid_mywstring, mywstring);
+    (void) mpl_add_param_to_list(&param_list_p, test_paramid_myuint8_arr, &u8_arr);
+    (void) mpl_add_param_to_list(&param_list_p, test_paramid_myuint16_arr, &u16_arr);
+    (void) mpl_add_param_to_list(&param_list_p, test_paramid_myuint32_arr, &u32_arr);
+    (void) mpl_add_param_to_list(&param_list_p, test_paramid_mystring_tup, &strtup);
+    (void) mpl_add_param_to_list(&param_list_p, test_paramid_mystring_tup2, &strtup2);
+    (void) mpl_add_param_to_list(&param_list_p, test_paramid_myint_tup, &ittup);
+    (void) mpl_add_param_to_list(&param_list_p, test_paramid_mystrint_tup, &sittup);
+    (void) mpl_add_param_to_list(&param_list_p, test_paramid_mystruint8_tup, &s8ttup);
+    (void) mpl_add_param_to_list(&param_list_p, test_paramid_myaddr, &myaddr);
+    param_elem_p = mpl_param_element_create_empty(test_paramid_myint2);
+    mpl_list_add(&param_list_p, &param_elem_p->list_entry);
 
-  if (0 != test_param_init())
-  {
-    printf("test_param_init() failed\n");
-    return;
-  }
+    TST_ADD_mynewbag_i1(&bag_p,111);
+    TST_ADD_mynewbag_i2(&bag_p,222);
+    TST_ADD_mynewbag_b(&bag_p,mybool);
+    TST_ADD_mynewbag_s_TAG(&bag_p,"hello there",1);
+    TST_ADD_mynewbag_s_TAG(&bag_p,"bye bye",2);
+    (void) mpl_add_param_to_list(&param_list_p, test_paramid_mynewbag, bag_p);
 
-  if (0 != tull_param_init())
-  {
-    printf("tull_param_init() failed\n");
-    return;
-  }
+    len = mpl_param_list_pack_bin(param_list_p, NULL, 0);
+    printf("binary length: %d\n", len);
+    if (len <= MPL_BIN_HEADER_LEN)
+        goto exit;
 
-  for(testcase = test_start; testcase <= test_stop; testcase++)
-  {
-    switch(testcase)
+    buf_p = malloc(len);
+
+    /* Too small buffer gives needed length */
+    if (mpl_param_list_pack_bin(param_list_p, buf_p, len - 1) != len)
     {
-    case 1:
-      result=tc_pack_unpack_req_mycommand();
-      break;
-    case 2:
-      result=tc_pack_unpack_resp_mycommand();
-      break;
-    case 3:
-      result=tc_pack_unpack_event_myevent();
-      break;
-    case 4:
-      result=tc_pack_unpack_buffer_too_small();
-      break;
-    case 5:
-      result=tc_unpack_with_unknown_parameter();
-      break;
-    case 6:
-      result=tc_pack_unsupported_param_id();
-      break;
-    case 7:
-      result=tc_pack_unpack_param_int();
-      break;
-    case 8:
-      result=tc_pack_unpack_param_enum();
-      break;
-    case 9:
-      result=tc_pack_unpack_param_uint8();
-      break;
-    case 10:
-      result=tc_pack_unpack_param_uint32();
-      break;
-    case 11:
-      result=tc_pack_unpack_param_bool();
-      break;
-    case 12:
-      result=tc_pack_unpack_param_string();
-      break;
-    case 13:
-      result=tc_pack_param_illegal();
-      break;
-    case 14:
-      result=tc_unpack_param_illegal();
-      break;
-    case 15:
-      result=tc_list();
-      break;
-    case 16:
-      result=tc_param_get_default();
-      break;
-    case 17:
-      result=tc_param_allow_get();
-      break;
-    case 18:
-      result=tc_param_allow_set();
-      break;
-    case 19:
-      result=tc_param_allow_config();
-      break;
-    case 20:
-      result=tc_clone_param();
-      break;
-    case 21:
-      result=tc_param_id_get_str();
-      break;
-    case 22:
-      result=tc_param_value_get_str();
-      break;
-    case 23:
-      result=tc_get_args_escape_1();
-      break;
-    case 24:
-      result=tc_get_args_escape_2();
-      break;
-    case 25:
-      result=tc_get_args_escape_3();
-      break;
-    case 26:
-      result=tc_compare_param();
-      break;
-    case 27:
-      result=tc_config_read();
-      break;
-    case 28:
-      result=tc_element_create_negative();
-      break;
-    case 29:
-      result=tc_config_negative();
-      break;
-    case 30:
-      result=tc_init_mpl_param();
-      break;
-    case 31:
-      result=tc_pack_unpack_param_default_param_set();
-      break;
-    case 32:
-      result=tc_uint8_array();
-      break;
-    case 33:
-      result=tc_string_tuple();
-      break;
-    case 34:
-      result=tc_param_list_tuple_key_find();
-      break;
-    case 35:
-      result=tc_pack_unpack_param_uint16();
-      break;
-    case 36:
-      result=tc_pack_unpack_param_bool8();
-      break;
-    case 37:
-      result=tc_pack_unpack_param_list();
-      break;
-    case 38:
-      result=tc_list_append();
-      break;
-    case 39:
-      result=tc_param_list_find_all();
-      break;
-    case 40:
-      result=tc_uint16_array();
-      break;
-    case 41:
-      result=tc_pack_unpack_param_wstring();
-      break;
-    case 42:
-      result=tc_uint32_array();
-      break;
-    case 43:
-      result=tc_param_clone_list();
-      break;
-    case 44:
-      result=tc_pack_unpack_param_enum8();
-      break;
-    case 45:
-      result=tc_config_read_bl();
-      break;
-    case 46:
-      result=tc_pack_param_list_no_prefix();
-      break;
-    case 47:
-      result=tc_unpack_param_list_default_param_set();
-      break;
-    case 48:
-      result=tc_list_write_read_file();
-      break;
-    case 49:
-      result=tc_write_read_config();
-      break;
-    case 50:
-      result=tc_param_tag();
-      break;
-    case 51:
-      result=tc_int_tuple();
-      break;
-    case 52:
-      result=tc_strint_tuple();
-      break;
-    case 53:
-      result=tc_get_type();
-      break;
-    case 54:
-      result=tc_get_type_string();
-      break;
-    case 55:
-      result=tc_pack_unpack_param_signed_enum8();
-      break;
-    case 56:
-      result=tc_pack_unpack_param_signed_enum16();
-      break;
-    case 57:
-      result=tc_pack_unpack_param_signed_enum32();
-      break;
-    case 58:
-      result=tc_pack_unpack_param_enum16();
-      break;
-    case 59:
-      result=tc_pack_unpack_param_enum32();
-      break;
-    case 60:
-      result=tc_pack_unpack_param_sint8();
-      break;
-    case 61:
-      result=tc_pack_unpack_param_sint16();
-      break;
-    case 62:
-      result=tc_pack_unpack_param_sint32();
-      break;
-    case 63:
-      result=tc_pack_unpack_param_uint16();
-      break;
-    case 64:
-      result=tc_param_list_add();
-      break;
-    case 65:
-      result=tc_pack_unpack_param_uint64();
-      break;
-    case 66:
-      result=tc_list_write_read_file_negative();
-      break;
-    case 67:
-      result=tc_errno();
-      break;
-    case 68:
-        result= tc_threads();
-      break;
-    case 69:
-      result=tc_struint8_tuple();
-      break;
-    case 70:
-      result=tc_sizeof_zero();
-      break;
-    case 71:
-      result=tc_write_read_blacklist();
-      break;
-    case 72:
-      result=tc_misc_invalid();
-      break;
-    case 73:
-      result=tc_param_type_bag();
-      break;
+        printf("mpl_param_list_pack_bin() with short buffer failed\n");
+        goto exit;
+    }
+
+    if (mpl_param_list_pack_bin(param_list_p, buf_p, len) != len)
+    {
+        printf("mpl_param_list_pack_bin() failed\n");
+        goto exit;
+    }
+
+    result_list_p = mpl_param_list_unpack_bin_error(buf_p, len, &err);
+    if (err || (result_list_p == NULL))
+    {
+        printf("mpl_param_list_unpack_bin_error() failed\n");
+        goto exit;
+    }
+
+    if (mpl_compare_param_lists(param_list_p, result_list_p))
+    {
+        printf("parameter list mismatch\n");
+        goto exit;
+    }
+    mpl_param_list_destroy(&result_list_p);
+
+    textlen = mpl_param_list_pack(param_list_p, NULL, 0);
+    printf("text length: %d\n", textlen);
+    if (textlen <= len)
+    {
+        printf("binary format not smaller than text\n");
+        goto exit;
+    }
+    text_p = malloc(textlen + 1);
+    (void) mpl_param_list_pack(param_list_p, text_p, textlen + 1);
+    printf("text: %s\n", text_p);
+
+    /* Truncated buffers must fail */
+    for (textlen = 0; textlen < len; textlen++)
+    {
+        result_list_p = mpl_param_list_unpack_bin_error(buf_p, textlen, &err);
+        if (!err || (result_list_p != NULL))
+        {
+            printf("unpack of truncated buffer (%d) succeeded\n", textlen);
+            goto exit;
+        }
+    }
+
+    /* Bad magic and version must fail */
+    buf_p[0]++;
+    result_list_p = mpl_param_list_unpack_bin(buf_p, len);
+    buf_p[0]--;
+    if (result_list_p != NULL)
+    {
+        printf("unpack of bad magic succeeded\n");
+        goto exit;
+    }
+    buf_p[1] = MPL_BIN_FORMAT_VERSION + 1;
+    result_list_p = mpl_param_list_unpack_bin(buf_p, len);
+    if (result_list_p != NULL)
+    {
+        printf("unpack of bad version succeeded\n");
+        goto exit;
+    }
+
+    /* Value outside max */
+    mpl_param_list_destroy(&param_list_p);
+    param_elem_p = mpl_param_element_create_empty(test_paramid_myint);
+    param_elem_p->value_p = malloc(sizeof(int));
+    *(int*)param_elem_p->value_p = 2000;
+    mpl_list_add(&param_list_p, &param_elem_p->list_entry);
+    len = mpl_param_list_pack_bin(param_list_p, buf_p, len);
+    result_list_p = mpl_param_list_unpack_bin_error(buf_p, len, &err);
+    if (!err || (result_list_p != NULL))
+    {
+        printf("unpack of too large value succeeded\n");
+        goto exit;
+    }
+
+    /* Ten byte varint with bits beyond 64 must fail */
+    *(int*)param_elem_p->value_p = 5;
+    len = mpl_param_list_pack_bin(param_list_p, buf_p, len);
+    {
+        uint8_t overlong[64];
+        uint64_t count = 1;
+        int pos = MPL_BIN_HEADER_LEN;
+        int i;
+
+        memcpy(overlong, buf_p, MPL_BIN_HEADER_LEN);
+        /* Element count 1, spread over ten bytes */
+        for (i = 0; i < 9; i++, count >>= 7)
+            overlong[pos++] = (uint8_t)(0x80 | (count & 0x7f));
+        overlong[pos++] = 0x02;
+        i = MPL_BIN_HEADER_LEN;
+        while (buf_p[i++] & 0x80)
+            ;
+        memcpy(overlong + pos, buf_p + i, len - i);
+        pos += len - i;
+
+        result_list_p = mpl_param_list_unpack_bin_error(overlong, pos, &err);
+        if (!err || (result_list_p != NULL))
+        {
+            printf("unpack of overlong varint succeeded\n");
+            goto exit;
+        }
+
+        /* Same varint padded with an empty 10th byte is accepted */
+        overlong[MPL_BIN_HEADER_LEN + 9] = 0x00;
+        result_list_p = mpl_param_list_unpack_bin_error(overlong, pos, &err);
+        if (err || (result_list_p == NULL) ||
+            mpl_compare_param_lists(param_list_p, result_list_p))
+        {
+            printf("unpack of padded varint failed\n");
+            goto exit;
+        }
+        mpl_param_list_destroy(&result_list_p);
+    }
+
+    ret = 0;
+
+exit:
+    mpl_param_list_destroy(&result_list_p);
+    mpl_param_list_destroy(&param_list_p);
+    mpl_param_list_destroy(&bag_p);
+    free(buf_p);
+    free(text_p);
+    return ret;
+}
+
+static int tc_name_lookup(void)
+{
+    int index;
+    mpl_param_element_id_t id;
+    const char *str;
+    char id_str[MPL_PARAMID_PREFIX_MAXLEN + 100];
+    mpl_param_element_t *param_elem_p;
+    mpl_bag_t *bag_p = NULL;
+    int64_t value;
+
+    /* All parameters, with and without prefix */
+    for (index = 0; index < mpl_param_num_parameters(TEST_PARAM_SET_ID); index++)
+    {
+        id = mpl_param_index_to_paramid(index, TEST_PARAM_SET_ID);
+        str = mpl_param_id_get_string(id);
+
+        /* Virtual parameters can not be instantiated */
+        param_elem_p = mpl_param_element_create_empty(id);
+        if (param_elem_p == NULL)
+            continue;
+        mpl_param_element_destroy(param_elem_p);
+
+        sprintf(id_str, "test.%s", str);
+        if ((mpl_param_unpack(id_str, NULL, &param_elem_p) < 0) ||
+            (param_elem_p->id != id))
+        {
+            printf("Failed 1: %s\n", id_str);
+            return -1;
+        }
+        mpl_param_element_destroy(param_elem_p);
+
+        if ((mpl_param_unpack_param_set(str, NULL, &param_elem_p, TEST_PARAM_SET_ID) < 0) ||
+            (param_elem_p->id != id))
+        {
+            printf("Failed 2: %s\n", str);
+            return -1;
+        }
+        mpl_param_element_destroy(param_elem_p);
+    }
+
+    /* Parameter in another set */
+    if ((mpl_param_unpack("tull.myint", NULL, &param_elem_p) < 0) ||
+        (param_elem_p->id != tull_paramid_myint))
+    {
+        printf("Failed 3\n");
+        return -1;
+    }
+    mpl_param_element_destroy(param_elem_p);
+
+    /* Unknown names */
+    if (mpl_param_unpack("test.myin", NULL, &param_elem_p) >= 0)
+        return -1;
+    if (mpl_param_unpack("test.myintt", NULL, &param_elem_p) >= 0)
+        return -1;
+    if (mpl_param_unpack("test.", NULL, &param_elem_p) >= 0)
+        return -1;
+    if (mpl_param_unpack("tes.myint", NULL, &param_elem_p) >= 0)
+        return -1;
+    if (mpl_param_unpack("testt.myint", NULL, &param_elem_p) >= 0)
+        return -1;
+
+    /* Enum names, large enum */
+    if ((mpl_param_unpack("test.my_enum6", "val_last", &param_elem_p) < 0) ||
+        (*(test_my_enum6_t*)param_elem_p->value_p != test_my_enum6_val_last))
+    {
+        printf("Failed 4\n");
+        return -1;
+    }
+    mpl_param_element_destroy(param_elem_p);
+    if ((mpl_param_unpack("test.my_enum6", "val12", &param_elem_p) < 0) ||
+        (*(test_my_enum6_t*)param_elem_p->value_p != test_my_enum6_val12))
+    {
+        printf("Failed 5\n");
+        return -1;
+    }
+    mpl_param_element_destroy(param_elem_p);
+    if (mpl_param_unpack("test.my_enum6", "val1x", &param_elem_p) >= 0)
+        return -1;
+    if (mpl_param_unpack("test.my_enum6", "val", &param_elem_p) >= 0)
+        return -1;
+    /* Numeric value is still accepted */
+    value = test_my_enum6_val13;
+    sprintf(id_str, "%" PRIi64, value);
+    if ((mpl_param_unpack("test.my_enum6", id_str, &param_elem_p) < 0) ||
+        (*(test_my_enum6_t*)param_elem_p->value_p != test_my_enum6_val13))
+    {
+        printf("Failed 6\n");
+        return -1;
+    }
+    mpl_param_element_destroy(param_elem_p);
+
+    /* Bag field names, large bag */
+    TST_ADD_mybigbag_f9(&bag_p, 9);
+    TST_ADD_mybigbag_f1(&bag_p, 1);
+    TST_ADD_mybigbag_f5(&bag_p, 5);
+    packparam.id = test_paramid_mybigbag;
+    packparam.value_p = bag_p;
+    if (pack_unpack_one(&packparam, true, -1) < 0)
+    {
+        mpl_param_list_destroy(&bag_p);
+        return -1;
+    }
+    memset(&packparam, 0, sizeof(packparam));
+    mpl_param_list_destroy(&bag_p);
+
+    if ((mpl_param_unpack("test.mybigbag", "{f8=8,f2=2}", &param_elem_p) < 0) ||
+        (mpl_list_len(param_elem_p->value_p) != 2) ||
+        (TST_GET_mybigbag_f8(param_elem_p->value_p) != 8))
+    {
+        printf("Failed 7\n");
+        return -1;
+    }
+    mpl_param_element_destroy(param_elem_p);
+
+    if (mpl_param_unpack("test.mybigbag", "{f10=10}", &param_elem_p) >= 0)
+        return -1;
+
+    return 0;
+}
+
+static void *thread_context_set_func(void *arg_p)
+{
+    mpl_set_errno(*((int*)arg_p));
+    return NULL;
+}
+
+static void *thread_context_get_func(void *arg_p)
+{
+    *((int*)arg_p) = mpl_get_errno();
+    return NULL;
+}
+
+static int tc_thread_context_exit(void)
+{
+    pthread_t t;
+    int error = E_MPL_FAILED_OPERATION;
+    int i;
+
+    /*
+     * A thread that exits takes its context with it; a new thread
+     * (which may well get the same thread id) starts with a clean one.
+     */
+    for (i = 0; i < 10; i++)
+    {
+        error = E_MPL_FAILED_OPERATION;
+        if (pthread_create(&t, NULL, thread_context_set_func, &error) != 0)
+            return -1;
+        pthread_join(t, NULL);
+
+        if (pthread_create(&t, NULL, thread_context_get_func, &error) != 0)
+            return -1;
+        pthread_join(t, NULL);
+
+        if (error != 0)
+        {
+            printf("New thread inherited errno %d\n", error);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+#define REGISTRY_NUM_SETS 20
+#define REGISTRY_NUM_READERS 4
+
+static void *registry_reader_func(void *arg_p)
+{
+    mpl_param_element_t *element_p;
+    int i;
+
+    *((int*)arg_p) = 0;
+    for (i = 0; i < 2000; i++)
+    {
+        if ((NULL == mpl_paramset_prefix(TEST_PARAM_SET_ID)) ||
+            (mpl_param_unpack("test.myint", "5", &element_p) < 0))
+        {
+            *((int*)arg_p) = -1;
+            return NULL;
+        }
+        if (*((int*)element_p->value_p) != 5)
+            *((int*)arg_p) = -1;
+        mpl_param_element_destroy(element_p);
+    }
+    return NULL;
+}
+
+static int tc_registry_concurrent_init(void)
+{
+    static mpl_param_descr_set_t sets[REGISTRY_NUM_SETS];
+    pthread_t readers[REGISTRY_NUM_READERS];
+    int results[REGISTRY_NUM_READERS];
+    mpl_param_element_t *element_p;
+    char id_str[32];
+    int result = 0;
+    int i;
+
+    /* Lookups in registered sets go on while new sets are registered */
+    for (i = 0; i < REGISTRY_NUM_READERS; i++)
+    {
+        if (pthread_create(&readers[i], NULL, registry_reader_func, &results[i]) != 0)
+            return -1;
+    }
+
+    for (i = 0; i < REGISTRY_NUM_SETS; i++)
+    {
+        sets[i] = *test_param_descr_set_external_p;
+        sets[i].param_set_id = 100 + i;
+        sprintf(sets[i].paramid_prefix, "reg%d", i);
+        if (mpl_param_init(&sets[i]) < 0)
+        {
+            printf("mpl_param_init() failed for set %d\n", i);
+            result = -1;
+        }
+    }
+
+    for (i = 0; i < REGISTRY_NUM_READERS; i++)
+    {
+        pthread_join(readers[i], NULL);
+        if (results[i] != 0)
+        {
+            printf("Reader %d failed\n", i);
+            result = -1;
+        }
+    }
+
+    for (i = 0; i < REGISTRY_NUM_SETS; i++)
+    {
+        if ((NULL == mpl_paramset_prefix(100 + i)) ||
+            strcmp(mpl_paramset_prefix(100 + i), sets[i].paramid_prefix))
+        {
+            printf("mpl_paramset_prefix(%d) failed\n", 100 + i);
+            return -1;
+        }
+
+        sprintf(id_str, "reg%d.myint", i);
+        if (mpl_param_unpack(id_str, "7", &element_p) < 0)
+        {
+            printf("mpl_param_unpack(%s) failed\n", id_str);
+            return -1;
+        }
+        if ((MPL_PARAMID_TO_PARAMSET(element_p->id) != (100 + i)) ||
+            (*((int*)element_p->value_p) != 7))
+        {
+            printf("mpl_param_unpack(%s) gave wrong element\n", id_str);
+            result = -1;
+        }
+        mpl_param_element_destroy(element_p);
+    }
+
+    return result;
+}
+
+static int tc_unpack_in_place(void)
+{
+    char buf[] = "test.mystring=hello world,test.myint=5,test.mystring[1]=ab\\,cde";
+    char *buf_end_p = buf + sizeof(buf);
+    mpl_list_t *list_p;
+    mpl_param_element_t *plain_p;
+    mpl_param_element_t *escaped_p;
+    mpl_param_element_t *int_p;
+    bool has_error = true;
+
+    list_p = mpl_param_list_unpack_in_place(buf, -1, &has_error);
+    if ((NULL == list_p) || has_error || (mpl_list_len(list_p) != 3))
+    {
+        printf("mpl_param_list_unpack_in_place() failed\n");
+        mpl_param_list_destroy(&list_p);
+        return -1;
+    }
+
+    plain_p = mpl_param_list_find_tag(test_paramid_mystring, 0, list_p);
+    escaped_p = mpl_param_list_find_tag(test_paramid_mystring, 1, list_p);
+    int_p = mpl_param_list_find(test_paramid_myint, list_p);
+    if ((NULL == plain_p) || (NULL == escaped_p) || (NULL == int_p))
+    {
+        printf("Parameters missing after unpack\n");
+        mpl_param_list_destroy(&list_p);
+        return -1;
+    }
+
+    /* Plain string borrows from the buffer, escaped one is a copy */
+    if (!plain_p->value_is_view ||
+        ((char*)plain_p->value_p < buf) ||
+        ((char*)plain_p->value_p >= buf_end_p) ||
+        strcmp(plain_p->value_p, "hello world"))
+    {
+        printf("Plain string is not a view into the buffer\n");
+        mpl_param_list_destroy(&list_p);
+        return -1;
+    }
+    if (escaped_p->value_is_view ||
+        strcmp(escaped_p->value_p, "ab,cde") ||
+        int_p->value_is_view ||
+        (*((int*)int_p->value_p) != 5))
+    {
+        printf("Unexpected values after unpack\n");
+        mpl_param_list_destroy(&list_p);
+        return -1;
+    }
+
+    if (mpl_param_list_own_values(list_p) < 0)
+    {
+        printf("mpl_param_list_own_values() failed\n");
+        mpl_param_list_destroy(&list_p);
+        return -1;
+    }
+
+    /* The list no longer depends on the buffer */
+    memset(buf, 'x', sizeof(buf) - 1);
+    if (plain_p->value_is_view ||
+        ((char*)plain_p->value_p >= buf && (char*)plain_p->value_p < buf_end_p) ||
+        strcmp(plain_p->value_p, "hello world"))
+    {
+        printf("Plain string still a view after own values\n");
+        mpl_param_list_destroy(&list_p);
+        return -1;
+    }
+    mpl_param_list_destroy(&list_p);
+
+    /* Destroy with views left in the list */
+    strcpy(buf, "test.mystring=abcdef");
+    list_p = mpl_param_list_unpack_in_place(buf, -1, NULL);
+    if ((NULL == list_p) ||
+        !MPL_LIST_CONTAINER(list_p, mpl_param_element_t, list_entry)->value_is_view)
+    {
+        printf("mpl_param_list_unpack_in_place() failed (2)\n");
+        mpl_param_list_destroy(&list_p);
+        return -1;
+    }
+    mpl_param_list_destroy(&list_p);
+
+    /* Errors are reported */
+    strcpy(buf, "test.mystring=abc");
+    list_p = mpl_param_list_unpack_in_place(buf, -1, &has_error);
+    if ((NULL != list_p) || !has_error)
+    {
+        printf("mpl_param_list_unpack_in_place() succeeded unexpectedly\n");
+        mpl_param_list_destroy(&list_p);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int tc_get_args_many(void)
+{
+    mpl_arg_t args[2]={{NULL},{NULL}};
+    mpl_arg_t *args_p = NULL;
+    int num_params = 5000;
+    size_t buflen = num_params * 20;
+    char *buf_p;
+    size_t len = 0;
+    mpl_list_t *list_p;
+    mpl_list_t *elem_p;
+    int numargs;
+    int sum = 0;
+    int i;
+
+    /* An array given by the caller is not grown (and not freed) */
+    buf_p = malloc(buflen);
+    if (NULL == buf_p)
+        return -1;
+    strcpy(buf_p, "a=1,b=2,c=3");
+    if (mpl_get_args(args, 2, buf_p, '=', ',', '\\') != -1)
+    {
+        printf("mpl_get_args() succeeded unexpectedly\n");
+        free(buf_p);
+        return -1;
+    }
+
+    for (i = 0; i < num_params; i++)
+        len += sprintf(buf_p + len, "%stest.myint=%d", (i > 0) ? "," : " ", i % 100);
+
+    numargs = mpl_get_args_2(&args_p, 0, buf_p, '=', ',', '\\');
+    if ((numargs != num_params) ||
+        strcmp(args_p[0].key_p, "test.myint") ||
+        strcmp(args_p[num_params - 1].value_p, "99"))
+    {
+        printf("mpl_get_args_2() returned %d args\n", numargs);
+        free(args_p);
+        free(buf_p);
+        return -1;
+    }
+    free(args_p);
+
+    len = 0;
+    for (i = 0; i < num_params; i++)
+        len += sprintf(buf_p + len, "%stest.myint=%d", (i > 0) ? "," : "", i % 100);
+
+    list_p = mpl_param_list_unpack(buf_p);
+    free(buf_p);
+    if (mpl_list_len(list_p) != (size_t)num_params)
+    {
+        printf("Unpacked %zu params\n", mpl_list_len(list_p));
+        mpl_param_list_destroy(&list_p);
+        return -1;
+    }
+
+    MPL_LIST_FOR_EACH(list_p, elem_p)
+    {
+        sum += *((int*)MPL_LIST_CONTAINER(elem_p,
+                                          mpl_param_element_t,
+                                          list_entry)->value_p);
+    }
+    mpl_param_list_destroy(&list_p);
+
+    if (sum != (num_params / 100) * 4950)
+    {
+        printf("Wrong sum of unpacked values: %d\n", sum);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int arena_list_check(mpl_list_t *list_p, bool in_arena)
+{
+    mpl_list_t *elem_p;
+    mpl_param_element_t *elem2_p;
+
+    MPL_LIST_FOR_EACH(list_p, elem_p)
+    {
+        elem2_p = MPL_LIST_CONTAINER(elem_p, mpl_param_element_t, list_entry);
+        if (elem2_p->in_arena != in_arena)
+            return -1;
+        if ((elem2_p->id == test_paramid_mylist1) &&
+            (arena_list_check(elem2_p->value_p, in_arena) < 0))
+            return -1;
+    }
+    return 0;
+}
+
+static int tc_arena(void)
+{
+    const char *msg =
+        "test.mystring=hallo world,"
+        "test.mylist1={test.myuint8=0x13,test.myuint8=0x12,test.myuint32=1234},"
+        "test.myint=55,"
+        "test.mystring_tup=eth0:10.2.3.4,"
+        "test.myuint8_arr=000000030102ff,"
+        "test.myint_tup=1:2";
+    char buf[512];
+    char packed[512];
+    char arena_packed[512];
+    mpl_arena_t *arena_p;
+    mpl_list_t *list_p;
+    mpl_list_t *arena_list_p;
+    mpl_list_t *clone_p;
+    mpl_param_element_t *elem_p;
+    size_t size = 0;
+    int i;
+
+    strcpy(buf, msg);
+    list_p = mpl_param_list_unpack(buf);
+    if ((NULL == list_p) || (arena_list_check(list_p, false) < 0))
+    {
+        printf("Heap unpack failed\n");
+        mpl_param_list_destroy(&list_p);
+        return -1;
+    }
+    if (mpl_param_list_pack(list_p, packed, sizeof(packed)) <= 0)
+    {
+        mpl_param_list_destroy(&list_p);
+        return -1;
+    }
+    mpl_param_list_destroy(&list_p);
+
+    arena_p = mpl_arena_create(256);
+    if (NULL == arena_p)
+        return -1;
+
+    for (i = 0; i < 20; i++)
+    {
+        if (NULL != mpl_param_arena_set(arena_p))
+        {
+            printf("Unexpected previous arena\n");
+            goto error_return;
+        }
+        strcpy(buf, msg);
+        arena_list_p = mpl_param_list_unpack(buf);
+        elem_p = mpl_param_element_create(test_paramid_mystring, "added later");
+        mpl_param_arena_set(NULL);
+
+        if ((NULL == arena_list_p) || (NULL == elem_p) || !elem_p->in_arena ||
+            (arena_list_check(arena_list_p, true) < 0) ||
+            !mpl_arena_contains(arena_p, elem_p->value_p))
+        {
+            printf("Arena unpack failed\n");
+            goto error_return;
+        }
+
+        /* Packs the same as a heap list */
+        if ((mpl_param_list_pack(arena_list_p, arena_packed, sizeof(arena_packed)) <= 0) ||
+            strcmp(packed, arena_packed))
+        {
+            printf("Arena list packs differently: %s\n", arena_packed);
+            goto error_return;
+        }
+
+        /* A clone outside the arena is an ordinary list */
+        clone_p = mpl_param_list_clone(arena_list_p);
+        if ((NULL == clone_p) || (arena_list_check(clone_p, false) < 0))
+        {
+            printf("Clone of arena list failed\n");
+            mpl_param_list_destroy(&clone_p);
+            goto error_return;
+        }
+        mpl_param_list_destroy(&clone_p);
+
+        /* Destroying arena elements is a no-op */
+        mpl_param_element_destroy(elem_p);
+        mpl_param_list_destroy(&arena_list_p);
+
+        if ((i > 0) && (mpl_arena_size(arena_p) != size))
+        {
+            printf("Arena size changed: %zu != %zu\n", mpl_arena_size(arena_p), size);
+            goto error_return;
+        }
+        size = mpl_arena_size(arena_p);
+        mpl_arena_reset(arena_p);
+        if (mpl_arena_size(arena_p) != 0)
+            goto error_return;
+    }
+
+    mpl_arena_destroy(arena_p);
+    return 0;
+
+error_return:
+    mpl_param_arena_set(NULL);
+    mpl_arena_destroy(arena_p);
+    return -1;
+}
+
+/* First element of the list matching, found without any index */
+static mpl_param_element_t *list_index_linear(mpl_list_t *list_p,
+                                              mpl_param_element_id_t id,
+                                              int id_in_context,
+                                              bool any_tag,
+                                              int tag)
+{
+    mpl_list_t *elem_p;
+    mpl_param_element_t *param_elem_p;
+
+    MPL_LIST_FOR_EACH(list_p, elem_p)
+    {
+        param_elem_p = MPL_LIST_CONTAINER(elem_p, mpl_param_element_t, list_entry);
+        if (!any_tag && (param_elem_p->tag != tag))
+            continue;
+        if (id_in_context > 0)
+        {
+            if ((param_elem_p->context == id) &&
+                (param_elem_p->id_in_context == id_in_context))
+                return param_elem_p;
+        }
+        else if ((MPL_PARAM_ID_UNDEFINED == id) || (param_elem_p->id == id))
+            return param_elem_p;
+    }
+    return NULL;
+}
+
+static int list_index_check(mpl_param_list_index_t *index_p, mpl_list_t *list_p)
+{
+    int s_index = TST_FIELD_INDEX(mynewbag, s);
+    int tag;
+
+    if ((mpl_param_list_index_find(index_p, test_paramid_myint) !=
+         list_index_linear(list_p, test_paramid_myint, 0, true, 0)) ||
+        (mpl_param_list_find(test_paramid_myint, list_p) !=
+         list_index_linear(list_p, test_paramid_myint, 0, true, 0)))
+        return -1;
+    if (mpl_param_list_index_find(index_p, test_paramid_mystring) !=
+        list_index_linear(list_p, test_paramid_mystring, 0, true, 0))
+        return -1;
+    if (mpl_param_list_index_find(index_p, test_paramid_myuint8) !=
+        list_index_linear(list_p, test_paramid_myuint8, 0, true, 0))
+        return -1;
+    if ((mpl_param_list_index_find_field(index_p, test_paramid_mynewbag, s_index) !=
+         list_index_linear(list_p, test_paramid_mynewbag, s_index, true, 0)) ||
+        (TST_GET_BAG_FIELD_ELEMENT_PTR(list_p, mynewbag, s) !=
+         list_index_linear(list_p, test_paramid_mynewbag, s_index, true, 0)))
+        return -1;
+
+    for (tag = -1; tag < 60; tag++)
+    {
+        if ((mpl_param_list_index_find_tag(index_p, test_paramid_myint, tag) !=
+             list_index_linear(list_p, test_paramid_myint, 0, false, tag)) ||
+            (mpl_param_list_find_tag(test_paramid_myint, tag, list_p) !=
+             list_index_linear(list_p, test_paramid_myint, 0, false, tag)))
+            return -1;
+        if (mpl_param_list_index_find_tag(index_p, MPL_PARAM_ID_UNDEFINED, tag) !=
+            list_index_linear(list_p, MPL_PARAM_ID_UNDEFINED, 0, false, tag))
+            return -1;
+        if ((mpl_param_list_index_find_field_tag(index_p,
+                                                 test_paramid_mynewbag,
+                                                 s_index,
+                                                 tag) !=
+             list_index_linear(list_p, test_paramid_mynewbag, s_index, false, tag)) ||
+            (mpl_param_list_find_field_tag(test_paramid_mynewbag,
+                                           s_index,
+                                           tag,
+                                           list_p) !=
+             list_index_linear(list_p, test_paramid_mynewbag, s_index, false, tag)))
+            return -1;
+    }
+    return 0;
+}
+
+static int tc_list_index(void)
+{
+    mpl_list_t *list_p = NULL;
+    mpl_list_t *clone_p = NULL;
+    mpl_param_list_index_t *index_p = NULL;
+    mpl_param_element_t *elem_p;
+    char s[16];
+    int i;
+
+    for (i = 0; i < 50; i++)
+    {
+        sprintf(s, "value%d", i);
+        (void) mpl_param_list_add_int_tag(&list_p, test_paramid_myint, i, i % 20);
+        TST_ADD_mynewbag_s_TAG(&list_p, s, i % 10);
+    }
+    (void) mpl_add_param_to_list(&list_p, test_paramid_mystring, "hello world");
+
+    index_p = mpl_param_list_index_create(&list_p);
+    if ((NULL == index_p) || (list_index_check(index_p, list_p) < 0))
+    {
+        printf("Index of new list failed\n");
+        goto error_return;
+    }
+
+    /* Add duplicates in front, then remove first elements */
+    for (i = 0; i < 30; i++)
+    {
+        elem_p = mpl_param_element_create(test_paramid_myint, &i);
+        elem_p->tag = i;
+        if (mpl_param_list_index_add(index_p, elem_p) < 0)
+        {
+            mpl_param_element_destroy(elem_p);
+            goto error_return;
+        }
+    }
+    if (list_index_check(index_p, list_p) < 0)
+    {
+        printf("Index after add failed\n");
+        goto error_return;
+    }
+
+    for (i = 0; i < 70; i++)
+    {
+        elem_p = MPL_LIST_CONTAINER(list_p->next_p, mpl_param_element_t, list_entry);
+        if (mpl_param_list_index_remove(index_p, elem_p) != elem_p)
+        {
+            printf("Index remove failed\n");
+            goto error_return;
+        }
+        mpl_param_element_destroy(elem_p);
+        if (list_index_check(index_p, list_p) < 0)
+        {
+            printf("Index after remove %d failed\n", i);
+            goto error_return;
+        }
+    }
+
+    /* Removing what is not in the list */
+    elem_p = mpl_param_element_create(test_paramid_myint, &i);
+    if (NULL != mpl_param_list_index_remove(index_p, elem_p))
+    {
+        printf("Removed element not in list\n");
+        mpl_param_element_destroy(elem_p);
+        goto error_return;
+    }
+
+    /* The find functions and get macros use the index: an element
+       linked in behind its back is not seen until it is destroyed */
+    elem_p->tag = 1000;
+    elem_p->list_entry.next_p = list_p->next_p;
+    list_p->next_p = &elem_p->list_entry;
+    if ((NULL != mpl_param_list_find_tag(test_paramid_myint, 1000, list_p)) ||
+        TST_EXISTS_TAG(list_p, myint, 1000))
+    {
+        printf("Find did not use the index\n");
+        list_p->next_p = elem_p->list_entry.next_p;
+        mpl_param_element_destroy(elem_p);
+        goto error_return;
+    }
+    if (mpl_param_list_find_tag(test_paramid_myint, 1000, list_p->next_p) != elem_p)
+    {
+        printf("Find from second element used the index\n");
+        list_p->next_p = elem_p->list_entry.next_p;
+        mpl_param_element_destroy(elem_p);
+        goto error_return;
+    }
+    list_p->next_p = elem_p->list_entry.next_p;
+    mpl_param_element_destroy(elem_p);
+
+    mpl_param_list_index_destroy(index_p);
+    index_p = NULL;
+    if (MPL_LIST_CONTAINER(list_p, mpl_param_element_t, list_entry)->heads_index)
+    {
+        printf("Index destroy left heads_index set\n");
+        goto error_return;
+    }
+
+    /* Long lists are compared through an index (tags must be unique) */
+    mpl_param_list_destroy(&list_p);
+    for (i = 0; i < 40; i++)
+    {
+        sprintf(s, "value%d", i);
+        (void) mpl_param_list_add_int_tag(&list_p, test_paramid_myint, i, i);
+        TST_ADD_mynewbag_s_TAG(&list_p, s, i);
+    }
+    (void) mpl_add_param_to_list(&list_p, test_paramid_mystring, "hello world");
+
+    clone_p = mpl_param_list_clone(list_p);
+    if (mpl_compare_param_lists(list_p, clone_p) != 0)
+    {
+        printf("Compare of clone failed\n");
+        goto error_return;
+    }
+    elem_p = mpl_param_list_find_tag(test_paramid_myint, 7, clone_p);
+    if (NULL == elem_p)
+        goto error_return;
+    *(int*)elem_p->value_p = -7;
+    if (mpl_compare_param_lists(list_p, clone_p) == 0)
+    {
+        printf("Compare of modified clone failed\n");
+        goto error_return;
+    }
+    elem_p = mpl_param_list_find(test_paramid_mystring, clone_p);
+    (void) mpl_list_remove(&clone_p, &elem_p->list_entry);
+    mpl_param_element_destroy(elem_p);
+    if (mpl_compare_param_lists(clone_p, list_p) == 0)
+    {
+        printf("Compare of shorter clone failed\n");
+        goto error_return;
+    }
+
+    mpl_param_list_index_destroy(index_p);
+    mpl_param_list_destroy(&list_p);
+    mpl_param_list_destroy(&clone_p);
+    return 0;
+
+ error_return:
+    mpl_param_list_index_destroy(index_p);
+    mpl_param_list_destroy(&list_p);
+    mpl_param_list_destroy(&clone_p);
+    return -1;
+}
+
+typedef struct
+{
+    char *buf_p;
+    size_t len;
+    int num_writes;
+    int fail_after;
+} stream_sink_t;
+
+static int stream_sink_write(void *ctx_p, const char *data_p, size_t len)
+{
+    stream_sink_t *sink_p = ctx_p;
+    char *new_p;
+
+    if ((sink_p->fail_after >= 0) && (sink_p->num_writes >= sink_p->fail_after))
+        return -1;
+
+    new_p = realloc(sink_p->buf_p, sink_p->len + len + 1);
+    if (NULL == new_p)
+        return -1;
+    sink_p->buf_p = new_p;
+    memcpy(sink_p->buf_p + sink_p->len, data_p, len);
+    sink_p->len += len;
+    sink_p->buf_p[sink_p->len] = '\0';
+    sink_p->num_writes++;
+    return 0;
+}
+
+static int tc_pack_stream(void)
+{
+    mpl_list_t *list_p = NULL;
+    stream_sink_t sink = { NULL, 0, 0, -1 };
+    mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
+    char *buf_p = NULL;
+    char *alloc_p = NULL;
+    char str[20];
+    size_t len;
+    int buflen;
+    int res;
+    int i;
+
+    /* Empty list */
+    alloc_p = mpl_param_list_pack_alloc(NULL, NULL, &len);
+    if ((NULL == alloc_p) || (0 != len) || strcmp(alloc_p, "") ||
+        (mpl_param_list_pack_stream(NULL, stream_sink_write, &sink, NULL) != 0) ||
+        (0 != sink.num_writes))
+    {
+        printf("Stream pack of empty list failed\n");
+        goto error_return;
+    }
+    free(alloc_p);
+    alloc_p = NULL;
+
+    /* Much larger than one batch */
+    for (i = 0; i < 3000; i++)
+    {
+        sprintf(str, "string %d", i);
+        (void) mpl_param_list_add_int_tag(&list_p, test_paramid_myint, i, i % 1000);
+        (void) mpl_add_param_to_list(&list_p, test_paramid_mystring, str);
+    }
+    options.no_prefix = true;
+    options.message_delimiter = '\n';
+
+    buflen = mpl_param_list_pack_extended(list_p, NULL, 0, &options);
+    buf_p = malloc(buflen + 1);
+    if ((NULL == buf_p) ||
+        (mpl_param_list_pack_extended(list_p, buf_p, buflen + 1, &options) != buflen))
+        goto error_return;
+
+    res = mpl_param_list_pack_stream(list_p, stream_sink_write, &sink, &options);
+    if ((res != buflen) || (sink.len != (size_t)buflen) ||
+        strcmp(sink.buf_p, buf_p) || (sink.num_writes < 2))
+    {
+        printf("Stream pack differs: %d %d\n", res, buflen);
+        goto error_return;
+    }
+
+    alloc_p = mpl_param_list_pack_alloc(list_p, &options, &len);
+    if ((NULL == alloc_p) || (len != (size_t)buflen) || strcmp(alloc_p, buf_p))
+    {
+        printf("Pack to allocated buffer differs\n");
+        goto error_return;
+    }
+
+    /* A failing writer stops the packing */
+    free(sink.buf_p);
+    sink.buf_p = NULL;
+    sink.len = 0;
+    sink.num_writes = 0;
+    sink.fail_after = 1;
+    if (mpl_param_list_pack_stream(list_p, stream_sink_write, &sink, &options) >= 0)
+    {
+        printf("Stream pack with failing writer succeeded\n");
+        goto error_return;
+    }
+
+    free(sink.buf_p);
+    free(buf_p);
+    free(alloc_p);
+    mpl_param_list_destroy(&list_p);
+    return 0;
+
+ error_return:
+    free(sink.buf_p);
+    free(buf_p);
+    free(alloc_p);
+    mpl_param_list_destroy(&list_p);
+    return -1;
+}
+
+typedef struct
+{
+    mpl_list_t *messages[8];
+    bool errors[8];
+    int num_messages;
+    int num_elements;
+} stream_result_t;
+
+static int stream_message(void *ctx_p, mpl_list_t *param_list_p, bool has_error)
+{
+    stream_result_t *result_p = ctx_p;
+
+    if (result_p->num_messages >= 8)
+    {
+        mpl_param_list_destroy(&param_list_p);
+        return -1;
+    }
+    result_p->messages[result_p->num_messages] = param_list_p;
+    result_p->errors[result_p->num_messages] = has_error;
+    result_p->num_messages++;
+    return 0;
+}
+
+static int stream_element(void *ctx_p, mpl_param_element_t *param_elem_p)
+{
+    stream_result_t *result_p = ctx_p;
+
+    result_p->num_elements++;
+    mpl_param_element_destroy(param_elem_p);
+    return 0;
+}
+
+static void stream_result_clear(stream_result_t *result_p)
+{
+    int i;
+
+    for (i = 0; i < result_p->num_messages; i++)
+        mpl_param_list_destroy(&result_p->messages[i]);
+    memset(result_p, 0, sizeof(*result_p));
+}
+
+/* Lists with duplicate parameters, so compare them packed */
+static int stream_list_compare(mpl_list_t *list1_p, mpl_list_t *list2_p)
+{
+    char buf1[512];
+    char buf2[512];
+
+    if ((mpl_param_list_pack(list1_p, buf1, sizeof(buf1)) <= 0) ||
+        (mpl_param_list_pack(list2_p, buf2, sizeof(buf2)) <= 0))
+        return -1;
+    return strcmp(buf1, buf2);
+}
+
+static int tc_unpack_stream(void)
+{
+    const char *msg =
+        "test.mystring=hallo\\, world,"
+        "test.mylist1={test.myuint8=0x13,test.myuint8=0x12,test.myuint32=1234},"
+        "test.myint=55,"
+        "test.mystring_tup=eth0:10.2.3.4,"
+        "test.myuint8_arr=000000030102ff,"
+        "test.myint_tup=1:2";
+    char input[1024];
+    char buf[512];
+    mpl_list_t *expected_p;
+    mpl_unpack_stream_t *stream_p = NULL;
+    stream_result_t result;
+    size_t input_len;
+    size_t pos;
+    size_t chunk;
+    int i;
+
+    memset(&result, 0, sizeof(result));
+    strcpy(buf, msg);
+    expected_p = mpl_param_list_unpack(buf);
+    if (mpl_list_len(expected_p) != 6)
+    {
+        printf("Unpack of reference message failed\n");
+        goto error_return;
+    }
+
+    /* Good, empty, bad and unterminated message */
+    input_len = sprintf(input, "%s\n\n  \ntest.myint=5000,%s\n%s", msg, msg, msg);
+
+    for (chunk = 1; chunk <= input_len; chunk = (chunk < 8) ? (chunk + 1) : (chunk * 3))
+    {
+        stream_p = mpl_unpack_stream_create(NULL, '\n', NULL, stream_message, &result);
+        if (NULL == stream_p)
+            goto error_return;
+
+        for (pos = 0; pos < input_len; pos += chunk)
+        {
+            if (mpl_unpack_stream_feed(stream_p,
+                                       input + pos,
+                                       ((input_len - pos) < chunk) ? (input_len - pos) : chunk) < 0)
+                goto error_return;
+        }
+        if (result.num_messages != 2)
+        {
+            printf("Expected 2 messages before finish, got %d (chunk %zu)\n",
+                   result.num_messages, chunk);
+            goto error_return;
+        }
+        if (mpl_unpack_stream_finish(stream_p) < 0)
+            goto error_return;
+
+        if ((result.num_messages != 3) ||
+            result.errors[0] || !result.errors[1] || result.errors[2] ||
+            (NULL != result.messages[1]) ||
+            stream_list_compare(expected_p, result.messages[0]) ||
+            stream_list_compare(expected_p, result.messages[2]))
+        {
+            printf("Stream unpack differs (chunk %zu)\n", chunk);
+            goto error_return;
+        }
+
+        stream_result_clear(&result);
+        mpl_unpack_stream_destroy(stream_p);
+        stream_p = NULL;
+    }
+
+    /* Element callback, messages larger than any read buffer */
+    stream_p = mpl_unpack_stream_create(NULL, '\n', stream_element, stream_message, &result);
+    if (NULL == stream_p)
+        goto error_return;
+    for (i = 0; i < 1000; i++)
+    {
+        if (mpl_unpack_stream_feed(stream_p, msg, strlen(msg)) < 0)
+            goto error_return;
+        if (mpl_unpack_stream_feed(stream_p, ",", 1) < 0)
+            goto error_return;
+    }
+    if ((mpl_unpack_stream_feed(stream_p, "\n", 1) < 0) ||
+        (result.num_messages != 1) || result.errors[0] ||
+        (NULL != result.messages[0]) || (result.num_elements != 6000))
+    {
+        printf("Stream unpack with element callback failed: %d\n",
+               result.num_elements);
+        goto error_return;
+    }
+
+    /* Incomplete message is discarded */
+    if (mpl_unpack_stream_feed(stream_p, msg, 20) < 0)
+        goto error_return;
+
+    stream_result_clear(&result);
+    mpl_unpack_stream_destroy(stream_p);
+    mpl_param_list_destroy(&expected_p);
+    return 0;
+
+ error_return:
+    stream_result_clear(&result);
+    mpl_unpack_stream_destroy(stream_p);
+    mpl_param_list_destroy(&expected_p);
+    return -1;
+}
+
+static int tc_read_large_file(void)
+{
+    FILE *fp;
+    char *path = CONFIG_FILE;
+    mpl_list_t *list_p = NULL;
+    mpl_list_t *pipe_list_p = NULL;
+    mpl_list_t *elem_p;
+    int *value_p;
+    int expected_sum = 0;
+    int sum = 0;
+    int line;
+    int i;
+    char cmd[512];
+
+    fp = fopen(path, "w");
+    if (NULL == fp)
+    {
+        printf("Could not open %s for writing\n", path);
+        return -1;
+    }
+
+    /* About 300 KB, 2000 byte lines with comments and white space */
+    fprintf(fp, "# Large parameter file\n\n");
+    for (line = 0; line < 150; line++)
+    {
+        fprintf(fp, "  ");
+        for (i = 0; i < 150; i++)
+        {
+            fprintf(fp, "%stest.myint=%d", (i > 0) ? ";" : "", (line + i) % 1000);
+            expected_sum += (line + i) % 1000;
+        }
+        fprintf(fp, " \t# line %d\n", line);
+    }
+    /* Last line without newline */
+    fprintf(fp, "test.mystring=last line");
+    fclose(fp);
+
+    fp = fopen(path, "r");
+    if (NULL == fp)
+    {
+        printf("Could not open %s for reading\n", path);
+        return -1;
+    }
+
+    if (mpl_file_read_params(fp, &list_p, TEST_PARAM_SET_ID) < 0)
+    {
+        printf("Reading large file failed\n");
+        fclose(fp);
+        goto error_return;
+    }
+    fclose(fp);
+
+    if (mpl_list_len(list_p) != (150 * 150 + 1))
+    {
+        printf("Wrong number of parameters: %zu\n", mpl_list_len(list_p));
+        goto error_return;
+    }
+
+    if ((NULL == mpl_param_list_find(test_paramid_mystring, list_p)) ||
+        strcmp(MPL_GET_PARAM_VALUE_PTR_FROM_LIST(char*,
+                                                 test_paramid_mystring,
+                                                 list_p),
+               "last line"))
+    {
+        printf("Last line not read\n");
+        goto error_return;
+    }
+
+    MPL_LIST_FOR_EACH(list_p, elem_p)
+    {
+        mpl_param_element_t *param_p =
+            MPL_LIST_CONTAINER(elem_p, mpl_param_element_t, list_entry);
+        if (param_p->id == test_paramid_myint)
+        {
+            value_p = param_p->value_p;
+            sum += *value_p;
+        }
+    }
+    if (sum != expected_sum)
+    {
+        printf("Wrong sum of values: %d != %d\n", sum, expected_sum);
+        goto error_return;
+    }
+
+    /* Same result when the size is not known up front */
+    snprintf(cmd, sizeof(cmd), "cat %s", path);
+    fp = popen(cmd, "r");
+    if (NULL == fp)
+    {
+        printf("Could not open pipe\n");
+        goto error_return;
+    }
+    if (mpl_file_read_params(fp, &pipe_list_p, TEST_PARAM_SET_ID) < 0)
+    {
+        printf("Reading large file from pipe failed\n");
+        pclose(fp);
+        goto error_return;
+    }
+    pclose(fp);
+
+    if (mpl_list_len(pipe_list_p) != mpl_list_len(list_p))
+    {
+        printf("Wrong number of parameters from pipe: %zu\n",
+               mpl_list_len(pipe_list_p));
+        goto error_return;
+    }
+
+    remove(path);
+    mpl_param_list_destroy(&list_p);
+    mpl_param_list_destroy(&pipe_list_p);
+    return 0;
+
+ error_return:
+    remove(path);
+    mpl_param_list_destroy(&list_p);
+    mpl_param_list_destroy(&pipe_list_p);
+    return -1;
+}
+
+static mpl_param_element_t *store_record(int i1, int i2)
+{
+    mpl_bag_t *bag_p = NULL;
+    mpl_param_element_t *record_p;
+    char s[] = "store record";
+
+    TST_ADD_mynewbag_i1(&bag_p, i1);
+    TST_ADD_mynewbag_i2(&bag_p, i2);
+    TST_ADD_mynewbag_s_TAG(&bag_p, s, 1);
+    record_p = mpl_param_element_create(test_paramid_mynewbag, bag_p);
+    mpl_param_list_destroy(&bag_p);
+    return record_p;
+}
+
+static int store_put(mpl_store_t *store_p, int i1, int i2)
+{
+    mpl_param_element_t *record_p = store_record(i1, i2);
+    int res;
+
+    res = (NULL != record_p) ? mpl_store_put(store_p, record_p) : -1;
+    mpl_param_element_destroy(record_p);
+    return res;
+}
+
+/* Returns i2 of the record with key i1, or -1 if not found */
+static int store_get_i2(mpl_store_t *store_p, int i1)
+{
+    mpl_param_element_t *key_p;
+    const mpl_param_element_t *record_p;
+
+    key_p = mpl_param_element_create(test_paramid_myint, &i1);
+    record_p = mpl_store_get(store_p, key_p);
+    mpl_param_element_destroy(key_p);
+    if (NULL == record_p)
+        return -1;
+    return TST_GET_mynewbag_i2(record_p->value_p);
+}
+
+static int store_delete(mpl_store_t *store_p, int i1)
+{
+    mpl_param_element_t *key_p;
+    int res;
+
+    key_p = mpl_param_element_create(test_paramid_myint, &i1);
+    res = mpl_store_delete(store_p, key_p);
+    mpl_param_element_destroy(key_p);
+    return res;
+}
+
+static int store_count_lines(const char *path_p)
+{
+    FILE *fp;
+    int c;
+    int lines = 0;
+
+    fp = fopen(path_p, "r");
+    if (NULL == fp)
+        return -1;
+    while ((c = fgetc(fp)) != EOF)
+    {
+        if (c == '\n')
+            lines++;
+    }
+    fclose(fp);
+    return lines;
+}
+
+static int store_check_sum(void *ctx_p, const mpl_param_element_t *record_p)
+{
+    int *sum_p = ctx_p;
+
+    *sum_p += TST_GET_mynewbag_i1(record_p->value_p);
+    return 0;
+}
+
+static int tc_store(void)
+{
+    char *path = CONFIG_FILE;
+    mpl_store_options_t options;
+    mpl_store_t *store_p = NULL;
+    FILE *fp;
+    int i;
+    int sum;
+    int lines;
+
+    options.param_set_id = TEST_PARAM_SET_ID;
+    options.record_id = test_paramid_mynewbag;
+    options.key_context = test_paramid_mynewbag;
+    options.key_field = TST_FIELD_INDEX(mynewbag, i1);
+    options.sync_interval = 0;
+    options.compact_min = 0;
+
+    remove(path);
+    store_p = mpl_store_open(path, &options);
+    if (NULL == store_p)
+    {
+        printf("mpl_store_open() failed\n");
+        return -1;
+    }
+
+    for (i = 1; i <= 100; i++)
+    {
+        if (store_put(store_p, i, i) < 0)
+        {
+            printf("mpl_store_put() failed\n");
+            goto error_return;
+        }
+    }
+    /* Replace 1..10, delete 81..100 */
+    for (i = 1; i <= 10; i++)
+    {
+        if (store_put(store_p, i, 500 + i) < 0)
+            goto error_return;
+    }
+    for (i = 81; i <= 100; i++)
+    {
+        if (store_delete(store_p, i) != 1)
+        {
+            printf("mpl_store_delete() failed\n");
+            goto error_return;
+        }
+    }
+    if (store_delete(store_p, 100) != 0)
+    {
+        printf("Deleted record was deleted again\n");
+        goto error_return;
+    }
+
+    /* The records read back from the journal are the same */
+    for (i = 0; i < 2; i++)
+    {
+        if ((mpl_store_count(store_p) != 80) ||
+            (store_get_i2(store_p, 5) != 505) ||
+            (store_get_i2(store_p, 50) != 50) ||
+            (store_get_i2(store_p, 90) != -1))
+        {
+            printf("Wrong store contents (%d)\n", i);
+            goto error_return;
+        }
+        if (mpl_store_close(store_p) < 0)
+        {
+            store_p = NULL;
+            goto error_return;
+        }
+        store_p = mpl_store_open(path, &options);
+        if (NULL == store_p)
+            goto error_return;
+    }
+
+    sum = 0;
+    (void) mpl_store_foreach(store_p, store_check_sum, &sum);
+    if (sum != (80 * 81 / 2))
+    {
+        printf("Wrong sum of keys: %d\n", sum);
+        goto error_return;
+    }
+
+    /* A partly written line is removed when opening */
+    mpl_store_close(store_p);
+    store_p = NULL;
+    lines = store_count_lines(path);
+    fp = fopen(path, "a");
+    if (NULL == fp)
+        goto error_return;
+    fprintf(fp, "test.mynewbag={i1=200,i2=");
+    fclose(fp);
+
+    store_p = mpl_store_open(path, &options);
+    if ((NULL == store_p) ||
+        (mpl_store_count(store_p) != 80) ||
+        (store_put(store_p, 200, 1) < 0))
+    {
+        printf("Incomplete line not handled\n");
+        goto error_return;
+    }
+    mpl_store_close(store_p);
+    store_p = mpl_store_open(path, &options);
+    if ((NULL == store_p) ||
+        (mpl_store_count(store_p) != 81) ||
+        (store_get_i2(store_p, 200) != 1) ||
+        (store_count_lines(path) != (lines + 1)))
+    {
+        printf("Record after incomplete line not read\n");
+        goto error_return;
+    }
+
+    /* Compaction leaves one line per record */
+    if ((mpl_store_compact(store_p) < 0) ||
+        (store_count_lines(path) != 81) ||
+        (store_put(store_p, 201, 2) < 0) ||
+        (store_count_lines(path) != 82))
+    {
+        printf("Compaction failed\n");
+        goto error_return;
+    }
+    mpl_store_close(store_p);
+    store_p = mpl_store_open(path, &options);
+    if ((NULL == store_p) ||
+        (mpl_store_count(store_p) != 82) ||
+        (store_get_i2(store_p, 5) != 505) ||
+        (store_get_i2(store_p, 201) != 2))
+    {
+        printf("Wrong store contents after compaction\n");
+        goto error_return;
+    }
+    mpl_store_close(store_p);
+
+    /* Automatic compaction keeps the journal small */
+    options.compact_min = 10;
+    options.sync_interval = 4;
+    store_p = mpl_store_open(path, &options);
+    if (NULL == store_p)
+        goto error_return;
+    for (i = 0; i < 1000; i++)
+    {
+        if (store_put(store_p, 1 + (i % 5), i % 1000) < 0)
+            goto error_return;
+    }
+    if ((store_count_lines(path) > (82 + 82 + 10)) ||
+        (store_get_i2(store_p, 5) != 999))
+    {
+        printf("No automatic compaction: %d lines\n",
+               store_count_lines(path));
+        goto error_return;
+    }
+
+    /* Wrong record type is refused */
+    {
+        int myint = 1;
+        mpl_param_element_t *elem_p;
+
+        elem_p = mpl_param_element_create(test_paramid_myint, &myint);
+        if (mpl_store_put(store_p, elem_p) == 0)
+        {
+            printf("Wrong record type accepted\n");
+            mpl_param_element_destroy(elem_p);
+            goto error_return;
+        }
+        mpl_param_element_destroy(elem_p);
+    }
+
+    mpl_store_close(store_p);
+    remove(path);
+    return 0;
+
+ error_return:
+    mpl_store_close(store_p);
+    remove(path);
+    return -1;
+}
+
+static int tc_bag_struct(void)
+{
+    mpl_bag_t *bag_p = NULL;
+    mpl_param_element_t *elem_p = NULL;
+    mpl_param_element_t *elem2_p;
+    mpl_list_t *list_p = NULL;
+    test_mynewbag_struct_t s;
+    test_mybigbag_struct_t big;
+    char s1[] = "first string";
+    char s2[] = "second string";
+    char buf[2048];
+    char buf2[256];
+    char small[10];
+    int len;
+    int i;
+    const char *bad_values[] = {
+        "{i1=1,s[1]=\"hello world\"}",            /* i2 missing */
+        "{i1=1,i2=2}",                            /* s missing */
+        "{i1=1,i2=2,s[1]=\"hello world\",x=1}",   /* unknown field */
+        "{i1=1,i2=2,s[2]=\"hello world\"}",       /* tags not in order */
+        "{i1=1,i1=1,i2=2,s[1]=\"hello world\"}",  /* i1 twice */
+        "{i1=1,i2=2,s[1]=\"too long string, more than 20\"}",
+        "{i1=1,i2=2,s[1]=\"hello world\",b=maybe}",
+        "{i1=1,i2,s[1]=\"hello world\"}",
+        "i1=1,i2=2,s[1]=\"hello world\""
+    };
+
+    memset(&s, 0, sizeof(s));
+    memset(&big, 0, sizeof(big));
+
+    /* Pack the same bag from a list and from the struct */
+    TST_ADD_mynewbag_i1(&bag_p, 111);
+    TST_ADD_mynewbag_i2(&bag_p, -5);
+    TST_ADD_mynewbag_s_TAG(&bag_p, s1, 1);
+    TST_ADD_mynewbag_s_TAG(&bag_p, s2, 2);
+    TST_ADD_mynewbag_b(&bag_p, true);
+    elem_p = mpl_param_element_create(test_paramid_mynewbag, bag_p);
+    mpl_param_list_destroy(&bag_p);
+    if (NULL == elem_p)
+        goto error_return;
+    len = mpl_param_pack(elem_p, buf, sizeof(buf));
+    if ((len < 0) || (len >= (int)sizeof(buf)))
+        goto error_return;
+
+    if (test_mynewbag_struct_unpack(buf, &s) < 0)
+    {
+        printf("Struct unpack failed: %s\n", buf);
+        goto error_return;
+    }
+    if ((s.i1 != 111) || (s.i2 != -5) || (s.s_count != 2) ||
+        strcmp(s.s[0], s1) || strcmp(s.s[1], s2) ||
+        !s.has.b || !s.b)
+    {
+        printf("Struct unpack wrong values: %s\n", buf);
+        goto error_return;
+    }
+
+    /* Same fields, but in declaration order (the list has them reversed) */
+    len = test_mynewbag_struct_pack(&s, buf2, sizeof(buf2));
+    if ((len != (int)strlen(buf)) ||
+        strcmp(buf2, "test.mynewbag={i1=111,i2=-5,s[1]=first string,"
+               "s[2]=second string,b=true}"))
+    {
+        printf("Struct pack differs:\n%s\n%s\n", buf, buf2);
+        goto error_return;
+    }
+
+    /* Too small buffer gives the needed length, like snprintf() */
+    if ((test_mynewbag_struct_pack(&s, small, sizeof(small)) != len) ||
+        (strlen(small) != (sizeof(small) - 1)))
+    {
+        printf("Struct pack to small buffer failed\n");
+        goto error_return;
+    }
+
+    /* The struct packing unpacks as a parameter list */
+    list_p = mpl_param_list_unpack(buf2);
+    if ((NULL == list_p) || (mpl_list_len(list_p) != 1))
+        goto error_return;
+    elem2_p = MPL_LIST_CONTAINER(list_p, mpl_param_element_t, list_entry);
+    if (mpl_param_element_compare(elem_p, elem2_p))
+    {
+        printf("Struct pack does not unpack to the same bag\n");
+        goto error_return;
+    }
+    mpl_param_list_destroy(&list_p);
+
+    /* Optional field left out */
+    s.has.b = 0;
+    len = test_mynewbag_struct_pack_value(&s, buf, sizeof(buf));
+    if ((len < 0) ||
+        strcmp(buf, "={i1=111,i2=-5,s[1]=first string,s[2]=second string}"))
+    {
+        printf("Struct pack without optional field: %s\n", buf);
+        goto error_return;
+    }
+    test_mynewbag_struct_free(&s);
+    if ((s.s != NULL) || (s.s_count != 0))
+        goto error_return;
+
+    /* Mandatory multiple field is missing */
+    if (test_mynewbag_struct_pack_value(&s, buf, sizeof(buf)) >= 0)
+    {
+        printf("Struct pack without mandatory field\n");
+        goto error_return;
+    }
+
+    /* Anything the struct can not hold fails, and leaves it cleared */
+    for (i = 0; i < (int)(sizeof(bad_values)/sizeof(bad_values[0])); i++)
+    {
+        if ((test_mynewbag_struct_unpack_value(bad_values[i], &s) == 0) ||
+            (s.s != NULL) || (s.s_count != 0))
+        {
+            printf("Struct unpack accepted %s\n", bad_values[i]);
+            goto error_return;
+        }
+    }
+    if (test_mynewbag_struct_unpack("test.mybigbag={f1=1}", &s) == 0)
+    {
+        printf("Struct unpack accepted wrong parameter\n");
+        goto error_return;
+    }
+    if (test_mynewbag_struct_unpack("mynewbag={i1=1,i2=2,s[1]=hello world}", &s) < 0)
+    {
+        printf("Struct unpack without prefix failed\n");
+        goto error_return;
+    }
+    test_mynewbag_struct_free(&s);
+
+    /* Many elements in an array that grows */
+    strcpy(buf, "{i1=1,i2=2");
+    for (i = 1; i <= 100; i++)
+        sprintf(buf + strlen(buf), ",s[%d]=str%04d", i, i);
+    strcat(buf, "}");
+    if ((test_mynewbag_struct_unpack_value(buf, &s) < 0) ||
+        (s.s_count != 100) || strcmp(s.s[99], "str0100"))
+    {
+        printf("Struct unpack of 100 elements failed\n");
+        goto error_return;
+    }
+    test_mynewbag_struct_free(&s);
+
+    /* Fields in another order than declared */
+    if ((test_mybigbag_struct_unpack("test.mybigbag={f9=9,f1=1,f2=2,f3=3,f4=4,f5=5,f6=6,f7=7,f8=8}",
+                                     &big) < 0) ||
+        (big.f1 != 1) || (big.f5 != 5) || (big.f9 != 9))
+    {
+        printf("Struct unpack of mybigbag failed\n");
+        goto error_return;
+    }
+    len = test_mybigbag_struct_pack(&big, buf, sizeof(buf));
+    if ((len < 0) ||
+        strcmp(buf, "test.mybigbag={f1=1,f2=2,f3=3,f4=4,f5=5,f6=6,f7=7,f8=8,f9=9}"))
+    {
+        printf("Struct pack of mybigbag: %s\n", buf);
+        goto error_return;
+    }
+
+    /* Arrays, tuples, enums and addrs */
+    {
+        test_mystructbag_struct_t st;
+        test_mystructbag_struct_t st2;
+        mpl_int_tuple_t itup = {-5, 6};
+        mpl_string_tuple_t stup = {"key", "value"};
+        uint32_t u32[] = {7, 4000000000u};
+        mpl_uint32_array_t u32_arr = {2, u32};
+        mpl_uint32_array_t *u32_arrs[] = {&u32_arr, &u32_arr};
+
+        memset(&st, 0, sizeof(st));
+        st.a[0] = 1;
+        st.a[1] = 2;
+        st.a[2] = 255;
+        st.a_len = 3;
+        st.it = &itup;
+        st.e = test_my_enum_val2;
+        st.p = &st;
+        st.u = u32_arrs;
+        st.u_count = 2;
+        len = test_mystructbag_struct_pack(&st, buf, sizeof(buf));
+        if ((len < 0) || (test_mystructbag_struct_unpack(buf, &st2) < 0))
+        {
+            printf("Struct pack/unpack of mystructbag failed: %s\n", buf);
+            goto error_return;
+        }
+        if ((st2.a_len != 3) || (st2.a[0] != 1) || (st2.a[2] != 255) ||
+            st2.has.b || st2.has.st || (st2.b_len != 0) || (st2.st != NULL) ||
+            (st2.it == NULL) || (st2.it->key != -5) || (st2.it->value != 6) ||
+            (st2.e != test_my_enum_val2) || (st2.p != &st) ||
+            (st2.u_count != 2) || (st2.u[1]->len != 2) ||
+            (st2.u[1]->arr_p[1] != 4000000000u))
+        {
+            printf("Struct unpack of mystructbag wrong values: %s\n", buf);
+            test_mystructbag_struct_free(&st2);
+            goto error_return;
+        }
+        test_mystructbag_struct_free(&st2);
+
+        /* With the optional fields, the list unpack agrees */
+        st.has.b = 1;
+        st.b[0] = 1000;
+        st.b[1] = 2000;
+        st.b_len = 2;
+        st.has.st = 1;
+        st.st = &stup;
+        len = test_mystructbag_struct_pack(&st, buf, sizeof(buf));
+        list_p = mpl_param_list_unpack(buf);
+        if ((len < 0) || (NULL == list_p) ||
+            (test_mystructbag_struct_unpack(buf, &st2) < 0))
+        {
+            printf("Struct pack of mystructbag with options failed: %s\n", buf);
+            goto error_return;
+        }
+        mpl_param_list_destroy(&list_p);
+        len = test_mystructbag_struct_pack(&st2, buf2, sizeof(buf2));
+        if ((len < 0) || strcmp(buf, buf2) ||
+            (st2.b_len != 2) || (st2.b[1] != 2000) ||
+            strcmp(st2.st->key_p, "key") || strcmp(st2.st->value_p, "value"))
+        {
+            printf("Struct repack of mystructbag differs:\n%s\n%s\n", buf, buf2);
+            test_mystructbag_struct_free(&st2);
+            goto error_return;
+        }
+        test_mystructbag_struct_free(&st2);
+        if ((st2.u != NULL) || (st2.st != NULL) || (st2.it != NULL))
+            goto error_return;
+
+        /* Mandatory tuple missing, and array longer than its max */
+        st.it = NULL;
+        if (test_mystructbag_struct_pack(&st, buf, sizeof(buf)) >= 0)
+        {
+            printf("Struct pack without mandatory tuple\n");
+            goto error_return;
+        }
+        st.it = &itup;
+        st.a_len = 21;
+        if (test_mystructbag_struct_pack(&st, buf, sizeof(buf)) >= 0)
+        {
+            printf("Struct pack of too long array\n");
+            goto error_return;
+        }
+    }
+
+    /* An empty bag is packed without value */
+    {
+        const char *value_p;
+        char *copy_p;
+        mpl_arg_t *args_p;
+
+        value_p = mpl_param_struct_value("test.mybigbag", "test", "mybigbag");
+        if ((value_p == NULL) || (*value_p != '\0') ||
+            (mpl_param_struct_split(value_p, &copy_p, &args_p) != 0))
+        {
+            printf("Struct value of empty bag failed\n");
+            goto error_return;
+        }
+        if (mpl_param_struct_value("test.mybigbag2", "test", "mybigbag") != NULL)
+        {
+            printf("Struct value of wrong name did not fail\n");
+            goto error_return;
+        }
+    }
+
+    mpl_param_element_destroy(elem_p);
+    return 0;
+
+ error_return:
+    test_mynewbag_struct_free(&s);
+    mpl_param_list_destroy(&list_p);
+    mpl_param_element_destroy(elem_p);
+    return -1;
+}
+
+static mpl_list_t *tc_dispatch_mycommand2(mpl_bag_t *reqParams, void *ctx_p)
+{
+    mpl_list_t *respMsg = NULL;
+    mpl_bag_t *respParams = NULL;
+
+    (*(int *) ctx_p)++;
+    TST_ADD_mycommand2_resp_i(&respParams,
+                              (int) strlen(TST_GET_mycommand2_cmd_s_PTR(reqParams)));
+    mpl_add_param_to_list(&respMsg,
+                          TESTCAT_COMMAND_ID_TO_RESPONSE_ID(TST_PARAM_ID(mycommand2_cmd)),
+                          respParams);
+    mpl_param_list_destroy(&respParams);
+    return respMsg;
+}
+
+static int tc_dispatch(void)
+{
+    testcat_handlers_t handlers;
+    mpl_list_t *req_p = NULL;
+    mpl_list_t *resp_p = NULL;
+    char cmd2[] = "test.mycommand2_cmd={s=hello}";
+    char cmd[] = "test.mycommand_cmd={myint=1}";
+    char resp[] = "test.mycommand2_resp={i=5}";
+    int calls = 0;
+
+    memset(&handlers, 0, sizeof(handlers));
+    handlers.mycommand2 = tc_dispatch_mycommand2;
+
+    /* Command with a handler */
+    req_p = mpl_param_list_unpack(cmd2);
+    if (req_p == NULL)
+        goto error_return;
+    resp_p = testcat_dispatch(&handlers, req_p, &calls);
+    if ((resp_p == NULL) || (calls != 1) ||
+        !TESTCAT_IS_RESPONSE(resp_p) ||
+        (TESTCAT_GET_RESPONSE_ID(resp_p) != TST_PARAM_ID(mycommand2_resp)) ||
+        (TST_GET_mycommand2_resp_i(TESTCAT_GET_RESPONSE_PARAMS_PTR(resp_p)) != 5))
+    {
+        printf("Dispatch of mycommand2 failed\n");
+        goto error_return;
+    }
+    mpl_param_list_destroy(&req_p);
+    mpl_param_list_destroy(&resp_p);
+
+    /* Command without a handler */
+    req_p = mpl_param_list_unpack(cmd);
+    if (req_p == NULL)
+        goto error_return;
+    if ((testcat_dispatch(&handlers, req_p, &calls) != NULL) || (calls != 1))
+    {
+        printf("Dispatch of mycommand without handler did not fail\n");
+        goto error_return;
+    }
+    mpl_param_list_destroy(&req_p);
+
+    /* Not a command */
+    req_p = mpl_param_list_unpack(resp);
+    if (req_p == NULL)
+        goto error_return;
+    if ((testcat_dispatch(&handlers, req_p, &calls) != NULL) || (calls != 1))
+    {
+        printf("Dispatch of a response did not fail\n");
+        goto error_return;
+    }
+    mpl_param_list_destroy(&req_p);
+    return 0;
+
+ error_return:
+    mpl_param_list_destroy(&req_p);
+    mpl_param_list_destroy(&resp_p);
+    return -1;
+}
+
+static mpl_list_t *tc_server_handler(void *ctx_p,
+                                     mpl_list_t *req_p,
+                                     bool has_error)
+{
+    int *myint_p;
+
+    if (has_error || (NULL == req_p))
+        return NULL;
+    myint_p = MPL_GET_PARAM_VALUE_PTR_FROM_LIST(int*, test_paramid_myint, req_p);
+    if (NULL == myint_p)
+        return NULL;
+    /* Let later requests finish first now and then */
+    if ((*myint_p % 7) == 0)
+        usleep(200);
+    return mpl_param_list_clone(req_p);
+}
+
+static void *tc_server_thread(void *arg_p)
+{
+    (void) mpl_server_run(arg_p);
+    return NULL;
+}
+
+/* Send requests myint=0..num-1 (with some noise) and check that the
+   echoed responses come back in order */
+static int tc_server_pipeline(int fd, int num)
+{
+    char *buf;
+    char *line_p;
+    char *nl_p;
+    size_t size = 32 * (size_t)num + 64;
+    size_t len = 0;
+    ssize_t n;
+    int expected = 0;
+    int res = -1;
+    int i;
+
+    buf = malloc(size);
+    if (NULL == buf)
+        return -1;
+    for (i = 0; i < num; i++)
+    {
+        len += sprintf(buf + len, "test.myint=%d\n", i);
+        if (i == num / 2)
+            len += sprintf(buf + len, "\ntest.nosuchparam=1\n");
+    }
+    for (i = 0; i < (int)len; i += n)
+    {
+        n = write(fd, buf + i, len - i);
+        if (n <= 0)
+            goto out;
+    }
+    (void) shutdown(fd, SHUT_WR);
+
+    len = 0;
+    while ((n = read(fd, buf + len, size - len - 1)) > 0)
+        len += n;
+    buf[len] = '\0';
+
+    for (line_p = buf; (nl_p = strchr(line_p, '\n')) != NULL; line_p = nl_p + 1)
+    {
+        mpl_list_t *resp_p;
+        int *myint_p;
+
+        *nl_p = '\0';
+        resp_p = mpl_param_list_unpack(line_p);
+        myint_p = MPL_GET_PARAM_VALUE_PTR_FROM_LIST(int*, test_paramid_myint, resp_p);
+        if ((NULL == myint_p) || (*myint_p != expected))
+        {
+            printf("Unexpected response '%s', expected myint=%d\n",
+                   line_p, expected);
+            mpl_param_list_destroy(&resp_p);
+            goto out;
+        }
+        mpl_param_list_destroy(&resp_p);
+        expected++;
+    }
+    if (expected != num)
+    {
+        printf("Got %d responses, expected %d\n", expected, num);
+        goto out;
+    }
+    res = 0;
+ out:
+    free(buf);
+    return res;
+}
+
+static int tc_server(void)
+{
+    mpl_server_options_t options = { 4, 8 };
+    mpl_server_t *server_p;
+    pthread_t thread;
+    struct sockaddr_in addr;
+    int fds[2];
+    int fd;
+    int port;
+
+    /* A connection on a socket pair, the server returns when it ends */
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0)
+        return -1;
+    server_p = mpl_server_create(&options, tc_server_handler, NULL);
+    if ((NULL == server_p) ||
+        (mpl_server_add_connection(server_p, fds[0], fds[0]) < 0) ||
+        (pthread_create(&thread, NULL, tc_server_thread, server_p) != 0))
+    {
+        printf("Server setup failed\n");
+        mpl_server_destroy(server_p);
+        close(fds[1]);
+        return -1;
+    }
+    if (tc_server_pipeline(fds[1], 1000) < 0)
+    {
+        mpl_server_stop(server_p);
+        pthread_join(thread, NULL);
+        mpl_server_destroy(server_p);
+        close(fds[1]);
+        return -1;
+    }
+    pthread_join(thread, NULL);
+    close(fds[1]);
+
+    /* TCP on localhost, runs until stopped */
+    port = mpl_server_listen_tcp(server_p, 0);
+    if ((port <= 0) ||
+        (pthread_create(&thread, NULL, tc_server_thread, server_p) != 0))
+    {
+        printf("TCP listen failed\n");
+        mpl_server_destroy(server_p);
+        return -1;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    if ((fd < 0) ||
+        (connect(fd, (struct sockaddr*) &addr, sizeof(addr)) < 0) ||
+        (tc_server_pipeline(fd, 100) < 0))
+    {
+        printf("TCP connection failed\n");
+        if (fd >= 0)
+            close(fd);
+        mpl_server_stop(server_p);
+        pthread_join(thread, NULL);
+        mpl_server_destroy(server_p);
+        return -1;
+    }
+    close(fd);
+    mpl_server_stop(server_p);
+    pthread_join(thread, NULL);
+    mpl_server_destroy(server_p);
+    return 0;
+}
+
+static mpl_list_t *tc_client_mycommand2(mpl_bag_t *reqParams, void *ctx_p)
+{
+    mpl_list_t *respMsg = NULL;
+    mpl_bag_t *respParams = NULL;
+
+    TST_ADD_mycommand2_resp_i(&respParams,
+                              atoi(TST_GET_mycommand2_cmd_s_PTR(reqParams)));
+    mpl_add_param_to_list(&respMsg,
+                          TESTCAT_COMMAND_ID_TO_RESPONSE_ID(TST_PARAM_ID(mycommand2_cmd)),
+                          respParams);
+    mpl_param_list_destroy(&respParams);
+    return respMsg;
+}
+
+/* Answers mycommand2 only, like a server dropping some requests */
+static mpl_list_t *tc_client_server_handler(void *ctx_p,
+                                            mpl_list_t *req_p,
+                                            bool has_error)
+{
+    static const testcat_handlers_t handlers = {
+        .mycommand2 = tc_client_mycommand2
+    };
+
+    if (has_error || (NULL == req_p))
+        return NULL;
+    return testcat_dispatch(&handlers, req_p, NULL);
+}
+
+#define TC_CLIENT_NUM 1000
+
+typedef struct
+{
+    int result[TC_CLIENT_NUM + 4];      /* By request id */
+    int responses;
+    int events;
+    testcat_client_handlers_t handlers;
+} tc_client_state_t;
+
+static void tc_client_response(void *ctx_p,
+                               uint32_t request_id,
+                               mpl_list_t *resp_p)
+{
+    tc_client_state_t *state_p = ctx_p;
+
+    state_p->responses++;
+    if (request_id >= (sizeof(state_p->result) / sizeof(int)))
+        return;
+    if (NULL == resp_p)
+        state_p->result[request_id] = -1;
+    else if (TESTCAT_IS_RESPONSE(resp_p) &&
+             (TESTCAT_GET_RESPONSE_ID(resp_p) == TST_PARAM_ID(mycommand2_resp)))
+        state_p->result[request_id] =
+            TST_GET_mycommand2_resp_i(TESTCAT_GET_RESPONSE_PARAMS_PTR(resp_p));
+    else
+        state_p->result[request_id] = -2;
+    mpl_param_list_destroy(&resp_p);
+}
+
+static void tc_client_mycommand2_response(void *ctx_p,
+                                          uint32_t request_id,
+                                          bool answered,
+                                          mpl_bag_t *respParams)
+{
+    tc_client_state_t *state_p = ctx_p;
+
+    state_p->responses++;
+    if (request_id >= (sizeof(state_p->result) / sizeof(int)))
+        return;
+    state_p->result[request_id] =
+        answered ? TST_GET_mycommand2_resp_i(respParams) : -1;
+}
+
+static void tc_client_event(void *ctx_p, mpl_list_t *evt_p)
+{
+    tc_client_state_t *state_p = ctx_p;
+
+    if (TESTCAT_IS_EVENT(evt_p))
+        state_p->events++;
+    mpl_param_list_destroy(&evt_p);
+}
+
+static int tc_client_send(mpl_client_t *client_p,
+                          tc_client_state_t *state_p,
+                          int n,
+                          uint32_t *request_id_p)
+{
+    char str[64];
+    mpl_list_t *req_p;
+    mpl_bag_t *reqParams = NULL;
+    int ret;
+
+    /* Every tenth request is not answered by the server */
+    if ((n % 10) == 0)
+    {
+        sprintf(str, "test.mycommand_cmd={myint=%d}", n);
+        req_p = mpl_param_list_unpack(str);
+        if (NULL == req_p)
+            return -1;
+        ret = mpl_client_send(client_p, req_p, tc_client_response, state_p,
+                              request_id_p);
+        mpl_param_list_destroy(&req_p);
+        return ret;
+    }
+
+    /* The others through the generated send function */
+    state_p->handlers.ctx_p = state_p;
+    state_p->handlers.mycommand2 = tc_client_mycommand2_response;
+    sprintf(str, "%05d", n); /* min 5 */
+    TST_ADD_mycommand2_cmd_s(&reqParams, str);
+    ret = testcat_client_send_mycommand2(client_p, reqParams,
+                                         &state_p->handlers, request_id_p);
+    mpl_param_list_destroy(&reqParams);
+    return ret;
+}
+
+static int tc_client(void)
+{
+    mpl_server_options_t server_options = { 4, 16 };
+    mpl_client_options_t options = { 4096, 500, 64 };
+    tc_client_state_t *state_p;
+    mpl_server_t *server_p = NULL;
+    mpl_client_t *client_p = NULL;
+    pthread_t thread;
+    bool thread_started = false;
+    uint32_t request_id;
+    uint32_t ids[3];
+    char buf[256];
+    int newlines;
+    int fds[2] = { -1, -1 };
+    int i;
+    ssize_t n;
+
+    state_p = calloc(1, sizeof(tc_client_state_t));
+    if (NULL == state_p)
+        return -1;
+
+    /* Pipelined requests to a server */
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0)
+        goto error_return;
+    server_p = mpl_server_create(&server_options, tc_client_server_handler, NULL);
+    if ((NULL == server_p) ||
+        (mpl_server_add_connection(server_p, fds[0], fds[0]) < 0) ||
+        (pthread_create(&thread, NULL, tc_server_thread, server_p) != 0))
+    {
+        printf("Server setup failed\n");
+        goto error_return;
+    }
+    fds[0] = -1;
+    thread_started = true;
+    client_p = mpl_client_create(&options,
+                                 &testcat_client_protocol,
+                                 fds[1],
+                                 fds[1],
+                                 tc_client_event,
+                                 state_p);
+    if (NULL == client_p)
+        goto error_return;
+    for (i = 0; i < TC_CLIENT_NUM; i++)
+    {
+        if (tc_client_send(client_p, state_p, i, &request_id) < 0)
+        {
+            printf("Send %d failed\n", i);
+            goto error_return;
+        }
+        if (mpl_client_in_flight(client_p) > options.max_in_flight)
+        {
+            printf("More than max_in_flight requests\n");
+            goto error_return;
+        }
+    }
+    if ((mpl_client_wait(client_p, request_id, 10000) < 0) ||
+        (mpl_client_in_flight(client_p) != 0) ||
+        (state_p->responses != TC_CLIENT_NUM))
+    {
+        printf("Waiting for the responses failed\n");
+        goto error_return;
+    }
+    /* Request ids start at 1 */
+    for (i = 0; i < TC_CLIENT_NUM; i++)
+    {
+        if (state_p->result[i + 1] != (((i % 10) == 0) ? -1 : i))
+        {
+            printf("Wrong response to request %d: %d\n",
+                   i, state_p->result[i + 1]);
+            goto error_return;
+        }
+    }
+    mpl_client_destroy(client_p);
+    client_p = NULL;
+    close(fds[1]);
+    fds[1] = -1;
+    pthread_join(thread, NULL);
+    thread_started = false;
+    mpl_server_destroy(server_p);
+    server_p = NULL;
+
+    /* Events, and requests left unanswered when the connection closes */
+    memset(state_p, 0, sizeof(*state_p));
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0)
+        goto error_return;
+    client_p = mpl_client_create(NULL,
+                                 &testcat_client_protocol,
+                                 fds[0],
+                                 fds[0],
+                                 tc_client_event,
+                                 state_p);
+    if ((NULL == client_p) ||
+        (tc_client_send(client_p, state_p, 0, &ids[0]) < 0) ||
+        (tc_client_send(client_p, state_p, 2, &ids[1]) < 0) ||
+        (tc_client_send(client_p, state_p, 3, &ids[2]) < 0) ||
+        (mpl_client_flush(client_p) < 0))
+    {
+        printf("Sending failed\n");
+        goto error_return;
+    }
+    newlines = 0;
+    while (newlines < 3)
+    {
+        n = read(fds[1], buf, sizeof(buf));
+        if (n <= 0)
+            goto error_return;
+        for (i = 0; i < n; i++)
+        {
+            if ('\n' == buf[i])
+                newlines++;
+        }
+    }
+    strcpy(buf,
+           "test.myevent_evt={i1=1,i2=2}\n"
+           "test.mycommand2_resp={i=2}\n");
+    if (write(fds[1], buf, strlen(buf)) != (ssize_t) strlen(buf))
+        goto error_return;
+    close(fds[1]);
+    fds[1] = -1;
+    while (mpl_client_poll(client_p, 1000) >= 0)
+        ;
+    if ((state_p->events != 1) ||
+        (state_p->result[ids[0]] != -1) ||
+        (state_p->result[ids[1]] != 2) ||
+        (state_p->result[ids[2]] != -1) ||
+        (mpl_client_in_flight(client_p) != 0))
+    {
+        printf("Unexpected event or response handling\n");
+        goto error_return;
+    }
+    mpl_client_destroy(client_p);
+    close(fds[0]);
+    free(state_p);
+    return 0;
+
+ error_return:
+    mpl_client_destroy(client_p);
+    if (fds[1] >= 0)
+        close(fds[1]);
+    if (thread_started)
+    {
+        mpl_server_stop(server_p);
+        pthread_join(thread, NULL);
+    }
+    else if (fds[0] >= 0)
+        close(fds[0]);
+    mpl_server_destroy(server_p);
+    free(state_p);
+    return -1;
+}
+
+/* Reference encoding, as the array pack functions wrote it with
+   snprintf() per element */
+static void tc_hex_reference(const void *arr_p, int num, int width, char *buf)
+{
+    int i;
+
+    buf[0] = '\0';
+    for (i = 0; i < num; i++)
+    {
+        if (1 == width)
+            buf += sprintf(buf, "%02x", ((const uint8_t*) arr_p)[i]);
+        else if (2 == width)
+            buf += sprintf(buf, "%04x", ((const uint16_t*) arr_p)[i]);
+        else
+            buf += sprintf(buf, "%08" PRIx32, ((const uint32_t*) arr_p)[i]);
+    }
+}
+
+static int tc_hex_codec(void)
+{
+    static const int lengths[] = { 0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 65,
+                                   127, 128, 129, 300, 1000 };
+    uint8_t *in_p = NULL;
+    uint8_t *out_p = NULL;
+    char *ref_p = NULL;
+    char *enc_p = NULL;
+    size_t li;
+    int width;
+    int num;
+    int i;
+    int res;
+
+    in_p = malloc(1000 * 4);
+    out_p = malloc(1000 * 4);
+    ref_p = malloc(1000 * 8 + 1);
+    enc_p = malloc(1000 * 8 + 1);
+    if ((NULL == in_p) || (NULL == out_p) || (NULL == ref_p) || (NULL == enc_p))
+        goto error_return;
+    for (i = 0; i < 1000 * 4; i++)
+        in_p[i] = (uint8_t) (i * 167 + 13);
+
+    for (li = 0; li < sizeof(lengths) / sizeof(lengths[0]); li++)
+    {
+        for (width = 1; width <= 4; width *= 2)
+        {
+            num = lengths[li];
+            tc_hex_reference(in_p, num, width, ref_p);
+            if (1 == width)
+                mpl_hex_encode_uint8(in_p, num, enc_p);
+            else if (2 == width)
+                mpl_hex_encode_uint16((uint16_t*) in_p, num, enc_p);
+            else
+                mpl_hex_encode_uint32((uint32_t*) in_p, num, enc_p);
+            enc_p[num * 2 * width] = '\0';
+            if (strcmp(enc_p, ref_p))
+            {
+                printf("Encoding %d elements of width %d failed\n", num, width);
+                goto error_return;
+            }
+
+            /* Upper case decodes the same */
+            for (i = 0; i < num * 2 * width; i += 3)
+                enc_p[i] = toupper((unsigned char) enc_p[i]);
+            memset(out_p, 0, 1000 * 4);
+            if (1 == width)
+                res = mpl_hex_decode_uint8(enc_p, num, out_p);
+            else if (2 == width)
+                res = mpl_hex_decode_uint16(enc_p, num, (uint16_t*) out_p);
+            else
+                res = mpl_hex_decode_uint32(enc_p, num, (uint32_t*) out_p);
+            if ((res < 0) || memcmp(in_p, out_p, num * width))
+            {
+                printf("Decoding %d elements of width %d failed\n", num, width);
+                goto error_return;
+            }
+
+            /* A bad character anywhere fails */
+            for (i = 0; i < num * 2 * width; i += 7)
+            {
+                char c = enc_p[i];
+
+                enc_p[i] = (i & 1) ? 'g' : ((i & 2) ? ':' : '@');
+                if (1 == width)
+                    res = mpl_hex_decode_uint8(enc_p, num, out_p);
+                else if (2 == width)
+                    res = mpl_hex_decode_uint16(enc_p, num, (uint16_t*) out_p);
+                else
+                    res = mpl_hex_decode_uint32(enc_p, num, (uint32_t*) out_p);
+                enc_p[i] = c;
+                if (res >= 0)
+                {
+                    printf("Bad character at %d was decoded\n", i);
+                    goto error_return;
+                }
+            }
+        }
+    }
+
+    free(in_p);
+    free(out_p);
+    free(ref_p);
+    free(enc_p);
+    return 0;
+
+ error_return:
+    free(in_p);
+    free(out_p);
+    free(ref_p);
+    free(enc_p);
+    return -1;
+}
+
+static int tc_hex_array(void)
+{
+    mpl_hex_impl_t best = mpl_hex_get_impl();
+    mpl_hex_impl_t impl;
+    mpl_param_element_t *param_p = NULL;
+    mpl_param_element_t *unpacked_p = NULL;
+    uint16_t arr16[3] = { 0x1234, 0xabcd, 0x0001 };
+    uint8_t arr8[3] = { 0x00, 0x7f, 0xff };
+    char buf[64];
+    int tested = 0;
+    int len;
+
+    /* Every implementation there is gives the snprintf() result */
+    for (impl = mpl_hex_impl_scalar; impl <= mpl_hex_impl_avx2; impl++)
+    {
+        if (mpl_hex_set_impl(impl) < 0)
+            continue;
+        tested++;
+        if (tc_hex_codec() < 0)
+        {
+            printf("Implementation %d failed\n", impl);
+            goto error_return;
+        }
+    }
+    if ((tested < 1) || (mpl_hex_set_impl(best) < 0))
+        goto error_return;
+    printf("%d hex implementations tested, using %d\n", tested, best);
+
+    /* The parameter text is unchanged, also when truncated */
+    param_p = mpl_param_element_create_uint16_array(test_paramid_myuint16_arr,
+                                                    arr16, 3);
+    if (NULL == param_p)
+        goto error_return;
+    len = mpl_param_pack(param_p, buf, sizeof(buf));
+    if ((len != (int) strlen("test.myuint16_arr=000000031234abcd0001")) ||
+        strcmp(buf, "test.myuint16_arr=000000031234abcd0001"))
+    {
+        printf("Packed uint16 array: %s\n", buf);
+        goto error_return;
+    }
+    if ((mpl_param_pack(param_p, buf, len - 1) != len) ||
+        strcmp(buf, "test.myuint16_arr=000000031234abcd"))
+    {
+        printf("Truncated uint16 array: %s\n", buf);
+        goto error_return;
+    }
+    mpl_param_element_destroy(param_p);
+    param_p = mpl_param_element_create_uint8_array(test_paramid_myuint8_arr,
+                                                   arr8, 3);
+    if ((NULL == param_p) ||
+        (mpl_param_pack(param_p, buf, sizeof(buf)) < 0) ||
+        strcmp(buf, "test.myuint8_arr=00000003007fff"))
+    {
+        printf("Packed uint8 array: %s\n", buf);
+        goto error_return;
+    }
+
+    if ((mpl_param_unpack("test.myuint8_arr", "00000003007FfF", &unpacked_p) < 0) ||
+        (0 != mpl_param_element_compare(param_p, unpacked_p)))
+    {
+        printf("Unpacking uint8 array failed\n");
+        goto error_return;
+    }
+    mpl_param_element_destroy(unpacked_p);
+    unpacked_p = NULL;
+
+    /* Missing or bad digits */
+    if ((mpl_param_unpack("test.myuint8_arr", "00000003007f", &unpacked_p) >= 0) ||
+        (mpl_param_unpack("test.myuint8_arr", "00000003007fxf", &unpacked_p) >= 0) ||
+        (mpl_param_unpack("test.myuint32_arr", "000000020000000", &unpacked_p) >= 0) ||
+        (mpl_param_unpack("test.myuint16_arr", "00000001", &unpacked_p) >= 0))
+    {
+        printf("Unpacking bad array succeeded\n");
+        goto error_return;
+    }
+
+    mpl_param_element_destroy(param_p);
+    return 0;
+
+ error_return:
+    (void) mpl_hex_set_impl(best);
+    mpl_param_element_destroy(param_p);
+    mpl_param_element_destroy(unpacked_p);
+    return -1;
+}
+
+static int tc_integer_codec(void)
+{
+    static const int64_t sint64_values[] =
+        { 0, -1, 1, 9, 10, 99, 100, -100, 12345678, INT64_MAX, INT64_MIN };
+    static const uint64_t uint64_values[] =
+        { 0, 1, 0xf, 0x10, 0xdeadbeef, UINT64_MAX };
+    static const struct
+    {
+        int value;
+        int range_id;
+    } ranges[] =
+        {
+            { -1001, -1 }, { -1000, 0 }, { -500, 0 }, { -499, -1 },
+            { -101, -1 }, { -100, 2 }, { -90, 2 }, { -89, -1 },
+            { -1, -1 }, { 0, 0 }, { 7, 0 }, { 13, 0 }, { 60, 0 }, { 61, -1 },
+            { 69, -1 }, { 70, 1 }, { 80, 1 }, { 81, -1 }, { 105, 2 },
+            { 199, -1 }, { 210, 0 }, { 311, -1 }, { 410, 0 }, { INT_MAX, -1 }
+        };
+    static const char *enum_names[] =
+        { "val1", "val2", "val8", "val11", "val12", "val13", "val_last" };
+    mpl_param_element_t *param_p = NULL;
+    char buf[64];
+    char expected[64];
+    uint64_t u;
+    int64_t i;
+    int val;
+    int len;
+    int n;
+
+    /* Packing gives the snprintf() result, also when truncated */
+    for (n = 0; n < (int)(sizeof(sint64_values) / sizeof(sint64_values[0])); n++)
+    {
+        i = sint64_values[n];
+        param_p = mpl_param_element_create(test_paramid_mysint64_2, &i);
+        if (NULL == param_p)
+            goto error_return;
+        len = snprintf(expected, sizeof(expected), "test.mysint64_2=%" PRIi64, i);
+        if ((mpl_param_pack(param_p, buf, sizeof(buf)) != len) ||
+            strcmp(buf, expected) ||
+            (mpl_param_pack(param_p, buf, len - 2) != len) ||
+            strncmp(buf, expected, len - 3) ||
+            (strlen(buf) != (size_t)(len - 3)))
+        {
+            printf("Packed sint64 %s, expected %s\n", buf, expected);
+            goto error_return;
+        }
+        mpl_param_element_destroy(param_p);
+        param_p = NULL;
+    }
+    for (n = 0; n < (int)(sizeof(uint64_values) / sizeof(uint64_values[0])); n++)
+    {
+        u = uint64_values[n];
+        param_p = mpl_param_element_create(test_paramid_myuint64_2, &u);
+        if (NULL == param_p)
+            goto error_return;
+        len = snprintf(expected, sizeof(expected), "test.myuint64_2=0x%" PRIx64, u);
+        if ((mpl_param_pack(param_p, buf, sizeof(buf)) != len) ||
+            strcmp(buf, expected))
+        {
+            printf("Packed uint64 %s, expected %s\n", buf, expected);
+            goto error_return;
+        }
+        mpl_param_element_destroy(param_p);
+        param_p = NULL;
+    }
+
+    /* Unpacking: hex, octal only where C syntax is used, overflow */
+    if ((mpl_param_unpack("test.mysint64_2", "-9223372036854775808", &param_p) < 0) ||
+        (*(int64_t*)param_p->value_p != INT64_MIN))
+        goto error_return;
+    mpl_param_element_destroy(param_p);
+    param_p = NULL;
+    if ((mpl_param_unpack("test.myuint64_2", "0XFFFFFFFFFFFFFFFF", &param_p) < 0) ||
+        (*(uint64_t*)param_p->value_p != UINT64_MAX))
+        goto error_return;
+    mpl_param_element_destroy(param_p);
+    param_p = NULL;
+    if ((mpl_param_unpack("test.myint2", " 010", &param_p) < 0) ||
+        (*(int*)param_p->value_p != 8))
+        goto error_return;
+    mpl_param_element_destroy(param_p);
+    param_p = NULL;
+    if ((mpl_param_unpack("test.myuint16_2", "010", &param_p) < 0) ||
+        (*(uint16_t*)param_p->value_p != 10))
+        goto error_return;
+    mpl_param_element_destroy(param_p);
+    param_p = NULL;
+    if ((mpl_param_unpack("test.mysint16_2", "-0x7fff", &param_p) < 0) ||
+        (*(sint16_t*)param_p->value_p != -0x7fff))
+        goto error_return;
+    mpl_param_element_destroy(param_p);
+    param_p = NULL;
+
+    /* Truncated to an int, as before, and empty values of the types read
+       without convert_int() are 0 */
+    if ((mpl_param_unpack("test.mysint32_2", "0x80000000", &param_p) < 0) ||
+        (*(sint32_t*)param_p->value_p != INT32_MIN))
+        goto error_return;
+    mpl_param_element_destroy(param_p);
+    param_p = NULL;
+    if ((mpl_param_unpack("test.myint2", "2147483648", &param_p) < 0) ||
+        (*(int*)param_p->value_p != INT_MIN))
+        goto error_return;
+    mpl_param_element_destroy(param_p);
+    param_p = NULL;
+    if ((mpl_param_unpack("test.myuint32_2", "", &param_p) < 0) ||
+        (*(uint32_t*)param_p->value_p != 0))
+        goto error_return;
+    mpl_param_element_destroy(param_p);
+    param_p = NULL;
+    if ((mpl_param_unpack("test.mysint64_2", "", &param_p) < 0) ||
+        (*(int64_t*)param_p->value_p != 0))
+        goto error_return;
+    mpl_param_element_destroy(param_p);
+    param_p = NULL;
+
+    if ((mpl_param_unpack("test.mysint64_2", "9223372036854775808", &param_p) >= 0) ||
+        (mpl_param_unpack("test.myuint64_2", "18446744073709551616", &param_p) >= 0) ||
+        (mpl_param_unpack("test.myuint64_2", "0x10000000000000000", &param_p) >= 0) ||
+        (mpl_param_unpack("test.myint2", "9223372036854775808", &param_p) >= 0) ||
+        (mpl_param_unpack("test.myint2", "", &param_p) >= 0) ||
+        (mpl_param_unpack("test.myint2", "0x", &param_p) >= 0) ||
+        (mpl_param_unpack("test.myint2", "08", &param_p) >= 0) ||
+        (mpl_param_unpack("test.myint2", "-", &param_p) >= 0) ||
+        (mpl_param_unpack("test.myuint32_2", "12 ", &param_p) >= 0))
+    {
+        printf("Unpacking bad integer succeeded\n");
+        goto error_return;
+    }
+
+    /* Range ids from the range intervals, also where ranges overlap */
+    for (n = 0; n < (int)(sizeof(ranges) / sizeof(ranges[0])); n++)
+    {
+        val = ranges[n].value;
+        if (mpl_param_value_get_range_id(test_paramid_my_ranged_int5, &val) !=
+            ranges[n].range_id)
+        {
+            printf("Range id of %d is not %d\n", val, ranges[n].range_id);
+            goto error_return;
+        }
+    }
+
+    /* Enum values to names, through the enum index */
+    for (n = 0; n < (int)(sizeof(enum_names) / sizeof(enum_names[0])); n++)
+    {
+        snprintf(expected, sizeof(expected), "test.my_enum6=%s", enum_names[n]);
+        if ((mpl_param_unpack("test.my_enum6", enum_names[n], &param_p) < 0) ||
+            (mpl_param_pack(param_p, buf, sizeof(buf)) < 0) ||
+            strcmp(buf, expected))
+        {
+            printf("Packed enum %s, expected %s\n", buf, expected);
+            goto error_return;
+        }
+        mpl_param_element_destroy(param_p);
+        param_p = NULL;
+    }
+    if ((mpl_param_unpack("test.my_enum6", "10", &param_p) < 0) ||
+        (mpl_param_pack(param_p, buf, sizeof(buf)) < 0) ||
+        strcmp(buf, "test.my_enum6=val8"))
+        goto error_return;
+    mpl_param_element_destroy(param_p);
+    param_p = NULL;
+    if (mpl_param_unpack("test.my_enum6", "1000", &param_p) >= 0)
+        goto error_return;
+
+    return 0;
+
+ error_return:
+    mpl_param_element_destroy(param_p);
+    return -1;
+}
+
+static int tc_packed_size(void)
+{
+    static const char *messages[] =
+        {
+            "test.mywstring=00000004000000610000002c0000005c00000000,"
+            "test.myint=-12,test.mysint8=-128,test.mysint16=300,"
+            "test.mysint32_2=-2147483648,"
+            "test.mysint64_2=-9223372036854775808,"
+            "test.myuint8=0x3f,test.myuint16_2=0xffff,test.myuint32_2=0x0,"
+            "test.myuint64_2=0xffffffffffffffff,"
+            "test.my_enum6=val8,test.my_enum8=smallval1,"
+            "test.my_enum16_2=maxval,test.my_enum32=val1,"
+            "test.my_senum8_2=minval,test.my_senum16=val1,"
+            "test.my_senum32=val2,test.mybool=false,test.mybool8=true",
+            "test.myuint8_arr=00000003010203,test.myuint16_arr=00000000,"
+            "test.myuint32_arr=00000001deadbeef,"
+            "test.mystring_tup=k\\,ey:va\\\\l,test.mystring_tup2=key:,"
+            "test.myint_tup=-11:22,test.mystrint_tup=a\\,b:-33,"
+            "test.mystruint8_tup=a\\\\b/33",
+            "test.mystring[2]=ab\\,c\\\\de,test.mystring=:2\n2:,"
+            "test.mystring[3]=\\\\ab\\,c",
+            "test.mycommand2_resp={result=ok,i=3,e(my_enum3)=val4},"
+            "test.mynewbag={i1=1,i2=2,s[1]=x\\,y\\\\z,"
+            "b=true},test.mylist1={test.mylist1={test.myint=1}}"
+        };
+    static const char delimiters[] = { ',', '\n', ':', '2' };
+    mpl_pack_options_t options;
+    mpl_param_element_t *param_p = NULL;
+    mpl_param_element_t *first_p;
+    mpl_list_t *list_p = NULL;
+    void *addr = &options;
+    char buf[32];
+    char *copy_p = NULL;
+    char *buf_p = NULL;
+    size_t alloc_len;
+    int size;
+    int len;
+    int m;
+    int d;
+    int mode;
+
+    for (m = 0; m < (int)(sizeof(messages) / sizeof(messages[0])); m++)
+    {
+        copy_p = strdup(messages[m]);
+        if (NULL == copy_p)
+            goto error_return;
+        list_p = mpl_param_list_unpack_param_set(copy_p, TEST_PARAM_SET_ID);
+        free(copy_p);
+        copy_p = NULL;
+        if (NULL == list_p)
+        {
+            printf("Unpacking message %d failed\n", m);
+            goto error_return;
+        }
+
+        /* A parameter without value, and one that is packed as a pointer */
+        param_p = mpl_param_element_create_empty(test_paramid_myint);
+        if (NULL == param_p)
+            goto error_return;
+        mpl_list_add(&list_p, &param_p->list_entry);
+        param_p = mpl_param_element_create(test_paramid_myaddr, &addr);
+        if (NULL == param_p)
+            goto error_return;
+        mpl_list_add(&list_p, &param_p->list_entry);
+        param_p = NULL;
+
+        /* The size is what packing returns, with all kinds of options */
+        for (d = 0; d < (int)sizeof(delimiters); d++)
+        {
+            for (mode = 0; mode < 3; mode++)
+            {
+                options = (mpl_pack_options_t)MPL_PACK_OPTIONS_DEFAULT;
+                options.message_delimiter = delimiters[d];
+                options.no_prefix = (mode == 1);
+                options.force_field_pack_mode = (mode == 2);
+
+                size = mpl_param_list_packed_size_extended(list_p, &options);
+                len = mpl_param_list_pack_extended(list_p, NULL, 0, &options);
+                buf_p = mpl_param_list_pack_alloc(list_p, &options, &alloc_len);
+                if ((size < 0) || (size != len) || (NULL == buf_p) ||
+                    (alloc_len != (size_t)size) ||
+                    (strlen(buf_p) != (size_t)size))
+                {
+                    printf("Message %d, delimiter %d, mode %d: "
+                           "packed size %d, packed length %d: %s\n",
+                           m, delimiters[d], mode, size, len,
+                           buf_p ? buf_p : "(null)");
+                    goto error_return;
+                }
+                free(buf_p);
+                buf_p = NULL;
+            }
+        }
+
+        if (mpl_param_list_packed_size(list_p) !=
+            mpl_param_list_pack(list_p, NULL, 0))
+            goto error_return;
+        first_p = MPL_LIST_CONTAINER(list_p, mpl_param_element_t, list_entry);
+        if (mpl_param_packed_size(first_p) != mpl_param_pack(first_p, NULL, 0))
+            goto error_return;
+
+        mpl_param_list_destroy(&list_p);
+    }
+
+    /* Truncating at any point leaves a terminated prefix of the output */
+    copy_p = strdup("test.mystring=a\\,\\\\bcd");
+    if (NULL == copy_p)
+        goto error_return;
+    list_p = mpl_param_list_unpack_param_set(copy_p, TEST_PARAM_SET_ID);
+    if (NULL == list_p)
+        goto error_return;
+    buf_p = mpl_param_list_pack_alloc(list_p, NULL, NULL);
+    if ((NULL == buf_p) || strcmp(buf_p, "test.mystring=a\\,\\\\bcd"))
+        goto error_return;
+    size = (int)strlen(buf_p);
+    for (len = 1; len <= size; len++)
+    {
+        if ((mpl_param_list_pack(list_p, buf, len) != size) ||
+            (strlen(buf) >= (size_t)len) ||
+            strncmp(buf, buf_p, strlen(buf)))
+        {
+            printf("Packed %s into %d bytes\n", buf, len);
+            goto error_return;
+        }
+    }
+    free(buf_p);
+    free(copy_p);
+    mpl_param_list_destroy(&list_p);
+    return 0;
+
+ error_return:
+    free(buf_p);
+    free(copy_p);
+    mpl_param_element_destroy(param_p);
+    mpl_param_list_destroy(&list_p);
+    return -1;
+}
+
+static int tc_bag_pack_nested(void)
+{
+    const int depth = 12;
+    mpl_list_t *list_p = NULL;
+    char *expected_p = NULL;
+    char *copy_p = NULL;
+    char *packed_p = NULL;
+    char *buf_p = NULL;
+    size_t len = 0;
+    size_t size;
+    int n;
+    int i;
+
+    /*
+     * Bags of bags, with a parameter and an escaped string at each level.
+     * Unpacking reverses the order, so the input is written reversed.
+     */
+    expected_p = malloc(depth * 64 + 64);
+    copy_p = malloc(depth * 64 + 64);
+    buf_p = malloc(depth * 64 + 64);
+    if ((NULL == expected_p) || (NULL == copy_p) || (NULL == buf_p))
+        goto error_return;
+    strcpy(expected_p, "test.mybool=true");
+    strcpy(copy_p, "test.mybool=true");
+    for (i = depth - 1; i >= 0; i--)
+    {
+        sprintf(buf_p,
+                "test.mylist1={test.myint=%d,test.mystring=l\\,evel\\\\%d,%s}",
+                i, i, expected_p);
+        strcpy(expected_p, buf_p);
+        sprintf(buf_p,
+                "test.mylist1={%s,test.mystring=l\\,evel\\\\%d,test.myint=%d}",
+                copy_p, i, i);
+        strcpy(copy_p, buf_p);
+    }
+    len = strlen(expected_p);
+    free(buf_p);
+    buf_p = NULL;
+    list_p = mpl_param_list_unpack_param_set(copy_p, TEST_PARAM_SET_ID);
+    if (NULL == list_p)
+        goto error_return;
+
+    /* Packed the same as it was written */
+    packed_p = mpl_param_list_pack_alloc(list_p, NULL, &size);
+    if ((NULL == packed_p) || (size != len) || strcmp(packed_p, expected_p))
+    {
+        printf("Packed %s\nexpected %s\n", packed_p ? packed_p : "(null)",
+               expected_p);
+        goto error_return;
+    }
+
+    /*
+     * Truncated at any length, a terminated prefix (one shorter where an
+     * escape would be split) and the full length
+     */
+    buf_p = malloc(len + 1);
+    if (NULL == buf_p)
+        goto error_return;
+    for (size = 1; size <= len + 1; size++)
+    {
+        memset(buf_p, 'x', len + 1);
+        n = mpl_param_list_pack(list_p, buf_p, (int)size);
+        if ((n != (int)len) ||
+            (strlen(buf_p) >= size) ||
+            (strlen(buf_p) + 2 < size) ||
+            strncmp(buf_p, expected_p, strlen(buf_p)))
+        {
+            printf("Packed %d into %zu bytes: %s\n", n, size, buf_p);
+            goto error_return;
+        }
+    }
+
+    free(buf_p);
+    free(packed_p);
+    free(copy_p);
+    free(expected_p);
+    mpl_param_list_destroy(&list_p);
+    return 0;
+
+ error_return:
+    free(buf_p);
+    free(packed_p);
+    free(copy_p);
+    free(expected_p);
+    mpl_param_list_destroy(&list_p);
+    return -1;
+}
+
+static int tc_bag_unpack_nested(void)
+{
+    const int depth = 500;
+    static const char *bad[] =
+        {
+            "test.mylist1={test.myint=1",
+            "test.mylist1={test.mylist1={test.myint=1}",
+            "test.mylist1={test.myint=x}",
+            "test.mylist2={test.myint=1}",
+            "test.mylist1={test.mystring=hello{world,test.myint=5}",
+            "test.mylist1={test.mystring=hello{world,test.myint}",
+            "test.mylist1={test.myint=5}garbage",
+            "test.mylist1={test.mylist1={test.myint=5}xx}",
+            "test.mylist1={test.mystring=ab\\}cde}",
+            "test.mylist1={test.mystring=ab\\{cde}"
+        };
+    /*
+     * Braces in strings, with the string expected in the innermost bag
+     * and the list packed again (in unpacked order)
+     */
+    static const struct
+    {
+        const char *msg_p;
+        const char *string_p;
+        int num_params;
+        const char *packed_p;
+    } braced[] =
+        {
+            { "test.mylist1={test.mylist1={test.mystring=xx{yy}zz}}",
+              "xx{yy}zz", 1,
+              "test.mylist1={test.mylist1={test.mystring=xx{yy}zz}}" },
+            { "test.mylist1={test.mystring=hello{wo}rld,test.myint=5}",
+              "hello{wo}rld", 2,
+              "test.mylist1={test.myint=5,test.mystring=hello{wo}rld}" },
+            { "test.mylist1={test.mystring={{a}b{c}}}", "{{a}b{c}}", 1,
+              "test.mylist1={test.mystring={{a}b{c}}}" },
+            { "test.mylist1={test.mystring=a\\,b{c}\\\\d}", "a,b{c}\\d", 1,
+              "test.mylist1={test.mystring=a\\,b{c}\\\\d}" },
+        };
+    char spaced[] =
+        " test.mylist1 = { ,test.myint = 1 ,, test.mystring = ab\\,c\\=d\\  , } ,";
+    char views[] = "test.mylist1={test.mylist1={test.mystring=hello}}";
+    mpl_list_t *list_p = NULL;
+    mpl_param_element_t *elem_p;
+    mpl_param_element_t *string_p;
+    char *msg_p = NULL;
+    char *packed_p = NULL;
+    bool has_error = false;
+    size_t len = 0;
+    int n;
+    int i;
+
+    /* Deep nesting, unpacked and packed again */
+    msg_p = malloc(depth * 16 + 32);
+    if (NULL == msg_p)
+        goto error_return;
+    for (i = 0; i < depth; i++)
+        len += sprintf(msg_p + len, "test.mylist1={");
+    len += sprintf(msg_p + len, "test.myint=7");
+    for (i = 0; i < depth; i++)
+        msg_p[len++] = '}';
+    msg_p[len] = '\0';
+
+    list_p = mpl_param_list_unpack(msg_p);
+    if (NULL == list_p)
+        goto error_return;
+    elem_p = MPL_LIST_CONTAINER(list_p, mpl_param_element_t, list_entry);
+    for (i = 0; i < depth; i++)
+    {
+        if ((elem_p->id != test_paramid_mylist1) || (NULL == elem_p->value_p))
+        {
+            printf("Level %d not unpacked\n", i);
+            goto error_return;
+        }
+        elem_p = MPL_LIST_CONTAINER(elem_p->value_p, mpl_param_element_t, list_entry);
+    }
+    if ((elem_p->id != test_paramid_myint) || (*(int*)elem_p->value_p != 7))
+        goto error_return;
+    packed_p = mpl_param_list_pack_alloc(list_p, NULL, NULL);
+    if ((NULL == packed_p) || strcmp(packed_p, msg_p))
+    {
+        printf("Packed nested bag differs\n");
+        goto error_return;
+    }
+    mpl_param_list_destroy(&list_p);
+
+    /* Space, empty parameters and escapes */
+    list_p = mpl_param_list_unpack(spaced);
+    if ((NULL == list_p) || (mpl_list_len(list_p) != 1))
+        goto error_return;
+    elem_p = mpl_param_list_find(test_paramid_mylist1, list_p);
+    if ((NULL == elem_p) || (mpl_list_len(elem_p->value_p) != 2))
+        goto error_return;
+    string_p = mpl_param_list_find(test_paramid_mystring, elem_p->value_p);
+    if ((NULL == string_p) || strcmp(string_p->value_p, "ab,c=d "))
+    {
+        printf("Unexpected string '%s'\n",
+               string_p ? (char*)string_p->value_p : "(null)");
+        goto error_return;
+    }
+    elem_p = mpl_param_list_find(test_paramid_myint, elem_p->value_p);
+    if ((NULL == elem_p) || (*(int*)elem_p->value_p != 1))
+        goto error_return;
+    mpl_param_list_destroy(&list_p);
+
+    /* Braces in values, unpacked and packed again */
+    for (n = 0; n < (int)(sizeof(braced) / sizeof(braced[0])); n++)
+    {
+        strcpy(msg_p, braced[n].msg_p);
+        list_p = mpl_param_list_unpack(msg_p);
+        if (NULL == list_p)
+        {
+            printf("Unpacking %s failed\n", braced[n].msg_p);
+            goto error_return;
+        }
+        elem_p = MPL_LIST_CONTAINER(list_p, mpl_param_element_t, list_entry);
+        while (NULL != mpl_param_list_find(test_paramid_mylist1, elem_p->value_p))
+            elem_p = mpl_param_list_find(test_paramid_mylist1, elem_p->value_p);
+        string_p = mpl_param_list_find(test_paramid_mystring, elem_p->value_p);
+        if ((NULL == string_p) || strcmp(string_p->value_p, braced[n].string_p) ||
+            (mpl_list_len(elem_p->value_p) != braced[n].num_params))
+        {
+            printf("Unexpected string '%s' from %s\n",
+                   string_p ? (char*)string_p->value_p : "(null)",
+                   braced[n].msg_p);
+            goto error_return;
+        }
+        free(packed_p);
+        packed_p = mpl_param_list_pack_alloc(list_p, NULL, NULL);
+        if ((NULL == packed_p) || strcmp(packed_p, braced[n].packed_p))
+        {
+            printf("Packed %s, expected %s\n", packed_p, braced[n].packed_p);
+            goto error_return;
+        }
+        mpl_param_list_destroy(&list_p);
+    }
+
+    /* Unterminated and invalid contents */
+    for (n = 0; n < (int)(sizeof(bad) / sizeof(bad[0])); n++)
+    {
+        strcpy(msg_p, bad[n]);
+        has_error = false;
+        list_p = mpl_param_list_unpack_error(msg_p, &has_error);
+        if ((NULL != list_p) || !has_error)
+        {
+            printf("Unpacking %s succeeded unexpectedly\n", bad[n]);
+            goto error_return;
+        }
+    }
+
+    /* Strings inside bags are views too, until owned */
+    list_p = mpl_param_list_unpack_in_place(views, -1, &has_error);
+    if ((NULL == list_p) || has_error)
+        goto error_return;
+    elem_p = MPL_LIST_CONTAINER(list_p, mpl_param_element_t, list_entry);
+    elem_p = MPL_LIST_CONTAINER(elem_p->value_p, mpl_param_element_t, list_entry);
+    string_p = mpl_param_list_find(test_paramid_mystring, elem_p->value_p);
+    if ((NULL == string_p) || !string_p->value_is_view ||
+        strcmp(string_p->value_p, "hello"))
+        goto error_return;
+    if (mpl_param_list_own_values(list_p) < 0)
+        goto error_return;
+    memset(views, 'x', sizeof(views) - 1);
+    if (string_p->value_is_view || strcmp(string_p->value_p, "hello"))
+    {
+        printf("Nested string still a view after own values\n");
+        goto error_return;
+    }
+
+    mpl_param_list_destroy(&list_p);
+    free(packed_p);
+    free(msg_p);
+    return 0;
+
+ error_return:
+    mpl_param_list_destroy(&list_p);
+    free(packed_p);
+    free(msg_p);
+    return -1;
+}
+
+/*
+ * Specialized methods (mplcomp -s, the mpl_test_s build) must give the
+ * same results as the methods of the type. Without -s the descriptors
+ * have the methods of the type.
+ */
+static int tc_specialized_methods(void)
+{
+#define SPEC_PARAM(NAME, TYPE) \
+    { test_paramid_##NAME, mpl_pack_param_value_##TYPE, \
+      mpl_unpack_param_value_##TYPE, mpl_packed_size_param_value_##TYPE }
+    static const struct
+    {
+        mpl_param_element_id_t id;
+        mpl_pack_param_fp pack_func;
+        mpl_unpack_param_fp unpack_func;
+        mpl_packed_size_param_fp packed_size_func;
+    } params[] =
+    {
+        SPEC_PARAM(myint, int),
+        SPEC_PARAM(myint1, int),
+        SPEC_PARAM(myint4, int),
+        SPEC_PARAM(myuint8, uint8),
+        SPEC_PARAM(myuint8_2, uint8),
+        SPEC_PARAM(myuint16, uint16),
+        SPEC_PARAM(myuint32_2, uint32),
+        SPEC_PARAM(myuint64, uint64),
+        SPEC_PARAM(myuint64_2, uint64),
+        SPEC_PARAM(mysint8, sint8),
+        SPEC_PARAM(mysint16_2, sint16),
+        SPEC_PARAM(mysint32, sint32),
+        SPEC_PARAM(mysint64_2, sint64),
+        SPEC_PARAM(my_ranged_int_child1, int),
+        SPEC_PARAM(my_ranged_int_child2, int),
+        SPEC_PARAM(my_ranged_int3, int),
+        SPEC_PARAM(my_ranged_int5, int),
+        SPEC_PARAM(my_ranged_uint8, uint8),
+        SPEC_PARAM(my_enum, enum),
+        SPEC_PARAM(my_enum_2, enum),
+        SPEC_PARAM(my_enum4, enum),
+        SPEC_PARAM(my_enum6, enum),
+        SPEC_PARAM(my_enum11, enum),
+        SPEC_PARAM(my_enum8, enum8),
+        SPEC_PARAM(my_enum16_2, enum16),
+        SPEC_PARAM(my_enum32, enum32),
+        SPEC_PARAM(my_senum8, signed_enum8),
+        SPEC_PARAM(my_senum16_2, signed_enum16),
+        SPEC_PARAM(my_senum32, signed_enum32),
+    };
+#undef SPEC_PARAM
+    static const char *values[] =
+    {
+        "0", "1", "-1", "5", "7", "63", "64", "99", "-500", "-501", "1000",
+        "1001", "-2000", "-3000", "0x10", "0X1f", "010", "-010", "+4", " 6",
+        "255", "256", "-128", "-129", "4999", "5000", "5001", "30000",
+        "32767", "32768", "65535", "65536", "2147483647", "2147483648",
+        "-2147483648", "-2147483649", "4294967295", "4294967296",
+        "9223372036854775807", "-9223372036854775808",
+        "18446744073709551615", "18446744073709551616", "0xffffffffffffffff",
+        "15", "25", "75", "105", "-95", "-45", "205", "405", "-700", "-5",
+        "val1", "val2", "val4", "val11", "smallval1", "smallval2", "minval",
+        "maxval", "val5", "val_last", "val13", "true", "", "abc", "1x", "0x", "-", "val", "val1 ",
+    };
+    static const char *string_values[] =
+    {
+        "hello", "hello", "hi", "hi", "01234567890123456789",
+        "01234567890123456789", "012345678901234567890", "with\\,comma",
+        "with\\,comma", "a\\=b\\=c\\=d", "12345\\", "",
+    };
+    const mpl_param_descr_set_t *set_p = test_param_descr_set_external_p;
+    const mpl_param_descr_t *descr_p;
+    const mpl_param_descr2_t *descr2_p;
+    mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
+    mpl_param_element_t *elem_p;
+    mpl_param_element_t *clone_p;
+    void *generic_p;
+    void *spec_p;
+    int generic_res;
+    int spec_res;
+    char generic_buf[64];
+    char spec_buf[64];
+    size_t i;
+    size_t n;
+
+    for (i = 0; i < ARRAY_SIZE(params); i++)
+    {
+        descr_p = &set_p->array[(params[i].id & MPL_PARAMID_TYPE_MASK) - 1];
+        descr2_p = &set_p->array2[(params[i].id & MPL_PARAMID_TYPE_MASK) - 1];
+#ifdef MPL_TEST_SPECIALIZED
+        if ((descr_p->pack_func == params[i].pack_func) ||
+            (descr_p->unpack_func == params[i].unpack_func) ||
+            (descr_p->packed_size_func == params[i].packed_size_func))
+        {
+            printf("%s: no specialized methods\n", descr_p->name);
+            return -1;
+        }
+#else
+        if ((descr_p->pack_func != params[i].pack_func) ||
+            (descr_p->unpack_func != params[i].unpack_func) ||
+            (descr_p->packed_size_func != params[i].packed_size_func))
+        {
+            printf("%s: specialized methods without -s\n", descr_p->name);
+            return -1;
+        }
+#endif
+
+        for (n = 0; n < ARRAY_SIZE(values); n++)
+        {
+            generic_p = NULL;
+            spec_p = NULL;
+            generic_res = params[i].unpack_func(values[n], &generic_p,
+                                                descr2_p, &options,
+                                                MPL_PARAM_ID_UNDEFINED);
+            spec_res = descr_p->unpack_func(values[n], &spec_p,
+                                            descr2_p, &options,
+                                            MPL_PARAM_ID_UNDEFINED);
+            if ((generic_res != spec_res) ||
+                ((generic_res >= 0) &&
+                 memcmp(generic_p, spec_p, descr_p->sizeof_func(descr2_p))))
+            {
+                printf("%s=%s: unpack %d, specialized %d\n",
+                       descr_p->name, values[n], generic_res, spec_res);
+                goto error_return;
+            }
+            if (generic_res < 0)
+                continue;
+
+            generic_res = params[i].pack_func(generic_p, generic_buf,
+                                              sizeof(generic_buf),
+                                              descr2_p, &options);
+            spec_res = descr_p->pack_func(spec_p, spec_buf, sizeof(spec_buf),
+                                          descr2_p, &options);
+            if ((generic_res != spec_res) || strcmp(generic_buf, spec_buf) ||
+                (descr_p->packed_size_func(spec_p, descr2_p, &options) !=
+                 spec_res))
+            {
+                printf("%s=%s: pack %s, specialized %s\n",
+                       descr_p->name, values[n], generic_buf, spec_buf);
+                goto error_return;
+            }
+
+            /* Truncated like snprintf() */
+            spec_res = descr_p->pack_func(spec_p, spec_buf, 3,
+                                          descr2_p, &options);
+            if ((spec_res != generic_res) ||
+                strncmp(spec_buf, generic_buf, 2) || (spec_buf[2] != '\0'))
+            {
+                printf("%s=%s: truncated pack %s\n",
+                       descr_p->name, values[n], spec_buf);
+                goto error_return;
+            }
+
+            descr_p->free_func(generic_p);
+            generic_p = NULL;
+            if ((descr_p->clone_func(&generic_p, spec_p, descr2_p) < 0) ||
+                memcmp(generic_p, spec_p, descr_p->sizeof_func(descr2_p)))
+            {
+                printf("%s=%s: clone failed\n", descr_p->name, values[n]);
+                goto error_return;
+            }
+            descr_p->free_func(generic_p);
+            descr_p->free_func(spec_p);
+        }
+    }
+
+    /* Strings: unpacked in one pass with the length limits built in */
+    descr_p = &set_p->array[(test_paramid_mystring & MPL_PARAMID_TYPE_MASK) - 1];
+    descr2_p = &set_p->array2[(test_paramid_mystring & MPL_PARAMID_TYPE_MASK) - 1];
+#ifdef MPL_TEST_SPECIALIZED
+    if ((descr_p->unpack_func == mpl_unpack_param_value_string) ||
+        (descr_p->clone_func == mpl_clone_param_value_string))
+    {
+        printf("%s: no specialized methods\n", descr_p->name);
+        return -1;
+    }
+#endif
+    for (n = 0; n < ARRAY_SIZE(string_values); n++)
+    {
+        options.string_views = (n % 2) != 0;
+        generic_p = NULL;
+        spec_p = NULL;
+        generic_res = mpl_unpack_param_value_string(string_values[n], &generic_p,
+                                                    descr2_p, &options,
+                                                    MPL_PARAM_ID_UNDEFINED);
+        spec_res = descr_p->unpack_func(string_values[n], &spec_p,
+                                        descr2_p, &options,
+                                        MPL_PARAM_ID_UNDEFINED);
+        if ((generic_res != spec_res) ||
+            ((generic_res >= 0) &&
+             (strcmp(generic_p, spec_p) ||
+              ((generic_p == (void*)string_values[n]) !=
+               (spec_p == (void*)string_values[n])))))
+        {
+            printf("%s=%s: unpack %d, specialized %d\n",
+                   descr_p->name, string_values[n], generic_res, spec_res);
+            goto string_error_return;
+        }
+        if (generic_res < 0)
+            continue;
+        if (generic_p != (void*)string_values[n])
+            descr_p->free_func(generic_p);
+        generic_p = NULL;
+        if ((descr_p->clone_func(&generic_p, spec_p, descr2_p) < 0) ||
+            strcmp(generic_p, spec_p))
+        {
+            printf("%s=%s: clone failed\n", descr_p->name, string_values[n]);
+            goto string_error_return;
+        }
+        descr_p->free_func(generic_p);
+        if (spec_p != (void*)string_values[n])
+            descr_p->free_func(spec_p);
+    }
+    options.string_views = false;
+
+    /* Flat values are freed without looking up the parameter */
+    elem_p = NULL;
+    if ((mpl_param_unpack("test.myint", "5", &elem_p) < 0) ||
+        !elem_p->value_is_flat)
+    {
+        printf("myint value not flat\n");
+        mpl_param_element_destroy(elem_p);
+        return -1;
+    }
+    clone_p = mpl_param_element_clone(elem_p);
+    mpl_param_element_destroy(elem_p);
+    if ((NULL == clone_p) || !clone_p->value_is_flat)
+    {
+        printf("myint clone not flat\n");
+        mpl_param_element_destroy(clone_p);
+        return -1;
+    }
+    mpl_param_element_destroy(clone_p);
+    elem_p = NULL;
+    if ((mpl_param_unpack("test.mynewbag", "{s=hello}", &elem_p) < 0) ||
+        elem_p->value_is_flat)
+    {
+        printf("bag value flat\n");
+        mpl_param_element_destroy(elem_p);
+        return -1;
+    }
+    mpl_param_element_destroy(elem_p);
+    return 0;
+
+ string_error_return:
+    if ((NULL != generic_p) && (generic_p != (void*)string_values[n]))
+        descr_p->free_func(generic_p);
+    if ((NULL != spec_p) && (spec_p != (void*)string_values[n]))
+        descr_p->free_func(spec_p);
+    return -1;
+
+ error_return:
+    if (NULL != generic_p)
+        descr_p->free_func(generic_p);
+    if (NULL != spec_p)
+        descr_p->free_func(spec_p);
+    return -1;
+}
+
+static int tc_enum_tables(void)
+{
+    const mpl_param_descr_set_t *set_p = test_param_descr_set_external_p;
+    const mpl_param_descr_t *descr_p;
+    const mpl_param_descr2_t *descr2_p;
+    mpl_param_descr2_t plain_descr2;
+    mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
+    mpl_pack_param_fp pack_func;
+    mpl_unpack_param_fp unpack_func;
+    const mpl_enum_value_t *enum_value_p;
+    void *table_p;
+    void *plain_p;
+    int table_res;
+    int plain_res;
+    char table_buf[64];
+    char plain_buf[64];
+    char name[64];
+    int64_t value;
+    int num_tables = 0;
+    int found_status_code = 0;
+    int i;
+    int n;
+    int k;
+
+    /* Parameter ids start at 1 */
+    for (i = 0; i < set_p->paramid_enum_size - 1; i++)
+    {
+        descr_p = &set_p->array[i];
+        descr2_p = &set_p->array2[i];
+        switch (descr_p->type)
+        {
+#define ENUM_TYPE(TYPE)                                         \
+            case mpl_type_##TYPE:                               \
+                pack_func = mpl_pack_param_value_##TYPE;        \
+                unpack_func = mpl_unpack_param_value_##TYPE;    \
+                break;
+            ENUM_TYPE(enum)
+            ENUM_TYPE(enum8)
+            ENUM_TYPE(enum16)
+            ENUM_TYPE(enum32)
+            ENUM_TYPE(signed_enum8)
+            ENUM_TYPE(signed_enum16)
+            ENUM_TYPE(signed_enum32)
+#undef ENUM_TYPE
+            default:
+                continue;
+        }
+        if ((NULL == descr2_p->enum_table_p) ||
+            (NULL == descr2_p->enum_table_p->name_slots) ||
+            (NULL == descr2_p->enum_table_p->by_value))
+        {
+            printf("%s: no enum tables\n", descr_p->name);
+            return -1;
+        }
+        num_tables++;
+        if (!strcmp(descr_p->name, "my_status_code"))
+            found_status_code = 1;
+
+        /* Without the tables, names and values are searched */
+        plain_descr2 = *descr2_p;
+        plain_descr2.enum_table_p = NULL;
+
+        for (n = 0; n < 3 * descr2_p->enum_values_size; n++)
+        {
+            enum_value_p = &descr2_p->enum_values[n / 3];
+            strcpy(name, enum_value_p->name_p);
+            if ((n % 3) == 1)
+                strcat(name, "x");
+            else if ((n % 3) == 2)
+                name[strlen(name) - 1] = '\0';
+
+            table_p = NULL;
+            plain_p = NULL;
+            table_res = unpack_func(name, &table_p, descr2_p, &options,
+                                    MPL_PARAM_ID_UNDEFINED);
+            plain_res = unpack_func(name, &plain_p, &plain_descr2, &options,
+                                    MPL_PARAM_ID_UNDEFINED);
+            if ((table_res != plain_res) ||
+                ((table_res >= 0) &&
+                 memcmp(table_p, plain_p, descr_p->sizeof_func(descr2_p))))
+            {
+                printf("%s=%s: unpack %d, without tables %d\n",
+                       descr_p->name, name, table_res, plain_res);
+                goto error_return;
+            }
+            mpl_free_param_value(table_p);
+            mpl_free_param_value(plain_p);
+        }
+
+        for (n = 0; n < 3 * descr2_p->enum_values_size; n++)
+        {
+            /* Each value and its neighbours */
+            value = descr2_p->enum_values[n / 3].value + (n % 3) - 1;
+            snprintf(name, sizeof(name), "%" PRIi64, value);
+
+            table_p = NULL;
+            plain_p = NULL;
+            table_res = unpack_func(name, &table_p, descr2_p, &options,
+                                    MPL_PARAM_ID_UNDEFINED);
+            plain_res = unpack_func(name, &plain_p, &plain_descr2, &options,
+                                    MPL_PARAM_ID_UNDEFINED);
+            if (table_res != plain_res)
+            {
+                printf("%s=%s: unpack %d, without tables %d\n",
+                       descr_p->name, name, table_res, plain_res);
+                goto error_return;
+            }
+            if (table_res >= 0)
+            {
+                table_res = pack_func(table_p, table_buf, sizeof(table_buf),
+                                      descr2_p, &options);
+                plain_res = pack_func(plain_p, plain_buf, sizeof(plain_buf),
+                                      &plain_descr2, &options);
+                if ((table_res != plain_res) || strcmp(table_buf, plain_buf))
+                {
+                    printf("%s=%s: pack %s, without tables %s\n",
+                           descr_p->name, name, table_buf, plain_buf);
+                    goto error_return;
+                }
+            }
+            mpl_free_param_value(table_p);
+            mpl_free_param_value(plain_p);
+        }
+
+        /* Every name has a slot, the first of duplicates */
+        for (n = 0; n < descr2_p->enum_values_size; n++)
+        {
+            for (k = 0; k <= (int)descr2_p->enum_table_p->name_slot_mask; k++)
+                if ((descr2_p->enum_table_p->name_slots[k] >= 0) &&
+                    !strcmp(descr2_p->enum_values[descr2_p->enum_table_p->name_slots[k]].name_p,
+                            descr2_p->enum_values[n].name_p))
+                    break;
+            if ((k > (int)descr2_p->enum_table_p->name_slot_mask) ||
+                (descr2_p->enum_table_p->name_slots[k] > n))
+            {
+                printf("%s: no slot for %s\n",
+                       descr_p->name, descr2_p->enum_values[n].name_p);
+                return -1;
+            }
+        }
+    }
+
+    if ((num_tables == 0) || !found_status_code)
+    {
+        printf("Enums missing\n");
+        return -1;
+    }
+    return 0;
+
+error_return:
+    mpl_free_param_value(table_p);
+    mpl_free_param_value(plain_p);
+    return -1;
+}
+
+static int tc_rendered_keys(void)
+{
+    const mpl_param_descr_set_t *set_p = test_param_descr_set_external_p;
+    const mpl_param_descr2_t *descr2_p;
+    const mpl_field_value_t *field_p;
+    mpl_pack_options_t options = MPL_PACK_OPTIONS_DEFAULT;
+    mpl_param_element_t elem;
+    static const int tags[] = { 0, 1, 9, 10, 123, MPL_MAX_ARGS - 1 };
+    char expected[256];
+    char buf[256];
+    int expected_len;
+    int len;
+    int num_fields = 0;
+    int i;
+    int j;
+    int t;
+    int m;
+    size_t n;
+
+    mpl_param_element_init(&elem, MPL_PARAM_ID_UNDEFINED);
+    for (i = 0; i < set_p->paramid_enum_size - 1; i++)
+    {
+        descr2_p = &set_p->array2[i];
+        /* The parameter itself (j == -1), then as each of its fields */
+        for (j = -1; j < descr2_p->field_values_size; j++)
+        {
+            field_p = (j >= 0) ? &descr2_p->field_values[j] : NULL;
+            if ((NULL != field_p) &&
+                ((field_p->param_id == MPL_PARAM_ID_UNDEFINED) ||
+                 (MPL_PARAMID_TO_PARAMSET(field_p->param_id) !=
+                  set_p->param_set_id)))
+                continue;
+            num_fields += (NULL != field_p);
+
+            memset(&elem, 0, sizeof(elem));
+            if (NULL != field_p)
+            {
+                elem.id = field_p->param_id;
+                elem.context = MPL_BUILD_PARAMID(descr2_p->is_virtual ? 1 : 0, set_p->param_set_id, i + 1);
+                elem.id_in_context = field_p->field_id;
+            }
+            else
+            {
+                elem.id = MPL_BUILD_PARAMID(descr2_p->is_virtual ? 1 : 0, set_p->param_set_id, i + 1);
+                elem.context = MPL_PARAM_ID_UNDEFINED;
+            }
+
+            for (t = 0; t < (int)ARRAY_SIZE(tags); t++)
+            {
+                elem.tag = tags[t];
+                for (m = 0; m < 4; m++)
+                {
+                    options.no_prefix = (m & 1);
+                    options.field_pack_mode = (m & 2) ?
+                        field_pack_mode_context : field_pack_mode_autonomous;
+
+                    if ((NULL != field_p) && (m & 2))
+                        expected_len = snprintf(expected, sizeof(expected),
+                                                "%s", field_p->name_p);
+                    else
+                        expected_len = snprintf(expected, sizeof(expected),
+                                                "%s%s%s%s%s",
+                                                (m & 1) ? "" : set_p->paramid_prefix,
+                                                (m & 1) ? "" : ".",
+                                                set_p->array[i].name,
+                                                (NULL != field_p) ? "%" : "",
+                                                (NULL != field_p) ? field_p->name_p : "");
+                    if (elem.tag > 0)
+                        expected_len += snprintf(expected + expected_len,
+                                                 sizeof(expected) - expected_len,
+                                                 "[%d]", elem.tag);
+
+                    len = mpl_param_pack_internal(&elem, buf, sizeof(buf),
+                                                  &options);
+                    if ((len != expected_len) || strcmp(buf, expected) ||
+                        (mpl_param_packed_size_internal(&elem, &options) != len))
+                    {
+                        printf("Packed %s (%d), expected %s (%d)\n",
+                               buf, len, expected, expected_len);
+                        return -1;
+                    }
+
+                    /* Truncated like snprintf() */
+                    for (n = 0; n <= (size_t)expected_len + 1; n++)
+                    {
+                        memset(buf, 'x', sizeof(buf));
+                        len = mpl_param_pack_internal(&elem, buf, n, &options);
+                        if ((len != expected_len) ||
+                            ((n > 0) &&
+                             (strncmp(buf, expected, n - 1) ||
+                              (buf[(n - 1 < (size_t)len) ? n - 1 : (size_t)len] != '\0'))) ||
+                            (buf[n] != 'x'))
+                        {
+                            printf("Truncated to %zu: %s, expected %s\n",
+                                   n, buf, expected);
+                            return -1;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    if (num_fields == 0)
+    {
+        printf("No fields\n");
+        return -1;
+    }
+    return 0;
+}
+
+void mpl_test(int test_start, int test_stop)
+{
+  int testcase;
+  int result;
+
+  if (0 != test_param_init())
+  {
+    printf("test_param_init() failed\n");
+    return;
+  }
+
+  if (0 != tull_param_init())
+  {
+    printf("tull_param_init() failed\n");
+    return;
+  }
+
+  for(testcase = test_start; testcase <= test_stop; testcase++)
+  {
+    switch(testcase)
+    {
+    case 1:
+      result=tc_pack_unpack_req_mycommand();
+      break;
+    case 2:
+      result=tc_pack_unpack_resp_mycommand();
+      break;
+    case 3:
+      result=tc_pack_unpack_event_myevent();
+      break;
+    case 4:
+      result=tc_pack_unpack_buffer_too_small();
+      break;
+    case 5:
+      result=tc_unpack_with_unknown_parameter();
+      break;
+    case 6:
+      result=tc_pack_unsupported_param_id();
+      break;
+    case 7:
+      result=tc_pack_unpack_param_int();
+      break;
+    case 8:
+      result=tc_pack_unpack_param_enum();
+      break;
+    case 9:
+      result=tc_pack_unpack_param_uint8();
+      break;
+    case 10:
+      result=tc_pack_unpack_param_uint32();
+      break;
+    case 11:
+      result=tc_pack_unpack_param_bool();
+      break;
+    case 12:
+      result=tc_pack_unpack_param_string();
+      break;
+    case 13:
+      result=tc_pack_param_illegal();
+      break;
+    case 14:
+      result=tc_unpack_param_illegal();
+      break;
+    case 15:
+      result=tc_list();
+      break;
+    case 16:
+      result=tc_param_get_default();
+      break;
+    case 17:
+      result=tc_param_allow_get();
+      break;
+    case 18:
+      result=tc_param_allow_set();
+      break;
+    case 19:
+      result=tc_param_allow_config();
+      break;
+    case 20:
+      result=tc_clone_param();
+      break;
+    case 21:
+      result=tc_param_id_get_str();
+      break;
+    case 22:
+      result=tc_param_value_get_str();
+      break;
+    case 23:
+      result=tc_get_args_escape_1();
+      break;
+    case 24:
+      result=tc_get_args_escape_2();
+      break;
+    case 25:
+      result=tc_get_args_escape_3();
+      break;
+    case 26:
+      result=tc_compare_param();
+      break;
+    case 27:
+      result=tc_config_read();
+      break;
+    case 28:
+      result=tc_element_create_negative();
+      break;
+    case 29:
+      result=tc_config_negative();
+      break;
+    case 30:
+      result=tc_init_mpl_param();
+      break;
+    case 31:
+      result=tc_pack_unpack_param_default_param_set();
+      break;
+    case 32:
+      result=tc_uint8_array();
+      break;
+    case 33:
+      result=tc_string_tuple();
+      break;
+    case 34:
+      result=tc_param_list_tuple_key_find();
+      break;
+    case 35:
+      result=tc_pack_unpack_param_uint16();
+      break;
+    case 36:
+      result=tc_pack_unpack_param_bool8();
+      break;
+    case 37:
+      result=tc_pack_unpack_param_list();
+      break;
+    case 38:
+      result=tc_list_append();
+      break;
+    case 39:
+      result=tc_param_list_find_all();
+      break;
+    case 40:
+      result=tc_uint16_array();
+      break;
+    case 41:
+      result=tc_pack_unpack_param_wstring();
+      break;
+    case 42:
+      result=tc_uint32_array();
+      break;
+    case 43:
+      result=tc_param_clone_list();
+      break;
+    case 44:
+      result=tc_pack_unpack_param_enum8();
+      break;
+    case 45:
+      result=tc_config_read_bl();
+      break;
+    case 46:
+      result=tc_pack_param_list_no_prefix();
+      break;
+    case 47:
+      result=tc_unpack_param_list_default_param_set();
+      break;
+    case 48:
+      result=tc_list_write_read_file();
+      break;
+    case 49:
+      result=tc_write_read_config();
+      break;
+    case 50:
+      result=tc_param_tag();
+      break;
+    case 51:
+      result=tc_int_tuple();
+      break;
+    case 52:
+      result=tc_strint_tuple();
+      break;
+    case 53:
+      result=tc_get_type();
+      break;
+    case 54:
+      result=tc_get_type_string();
+      break;
+    case 55:
+      result=tc_pack_unpack_param_signed_enum8();
+      break;
+    case 56:
+      result=tc_pack_unpack_param_signed_enum16();
+      break;
+    case 57:
+      result=tc_pack_unpack_param_signed_enum32();
+      break;
+    case 58:
+      result=tc_pack_unpack_param_enum16();
+      break;
+    case 59:
+      result=tc_pack_unpack_param_enum32();
+      break;
+    case 60:
+      result=tc_pack_unpack_param_sint8();
+      break;
+    case 61:
+      result=tc_pack_unpack_param_sint16();
+      break;
+    case 62:
+      result=tc_pack_unpack_param_sint32();
+      break;
+    case 63:
+      result=tc_pack_unpack_param_uint16();
+      break;
+    case 64:
+      result=tc_param_list_add();
+      break;
+    case 65:
+      result=tc_pack_unpack_param_uint64();
+      break;
+    case 66:
+      result=tc_list_write_read_file_negative();
+      break;
+    case 67:
+      result=tc_errno();
+      break;
+    case 68:
+        result= tc_threads();
+      break;
+    case 69:
+      result=tc_struint8_tuple();
+      break;
+    case 70:
+      result=tc_sizeof_zero();
+      break;
+    case 71:
+      result=tc_write_read_blacklist();
+      break;
+    case 72:
+      result=tc_misc_invalid();
+      break;
+    case 73:
+      result=tc_param_type_bag();
+      break;
     case 74:
       result=tc_pack_unpack_param_addr();
       break;
@@ -11307,6 +14994,78 @@ void mpl_test(int test_start, int test_stop)
     case 88:
       result=tc_long_tagged_list();
       break;
+    case 89:
+      result=tc_pack_unpack_bin();
+      break;
+    case 90:
+      result=tc_name_lookup();
+      break;
+    case 91:
+      result=tc_thread_context_exit();
+      break;
+    case 92:
+      result=tc_registry_concurrent_init();
+      break;
+    case 93:
+      result=tc_unpack_in_place();
+      break;
+    case 94:
+      result=tc_get_args_many();
+      break;
+    case 95:
+      result=tc_arena();
+      break;
+    case 96:
+      result=tc_list_index();
+      break;
+    case 97:
+      result=tc_pack_stream();
+      break;
+    case 98:
+      result=tc_unpack_stream();
+      break;
+    case 99:
+      result=tc_read_large_file();
+      break;
+    case 100:
+      result=tc_store();
+      break;
+    case 101:
+      result=tc_bag_struct();
+      break;
+    case 102:
+      result=tc_dispatch();
+      break;
+    case 103:
+      result=tc_server();
+      break;
+    case 104:
+      result=tc_client();
+      break;
+    case 105:
+      result=tc_hex_array();
+      break;
+    case 106:
+      result=tc_integer_codec();
+      break;
+    case 107:
+      result=tc_packed_size();
+      break;
+    case 108:
+      result=tc_bag_pack_nested();
+      break;
+    case 109:
+      result=tc_bag_unpack_nested();
+      break;
+    case 110:
+      result=tc_specialized_methods();
+      break;
+    case 111:
+      result=tc_enum_tables();
+      break;
+    case 112:
+      result=tc_rendered_keys();
+      break;
     default:
       printf("\n** unknown TC **\n");
       result=-1;
@@ -22,7 +22,7 @@ static int pack_and_send(mpl_list_t *msg)
     int len;
     int ret = -1;
 
-    len = mpl_param_list_pack(msg, NULL, 0);
+    len = mpl_param_list_packed_size(msg);
     if (len <= 0) {
         printf("!!! FAILED PACKING MESSAGE !!!\n");
         goto exit;
@@ -21,73 +21,56 @@
 #include <stdlib.h>
 
 
-static mpl_list_t *handle_TestEchoInt(mpl_bag_t *reqParams);
-static mpl_list_t *handle_TestEchoIntPN(mpl_bag_t *reqParams);
-static mpl_list_t *handle_TestEchoEnum(mpl_bag_t *reqParams);
-static mpl_list_t *handle_TestEchoEnumPN(mpl_bag_t *reqParams);
-static mpl_list_t *handle_TestEchoBool(mpl_bag_t *reqParams);
-static mpl_list_t *handle_TestEchoBoolPN(mpl_bag_t *reqParams);
-static mpl_list_t *handle_TestEchoString(mpl_bag_t *reqParams);
-static mpl_list_t *handle_TestEchoStringPN(mpl_bag_t *reqParams);
-static mpl_list_t *handle_TestEchoAddr(mpl_bag_t *reqParams);
-static mpl_list_t *handle_TestEchoAddrPN(mpl_bag_t *reqParams);
-static mpl_list_t *handle_TestEchoArray(mpl_bag_t *reqParams);
-static mpl_list_t *handle_TestEchoArrayPN(mpl_bag_t *reqParams);
-static mpl_list_t *handle_TestEchoTuple(mpl_bag_t *reqParams);
-static mpl_list_t *handle_TestEchoTuplePN(mpl_bag_t *reqParams);
-static mpl_list_t *handle_TestEchoBag(mpl_bag_t *reqParams);
-static mpl_list_t *handle_TestEchoBagPN(mpl_bag_t *reqParams);
+static mpl_list_t *handle_TestEchoInt(mpl_bag_t *reqParams, void *ctx_p);
+static mpl_list_t *handle_TestEchoIntPN(mpl_bag_t *reqParams, void *ctx_p);
+static mpl_list_t *handle_TestEchoEnum(mpl_bag_t *reqParams, void *ctx_p);
+static mpl_list_t *handle_TestEchoEnumPN(mpl_bag_t *reqParams, void *ctx_p);
+static mpl_list_t *handle_TestEchoBool(mpl_bag_t *reqParams, void *ctx_p);
+static mpl_list_t *handle_TestEchoBoolPN(mpl_bag_t *reqParams, void *ctx_p);
+static mpl_list_t *handle_TestEchoString(mpl_bag_t *reqParams, void *ctx_p);
+static mpl_list_t *handle_TestEchoStringPN(mpl_bag_t *reqParams, void *ctx_p);
+static mpl_list_t *handle_TestEchoAddr(mpl_bag_t *reqParams, void *ctx_p);
+static mpl_list_t *handle_TestEchoAddrPN(mpl_bag_t *reqParams, void *ctx_p);
+static mpl_list_t *handle_TestEchoArray(mpl_bag_t *reqParams, void *ctx_p);
+static mpl_list_t *handle_TestEchoArrayPN(mpl_bag_t *reqParams, void *ctx_p);
+static mpl_list_t *handle_TestEchoTuple(mpl_bag_t *reqParams, void *ctx_p);
+static mpl_list_t *handle_TestEchoTuplePN(mpl_bag_t *reqParams, void *ctx_p);
+static mpl_list_t *handle_TestEchoBag(mpl_bag_t *reqParams, void *ctx_p);
+static mpl_list_t *handle_TestEchoBagPN(mpl_bag_t *reqParams, void *ctx_p);
+
+static const testprot_handlers_t handlers = {
+    .TestEchoInt = handle_TestEchoInt,
+    .TestEchoIntPN = handle_TestEchoIntPN,
+    .TestEchoEnum = handle_TestEchoEnum,
+    .TestEchoEnumPN = handle_TestEchoEnumPN,
+    .TestEchoBool = handle_TestEchoBool,
+    .TestEchoBoolPN = handle_TestEchoBoolPN,
+    .TestEchoString = handle_TestEchoString,
+    .TestEchoStringPN = handle_TestEchoStringPN,
+    .TestEchoAddr = handle_TestEchoAddr,
+    .TestEchoAddrPN = handle_TestEchoAddrPN,
+    .TestEchoArray = handle_TestEchoArray,
+    .TestEchoArrayPN = handle_TestEchoArrayPN,
+    .TestEchoTuple = handle_TestEchoTuple,
+    .TestEchoTuplePN = handle_TestEchoTuplePN,
+    .TestEchoBag = handle_TestEchoBag,
+    .TestEchoBagPN = handle_TestEchoBagPN,
+};
 
 mpl_list_t *handle_testprot(mpl_list_t *reqMsg)
 {
-    mpl_bag_t *reqParams;
+    mpl_list_t *respMsg = NULL;
 
     if (!TESTPROT_IS_COMMAND(reqMsg)) {
         goto req_failure;
     }
 
-    reqParams = TESTPROT_GET_COMMAND_PARAMS_PTR(reqMsg);
-
-    switch (TESTPROT_GET_COMMAND_ID(reqMsg)) {
-        case TESTP_PARAM_ID(TestEchoInt_Req):
-            return handle_TestEchoInt(reqParams);
-        case TESTP_PARAM_ID(TestEchoIntPN_Req):
-            return handle_TestEchoIntPN(reqParams);
-        case TESTP_PARAM_ID(TestEchoEnum_Req):
-            return handle_TestEchoEnum(reqParams);
-        case TESTP_PARAM_ID(TestEchoEnumPN_Req):
-            return handle_TestEchoEnumPN(reqParams);
-        case TESTP_PARAM_ID(TestEchoBool_Req):
-            return handle_TestEchoBool(reqParams);
-        case TESTP_PARAM_ID(TestEchoBoolPN_Req):
-            return handle_TestEchoBoolPN(reqParams);
-        case TESTP_PARAM_ID(TestEchoString_Req):
-            return handle_TestEchoString(reqParams);
-        case TESTP_PARAM_ID(TestEchoStringPN_Req):
-            return handle_TestEchoStringPN(reqParams);
-        case TESTP_PARAM_ID(TestEchoAddr_Req):
-            return handle_TestEchoAddr(reqParams);
-        case TESTP_PARAM_ID(TestEchoAddrPN_Req):
-            return handle_TestEchoAddrPN(reqParams);
-        case TESTP_PARAM_ID(TestEchoArray_Req):
-            return handle_TestEchoArray(reqParams);
-        case TESTP_PARAM_ID(TestEchoArrayPN_Req):
-            return handle_TestEchoArrayPN(reqParams);
-        case TESTP_PARAM_ID(TestEchoTuple_Req):
-            return handle_TestEchoTuple(reqParams);
-        case TESTP_PARAM_ID(TestEchoTuplePN_Req):
-            return handle_TestEchoTuplePN(reqParams);
-        case TESTP_PARAM_ID(TestEchoBag_Req):
-            return handle_TestEchoBag(reqParams);
-        case TESTP_PARAM_ID(TestEchoBagPN_Req):
-            return handle_TestEchoBagPN(reqParams);
-        default:
-            break;
-    }
+    respMsg = testprot_dispatch(&handlers, reqMsg, NULL);
+    if (respMsg != NULL)
+        return respMsg;
 
 req_failure:
     {
-        mpl_list_t *respMsg = NULL;
         mpl_bag_t *respParams = NULL;
 
         mpl_add_param_to_list(&respMsg,
@@ -98,7 +81,7 @@ req_failure:
     }
 }
 
-static mpl_list_t *handle_TestEchoInt(mpl_bag_t *reqParams)
+static mpl_list_t *handle_TestEchoInt(mpl_bag_t *reqParams, void *ctx_p)
 {
     mpl_list_t *respMsg = NULL;
     mpl_bag_t *respParams = NULL;
@@ -146,7 +129,7 @@ static mpl_list_t *handle_TestEchoInt(mpl_bag_t *reqParams)
     return respMsg;
 }
 
-static mpl_list_t *handle_TestEchoIntPN(mpl_bag_t *reqParams)
+static mpl_list_t *handle_TestEchoIntPN(mpl_bag_t *reqParams, void *ctx_p)
 {
     mpl_list_t *respMsg = NULL;
     mpl_bag_t *respParams = NULL;
@@ -194,7 +177,7 @@ static mpl_list_t *handle_TestEchoIntPN(mpl_bag_t *reqParams)
     return respMsg;
 }
 
-static mpl_list_t *handle_TestEchoEnum(mpl_bag_t *reqParams)
+static mpl_list_t *handle_TestEchoEnum(mpl_bag_t *reqParams, void *ctx_p)
 {
     mpl_list_t *respMsg = NULL;
     mpl_bag_t *respParams = NULL;
@@ -234,7 +217,7 @@ static mpl_list_t *handle_TestEchoEnum(mpl_bag_t *reqParams)
     return respMsg;
 }
 
-static mpl_list_t *handle_TestEchoEnumPN(mpl_bag_t *reqParams)
+static mpl_list_t *handle_TestEchoEnumPN(mpl_bag_t *reqParams, void *ctx_p)
 {
     mpl_list_t *respMsg = NULL;
     mpl_bag_t *respParams = NULL;
@@ -274,7 +257,7 @@ static mpl_list_t *handle_TestEchoEnumPN(mpl_bag_t *reqParams)
     return respMsg;
 }
 
-static mpl_list_t *handle_TestEchoBool(mpl_bag_t *reqParams)
+static mpl_list_t *handle_TestEchoBool(mpl_bag_t *reqParams, void *ctx_p)
 {
     mpl_list_t *respMsg = NULL;
     mpl_bag_t *respParams = NULL;
@@ -294,7 +277,7 @@ static mpl_list_t *handle_TestEchoBool(mpl_bag_t *reqParams)
     return respMsg;
 }
 
-static mpl_list_t *handle_TestEchoBoolPN(mpl_bag_t *reqParams)
+static mpl_list_t *handle_TestEchoBoolPN(mpl_bag_t *reqParams, void *ctx_p)
 {
     mpl_list_t *respMsg = NULL;
     mpl_bag_t *respParams = NULL;
@@ -314,7 +297,7 @@ static mpl_list_t *handle_TestEchoBoolPN(mpl_bag_t *reqParams)
     return respMsg;
 }
 
-static mpl_list_t *handle_TestEchoString(mpl_bag_t *reqParams)
+static mpl_list_t *handle_TestEchoString(mpl_bag_t *reqParams, void *ctx_p)
 {
     mpl_list_t *respMsg = NULL;
     mpl_bag_t *respParams = NULL;
@@ -334,7 +317,7 @@ static mpl_list_t *handle_TestEchoString(mpl_bag_t *reqParams)
     return respMsg;
 }
 
-static mpl_list_t *handle_TestEchoStringPN(mpl_bag_t *reqParams)
+static mpl_list_t *handle_TestEchoStringPN(mpl_bag_t *reqParams, void *ctx_p)
 {
     mpl_list_t *respMsg = NULL;
     mpl_bag_t *respParams = NULL;
@@ -354,7 +337,7 @@ static mpl_list_t *handle_TestEchoStringPN(mpl_bag_t *reqParams)
     return respMsg;
 }
 
-static mpl_list_t *handle_TestEchoAddr(mpl_bag_t *reqParams)
+static mpl_list_t *handle_TestEchoAddr(mpl_bag_t *reqParams, void *ctx_p)
 {
     mpl_list_t *respMsg = NULL;
     mpl_bag_t *respParams = NULL;
@@ -370,7 +353,7 @@ static mpl_list_t *handle_TestEchoAddr(mpl_bag_t *reqParams)
     return respMsg;
 }
 
-static mpl_list_t *handle_TestEchoAddrPN(mpl_bag_t *reqParams)
+static mpl_list_t *handle_TestEchoAddrPN(mpl_bag_t *reqParams, void *ctx_p)
 {
     mpl_list_t *respMsg = NULL;
     mpl_bag_t *respParams = NULL;
@@ -386,7 +369,7 @@ static mpl_list_t *handle_TestEchoAddrPN(mpl_bag_t *reqParams)
     return respMsg;
 }
 
-static mpl_list_t *handle_TestEchoArray(mpl_bag_t *reqParams)
+static mpl_list_t *handle_TestEchoArray(mpl_bag_t *reqParams, void *ctx_p)
 {
     mpl_list_t *respMsg = NULL;
     mpl_bag_t *respParams = NULL;
@@ -410,7 +393,7 @@ static mpl_list_t *handle_TestEchoArray(mpl_bag_t *reqParams)
     return respMsg;
 }
 
-static mpl_list_t *handle_TestEchoArrayPN(mpl_bag_t *reqParams)
+static mpl_list_t *handle_TestEchoArrayPN(mpl_bag_t *reqParams, void *ctx_p)
 {
     mpl_list_t *respMsg = NULL;
     mpl_bag_t *respParams = NULL;
@@ -434,7 +417,7 @@ static mpl_list_t *handle_TestEchoArrayPN(mpl_bag_t *reqParams)
     return respMsg;
 }
 
-static mpl_list_t *handle_TestEchoTuple(mpl_bag_t *reqParams)
+static mpl_list_t *handle_TestEchoTuple(mpl_bag_t *reqParams, void *ctx_p)
 {
     mpl_list_t *respMsg = NULL;
     mpl_bag_t *respParams = NULL;
@@ -462,7 +445,7 @@ static mpl_list_t *handle_TestEchoTuple(mpl_bag_t *reqParams)
     return respMsg;
 }
 
-static mpl_list_t *handle_TestEchoTuplePN(mpl_bag_t *reqParams)
+static mpl_list_t *handle_TestEchoTuplePN(mpl_bag_t *reqParams, void *ctx_p)
 {
     mpl_list_t *respMsg = NULL;
     mpl_bag_t *respParams = NULL;
@@ -490,7 +473,7 @@ static mpl_list_t *handle_TestEchoTuplePN(mpl_bag_t *reqParams)
     return respMsg;
 }
 
-static mpl_list_t *handle_TestEchoBag(mpl_bag_t *reqParams)
+static mpl_list_t *handle_TestEchoBag(mpl_bag_t *reqParams, void *ctx_p)
 {
     mpl_list_t *respMsg = NULL;
     mpl_bag_t *respParams = NULL;
@@ -506,7 +489,7 @@ static mpl_list_t *handle_TestEchoBag(mpl_bag_t *reqParams)
     return respMsg;
 }
 
-static mpl_list_t *handle_TestEchoBagPN(mpl_bag_t *reqParams)
+static mpl_list_t *handle_TestEchoBagPN(mpl_bag_t *reqParams, void *ctx_p)
 {
     mpl_list_t *respMsg = NULL;
     mpl_bag_t *respParams = NULL;
@@ -23,65 +23,49 @@
 
 using namespace testprotocol;
 
-static BAG *handle_TestEchoInt(TestEchoInt_Req *reqObj);
-static BAG *handle_TestEchoIntPN(TestEchoIntPN_Req *reqObj);
-static BAG *handle_TestEchoEnum(TestEchoEnum_Req *reqObj);
-static BAG *handle_TestEchoEnumPN(TestEchoEnumPN_Req *reqObj);
-static BAG *handle_TestEchoBool(TestEchoBool_Req *reqObj);
-static BAG *handle_TestEchoBoolPN(TestEchoBoolPN_Req *reqObj);
-static BAG *handle_TestEchoString(TestEchoString_Req *reqObj);
-static BAG *handle_TestEchoStringPN(TestEchoStringPN_Req *reqObj);
-static BAG *handle_TestEchoAddr(TestEchoAddr_Req *reqObj);
-static BAG *handle_TestEchoAddrPN(TestEchoAddrPN_Req *reqObj);
-static BAG *handle_TestEchoArray(TestEchoArray_Req *reqObj);
-static BAG *handle_TestEchoArrayPN(TestEchoArrayPN_Req *reqObj);
-static BAG *handle_TestEchoTuple(TestEchoTuple_Req *reqObj);
-static BAG *handle_TestEchoTuplePN(TestEchoTuplePN_Req *reqObj);
-static BAG *handle_TestEchoBag(TestEchoBag_Req *reqObj);
-static BAG *handle_TestEchoBagPN(TestEchoBagPN_Req *reqObj);
+static BAG *handle_TestEchoInt(TestEchoInt_Req *reqObj, void *ctx_p);
+static BAG *handle_TestEchoIntPN(TestEchoIntPN_Req *reqObj, void *ctx_p);
+static BAG *handle_TestEchoEnum(TestEchoEnum_Req *reqObj, void *ctx_p);
+static BAG *handle_TestEchoEnumPN(TestEchoEnumPN_Req *reqObj, void *ctx_p);
+static BAG *handle_TestEchoBool(TestEchoBool_Req *reqObj, void *ctx_p);
+static BAG *handle_TestEchoBoolPN(TestEchoBoolPN_Req *reqObj, void *ctx_p);
+static BAG *handle_TestEchoString(TestEchoString_Req *reqObj, void *ctx_p);
+static BAG *handle_TestEchoStringPN(TestEchoStringPN_Req *reqObj, void *ctx_p);
+static BAG *handle_TestEchoAddr(TestEchoAddr_Req *reqObj, void *ctx_p);
+static BAG *handle_TestEchoAddrPN(TestEchoAddrPN_Req *reqObj, void *ctx_p);
+static BAG *handle_TestEchoArray(TestEchoArray_Req *reqObj, void *ctx_p);
+static BAG *handle_TestEchoArrayPN(TestEchoArrayPN_Req *reqObj, void *ctx_p);
+static BAG *handle_TestEchoTuple(TestEchoTuple_Req *reqObj, void *ctx_p);
+static BAG *handle_TestEchoTuplePN(TestEchoTuplePN_Req *reqObj, void *ctx_p);
+static BAG *handle_TestEchoBag(TestEchoBag_Req *reqObj, void *ctx_p);
+static BAG *handle_TestEchoBagPN(TestEchoBagPN_Req *reqObj, void *ctx_p);
 
-BAG *handle_testprot(BAG *reqObj)
+// In command id order, the order of the generated handler slots
+static const testprot::handlers handlers = {
+    handle_TestEchoInt,
+    handle_TestEchoIntPN,
+    handle_TestEchoEnum,
+    handle_TestEchoEnumPN,
+    handle_TestEchoBool,
+    handle_TestEchoBoolPN,
+    handle_TestEchoString,
+    handle_TestEchoStringPN,
+    handle_TestEchoAddr,
+    handle_TestEchoAddrPN,
+    handle_TestEchoArray,
+    handle_TestEchoArrayPN,
+    handle_TestEchoTuple,
+    handle_TestEchoTuplePN,
+    handle_TestEchoBag,
+    handle_TestEchoBagPN
+};
+
+BAG *handle_testprot(mpl_list_t *reqMsg)
 {
-    switch (reqObj->id()) {
-        case TESTP_PARAM_ID(TestEchoInt_Req):
-            return handle_TestEchoInt((TestEchoInt_Req*)reqObj);
-        case TESTP_PARAM_ID(TestEchoIntPN_Req):
-            return handle_TestEchoIntPN((TestEchoIntPN_Req*)reqObj);
-        case TESTP_PARAM_ID(TestEchoEnum_Req):
-            return handle_TestEchoEnum((TestEchoEnum_Req*)reqObj);
-        case TESTP_PARAM_ID(TestEchoEnumPN_Req):
-            return handle_TestEchoEnumPN((TestEchoEnumPN_Req*)reqObj);
-        case TESTP_PARAM_ID(TestEchoBool_Req):
-            return handle_TestEchoBool((TestEchoBool_Req*)reqObj);
-        case TESTP_PARAM_ID(TestEchoBoolPN_Req):
-            return handle_TestEchoBoolPN((TestEchoBoolPN_Req*)reqObj);
-        case TESTP_PARAM_ID(TestEchoString_Req):
-            return handle_TestEchoString((TestEchoString_Req*)reqObj);
-        case TESTP_PARAM_ID(TestEchoStringPN_Req):
-            return handle_TestEchoStringPN((TestEchoStringPN_Req*)reqObj);
-        case TESTP_PARAM_ID(TestEchoAddr_Req):
-            return handle_TestEchoAddr((TestEchoAddr_Req*)reqObj);
-        case TESTP_PARAM_ID(TestEchoAddrPN_Req):
-            return handle_TestEchoAddrPN((TestEchoAddrPN_Req*)reqObj);
-        case TESTP_PARAM_ID(TestEchoArray_Req):
-            return handle_TestEchoArray((TestEchoArray_Req*)reqObj);
-        case TESTP_PARAM_ID(TestEchoArrayPN_Req):
-            return handle_TestEchoArrayPN((TestEchoArrayPN_Req*)reqObj);
-        case TESTP_PARAM_ID(TestEchoTuple_Req):
-            return handle_TestEchoTuple((TestEchoTuple_Req*)reqObj);
-        case TESTP_PARAM_ID(TestEchoTuplePN_Req):
-            return handle_TestEchoTuplePN((TestEchoTuplePN_Req*)reqObj);
-        case TESTP_PARAM_ID(TestEchoBag_Req):
-            return handle_TestEchoBag((TestEchoBag_Req*)reqObj);
-        case TESTP_PARAM_ID(TestEchoBagPN_Req):
-            return handle_TestEchoBagPN((TestEchoBagPN_Req*)reqObj);
-        default:
-            break;
-    }
-    return NULL;
+    return testprot::dispatch(handlers, reqMsg, NULL);
 }
 
-static BAG *handle_TestEchoInt(TestEchoInt_Req *reqObj)
+static BAG *handle_TestEchoInt(TestEchoInt_Req *reqObj, void *ctx_p)
 {
     TestEchoInt_Req *copy = new TestEchoInt_Req(*reqObj); // Test copy constructor
     TestEchoInt_Req copy2(NULL,
@@ -155,7 +139,7 @@ static BAG *handle_TestEchoInt(TestEchoInt_Req *reqObj)
     return resp;
 }
 
-static BAG *handle_TestEchoIntPN(TestEchoIntPN_Req *reqObj)
+static BAG *handle_TestEchoIntPN(TestEchoIntPN_Req *reqObj, void *ctx_p)
 {
     TestEchoIntPN_Req *copy = new TestEchoIntPN_Req(*reqObj); // Test copy constructor
     TestEchoIntPN_Req copy2(NULL,
@@ -229,7 +213,7 @@ static BAG *handle_TestEchoIntPN(TestEchoIntPN_Req *reqObj)
     return resp;
 }
 
-static BAG *handle_TestEchoEnum(TestEchoEnum_Req *reqObj)
+static BAG *handle_TestEchoEnum(TestEchoEnum_Req *reqObj, void *ctx_p)
 {
     TestEchoEnum_Req *copy = new TestEchoEnum_Req(*reqObj); // Test copy constructor
     TestEchoEnum_Req copy2(NULL,
@@ -291,7 +275,7 @@ static BAG *handle_TestEchoEnum(TestEchoEnum_Req *reqObj)
     return resp;
 }
 
-static BAG *handle_TestEchoEnumPN(TestEchoEnumPN_Req *reqObj)
+static BAG *handle_TestEchoEnumPN(TestEchoEnumPN_Req *reqObj, void *ctx_p)
 {
     TestEchoEnumPN_Req *copy = new TestEchoEnumPN_Req(*reqObj); // Test copy constructor
     TestEchoEnumPN_Req copy2(NULL,
@@ -353,7 +337,7 @@ static BAG *handle_TestEchoEnumPN(TestEchoEnumPN_Req *reqObj)
     return resp;
 }
 
-static BAG *handle_TestEchoBool(TestEchoBool_Req *reqObj)
+static BAG *handle_TestEchoBool(TestEchoBool_Req *reqObj, void *ctx_p)
 {
     TestEchoBool_Req *copy = new TestEchoBool_Req(*reqObj); // Test copy constructor
     TestEchoBool_Req copy2(NULL,
@@ -385,7 +369,7 @@ static BAG *handle_TestEchoBool(TestEchoBool_Req *reqObj)
     return resp;
 }
 
-static BAG *handle_TestEchoBoolPN(TestEchoBoolPN_Req *reqObj)
+static BAG *handle_TestEchoBoolPN(TestEchoBoolPN_Req *reqObj, void *ctx_p)
 {
     TestEchoBoolPN_Req *copy = new TestEchoBoolPN_Req(*reqObj); // Test copy constructor
     TestEchoBoolPN_Req copy2(NULL,
@@ -417,7 +401,7 @@ static BAG *handle_TestEchoBoolPN(TestEchoBoolPN_Req *reqObj)
     return resp;
 }
 
-static BAG *handle_TestEchoString(TestEchoString_Req *reqObj)
+static BAG *handle_TestEchoString(TestEchoString_Req *reqObj, void *ctx_p)
 {
     TestEchoString_Req *copy = new TestEchoString_Req(*reqObj); // Test copy constructor
     TestEchoString_Req copy2(NULL,
@@ -450,7 +434,7 @@ static BAG *handle_TestEchoString(TestEchoString_Req *reqObj)
     return resp;
 }
 
-static BAG *handle_TestEchoStringPN(TestEchoStringPN_Req *reqObj)
+static BAG *handle_TestEchoStringPN(TestEchoStringPN_Req *reqObj, void *ctx_p)
 {
     TestEchoStringPN_Req *copy = new TestEchoStringPN_Req(*reqObj); // Test copy constructor
     TestEchoStringPN_Req copy2(NULL,
@@ -483,7 +467,7 @@ static BAG *handle_TestEchoStringPN(TestEchoStringPN_Req *reqObj)
     return resp;
 }
 
-static BAG *handle_TestEchoAddr(TestEchoAddr_Req *reqObj)
+static BAG *handle_TestEchoAddr(TestEchoAddr_Req *reqObj, void *ctx_p)
 {
     TestEchoAddr_Req *copy = new TestEchoAddr_Req(*reqObj); // Test copy constructor
     TestEchoAddr_Req copy2(NULL,
@@ -508,7 +492,7 @@ static BAG *handle_TestEchoAddr(TestEchoAddr_Req *reqObj)
     return resp;
 }
 
-static BAG *handle_TestEchoAddrPN(TestEchoAddrPN_Req *reqObj)
+static BAG *handle_TestEchoAddrPN(TestEchoAddrPN_Req *reqObj, void *ctx_p)
 {
     TestEchoAddrPN_Req *copy = new TestEchoAddrPN_Req(*reqObj); // Test copy constructor
     TestEchoAddrPN_Req copy2(NULL,
@@ -533,7 +517,7 @@ static BAG *handle_TestEchoAddrPN(TestEchoAddrPN_Req *reqObj)
     return resp;
 }
 
-static BAG *handle_TestEchoArray(TestEchoArray_Req *reqObj)
+static BAG *handle_TestEchoArray(TestEchoArray_Req *reqObj, void *ctx_p)
 {
     TestEchoArray_Req *copy = new TestEchoArray_Req(*reqObj); // Test copy constructor
     TestEchoArray_Req copy2(NULL,
@@ -572,7 +556,7 @@ static BAG *handle_TestEchoArray(TestEchoArray_Req *reqObj)
     return resp;
 }
 
-static BAG *handle_TestEchoArrayPN(TestEchoArrayPN_Req *reqObj)
+static BAG *handle_TestEchoArrayPN(TestEchoArrayPN_Req *reqObj, void *ctx_p)
 {
     TestEchoArrayPN_Req *copy = new TestEchoArrayPN_Req(*reqObj); // Test copy constructor
     TestEchoArrayPN_Req copy2(NULL,
@@ -611,7 +595,7 @@ static BAG *handle_TestEchoArrayPN(TestEchoArrayPN_Req *reqObj)
     return resp;
 }
 
-static BAG *handle_TestEchoTuple(TestEchoTuple_Req *reqObj)
+static BAG *handle_TestEchoTuple(TestEchoTuple_Req *reqObj, void *ctx_p)
 {
     TestEchoTuple_Req *copy = new TestEchoTuple_Req(*reqObj); // Test copy constructor
     TestEchoTuple_Req copy2(NULL,
@@ -655,7 +639,7 @@ static BAG *handle_TestEchoTuple(TestEchoTuple_Req *reqObj)
     return resp;
 }
 
-static BAG *handle_TestEchoTuplePN(TestEchoTuplePN_Req *reqObj)
+static BAG *handle_TestEchoTuplePN(TestEchoTuplePN_Req *reqObj, void *ctx_p)
 {
     TestEchoTuplePN_Req *copy = new TestEchoTuplePN_Req(*reqObj); // Test copy constructor
     TestEchoTuplePN_Req copy2(NULL,
@@ -699,7 +683,7 @@ static BAG *handle_TestEchoTuplePN(TestEchoTuplePN_Req *reqObj)
     return resp;
 }
 
-static BAG *handle_TestEchoBag(TestEchoBag_Req *reqObj)
+static BAG *handle_TestEchoBag(TestEchoBag_Req *reqObj, void *ctx_p)
 {
     TestEchoBag_Req *copy = new TestEchoBag_Req(*reqObj); // Test copy constructor
     TestEchoBag_Req copy2(NULL,
@@ -725,7 +709,7 @@ static BAG *handle_TestEchoBag(TestEchoBag_Req *reqObj)
     return resp;
 }
 
-static BAG *handle_TestEchoBagPN(TestEchoBagPN_Req *reqObj)
+static BAG *handle_TestEchoBagPN(TestEchoBagPN_Req *reqObj, void *ctx_p)
 {
     TestEchoBagPN_Req *copy = new TestEchoBagPN_Req(*reqObj); // Test copy constructor
     TestEchoBagPN_Req copy2(NULL,
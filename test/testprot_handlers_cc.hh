@@ -21,6 +21,6 @@
 
 #include "testprotocol.hh"
 
-testprotocol::BAG *handle_testprot(testprotocol::BAG *reqobj);
+testprotocol::BAG *handle_testprot(mpl_list_t *reqMsg);
 
 #endif
@@ -18,68 +18,65 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <fcntl.h>
+#include <signal.h>
 #include "testprotocol.h"
 #include "testprot_handlers.h"
-#include <assert.h>
+#include "mpl_server.h"
+
+/* Called from the server worker threads */
+static mpl_list_t *handle_request(void *ctx_p, mpl_list_t *req, bool has_error)
+{
+    mpl_list_t *resp;
+
+    if (has_error || (req == NULL)) {
+        fprintf(stderr, "!!! INVALID REQUEST !!!\n");
+        return NULL;
+    }
+
+    resp = handle_testprot(req);
+    if (resp == NULL)
+        fprintf(stderr, "!!! INVALID RESPONSE !!!\n");
+    return resp;
+}
 
 int main(int argc, char *argv[])
 {
-    char buf[1024];
-    FILE *fi;
-    FILE *fo;
+    int fi;
+    int fo;
+    mpl_server_t *server;
 
     if (argc > 2) {
-        fi = fopen(argv[1], "r");
-        if (!fi) {
+        fi = open(argv[1], O_RDONLY);
+        if (fi < 0) {
             fprintf(stderr, "Error opening file '%s' for reading\n", argv[1]);
             exit(-1);
         }
-        fo = fopen(argv[2], "w");
-        if (!fo) {
+        fo = open(argv[2], O_WRONLY | O_CREAT | O_TRUNC, 0666);
+        if (fo < 0) {
             fprintf(stderr, "Error opening file '%s' for writing\n", argv[2]);
             exit(-1);
         }
     }
     else {
-        fi = stdin;
-        fo = stdout;
+        fi = 0;
+        fo = 1;
     }
 
     fprintf(stderr, "testprot server STARTS\n");
 
     testprotocol_param_init();
+    signal(SIGPIPE, SIG_IGN);
 
-    while (fgets(buf, 1024, fi) != NULL) {
-        mpl_list_t *req;
-        mpl_list_t *resp;
-
-        req = mpl_param_list_unpack(buf);
-        if (req) {
-            resp = handle_testprot(req);
-            if (resp) {
-                if (mpl_param_list_pack(resp, buf, 1023) <= 0) {
-                    fprintf(stderr, "!!! FAILED PACKING MESSAGE !!!\n");
-                }
-                mpl_param_list_destroy(&resp);
-                if (fprintf(fo, "%s\n", buf) <= 0) {
-                    fprintf(stderr, "!!! FAILED SENDING MESSAGE !!!\n");
-                }
-                fflush(fo);
-            }
-            else {
-                fprintf(stderr, "!!! INVALID RESPONSE !!!\n");
-            }
-            mpl_param_list_destroy(&req);
-        }
-        else {
-            fprintf(stderr, "!!! INVALID REQUEST !!!\n");
-        }
+    server = mpl_server_create(NULL, handle_request, NULL);
+    if ((server == NULL) ||
+        (mpl_server_add_connection(server, fi, fo) < 0) ||
+        (mpl_server_run(server) < 0)) {
+        fprintf(stderr, "!!! SERVER FAILED !!!\n");
     }
+    /* Closes fi and fo */
+    mpl_server_destroy(server);
 
-    if (fi != stdin)
-        fclose(fi);
-    if ((fo != stdout) && (fo != stderr))
-        fclose(fo);
     mpl_param_system_deinit();
     fprintf(stderr, "testprot server QUITS\n");
     return 0;
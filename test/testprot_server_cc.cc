@@ -56,9 +56,7 @@ int main(int argc, char *argv[])
 
         req = mpl_param_list_unpack(buf);
         if (req && TESTPROT_IS_COMMAND(req)) {
-            BAG *reqObj = testprot::receive(req);
-            BAG *respObj = handle_testprot(reqObj);
-            delete reqObj;
+            BAG *respObj = handle_testprot(req);
             mpl_list_t *resp = NULL;
             if (respObj) {
                 resp = testprot::send(respObj);